@@ -53,10 +53,10 @@ public:
     void        clear(void);
     GBilinear*  clone(void) const;
     std::string classname(void) const;
-    int&        index1(void);
-    int&        index2(void);
-    int&        index3(void);
-    int&        index4(void);
+    long long&  index1(void);
+    long long&  index2(void);
+    long long&  index3(void);
+    long long&  index4(void);
     double&     weight1(void);
     double&     weight2(void);
     double&     weight3(void);
@@ -70,14 +70,14 @@ private:
     void free_members(void);
 
     // Members
-    int    m_inx1;
-    int    m_inx2;
-    int    m_inx3;
-    int    m_inx4;
-    double m_wgt1;
-    double m_wgt2;
-    double m_wgt3;
-    double m_wgt4;
+    long long m_inx1;
+    long long m_inx2;
+    long long m_inx3;
+    long long m_inx4;
+    double    m_wgt1;
+    double    m_wgt2;
+    double    m_wgt3;
+    double    m_wgt4;
 };
 
 
@@ -99,7 +99,7 @@ std::string GBilinear::classname(void) const
  * @return Reference to index 1.
  ***************************************************************************/
 inline
-int& GBilinear::index1(void)
+long long& GBilinear::index1(void)
 {
     return (m_inx1);
 }
@@ -111,7 +111,7 @@ int& GBilinear::index1(void)
  * @return Reference to index 2.
  ***************************************************************************/
 inline
-int& GBilinear::index2(void)
+long long& GBilinear::index2(void)
 {
     return (m_inx2);
 }
@@ -123,7 +123,7 @@ int& GBilinear::index2(void)
  * @return Reference to index 3.
  ***************************************************************************/
 inline
-int& GBilinear::index3(void)
+long long& GBilinear::index3(void)
 {
     return (m_inx3);
 }
@@ -135,7 +135,7 @@ int& GBilinear::index3(void)
  * @return Reference to index 4.
  ***************************************************************************/
 inline
-int& GBilinear::index4(void)
+long long& GBilinear::index4(void)
 {
     return (m_inx4);
 }
@@ -49,6 +49,11 @@ class GFitsTable;
  *
  * The class has no method for sorting of the energy boundaries; it is
  * expected that the energy boundaries are correctly set by the client.
+ *
+ * If the intervals are ordered by increasing energy and do not overlap,
+ * the index() and contains() methods locate an energy using a bi-section
+ * search. For boundaries created by set_lin() or set_log() the interval
+ * is computed directly from the energy.
  ***************************************************************************/
 class GEbounds : public GContainer {
 
@@ -113,6 +118,7 @@ protected:
     void free_members(void);
     void set_attributes(void);
     void insert_eng(const int& index, const GEnergy& emin, const GEnergy& emax);
+    int  find(const GEnergy& eng) const;
 
     // Protected data area
     int      m_num;         //!< Number of energy boundaries
@@ -120,6 +126,11 @@ protected:
     GEnergy  m_emax;        //!< Maximum energy of all intervals
     GEnergy* m_min;         //!< Array of interval minimum energies
     GEnergy* m_max;         //!< Array of interval maximum energies
+    bool     m_sorted;      //!< Intervals are ordered and do not overlap
+    bool     m_grid;        //!< Intervals form a regular grid
+    bool     m_grid_log;    //!< Grid is logarithmic
+    double   m_grid_min;    //!< Grid start (MeV or log10 MeV)
+    double   m_grid_bin;    //!< Grid bin width (MeV or log10 MeV)
 };
 
 
@@ -95,6 +95,11 @@ public:
                      const int&         index,
                      const int&         elements,
                      const std::string& message = "");
+        out_of_range(const std::string& origin,
+                     const std::string& what,
+                     const long long&   index,
+                     const long long&   elements,
+                     const std::string& message = "");
     };
 
     // FITS error
@@ -0,0 +1,167 @@
+/***************************************************************************
+ *               GFft.hpp - Fast Fourier transformation class              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFft.hpp
+ * @brief Fast Fourier transformation class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFFT_HPP
+#define GFFT_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include <complex>
+#include "GBase.hpp"
+
+
+/***********************************************************************//**
+ * @class GFft
+ *
+ * @brief Fast Fourier transformation class
+ *
+ * This class implements a one-dimensional complex Fast Fourier
+ * Transformation of arbitrary length. The transformation is planned once
+ * for a given length, after which any number of arrays of that length
+ * may be transformed:
+ *
+ *     GFft fft(n);
+ *     fft.forward(data);    // data[k] = sum_j data[j] exp(-2 pi i jk/n)
+ *     fft.backward(data);   // data[j] = sum_k data[k] exp(+2 pi i jk/n)
+ *
+ * Note that the backward transformation is not normalised, hence a
+ * forward transformation followed by a backward transformation multiplies
+ * the data by the length @p n.
+ *
+ * Lengths that factorise into small primes are transformed using a
+ * mixed-radix Cooley-Tukey algorithm. Lengths that contain a large prime
+ * factor are transformed using Bluestein's algorithm, which maps the
+ * transformation on a convolution of power of two length. Both variants
+ * take a time proportional to n log n. The good_size() method returns the
+ * smallest length not below a given length that factorises into 2, 3 and
+ * 5, which should be used for zero padding.
+ *
+ * The transformation methods are const, hence a single plan may be used
+ * by several threads at the same time.
+ ***************************************************************************/
+class GFft : public GBase {
+
+public:
+    // Constructors and destructors
+    GFft(void);
+    explicit GFft(const int& n);
+    GFft(const GFft& fft);
+    virtual ~GFft(void);
+
+    // Operators
+    GFft& operator=(const GFft& fft);
+
+    // Methods
+    void        clear(void);
+    GFft*       clone(void) const;
+    std::string classname(void) const;
+    const int&  size(void) const;
+    void        set(const int& n);
+    void        forward(std::complex<double>* data) const;
+    void        backward(std::complex<double>* data) const;
+    static int  good_size(const int& n);
+    std::string print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFft& fft);
+    void free_members(void);
+    void transform(std::complex<double>* data, const bool& forward) const;
+    void cooley_tukey(const std::complex<double>* in,
+                      std::complex<double>*       out,
+                      const int&                  n,
+                      const int&                  stride,
+                      const int&                  ifactor,
+                      const bool&                 forward) const;
+    void bluestein(std::complex<double>* data, const bool& forward) const;
+
+    // Protected data members
+    int                                m_size;    //!< Transformation length
+    std::vector<int>                   m_factors; //!< Radix factors
+    std::vector<std::complex<double> > m_twiddle; //!< exp(-2 pi i k/n)
+    GFft*                              m_fft;     //!< Bluestein FFT (NULL if not used)
+    std::vector<std::complex<double> > m_chirp;   //!< Bluestein chirp exp(-i pi k^2/n)
+    std::vector<std::complex<double> > m_kernel;  //!< Bluestein kernel spectrum
+};
+
+
+/***********************************************************************//**
+ * @brief Return class name
+ *
+ * @return String containing the class name ("GFft").
+ ***************************************************************************/
+inline
+std::string GFft::classname(void) const
+{
+    return ("GFft");
+}
+
+
+/***********************************************************************//**
+ * @brief Return transformation length
+ *
+ * @return Transformation length.
+ ***************************************************************************/
+inline
+const int& GFft::size(void) const
+{
+    return (m_size);
+}
+
+
+/***********************************************************************//**
+ * @brief Forward transformation
+ *
+ * @param[in,out] data Array of size() complex values.
+ *
+ * Replaces @p data by its forward Fourier transformation.
+ ***************************************************************************/
+inline
+void GFft::forward(std::complex<double>* data) const
+{
+    transform(data, true);
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Backward transformation
+ *
+ * @param[in,out] data Array of size() complex values.
+ *
+ * Replaces @p data by its backward Fourier transformation. The result is
+ * not normalised.
+ ***************************************************************************/
+inline
+void GFft::backward(std::complex<double>* data) const
+{
+    transform(data, false);
+    return;
+}
+
+#endif /* GFFT_HPP */
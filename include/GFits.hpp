@@ -37,8 +37,15 @@
 
 /* __ Prototypes _________________________________________________________ */
 namespace gammalib {
-    int fits_move_to_hdu(const std::string& caller, void* vptr,
-                         const int& hdunum = 0);
+    int  fits_move_to_hdu(const std::string& caller, void* vptr,
+                          const int& hdunum = 0);
+    bool fits_mmap(void);
+    void fits_mmap(const bool& mmap);
+    bool fits_mmap_column(void* vptr, const int& colnum, const int& type,
+                          const int& row, const int& nrows,
+                          const int& number, void* data);
+    bool fits_mmap_image(void* vptr, const int& bitpix, const int& type,
+                         const int& npixels, void* data);
 }
 
 
@@ -96,6 +96,12 @@ public:
     void                    anynul(const int& anynul);
     const int&              anynul(void) const;
     std::string             tform_binary(void) const;
+    void                    read_rows(const int&           row,
+                                      const int&           nrows,
+                                      std::vector<double>& values) const;
+    void                    read_rows(const int&                  row,
+                                      const int&                  nrows,
+                                      std::vector<unsigned long>& values) const;
     std::string             print(const GChatter& chatter = NORMAL) const;
 
 protected:
@@ -104,6 +110,11 @@ protected:
     void        copy_members(const GFitsTableCol& column);
     void        free_members(void);
     void        connect(void* vptr);
+    void        check_rows(const std::string& origin, const int& row,
+                           const int& nrows) const;
+    bool        read_cells(const std::string& origin, const int& row,
+                           const int& nelements, const int& type,
+                           void* values) const;
 
     // Protected pure virtual methods
     virtual void        alloc_data(void) = 0;
@@ -40,6 +40,13 @@
  * of derivatives. This class has no members. The only pure virtual method
  * that needs to be implemented by the derived class is the eval() method
  * that provides function evaluation at a given value x, e.g. y=eval(x).
+ *
+ * The class also provides a batch eval() method that evaluates the function
+ * for an array of values. By default, the method calls the single value
+ * eval() method for each value. Derived classes may override the batch
+ * method to evaluate many abscissas at once, which avoids one virtual
+ * function call per value and allows the compiler to vectorise the
+ * computation.
  ***************************************************************************/
 class GFunction {
 
@@ -55,6 +62,7 @@ public:
 
     // Methods
     virtual double eval(const double& x) = 0;
+    virtual void   eval(const double* x, double* y, const int& n);
 
 protected:
     // Protected methods
@@ -52,6 +52,12 @@ class GFitsTable;
  *
  * The class has no method for sorting of the Good Time Intervals; it is
  * expected that the Good Time Intervals are correctly set by the client.
+ *
+ * If the Good Time Intervals are ordered by increasing time and do not
+ * overlap, the contains() method locates a time using a bi-section search.
+ * The interval found last is kept as a hint for the next search, so that
+ * checking a time ordered sequence of times takes on average a constant
+ * time per check.
  ***************************************************************************/
 class GGti : public GContainer {
 
@@ -109,6 +115,7 @@ protected:
     void  free_members(void);
     void  set_attributes(void);
     void  insert_gti(const int& index, const GTime& tstart, const GTime& tstop);
+    int   find(const GTime& time) const;
 
     // Protected data area
     int             m_num;       //!< Number of Good Time Intervals
@@ -119,6 +126,7 @@ protected:
     GTime          *m_start;     //!< Array of start times
     GTime          *m_stop;      //!< Array of stop times
     GTimeReference  m_reference; //!< Time reference
+    bool            m_sorted;    //!< GTIs are ordered and do not overlap
 };
 
 
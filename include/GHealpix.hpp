@@ -28,12 +28,18 @@
 #define GHEALPIX_HPP
 
 /* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include <complex>
 #include "GSkyProjection.hpp"
 #include "GFitsHDU.hpp"
 #include "GSkyDir.hpp"
 #include "GSkyPixel.hpp"
 #include "GBilinear.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GFft;
+
 
 /***********************************************************************//**
  * @class GHealpix
@@ -43,6 +49,19 @@
  * The HealPix projection class has been implemented by adapting code from
  * the HealPix library (version 2.1). For more information about HEALPix, see
  * http://healpix.jpl.nasa.gov
+ *
+ * Pixel indices are handled as 64-bit integers, allowing for maps with
+ * Nside up to 2^27, which exceed the 2^31 pixels that a 32-bit integer
+ * index can address.
+ *
+ * The query_disc(), query_strip() and query_polygon() methods return the
+ * pixels within a sky region. They work ring by ring on pixel ranges, hence
+ * their cost scales with the number of pixels in the region and not with
+ * the number of pixels in the map.
+ *
+ * The map2alm() and alm2map() methods transform a map into spherical
+ * harmonic coefficients and back, which allows for example to convolve a
+ * map with an isotropic kernel.
  ***************************************************************************/
 class GHealpix : public GSkyProjection {
 
@@ -71,14 +90,34 @@ public:
     virtual double      solidangle(const GSkyPixel& pixel) const;
     virtual GSkyDir     pix2dir(const GSkyPixel& pixel) const;
     virtual GSkyPixel   dir2pix(const GSkyDir& dir) const;
+    virtual void        pix2dir(const double* x, const double* y,
+                                double* lon, double* lat,
+                                const int& n) const;
+    virtual void        dir2pix(const double* lon, const double* lat,
+                                double* x, double* y,
+                                const int& n) const;
     virtual GBilinear   interpolator(const GSkyDir& dir) const;
     virtual std::string print(const GChatter& chatter = NORMAL) const;
 
     // Other methods
-    const int&   npix(void) const;
-    const int&   nside(void) const;
-    std::string  ordering(void) const;
-    void         ordering(const std::string& ordering);
+    const long long&       npix(void) const;
+    const int&             nside(void) const;
+    std::string            ordering(void) const;
+    void                   ordering(const std::string& ordering);
+    std::vector<long long> query_disc(const GSkyDir& dir,
+                                      const double&  radius,
+                                      const bool&    inclusive = false) const;
+    std::vector<long long> query_strip(const double& bmin,
+                                       const double& bmax,
+                                       const bool&   inclusive = false) const;
+    std::vector<long long> query_polygon(const std::vector<GSkyDir>& vertices,
+                                         const bool& inclusive = false) const;
+    std::vector<std::complex<double> >
+                           map2alm(const double* pixels,
+                                   const int&    lmax) const;
+    void                   alm2map(const std::vector<std::complex<double> >& alm,
+                                   const int&                                lmax,
+                                   double*                                   pixels) const;
 
 private:
     // Private methods
@@ -88,39 +127,57 @@ private:
     virtual bool compare(const GSkyProjection& proj) const;
 
     // Low-level HealPix methods
-    int          compress_bits(const int& value) const;
-    int          spread_bits(const int& value) const;
-    void         nest2xyf(const int& pix, int* ix, int* iy, int* face) const;
-    void         ring2xyf(const int& pix, int* ix, int* iy, int* face) const;
-    int          xyf2nest(const int& ix, const int& iy, const int& face) const;
-    int          xyf2ring(const int& ix, const int& iy, const int& face) const;
+    int          compress_bits(const long long& value) const;
+    long long    spread_bits(const int& value) const;
+    void         nest2xyf(const long long& pix, int* ix, int* iy,
+                          int* face) const;
+    void         ring2xyf(const long long& pix, int* ix, int* iy,
+                          int* face) const;
+    long long    xyf2nest(const int& ix, const int& iy, const int& face) const;
+    long long    xyf2ring(const int& ix, const int& iy, const int& face) const;
     int          nside2order(const int& nside) const;
-    int          nest2ring(const int& pix) const;
-    int          ring2nest(const int& pix) const;
-    void         pix2xy(const int& ipix, int* x, int* y) const;
-    int          xy2pix(int x, int y) const;
-    void         pix2ang_ring(int ipix, double* theta, double* phi) const;
-    void         pix2ang_nest(int ipix, double* theta, double* phi) const;
-    int          ang2pix_z_phi_ring(double z, double phi) const;
-    int          ang2pix_z_phi_nest(double z, double phi) const;
+    long long    nest2ring(const long long& pix) const;
+    long long    ring2nest(const long long& pix) const;
+    void         pix2ang_ring(long long ipix, double* theta, double* phi) const;
+    void         pix2ang_nest(long long ipix, double* theta, double* phi) const;
+    long long    ang2pix_z_phi_ring(double z, double phi) const;
+    long long    ang2pix_z_phi_nest(double z, double phi) const;
     int          ring_above(const double& z) const;
-    void         get_ring_info(const int& ring, int* startpix, int* ringpix,
+    void         get_ring_info(const int& ring, long long* startpix,
+                               int* ringpix, bool* shifted) const;
+    void         get_ring_info(const int& ring, long long* startpix,
+                               int* ringpix, double* theta,
                                bool* shifted) const;
-    void         get_ring_info(const int& ring, int* startpix, int* ringpix,
-                               double* theta, bool* shifted) const;
     GBilinear    interpolator(const double& theta, const double& phi) const;
-    unsigned int isqrt(unsigned int arg) const;
+    long long    isqrt(const long long& arg) const;
+    double       ring2z(const int& ring) const;
+    double       max_pixrad(void) const;
+    void         dir2ang(const GSkyDir& dir, double* theta, double* phi) const;
+    std::vector<long long> query_discs(const std::vector<double>& z0,
+                                       const std::vector<double>& phi0,
+                                       const std::vector<double>& radius) const;
+    std::vector<long long> ranges2pixels(const std::vector<long long>& ranges) const;
+    void         ring_geometry(std::vector<double>* z,
+                               std::vector<double>* logsin,
+                               std::vector<GFft>*   ffts) const;
+    void         legendre_transform(const int&                 m,
+                                    const int&                 lmax,
+                                    const std::vector<double>& z,
+                                    const std::vector<double>& logsin,
+                                    std::complex<double>*      values,
+                                    std::complex<double>*      alm,
+                                    const bool&                analysis) const;
 
     // Private data area
-    int      m_nside;        //!< Number of divisions of each base pixel (1-8192)
-    int      m_npface;       //!<
-    int      m_ncap;         //!< Number of pixels in polar cap
-    int      m_order;        //!< Order
-    int      m_ordering;     //!< Pixel ordering (0=ring, 1=nested, -1=?)
-    int      m_num_pixels;   //!< Number of pixels in projection
-    double   m_fact1;        //!<
-    double   m_fact2;        //!<
-    double   m_solidangle;   //!< Solid angle of pixel
+    int       m_nside;       //!< Number of divisions of each base pixel (1-2^27)
+    long long m_npface;      //!< Number of pixels per face
+    long long m_ncap;        //!< Number of pixels in polar cap
+    int       m_order;       //!< Order
+    int       m_ordering;    //!< Pixel ordering (0=ring, 1=nested, -1=?)
+    long long m_num_pixels;  //!< Number of pixels in projection
+    double    m_fact1;       //!<
+    double    m_fact2;       //!<
+    double    m_solidangle;  //!< Solid angle of pixel
 };
 
 
@@ -180,9 +237,15 @@ std::string GHealpix::name(void) const
 
 /***********************************************************************//**
  * @brief Returns number of pixels
+ *
+ * @return Number of pixels.
+ *
+ * Returns the number of pixels. The number is returned as long long since
+ * maps with Nside > 8192 hold more than 2^31 pixels; callers should not
+ * store it in an int.
  ***************************************************************************/
 inline
-const int& GHealpix::npix(void) const
+const long long& GHealpix::npix(void) const
 {
     // Return number of pixels
     return m_num_pixels;
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GMatrixBase.hpp"
 
 /* __ Definitions ________________________________________________________ */
@@ -180,6 +181,24 @@ class GSparseNumeric;
  * the stack_destroy() method flushes the stack before destroying it. The
  * matrix stack is also destroyed by the sparse matrix destructor, hence
  * manual stack destruction is not mandatory.
+ *
+ * If the pattern of the matrix is known in advance, for example from a
+ * previous fill of a matrix with the same structure, values can be
+ * accumulated on that pattern without inserting any matrix elements:
+ *
+ *     matrix.pattern_init(pattern);
+ *     ...
+ *     matrix.add_to_column(index, values, rows, number);
+ *     ...
+ *     matrix.pattern_destroy();
+ *
+ * The pattern_init(pattern) method shares the pattern of the matrix
+ * @p pattern, which hence needs to exist as long as values are accumulated.
+ * Elements that are not part of the pattern are added to the matrix
+ * elements (using the fill stack if it exists). The pattern_destroy()
+ * method adds the accumulated values to the matrix elements. Matrices that
+ * accumulate on the same pattern are merged by add_matrices() by simply
+ * summing their value arrays.
  * 
  * Except for *m_rowinx which is implemented on the level of GMatrixSparse,
  * all other members are implemented by the base class GMatrixBase.
@@ -253,12 +272,17 @@ public:
                          const int* rows, int number);
     void          add_to_column(const int& column, const double* values,
                                 const int* rows, int number);
+    void          add_matrices(const std::vector<const GMatrixSparse*>& matrices);
     GMatrixSparse transpose(void) const;
     GMatrixSparse invert(void) const;
     GVector       solve(const GVector& vector) const;
     GMatrixSparse abs(void) const;
     GMatrixSparse cholesky_decompose(const bool& compress = true) const;
+    bool          cholesky_refactor(const GMatrixSparse& matrix,
+                                    const bool&          compress = true);
     GVector       cholesky_solver(const GVector& vector, const bool& compress = true) const;
+    GMatrix       cholesky_solver(const GMatrix& matrix, const bool& compress = true) const;
+    GVector       cholesky_inverse_diagonal(const bool& compress = true) const;
     GMatrixSparse cholesky_invert(const bool& compress = true) const;
     void          set_mem_block(const int& block);
     void          stack_init(const int& size = 0, const int& entries = 0);
@@ -267,6 +291,8 @@ public:
                                     const int& number, const int& col);
     void          stack_flush(void);
     void          stack_destroy(void);
+    void          pattern_init(const GMatrixSparse& matrix);
+    void          pattern_destroy(void);
 
 private:
     // Private methods
@@ -276,12 +302,22 @@ private:
     void alloc_members(const int& rows, const int& cols, const int& elements = 0);
     void init_stack_members(void);
     void free_stack_members(void);
+    void init_pattern_members(void);
+    void free_pattern_members(void);
     int  get_index(const int& row, const int& column) const;
     void fill_pending(void);
     void alloc_elements(int start, const int& num);
     void free_elements(const int& start, const int& num);
     void remove_zero_row_col(void);
     void insert_zero_row_col(const int& rows, const int& cols);
+    void cholesky_maps(const bool&       compress,
+                       std::vector<int>& row_map,
+                       std::vector<int>& row_inx,
+                       std::vector<int>& col_inx) const;
+    void add_column_elements(const int& column, const double* values,
+                             const int* rows, int number);
+    void add_values(double* data, const int& elements,
+                    const std::vector<const double*>& values) const;
     void mix_column_prepare(const int* src1_row, int src1_num,
                             const int* src2_row, int src2_num,
                             int* num_1, int* num_2, int* num_mix);
@@ -310,6 +346,12 @@ private:
     int*    m_stack_work;         //!< Stack flush integer working array [m_cols]
     int*    m_stack_rows;         //!< Stack push integer working array [m_cols]
     double* m_stack_values;       //!< Stack push double buffer [m_cols]
+
+    // Shared pattern
+    const int* m_pattern_colstart;  //!< Column start indices of pattern [m_cols+1]
+    const int* m_pattern_rowinx;    //!< Row indices of pattern [m_pattern_elements]
+    double*    m_pattern_data;      //!< Values on pattern [m_pattern_elements]
+    int        m_pattern_elements;  //!< Number of pattern elements
 };
 
 
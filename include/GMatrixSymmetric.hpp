@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GMatrixBase.hpp"
 
 /* __ Forward declarations _______________________________________________ */
@@ -121,8 +122,12 @@ public:
     GMatrixSymmetric abs(void) const;
     GMatrix          extract_lower_triangle(void) const;
     GMatrix          extract_upper_triangle(void) const;
+    void             rank1_update(const double& alpha, const GVector& vector,
+                                  const int* inx, const int& number);
     GMatrixSymmetric cholesky_decompose(const bool& compress = true) const;
     GVector          cholesky_solver(const GVector& vector, const bool& compress = true) const;
+    GMatrix          cholesky_solver(const GMatrix& matrix, const bool& compress = true) const;
+    GVector          cholesky_inverse_diagonal(const bool& compress = true) const;
     GMatrixSymmetric cholesky_invert(const bool& compress = true) const;
 
 private:
@@ -132,6 +137,10 @@ private:
     void free_members(void);
     void alloc_members(const int& rows, const int& columns);
     void set_inx(void);
+    std::vector<int> cholesky_inx(const bool&        compress,
+                                  const std::string& origin) const;
+    std::vector<double> pack_inx(void) const;
+    void                unpack_inx(const std::vector<double>& packed);
 
     // Private data area
     int  m_num_inx;          //!< Number of indices in array
@@ -35,6 +35,7 @@
 #include "GXmlElement.hpp"
 #include "GEnergy.hpp"
 #include "GTime.hpp"
+#include "GTools.hpp"
 
 /* __ Forward declarations _______________________________________________ */
 class GEvent;
@@ -97,6 +98,9 @@ class GObservation;
  ***************************************************************************/
 class GModel : public GBase {
 
+    // Friend classes
+    friend class GModels;
+
 public:
     // Constructors and destructors
     GModel(void);
@@ -134,6 +138,7 @@ public:
     bool                has_par(const std::string& name) const;
     const std::string&  name(void) const;
     void                name(const std::string& name);
+    const int&          name_id(void) const;
     const double&       ts(void) const;
     void                ts(const double& ts);
     const bool&         tscalc(void) const;
@@ -158,6 +163,7 @@ protected:
 
     // Protected members
     std::string              m_name;         //!< Model name
+    int                      m_name_id;      //!< Interned model name
     std::vector<std::string> m_instruments;  //!< Instruments to which model applies
     std::vector<GModelPar>   m_scales;       //!< Model instrument scale factors
     std::vector<std::string> m_ids;          //!< Identifiers to which model applies
@@ -166,6 +172,7 @@ protected:
     bool                     m_has_tscalc;   //!< Signals if tscalc attribute is available
     bool                     m_tscalc;       //!< Signals if TS should be computed
     double                   m_ts;           //!< Test Statistic of the model
+    bool*                    m_renamed;      //!< Renaming flag of model container
 };
 
 
@@ -234,15 +241,36 @@ const std::string& GModel::name(void) const
  *
  * @param[in] name Parameter name.
  *
- * Set the parameter name.
+ * Set the parameter name. If the model is held by a model container, the
+ * container is informed that its model name index needs to be rebuilt.
  ***************************************************************************/
 inline
 void GModel::name(const std::string& name)
 {
-    m_name = name;
+    m_name    = name;
+    m_name_id = gammalib::intern(name);
+    if (m_renamed != NULL) {
+        *m_renamed = true;
+    }
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Return interned model name
+ *
+ * @return Interned model name identifier (-1 if no name was set).
+ *
+ * Returns the identifier of the model name (see gammalib::intern()).
+ * The identifier allows to look up model dependent information without
+ * comparing model names.
+ ***************************************************************************/
+inline
+const int& GModel::name_id(void) const
+{
+    return m_name_id;
+}
+
 /***********************************************************************//**
  * @brief Return Test Statistic value
  *
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GModel.hpp"
 #include "GModelPar.hpp"
 #include "GModelSpatial.hpp"
@@ -37,6 +38,7 @@
 #include "GSkyDir.hpp"
 #include "GEnergy.hpp"
 #include "GTime.hpp"
+#include "GTimes.hpp"
 #include "GPhoton.hpp"
 #include "GPhotons.hpp"
 #include "GRan.hpp"
@@ -194,6 +196,16 @@ protected:
                                   const GObservation& obs,
                                   bool grad) const;
     bool            valid_model(void) const;
+    void            mc_block(const GModelSpectral&  spectral,
+                             const GTimes&          times,
+                             const int&             ifirst,
+                             const int&             ilast,
+                             const GEnergy&         emin,
+                             const GEnergy&         emax,
+                             const GSkyDir&         dir,
+                             std::vector<GPhoton>*  photons,
+                             std::vector<double>*   cosdist,
+                             GRan&                  ran) const;
 
     class edisp_kern : public GFunction {
     public:
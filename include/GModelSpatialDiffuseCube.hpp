@@ -29,12 +29,14 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GModelSpatialDiffuse.hpp"
 #include "GModelSpectral.hpp"
 #include "GModelSpectralNodes.hpp"
 #include "GModelPar.hpp"
 #include "GSkyDir.hpp"
 #include "GSkymap.hpp"
+#include "GRanAlias.hpp"
 #include "GNodeArray.hpp"
 #include "GXmlElement.hpp"
 #include "GEbounds.hpp"
@@ -88,7 +90,7 @@ public:
 
     // Other methods
     int                        maps(void) const;
-    int                        pixels(void) const;
+    long long                  pixels(void) const;
     void                       load(const std::string& filename);
     double                     value(void) const;
     void                       value(const double& value);
@@ -112,16 +114,16 @@ protected:
     void update_mc_cache(void);
 
     // Protected members
-    GModelPar           m_value;       //!< Value
-    std::string         m_filename;    //!< Name of map cube
-    bool                m_loaded;      //!< Signals if map cube has been loaded
-    GSkymap             m_cube;        //!< Map cube
-    GNodeArray          m_logE;        //!< Log10(energy) values of the maps
-    GEbounds            m_ebounds;     //!< Energy bounds of the maps
-    std::vector<double> m_mc_cache;    //!< Monte Carlo cache
-    GModelSpectralNodes m_mc_spectrum; //!< Map cube spectrum
-    GSkyDir             m_mc_cone_dir; //!< Monte Carlo simulation cone centre
-    double              m_mc_cone_rad; //!< Monte Carlo simulation cone radius
+    GModelPar              m_value;       //!< Value
+    std::string            m_filename;    //!< Name of map cube
+    bool                   m_loaded;      //!< Signals if map cube has been loaded
+    GSkymap                m_cube;        //!< Map cube
+    GNodeArray             m_logE;        //!< Log10(energy) values of the maps
+    GEbounds               m_ebounds;     //!< Energy bounds of the maps
+    std::vector<GRanAlias> m_mc_cache;    //!< Monte Carlo alias tables
+    GModelSpectralNodes    m_mc_spectrum; //!< Map cube spectrum
+    GSkyDir                m_mc_cone_dir; //!< Monte Carlo simulation cone centre
+    double                 m_mc_cone_rad; //!< Monte Carlo simulation cone radius
 };
 
 
@@ -173,7 +175,7 @@ int GModelSpatialDiffuseCube::maps(void) const
  * Returns the number of pixels in the cube.
  ***************************************************************************/
 inline
-int GModelSpatialDiffuseCube::pixels(void) const
+long long GModelSpatialDiffuseCube::pixels(void) const
 {
     return (m_cube.npix());
 }
@@ -34,6 +34,7 @@
 #include "GModelPar.hpp"
 #include "GSkyDir.hpp"
 #include "GSkymap.hpp"
+#include "GRanAlias.hpp"
 #include "GXmlElement.hpp"
 
 
@@ -101,7 +102,7 @@ protected:
     GModelPar           m_value;         //!< Value
     GSkymap             m_map;           //!< Skymap
     std::string         m_filename;      //!< Name of skymap
-    std::vector<double> m_mc_cache;      //!< Monte Carlo cache
+    GRanAlias           m_mc_cache;      //!< Monte Carlo alias table
     bool                m_normalize;     //!< Normalize map (default: true)
     bool                m_has_normalize; //!< XML has normalize attribute
     double              m_norm;          //!< Map normalization
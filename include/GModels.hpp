@@ -29,6 +29,8 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
+#include <map>
 #include "GContainer.hpp"
 #include "GModel.hpp"
 #include "GOptimizerPars.hpp"
@@ -139,8 +141,14 @@ class GObservation;
  * The eval_gradients() method sets the parameter gradients for all free
  * model parameters that have an analytical parameter gradient.
  *
- * The only member of GModels is a list of model pointers. The class handles
- * the proper allocation and deallocation of the model memory.
+ * The main member of GModels is a list of model pointers. The class handles
+ * the proper allocation and deallocation of the model memory. In addition,
+ * the class maintains an index that maps model names on model indices, so
+ * that models can be found by name without scanning the full container.
+ * As models may be renamed through the pointers that are returned by the
+ * non-const access methods, each model in the container flags the index
+ * as invalid when its name changes, and the index is rebuilt at the next
+ * failed look-up.
  ***************************************************************************/
 class GModels : public GContainer {
 
@@ -192,9 +200,13 @@ protected:
     void          copy_members(const GModels& models);
     void          free_members(void);
     int           get_index(const std::string& name) const;
+    void          shift_index(const int& index, const int& offset);
+    void          set_index(void) const;
 
     // Proteced members
-    std::vector<GModel*> m_models;  //!< List of models
+    std::vector<GModel*>               m_models;      //!< List of models
+    mutable std::map<std::string, int> m_index;       //!< Model name index
+    mutable bool                       m_index_dirty; //!< Models were renamed
 };
 
 
@@ -52,11 +52,26 @@
  * or using the set_value(). In the latter case, the node indices and
  * weighting factors can be recovered using inx_left(), inx_right(),
  * wgt_left() and wgt_right().
+ * As set_value() stores the indices and weighting factors in the node
+ * array, it may not be used by several threads on the same node array.
+ * The interpolate(const double&) method returns the indices and weighting
+ * factors by value without modifying the node array, and hence can be used
+ * concurrently by several threads.
  * If the nodes are equally spaced, interpolation is more rapid.
  ***************************************************************************/
 class GNodeArray : public GContainer {
 
 public:
+    /**
+     * @brief Node indices and weighting factors for linear interpolation
+     */
+    struct interpolation {
+        int    inx_left;    //!< Index of left node
+        int    inx_right;   //!< Index of right node
+        double wgt_left;    //!< Weight of left node
+        double wgt_right;   //!< Weight of right node
+    };
+
     // Constructors and destructors
     GNodeArray(void);
     GNodeArray(const int& num, const double* array);
@@ -88,6 +103,7 @@ public:
     void          nodes(const std::vector<double>& vector);
     double        interpolate(const double& value,
                               const std::vector<double>& vector) const;
+    interpolation interpolate(const double& value) const;
     void          set_value(const double& value) const;
     const int&    inx_left(void) const;
     const int&    inx_right(void) const;
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GEvents.hpp"
 #include "GResponse.hpp"
@@ -38,6 +39,7 @@
 #include "GFunction.hpp"
 #include "GVector.hpp"
 #include "GMatrixSparse.hpp"
+#include "GMatrixSymmetric.hpp"
 
 
 /***********************************************************************//**
@@ -90,10 +92,11 @@ public:
     // Virtual methods
     virtual const GEvents*   events(void) const;
     virtual void             events(const GEvents& events);
-    virtual double           likelihood(const GModels& models,
-                                        GVector*       gradient,
-                                        GMatrixSparse* curvature,
-                                        double*        npred) const;
+    virtual double           likelihood(const GModels&                 models,
+                                        GVector*                       gradient,
+                                        GMatrixSparse*                 curvature,
+                                        double*                        npred,
+                                        std::vector<GMatrixSymmetric>* dense = NULL) const;
     virtual double           model(const GModels& models,
                                    const GEvent&  event,
                                    GVector*       gradient = NULL) const;
@@ -105,6 +108,7 @@ public:
                                         const GEvent&    event) const;
     virtual double           npred_grad(const GModel&    model,
                                         const GModelPar& par) const;
+    virtual bool             is_threadsafe(void) const;
 
     // Implemented methods
     void               name(const std::string& name);
@@ -114,6 +118,10 @@ public:
     const std::string& id(void) const;
     const std::string& statistics(void) const;
 
+    // Static constants
+    static const int max_dense_pars = 100; //!< Maximum number of parameters
+                                           //!< for dense curvature accumulation
+
 protected:
     // Protected methods
     void init_members(void);
@@ -121,18 +129,57 @@ protected:
     void free_members(void);
 
     // Likelihood methods
-    virtual double likelihood_poisson_unbinned(const GModels& models,
-                                               GVector*       gradient,
-                                               GMatrixSparse* curvature,
-                                               double*        npred) const;
-    virtual double likelihood_poisson_binned(const GModels& models,
-                                             GVector*       gradient,
-                                             GMatrixSparse* curvature,
-                                             double*        npred) const;
-    virtual double likelihood_gaussian_binned(const GModels& models,
-                                              GVector*       gradient,
-                                              GMatrixSparse* curvature,
-                                              double*        npred) const;
+    virtual double likelihood_poisson_unbinned(const GModels&                 models,
+                                               GVector*                       gradient,
+                                               GMatrixSparse*                 curvature,
+                                               std::vector<GMatrixSymmetric>* dense,
+                                               double*                        npred) const;
+    virtual double likelihood_poisson_binned(const GModels&                 models,
+                                             GVector*                       gradient,
+                                             GMatrixSparse*                 curvature,
+                                             std::vector<GMatrixSymmetric>* dense,
+                                             double*                        npred) const;
+    virtual double likelihood_gaussian_binned(const GModels&                 models,
+                                              GVector*                       gradient,
+                                              GMatrixSparse*                 curvature,
+                                              std::vector<GMatrixSymmetric>* dense,
+                                              double*                        npred) const;
+
+    // Event-level likelihood methods
+    typedef double (GObservation::*likelihood_kernel)(const GModels&    models,
+                                                      const int&        ifirst,
+                                                      const int&        ilast,
+                                                      GVector*          gradient,
+                                                      GMatrixSparse*    curvature,
+                                                      GMatrixSymmetric* dense,
+                                                      double*           npred) const;
+    double likelihood_events(likelihood_kernel              kernel,
+                             const GModels&                 models,
+                             GVector*                       gradient,
+                             GMatrixSparse*                 curvature,
+                             std::vector<GMatrixSymmetric>* dense,
+                             double*                        npred) const;
+    double poisson_unbinned_kernel(const GModels&    models,
+                                   const int&        ifirst,
+                                   const int&        ilast,
+                                   GVector*          gradient,
+                                   GMatrixSparse*    curvature,
+                                   GMatrixSymmetric* dense,
+                                   double*) const;
+    double poisson_binned_kernel(const GModels&    models,
+                                 const int&        ifirst,
+                                 const int&        ilast,
+                                 GVector*          gradient,
+                                 GMatrixSparse*    curvature,
+                                 GMatrixSymmetric* dense,
+                                 double*           npred) const;
+    double gaussian_binned_kernel(const GModels&    models,
+                                  const int&        ifirst,
+                                  const int&        ilast,
+                                  GVector*          gradient,
+                                  GMatrixSparse*    curvature,
+                                  GMatrixSymmetric* dense,
+                                  double*           npred) const;
 
     // Model gradient kernel classes
     class model_func : public GFunction {
@@ -288,4 +335,22 @@ const std::string& GObservation::statistics(void) const
     return (m_statistics);
 }
 
+
+/***********************************************************************//**
+ * @brief Signals if observation may be evaluated by concurrent threads
+ *
+ * @return False.
+ *
+ * Returns true if the model(), npred() and event access methods of the
+ * observation may be called concurrently by several threads, each thread
+ * operating on its own copy of the models. This enables event-level
+ * parallelism in the likelihood computation. As responses and event
+ * containers often hold mutable caches, the base class returns false.
+ ***************************************************************************/
+inline
+bool GObservation::is_threadsafe(void) const
+{
+    return false;
+}
+
 #endif /* GOBSERVATION_HPP */
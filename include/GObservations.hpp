@@ -158,13 +158,15 @@ public:
         void           init_members(void);
         void           copy_members(const likelihood& fct);
         void           free_members(void);
+        void           set_curvature(const GMatrixSymmetric& matrix);
 
         // Protected data members
-        double         m_value;       //!< Function value
-        double         m_npred;       //!< Total number of predicted events
-        GVector*       m_gradient;    //!< Pointer to gradient vector
-        GMatrixSparse* m_curvature;   //!< Pointer to curvature matrix
-        GObservations* m_this;        //!< Pointer to GObservations object
+        double                                      m_value;     //!< Function value
+        double                                      m_npred;     //!< Total number of predicted events
+        GVector*                                    m_gradient;  //!< Pointer to gradient vector
+        GMatrixSparse*                              m_curvature; //!< Pointer to curvature matrix
+        std::vector<std::vector<GMatrixSymmetric> > m_dense;     //!< Dense curvature accumulators
+        GObservations*                              m_this;      //!< Pointer to GObservations object
     };
 
     // Optimizer function access method
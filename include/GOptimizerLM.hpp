@@ -31,6 +31,7 @@
 #include <vector>
 #include "GOptimizer.hpp"
 #include "GOptimizerFunction.hpp"
+#include "GMatrixSparse.hpp"
 #include "GLog.hpp"
 
 /* __ Definitions ________________________________________________________ */
@@ -123,6 +124,7 @@ protected:
     int               m_status;          //!< Fit status
     int               m_iter;            //!< Iteration
     int               m_num_dec;         //!< Number of function decreases
+    GMatrixSparse     m_decomposition;   //!< Cholesky decomposition of curvature
     GLog*             m_logger;          //!< Pointer to optional logger
 
 };
@@ -40,6 +40,11 @@
  * @brief Random number generator class
  *
  * This class implements a random number generator.
+ *
+ * Independent and reproducible random number sequences for parallel
+ * computations are obtained using the substream() method, which returns
+ * a generator that depends only on the seed and a stream index, but not on
+ * the numbers that have already been drawn.
  ***************************************************************************/
 class GRan : public GBase {
 
@@ -59,6 +64,7 @@ public:
     std::string            classname(void) const;
     void                   seed(unsigned long long int seed);
     unsigned long long int seed(void) const;
+    GRan                   substream(const unsigned long long int& index) const;
     unsigned long int      int32(void);
     unsigned long long int int64(void);
     double                 uniform(void);
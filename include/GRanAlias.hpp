@@ -0,0 +1,137 @@
+/***************************************************************************
+ *            GRanAlias.hpp - Alias table random sampler class             *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GRanAlias.hpp
+ * @brief Alias table random sampler class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GRANALIAS_HPP
+#define GRANALIAS_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include "GBase.hpp"
+#include "GRan.hpp"
+
+
+/***********************************************************************//**
+ * @class GRanAlias
+ *
+ * @brief Alias table random sampler class
+ *
+ * This class implements Walker's alias method for drawing random indices
+ * from a discrete distribution that is given by an array of non-negative
+ * weights. The alias table is built once using Vose's algorithm, after
+ * which each index is drawn in constant time using a single uniform random
+ * number. Compared to a bi-section search in the cumulative distribution,
+ * the cost of a draw does not depend on the number of weights.
+ *
+ * Drawing is a const operation, hence a single table can be shared by
+ * several threads as long as each thread uses its own random number
+ * generator.
+ ***************************************************************************/
+class GRanAlias : public GBase {
+
+public:
+    // Constructors and destructors
+    GRanAlias(void);
+    explicit GRanAlias(const std::vector<double>& weights);
+    GRanAlias(const GRanAlias& alias);
+    virtual ~GRanAlias(void);
+
+    // Operators
+    GRanAlias& operator=(const GRanAlias& alias);
+
+    // Methods
+    void             clear(void);
+    GRanAlias*       clone(void) const;
+    std::string      classname(void) const;
+    int              size(void) const;
+    bool             is_empty(void) const;
+    const double&    total(void) const;
+    void             set(const std::vector<double>& weights);
+    int              draw(GRan& ran) const;
+    std::vector<int> draw(GRan& ran, const int& number) const;
+    std::string      print(const GChatter& chatter = NORMAL) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GRanAlias& alias);
+    void free_members(void);
+
+    // Protected data members
+    std::vector<double> m_prob;   //!< Probability of keeping the index
+    std::vector<int>    m_alias;  //!< Alias index
+    double              m_total;  //!< Sum of weights
+};
+
+
+/***********************************************************************//**
+ * @brief Return class name
+ *
+ * @return String containing the class name ("GRanAlias").
+ ***************************************************************************/
+inline
+std::string GRanAlias::classname(void) const
+{
+    return ("GRanAlias");
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of weights
+ *
+ * @return Number of weights in alias table.
+ ***************************************************************************/
+inline
+int GRanAlias::size(void) const
+{
+    return (int)m_prob.size();
+}
+
+
+/***********************************************************************//**
+ * @brief Signals if alias table is empty
+ *
+ * @return True if alias table is empty, false otherwise.
+ ***************************************************************************/
+inline
+bool GRanAlias::is_empty(void) const
+{
+    return (m_prob.empty());
+}
+
+
+/***********************************************************************//**
+ * @brief Return sum of weights
+ *
+ * @return Sum of weights that were used to build the alias table.
+ ***************************************************************************/
+inline
+const double& GRanAlias::total(void) const
+{
+    return (m_total);
+}
+
+#endif /* GRANALIAS_HPP */
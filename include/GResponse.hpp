@@ -87,6 +87,10 @@ public:
     virtual double   irf(const GEvent&       event,
                          const GSource&      source,
                          const GObservation& obs) const;
+    virtual double   irf_gradients(const GEvent&       event,
+                                   const GSource&      source,
+                                   const GObservation& obs) const;
+    virtual bool     has_irf_gradients(const GModelSpatial& model) const;
     virtual double   irf_ptsrc(const GEvent&       event,
                                const GSource&      source,
                                const GObservation& obs) const;
@@ -108,14 +108,14 @@ private:
     double m_ra;         //!< Right Ascension in radians
     double m_dec;        //!< Declination in radians
 
-    // Sincos cache
+    // Sincos cache (set together with the coordinates)
     #if defined(G_SINCOS_CACHE)
-    mutable bool   m_has_lb_cache;
-    mutable bool   m_has_radec_cache;
-    mutable double m_sin_b;
-    mutable double m_cos_b;
-    mutable double m_sin_dec;
-    mutable double m_cos_dec;
+    bool   m_has_lb_cache;
+    bool   m_has_radec_cache;
+    double m_sin_b;
+    double m_cos_b;
+    double m_sin_dec;
+    double m_cos_dec;
     #endif
 };
 
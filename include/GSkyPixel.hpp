@@ -77,6 +77,7 @@ public:
     // Constructors and destructors
     GSkyPixel(void);
     GSkyPixel(const int& index);
+    GSkyPixel(const long long& index);
     GSkyPixel(const double& index);
     GSkyPixel(const int& x, const int& y);
     GSkyPixel(const double& x, const double& y);
@@ -86,6 +87,7 @@ public:
     // Operators
     GSkyPixel& operator=(const GSkyPixel& pixel);
     operator int() const;
+    operator long long() const;
     operator double() const;
     
     // Methods
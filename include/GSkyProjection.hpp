@@ -76,6 +76,12 @@ public:
     // Virtual methods
     virtual std::string coordsys(void) const;
     virtual void        coordsys(const std::string& coordsys);
+    virtual void        pix2dir(const double* x, const double* y,
+                                double* lon, double* lat,
+                                const int& n) const;
+    virtual void        dir2pix(const double* lon, const double* lat,
+                                double* x, double* y,
+                                const int& n) const;
 
 protected:
     // Protected methods
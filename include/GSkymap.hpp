@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GSkyDir.hpp"
 #include "GSkyPixel.hpp"
@@ -42,6 +43,9 @@
 #include "GVector.hpp"
 #include "GBilinear.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GFunction;
+
 
 /***********************************************************************//**
  * @class GSkymap
@@ -72,9 +76,35 @@
  *     GSkyPixel pixel = map.inx2pix(index);   // Index to pixel
  *     GSkyDir   dir   = map.inx2dir(index);   // Index to sky direction
  *     GSkyDir   dir   = map.pix2dir(pixel);   // Pixel to sky direction
- *     int       index = map.pix2inx(pixel);   // Pixel to index
- *     int       index = map.dir2inx(dir);     // Sky direction to index
+ *     long long index = map.pix2inx(pixel);   // Pixel to index
+ *     long long index = map.dir2inx(dir);     // Sky direction to index
  *     GSkyPixel pixel = map.dir2pix(dir);     // Sky direction to pixel
+ *
+ * Pixel indices are 64-bit integers, so that sky maps may hold more than
+ * 2^31 pixels, and so that the total number of pixels of all maps may
+ * exceed 2^31.
+ *
+ * Each of the conversions from a pixel into a sky direction or a solid
+ * angle involves a sky projection. Clients that repeatedly request the
+ * sky directions or solid angles of the pixels may enable the pixel cache
+ * using
+ *
+ *     map.pixel_cache(true);
+ *
+ * On first use, the sky directions and solid angles of all pixels are
+ * then computed and stored, and subsequent requests for pixel centres are
+ * served from the cache. The cache is dropped when the sky projection
+ * changes. Copies of a sky map share the cache of the original map.
+ *
+ * The arithmetic operators combine the pixels of two sky maps directly if
+ * both maps have the same pixelisation, and otherwise interpolate the
+ * second sky map. The add() method adds a scaled sky map and the scale()
+ * method scales each map by an individual factor, both without allocating
+ * temporary sky maps.
+ *
+ * The convolve() methods convolve the maps with an isotropic kernel. The
+ * convolution is computed by a Fast Fourier Transformation for "CAR" and
+ * "TAN" projections and in spherical harmonic space for HealPix maps.
  *  
  ***************************************************************************/
 class GSkymap : public GBase {
@@ -112,8 +142,8 @@ public:
     GSkymap&      operator*=(const double& factor);
     GSkymap&      operator/=(const GSkymap& map);
     GSkymap&      operator/=(const double& factor);
-    double&       operator()(const int& index, const int& map = 0);
-    const double& operator()(const int& index, const int& map = 0) const;
+    double&       operator()(const long long& index, const int& map = 0);
+    const double& operator()(const long long& index, const int& map = 0) const;
     double&       operator()(const GSkyPixel& pixel, const int& map = 0);
     const double& operator()(const GSkyPixel& pixel, const int& map = 0) const;
     double        operator()(const GSkyDir& dir, const int& map = 0) const;
@@ -122,26 +152,35 @@ public:
     void                  clear(void);
     GSkymap*              clone(void) const;
     std::string           classname(void) const;
-    const int&            npix(void) const;
+    const long long&      npix(void) const;
     const int&            nx(void) const;
     const int&            ny(void) const;
     const int&            nmaps(void) const;
     void                  nmaps(const int& nmaps);
-    GSkyPixel             inx2pix(const int& index) const;
-    GSkyDir               inx2dir(const int& index) const;
+    GSkyPixel             inx2pix(const long long& index) const;
+    GSkyDir               inx2dir(const long long& index) const;
+    std::vector<GSkyDir>  inx2dir(const long long& index,
+                                  const int&       number) const;
     GSkyDir               pix2dir(const GSkyPixel& pixel) const;
-    int                   pix2inx(const GSkyPixel& pixel) const;
-    int                   dir2inx(const GSkyDir& dir) const;
+    long long             pix2inx(const GSkyPixel& pixel) const;
+    long long             dir2inx(const GSkyDir& dir) const;
     GSkyPixel             dir2pix(const GSkyDir& dir) const;
-    double                solidangle(const int& index) const;
+    double                solidangle(const long long& index) const;
     double                solidangle(const GSkyPixel& pixel) const;
     bool                  contains(const GSkyDir& dir) const;
     bool                  contains(const GSkyPixel& pixel) const;
     const GSkyProjection* projection(void) const;
     void                  projection(const GSkyProjection& proj);
+    const bool&           pixel_cache(void) const;
+    void                  pixel_cache(const bool& cache);
     const double*         pixels(void) const;
     GSkymap               extract(const int& map, const int& nmaps = 1) const;
     void                  stack_maps(void);
+    void                  add(const GSkymap& map, const double& factor);
+    void                  scale(const std::vector<double>& factors);
+    void                  convolve(GFunction& kernel, const double& theta_max,
+                                   const int& map);
+    void                  convolve(GFunction& kernel, const double& theta_max);
     void                  load(const std::string& filename);
     void                  save(const std::string& filename, bool clobber = false) const;
     void                  read(const GFitsHDU& hdu);
@@ -152,7 +191,8 @@ private:
     // Private methods
     void              init_members(void);
     void              alloc_pixels(void);
-    void              copy_members(const GSkymap& map);
+    void              copy_members(const GSkymap& map,
+                                   const bool&    pixels = true);
     void              free_members(void);
     void              set_wcs(const std::string& wcs, const std::string& coords,
                               const double& crval1, const double& crval2,
@@ -164,9 +204,22 @@ private:
     void              alloc_wcs(const GFitsImage& image);
     GFitsBinTable*    create_healpix_hdu(void) const;
     GFitsImageDouble* create_wcs_hdu(void) const;
+    bool              is_cached(const long long& index) const;
+    long long         cached_index(const GSkyPixel& pixel) const;
+    GSkyDir           cached_dir(const long long& index) const;
+    double            cached_solidangle(const long long& index) const;
+    bool              is_same(const GSkymap& map) const;
+    void              convolve_healpix(GFunction&    kernel,
+                                       const double& theta_max,
+                                       const int&    map,
+                                       const int&    nmaps);
+    void              convolve_wcs(GFunction&    kernel,
+                                   const double& theta_max,
+                                   const int&    map,
+                                   const int&    nmaps);
 
     // Private data area
-    int               m_num_pixels; //!< Number of pixels (used for pixel allocation)
+    long long         m_num_pixels; //!< Number of pixels (used for pixel allocation)
     int               m_num_maps;   //!< Number of maps (used for pixel allocation)
     int               m_num_x;      //!< Number of pixels in x direction (only 2D)
     int               m_num_y;      //!< Number of pixels in y direction (only 2D)
@@ -178,6 +231,28 @@ private:
     mutable bool      m_contained;  //!< Sky direction is contained in map
     mutable GSkyDir   m_last_dir;   //!< Last sky direction
     mutable GBilinear m_interpol;   //!< Bilinear interpolator
+
+    // Pixel cache that is shared between copies of a sky map. The cache
+    // is not modified once it has been computed.
+    class pixcache {
+    public:
+        pixcache(void) : m_equ(true), m_refs(1) {}
+        ~pixcache(void) {}
+        bool                m_equ;    //!< Cache in celestial coordinates
+        std::vector<double> m_lon;    //!< Pixel longitudes (deg)
+        std::vector<double> m_lat;    //!< Pixel latitudes (deg)
+        std::vector<double> m_omega;  //!< Pixel solid angles (sr)
+        int                 m_refs;   //!< Number of sky maps using the cache
+    };
+
+    // Pixel cache methods
+    const pixcache*   pixel_cache_data(void) const;
+    pixcache*         set_pixel_cache(void) const;
+    void              free_pixel_cache(void);
+
+    // Pixel cache
+    bool              m_use_pixel_cache; //!< Use pixel cache
+    mutable pixcache* m_pixel_cache;     //!< Pixel cache (NULL if not computed)
 };
 
 
@@ -198,10 +273,12 @@ std::string GSkymap::classname(void) const
  *
  * @return Number of pixels in one sky map.
  *
- * Returns the number of pixels in one sky map.
+ * Returns the number of pixels in one sky map. The number is returned as
+ * long long since HealPix maps with Nside > 8192 hold more than 2^31
+ * pixels; callers should not store it in an int.
  ***************************************************************************/
 inline
-const int& GSkymap::npix(void) const
+const long long& GSkymap::npix(void) const
 {
     return m_num_pixels;
 }
@@ -263,6 +340,18 @@ const GSkyProjection* GSkymap::projection(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Signals whether the pixel cache is used
+ *
+ * @return True if the pixel cache is used.
+ ***************************************************************************/
+inline
+const bool& GSkymap::pixel_cache(void) const
+{
+    return m_use_pixel_cache;
+}
+
+
 /***********************************************************************//**
  * @brief Returns pointer to pixel data
  *
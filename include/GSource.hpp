@@ -33,6 +33,7 @@
 #include "GModelSpatial.hpp"
 #include "GEnergy.hpp"
 #include "GTime.hpp"
+#include "GTools.hpp"
 
 
 /***********************************************************************//**
@@ -57,6 +58,8 @@ public:
     GSource(void);
     GSource(const std::string& name, GModelSpatial* model,
             const GEnergy& energy, const GTime& time);
+    GSource(const std::string& name, const int& name_id,
+            GModelSpatial* model, const GEnergy& energy, const GTime& time);
     GSource(const GSource& src);
     virtual ~GSource(void);
 
@@ -68,10 +71,12 @@ public:
     GSource*             clone(void) const;
     std::string          classname(void) const;
     const std::string&   name(void) const;
+    const int&           name_id(void) const;
     const GModelSpatial* model(void) const;
     const GEnergy&       energy(void) const;
     const GTime&         time(void) const;
     void                 name(const std::string& name);
+    void                 name_id(const int& id);
     void                 model(GModelSpatial* model);
     void                 energy(const GEnergy& energy);
     void                 time(const GTime& time);
@@ -85,6 +90,7 @@ protected:
 
     // Protected data members
     std::string    m_name;     //!< Source name
+    int            m_name_id;  //!< Interned source name (-1 if no name)
     GModelSpatial* m_model;    //!< Spatial model
     GEnergy        m_energy;   //!< Photon energy
     GTime          m_time;     //!< Photon arrival time
@@ -169,7 +175,42 @@ const GTime& GSource::time(void) const
 inline
 void GSource::name(const std::string& name)
 {
-    m_name = name;
+    m_name    = name;
+    m_name_id = gammalib::intern(name);
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return interned model name
+ *
+ * @return Interned model name identifier (-1 if no name was set).
+ *
+ * Returns the identifier of the model name (see gammalib::intern()). The
+ * model name is interned when it is set, hence the method does not modify
+ * the source and can be called concurrently by several threads.
+ ***************************************************************************/
+inline
+const int& GSource::name_id(void) const
+{
+    return m_name_id;
+}
+
+
+/***********************************************************************//**
+ * @brief Set interned model name
+ *
+ * @param[in] id Interned model name identifier.
+ *
+ * Sets the identifier of the model name. The identifier must have been
+ * obtained by interning the model name (see gammalib::intern()), for
+ * example using GModel::name_id(). Setting the identifier avoids interning
+ * the model name when the identifier is requested.
+ ***************************************************************************/
+inline
+void GSource::name_id(const int& id)
+{
+    m_name_id = id;
     return;
 }
 
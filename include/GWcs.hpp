@@ -74,6 +74,12 @@ public:
     virtual double      solidangle(const GSkyPixel& pixel) const;
     virtual GSkyDir     pix2dir(const GSkyPixel& pixel) const;
     virtual GSkyPixel   dir2pix(const GSkyDir& dir) const;
+    virtual void        pix2dir(const double* x, const double* y,
+                                double* lon, double* lat,
+                                const int& n) const;
+    virtual void        dir2pix(const double* lon, const double* lat,
+                                double* x, double* y,
+                                const int& n) const;
 
     // Other methods
     void   set(const std::string& coords,
@@ -83,6 +89,8 @@ public:
     double crval(const int& inx) const;
     double crpix(const int& inx) const;
     double cdelt(const int& inx) const;
+    double solidangle(const GSkyDir& dir1, const GSkyDir& dir2,
+                      const GSkyDir& dir3, const GSkyDir& dir4) const;
 
 private:
     // Static constants (set in GWcs.cpp)
@@ -46,6 +46,7 @@
 #include "GBilinear.hpp"
 #include "GCsv.hpp"
 #include "GRan.hpp"
+#include "GRanAlias.hpp"
 #include "GUrl.hpp"
 #include "GUrlFile.hpp"
 #include "GUrlString.hpp"
@@ -61,6 +62,7 @@
 #include "GIntegral.hpp"
 #include "GDerivative.hpp"
 #include "GFunction.hpp"
+#include "GFft.hpp"
 #include "GMath.hpp"
 
 /* __ FITS module ________________________________________________________ */
@@ -87,7 +87,7 @@ public:
     int                    nchi(void) const { return m_map.nx(); }
     int                    npsi(void) const { return m_map.ny(); }
     int                    nphi(void) const { return m_map.nmaps(); }
-    int                    npix(void) const { return m_map.npix(); }
+    int                    npix(void) const { return int(m_map.npix()); }
 
 protected:
     // Protected methods
@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <climits>
 #include "GTools.hpp"
 #include "GFits.hpp"
 #include "GCOMException.hpp"
@@ -288,7 +289,7 @@ GCOMEventCube* GCOMEventCube::clone(void) const
 int GCOMEventCube::size(void) const
 {
     // Compute number of bins
-    int nbins = m_map.npix() * m_map.nmaps(); 
+    int nbins = int(m_map.npix() * m_map.nmaps());
 
     // Return number of bins
     return nbins;
@@ -682,6 +683,8 @@ void GCOMEventCube::free_members(void)
  *
  * @exception GCOMException::no_sky
  *            No sky pixels have been defined.
+ * @exception GException::invalid_value
+ *            Number of event cube bins exceeds the int range.
  *
  * This method computes the sky directions and solid angles for all (Chi,Psi)
  * values of the event cube. Sky directions are stored in an array of GSkyDir
@@ -690,6 +693,15 @@ void GCOMEventCube::free_members(void)
  ***************************************************************************/
 void GCOMEventCube::set_scatter_directions(void)
 {
+    // Throw an error if the event cube has more bins than can be indexed
+    if (m_map.npix() * m_map.nmaps() > INT_MAX) {
+        std::string msg = "Sky map with "+gammalib::str(m_map.npix())+
+                          " pixels and "+gammalib::str(m_map.nmaps())+
+                          " maps exceeds the maximum number of "+
+                          gammalib::str(INT_MAX)+" COMPTEL event cube bins.";
+        throw GException::invalid_value(G_SET_SCATTER_DIRECTIONS, msg);
+    }
+
     // Throw an error if we have no sky pixels
     if (npix() < 1) {
         throw GCOMException::no_sky(G_SET_SCATTER_DIRECTIONS,
@@ -704,15 +716,20 @@ void GCOMEventCube::set_scatter_directions(void)
     m_dirs.reserve(npix());
     m_solidangle.reserve(npix());
 
+    // Enable the pixel cache of the sky map so that all pixel directions
+    // and solid angles are computed in a single pass
+    bool pixel_cache = m_map.pixel_cache();
+    m_map.pixel_cache(true);
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < npsi(); ++iy) {
-        for (int ix = 0; ix < nchi(); ++ix) {
-            GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(m_map.pix2dir(pixel));
-            m_solidangle.push_back(m_map.solidangle(pixel));
-        }
+    for (int i = 0; i < npix(); ++i) {
+        m_dirs.push_back(m_map.inx2dir(i));
+        m_solidangle.push_back(m_map.solidangle(i));
     }
 
+    // Restore pixel cache usage of the sky map
+    m_map.pixel_cache(pixel_cache);
+
     // Return
     return;
 }
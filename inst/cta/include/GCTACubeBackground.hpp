@@ -39,6 +39,9 @@ class GFitsBinTable;
 class GRan;
 class GObservations;
 class GCTAInstDir;
+class GCTAObservation;
+class GCTAEventCube;
+class GModels;
 
 
 /***********************************************************************//**
@@ -84,20 +87,17 @@ private:
     void copy_members(const GCTACubeBackground& bgd);
     void free_members(void);
     void set_eng_axis(void);
-    void update(const double& logE) const;
+    void fill_cube(const GCTAObservation& obs,
+                   const GModels&         models,
+                   const int&             first,
+                   const int&             last,
+                   GCTAEventCube*         cube) const;
 
     // Members
     mutable std::string m_filename;  //!< Name of background response file
     GSkymap             m_cube;      //!< Background cube
     GEbounds            m_ebounds;   //!< Energy bounds for the background cube
     GNodeArray          m_elogmeans; //!< Mean energy for the background cube
-
-    // Response table computation cache for 1D access
-    mutable int    m_inx_left;       //!< Index of left node
-    mutable int    m_inx_right;      //!< Index of right node
-    mutable double m_wgt_left;       //!< Weight of left node
-    mutable double m_wgt_right;      //!< Weight of right node
-
 };
 
 
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GFits.hpp"
 #include "GSkymap.hpp"
@@ -36,6 +37,10 @@
 #include "GCTAObservation.hpp"
 #include "GCTAEventCube.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GCTAResponseIrf;
+class GCTARoi;
+
 
 /***********************************************************************//**
  * @class GCTACubeExposure
@@ -95,10 +100,16 @@ protected:
     void init_members(void);
     void copy_members(const GCTACubeExposure& exp);
     void free_members(void);
-    void update(const double& logE) const;
     void set_eng_axis(void);
     void read_attributes(const GFitsHDU& hdu);
     void write_attributes(GFitsHDU& hdu) const;
+    void fill_cube(const GCTAObservation&      obs,
+                   const GCTAResponseIrf&      rsp,
+                   const GCTARoi&              roi,
+                   const std::vector<GSkyDir>& dirs,
+                   const long long&            first,
+                   const long long&            last,
+                   GSkymap*                    cube) const;
 
     // Members
     mutable std::string m_filename;  //!< Filename
@@ -109,13 +120,6 @@ protected:
 
     // Exposure attributes
     double              m_livetime;  //!< Livetime (sec)
-
-private:
-    // Response table computation cache for 1D access
-    mutable int    m_inx_left;       //!< Index of left node
-    mutable int    m_inx_right;      //!< Index of right node
-    mutable double m_wgt_left;       //!< Weight of left node
-    mutable double m_wgt_right;      //!< Weight of right node
 };
 
 
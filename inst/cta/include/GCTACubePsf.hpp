@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GFits.hpp"
 #include "GSkymap.hpp"
@@ -37,6 +38,10 @@
 #include "GNodeArray.hpp"
 #include "GCTAEventCube.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GCTAResponseIrf;
+class GCTARoi;
+
 
 /***********************************************************************//**
  * @class GCTACubePsf
@@ -102,10 +107,17 @@ protected:
     void copy_members(const GCTACubePsf& cube);
     void free_members(void);
     void clear_cube(void);
-    void update(const double& delta, const double& logE) const;
     void set_delta_axis(void);
     void set_eng_axis(void);
     void set_to_smooth(void);
+    void fill_cube(const GCTAObservation&      obs,
+                   const GCTAResponseIrf&      rsp,
+                   const GCTARoi&              roi,
+                   const std::vector<GSkyDir>& dirs,
+                   const long long&            first,
+                   const long long&            last,
+                   GSkymap*                    cube,
+                   GSkymap*                    exposure) const;
 
     // Data
     mutable std::string m_filename;          //!< Filename
@@ -115,17 +127,6 @@ protected:
     GNodeArray          m_deltas;            //!< Delta bins (deg) for the PSF cube
     GNodeArray          m_deltas_cache;      //!< Internal delta bins (rad)
     bool                m_quadratic_binning; //!< Internal binning is linear
-
-private:
-    // Response table computation cache for 2D access
-    mutable int    m_inx1;            //!< Index of upper left node
-    mutable int    m_inx2;            //!< Index of lower left node
-    mutable int    m_inx3;            //!< Index of upper right node
-    mutable int    m_inx4;            //!< Index of lower right node
-    mutable double m_wgt1;            //!< Weight of upper left node
-    mutable double m_wgt2;            //!< Weight of lower left node
-    mutable double m_wgt3;            //!< Weight of upper right node
-    mutable double m_wgt4;            //!< Weight of lower right node
 };
 
 
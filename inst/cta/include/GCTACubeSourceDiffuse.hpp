@@ -41,6 +41,7 @@
 class GModelSpatial;
 class GObservation;
 class GModelSpatialDiffuse;
+class GCTAEventCube;
 class GSkyDir;
 class GEnergy;
 class GTime;
@@ -90,6 +91,10 @@ protected:
     void init_members(void);
     void copy_members(const GCTACubeSourceDiffuse& source);
     void free_members(void);
+    void set_convolved(const GCTAResponseCube*     rsp,
+                       const GModelSpatialDiffuse* model,
+                       const GCTAEventCube*        cube,
+                       const GTime&                srcTime);
 
     // Data members
     GSkymap m_cube;  //!< Diffuse map convolved with IRF
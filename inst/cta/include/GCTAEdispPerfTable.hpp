@@ -88,22 +88,23 @@ public:
     std::string         print(const GChatter& chatter = NORMAL) const;
 
 private:
+    // Energy dispersion parameters
+    struct parameters {
+        double scale; //!< Gaussian normalization
+        double sigma; //!< Gaussian sigma
+        double width; //!< Gaussian width parameter
+    };
+
     // Methods
-    void init_members(void);
-    void copy_members(const GCTAEdispPerfTable& psf);
-    void free_members(void);
-    void update(const double& logE) const;
+    void       init_members(void);
+    void       copy_members(const GCTAEdispPerfTable& psf);
+    void       free_members(void);
+    parameters compute(const double& logE) const;
 
     // Members
     std::string         m_filename;  //!< Name of response file
     GNodeArray          m_logE;      //!< log(E) nodes for interpolation
     std::vector<double> m_sigma;     //!< Sigma value (rms) of energy resolution
-
-    // Precomputation cache
-    mutable double      m_par_logE;  //!< Energy for which precomputation is done
-    mutable double      m_par_scale; //!< Gaussian normalization
-    mutable double      m_par_sigma; //!< Gaussian sigma
-    mutable double      m_par_width; //!< Gaussian width parameter
 };
 
 
@@ -99,7 +99,6 @@ private:
     void set_matrix(void);
     void set_cache(void) const;
     void set_mc_cache(void) const;
-    void update(const double& arg1, const double& arg2) const;
     void update_cumul(const double& logEsrc,
                       const double& theta = 0.0,
                       const double& phi = 0.0,
@@ -114,16 +113,6 @@ private:
     // Interpolation cache
     mutable GNodeArray m_etrue;          //!< Array of log10(Etrue)
     mutable GNodeArray m_emeasured;      //!< Array of log10(Emeasured)
-    mutable double     m_last_etrue;     //!< Last log10(Etrue)
-    mutable double     m_last_emeasured; //!< Last log10(Emeasured)
-    mutable int        m_itrue1;         //!< Index of left Etrue
-    mutable int        m_itrue2;         //!< Index of right Etrue
-    mutable int        m_imeas1;         //!< Index of left Emeasured
-    mutable int        m_imeas2;         //!< Index of right Emeasured
-    mutable double     m_wgt1;           //!< Weight of lower left node
-    mutable double     m_wgt2;           //!< Weight of upper left node
-    mutable double     m_wgt3;           //!< Weight of lower right node
-    mutable double     m_wgt4;           //!< Weight of upper right node
 
     // Monte Carlo cache
     mutable std::vector<int>                        m_mc_measured_start;
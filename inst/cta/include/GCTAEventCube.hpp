@@ -183,11 +183,14 @@ int GCTAEventCube::ny(void) const
  * @brief Return number of pixels in one energy bins of the event cube
  *
  * @return Number of pixels in one energy bins of the event cube.
+ *
+ * The number of bins of an event cube is limited to the int range (see
+ * set_directions()), hence the number of pixels is returned as int.
  ***************************************************************************/
 inline
 int GCTAEventCube::npix(void) const
 {
-    return (m_map.npix());
+    return (int(m_map.npix()));
 }
 
 
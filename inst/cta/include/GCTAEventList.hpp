@@ -30,6 +30,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <string>
 #include <vector>
+#include <map>
 #include "GEventList.hpp"
 #include "GCTAEventAtom.hpp"
 #include "GCTARoi.hpp"
@@ -37,6 +38,9 @@
 #include "GFitsTable.hpp"
 #include "GFitsBinTable.hpp"
 
+/* __ Forward declarations _______________________________________________ */
+class GFits;
+
 
 /***********************************************************************//**
  * @class GCTAEventList
@@ -44,6 +48,46 @@
  * @brief CTA event atom container class
  *
  * This class is a container class for CTA event atoms.
+ *
+ * The events are stored column-wise: the quantities that are needed for
+ * the likelihood computation (direction, energy and time) are kept in
+ * contiguous arrays, so that loops over the events only touch the memory
+ * they need. Reconstruction information (multiplicity, shower parameters,
+ * Hillas parameters, etc.) and pulse phases are kept in separate arrays
+ * that are only allocated if any of the events carries such information.
+ *
+ * The access operators return a pointer to an event atom view that is
+ * filled from the columns (similar to the event bin view returned by
+ * GCTAEventCube). Each thread that reads events through the const access
+ * operator has its own view, hence the const access operator can be used
+ * concurrently by several threads. Views are indexed by the OpenMP thread
+ * number, hence the const access operator must not be called from nested
+ * parallel regions.
+ *
+ * Note that the pointer returned by the const access operator does not
+ * point to a stored event. It points to the view of the calling thread and
+ * is only valid until the same thread accesses the event list again: the
+ * next access overwrites the view with another event. Pointers to events
+ * hence must not be kept across accesses; copy the event atom if it is
+ * needed later. The pointer returned by the non-const access operator is
+ * valid until the next call of the non-const access operator, and
+ * modifications of the event atom are written back into the columns.
+ *
+ * If the events are loaded from a file using load(), the reconstruction
+ * information is only read from the file when it is needed, i.e. when the
+ * event list is written or when events are modified or appended. Event
+ * atom views returned by the const access operator carry the
+ * reconstruction information only once it was read.
+ *
+ * Event lists that are too large to be held in memory can be streamed
+ * from the event file (see stream()). In that case only chunks of
+ * consecutive rows of the EVENTS table are held in memory, and the chunk
+ * that contains a requested event is read on access. Each thread has its
+ * own chunk, so that threads that iterate through different event ranges
+ * do not replace each other's chunks; only the reading of a chunk is
+ * serialised. Iterating through the events in index order hence reads
+ * each chunk once per thread. Streamed event lists are read-only, and IRF
+ * values are not cached for them (see irf_cache()).
  ***************************************************************************/
 class GCTAEventList : public GEventList {
 
@@ -77,34 +121,101 @@ public:
     // Implement other methods
     void   append(const GCTAEventAtom& event);
     void   reserve(const int& number);
+    void   stream(const std::string& filename, const int& chunk_size);
+    void   stream(const GFitsTable& table, const int& chunk_size);
+    bool   is_streamed(void) const;
+    int    chunk_size(void) const;
     double irf_cache(const std::string& name, const int& index) const;
     void   irf_cache(const std::string& name, const int& index,
                      const double& irf) const;
+    double irf_cache(const int& id, const int& index) const;
+    void   irf_cache(const int& id, const int& index,
+                     const double& irf) const;
 
 protected:
+    // Read access data of a thread
+    struct thread_data {
+        GCTAEventAtom  view;        //!< Event atom view
+        GCTAEventList* chunk;       //!< Chunk of streamed events
+        int            chunk_first; //!< First row of chunk (-1: none)
+    };
+
+    // IRF cache entry of a model
+    struct irf_cache_entry {
+        int                 id;     //!< Interned model name
+        std::vector<double> values; //!< IRF values (-1: not yet computed)
+        irf_cache_entry*    next;   //!< Next cache entry
+    };
+
     // Protected methods
     void         init_members(void);
     void         copy_members(const GCTAEventList& list);
     void         free_members(void);
     virtual void set_energies(void) { return; }
     virtual void set_times(void) { return; }
-    void         read_events(const GFitsTable& hdu);
-    void         read_events_v0(const GFitsTable& hdu);
-    void         read_events_v1(const GFitsTable& hdu);
-    void         read_events_hillas(const GFitsTable& hdu);
+    void         read_header(const GFits& file);
+    void         read_header(const GFitsTable& events,
+                             const GFitsTable* gti = NULL);
+    void         read_events(const GFitsTable& hdu, const int& row = 0,
+                             const int& nrows = -1);
+    void         read_events_v0(const GFitsTable& hdu, const int& row,
+                                const int& nrows);
+    void         read_events_v1(const GFitsTable& hdu, const int& row,
+                                const int& nrows);
+    void         read_events_recon(const GFitsTable& hdu, const int& row,
+                                   const int& nrows);
     void         write_events(GFitsBinTable& hdu) const;
     void         write_ds_keys(GFitsHDU& hdu) const;
-    int          irf_cache_init(const std::string& name) const;
-    int          irf_cache_index(const std::string& name) const;
+    irf_cache_entry* irf_cache_init(const int& id) const;
+    irf_cache_entry* irf_cache_find(const int& id) const;
+    thread_data* thread_slot(void) const;
+    void         load_recon(void);
+    void         get_event(const int& index, GCTAEventAtom& event) const;
+    void         set_event(const int& index, const GCTAEventAtom& event);
+    void         flush_edit(void);
+    void         fetch_chunk(thread_data* data, const int& index) const;
 
     // Protected members
-    GCTARoi                    m_roi;       //!< Region of interest
-    std::vector<GCTAEventAtom> m_events;    //!< Events
-    bool                       m_has_phase; //!< Signal presence of phase
+    GCTARoi                    m_roi;        //!< Region of interest
+    bool                       m_has_phase;  //!< Signal presence of phase
+
+    // Event columns
+    std::vector<double>        m_ra;         //!< Right Ascension (radians)
+    std::vector<double>        m_dec;        //!< Declination (radians)
+    std::vector<double>        m_detx;       //!< Instrument coordinate X (radians)
+    std::vector<double>        m_dety;       //!< Instrument coordinate Y (radians)
+    std::vector<double>        m_logE;       //!< log10 of energy in MeV
+    std::vector<double>        m_times;      //!< Times (native seconds)
+    std::vector<unsigned long> m_event_ids;  //!< Event identifiers
+    std::vector<unsigned long> m_obs_ids;    //!< Observation identifiers
+    std::vector<float>         m_phases;     //!< Phases (optional)
+    std::vector<float>         m_recon;      //!< Reconstruction info (optional)
+    std::string                m_recon_file; //!< File for deferred recon info
+    long long                  m_recon_size; //!< Size of deferred recon file
+    long long                  m_recon_time; //!< Modification time of recon file
+
+    // Event atom views and streamed chunks. The data for read access are
+    // indexed by the OpenMP thread number, and the data of a thread are
+    // only allocated by the thread itself. Data of threads beyond the
+    // number of threads available at creation of the list are kept in a map
+    // that is only accessed within a critical zone
+    mutable std::vector<thread_data*>   m_threads;       //!< Read access data
+    mutable std::map<int, thread_data*> m_threads_extra; //!< Additional data
+    GCTAEventAtom              m_edit;       //!< View for write access
+    int                        m_edit_index; //!< Index of write view (-1: none)
 
-    // IRF cache for diffuse models
-    mutable std::vector<std::string>          m_irf_names;  //!< Model names
-    mutable std::vector<std::vector<double> > m_irf_values; //!< IRF values
+    // Event streaming
+    std::string                m_stream_file;  //!< Streamed event file
+    mutable GFits*             m_stream_fits;  //!< Open streamed event file
+    GFitsTable*                m_stream_table; //!< Streamed table in memory
+    int                        m_stream_rows;  //!< Number of streamed events
+    int                        m_chunk_size;   //!< Rows per streamed chunk
+
+    // IRF cache for diffuse models. The entries are never moved once they
+    // are linked into the list, hence the list can be searched without
+    // locking while entries are appended by other threads
+    mutable irf_cache_entry*   m_irf_first;  //!< First IRF cache entry
+    mutable irf_cache_entry*   m_irf_last;   //!< Last IRF cache entry
 };
 
 
@@ -128,7 +239,7 @@ std::string GCTAEventList::classname(void) const
 inline
 int GCTAEventList::size(void) const
 {
-    return (m_events.size());
+    return (is_streamed() ? m_stream_rows : int(m_logE.size()));
 }
 
 
@@ -140,7 +251,7 @@ int GCTAEventList::size(void) const
 inline
 int GCTAEventList::number(void) const
 {
-    return (m_events.size());
+    return (size());
 }
 
 
@@ -161,13 +272,45 @@ const GCTARoi& GCTAEventList::roi(void) const
  *
  * @param[in] number Number of events.
  *
- * Reserves space for number events in the event list.
+ * Reserves space for number events in the event list. Space for the
+ * optional phase and reconstruction columns is not reserved.
  ***************************************************************************/
 inline
 void GCTAEventList::reserve(const int& number)
 {
-    m_events.reserve(number);
+    m_ra.reserve(number);
+    m_dec.reserve(number);
+    m_detx.reserve(number);
+    m_dety.reserve(number);
+    m_logE.reserve(number);
+    m_times.reserve(number);
+    m_event_ids.reserve(number);
+    m_obs_ids.reserve(number);
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Signal if events are streamed from the event file
+ *
+ * @return True if events are streamed from the event file.
+ ***************************************************************************/
+inline
+bool GCTAEventList::is_streamed(void) const
+{
+    return (m_chunk_size > 0);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of rows per streamed chunk
+ *
+ * @return Number of rows per streamed chunk (0 if events are not streamed).
+ ***************************************************************************/
+inline
+int GCTAEventList::chunk_size(void) const
+{
+    return (m_chunk_size);
+}
+
 #endif /* GCTAEVENTLIST_HPP */
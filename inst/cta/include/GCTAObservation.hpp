@@ -90,6 +90,7 @@ public:
     // Overwrite virtual base class methods
     virtual const GEvents* events(void) const;
     virtual void           events(const GEvents& events);
+    virtual bool           is_threadsafe(void) const;
 
     // Other methods
     bool                has_response(void) const;
@@ -124,6 +125,8 @@ public:
     void                deadc(const double& deadc);
     void                eventfile(const std::string& filename);
     const std::string&  eventfile(void) const;
+    void                chunk_size(const int& chunk_size);
+    const int&          chunk_size(void) const;
     void                dispose_events(void);
     const double&       lo_user_thres(void) const;
     const double&       hi_user_thres(void) const;
@@ -151,6 +154,7 @@ protected:
     double        m_dec_obj;       //!< Declination of object (degrees)
     double        m_lo_user_thres; //!< User defined lower energy threshold
     double        m_hi_user_thres; //!< User defined upper energy boundary
+    int           m_chunk_size;    //!< Rows per streamed chunk (0: no streaming)
 
     // Special protected member for GCTAModelCubeBackground friend
     std::string   m_bgdfile;     //!< Background filename
@@ -409,6 +413,36 @@ const std::string& GCTAObservation::eventfile(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Set number of rows per streamed chunk
+ *
+ * @param[in] chunk_size Number of rows per streamed chunk (0: no streaming).
+ *
+ * If @p chunk_size is positive, event lists are streamed from the event
+ * file in chunks of @p chunk_size rows when they are loaded (see
+ * GCTAEventList::stream()). The setting applies to the next load of the
+ * event file.
+ ***************************************************************************/
+inline
+void GCTAObservation::chunk_size(const int& chunk_size)
+{
+    m_chunk_size = (chunk_size > 0) ? chunk_size : 0;
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of rows per streamed chunk
+ *
+ * @return Number of rows per streamed chunk (0: no streaming).
+ ***************************************************************************/
+inline
+const int& GCTAObservation::chunk_size(void) const
+{
+    return m_chunk_size;
+}
+
+
 /***********************************************************************//**
  * @brief Return user low energy threshold
  *
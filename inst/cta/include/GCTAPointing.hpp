@@ -95,7 +95,7 @@ protected:
     void init_members(void);
     void copy_members(const GCTAPointing& pnt);
     void free_members(void);
-    void update(void) const;
+    void update(void);
 
     // Protected members
     GSkyDir             m_dir;         //!< Pointing direction in sky coordinates
@@ -108,10 +108,7 @@ protected:
     GTime               m_table_tmin;  //!< Min time bound in table
     GTime               m_table_tmax;  //!< Max time bound in table
     GTimeReference      m_reference;   //!< Time reference
-
-    // Cached members
-    mutable bool    m_has_cache;  //!< Has transformation cache
-    mutable GMatrix m_Rback;      //!< Rotation matrix
+    GMatrix             m_Rback;       //!< Rotation matrix
 };
 
 
@@ -96,28 +96,32 @@ public:
     
 
 private:
+    // PSF parameters
+    struct parameters {
+        int    id;     //!< Identifier of PSF
+        double logE;   //!< Energy
+        double theta;  //!< Offset angle
+        double norm;   //!< Global normalization
+        double norm2;  //!< Gaussian 2 normalization
+        double norm3;  //!< Gaussian 3 normalization
+        double sigma1; //!< Gaussian 1 sigma
+        double sigma2; //!< Gaussian 2 sigma
+        double sigma3; //!< Gaussian 3 sigma
+        double width1; //!< Gaussian 1 width
+        double width2; //!< Gaussian 2 width
+        double width3; //!< Gaussian 3 width
+    };
+
     // Methods
-    void init_members(void);
-    void copy_members(const GCTAPsf2D& psf);
-    void free_members(void);
-    void update(const double& logE, const double& theta) const;
+    void              init_members(void);
+    void              copy_members(const GCTAPsf2D& psf);
+    void              free_members(void);
+    const parameters& update(const double& logE, const double& theta) const;
 
     // Members
     std::string       m_filename;   //!< Name of Aeff response file
     GCTAResponseTable m_psf;        //!< PSF response table
-
-    // Precomputation cache
-    mutable double    m_par_logE;   //!< Cache energy
-    mutable double    m_par_theta;  //!< Cache offset angle
-    mutable double    m_norm;       //!< Global normalization
-    mutable double    m_norm2;      //!< Gaussian 2 normalization
-    mutable double    m_norm3;      //!< Gaussian 3 normalization
-    mutable double    m_sigma1;     //!< Gaussian 1 sigma
-    mutable double    m_sigma2;     //!< Gaussian 2 sigma
-    mutable double    m_sigma3;     //!< Gaussian 3 sigma
-    mutable double    m_width1;     //!< Gaussian 1 width
-    mutable double    m_width2;     //!< Gaussian 2 width
-    mutable double    m_width3;     //!< Gaussian 3 width
+    int               m_id;         //!< Identifier for parameter cache
 };
 
 
@@ -155,16 +159,5 @@ const GCTAResponseTable& GCTAPsf2D::table(void) const
     return m_psf;
 }
 
-/***********************************************************************//**
- * @brief Assign response table
- *
- * @param[in] table Response table.
- ***************************************************************************/
-inline
-void GCTAPsf2D::table(const GCTAResponseTable& table)
-{
-     m_psf = table;
-}
-
 
 #endif /* GCTAPSF2D_HPP */
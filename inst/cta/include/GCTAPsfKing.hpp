@@ -94,23 +94,27 @@ public:
 
 
 private:
+    // PSF parameters
+    struct parameters {
+        int    id;     //!< Identifier of PSF
+        double logE;   //!< Energy
+        double theta;  //!< Offset angle
+        double norm;   //!< King profile normalization
+        double sigma;  //!< King profile sigma (radians)
+        double sigma2; //!< King profile sigma squared
+        double gamma;  //!< King profile gamma parameter
+    };
+
     // Methods
-    void init_members(void);
-    void copy_members(const GCTAPsfKing& psf);
-    void free_members(void);
-    void update(const double& logE, const double& theta) const;
+    void              init_members(void);
+    void              copy_members(const GCTAPsfKing& psf);
+    void              free_members(void);
+    const parameters& update(const double& logE, const double& theta) const;
 
     // Members
     std::string       m_filename;   //!< Name of Aeff response file
     GCTAResponseTable m_psf;        //!< PSF response table
-
-    // Evaluation cache
-    mutable double m_par_logE;   //!< Cache energy
-    mutable double m_par_theta;  //!< Cache offset angle
-    mutable double m_par_norm;   //!< King profile normalization
-    mutable double m_par_sigma;  //!< King profile sigma (radians)
-    mutable double m_par_sigma2; //!< King profile sigma squared
-    mutable double m_par_gamma;  //!< King profile gamma parameter
+    int               m_id;         //!< Identifier for parameter cache
 };
 
 
@@ -150,16 +154,5 @@ const GCTAResponseTable& GCTAPsfKing::table(void) const
     return m_psf;
 }
 
-/***********************************************************************//**
- * @brief Assign response table
- *
- * @param[in] table Response table.
- ***************************************************************************/
-inline
-void GCTAPsfKing::table(const GCTAResponseTable& table)
-{
-     m_psf = table;
-}
-
 
 #endif /* GCTAPsfKing_HPP */
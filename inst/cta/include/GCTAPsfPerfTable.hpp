@@ -86,11 +86,18 @@ public:
     std::string       print(const GChatter& chatter = NORMAL) const;
 
 private:
+    // PSF parameters
+    struct parameters {
+        double scale; //!< Gaussian normalization
+        double sigma; //!< Gaussian sigma (radians)
+        double width; //!< Gaussian width parameter
+    };
+
     // Methods
-    void init_members(void);
-    void copy_members(const GCTAPsfPerfTable& psf);
-    void free_members(void);
-    void update(const double& logE) const;
+    void       init_members(void);
+    void       copy_members(const GCTAPsfPerfTable& psf);
+    void       free_members(void);
+    parameters compute(const double& logE) const;
 
     // Members
     std::string         m_filename;  //!< Name of Aeff response file
@@ -98,12 +105,6 @@ private:
     std::vector<double> m_r68;       //!< 68% containment radius of PSF in degrees
     std::vector<double> m_r80;       //!< 80% containment radius of PSF in degrees
     std::vector<double> m_sigma;     //!< Sigma value of PSF in radians
-
-    // Precomputation cache
-    mutable double      m_par_logE;  //!< Energy for which precomputation is done
-    mutable double      m_par_scale; //!< Gaussian normalization
-    mutable double      m_par_sigma; //!< Gaussian sigma (radians)
-    mutable double      m_par_width; //!< Gaussian width parameter
 };
 
 
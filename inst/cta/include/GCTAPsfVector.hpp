@@ -87,23 +87,24 @@ public:
     void read(const GFitsTable& table);
 
 private:
+    // PSF parameters
+    struct parameters {
+        double scale; //!< Gaussian normalization
+        double sigma; //!< Gaussian sigma (radians)
+        double width; //!< Gaussian width parameter
+    };
+
     // Methods
-    void init_members(void);
-    void copy_members(const GCTAPsfVector& psf);
-    void free_members(void);
-    void update(const double& logE) const;
+    void       init_members(void);
+    void       copy_members(const GCTAPsfVector& psf);
+    void       free_members(void);
+    parameters compute(const double& logE) const;
 
     // Members
     std::string         m_filename;  //!< Name of Aeff response file
     GNodeArray          m_logE;      //!< log(E) nodes for Aeff interpolation
     std::vector<double> m_r68;       //!< 68% containment radius of PSF in degrees
     std::vector<double> m_sigma;     //!< Sigma value of PSF in radians
-
-    // Precomputation cache
-    mutable double      m_par_logE;  //!< Energy for which precomputation is done
-    mutable double      m_par_scale; //!< Gaussian normalization
-    mutable double      m_par_sigma; //!< Gaussian sigma (radians)
-    mutable double      m_par_width; //!< Gaussian width parameter
 };
 
 
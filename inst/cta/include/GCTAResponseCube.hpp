@@ -110,13 +110,24 @@ public:
     void                      psf(const GCTACubePsf& psf);
     const GCTACubeBackground& background(void) const;
     void                      background(const GCTACubeBackground& background);
+    bool                      psf_convolve(void) const;
+    void                      psf_convolve(const bool& psf_convolve);
 
 private:
+    // Response cache entry of a model
+    struct cache_entry {
+        int             id;     //!< Interned model name
+        GCTACubeSource* source; //!< Source response
+        cache_entry*    next;   //!< Next cache entry
+    };
+
     // Private methods
-    void   init_members(void);
-    void   copy_members(const GCTAResponseCube& rsp);
-    void   free_members(void);
-    int    cache_index(const std::string& name) const;
+    void            init_members(void);
+    void            copy_members(const GCTAResponseCube& rsp);
+    void            free_members(void);
+    void            cache_clear(void);
+    GCTACubeSource* cache_find(const int& id) const;
+    void            cache_append(const int& id, GCTACubeSource* source) const;
     double psf_radial(const GModelSpatialRadial* model,
                       const double&              rho_obs,
                       const GSkyDir&             obsDir,
@@ -130,13 +141,17 @@ private:
                           const GTime&                   srcTime) const;
 
     // Private data members
-    GCTACubeExposure   m_exposure;    //!< Exposure cube
-    GCTACubePsf        m_psf;         //!< Mean point spread function
-    GCTACubeBackground m_background;  //!< Background cube
-    mutable bool       m_apply_edisp; //!< Apply energy dispersion
-
-    // Response cache
-    mutable std::vector<GCTACubeSource*> m_cache; //!< Response cache
+    GCTACubeExposure   m_exposure;     //!< Exposure cube
+    GCTACubePsf        m_psf;          //!< Mean point spread function
+    GCTACubeBackground m_background;   //!< Background cube
+    mutable bool       m_apply_edisp;  //!< Apply energy dispersion
+    bool               m_psf_convolve; //!< Convolve diffuse maps with Psf
+
+    // Response cache. The entries are never moved once they are linked
+    // into the list, hence the list can be searched without locking while
+    // entries are appended by other threads
+    mutable cache_entry* m_cache_first; //!< First response cache entry
+    mutable cache_entry* m_cache_last;  //!< Last response cache entry
 };
 
 
@@ -292,4 +307,16 @@ const GCTACubeBackground& GCTAResponseCube::background(void) const
     return (m_background);
 }
 
+
+/***********************************************************************//**
+ * @brief Signal if diffuse models are convolved with the Psf
+ *
+ * @return True if diffuse models are convolved with the Psf.
+ ***************************************************************************/
+inline
+bool GCTAResponseCube::psf_convolve(void) const
+{
+    return (m_psf_convolve);
+}
+
 #endif /* GCTARESPONSECUBE_HPP */
@@ -100,6 +100,10 @@ public:
     virtual double   irf_diffuse(const GEvent&       event,
                                  const GSource&      source,
                                  const GObservation& obs) const;
+    virtual double   irf_gradients(const GEvent&       event,
+                                   const GSource&      source,
+                                   const GObservation& obs) const;
+    virtual bool     has_irf_gradients(const GModelSpatial& model) const;
     virtual double   npred_radial(const GSource&      source,
                                   const GObservation& obs) const;
     virtual double   npred_elliptical(const GSource&      source,
@@ -171,6 +175,15 @@ private:
     void        copy_members(const GCTAResponseIrf& rsp);
     void        free_members(void);
     std::string irf_filename(const std::string& filename) const;
+    double      irf_ptsrc_gradients(const GEvent&       event,
+                                    const GSource&      source,
+                                    const GObservation& obs) const;
+    double      irf_radial_gradients(const GEvent&       event,
+                                     const GSource&      source,
+                                     const GObservation& obs) const;
+    double      irf_elliptical_gradients(const GEvent&       event,
+                                         const GSource&      source,
+                                         const GObservation& obs) const;
 
     // Private data members
     GCaldb          m_caldb;          //!< Calibration database
@@ -60,9 +60,16 @@ public:
     // Implement other methods
     void   append(const GCTAEventAtom& event);
     void   reserve(const int& number);
+    void   stream(const std::string& filename, const int& chunk_size);
+    void   stream(const GFitsTable& table, const int& chunk_size);
+    bool   is_streamed(void) const;
+    int    chunk_size(void) const;
     double irf_cache(const std::string& name, const int& index) const;
+    double irf_cache(const int& id, const int& index) const;
     void   irf_cache(const std::string& name, const int& index,
                      const double& irf) const;
+    void   irf_cache(const int& id, const int& index,
+                     const double& irf) const;
 };
 
 
@@ -73,9 +80,13 @@ public:
     GCTAEventList copy() {
         return (*self);
     }
-    GCTAEventAtom* __getitem__(int index) {
-        if (index >= 0 && index < self->size())
-            return (*self)[index];
+    GCTAEventAtom __getitem__(int index) {
+        if (index >= 0 && index < self->size() && self->is_streamed()) {
+            const GCTAEventList* list = self;
+            return *((*list)[index]);
+        }
+        else if (index >= 0 && index < self->size())
+            return *((*self)[index]);
         else
             throw GException::out_of_range("__getitem__(int)", index, self->size());
     }
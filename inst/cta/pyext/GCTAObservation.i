@@ -62,6 +62,7 @@ public:
     // Overwrite virtual base class methods
     virtual const GEvents* events(void) const;
     virtual void           events(const GEvents& events);
+    virtual bool           is_threadsafe(void) const;
 
     // Other methods
     bool                has_response(void) const;
@@ -96,6 +97,8 @@ public:
     void                deadc(const double& deadc);
     void                eventfile(const std::string& filename);
     const std::string&  eventfile(void) const;
+    void                chunk_size(const int& chunk_size);
+    const int&          chunk_size(void) const;
     void                dispose_events(void);
     const double&       lo_user_thres(void) const;
     const double&       hi_user_thres(void) const;
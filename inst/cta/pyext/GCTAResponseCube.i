@@ -86,6 +86,8 @@ public:
     void                      psf(const GCTACubePsf& psf);
     const GCTACubeBackground& background(void) const;
     void                      background(const GCTACubeBackground& background);
+    bool                      psf_convolve(void) const;
+    void                      psf_convolve(const bool& psf_convolve);
 };
 
 
@@ -123,6 +123,10 @@ public:
     virtual double   irf_diffuse(const GEvent&       event,
                                  const GSource&      source,
                                  const GObservation& obs) const;
+    virtual double   irf_gradients(const GEvent&       event,
+                                   const GSource&      source,
+                                   const GObservation& obs) const;
+    virtual bool     has_irf_gradients(const GModelSpatial& model) const;
     virtual double   npred_radial(const GSource&      source,
                                   const GObservation& obs) const;
     virtual double   npred_elliptical(const GSource&      source,
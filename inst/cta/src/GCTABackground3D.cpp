@@ -184,35 +184,35 @@ double GCTABackground3D::operator()(const double& logE,
     const GNodeArray& dety_nodes   = m_background.nodes(1);
     const GNodeArray& energy_nodes = m_background.nodes(2);
 
-    // Set values for node arrays
-    detx_nodes.set_value(detx);
-    dety_nodes.set_value(dety);
-    energy_nodes.set_value(logE);
+    // Get indices and weighting factors for node arrays
+    GNodeArray::interpolation w_detx   = detx_nodes.interpolate(detx);
+    GNodeArray::interpolation w_dety   = dety_nodes.interpolate(dety);
+    GNodeArray::interpolation w_energy = energy_nodes.interpolate(logE);
 
     // Compute offsets of DETY in DETX-DETY plane
     int size1        = m_background.axis(0);
-    int offset_left  = dety_nodes.inx_left()  * size1;
-    int offset_right = dety_nodes.inx_right() * size1;
+    int offset_left  = w_dety.inx_left  * size1;
+    int offset_right = w_dety.inx_right * size1;
 
     // Set indices for bi-linear interpolation in DETX-DETY plane
-    int inx_ll = detx_nodes.inx_left()  + offset_left;
-    int inx_lr = detx_nodes.inx_left()  + offset_right;
-    int inx_rl = detx_nodes.inx_right() + offset_left;
-    int inx_rr = detx_nodes.inx_right() + offset_right;
+    int inx_ll = w_detx.inx_left  + offset_left;
+    int inx_lr = w_detx.inx_left  + offset_right;
+    int inx_rl = w_detx.inx_right + offset_left;
+    int inx_rr = w_detx.inx_right + offset_right;
 
     // Set weighting factors for bi-linear interpolation in DETX-DETY plane
-    double wgt_ll = detx_nodes.wgt_left()  * dety_nodes.wgt_left();
-    double wgt_lr = detx_nodes.wgt_left()  * dety_nodes.wgt_right();
-    double wgt_rl = detx_nodes.wgt_right() * dety_nodes.wgt_left();
-    double wgt_rr = detx_nodes.wgt_right() * dety_nodes.wgt_right();
+    double wgt_ll = w_detx.wgt_left  * w_dety.wgt_left;
+    double wgt_lr = w_detx.wgt_left  * w_dety.wgt_right;
+    double wgt_rl = w_detx.wgt_right * w_dety.wgt_left;
+    double wgt_rr = w_detx.wgt_right * w_dety.wgt_right;
 
     // Set indices for energy interpolation
-    int inx_emin = energy_nodes.inx_left();
-    int inx_emax = energy_nodes.inx_right();
+    int inx_emin = w_energy.inx_left;
+    int inx_emax = w_energy.inx_right;
 
     // Set weighting factors for energy interpolation
-    double wgt_emin = energy_nodes.wgt_left();
-    double wgt_emax = energy_nodes.wgt_right();
+    double wgt_emin = w_energy.wgt_left;
+    double wgt_emax = w_energy.wgt_right;
 
     // Compute offsets in energy dimension
     int npixels     = m_background.axis(0) * m_background.axis(1);
@@ -472,36 +472,25 @@ GCTAInstDir GCTABackground3D::mc(const GEnergy& energy,
             throw GException::invalid_value(G_MC, msg);
         }
 
-        // Get uniform random number
-        double u = ran.uniform();
-
-        // Get pixel index according to random number. We use a bi-section
-        // method to find the corresponding response cube pixel
-        int offset = index * (m_mc_npix+1);
-        int low    = offset;
-        int high   = offset + m_mc_npix;
-        while ((high - low) > 1) {
-            int mid = (low+high) / 2;
-            if (u < m_mc_cache[mid]) {
-                high = mid;
-            }
-            else if (m_mc_cache[mid] <= u) {
-                low = mid;
-            }
-        }
+        // Continue only if the map has a positive rate
+        if (m_mc_cache[index].total() > 0.0) {
+
+            // Get pixel index from the alias table of the map
+            int pixel = m_mc_cache[index].draw(ran);
+
+            // Get pixel indices in x and y
+            int idetx = pixel % m_mc_nx;
+            int idety = pixel / m_mc_nx;
 
-        // Get pixel indices in x and y
-        int pixel = low - offset;
-        int idetx = pixel % m_mc_nx;
-        int idety = pixel / m_mc_nx;
+            // Get randomized detx and dety
+            double detx = m_mc_detx_min + (idetx + ran.uniform()) * m_mc_detx_bin;
+            double dety = m_mc_dety_min + (idety + ran.uniform()) * m_mc_dety_bin;
 
-        // Get randomized detx and dety
-        double detx = m_mc_detx_min + (idetx + ran.uniform()) * m_mc_detx_bin;
-        double dety = m_mc_dety_min + (idety + ran.uniform()) * m_mc_dety_bin;
+            // Set instrument direction (in radians)
+            dir.detx(detx * gammalib::deg2rad);
+            dir.dety(dety * gammalib::deg2rad);
 
-        // Set instrument direction (in radians)
-        dir.detx(detx * gammalib::deg2rad);
-        dir.dety(dety * gammalib::deg2rad);
+        } // endif: map had a positive rate
 
     } // endif: there were cube pixels and maps
 
@@ -716,52 +705,40 @@ void GCTABackground3D::init_mc_cache(void) const
     // Continue only if there are pixels and maps
     if (m_mc_npix > 0 && m_mc_nmaps > 0) {
 
-        // Reserve space for all pixels in cache
-        m_mc_cache.reserve((m_mc_npix+1)*m_mc_nmaps);
+        // Reserve space for the alias tables of all maps
+        m_mc_cache.reserve(m_mc_nmaps);
 
         // Loop over all maps
         for (int i = 0; i < m_mc_nmaps; ++i) {
 
-            // Compute pixel offset
-            int offset = i * (m_mc_npix+1);
-
             // Get logE
             //double logE = m_background.nodes(2)[i];
             double logE = m_mc_logE_min + (i+0.5) * m_mc_logE_bin;
 
-            // Set first cache value to 0
-            m_mc_cache.push_back(0.0);
-
-            // Initialise cache with cumulative pixel fluxes and compute
-            // total flux in response table for normalization. Negative
-            // pixels are excluded from the cumulative map.
-            double total_rate = 0.0;
-            double xmin       = m_mc_detx_min * gammalib::deg2rad;
-            double xbin       = m_mc_detx_bin * gammalib::deg2rad;
-            double ymin       = m_mc_dety_min * gammalib::deg2rad;
-            double ybin       = m_mc_dety_bin * gammalib::deg2rad;
-            double detx       = xmin + 0.5 * xbin;
+            // Initialise pixel rates and compute total rate in response
+            // table. Negative pixels are excluded from the alias table.
+            // Pixels are stored with DETX as the most rapidly varying
+            // index, as expected by the mc() method.
+            std::vector<double> rates(m_mc_npix, 0.0);
+            double              total_rate = 0.0;
+            double              xmin       = m_mc_detx_min * gammalib::deg2rad;
+            double              xbin       = m_mc_detx_bin * gammalib::deg2rad;
+            double              ymin       = m_mc_dety_min * gammalib::deg2rad;
+            double              ybin       = m_mc_dety_bin * gammalib::deg2rad;
+            double              detx       = xmin + 0.5 * xbin;
             for (int ix = 0; ix < m_mc_nx; ++ix, detx += xbin) {
                 double dety = ymin + 0.5 * ybin;
                 for (int iy = 0; iy < m_mc_ny; ++iy, dety += ybin) {
                     double rate = (*this)(logE, detx, dety) * solidangle;
                     if (rate > 0.0) {
-                        total_rate += rate;
+                        rates[ix+iy*m_mc_nx] = rate; // units: events/s/MeV
+                        total_rate          += rate;
                     }
-                    m_mc_cache.push_back(total_rate); // units: events/s/MeV
-                }
-            }
-
-            // Normalize cumulative pixel fluxes so that the values in the
-            // cache run from 0 to 1
-            if (total_rate > 0.0) {
-                for (int k = 0, element = offset; k < m_mc_npix; ++k, ++element) {
-                    m_mc_cache[element] /= total_rate;
                 }
             }
 
-            // Make sure that last pixel in the cache is >1
-            m_mc_cache[m_mc_npix+offset] = 1.0001;
+            // Build alias table for the map
+            m_mc_cache.push_back(GRanAlias(rates));
 
             // Set energy value (unit independent)
             GEnergy energy;
@@ -781,11 +758,11 @@ void GCTABackground3D::init_mc_cache(void) const
 
         } // endfor: looped over all maps
 
-        // Dump cache values for debugging
+        // Dump cache for debugging
         #if defined(G_DEBUG_CACHE)
         for (int i = 0; i < m_mc_cache.size(); ++i) {
-            std::cout << "i=" << i;
-            std::cout << " c=" << m_mc_cache[i] << std::endl;
+            std::cout << "i=" << i << std::endl;
+            std::cout << m_mc_cache[i].print() << std::endl;
         }
         #endif
 
@@ -35,15 +35,24 @@
 #include "GFits.hpp"
 #include "GFitsBinTable.hpp"
 #include "GObservations.hpp"
+#include "GModels.hpp"
 #include "GCTAEventCube.hpp"
+#include "GCTAEventList.hpp"
 #include "GCTAObservation.hpp"
 #include "GCTARoi.hpp"
 #include "GCTAInstDir.hpp"
+#include "GCTASupport.hpp"
 #include "GCTACubeBackground.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Method name definitions ____________________________________________ */
 #define G_READ                             "GCTACubeBackground::read(GFits&)"
 #define G_MC                "GCTACubeBackground::mc(GEnergy&, GTime&, GRan&)"
+#define G_FILL                      "GCTACubeBackground::fill(GObservations&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -55,6 +64,7 @@
 #define G_LOG_INTERPOLATION   //!< Energy interpolate log10(background rate)
 
 /* __ Constants __________________________________________________________ */
+const int fill_block_size = 1024;  //!< Number of bins per fill work item
 
 
 /*==========================================================================
@@ -207,12 +217,12 @@ GCTACubeBackground& GCTACubeBackground::operator=(const GCTACubeBackground& bgd)
 double GCTACubeBackground::operator()(const GCTAInstDir& dir,
                                       const GEnergy&     energy) const
 {
-    // Set indices and weighting factors for interpolation
-    update(energy.log10TeV());
+    // Get indices and weighting factors for interpolation
+    GNodeArray::interpolation wgt = m_elogmeans.interpolate(energy.log10TeV());
 
     // Perform interpolation
-    double background = m_wgt_left  * m_cube(dir.dir(), m_inx_left) +
-                        m_wgt_right * m_cube(dir.dir(), m_inx_right);
+    double background = wgt.wgt_left  * m_cube(dir.dir(), wgt.inx_left) +
+                        wgt.wgt_right * m_cube(dir.dir(), wgt.inx_right);
 
     // Make sure that background rate does not become negative
     if (background < 0.0) {
@@ -266,10 +276,23 @@ GCTACubeBackground* GCTACubeBackground::clone(void) const
  *
  * @exception GException::invalid_value
  *            No event list found in CTA observations.
+ * @exception GException::runtime_error
+ *            Filling of background cube failed.
  *
  * Set the background cube by computing the livetime weighted background rate
  * for all CTA observations in an observation container. The cube pixel
  * values are computed as the sum over the background rates.
+ *
+ * The cube is filled in parallel. The work is split into blocks of cube
+ * bins for each observation, and each thread accumulates the background
+ * rates of its blocks in its own event cube. The models are evaluated for
+ * lightweight copies of the observations that hold the response, pointing
+ * and times of the observations, but no events. These copies are shared by
+ * all threads since the response functions can be evaluated concurrently.
+ * As the models keep evaluation caches, the first thread evaluates the
+ * models of the container while all other threads evaluate their own copy
+ * of the models. The partial cubes are summed using
+ * gammalib::cta_reduce_maps().
  ***************************************************************************/
 void GCTACubeBackground::fill(const GObservations& obs)
 {
@@ -279,74 +302,135 @@ void GCTACubeBackground::fill(const GObservations& obs)
     // Initialise event cube to evaluate models
     GCTAEventCube eventcube = GCTAEventCube(m_cube, m_ebounds, obs[0]->events()->gti());
 
-    // Initialise total livetime
-    double total_livetime = 0.0;
-
-    // Loop over all observations in container
+    // Setup for all CTA observations a lightweight copy without events but
+    // with an empty event list holding the RoI, energy boundaries and GTIs.
+    // Accumulate total livetime.
+    std::vector<const GCTAObservation*> ctas;
+    std::vector<GCTAObservation>        shells;
+    double                              total_livetime = 0.0;
     for (int i = 0; i < obs.size(); ++i) {
-
-        // Get observation and continue only if it is a CTA observation
         const GCTAObservation* cta = dynamic_cast<const GCTAObservation*>(obs[i]);
-
         if (cta != NULL) {
+            GCTAEventList list;
+            list.roi(cta->roi());
+            list.ebounds(cta->events()->ebounds());
+            list.gti(cta->gti());
+            GCTAObservation shell(cta->instrument());
+            shell.name(cta->name());
+            shell.id(cta->id());
+            shell.response(*cta->response());
+            shell.pointing(cta->pointing());
+            shell.ontime(cta->ontime());
+            shell.livetime(cta->livetime());
+            shell.deadc(cta->deadc(GTime()));
+            shell.events(list);
+            ctas.push_back(cta);
+            shells.push_back(shell);
+            total_livetime += cta->livetime();
+        }
+    }
 
-            // Extract region of interest from CTA observation
-            GCTARoi roi = cta->roi();
-
-            // Set GTI of actual observations as the GTI of the event cube
-            eventcube.gti(cta->gti());
-
-            // Get observation livetime
-            double livetime = cta->livetime();
-
-            // Loop over all bins in background cube
-            for (int i = 0; i < eventcube.size(); ++i) {
-
-                // Get event bin
-                GCTAEventBin* bin = eventcube[i];
-
-                // Continue only if binned in contained in ROI
-                if (roi.contains(*bin)) {
-
-                    // Compute model value for event bin. The model value is
-                    // given in counts/MeV/s/sr.
-                    double model = obs.models().eval(*bin, *cta);
-
-                    // Multiply by livetime to get the correct weighting for
-                    // each observation. We divide by the total livetime later
-                    // to get the background model in units of counts/MeV/s/sr.
-                    model *= livetime;
-
-                    // Add existing number of counts
-                    model += bin->counts();
-
-                    // Store cumulated value (units: counts/MeV/sr)
-                    bin->counts(model);
-
-                } // endif: bin was contained in RoI
-
-            } // endfor: looped over all bins
-
-            // Accumulate livetime
-            total_livetime += livetime;
+    // Determine work items and number of threads
+    int nbins    = eventcube.size();
+    int nblocks  = (nbins + fill_block_size - 1) / fill_block_size;
+    int nitems   = ctas.size() * nblocks;
+    int nthreads = gammalib::cta_fill_threads(nitems);
+
+    // Allocate partial background maps
+    std::vector<GSkymap>  maps(nthreads);
+    std::vector<GSkymap*> pmaps(nthreads);
+    for (int k = 0; k < nthreads; ++k) {
+        pmaps[k] = &maps[k];
+    }
 
-        } // endif: cta observation was vaild
+    // Initialise error message
+    std::string error;
+
+    // Fill partial cubes in parallel
+    #pragma omp parallel num_threads(nthreads)
+    {
+        // Get thread number
+        int thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+
+        // Get event cube and models of this thread. The first thread fills
+        // the event cube and evaluates the models of the container, all
+        // other threads use copies.
+        GCTAEventCube* cube   = (thread == 0) ? &eventcube
+                                              : new GCTAEventCube(eventcube);
+        const GModels* models = (thread == 0) ? &obs.models()
+                                              : new GModels(obs.models());
+
+        // Initialise index of current observation
+        int current = -1;
+
+        // Wait until all copies are done before the first thread modifies
+        // the event cube and the model caches
+        #pragma omp barrier
+
+        // Loop over work items
+        #pragma omp for schedule(dynamic)
+        for (int item = 0; item < nitems; ++item) {
+
+            // Determine observation and bin range of work item
+            int iobs  = item / nblocks;
+            int first = (item % nblocks) * fill_block_size;
+            int last  = (first + fill_block_size < nbins) ? first + fill_block_size : nbins;
+
+            // Fill bins, recording any error since exceptions must not
+            // leave the parallel region
+            try {
+
+                // Set GTI of the event cube if the observation changed
+                if (iobs != current) {
+                    cube->gti(shells[iobs].gti());
+                    current = iobs;
+                }
+
+                // Fill bins
+                fill_cube(shells[iobs], *models, first, last, cube);
+
+            }
+            catch (std::exception& e) {
+                #pragma omp critical(GCTACubeBackground_fill)
+                {
+                    if (error.empty()) {
+                        error = e.what();
+                    }
+                }
+            }
+
+        } // endfor: looped over work items
+
+        // Store partial background map
+        maps[thread] = cube->map();
+
+        // Free copies of event cube and models
+        if (thread != 0) {
+            delete cube;
+            delete models;
+        }
+
+    } // end pragma omp parallel
+
+    // Throw an exception if a work item failed
+    if (!error.empty()) {
+        std::string msg = "Filling of background cube failed: "+error;
+        throw GException::runtime_error(G_FILL, msg);
+    }
 
-    } // endfor: looped over all observations
+    // Sum partial background maps
+    gammalib::cta_reduce_maps(pmaps);
 
     // Re-normalize cube to get units of counts/MeV/s/sr
     if (total_livetime > 0.0) {
 
-      // Loop over all bins in background cube and divide the content
-      // by the total livetime.
-      for (int i = 0; i < eventcube.size(); ++i) {
-          GCTAEventBin* bin  = eventcube[i];
-          double        rate = bin->counts() / total_livetime;
-          bin->counts(rate);
-      }
-
-      // Set background cube values from event cube
-      m_cube = eventcube.map();
+        // Set background cube values from summed map, divided by the total
+        // livetime
+        m_cube  = maps[0];
+        m_cube /= total_livetime;
 
     } // endif: livetime was positive
 
@@ -369,18 +453,18 @@ void GCTACubeBackground::fill(const GObservations& obs)
  ***************************************************************************/
 double GCTACubeBackground::integral(const double& logE) const
 {
-    // Update interpolation cache
-    update(logE);
+    // Get indices and weighting factors for interpolation
+    GNodeArray::interpolation wgt = m_elogmeans.interpolate(logE);
 
     // Initialise result
     double result = 0.0;
 
     // Loop over all map pixels
-    for (int i = 0; i < m_cube.npix(); ++i) {
+    for (long long i = 0; i < m_cube.npix(); ++i) {
 
         // Get bin value
-        double value = m_wgt_left  * m_cube(i, m_inx_left) +
-                       m_wgt_right * m_cube(i, m_inx_right);
+        double value = wgt.wgt_left  * m_cube(i, wgt.inx_left) +
+                       wgt.wgt_right * m_cube(i, wgt.inx_right);
 
         // Sum bin contents
         result += value * m_cube.solidangle(i);
@@ -573,12 +657,6 @@ void GCTACubeBackground::init_members(void)
     m_ebounds.clear();
     m_elogmeans.clear();
 
-    // Initialise cache
-    m_inx_left  = 0;
-    m_inx_right = 0;
-    m_wgt_left  = 0.0;
-    m_wgt_right = 0.0;
-
     // Return
     return;
 }
@@ -597,12 +675,6 @@ void GCTACubeBackground::copy_members(const GCTACubeBackground& bgd)
     m_ebounds   = bgd.m_ebounds;
     m_elogmeans = bgd.m_elogmeans;
 
-    // Copy cache
-    m_inx_left  = bgd.m_inx_left;
-    m_inx_right = bgd.m_inx_right;
-    m_wgt_left  = bgd.m_wgt_left;
-    m_wgt_right = bgd.m_wgt_right;
-
     // Return
     return;
 }
@@ -654,26 +726,48 @@ void GCTACubeBackground::set_eng_axis(void)
 
 
 /***********************************************************************//**
- * @brief Update 1D cache
+ * @brief Add background rate of one observation to a range of cube bins
  *
- * @param[in] logE Log10 energy in TeV.
+ * @param[in] obs CTA observation.
+ * @param[in] models Models.
+ * @param[in] first Index of first bin.
+ * @param[in] last Index of bin after last bin.
+ * @param[in,out] cube Event cube.
  *
- * Updates the 1D interpolation cache. The interpolation cache is composed
- * of two indices and weights that define 2 data values of the 2D skymap
- * that are used for linear interpolation.
- *
- * @todo Write down formula
+ * Adds the livetime weighted model value to all bins in the range
+ * [@p first, @p last[ of @p cube that are within the region of interest
+ * of the observation. The model value is given in counts/MeV/s/sr, hence
+ * the cube bins are in units of counts/MeV/sr.
  ***************************************************************************/
-void GCTACubeBackground::update(const double& logE) const
+void GCTACubeBackground::fill_cube(const GCTAObservation& obs,
+                                   const GModels&         models,
+                                   const int&             first,
+                                   const int&             last,
+                                   GCTAEventCube*         cube) const
 {
-    // Set value for node array
-    m_elogmeans.set_value(logE);
-
-    // Set indices and weighting factors for interpolation
-    m_inx_left  = m_elogmeans.inx_left();
-    m_inx_right = m_elogmeans.inx_right();
-    m_wgt_left  = m_elogmeans.wgt_left();
-    m_wgt_right = m_elogmeans.wgt_right();
+    // Get region of interest and livetime of observation
+    const GCTARoi& roi      = obs.roi();
+    double         livetime = obs.livetime();
+
+    // Loop over bins
+    for (int i = first; i < last; ++i) {
+
+        // Get event bin
+        GCTAEventBin* bin = (*cube)[i];
+
+        // Continue only if binned in contained in ROI
+        if (roi.contains(*bin)) {
+
+            // Compute model value for event bin, multiplied by livetime to
+            // get the correct weighting for each observation
+            double model = models.eval(*bin, obs) * livetime;
+
+            // Store cumulated value (units: counts/MeV/sr)
+            bin->counts(bin->counts() + model);
+
+        } // endif: bin was contained in RoI
+
+    } // endfor: looped over bins
 
     // Return
     return;
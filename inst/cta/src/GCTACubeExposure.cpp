@@ -34,8 +34,16 @@
 #include "GCTAEventList.hpp"
 #include "GMath.hpp"
 #include "GTools.hpp"
+#include "GCTARoi.hpp"
+#include "GCTASupport.hpp"
+
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Method name definitions ____________________________________________ */
+#define G_FILL                      "GCTACubeExposure::fill(GObservations&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -44,6 +52,7 @@
 /* __ Debug definitions __________________________________________________ */
 
 /* __ Constants __________________________________________________________ */
+const int fill_block_size = 1024;  //!< Number of pixels per fill work item
 
 
 /*==========================================================================
@@ -234,12 +243,12 @@ GCTACubeExposure& GCTACubeExposure::operator=(const GCTACubeExposure& cube)
  ***************************************************************************/
 double GCTACubeExposure::operator()(const GSkyDir& dir, const GEnergy& energy) const
 { 
-    // Set indices and weighting factors for interpolation
-    update(energy.log10TeV());
+    // Get indices and weighting factors for interpolation
+    GNodeArray::interpolation wgt = m_elogmeans.interpolate(energy.log10TeV());
 
     // Perform interpolation
-    double exposure = m_wgt_left  * m_cube(dir, m_inx_left) +
-                      m_wgt_right * m_cube(dir, m_inx_right);
+    double exposure = wgt.wgt_left  * m_cube(dir, wgt.inx_left) +
+                      wgt.wgt_right * m_cube(dir, wgt.inx_right);
 
     // Make sure that exposure does not become negative
     if (exposure < 0.0) {
@@ -313,11 +322,14 @@ void GCTACubeExposure::set(const GCTAObservation& obs)
     // Continue only if response is valid
     if (rsp != NULL) {
 
+        // Get sky directions of all pixels
+        std::vector<GSkyDir> dirs = m_cube.inx2dir(0, m_cube.npix());
+
         // Loop over all pixels in sky map
-        for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
+        for (long long pixel = 0; pixel < m_cube.npix(); ++pixel) {
 
             // Get pixel sky direction
-            GSkyDir dir = m_cube.inx2dir(pixel);
+            const GSkyDir& dir = dirs[pixel];
             
             // Continue only if pixel is within RoI
             if (roi.centre().dir().dist_deg(dir) <= roi.radius()) {
@@ -360,10 +372,18 @@ void GCTACubeExposure::set(const GCTAObservation& obs)
  *
  * @exception GException::invalid_value
  *            No event list found in CTA observations.
+ * @exception GException::runtime_error
+ *            Filling of exposure cube failed.
  *
  * Set the exposure cube by summing the exposure for all CTA observations in
  * an observation container. The cube pixel values are computed as the sum
  * over the products of the effective area and the livetime.
+ *
+ * The cube is filled in parallel. The work is split into blocks of pixels
+ * for each observation, and each thread adds the exposure of its blocks to
+ * its own partial cube. The response of the observations is shared by all
+ * threads since the response functions can be evaluated concurrently. The
+ * partial cubes are finally summed using gammalib::cta_reduce_maps().
  ***************************************************************************/
 void GCTACubeExposure::fill(const GObservations& obs)
 {
@@ -372,61 +392,95 @@ void GCTACubeExposure::fill(const GObservations& obs)
     m_livetime = 0.0;
     m_cube     = 0.0;
 
-    // Loop over all observations in container
+    // Collect all CTA observations with a valid response, together with
+    // their region of interest. Append GTIs and increment livetime.
+    std::vector<const GCTAObservation*> ctas;
+    std::vector<GCTARoi>                rois;
     for (int i = 0; i < obs.size(); ++i) {
-
-        // Get observation and continue only if it is a CTA observation
         const GCTAObservation* cta = dynamic_cast<const GCTAObservation*>(obs[i]);
-        if (cta != NULL) {
-
-            // Extract region of interest from CTA observation
-            GCTARoi roi = cta->roi();
-
-            // Get references on CTA response and pointing direction
-            const GCTAResponseIrf* rsp = dynamic_cast<const GCTAResponseIrf*>(cta->response());
-            const GSkyDir&         pnt = cta->pointing().dir();
-
-            // Continue only if response is valid
-            if (rsp != NULL) {
-            
-                // Loop over all pixels in sky map
-                for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
-
-                    // Get pixel sky direction
-                    GSkyDir dir = m_cube.inx2dir(pixel);
-                    
-                    // Continue only if pixel is within RoI
-                    if (roi.centre().dir().dist_deg(dir) <= roi.radius()) {
-
-                        // Compute theta angle with respect to pointing
-                        // direction in radians
-                        double theta = pnt.dist(dir);
-    
-                        // Loop over all exposure cube energy bins
-                        for (int iebin = 0; iebin < m_ebounds.size(); ++iebin){
-
-                            // Get logE/TeV
-                            double logE = m_ebounds.elogmean(iebin).log10TeV();
-
-                            // Add to exposure cube (effective area * livetime)
-                            m_cube(pixel, iebin) += rsp->aeff(theta, 0.0, 0.0, 0.0, logE) *
-                                                    cta->livetime();
+        if (cta != NULL &&
+            dynamic_cast<const GCTAResponseIrf*>(cta->response()) != NULL) {
+            ctas.push_back(cta);
+            rois.push_back(cta->roi());
+            m_gti.extend(cta->gti());
+            m_livetime += cta->livetime();
+        }
+    }
 
-                        } // endfor: looped over energy bins
+    // Get sky directions of all pixels
+    std::vector<GSkyDir> dirs = m_cube.inx2dir(0, m_cube.npix());
 
-                    } // endif: pixel within RoI
+    // Determine work items and number of threads
+    long long npix     = m_cube.npix();
+    int       nblocks  = int((npix + fill_block_size - 1) / fill_block_size);
+    int       nitems   = ctas.size() * nblocks;
+    int       nthreads = gammalib::cta_fill_threads(nitems);
 
-                } // endfor: looped over all pixels
+    // Setup partial cubes. The first thread fills the exposure cube itself.
+    std::vector<GSkymap>  partials(nthreads-1, m_cube);
+    std::vector<GSkymap*> cubes(nthreads, &m_cube);
+    for (int k = 1; k < nthreads; ++k) {
+        cubes[k] = &partials[k-1];
+    }
 
-                // Append GTIs and increment livetime
-                m_gti.extend(cta->gti());
-                m_livetime += cta->livetime();
-            
-            } // endif: response was valid
-    
-        } // endif: observation was a CTA observation
+    // Initialise error message
+    std::string error;
+
+    // Fill partial cubes in parallel
+    #pragma omp parallel num_threads(nthreads)
+    {
+        // Get partial cube of this thread
+        int thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+        GSkymap* cube = cubes[thread];
+
+        // Loop over work items
+        #pragma omp for schedule(dynamic)
+        for (int item = 0; item < nitems; ++item) {
+
+            // Determine observation and pixel range of work item
+            int       iobs  = item / nblocks;
+            long long first = (long long)(item % nblocks) * fill_block_size;
+            long long last  = (first + fill_block_size < npix) ? first + fill_block_size : npix;
+
+            // Fill pixels, recording any error since exceptions must not
+            // leave the parallel region
+            try {
+
+                // Get response of observation. The response functions do
+                // not modify the response, hence they can be evaluated by
+                // several threads concurrently.
+                const GCTAResponseIrf* rsp =
+                      static_cast<const GCTAResponseIrf*>(ctas[iobs]->response());
+
+                // Fill pixels
+                fill_cube(*ctas[iobs], *rsp, rois[iobs], dirs, first, last,
+                          cube);
+
+            }
+            catch (std::exception& e) {
+                #pragma omp critical(GCTACubeExposure_fill)
+                {
+                    if (error.empty()) {
+                        error = e.what();
+                    }
+                }
+            }
+
+        } // endfor: looped over work items
+
+    } // end pragma omp parallel
+
+    // Throw an exception if a work item failed
+    if (!error.empty()) {
+        std::string msg = "Filling of exposure cube failed: "+error;
+        throw GException::runtime_error(G_FILL, msg);
+    }
 
-    } // endfor: looped over observations
+    // Sum partial cubes
+    gammalib::cta_reduce_maps(cubes);
 
     // Return
     return;
@@ -624,12 +678,6 @@ void GCTACubeExposure::init_members(void)
     m_gti.clear();
     m_livetime = 0.0;
 
-    // Initialise cache
-    m_inx_left  = 0;
-    m_inx_right = 0;
-    m_wgt_left  = 0.0;
-    m_wgt_right = 0.0;
-   
     // Return
     return;
 }
@@ -650,12 +698,6 @@ void GCTACubeExposure::copy_members(const GCTACubeExposure& cube)
     m_gti       = cube.m_gti;
     m_livetime  = cube.m_livetime;
 
-    // Copy cache
-    m_inx_left  = cube.m_inx_left;
-    m_inx_right = cube.m_inx_right;
-    m_wgt_left  = cube.m_wgt_left;
-    m_wgt_right = cube.m_wgt_right;
-
     // Return
     return;
 }
@@ -670,33 +712,6 @@ void GCTACubeExposure::free_members(void)
 }
 
 
-/***********************************************************************//**
- * @brief Update 1D cache
- *
- * @param[in] logE Log10 energy in TeV.
- *
- * Updates the 1D interpolation cache. The interpolation cache is composed
- * of two indices and weights that define 2 data values of the 2D skymap
- * that are used for linear interpolation.
- *
- * @todo Write down formula
- ***************************************************************************/
-void GCTACubeExposure::update(const double& logE) const
-{
-    // Set value for node array
-    m_elogmeans.set_value(logE);
-
-    // Set indices and weighting factors for interpolation
-    m_inx_left  = m_elogmeans.inx_left();
-    m_inx_right = m_elogmeans.inx_right();
-    m_wgt_left  = m_elogmeans.wgt_left();
-    m_wgt_right = m_elogmeans.wgt_right();
-
-    // Return
-    return;
-}
-
-
 /***********************************************************************//**
  * @brief Set nodes for a logarithmic (base 10) energy axis
  *
@@ -792,3 +807,70 @@ void GCTACubeExposure::write_attributes(GFitsHDU& hdu) const
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Add exposure of one observation to a range of cube pixels
+ *
+ * @param[in] obs CTA observation.
+ * @param[in] rsp Response of CTA observation.
+ * @param[in] roi Region of interest of CTA observation.
+ * @param[in] dirs Sky directions of all cube pixels.
+ * @param[in] first Index of first pixel.
+ * @param[in] last Index of pixel after last pixel.
+ * @param[in,out] cube Exposure cube.
+ *
+ * Adds the product of effective area and livetime to all pixels in the
+ * range [@p first, @p last[ of @p cube that are within the region of
+ * interest. The method works on copies of all sky directions since sky
+ * directions cache derived quantities, hence it may be called by several
+ * threads at the same time for different cubes and responses.
+ ***************************************************************************/
+void GCTACubeExposure::fill_cube(const GCTAObservation&      obs,
+                                 const GCTAResponseIrf&      rsp,
+                                 const GCTARoi&              roi,
+                                 const std::vector<GSkyDir>& dirs,
+                                 const long long&            first,
+                                 const long long&            last,
+                                 GSkymap*                    cube) const
+{
+    // Get copies of RoI centre and pointing direction
+    GSkyDir centre = roi.centre().dir();
+    GSkyDir pnt    = obs.pointing().dir();
+    double  radius = roi.radius();
+
+    // Get livetime
+    double livetime = obs.livetime();
+
+    // Loop over pixels
+    for (long long pixel = first; pixel < last; ++pixel) {
+
+        // Get pixel sky direction
+        GSkyDir dir = dirs[pixel];
+
+        // Continue only if pixel is within RoI
+        if (centre.dist_deg(dir) <= radius) {
+
+            // Compute theta angle with respect to pointing direction in
+            // radians
+            double theta = pnt.dist(dir);
+
+            // Loop over all exposure cube energy bins
+            for (int iebin = 0; iebin < m_ebounds.size(); ++iebin){
+
+                // Get logE/TeV
+                double logE = m_ebounds.elogmean(iebin).log10TeV();
+
+                // Add to exposure cube (effective area * livetime)
+                (*cube)(pixel, iebin) += rsp.aeff(theta, 0.0, 0.0, 0.0, logE) *
+                                         livetime;
+
+            } // endfor: looped over energy bins
+
+        } // endif: pixel within RoI
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
@@ -34,9 +34,17 @@
 #include "GCTAEventList.hpp"
 #include "GMath.hpp"
 #include "GTools.hpp"
+#include "GCTARoi.hpp"
+#include "GCTASupport.hpp"
+
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Method name definitions ____________________________________________ */
 #define G_SET                            "GCTACubePsf::set(GCTAObservation&)"
+#define G_FILL                             "GCTACubePsf::fill(GObservations&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -47,6 +55,7 @@
 /* __ Debug definitions __________________________________________________ */
 
 /* __ Constants __________________________________________________________ */
+const int fill_block_size = 1024;  //!< Number of pixels per fill work item
 
 
 /*==========================================================================
@@ -293,14 +302,24 @@ double GCTACubePsf::operator()(const GSkyDir& dir,
                                const double&  delta,
                                const GEnergy& energy) const
 {
-    // Update indices and weighting factors for interpolation
-    update(delta, energy.log10TeV());
+    // Get indices and weighting factors for delta interpolation
+    GNodeArray::interpolation wgt_delta = (m_quadratic_binning)
+                                          ? m_deltas_cache.interpolate(std::sqrt(delta))
+                                          : m_deltas_cache.interpolate(delta);
+
+    // Get indices and weighting factors for energy interpolation
+    GNodeArray::interpolation wgt_eng = m_elogmeans.interpolate(energy.log10TeV());
 
     // Perform bi-linear interpolation
-    double psf = m_wgt1 * m_cube(dir, m_inx1) +
-                 m_wgt2 * m_cube(dir, m_inx2) +
-                 m_wgt3 * m_cube(dir, m_inx3) +
-                 m_wgt4 * m_cube(dir, m_inx4);
+    double psf =
+        wgt_delta.wgt_left  * wgt_eng.wgt_left  *
+        m_cube(dir, offset(wgt_delta.inx_left,  wgt_eng.inx_left))  +
+        wgt_delta.wgt_left  * wgt_eng.wgt_right *
+        m_cube(dir, offset(wgt_delta.inx_left,  wgt_eng.inx_right)) +
+        wgt_delta.wgt_right * wgt_eng.wgt_left  *
+        m_cube(dir, offset(wgt_delta.inx_right, wgt_eng.inx_left))  +
+        wgt_delta.wgt_right * wgt_eng.wgt_right *
+        m_cube(dir, offset(wgt_delta.inx_right, wgt_eng.inx_right));
 
     // Make sure that PSF does not become negative
     if (psf < 0.0) {
@@ -375,11 +394,14 @@ void GCTACubePsf::set(const GCTAObservation& obs)
     // Continue only if response is valid
     if (rsp != NULL) {
 
+        // Get sky directions of all pixels
+        std::vector<GSkyDir> dirs = m_cube.inx2dir(0, m_cube.npix());
+
         // Loop over all pixels in sky map
-        for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
+        for (long long pixel = 0; pixel < m_cube.npix(); ++pixel) {
 
             // Get pixel sky direction
-            GSkyDir dir = m_cube.inx2dir(pixel);
+            const GSkyDir& dir = dirs[pixel];
             
             // Continue only if pixel is within RoI
             if (roi.centre().dir().dist_deg(dir) <= roi.radius()) {
@@ -430,6 +452,20 @@ void GCTACubePsf::set(const GCTAObservation& obs)
  * @brief Fill PSF cube from observation container
  *
  * @param[in] obs Observation container.
+ *
+ * @exception GException::runtime_error
+ *            Filling of PSF cube failed.
+ *
+ * Sets the PSF cube to the exposure weighted mean of the point spread
+ * functions of all CTA observations in an observation container.
+ *
+ * The cube is filled in parallel. The work is split into blocks of pixels
+ * for each observation, and each thread accumulates the exposure weighted
+ * point spread functions and the exposure weights of its blocks in its own
+ * partial cubes. The response of the observations is shared by all threads
+ * since the response functions can be evaluated concurrently. The partial
+ * cubes are summed using gammalib::cta_reduce_maps() before the
+ * normalisation.
  ***************************************************************************/
 void GCTACubePsf::fill(const GObservations& obs)
 {
@@ -439,78 +475,102 @@ void GCTACubePsf::fill(const GObservations& obs)
     // Initialise skymap for exposure weight accumulation
     GSkymap exposure(m_cube);
 
-    // Loop over all observations in container
+    // Collect all CTA observations with a valid response, together with
+    // their region of interest
+    std::vector<const GCTAObservation*> ctas;
+    std::vector<GCTARoi>                rois;
     for (int i = 0; i < obs.size(); ++i) {
-
-        // Get observation and continue only if it is a CTA observation
         const GCTAObservation* cta = dynamic_cast<const GCTAObservation*>(obs[i]);
-        if (cta != NULL) {
-
-            // Extract region of interest from CTA observation
-            GCTARoi roi = cta->roi();
-
-            // Get references on CTA response and pointing direction
-            const GCTAResponseIrf* rsp = dynamic_cast<const GCTAResponseIrf*>(cta->response());
-            const GSkyDir&         pnt = cta->pointing().dir();
-
-            // Continue only if response is valid
-            if (rsp != NULL) {
-
-                // Loop over all pixels in sky map
-                for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
-
-                    // Get pixel sky direction
-                    GSkyDir dir = m_cube.inx2dir(pixel);
-                    
-                    // Continue only if pixel is within RoI
-                    if (roi.centre().dir().dist_deg(dir) <= roi.radius()) {
-
-                        // Compute theta angle with respect to pointing
-                        // direction in radians
-                        double theta = pnt.dist(dir);
-    
-                        // Loop over all energy bins
-                        for (int iebin = 0; iebin < m_ebounds.size(); ++iebin) {
-
-                            // Get logE/TeV
-                            double logE = m_ebounds.elogmean(iebin).log10TeV();
+        if (cta != NULL &&
+            dynamic_cast<const GCTAResponseIrf*>(cta->response()) != NULL) {
+            ctas.push_back(cta);
+            rois.push_back(cta->roi());
+        }
+    }
 
-                            // Compute exposure weight
-                            double weight = rsp->aeff(theta, 0.0, 0.0, 0.0, logE) *
-                                            cta->livetime();
+    // Get sky directions of all pixels
+    std::vector<GSkyDir> dirs = m_cube.inx2dir(0, m_cube.npix());
+
+    // Determine work items and number of threads
+    long long npix     = m_cube.npix();
+    int       nblocks  = int((npix + fill_block_size - 1) / fill_block_size);
+    int       nitems   = ctas.size() * nblocks;
+    int       nthreads = gammalib::cta_fill_threads(nitems);
+
+    // Setup partial cubes and exposure maps. The first thread fills the PSF
+    // cube and the exposure map itself.
+    std::vector<GSkymap>  partial_cubes(nthreads-1, m_cube);
+    std::vector<GSkymap>  partial_exposures(nthreads-1, exposure);
+    std::vector<GSkymap*> cubes(nthreads, &m_cube);
+    std::vector<GSkymap*> exposures(nthreads, &exposure);
+    for (int k = 1; k < nthreads; ++k) {
+        cubes[k]     = &partial_cubes[k-1];
+        exposures[k] = &partial_exposures[k-1];
+    }
 
-                            // Accumulate weights
-                            exposure(pixel, iebin) += weight;
+    // Initialise error message
+    std::string error;
 
-                            // Loop over delta values
-                            for (int idelta = 0; idelta < m_deltas.size(); ++idelta) {
+    // Fill partial cubes in parallel
+    #pragma omp parallel num_threads(nthreads)
+    {
+        // Get partial cubes of this thread
+        int thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+        GSkymap* cube   = cubes[thread];
+        GSkymap* weight = exposures[thread];
 
-                                // Compute delta in radians
-                                double delta = m_deltas[idelta] * gammalib::deg2rad;
+        // Loop over work items
+        #pragma omp for schedule(dynamic)
+        for (int item = 0; item < nitems; ++item) {
 
-                                // Set map index
-                                int imap = offset(idelta, iebin);
+            // Determine observation and pixel range of work item
+            int       iobs  = item / nblocks;
+            long long first = (long long)(item % nblocks) * fill_block_size;
+            long long last  = (first + fill_block_size < npix) ? first + fill_block_size : npix;
 
-                                // Add on PSF cube
-                                m_cube(pixel, imap) +=
-                                    rsp->psf(delta, theta, 0.0, 0.0, 0.0, logE) * weight;
+            // Fill pixels, recording any error since exceptions must not
+            // leave the parallel region
+            try {
 
-                            } // endfor: looped over delta bins
+                // Get response of observation. The response functions do
+                // not modify the response, hence they can be evaluated by
+                // several threads concurrently.
+                const GCTAResponseIrf* rsp =
+                      static_cast<const GCTAResponseIrf*>(ctas[iobs]->response());
 
-                        } // endfor: looped over energy bins
+                // Fill pixels
+                fill_cube(*ctas[iobs], *rsp, rois[iobs], dirs, first, last,
+                          cube, weight);
 
-                    } // endif: pixel was within RoI
+            }
+            catch (std::exception& e) {
+                #pragma omp critical(GCTACubePsf_fill)
+                {
+                    if (error.empty()) {
+                        error = e.what();
+                    }
+                }
+            }
 
-                } // endfor: looped over all pixels
+        } // endfor: looped over work items
 
-            } // endif: response was valid
+    } // end pragma omp parallel
 
-        } // endif: observation was a CTA observation
+    // Throw an exception if a work item failed
+    if (!error.empty()) {
+        std::string msg = "Filling of PSF cube failed: "+error;
+        throw GException::runtime_error(G_FILL, msg);
+    }
 
-    } // endfor: looped over observations
+    // Sum partial cubes and exposure maps
+    gammalib::cta_reduce_maps(cubes);
+    gammalib::cta_reduce_maps(exposures);
 
     // Compute mean PSF cube by dividing though the weights
-    for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
+    for (long long pixel = 0; pixel < m_cube.npix(); ++pixel) {
         for (int iebin = 0; iebin < m_ebounds.size(); ++iebin) {
             if (exposure(pixel, iebin) > 0.0) {
                 double norm = 1.0 / exposure(pixel, iebin);
@@ -734,16 +794,6 @@ void GCTACubePsf::init_members(void)
     m_deltas_cache.clear();
     m_quadratic_binning = false;
 
-    // Initialise cache
-    m_inx1 = 0;
-    m_inx2 = 0;
-    m_inx3 = 0;
-    m_inx4 = 0;
-    m_wgt1 = 0.0;
-    m_wgt2 = 0.0;
-    m_wgt3 = 0.0;
-    m_wgt4 = 0.0;
-   
     // Return
     return;
 }
@@ -765,16 +815,6 @@ void GCTACubePsf::copy_members(const GCTACubePsf& cube)
     m_deltas_cache      = cube.m_deltas_cache;
     m_quadratic_binning = cube.m_quadratic_binning;
 
-    // Copy cache
-    m_inx1 = cube.m_inx1;
-    m_inx2 = cube.m_inx2;
-    m_inx3 = cube.m_inx3;
-    m_inx4 = cube.m_inx4;
-    m_wgt1 = cube.m_wgt1;
-    m_wgt2 = cube.m_wgt2;
-    m_wgt3 = cube.m_wgt3;
-    m_wgt4 = cube.m_wgt4;
-
     // Return
     return;
 }
@@ -798,7 +838,7 @@ void GCTACubePsf::clear_cube(void)
     for (int imap = 0; imap < m_cube.nmaps(); ++imap) {
 
         // Loop over all pixels in sky map
-        for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
+        for (long long pixel = 0; pixel < m_cube.npix(); ++pixel) {
 
             // Reset cube value to zero
             m_cube(pixel, imap) = 0.0;
@@ -811,45 +851,6 @@ void GCTACubePsf::clear_cube(void)
     return;
 }
 
-/***********************************************************************//**
- * @brief Update PSF parameter cache
- *
- * @param[in] delta Angular separation between true and measured photon
- *            directions (radians).
- * @param[in] logE Log10 true photon energy (TeV). 
- *
- * This method updates the PSF parameter cache.
- ***************************************************************************/
-void GCTACubePsf::update(const double& delta, const double& logE) const
-{
-    // Set node array for delta interpolation
-    if (m_quadratic_binning) {
-        m_deltas_cache.set_value(std::sqrt(delta));
-    }
-    else {
-        m_deltas_cache.set_value(delta);
-    }
-
-    // Set node array for energy interpolation
-    m_elogmeans.set_value(logE);
-   
-    // Set indices for bi-linear interpolation
-    m_inx1 = offset(m_deltas_cache.inx_left(),  m_elogmeans.inx_left());
-    m_inx2 = offset(m_deltas_cache.inx_left(),  m_elogmeans.inx_right());
-    m_inx3 = offset(m_deltas_cache.inx_right(), m_elogmeans.inx_left());
-    m_inx4 = offset(m_deltas_cache.inx_right(), m_elogmeans.inx_right());
-
-    // Set weighting factors for bi-linear interpolation
-    m_wgt1 = m_deltas_cache.wgt_left()  * m_elogmeans.wgt_left();
-    m_wgt2 = m_deltas_cache.wgt_left()  * m_elogmeans.wgt_right();
-    m_wgt3 = m_deltas_cache.wgt_right() * m_elogmeans.wgt_left();
-    m_wgt4 = m_deltas_cache.wgt_right() * m_elogmeans.wgt_right();
-
-    // Return
-    return;
-}
-
-
 /***********************************************************************//**
  * @brief Set nodes for delta axis in radians
  *
@@ -952,7 +953,7 @@ void GCTACubePsf::set_to_smooth(void)
         for (int iebin = 0; iebin < m_ebounds.size(); ++iebin) {
             int isrc = offset(1, iebin);
             int idst = offset(0, iebin);
-            for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
+            for (long long pixel = 0; pixel < m_cube.npix(); ++pixel) {
                 m_cube(pixel, idst) = m_cube(pixel, isrc);
             }
         }
@@ -963,7 +964,7 @@ void GCTACubePsf::set_to_smooth(void)
         // Pad mean PSF with zeros in the last delta bin
         for (int iebin = 0; iebin < m_ebounds.size(); ++iebin) {
             int imap = offset(idelta, iebin);
-            for (int pixel = 0; pixel < m_cube.npix(); ++pixel) {
+            for (long long pixel = 0; pixel < m_cube.npix(); ++pixel) {
                 m_cube(pixel, imap) = 0.0;
             }
         }
@@ -973,3 +974,89 @@ void GCTACubePsf::set_to_smooth(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Add PSF of one observation to a range of cube pixels
+ *
+ * @param[in] obs CTA observation.
+ * @param[in] rsp Response of CTA observation.
+ * @param[in] roi Region of interest of CTA observation.
+ * @param[in] dirs Sky directions of all cube pixels.
+ * @param[in] first Index of first pixel.
+ * @param[in] last Index of pixel after last pixel.
+ * @param[in,out] cube PSF cube.
+ * @param[in,out] exposure Exposure weight map.
+ *
+ * Adds the exposure weighted point spread function to all pixels in the
+ * range [@p first, @p last[ of @p cube that are within the region of
+ * interest, and adds the exposure weights to @p exposure. The method works
+ * on copies of all sky directions, hence it may be called by several
+ * threads at the same time for different cubes and responses.
+ ***************************************************************************/
+void GCTACubePsf::fill_cube(const GCTAObservation&      obs,
+                            const GCTAResponseIrf&      rsp,
+                            const GCTARoi&              roi,
+                            const std::vector<GSkyDir>& dirs,
+                            const long long&            first,
+                            const long long&            last,
+                            GSkymap*                    cube,
+                            GSkymap*                    exposure) const
+{
+    // Get copies of RoI centre and pointing direction
+    GSkyDir centre = roi.centre().dir();
+    GSkyDir pnt    = obs.pointing().dir();
+    double  radius = roi.radius();
+
+    // Get livetime
+    double livetime = obs.livetime();
+
+    // Loop over pixels
+    for (long long pixel = first; pixel < last; ++pixel) {
+
+        // Get pixel sky direction
+        GSkyDir dir = dirs[pixel];
+
+        // Continue only if pixel is within RoI
+        if (centre.dist_deg(dir) <= radius) {
+
+            // Compute theta angle with respect to pointing direction in
+            // radians
+            double theta = pnt.dist(dir);
+
+            // Loop over all energy bins
+            for (int iebin = 0; iebin < m_ebounds.size(); ++iebin) {
+
+                // Get logE/TeV
+                double logE = m_ebounds.elogmean(iebin).log10TeV();
+
+                // Compute exposure weight
+                double weight = rsp.aeff(theta, 0.0, 0.0, 0.0, logE) * livetime;
+
+                // Accumulate weights
+                (*exposure)(pixel, iebin) += weight;
+
+                // Loop over delta values
+                for (int idelta = 0; idelta < m_deltas.size(); ++idelta) {
+
+                    // Compute delta in radians
+                    double delta = m_deltas[idelta] * gammalib::deg2rad;
+
+                    // Set map index
+                    int imap = offset(idelta, iebin);
+
+                    // Add on PSF cube
+                    (*cube)(pixel, imap) +=
+                        rsp.psf(delta, theta, 0.0, 0.0, 0.0, logE) * weight;
+
+                } // endfor: looped over delta bins
+
+            } // endfor: looped over energy bins
+
+        } // endif: pixel was within RoI
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <vector>
 #include "GTools.hpp"
 #include "GCTACubeSourceDiffuse.hpp"
 #include "GModelSpatialDiffuse.hpp"
@@ -39,6 +40,9 @@
 #include "GCTAEventCube.hpp"
 #include "GCTAResponseCube.hpp"
 #include "GCTAResponse_helpers.hpp"
+#include "GWcs.hpp"
+#include "GSkyPixel.hpp"
+#include "GPhoton.hpp"
 
 /* __ OpenMP section _____________________________________________________ */
 #ifdef _OPENMP
@@ -51,7 +55,7 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
-#define G_PSF_INTEGRATE               //!< Integrate map over PSF (default)
+#define G_PSF_INTEGRATE                         //!< Integrate map over PSF
 
 /* __ Debug definitions __________________________________________________ */
 //#define G_DEBUG_SET
@@ -199,6 +203,14 @@ GCTACubeSourceDiffuse* GCTACubeSourceDiffuse::clone(void) const
  * Sets the diffuse source cube assuming no energy dispersion and assuming
  * a negligible variation of the effective area over the size of the
  * point spread function.
+ *
+ * The Psf is integrated numerically for each pixel. If Psf convolution
+ * was requested using GCTAResponseCube::psf_convolve(), the model of "CAR",
+ * "TAN" and HealPix event cubes is instead convolved with the Psf using
+ * GSkymap::convolve(). The convolution is much faster but uses for each
+ * energy a single Psf, the exposure weighted mean Psf over the event cube.
+ * If the convolution is not possible for the event cube, the numerical Psf
+ * integration is used.
  ***************************************************************************/
 void GCTACubeSourceDiffuse::set(const std::string&   name,
                                 const GModelSpatial& model,
@@ -251,8 +263,33 @@ void GCTACubeSourceDiffuse::set(const std::string&   name,
     // Get Psf radius (in degrees)
     double delta_max = rsp->psf().delta_max() * gammalib::rad2deg;
 
-    // Continue only if livetime is >0
-    if (livetime > 0.0)  {
+    // Determine whether the Psf integration should be done by a
+    // convolution of the model map
+    bool convolve = false;
+    #if defined(G_PSF_INTEGRATE)
+    if (rsp->psf_convolve()) {
+        std::string code = (cube->map().projection() != NULL)
+                           ? cube->map().projection()->code() : "";
+        convolve         = (code == "CAR" || code == "TAN" || code == "HPX");
+    }
+    #endif
+
+    // If requested, compute Psf integration by map convolution. If the
+    // map cannot be convolved then fall back to the Psf integration for
+    // each pixel.
+    if (livetime > 0.0 && convolve) {
+        try {
+            set_convolved(rsp, spatial, cube, obsTime);
+        }
+        catch (GException::invalid_value& e) {
+            m_cube   = 0.0;
+            convolve = false;
+        }
+    }
+
+    // If no convolution was done then integrate Psf for each pixel if
+    // livetime is >0
+    if (livetime > 0.0 && !convolve)  {
 
         // Loop over all spatial bins
         for (int pixel = 0; pixel < cube->npix(); ++pixel) {
@@ -465,3 +502,186 @@ void GCTACubeSourceDiffuse::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Set diffuse source cube by Psf convolution of the model map
+ *
+ * @param[in] rsp Response cube.
+ * @param[in] model Diffuse spatial model.
+ * @param[in] cube Event cube.
+ * @param[in] srcTime True photon arrival time.
+ *
+ * @exception GException::invalid_value
+ *            Model map cannot be convolved with a single kernel.
+ *
+ * Computes the Psf convolved diffuse model by evaluating the model on a
+ * copy of the event cube map and by convolving each energy layer of the
+ * map with the Psf using GSkymap::convolve(). For World Coordinate System
+ * maps, the copy is enlarged by the Psf radius on each side, so that model
+ * emission from outside the event cube is spilled into the cube.
+ *
+ * For each energy layer a single convolution kernel is used, which is the
+ * mean of the Psf cube over all Psf cube pixels within the event cube,
+ * weighted by the exposure at the pixel and energy. Spatial variations of
+ * the Psf within the event cube are hence neglected. The effective area is
+ * computed at the pixel centre.
+ ***************************************************************************/
+void GCTACubeSourceDiffuse::set_convolved(const GCTAResponseCube*     rsp,
+                                          const GModelSpatialDiffuse* model,
+                                          const GCTAEventCube*        cube,
+                                          const GTime&                srcTime)
+{
+    // Get livetime (in seconds) and deadtime correction factor
+    double livetime = rsp->exposure().livetime();
+    double deadc    = rsp->exposure().deadc();
+
+    // Get Psf radius (in radians and degrees)
+    double theta_max = 1.1 * rsp->psf().delta_max();
+    double delta_max = rsp->psf().delta_max() * gammalib::rad2deg;
+
+    // Setup model map. For World Coordinate Systems, enlarge the map by the
+    // Psf radius on each side.
+    const GSkymap& map = cube->map();
+    GSkymap        model_map(map);
+    int            rx = 0;
+    int            ry = 0;
+    if (map.projection()->code() != "HPX") {
+        const GWcs* wcs = static_cast<const GWcs*>(map.projection());
+        rx = int(theta_max * gammalib::rad2deg / std::abs(wcs->cdelt(0))) + 1;
+        ry = int(theta_max * gammalib::rad2deg / std::abs(wcs->cdelt(1))) + 1;
+        GWcs* proj = wcs->clone();
+        proj->set(wcs->coordsys(), wcs->crval(0), wcs->crval(1),
+                  wcs->crpix(0)+rx, wcs->crpix(1)+ry,
+                  wcs->cdelt(0), wcs->cdelt(1));
+        model_map = GSkymap(wcs->code(), wcs->coordsys(),
+                            wcs->crval(0), wcs->crval(1),
+                            wcs->cdelt(0), wcs->cdelt(1),
+                            map.nx()+2*rx, map.ny()+2*ry, map.nmaps());
+        model_map.projection(*proj);
+        delete proj;
+    }
+    model_map = 0.0;
+    model_map.pixel_cache(true);
+
+    // Evaluate model on map
+    for (long long i = 0; i < model_map.npix(); ++i) {
+
+        // Get sky direction of pixel, skipping pixels outside the projection
+        GSkyDir srcDir;
+        try {
+            srcDir = model_map.inx2dir(i);
+        }
+        catch (GException::wcs_invalid_x_y& e) {
+            continue;
+        }
+
+        // Evaluate model for all energy layers if the model contains the
+        // sky direction
+        if (model->contains(srcDir)) {
+            for (int iebin = 0; iebin < cube->ebins(); ++iebin) {
+                GPhoton photon(srcDir, cube->energy(iebin), srcTime);
+                model_map(i, iebin) = model->eval(photon);
+            }
+        }
+
+    } // endfor: looped over map pixels
+
+    // Collect the Psf cube pixels that fall within the event cube
+    const GSkymap&       psfmap = rsp->psf().map();
+    std::vector<GSkyDir> psfdirs;
+    for (long long i = 0; i < psfmap.npix(); ++i) {
+        try {
+            GSkyDir dir = psfmap.inx2dir(i);
+            if (map.contains(dir)) {
+                psfdirs.push_back(dir);
+            }
+        }
+        catch (GException::wcs_invalid_x_y& e) {
+            continue;
+        }
+    }
+
+    // Get Psf cube centre, used if no Psf cube pixel has any exposure
+    GSkyDir centre = (psfmap.nx() > 0 && psfmap.ny() > 0)
+                     ? psfmap.pix2dir(GSkyPixel(0.5*(psfmap.nx()-1),
+                                                0.5*(psfmap.ny()-1)))
+                     : psfmap.inx2dir(0);
+
+    // Convolve all energy layers with the exposure weighted mean Psf of
+    // the event cube
+    for (int iebin = 0; iebin < cube->ebins(); ++iebin) {
+
+        // Get energy of layer
+        const GEnergy& srcEng = cube->energy(iebin);
+
+        // Compute exposure weights of Psf cube pixels
+        std::vector<GSkyDir> dirs;
+        std::vector<double>  weights;
+        double               sum     = 0.0;
+        int                  npsf    = psfdirs.size();
+        for (int i = 0; i < npsf; ++i) {
+            double exposure = rsp->exposure()(psfdirs[i], srcEng);
+            if (exposure > 0.0) {
+                dirs.push_back(psfdirs[i]);
+                weights.push_back(exposure);
+                sum += exposure;
+            }
+        }
+
+        // Normalise weights, or use Psf cube centre if there is no exposure
+        if (sum > 0.0) {
+            int nweights = weights.size();
+            for (int i = 0; i < nweights; ++i) {
+                weights[i] /= sum;
+            }
+        }
+        else {
+            dirs.assign(1, centre);
+            weights.assign(1, 1.0);
+        }
+
+        // Convolve energy layer
+        cta_psf_diffuse_kern_map kernel(rsp, dirs, weights, srcEng);
+        model_map.convolve(kernel, theta_max, iebin);
+
+    } // endfor: looped over energy layers
+
+    // Loop over all spatial bins
+    for (int pixel = 0; pixel < cube->npix(); ++pixel) {
+
+        // Get cube pixel sky direction
+        GSkyDir obsDir = map.inx2dir(pixel);
+
+        // Continue only if model contains that sky direction
+        if (model->contains(obsDir, delta_max)) {
+
+            // Get index of pixel in model map
+            long long index = pixel;
+            if (rx > 0 || ry > 0) {
+                GSkyPixel mappixel = map.inx2pix(pixel);
+                index = model_map.pix2inx(GSkyPixel(mappixel.x()+rx,
+                                                    mappixel.y()+ry));
+            }
+
+            // Loop over all energy layers
+            for (int iebin = 0; iebin < cube->ebins(); ++iebin) {
+
+                // Determine effective area
+                double aeff = rsp->exposure()(obsDir, cube->energy(iebin));
+
+                // Set cube value if effective area is positive
+                if (aeff > 0.0) {
+                    aeff /= livetime;
+                    m_cube(pixel, iebin) = aeff * model_map(index, iebin) * deadc;
+                }
+
+            } // endfor: looped over all energy layers
+
+        } // endif: pixel was contained in model
+
+    } // endfor: looped over all spatial pixels
+
+    // Return
+    return;
+}
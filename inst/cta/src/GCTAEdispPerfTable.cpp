@@ -184,12 +184,12 @@ double GCTAEdispPerfTable::operator()(const double& logEobs,
                                       const double& zenith,
                                       const double& azimuth) const
 {
-    // Update the parameter cache
-    update(logEsrc);
+    // Get energy dispersion parameters
+    parameters par = compute(logEsrc);
 
     // Compute energy dispersion value
     double delta = logEobs - logEsrc;
-    double edisp = m_par_scale * std::exp(m_par_width * delta * delta);
+    double edisp = par.scale * std::exp(par.width * delta * delta);
     
     // Return energy dispersion
     return edisp;
@@ -318,7 +318,7 @@ void GCTAEdispPerfTable::load(const std::string& filename)
  * @param[in] azimuth Azimuth angle in Earth system (rad). Not used.
  *
  * Draws observed energy value from a normal distribution of width
- * m_par_sigma around @p logE.
+ * sigma around @p logE.
  ***************************************************************************/
 GEnergy GCTAEdispPerfTable::mc(GRan&         ran,
                                const double& logE,
@@ -327,11 +327,11 @@ GEnergy GCTAEdispPerfTable::mc(GRan&         ran,
                                const double& zenith,
                                const double& azimuth) const
 {
-    // Update the parameter cache
-    update(logE);
+    // Get energy dispersion parameters
+    parameters par = compute(logE);
 
     // Draw log observed energy in TeV
-    double logEobs = m_par_sigma * ran.normal() + logE;
+    double logEobs = par.sigma * ran.normal() + logE;
 
     // Set energy
     GEnergy energy;
@@ -475,10 +475,6 @@ void GCTAEdispPerfTable::init_members(void)
     m_filename.clear();
     m_logE.clear();
     m_sigma.clear();
-    m_par_logE  = -1.0e30;
-    m_par_scale = 1.0;
-    m_par_sigma = 0.0;
-    m_par_width = 0.0;
 
     // Return
     return;
@@ -493,13 +489,9 @@ void GCTAEdispPerfTable::init_members(void)
 void GCTAEdispPerfTable::copy_members(const GCTAEdispPerfTable& edisp)
 {
     // Copy members
-    m_filename  = edisp.m_filename;
-    m_logE      = edisp.m_logE;
-    m_sigma     = edisp.m_sigma;
-    m_par_logE  = edisp.m_par_logE;
-    m_par_scale = edisp.m_par_scale;
-    m_par_sigma = edisp.m_par_sigma;
-    m_par_width = edisp.m_par_width;
+    m_filename = edisp.m_filename;
+    m_logE     = edisp.m_logE;
+    m_sigma    = edisp.m_sigma;
 
     // Return
     return;
@@ -517,29 +509,25 @@ void GCTAEdispPerfTable::free_members(void)
 
 
 /***********************************************************************//**
- * @brief Update energy dispersion parameter cache
+ * @brief Compute energy dispersion parameters
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
+ * @return Energy dispersion parameters.
  *
- * This method updates the energy dispersion parameter cache.
- * As the performance table energy dispersion only depends on energy,
- * the only parameter on which the cache values depend is the energy.
+ * This method computes the Gaussian energy dispersion parameters for a
+ * given energy. The parameters are not cached, hence the energy dispersion
+ * can be evaluated concurrently by several threads.
  ***************************************************************************/
-void GCTAEdispPerfTable::update(const double& logE) const
+GCTAEdispPerfTable::parameters GCTAEdispPerfTable::compute(const double& logE) const
 {
-    // Only compute energy dispersion parameters if arguments have changed
-    if (logE != m_par_logE) {
+    // Allocate parameters
+    parameters par;
 
-        // Save energy
-        m_par_logE = logE;
-    
-        // Determine Gaussian sigma and pre-compute Gaussian parameters
-        m_par_sigma = m_logE.interpolate(logE, m_sigma);
-        m_par_scale = gammalib::inv_sqrt2pi / m_par_sigma;
-        m_par_width = -0.5 / (m_par_sigma * m_par_sigma);
-
-    }
+    // Determine Gaussian sigma and pre-compute Gaussian parameters
+    par.sigma = m_logE.interpolate(logE, m_sigma);
+    par.scale = gammalib::inv_sqrt2pi / par.sigma;
+    par.width = -0.5 / (par.sigma * par.sigma);
 
-    // Return
-    return;
+    // Return parameters
+    return par;
 }
@@ -176,14 +176,19 @@ double GCTAEdispRmf::operator()(const double& logEobs,
                                 const double& zenith,
                                 const double& azimuth) const
 {
-    // Update indexes and weighting factors for interpolation
-    update(logEobs, logEsrc);
-
-    // Perform interpolation
-    double edisp =  m_wgt1 * m_matrix(m_itrue1, m_imeas1) +
-                    m_wgt2 * m_matrix(m_itrue1, m_imeas2) +
-                    m_wgt3 * m_matrix(m_itrue2, m_imeas1) +
-                    m_wgt4 * m_matrix(m_itrue2, m_imeas2);
+    // Get indices and weighting factors for interpolation
+    GNodeArray::interpolation wtrue = m_etrue.interpolate(logEobs);
+    GNodeArray::interpolation wmeas = m_emeasured.interpolate(logEsrc);
+
+    // Perform bi-linear interpolation
+    double edisp =  wtrue.wgt_left  * wmeas.wgt_left  *
+                    m_matrix(wtrue.inx_left,  wmeas.inx_left)  +
+                    wtrue.wgt_left  * wmeas.wgt_right *
+                    m_matrix(wtrue.inx_left,  wmeas.inx_right) +
+                    wtrue.wgt_right * wmeas.wgt_left  *
+                    m_matrix(wtrue.inx_right, wmeas.inx_left)  +
+                    wtrue.wgt_right * wmeas.wgt_right *
+                    m_matrix(wtrue.inx_right, wmeas.inx_right);
 
     // Return energy dispersion
     return edisp;
@@ -510,16 +515,6 @@ void GCTAEdispRmf::init_members(void)
     // Initialise interpolation cache
     m_etrue.clear();
     m_emeasured.clear();
-    m_last_etrue     = 9999.0;
-    m_last_emeasured = 9999.0;
-    m_itrue1         = 0;
-    m_itrue2         = 0;
-    m_imeas1         = 0;
-    m_imeas2         = 0;
-    m_wgt1           = 0.0;
-    m_wgt2           = 0.0;
-    m_wgt3           = 0.0;
-    m_wgt4           = 0.0;
 
     // Initialise Monte Carlo cache
     m_mc_measured_start.clear();
@@ -546,18 +541,8 @@ void GCTAEdispRmf::copy_members(const GCTAEdispRmf& edisp)
     m_matrix   = edisp.m_matrix;
 
     // Copy interpolation cache
-    m_etrue          = edisp.m_etrue;
-    m_emeasured      = edisp.m_emeasured;
-    m_last_etrue     = edisp.m_last_etrue;
-    m_last_emeasured = edisp.m_last_emeasured;
-    m_itrue1         = edisp.m_itrue1;
-    m_itrue2         = edisp.m_itrue2;
-    m_imeas1         = edisp.m_imeas1;
-    m_imeas2         = edisp.m_imeas2;
-    m_wgt1           = edisp.m_wgt1;
-    m_wgt2           = edisp.m_wgt2;
-    m_wgt3           = edisp.m_wgt3;
-    m_wgt4           = edisp.m_wgt4;
+    m_etrue     = edisp.m_etrue;
+    m_emeasured = edisp.m_emeasured;
 
     // Copy Monte Carlo cache
     m_mc_measured_start = edisp.m_mc_measured_start;
@@ -727,48 +712,6 @@ void GCTAEdispRmf::set_mc_cache(void) const
 }
 
 
-/***********************************************************************//**
- * @brief Update cache
- *
- * @param[in] etrue True energy.
- * @param[in] emeasured Measured energy.
- *
- * Updates the interpolation cache. The interpolation cache is composed
- * of four indices and weights that define 4 data values of the RMF matrix
- * that are used for bilinear interpolation.
- ***************************************************************************/
-void GCTAEdispRmf::update(const double& etrue, const double& emeasured) const
-{
-    // Update cache only of arguments have changed
-    if (etrue != m_last_etrue || emeasured != m_last_emeasured) {
-
-        // Store actual values
-        m_last_etrue     = etrue;
-        m_last_emeasured = emeasured;
-
-        // Set values for node arrays
-        m_etrue.set_value(etrue);
-        m_emeasured.set_value(emeasured);
-
-        // Set indices for bi-linear interpolation
-        m_itrue1 = m_etrue.inx_left();
-        m_itrue2 = m_etrue.inx_right();
-        m_imeas1 = m_emeasured.inx_left();
-        m_imeas2 = m_emeasured.inx_right();
-
-        // Set weighting factors for bi-linear interpolation
-        m_wgt1 = m_etrue.wgt_left()  * m_emeasured.wgt_left();
-        m_wgt2 = m_etrue.wgt_left()  * m_emeasured.wgt_right();
-        m_wgt3 = m_etrue.wgt_right() * m_emeasured.wgt_left();
-        m_wgt4 = m_etrue.wgt_right() * m_emeasured.wgt_right();
-
-    } // endif: update requested
-
-    // Return
-    return;
-}
-
-
 /***********************************************************************//**
  * @brief Update cumulative probability
  *
@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <climits>
 #include "GTools.hpp"
 #include "GFits.hpp"
 #include "GCTAException.hpp"
@@ -267,7 +268,7 @@ GCTAEventCube* GCTAEventCube::clone(void) const
 int GCTAEventCube::size(void) const
 {
     // Compute number of bins
-    int nbins = m_map.npix() * m_map.nmaps(); 
+    int nbins = int(m_map.npix() * m_map.nmaps());
 
     // Return number of bins
     return nbins;
@@ -672,6 +673,8 @@ void GCTAEventCube::read_gti(const GFitsTable& hdu)
  *
  * @exception GCTAException::no_sky
  *            No sky pixels found in event cube.
+ * @exception GException::invalid_value
+ *            Number of event cube bins exceeds the int range.
  *
  * This method computes the sky directions and solid angles for all event
  * cube pixels. Sky directions are stored in an array of GCTAInstDir objects
@@ -686,6 +689,15 @@ void GCTAEventCube::read_gti(const GFitsTable& hdu)
  ***************************************************************************/
 void GCTAEventCube::set_directions(void)
 {
+    // Throw an error if the event cube has more bins than can be indexed
+    if (m_map.npix() * m_map.nmaps() > INT_MAX) {
+        std::string msg = "Sky map with "+gammalib::str(m_map.npix())+
+                          " pixels and "+gammalib::str(m_map.nmaps())+
+                          " maps exceeds the maximum number of "+
+                          gammalib::str(INT_MAX)+" CTA event cube bins.";
+        throw GException::invalid_value(G_SET_DIRECTIONS, msg);
+    }
+
     // Throw an error if we have no sky pixels
     if (npix() < 1) {
         throw GCTAException::no_sky(G_SET_DIRECTIONS, "Every CTA event cube"
@@ -700,21 +712,29 @@ void GCTAEventCube::set_directions(void)
     m_dirs.reserve(npix());
     m_solidangle.reserve(npix());
 
+    // Enable the pixel cache of the sky map so that all pixel directions
+    // and solid angles are computed in a single pass
+    bool pixel_cache = m_map.pixel_cache();
+    m_map.pixel_cache(true);
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < ny(); ++iy) {
-        for (int ix = 0; ix < nx(); ++ix) {
-            try {
-                GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-                m_dirs.push_back(GCTAInstDir(m_map.pix2dir(pixel)));
-                m_solidangle.push_back(m_map.solidangle(pixel));
-            }
-            catch (GException::wcs_invalid_x_y& e) {
-                m_dirs.push_back(GCTAInstDir());
-                m_solidangle.push_back(0.0);
-            }
+    for (int i = 0; i < npix(); ++i) {
+        GCTAInstDir dir;
+        double      solidangle = 0.0;
+        try {
+            dir        = GCTAInstDir(m_map.inx2dir(i));
+            solidangle = m_map.solidangle(i);
+        }
+        catch (GException::wcs_invalid_x_y& e) {
+            solidangle = 0.0;
         }
+        m_dirs.push_back(dir);
+        m_solidangle.push_back(solidangle);
     }
 
+    // Restore pixel cache usage of the sky map
+    m_map.pixel_cache(pixel_cache);
+
     // Return
     return;
 }
@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <sys/stat.h>
 #include "GCTAEventList.hpp"
 #include "GCTAException.hpp"
 #include "GCTASupport.hpp"
@@ -43,10 +44,29 @@
 #include "GTime.hpp"
 #include "GTimeReference.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Method name definitions ____________________________________________ */
 #define G_OPERATOR                          "GCTAEventList::operator[](int&)"
+#define G_APPEND                      "GCTAEventList::append(GCTAEventAtom&)"
+#define G_STREAM1                    "GCTAEventList::stream(std::string&, int&)"
+#define G_STREAM2                     "GCTAEventList::stream(GFitsTable&, int&)"
 #define G_ROI                                     "GCTAEventList::roi(GRoi&)"
+#define G_FETCH_CHUNK       "GCTAEventList::fetch_chunk(thread_data*, int&)"
 #define G_READ_DS_EBOUNDS         "GCTAEventList::read_ds_ebounds(GFitsHDU*)"
+#define G_LOAD_RECON                          "GCTAEventList::load_recon()"
+
+/* __ Constants __________________________________________________________ */
+const int recon_size = 16;             //!< Reconstruction values per event
+const char* recon_names[recon_size] = {"MULTIP",   "DIR_ERR",  "ALT",
+                                       "AZ",       "COREX",    "COREY",
+                                       "CORE_ERR", "XMAX",     "XMAX_ERR",
+                                       "SHWIDTH",  "SHLENGTH", "ENERGY_ERR",
+                                       "HIL_MSW",  "HIL_MSW_ERR",
+                                       "HIL_MSL",  "HIL_MSL_ERR"};
 
 /* __ Macros _____________________________________________________________ */
 
@@ -54,6 +74,10 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Local prototypes ___________________________________________________ */
+static bool file_identity(const std::string& filename, long long* size,
+                          long long* time);
+
 
 /*==========================================================================
  =                                                                         =
@@ -169,7 +193,24 @@ GCTAEventList& GCTAEventList::operator=(const GCTAEventList& list)
  * @exception GException::out_of_range
  *            Event index outside valid range.
  *
- * Returns pointer to an event atom.
+ * @exception GException::invalid_value
+ *            Event list is streamed from the event file.
+ *
+ * Returns pointer to the write view of the event list, which holds a copy
+ * of the event. Modifications of the event atom are written back into the
+ * event list on the next access to another event through this operator,
+ * when an event is appended and when the event list is written. The const
+ * access operator returns the modified event.
+ *
+ * The event list has a single write view, hence the returned pointer is
+ * only valid until the next call of this operator: a call with another
+ * index writes the view back and overwrites it with the other event, so
+ * that all previously returned pointers then point to the other event.
+ * Two pointers returned by this operator therefore always alias the same
+ * event atom, even if they were obtained for different indices, and
+ * modifying the event through one pointer modifies it through the other.
+ * Pointers must therefore not be kept across calls; copy the event atom
+ * if it is needed later. The write view is not thread safe.
  ***************************************************************************/
 GCTAEventAtom* GCTAEventList::operator[](const int& index)
 {
@@ -180,8 +221,30 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
     }
     #endif
 
+    // Throw an exception if events are streamed since modifications
+    // would be lost once the chunk is released
+    if (is_streamed()) {
+        std::string msg = "Streamed events cannot be modified. Please use "
+                          "the const access operator.";
+        throw GException::invalid_value(G_OPERATOR, msg);
+    }
+
+    // If the event is not yet in the write view then write back the
+    // current view and fetch the event. The reconstruction information
+    // is read before, so that it is preserved on write back
+    if (index != m_edit_index) {
+        load_recon();
+        flush_edit();
+        get_event(index, m_edit);
+        m_edit_index = index;
+    }
+
+    // Make sure that the event index is correct (the view may have been
+    // overwritten by an assignment)
+    m_edit.m_index = index;
+
     // Return pointer
-    return (&(m_events[index]));
+    return (&m_edit);
 }
 
 
@@ -193,7 +256,14 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
  * @exception GException::out_of_range
  *            Event index outside valid range.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to the event atom view of the calling thread. The view
+ * is valid until the next access to the event list by the same thread.
+ * Since each thread has its own view, the method can be called
+ * concurrently by several threads, but not from nested parallel regions.
+ *
+ * If events are streamed, the chunk that contains the event is read into
+ * the chunk of the calling thread if it is not yet in memory. Only the
+ * reading of a chunk is serialised.
  ***************************************************************************/
 const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
 {
@@ -204,8 +274,31 @@ const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
     }
     #endif
 
+    // Get read access data and view of calling thread
+    thread_data*   data = thread_slot();
+    GCTAEventAtom* view = &(data->view);
+
+    // If events are streamed then fill view from the chunk of the calling
+    // thread after making sure that the chunk contains the event
+    if (is_streamed()) {
+        fetch_chunk(data, index);
+        data->chunk->get_event(index - data->chunk_first, *view);
+        view->m_index = index;
+    }
+
+    // ... otherwise if the event is in the write view then copy the write
+    // view since it may hold modifications that were not yet written back
+    else if (index == m_edit_index) {
+        *view = m_edit;
+    }
+
+    // ... otherwise fill view from the event columns
+    else {
+        get_event(index, *view);
+    }
+
     // Return pointer
-    return (&(m_events[index]));
+    return view;
 }
 
 
@@ -258,6 +351,14 @@ GCTAEventList* GCTAEventList::clone(void) const
  * interest and the energy boundaries from the data selection keywords,
  * and read the Good Time Intervals from the GTI extension.
  *
+ * The reconstruction information (multiplicity, shower and Hillas
+ * parameters) is not loaded. It is read from the file once it is needed,
+ * i.e. when the event list is written or when events are modified or
+ * appended. The size and modification time of the file are recorded so
+ * that load_recon() can verify that the file was not changed in the
+ * meantime. If the file cannot be identified the reconstruction
+ * information is loaded immediately.
+ *
  * The method clears the object before loading, thus any events residing in
  * the object before loading will be lost.
  ***************************************************************************/
@@ -269,8 +370,22 @@ void GCTAEventList::load(const std::string& filename)
     // Open FITS file
     GFits file(filename);
 
-    // Read event list
-    read(file);
+    // Read Good Time Intervals, region of interest and energy boundaries
+    read_header(file);
+
+    // Load event data without reconstruction information
+    read_events(*file.table("EVENTS"));
+
+    // Defer reading of reconstruction information if the file can be
+    // identified when the information is read, otherwise read it now
+    if (size() > 0) {
+        if (file_identity(filename, &m_recon_size, &m_recon_time)) {
+            m_recon_file = filename;
+        }
+        else {
+            read_events_recon(*file.table("EVENTS"), 0, size());
+        }
+    }
 
     // Close FITS file
     file.close();
@@ -330,46 +445,13 @@ void GCTAEventList::read(const GFits& fits)
     // Clear object
     clear();
 
-    // Get event list HDU
-    const GFitsTable& events = *fits.table("EVENTS");
-
-    // If we have a GTI extension, then read Good Time Intervals from that
-    // extension
-    if (fits.contains("GTI")) {
-        const GFitsTable& gti = *fits.table("GTI");
-        m_gti.read(gti);
-    }
-
-    // ... otherwise build GTI from TSTART and TSTOP
-    else {
-
-        // Read start and stop time
-        double tstart = events.real("TSTART");
-        double tstop  = events.real("TSTOP");
-
-        // Create time reference from header information
-        GTimeReference timeref(events);
-
-        // Set start and stop time
-        GTime start(tstart);
-        GTime stop(tstop);
-
-        // Append start and stop time as single time interval to GTI
-        m_gti.append(start, stop);
-
-        // Set GTI time reference
-        m_gti.reference(timeref);
-
-    } // endelse: GTI built from TSTART and TSTOP
+    // Read Good Time Intervals, region of interest and energy boundaries
+    read_header(fits);
 
     // Load event data
-    read_events(events);
-
-    // Read region of interest from data selection keyword
-    m_roi = gammalib::read_ds_roi(events);
-
-    // Read energy boundaries from data selection keyword
-    m_ebounds = gammalib::read_ds_ebounds(events);
+    const GFitsTable& table = *fits.table("EVENTS");
+    read_events(table);
+    read_events_recon(table, 0, size());
 
     // Return
     return;
@@ -458,6 +540,19 @@ std::string GCTAEventList::print(const GChatter& chatter) const
         result.append("\n"+gammalib::parformat("Number of events") +
                       gammalib::str(size()));
 
+        // Append streaming information
+        if (is_streamed()) {
+            result.append("\n"+gammalib::parformat("Streamed from"));
+            if (m_stream_table != NULL) {
+                result.append("table in memory");
+            }
+            else {
+                result.append(m_stream_file);
+            }
+            result.append("\n"+gammalib::parformat("Chunk size") +
+                          gammalib::str(m_chunk_size)+" events");
+        }
+
         // Append GTI interval
         result.append("\n"+gammalib::parformat("Time interval"));
         if (gti().size() > 0) {
@@ -516,13 +611,16 @@ std::string GCTAEventList::print(const GChatter& chatter) const
 
         // EXPLICIT: Append IRF cache
         if (chatter >= EXPLICIT) {
-            for (int i = 0; i < m_irf_names.size(); ++i) {
+            int i = 0;
+            for (irf_cache_entry* entry = m_irf_first; entry != NULL;
+                 entry = entry->next, ++i) {
                 result.append("\n"+gammalib::parformat("IRF cache " +
                               gammalib::str(i)));
-                result.append(m_irf_names[i]+" = ");
+                result.append(gammalib::interned(entry->id)+" = ");
                 int num   = 0;
-                for (int k = 0; k < size(); ++k) {
-                    if ((m_irf_values[i])[k] != -1.0) {
+                int nvals = entry->values.size();
+                for (int k = 0; k < nvals; ++k) {
+                    if (entry->values[k] != -1.0) {
                         num++;
                     }
                 }
@@ -542,16 +640,148 @@ std::string GCTAEventList::print(const GChatter& chatter) const
  *
  * @param[in] event Event.
  *
+ * @exception GException::invalid_value
+ *            Event list is streamed from the event file.
+ *
  * Appends an event atom to the event list.
  ***************************************************************************/
 void GCTAEventList::append(const GCTAEventAtom& event)
 {
-    // Append event
-    m_events.push_back(event);
+    // Throw an exception if events are streamed
+    if (is_streamed()) {
+        std::string msg = "Events cannot be appended to streamed events.";
+        throw GException::invalid_value(G_APPEND, msg);
+    }
 
-    // Set event index
-    int index = m_events.size()-1;
-    m_events[index].m_index = index;
+    // Read deferred reconstruction information and write back any pending
+    // modification
+    load_recon();
+    flush_edit();
+
+    // Add an empty event to the mandatory columns
+    m_ra.push_back(0.0);
+    m_dec.push_back(0.0);
+    m_detx.push_back(0.0);
+    m_dety.push_back(0.0);
+    m_logE.push_back(0.0);
+    m_times.push_back(0.0);
+    m_event_ids.push_back(0);
+    m_obs_ids.push_back(0);
+
+    // Extend optional columns if they exist
+    if (!m_phases.empty()) {
+        m_phases.push_back(0.0);
+    }
+    if (!m_recon.empty()) {
+        m_recon.insert(m_recon.end(), recon_size, 0.0);
+    }
+
+    // Set event
+    set_event(size()-1, event);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Stream events from event FITS file
+ *
+ * @param[in] filename Name of FITS file from which events are streamed.
+ * @param[in] chunk_size Number of rows per chunk (>0).
+ *
+ * @exception GException::invalid_argument
+ *            Chunk size is not positive.
+ *
+ * Attaches the EVENTS extension of a FITS file to the event list without
+ * loading the events into memory. The Good Time Intervals, the region of
+ * interest and the energy boundaries are read as by load().
+ *
+ * The events are read on access in chunks of @p chunk_size consecutive
+ * rows, and only a single chunk is held in memory at any time. Peak memory
+ * is hence bounded by the chunk size, independent of the number of events
+ * in the file.
+ *
+ * The method clears the object before streaming, thus any events residing
+ * in the object before will be lost.
+ ***************************************************************************/
+void GCTAEventList::stream(const std::string& filename,
+                           const int&         chunk_size)
+{
+    // Throw an exception if the chunk size is not positive
+    if (chunk_size < 1) {
+        std::string msg = "Chunk size "+gammalib::str(chunk_size)+" is not "
+                          "positive. Please specify a positive number of "
+                          "rows per chunk.";
+        throw GException::invalid_argument(G_STREAM1, msg);
+    }
+
+    // Clear object
+    clear();
+
+    // Open FITS file
+    GFits fits(filename);
+
+    // Read Good Time Intervals, region of interest and energy boundaries
+    read_header(fits);
+
+    // Get number of events
+    int num = fits.table("EVENTS")->nrows();
+
+    // Close FITS file
+    fits.close();
+
+    // Set streaming information
+    m_stream_file = filename;
+    m_stream_rows = num;
+    m_chunk_size  = chunk_size;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Stream events from FITS table
+ *
+ * @param[in] table Events table from which events are streamed.
+ * @param[in] chunk_size Number of rows per chunk (>0).
+ *
+ * @exception GException::invalid_argument
+ *            Chunk size is not positive.
+ *
+ * Streams the events from an events table. A single Good Time Interval is
+ * built from the TSTART and TSTOP keywords of the table, and the region of
+ * interest and the energy boundaries are read from the data selection
+ * keywords. The table is copied, hence the method is meant for tables that
+ * are held in memory; use stream(const std::string&, const int&) to stream
+ * events from a file.
+ *
+ * The method clears the object before streaming, thus any events residing
+ * in the object before will be lost.
+ ***************************************************************************/
+void GCTAEventList::stream(const GFitsTable& table, const int& chunk_size)
+{
+    // Throw an exception if the chunk size is not positive
+    if (chunk_size < 1) {
+        std::string msg = "Chunk size "+gammalib::str(chunk_size)+" is not "
+                          "positive. Please specify a positive number of "
+                          "rows per chunk.";
+        throw GException::invalid_argument(G_STREAM2, msg);
+    }
+
+    // Clear object
+    clear();
+
+    // Read Good Time Interval, region of interest and energy boundaries
+    read_header(table);
+
+    // Copy events table
+    m_stream_table = table.clone();
+
+    // Set streaming information
+    m_stream_rows = m_stream_table->nrows();
+    m_chunk_size  = chunk_size;
 
     // Return
     return;
@@ -571,12 +801,45 @@ void GCTAEventList::init_members(void)
 {
     // Initialise members
     m_roi.clear();
-    m_events.clear();
     m_has_phase = false;
 
+    // Initialise event columns
+    m_ra.clear();
+    m_dec.clear();
+    m_detx.clear();
+    m_dety.clear();
+    m_logE.clear();
+    m_times.clear();
+    m_event_ids.clear();
+    m_obs_ids.clear();
+    m_phases.clear();
+    m_recon.clear();
+    m_recon_file.clear();
+    m_recon_size = 0;
+    m_recon_time = 0;
+
+    // Initialise read access data of threads
+    #ifdef _OPENMP
+    m_threads.assign(omp_get_max_threads(), NULL);
+    #else
+    m_threads.assign(1, NULL);
+    #endif
+    m_threads_extra.clear();
+
+    // Initialise event atom view for write access
+    m_edit.clear();
+    m_edit_index = -1;
+
+    // Initialise event streaming
+    m_stream_file.clear();
+    m_stream_fits  = NULL;
+    m_stream_table = NULL;
+    m_stream_rows  = 0;
+    m_chunk_size   = 0;
+
     // Initialise cache
-    m_irf_names.clear();
-    m_irf_values.clear();
+    m_irf_first = NULL;
+    m_irf_last  = NULL;
 
     // Return
     return;
@@ -592,12 +855,50 @@ void GCTAEventList::copy_members(const GCTAEventList& list)
 {
     // Copy members
     m_roi       = list.m_roi;
-    m_events    = list.m_events;
     m_has_phase = list.m_has_phase;
 
+    // Copy event columns
+    m_ra         = list.m_ra;
+    m_dec        = list.m_dec;
+    m_detx       = list.m_detx;
+    m_dety       = list.m_dety;
+    m_logE       = list.m_logE;
+    m_times      = list.m_times;
+    m_event_ids  = list.m_event_ids;
+    m_obs_ids    = list.m_obs_ids;
+    m_phases     = list.m_phases;
+    m_recon      = list.m_recon;
+    m_recon_file = list.m_recon_file;
+    m_recon_size = list.m_recon_size;
+    m_recon_time = list.m_recon_time;
+
+    // Copy write view (it may hold modifications that were not yet
+    // written back). The views for read access are not copied
+    m_edit       = list.m_edit;
+    m_edit_index = list.m_edit_index;
+
+    // Copy event streaming information. The event file and the chunks are
+    // not copied but opened and read again on access
+    m_stream_file = list.m_stream_file;
+    m_stream_rows = list.m_stream_rows;
+    m_chunk_size  = list.m_chunk_size;
+    if (list.m_stream_table != NULL) {
+        m_stream_table = list.m_stream_table->clone();
+    }
+
     // Copy cache
-    m_irf_names  = list.m_irf_names;
-    m_irf_values = list.m_irf_values;
+    for (irf_cache_entry* entry = list.m_irf_first; entry != NULL;
+         entry = entry->next) {
+        irf_cache_entry* copy = new irf_cache_entry(*entry);
+        copy->next = NULL;
+        if (m_irf_last != NULL) {
+            m_irf_last->next = copy;
+        }
+        else {
+            m_irf_first = copy;
+        }
+        m_irf_last = copy;
+    }
 
     // Return
     return;
@@ -609,6 +910,114 @@ void GCTAEventList::copy_members(const GCTAEventList& list)
  ***************************************************************************/
 void GCTAEventList::free_members(void)
 {
+    // Close streamed event file and free streamed table
+    if (m_stream_fits  != NULL) delete m_stream_fits;
+    if (m_stream_table != NULL) delete m_stream_table;
+    m_stream_fits  = NULL;
+    m_stream_table = NULL;
+
+    // Free read access data of threads
+    int nthreads = m_threads.size();
+    for (int i = 0; i < nthreads; ++i) {
+        if (m_threads[i] != NULL) {
+            if (m_threads[i]->chunk != NULL) delete m_threads[i]->chunk;
+            delete m_threads[i];
+            m_threads[i] = NULL;
+        }
+    }
+    std::map<int, thread_data*>::iterator it;
+    for (it = m_threads_extra.begin(); it != m_threads_extra.end(); ++it) {
+        if (it->second->chunk != NULL) delete it->second->chunk;
+        delete it->second;
+    }
+    m_threads_extra.clear();
+
+    // Free cache
+    while (m_irf_first != NULL) {
+        irf_cache_entry* next = m_irf_first->next;
+        delete m_irf_first;
+        m_irf_first = next;
+    }
+    m_irf_last = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read event list header information from FITS file
+ *
+ * @param[in] fits FITS file.
+ *
+ * Reads the Good Time Intervals, the region of interest and the energy
+ * boundaries of the event list from the "EVENTS" extension and, if
+ * present, the "GTI" extension of a FITS file (see
+ * read_header(const GFitsTable&, const GFitsTable*)).
+ ***************************************************************************/
+void GCTAEventList::read_header(const GFits& fits)
+{
+    // Get GTI extension if it exists
+    const GFitsTable* gti = (fits.contains("GTI")) ? fits.table("GTI") : NULL;
+
+    // Read header information
+    read_header(*fits.table("EVENTS"), gti);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read event list header information from FITS tables
+ *
+ * @param[in] events Events table.
+ * @param[in] gti Good Time Intervals table (NULL if not available).
+ *
+ * Reads the Good Time Intervals, the region of interest and the energy
+ * boundaries of the event list. If a @p gti table is given, Good Time
+ * Intervals will be read from that table, otherwise a single Good Time
+ * Interval is built from the TSTART and TSTOP keywords of the @p events
+ * table. The region of interest and the energy boundaries are read from
+ * the data selection keywords of the @p events table.
+ ***************************************************************************/
+void GCTAEventList::read_header(const GFitsTable& events,
+                                const GFitsTable* gti)
+{
+    // If we have a GTI table, then read Good Time Intervals from that
+    // table
+    if (gti != NULL) {
+        m_gti.read(*gti);
+    }
+
+    // ... otherwise build GTI from TSTART and TSTOP
+    else {
+
+        // Read start and stop time
+        double tstart = events.real("TSTART");
+        double tstop  = events.real("TSTOP");
+
+        // Create time reference from header information
+        GTimeReference timeref(events);
+
+        // Set start and stop time
+        GTime start(tstart);
+        GTime stop(tstop);
+
+        // Append start and stop time as single time interval to GTI
+        m_gti.append(start, stop);
+
+        // Set GTI time reference
+        m_gti.reference(timeref);
+
+    } // endelse: GTI built from TSTART and TSTOP
+
+    // Read region of interest from data selection keyword
+    m_roi = gammalib::read_ds_roi(events);
+
+    // Read energy boundaries from data selection keyword
+    m_ebounds = gammalib::read_ds_ebounds(events);
+
     // Return
     return;
 }
@@ -618,35 +1027,52 @@ void GCTAEventList::free_members(void)
  * @brief Read CTA events from FITS table
  *
  * @param[in] table FITS table.
+ * @param[in] row Index of first row to read (default: 0).
+ * @param[in] nrows Number of rows to read (default: -1, all rows from
+ *                  @p row on).
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
  * Depending on the columns existing in the file, it either selects v0 or
- * v1 of the event list reader.
+ * v1 of the event list reader. The reconstruction information is not read
+ * (see read_events_recon()).
+ *
+ * The columns are read row range by row range using
+ * GFitsTableCol::read_rows(), hence FITS columns that are not yet loaded
+ * are not brought into memory.
  ***************************************************************************/
-void GCTAEventList::read_events(const GFitsTable& table)
+void GCTAEventList::read_events(const GFitsTable& table, const int& row,
+                                const int& nrows)
 {
     // Clear existing events
-    m_events.clear();
-
-    // Extract number of events in FITS file
-    int num = table.integer("NAXIS2");
+    m_ra.clear();
+    m_dec.clear();
+    m_detx.clear();
+    m_dety.clear();
+    m_logE.clear();
+    m_times.clear();
+    m_event_ids.clear();
+    m_obs_ids.clear();
+    m_phases.clear();
+    m_recon.clear();
+    m_recon_file.clear();
+    m_edit_index = -1;
+
+    // Determine number of events to read
+    int num = (nrows < 0) ? table.integer("NAXIS2") - row : nrows;
 
     // Continue only if there are events
     if (num > 0) {
 
         // Read events for v1
         if (table.contains("SHWIDTH") && table.contains("SHLENGTH")) {
-            read_events_v1(table);
+            read_events_v1(table, row, num);
         }
 
         // ... otherwise read events for v0
         else {
-            read_events_v0(table);
+            read_events_v0(table, row, num);
         }
 
-        // Read (optional) Hillas parameters
-        read_events_hillas(table);
-
     } // endif: there were events
 
     // Return
@@ -658,86 +1084,74 @@ void GCTAEventList::read_events(const GFitsTable& table)
  * @brief Read CTA events from FITS table (version 0)
  *
  * @param[in] table FITS table.
+ * @param[in] row Index of first row to read.
+ * @param[in] nrows Number of rows to read.
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
  * It is a minimal event reader that is compliant with the initial data
  * format distributed by Karl Kosack. Information that is not present in
  * that format is set to 0.
  ***************************************************************************/
-void GCTAEventList::read_events_v0(const GFitsTable& table)
+void GCTAEventList::read_events_v0(const GFitsTable& table, const int& row,
+                                   const int& nrows)
 {
-    // Clear existing events
-    m_events.clear();
-
-    // Extract number of events in FITS file
-    int num = table.nrows();
-
     // If there are events then load them
-    if (num > 0) {
-
-        // Reserve data
-        m_events.reserve(num);
-
-        // Get column pointers
-        const GFitsTableCol* ptr_eid         = table["EVENT_ID"];
-        const GFitsTableCol* ptr_time        = table["TIME"];
-        const GFitsTableCol* ptr_multip      = table["MULTIP"];
-        const GFitsTableCol* ptr_ra          = table["RA"];
-        const GFitsTableCol* ptr_dec         = table["DEC"];
-        const GFitsTableCol* ptr_dir_err     = table["DIR_ERR"];
-        const GFitsTableCol* ptr_detx        = table["DETX"];
-        const GFitsTableCol* ptr_dety        = table["DETY"];
-        const GFitsTableCol* ptr_alt         = table["ALT"];
-        const GFitsTableCol* ptr_az          = table["AZ"];
-        const GFitsTableCol* ptr_corex       = table["COREX"];
-        const GFitsTableCol* ptr_corey       = table["COREY"];
-        const GFitsTableCol* ptr_core_err    = table["CORE_ERR"];
-        const GFitsTableCol* ptr_xmax        = table["XMAX"];
-        const GFitsTableCol* ptr_xmax_err    = table["XMAX_ERR"];
-        const GFitsTableCol* ptr_energy      = table["ENERGY"];
-        const GFitsTableCol* ptr_energy_err  = table["ENERGY_ERR"];
+    if (nrows > 0) {
 
         // Check for phase column
-        const GFitsTableCol* ptr_phase;
-        if (table.contains("PHASE")) {
-            m_has_phase = true;
-            ptr_phase   = table["PHASE"];
+        m_has_phase = table.contains("PHASE");
+
+        // Allocate columns
+        m_ra.assign(nrows, 0.0);
+        m_dec.assign(nrows, 0.0);
+        m_detx.assign(nrows, 0.0);
+        m_dety.assign(nrows, 0.0);
+        m_logE.assign(nrows, 0.0);
+        m_times.assign(nrows, 0.0);
+        m_obs_ids.assign(nrows, 0);
+        if (m_has_phase) {
+            m_phases.assign(nrows, 0.0);
         }
-        else {
-            m_has_phase = false;
+
+        // Copy data from FITS columns into event columns. The event
+        // identifiers are read as integers to preserve 64-bit values
+        table["EVENT_ID"]->read_rows(row, nrows, m_event_ids);
+        std::vector<double> values;
+        table["TIME"]->read_rows(row, nrows, values);
+        GTime time;
+        for (int i = 0; i < nrows; ++i) {
+            time.set(values[i], m_gti.reference());
+            m_times[i] = time.secs();
+        }
+        table["RA"]->read_rows(row, nrows, values);
+        for (int i = 0; i < nrows; ++i) {
+            m_ra[i] = values[i] * gammalib::deg2rad;
+        }
+        table["DEC"]->read_rows(row, nrows, values);
+        for (int i = 0; i < nrows; ++i) {
+            m_dec[i] = values[i] * gammalib::deg2rad;
+        }
+        table["DETX"]->read_rows(row, nrows, values);
+        for (int i = 0; i < nrows; ++i) {
+            m_detx[i] = values[i] * gammalib::deg2rad;
+        }
+        table["DETY"]->read_rows(row, nrows, values);
+        for (int i = 0; i < nrows; ++i) {
+            m_dety[i] = values[i] * gammalib::deg2rad;
+        }
+        table["ENERGY"]->read_rows(row, nrows, values);
+        GEnergy energy;
+        for (int i = 0; i < nrows; ++i) {
+            energy.TeV(values[i]);
+            m_logE[i] = energy.log10MeV();
         }
 
-        // Copy data from columns into GCTAEventAtom objects
-        GCTAEventAtom event;
-        for (int i = 0; i < num; ++i) {
-            event.m_index     = i;
-            event.m_time.set(ptr_time->real(i), m_gti.reference());
-            event.m_dir.dir().radec_deg(ptr_ra->real(i), ptr_dec->real(i));
-            event.m_dir.detx(ptr_detx->real(i)*gammalib::deg2rad);
-            event.m_dir.dety(ptr_dety->real(i)*gammalib::deg2rad);
-            event.m_energy.TeV(ptr_energy->real(i));
-            event.m_event_id    = ptr_eid->integer(i);
-            event.m_obs_id      = 0;
-            event.m_multip      = ptr_multip->integer(i);
-            event.m_telmask     = 0;
-            event.m_dir_err     = ptr_dir_err->real(i);
-            event.m_alt         = ptr_alt->real(i);
-            event.m_az          = ptr_az->real(i);
-            event.m_corex       = ptr_corex->real(i);
-            event.m_corey       = ptr_corey->real(i);
-            event.m_core_err    = ptr_core_err->real(i);
-            event.m_xmax        = ptr_xmax->real(i);
-            event.m_xmax_err    = ptr_xmax_err->real(i);
-            event.m_shwidth     = 0.0;
-            event.m_shlength    = 0.0;
-            event.m_energy_err  = ptr_energy_err->real(i);
-
-            // Set pulse phase if available
-            if (m_has_phase) {
-                event.m_phase = ptr_phase->real(i);
+        // Set pulse phase if available
+        if (m_has_phase) {
+            table["PHASE"]->read_rows(row, nrows, values);
+            for (int i = 0; i < nrows; ++i) {
+                m_phases[i] = values[i];
             }
-
-            m_events.push_back(event);
         }
 
     } // endif: there were events
@@ -751,89 +1165,25 @@ void GCTAEventList::read_events_v0(const GFitsTable& table)
  * @brief Read CTA events from FITS table (version 1)
  *
  * @param[in] table FITS table.
+ * @param[in] row Index of first row to read.
+ * @param[in] nrows Number of rows to read.
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
+ * The version 1 format extends version 0 by the observation identifier.
  *
  * @todo Implement agreed column format
  ***************************************************************************/
-void GCTAEventList::read_events_v1(const GFitsTable& table)
+void GCTAEventList::read_events_v1(const GFitsTable& table, const int& row,
+                                   const int& nrows)
 {
-    // Clear existing events
-    m_events.clear();
-
-    // Extract number of events in FITS file
-    int num = table.nrows();
-
     // If there are events then load them
-    if (num > 0) {
+    if (nrows > 0) {
 
-        // Reserve data
-        m_events.reserve(num);
-
-        // Get column pointers
-        const GFitsTableCol* ptr_eid         = table["EVENT_ID"];
-        const GFitsTableCol* ptr_oid         = table["OBS_ID"];
-        const GFitsTableCol* ptr_time        = table["TIME"];
-        const GFitsTableCol* ptr_multip      = table["MULTIP"];
-        const GFitsTableCol* ptr_ra          = table["RA"];
-        const GFitsTableCol* ptr_dec         = table["DEC"];
-        const GFitsTableCol* ptr_dir_err     = table["DIR_ERR"];
-        const GFitsTableCol* ptr_detx        = table["DETX"];
-        const GFitsTableCol* ptr_dety        = table["DETY"];
-        const GFitsTableCol* ptr_alt         = table["ALT"];
-        const GFitsTableCol* ptr_az          = table["AZ"];
-        const GFitsTableCol* ptr_corex       = table["COREX"];
-        const GFitsTableCol* ptr_corey       = table["COREY"];
-        const GFitsTableCol* ptr_core_err    = table["CORE_ERR"];
-        const GFitsTableCol* ptr_xmax        = table["XMAX"];
-        const GFitsTableCol* ptr_xmax_err    = table["XMAX_ERR"];
-        const GFitsTableCol* ptr_shw         = table["SHWIDTH"];
-        const GFitsTableCol* ptr_shl         = table["SHLENGTH"];
-        const GFitsTableCol* ptr_energy      = table["ENERGY"];
-        const GFitsTableCol* ptr_energy_err  = table["ENERGY_ERR"];
+        // Read the columns that are common to version 0
+        read_events_v0(table, row, nrows);
 
-        // Check for phase column
-        const GFitsTableCol* ptr_phase;
-        if (table.contains("PHASE")) {
-            m_has_phase = true;
-            ptr_phase   = table["PHASE"];
-        }
-        else {
-            m_has_phase = false;
-        }
-
-        // Copy data from columns into GCTAEventAtom objects
-        GCTAEventAtom event;
-        for (int i = 0; i < num; ++i) {
-            event.m_index     = i;
-            event.m_time.set(ptr_time->real(i), m_gti.reference());
-            event.m_dir.dir().radec_deg(ptr_ra->real(i), ptr_dec->real(i));
-            event.m_dir.detx(ptr_detx->real(i)*gammalib::deg2rad);
-            event.m_dir.dety(ptr_dety->real(i)*gammalib::deg2rad);
-            event.m_energy.TeV(ptr_energy->real(i));
-            event.m_event_id    = ptr_eid->integer(i);
-            event.m_obs_id      = ptr_oid->integer(i);
-            event.m_multip      = ptr_multip->integer(i);
-            event.m_telmask     = 0;
-            event.m_dir_err     = ptr_dir_err->real(i);
-            event.m_alt         = ptr_alt->real(i);
-            event.m_az          = ptr_az->real(i);
-            event.m_corex       = ptr_corex->real(i);
-            event.m_corey       = ptr_corey->real(i);
-            event.m_core_err    = ptr_core_err->real(i);
-            event.m_xmax        = ptr_xmax->real(i);
-            event.m_xmax_err    = ptr_xmax_err->real(i);
-            event.m_shwidth     = ptr_shw->real(i);
-            event.m_shlength    = ptr_shl->real(i);
-            event.m_energy_err  = ptr_energy_err->real(i);
-
-            // Set phase if available
-            if (m_has_phase) {
-                event.m_phase = ptr_phase->real(i);
-            }
-
-            m_events.push_back(event);
-        }
+        // Read observation identifiers
+        table["OBS_ID"]->read_rows(row, nrows, m_obs_ids);
 
     } // endif: there were events
 
@@ -843,60 +1193,49 @@ void GCTAEventList::read_events_v1(const GFitsTable& table)
 
 
 /***********************************************************************//**
- * @brief Read Hillas information for CTA events from FITS table
+ * @brief Read reconstruction information for CTA events from FITS table
  *
  * @param[in] table FITS table.
+ * @param[in] row Index of first row to read.
+ * @param[in] nrows Number of rows to read.
  *
- * This method reads the Hillas reconstruction information for CTA events
- * from an EVENTS file. It searches for the columns HIL_MSW, HIL_MSW_ERR,
- * HIL_MSL, and HIL_MSL_ERR in the FITS table and extracts the relevant
- * columns from the FITS file. If a column is not found, no action is
- * performed.
- *
- * @todo Verify consistency of event list size
+ * This method reads the reconstruction information for CTA events from an
+ * EVENTS file. It searches for the columns MULTIP, DIR_ERR, ALT, AZ, COREX,
+ * COREY, CORE_ERR, XMAX, XMAX_ERR, SHWIDTH, SHLENGTH, ENERGY_ERR, HIL_MSW,
+ * HIL_MSW_ERR, HIL_MSL, and HIL_MSL_ERR in the FITS table and extracts the
+ * relevant columns from the FITS file. Columns that are not found are set
+ * to zero. If none of the columns is found, no memory is allocated for the
+ * reconstruction information.
  ***************************************************************************/
-void GCTAEventList::read_events_hillas(const GFitsTable& table)
+void GCTAEventList::read_events_recon(const GFitsTable& table, const int& row,
+                                      const int& nrows)
 {
-    // Extract number of events in FITS file
-    int num = table.nrows();
+    // Continue only if the number of events is consistent with the
+    // event list
+    if (nrows > 0 && nrows == size()) {
 
-    //TODO: Make sure that dimension is consistent with existing event
-    //      list
+        // Loop over reconstruction columns
+        std::vector<double> values;
+        for (int k = 0; k < recon_size; ++k) {
 
-    // Continue only if there are events
-    if (num > 0) {
-
-        // HIL_MSW
-        if (table.contains("HIL_MSW")) {
-            const GFitsTableCol* ptr = table["HIL_MSW"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msw = ptr->real(i);
+            // Skip column if it does not exist
+            if (!table.contains(recon_names[k])) {
+                continue;
             }
-        }
 
-        // HIL_MSW_ERR
-        if (table.contains("HIL_MSW_ERR")) {
-            const GFitsTableCol* ptr = table["HIL_MSW_ERR"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msw_err = ptr->real(i);
+            // Allocate reconstruction information if needed
+            if (m_recon.empty()) {
+                m_recon.assign(std::size_t(nrows) * recon_size, 0.0);
             }
-        }
 
-        // HIL_MSL
-        if (table.contains("HIL_MSL")) {
-            const GFitsTableCol* ptr = table["HIL_MSL"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msl = ptr->real(i);
+            // Copy column
+            table[recon_names[k]]->read_rows(row, nrows, values);
+            float* recon = &(m_recon[k]);
+            for (int i = 0; i < nrows; ++i, recon += recon_size) {
+                *recon = values[i];
             }
-        }
 
-        // HIL_MSL_ERR
-        if (table.contains("HIL_MSL_ERR")) {
-            const GFitsTableCol* ptr = table["HIL_MSL_ERR"];
-            for (int i = 0; i < num; ++i) {
-                m_events[i].m_hil_msl_err = ptr->real(i);
-            }
-        }
+        } // endfor: looped over reconstruction columns
 
     } // endif: there were events
 
@@ -923,6 +1262,16 @@ void GCTAEventList::write_events(GFitsBinTable& hdu) const
     // If there are events then write them now
     if (size() > 0) {
 
+        // Read deferred reconstruction information and write back any
+        // pending modification of the write view. The write view stays
+        // valid so that pointers that were handed out by the non-const
+        // access operator can still be used (circumvent const correctness)
+        GCTAEventList* list = const_cast<GCTAEventList*>(this);
+        list->load_recon();
+        if (m_edit_index >= 0) {
+            list->set_event(m_edit_index, m_edit);
+        }
+
         // Allocate columns
         GFitsTableULongCol  col_eid         = GFitsTableULongCol("EVENT_ID", size());
         GFitsTableULongCol  col_oid         = GFitsTableULongCol("OBS_ID", size());
@@ -959,36 +1308,41 @@ void GCTAEventList::write_events(GFitsBinTable& hdu) const
 
         // Fill columns
         for (int i = 0; i < size(); ++i) {
-            col_eid(i)         = m_events[i].m_event_id;
-            col_oid(i)         = m_events[i].m_obs_id;
-            col_time(i)        = m_events[i].time().convert(m_gti.reference());
+
+            // Get event
+            const GCTAEventAtom* event = (*this)[i];
+
+            // Fill event
+            col_eid(i)         = event->m_event_id;
+            col_oid(i)         = event->m_obs_id;
+            col_time(i)        = event->time().convert(m_gti.reference());
             col_live(i)        = 0.0;
             col_multip(i)      = 0;
             //col_telmask
-            col_ra(i)          = m_events[i].dir().dir().ra_deg();
-            col_dec(i)         = m_events[i].dir().dir().dec_deg();
-            col_direrr(i)      = m_events[i].m_dir_err;
-            col_detx(i)        = m_events[i].dir().detx() * gammalib::rad2deg;
-            col_dety(i)        = m_events[i].dir().dety() * gammalib::rad2deg;
-            col_alt(i)         = m_events[i].m_alt;
-            col_az(i)          = m_events[i].m_az;
-            col_corex(i)       = m_events[i].m_corex;
-            col_corey(i)       = m_events[i].m_corey;
-            col_core_err(i)    = m_events[i].m_core_err;
-            col_xmax(i)        = m_events[i].m_xmax;
-            col_xmax_err(i)    = m_events[i].m_xmax_err;
-            col_shw(i)         = m_events[i].m_shwidth;
-            col_shl(i)         = m_events[i].m_shlength;
-            col_energy(i)      = m_events[i].energy().TeV();
-            col_energy_err(i)  = m_events[i].m_energy_err;
-            col_hil_msw(i)     = m_events[i].m_hil_msw;
-            col_hil_msw_err(i) = m_events[i].m_hil_msw_err;
-            col_hil_msl(i)     = m_events[i].m_hil_msl;
-            col_hil_msl_err(i) = m_events[i].m_hil_msl_err;
+            col_ra(i)          = event->dir().dir().ra_deg();
+            col_dec(i)         = event->dir().dir().dec_deg();
+            col_direrr(i)      = event->m_dir_err;
+            col_detx(i)        = event->dir().detx() * gammalib::rad2deg;
+            col_dety(i)        = event->dir().dety() * gammalib::rad2deg;
+            col_alt(i)         = event->m_alt;
+            col_az(i)          = event->m_az;
+            col_corex(i)       = event->m_corex;
+            col_corey(i)       = event->m_corey;
+            col_core_err(i)    = event->m_core_err;
+            col_xmax(i)        = event->m_xmax;
+            col_xmax_err(i)    = event->m_xmax_err;
+            col_shw(i)         = event->m_shwidth;
+            col_shl(i)         = event->m_shlength;
+            col_energy(i)      = event->energy().TeV();
+            col_energy_err(i)  = event->m_energy_err;
+            col_hil_msw(i)     = event->m_hil_msw;
+            col_hil_msw_err(i) = event->m_hil_msw_err;
+            col_hil_msl(i)     = event->m_hil_msl;
+            col_hil_msl_err(i) = event->m_hil_msl_err;
 
             // Optionally fill pulse phase column
             if (m_has_phase) {
-                col_phase(i) = m_events[i].m_phase;
+                col_phase(i) = event->m_phase;
             }
 
         } // endfor: looped over rows
@@ -1091,60 +1445,454 @@ void GCTAEventList::write_ds_keys(GFitsHDU& hdu) const
 
 
 /***********************************************************************//**
- * @brief Initialize IRF cache for a given model
+ * @brief Fill event atom from event columns
  *
- * @param[in] name Model name.
- * @return Cache index (-1 if invalid).
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[out] event Event atom.
  ***************************************************************************/
-int GCTAEventList::irf_cache_init(const std::string& name) const
+void GCTAEventList::get_event(const int& index, GCTAEventAtom& event) const
 {
-    // Initialise cache index
-    int index = irf_cache_index(name);
+    // Set event index
+    event.m_index = index;
+
+    // Set direction, energy and time
+    event.m_dir.dir().radec(m_ra[index], m_dec[index]);
+    event.m_dir.detx(m_detx[index]);
+    event.m_dir.dety(m_dety[index]);
+    event.m_energy.log10MeV(m_logE[index]);
+    event.m_time.secs(m_times[index]);
+
+    // Set identifiers
+    event.m_event_id = m_event_ids[index];
+    event.m_obs_id   = m_obs_ids[index];
+    event.m_telmask  = 0;
+
+    // Set phase
+    event.m_phase = (m_phases.empty()) ? 0.0 : m_phases[index];
+
+    // Set reconstruction information
+    if (m_recon.empty()) {
+        event.m_multip      = 0;
+        event.m_dir_err     = 0.0;
+        event.m_alt         = 0.0;
+        event.m_az          = 0.0;
+        event.m_corex       = 0.0;
+        event.m_corey       = 0.0;
+        event.m_core_err    = 0.0;
+        event.m_xmax        = 0.0;
+        event.m_xmax_err    = 0.0;
+        event.m_shwidth     = 0.0;
+        event.m_shlength    = 0.0;
+        event.m_energy_err  = 0.0;
+        event.m_hil_msw     = 0.0;
+        event.m_hil_msw_err = 0.0;
+        event.m_hil_msl     = 0.0;
+        event.m_hil_msl_err = 0.0;
+    }
+    else {
+        const float* recon  = &(m_recon[std::size_t(index) * recon_size]);
+        event.m_multip      = int(recon[0]);
+        event.m_dir_err     = recon[1];
+        event.m_alt         = recon[2];
+        event.m_az          = recon[3];
+        event.m_corex       = recon[4];
+        event.m_corey       = recon[5];
+        event.m_core_err    = recon[6];
+        event.m_xmax        = recon[7];
+        event.m_xmax_err    = recon[8];
+        event.m_shwidth     = recon[9];
+        event.m_shlength    = recon[10];
+        event.m_energy_err  = recon[11];
+        event.m_hil_msw     = recon[12];
+        event.m_hil_msw_err = recon[13];
+        event.m_hil_msl     = recon[14];
+        event.m_hil_msl_err = recon[15];
+    }
+
+    // Return
+    return;
+}
 
-    // Continue only if model does not yet exist
-    if (index == -1) {
 
-        // Add model name and vector to cache. The vector is initialized
-        // to -1, which signals that no cache values exist
-        m_irf_names.push_back(name);
-        m_irf_values.push_back(std::vector<double>(size(), -1.0));
+/***********************************************************************//**
+ * @brief Store event atom in event columns
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] event Event atom.
+ *
+ * Stores an event atom in the event columns. The optional phase and
+ * reconstruction columns are allocated when the first event that carries
+ * such information is stored.
+ ***************************************************************************/
+void GCTAEventList::set_event(const int& index, const GCTAEventAtom& event)
+{
+    // Store direction, energy and time
+    m_ra[index]       = event.m_dir.dir().ra();
+    m_dec[index]      = event.m_dir.dir().dec();
+    m_detx[index]     = event.m_dir.detx();
+    m_dety[index]     = event.m_dir.dety();
+    m_logE[index]     = event.m_energy.log10MeV();
+    m_times[index]    = event.m_time.secs();
+
+    // Store identifiers
+    m_event_ids[index] = event.m_event_id;
+    m_obs_ids[index]   = event.m_obs_id;
+
+    // Store phase
+    if (m_phases.empty() && event.m_phase != 0.0) {
+        m_phases.assign(size(), 0.0);
+    }
+    if (!m_phases.empty()) {
+        m_phases[index] = event.m_phase;
+    }
 
-        // Set index
-        index = m_irf_names.size()-1;
+    // Gather reconstruction information
+    float values[recon_size] = {float(event.m_multip), event.m_dir_err,
+                                event.m_alt,           event.m_az,
+                                event.m_corex,         event.m_corey,
+                                event.m_core_err,      event.m_xmax,
+                                event.m_xmax_err,      event.m_shwidth,
+                                event.m_shlength,      event.m_energy_err,
+                                event.m_hil_msw,       event.m_hil_msw_err,
+                                event.m_hil_msl,       event.m_hil_msl_err};
+
+    // Allocate reconstruction information if the event carries any
+    if (m_recon.empty()) {
+        for (int k = 0; k < recon_size; ++k) {
+            if (values[k] != 0.0) {
+                m_recon.assign(std::size_t(size()) * recon_size, 0.0);
+                break;
+            }
+        }
+    }
 
-    } // endif: model cache did not yet exist
+    // Store reconstruction information
+    if (!m_recon.empty()) {
+        float* recon = &(m_recon[std::size_t(index) * recon_size]);
+        for (int k = 0; k < recon_size; ++k) {
+            recon[k] = values[k];
+        }
+    }
 
-    // Return index
-    return index;
+    // Return
+    return;
 }
 
 
 /***********************************************************************//**
- * @brief Determines the cache index for a given model name
+ * @brief Write back modifications of the write view
  *
- * @param[in] name Model name.
- * @return Cache index (-1 if model has not been found).
+ * Stores the event atom that was handed out by the non-const access
+ * operator in the event columns and invalidates the write view.
  ***************************************************************************/
-int GCTAEventList::irf_cache_index(const std::string& name) const
+void GCTAEventList::flush_edit(void)
 {
-    // Initialise index
-    int index = -1;
+    // Continue only if there is a write view
+    if (m_edit_index >= 0) {
 
-    // Continue only if there are models in cache
-    if (!m_irf_names.empty()) {
+        // Store event
+        set_event(m_edit_index, m_edit);
 
-         // Search for model name
-         for (int i = 0; i < m_irf_names.size(); ++i) {
-             if (m_irf_names[i] == name) {
-                 index = i;
-                 break;
-             }
-         }
+        // Invalidate write view
+        m_edit_index = -1;
 
-    } // endif: there were models in cache
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return read access data of calling thread
+ *
+ * @return Pointer to read access data of calling thread.
+ *
+ * Returns the read access data (event atom view and chunk of streamed
+ * events) of the calling thread. The data are indexed by the OpenMP thread
+ * number, and the data of a thread are allocated by the thread itself on
+ * its first access, hence no locking is needed.
+ *
+ * There is one slot for each of the threads that were available when the
+ * event list was created, and outside a parallel region the number of
+ * slots is adapted to the maximum number of threads. Threads with a larger
+ * thread number (e.g. in a parallel region with an explicit number of
+ * threads) get their data from an additional map that is accessed within
+ * a critical zone. The amount of read access data is hence bounded by the
+ * number of threads.
+ ***************************************************************************/
+GCTAEventList::thread_data* GCTAEventList::thread_slot(void) const
+{
+    // Initialise data
+    thread_data* data = NULL;
+
+    // Get thread number of calling thread
+    int thread = 0;
+    #ifdef _OPENMP
+    thread = omp_get_thread_num();
+
+    // Adapt number of slots to maximum number of threads outside a
+    // parallel region
+    if (!omp_in_parallel() && int(m_threads.size()) < omp_get_max_threads()) {
+        m_threads.resize(omp_get_max_threads(), NULL);
+    }
+    #endif
 
-    // Return index
-    return index;
+    // If the thread has a slot then get data from the slot and allocate
+    // the data if the thread has no data yet
+    if (thread < int(m_threads.size())) {
+        if (m_threads[thread] == NULL) {
+            thread_data* slot = new thread_data;
+            slot->chunk       = NULL;
+            slot->chunk_first = -1;
+            m_threads[thread] = slot;
+        }
+        data = m_threads[thread];
+    }
+
+    // ... otherwise get data from the additional map
+    else {
+        #pragma omp critical(GCTAEventList_thread_slot)
+        {
+            std::map<int, thread_data*>::iterator it =
+                m_threads_extra.find(thread);
+            if (it == m_threads_extra.end()) {
+                thread_data* slot = new thread_data;
+                slot->chunk       = NULL;
+                slot->chunk_first = -1;
+                it = m_threads_extra.insert(std::make_pair(thread, slot)).first;
+            }
+            data = it->second;
+        }
+    }
+
+    // Return data
+    return data;
+}
+
+
+/***********************************************************************//**
+ * @brief Read deferred reconstruction information
+ *
+ * @exception GException::file_error
+ *            Event file was modified since the events were loaded.
+ *
+ * Reads the reconstruction information from the event file if it was
+ * deferred by load(). The method does nothing if the reconstruction
+ * information was already read.
+ *
+ * Before reading, the method checks that the size and modification time
+ * of the event file are still those recorded by load(), and that the
+ * EVENTS table still holds one row per event, so that the reconstruction
+ * information is never read from a file that was replaced or rewritten.
+ ***************************************************************************/
+void GCTAEventList::load_recon(void)
+{
+    // Continue only if reconstruction information was deferred
+    if (!m_recon_file.empty()) {
+
+        // Throw an exception if the event file was modified
+        long long file_size = 0;
+        long long file_time = 0;
+        if (!file_identity(m_recon_file, &file_size, &file_time) ||
+            file_size != m_recon_size || file_time != m_recon_time) {
+            std::string msg = "Event file \""+m_recon_file+"\" was modified "
+                              "or removed since the events were loaded. "
+                              "Reconstruction information cannot be read. "
+                              "Please reload the event list.";
+            throw GException::file_error(G_LOAD_RECON, msg);
+        }
+
+        // Open events table and throw an exception if the number of rows
+        // differs from the number of events
+        GFits             fits(m_recon_file);
+        const GFitsTable& table = *fits.table("EVENTS");
+        if (table.nrows() != size()) {
+            std::string msg = "EVENTS table of file \""+m_recon_file+"\" "
+                              "has "+gammalib::str(table.nrows())+" rows but "
+                              "the event list has "+gammalib::str(size())+
+                              " events. Reconstruction information cannot "
+                              "be read. Please reload the event list.";
+            throw GException::file_error(G_LOAD_RECON, msg);
+        }
+
+        // Read reconstruction information
+        read_events_recon(table, 0, size());
+        fits.close();
+
+        // Signal that reconstruction information was read
+        m_recon_file.clear();
+
+    } // endif: reconstruction information was deferred
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Make sure that the chunk of a thread contains an event
+ *
+ * @param[in] data Read access data of calling thread.
+ * @param[in] index Event index [0,...,size()-1].
+ *
+ * @exception GException::runtime_error
+ *            Chunk could not be read.
+ *
+ * Makes sure that the chunk of streamed events of the calling thread
+ * contains the event with the specified @p index. If the chunk is not in
+ * memory, the previous chunk of the thread is replaced by the chunk read
+ * from the streamed table. The event with @p index is then found at index
+ * @p index - data->chunk_first in the chunk.
+ *
+ * Each thread reads into its own chunk, hence only the reading from the
+ * streamed table is done within a critical zone. The event file is opened
+ * when the first chunk is read and is kept open for reading the subsequent
+ * chunks. It is closed when the event list is cleared or destroyed.
+ ***************************************************************************/
+void GCTAEventList::fetch_chunk(thread_data* data, const int& index) const
+{
+    // Determine first row of chunk
+    int first = (index / m_chunk_size) * m_chunk_size;
+
+    // Read chunk if it is not in memory
+    if (data->chunk == NULL || first != data->chunk_first) {
+
+        // Allocate chunk if needed. The chunk inherits the time reference
+        // which is needed for the conversion of the event times
+        if (data->chunk == NULL) {
+            data->chunk = new GCTAEventList;
+            data->chunk->m_gti.reference(m_gti.reference());
+        }
+
+        // Determine number of rows in chunk
+        int nrows = m_stream_rows - first;
+        if (nrows > m_chunk_size) {
+            nrows = m_chunk_size;
+        }
+
+        // Invalidate the chunk before reading so that it is read again if
+        // reading fails
+        data->chunk_first = -1;
+
+        // Read chunk from streamed table, recording any error since
+        // exceptions must not leave the critical zone
+        std::string error;
+        #pragma omp critical(GCTAEventList_stream)
+        {
+            try {
+
+                // Open event file if needed
+                if (m_stream_table == NULL && m_stream_fits == NULL) {
+                    m_stream_fits = new GFits(m_stream_file);
+                }
+
+                // Get streamed table
+                const GFitsTable& table = (m_stream_table != NULL)
+                                          ? *m_stream_table
+                                          : *m_stream_fits->table("EVENTS");
+
+                // Read chunk
+                data->chunk->read_events(table, first, nrows);
+                data->chunk->read_events_recon(table, first, nrows);
+
+            }
+            catch (std::exception& e) {
+                error = e.what();
+            }
+        }
+
+        // Throw an exception if the chunk could not be read
+        if (!error.empty()) {
+            std::string msg = "Reading of chunk of streamed events "
+                              "failed: "+error;
+            throw GException::runtime_error(G_FETCH_CHUNK, msg);
+        }
+
+        // Store first row of chunk
+        data->chunk_first = first;
+
+    } // endif: chunk was not in memory
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Initialize IRF cache for a given model
+ *
+ * @param[in] id Interned model name.
+ * @return Pointer to cache entry.
+ *
+ * Returns the cache entry of a model. If no cache entry exists, an entry is
+ * allocated and appended to the cache. The allocation is done in a critical
+ * zone so that an entry is allocated only once even if the method is
+ * called simultaneously from several threads. The entry is fully
+ * initialised before it is linked into the cache, so that threads that
+ * search the cache without locking only see complete entries.
+ ***************************************************************************/
+GCTAEventList::irf_cache_entry* GCTAEventList::irf_cache_init(const int& id) const
+{
+    // Search entry without locking
+    irf_cache_entry* entry = irf_cache_find(id);
+
+    // If no entry was found then allocate it in a critical zone
+    if (entry == NULL) {
+        #pragma omp critical(GCTAEventList_irf_cache)
+        {
+            // Check whether the entry was allocated in the meantime
+            entry = irf_cache_find(id);
+
+            // If not then allocate and initialise entry. The IRF values
+            // are initialised to -1, which signals that no cache values
+            // exist
+            if (entry == NULL) {
+                entry         = new irf_cache_entry;
+                entry->id     = id;
+                entry->values = std::vector<double>(size(), -1.0);
+                entry->next   = NULL;
+
+                // Make entry visible to all threads before linking it
+                #pragma omp flush
+                if (m_irf_last != NULL) {
+                    m_irf_last->next = entry;
+                }
+                else {
+                    m_irf_first = entry;
+                }
+                m_irf_last = entry;
+            }
+        }
+    }
+
+    // Return entry
+    return entry;
+}
+
+
+/***********************************************************************//**
+ * @brief Search IRF cache entry for a given model
+ *
+ * @param[in] id Interned model name.
+ * @return Pointer to cache entry (NULL if model has not been found).
+ *
+ * Searches the cache for the entry of a model. The search compares integer
+ * identifiers and does not require locking.
+ ***************************************************************************/
+GCTAEventList::irf_cache_entry* GCTAEventList::irf_cache_find(const int& id) const
+{
+    // Make sure that we see entries linked by other threads
+    #pragma omp flush
+
+    // Search entry
+    irf_cache_entry* entry = m_irf_first;
+    while (entry != NULL && entry->id != id) {
+        entry = entry->next;
+    }
+
+    // Return entry
+    return entry;
 }
 
 
@@ -1156,14 +1904,49 @@ int GCTAEventList::irf_cache_index(const std::string& name) const
  * @return IRF value (-1 if no cache value found).
  ***************************************************************************/
 double GCTAEventList::irf_cache(const std::string& name, const int& index) const
+{
+    // Return IRF value
+    return (irf_cache(gammalib::intern(name), index));
+}
+
+
+/***********************************************************************//**
+ * @brief Set cache IRF value
+ *
+ * @param[in] name Model name.
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] irf IRF value.
+ ***************************************************************************/
+void GCTAEventList::irf_cache(const std::string& name, const int& index,
+                              const double& irf) const
+{
+    // Set IRF value
+    irf_cache(gammalib::intern(name), index, irf);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Get cache IRF value
+ *
+ * @param[in] id Interned model name (see gammalib::intern()).
+ * @param[in] index Event index [0,...,size()-1].
+ * @return IRF value (-1 if no cache value found).
+ *
+ * Returns the cached IRF value of an event for a model. The method does
+ * not lock and may be called from several threads.
+ ***************************************************************************/
+double GCTAEventList::irf_cache(const int& id, const int& index) const
 {
     // Initialise IRF value to invalid value
     double irf = -1.0;
 
-    // Get cache index. Continue only if index is valid
-    int icache = irf_cache_index(name);
-    if (icache != -1) {
-        irf = (m_irf_values[icache])[index];
+    // Get cache entry. Continue only if entry and index are valid
+    const irf_cache_entry* entry = irf_cache_find(id);
+    if (entry != NULL && index >= 0 && index < int(entry->values.size())) {
+        irf = entry->values[index];
     }
 
     // Return IRF value
@@ -1174,19 +1957,72 @@ double GCTAEventList::irf_cache(const std::string& name, const int& index) const
 /***********************************************************************//**
  * @brief Set cache IRF value
  *
- * @param[in] name Model name.
+ * @param[in] id Interned model name (see gammalib::intern()).
  * @param[in] index Event index [0,...,size()-1].
  * @param[in] irf IRF value.
+ *
+ * Sets the cached IRF value of an event for a model. The cache entry of
+ * the model is allocated if it does not yet exist. Several threads may set
+ * values simultaneously as long as they set values of different events.
+ *
+ * Since a cache entry holds one value per event, IRF values are not cached
+ * for streamed event lists, as the memory used by the cache would grow
+ * with the number of events instead of being bounded by the chunk size.
  ***************************************************************************/
-void GCTAEventList::irf_cache(const std::string& name, const int& index,
+void GCTAEventList::irf_cache(const int& id, const int& index,
                               const double& irf) const
 {
-    // Initialize cache index. Continue only if index is valid
-    int icache = irf_cache_init(name);
-    if (icache != -1) {
-        (m_irf_values[icache])[index] = irf;
-    }
+    // Continue only if events are not streamed
+    if (!is_streamed()) {
+
+        // Get cache entry. Continue only if index is valid
+        irf_cache_entry* entry = irf_cache_init(id);
+        if (index >= 0 && index < int(entry->values.size())) {
+            entry->values[index] = irf;
+        }
+
+    } // endif: events were not streamed
 
     // Return
     return;
 }
+
+
+/*==========================================================================
+ =                                                                         =
+ =                              Local functions                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Determine identity of a file
+ *
+ * @param[in] filename File name.
+ * @param[out] size File size (bytes).
+ * @param[out] time Modification time of file (seconds since epoch).
+ * @return True if the file is a regular file that could be identified.
+ *
+ * Returns the size and the modification time of a file, which are used to
+ * check that an event file was not modified between loading the events
+ * and reading the deferred reconstruction information.
+ ***************************************************************************/
+static bool file_identity(const std::string& filename, long long* size,
+                          long long* time)
+{
+    // Initialise result
+    bool result = false;
+
+    // Get file information structure
+    struct stat info;
+    int ret = stat(gammalib::expand_env(filename).c_str(), &info);
+
+    // Set identity if the file is a regular file
+    if (ret == 0 && S_ISREG(info.st_mode)) {
+        *size  = (long long)(info.st_size);
+        *time  = (long long)(info.st_mtime);
+        result = true;
+    }
+
+    // Return result
+    return result;
+}
@@ -693,6 +693,12 @@ GEbounds GCTAObservation::ebounds(void) const
  *
  *     <observation name="..." id="..." instrument="..." emin="..." emax="...">
  *
+ * Event lists that are too large to be held in memory can be streamed in
+ * chunks of rows by adding the @a chunk attribute to the @a EventList
+ * parameter:
+ *
+ *     <parameter name="EventList" file="..." chunk="1000000"/>
+ *
  * The method does no load the events into memory but stores the file name
  * of the event file. The events are only loaded when required. This reduces
  * the memory needs for an CTA observation object and allows for loading
@@ -740,6 +746,11 @@ void GCTAObservation::read(const GXmlElement& xml)
             // Read eventlist file name
             std::string filename = par->attribute("file");
 
+            // Read (optional) number of rows per streamed chunk
+            if (par->attribute("chunk") != "") {
+                chunk_size(gammalib::toint(par->attribute("chunk")));
+            }
+
             // Open FITS file
             GFits fits(filename);
 
@@ -1013,6 +1024,9 @@ void GCTAObservation::write(GXmlElement& xml) const
     if (m_eventfile.length() > 0) {
         GXmlElement* par = gammalib::xml_need_par(G_WRITE, xml, m_eventtype);
         par->attribute("file", m_eventfile);
+        if (m_chunk_size > 0 && m_eventtype == "EventList") {
+            par->attribute("chunk", gammalib::str(m_chunk_size));
+        }
     }
 
     // ... otherwise write the observation definition information
@@ -1152,15 +1166,42 @@ void GCTAObservation::write(GFits& fits) const
  *
  * @param[in] filename FITS file name.
  *
- * Loads either an event list or a counts cube from a FITS file.
+ * Loads either an event list or a counts cube from a FITS file. If a
+ * chunk size was set (see chunk_size()), an event list is not loaded into
+ * memory but streamed from the FITS file (see GCTAEventList::stream()).
  ***************************************************************************/
 void GCTAObservation::load(const std::string& filename)
 {
     // Open FITS file
     GFits fits(filename);
 
-    // Read data
-    read(fits);
+    // If a chunk size was set and the file contains an event list then
+    // stream the events
+    if (m_chunk_size > 0 && fits.contains("EVENTS")) {
+
+        // Delete any existing event container
+        if (m_events != NULL) delete m_events;
+        m_events = NULL;
+
+        // Allocate event list and attach it to the observation
+        GCTAEventList* events = new GCTAEventList;
+        m_events = events;
+
+        // Stream event list
+        events->stream(filename, m_chunk_size);
+
+        // Read observation attributes from EVENTS extension
+        read_attributes(*fits.at("EVENTS"));
+
+        // Set the event type
+        set_event_type();
+
+    }
+
+    // ... otherwise read data
+    else {
+        read(fits);
+    }
 
     // Close FITS file
     fits.close();
@@ -1315,6 +1356,32 @@ const GEvents* GCTAObservation::events(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Signals if observation may be evaluated by concurrent threads
+ *
+ * @return True if observation is thread safe.
+ *
+ * Returns true for an unbinned observation with an instrument response
+ * function. The instrument response functions keep their parameter caches
+ * per thread and the event list hands out a separate event atom and, for
+ * streamed events, a separate chunk to each thread, hence the likelihood
+ * of such an observation can be evaluated by several threads. Binned and
+ * stacked observations are not thread safe.
+ ***************************************************************************/
+bool GCTAObservation::is_threadsafe(void) const
+{
+    // Get event list and instrument response function
+    const GCTAEventList*   list = dynamic_cast<const GCTAEventList*>(m_events);
+    const GCTAResponseIrf* rsp  = dynamic_cast<const GCTAResponseIrf*>(m_response);
+
+    // Signal thread safety for event lists and IRF responses
+    bool threadsafe = ((list != NULL) && (rsp != NULL));
+
+    // Return thread safety flag
+    return threadsafe;
+}
+
+
 /***********************************************************************//**
  * @brief Dispose events
  *
@@ -1443,6 +1510,7 @@ void GCTAObservation::init_members(void)
     m_dec_obj       = 0.0;
     m_lo_user_thres = 0.0;
     m_hi_user_thres = 0.0;
+    m_chunk_size    = 0;
 
     // Return
     return;
@@ -1470,6 +1538,7 @@ void GCTAObservation::copy_members(const GCTAObservation& obs)
     m_dec_obj       = obs.m_dec_obj;
     m_lo_user_thres = obs.m_lo_user_thres;
     m_hi_user_thres = obs.m_hi_user_thres;
+    m_chunk_size    = obs.m_chunk_size;
 
     // Clone members
     m_response = (obs.m_response != NULL) ? obs.m_response->clone() : NULL;
@@ -237,8 +237,8 @@ void GCTAPointing::dir(const GSkyDir& dir)
     // Set sky direction
     m_dir = dir;
 
-    // Invalidate cache
-    m_has_cache = false;
+    // Update rotation matrix
+    update();
 
     // Return
     return;
@@ -255,9 +255,6 @@ void GCTAPointing::dir(const GSkyDir& dir)
 GCTAInstDir GCTAPointing::instdir(const GSkyDir& skydir) const
 {
     #if defined(G_USE_VECTORS)
-	// Compute rotation matrix
-	update();
-
 	// Get celestial vector from sky coordinate
 	GVector celvector = skydir.celvector();
 
@@ -308,9 +305,6 @@ GCTAInstDir GCTAPointing::instdir(const GSkyDir& skydir) const
  ***************************************************************************/
 GSkyDir GCTAPointing::skydir(const GCTAInstDir& instdir)const
 {
-	// Compute rotation matrix
-	update();
-
 	// Retrieve instrument coordinates
 	double inst_x = instdir.detx();
 	double inst_y = instdir.dety();
@@ -344,9 +338,6 @@ GSkyDir GCTAPointing::skydir(const GCTAInstDir& instdir)const
  ***************************************************************************/
 const GMatrix& GCTAPointing::rot(void) const
 {
-    // Update cache
-    update();
-
     // Return rotation matrix
     return m_Rback;
 }
@@ -542,6 +533,9 @@ void GCTAPointing::read(const GXmlElement& xml)
         throw GException::invalid_value(G_READ_XML, msg);
     }
 
+    // Update rotation matrix
+    update();
+
     // Return
     return;
 }
@@ -623,9 +617,9 @@ void GCTAPointing::init_members(void)
     m_table_tmax.clear();
     m_reference.clear();
 
-    // Initialise cache
-    m_has_cache = false;
+    // Initialise rotation matrix
     m_Rback.clear();
+    update();
 
     // Return
     return;
@@ -651,9 +645,8 @@ void GCTAPointing::copy_members(const GCTAPointing& pnt)
     m_table_tmax  = pnt.m_table_tmax;
     m_reference   = pnt.m_reference;
 
-    // Copy cache
-    m_has_cache = pnt.m_has_cache;
-    m_Rback     = pnt.m_Rback;
+    // Copy rotation matrix
+    m_Rback       = pnt.m_Rback;
 
     // Return
     return;
@@ -671,26 +664,23 @@ void GCTAPointing::free_members(void)
 
 
 /***********************************************************************//**
- * @brief Update coordinate transformation cache
+ * @brief Update rotation matrix
+ *
+ * Computes the rotation matrix from the pointing direction. The matrix is
+ * updated by all methods that set the pointing direction so that the const
+ * methods never modify the pointing, and a pointing can be shared among
+ * several threads.
  ***************************************************************************/
-void GCTAPointing::update(void) const
+void GCTAPointing::update(void)
 {
-    // Update coordinate transformation cache only if required
-    if (!m_has_cache) {
-
-        // Set up Euler matrices
-        GMatrix Ry;
-        GMatrix Rz;
-        Ry.eulery(m_dir.dec_deg() - 90.0);
-        Rz.eulerz(-m_dir.ra_deg());
-
-        // Compute rotation matrix
-        m_Rback = (Ry * Rz).transpose();
-
-        // Signal that we have a valid transformation cache
-        m_has_cache = true;
-
-    } // endif: Update of cache was required
+    // Set up Euler matrices
+    GMatrix Ry;
+    GMatrix Rz;
+    Ry.eulery(m_dir.dec_deg() - 90.0);
+    Rz.eulerz(-m_dir.ra_deg());
+
+    // Compute rotation matrix
+    m_Rback = (Ry * Rz).transpose();
 
     // Return
     return;
@@ -36,6 +36,7 @@
 #include "GFitsBinTable.hpp"
 #include "GCTAPsfKing.hpp"
 #include "GCTAException.hpp"
+#include "GCTASupport.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_READ                                    "GCTAPsfKing::read(GFits&)"
@@ -200,17 +201,17 @@ double GCTAPsfKing::operator()(const double& delta,
     if (delta <= r_max) {
     #endif
 
-    // Update the parameter cache
-    update(logE, theta);
+    // Get PSF parameters
+    const parameters& par = update(logE, theta);
 
     // Continue only if normalization is positive
-    if (m_par_norm > 0.0) {
+    if (par.norm > 0.0) {
 
 		// Compute PSF value
-        double arg  = delta / m_par_sigma;
+        double arg  = delta / par.sigma;
         double arg2 = arg * arg;
-		psf = m_par_norm * 
-              std::pow((1.0 + 1.0 / (2.0 * m_par_gamma) * arg2), -m_par_gamma);
+		psf = par.norm * 
+              std::pow((1.0 + 1.0 / (2.0 * par.gamma) * arg2), -par.gamma);
 
         // If we are at large offset angles, add a smooth ramp down to
         // avoid steps in the log-likelihood computation
@@ -320,7 +321,10 @@ void GCTAPsfKing::read(const GFits& fits)
 
     // Convert sigma parameters to radians
     m_psf.scale(1, gammalib::deg2rad);
-   
+
+    // Set new cache identifier
+    m_id = gammalib::cta_cache_id();
+
     // Return
     return;
 }
@@ -423,11 +427,11 @@ double GCTAPsfKing::mc(GRan&         ran,
 	// Initialise random offset
 	double delta = 0.0;
 
-    // Update the parameter cache
-    update(logE, theta);
+    // Get PSF parameters
+    const parameters& par = update(logE, theta);
 
     // Compute exponent
-    double exponent = 1.0 / (1.0-m_par_gamma);
+    double exponent = 1.0 / (1.0-par.gamma);
 
     // Compile option: sample until delta <= r_max
     #if defined(G_FIX_DELTA_MAX)
@@ -438,8 +442,8 @@ double GCTAPsfKing::mc(GRan&         ran,
     double u = ran.uniform();
 
     // Draw random offset using inversion sampling
-    double u_max = (std::pow((1.0 - u), exponent) - 1.0) * m_par_gamma;
-    delta = m_par_sigma * std::sqrt(2.0 * u_max);
+    double u_max = (std::pow((1.0 - u), exponent) - 1.0) * par.gamma;
+    delta = par.sigma * std::sqrt(2.0 * u_max);
 
     // Compile option: sample until delta <= r_max
     #if defined(G_FIX_DELTA_MAX)
@@ -477,14 +481,14 @@ double GCTAPsfKing::delta_max(const double& logE,
     double radius = r_max;
     #else
 
-    // Update the parameter cache
-    update(logE, theta);
+    // Get PSF parameters
+    const parameters& par = update(logE, theta);
 
     // Compute maximum PSF radius (99.995% containment)
     double F      = 0.99995;
-    double u_max  = (std::pow((1.0 - F), (1.0/(1.0-m_par_gamma))) - 1.0) * 
-                    m_par_gamma;
-    double radius = m_par_sigma * std::sqrt(2.0 * u_max);
+    double u_max  = (std::pow((1.0 - F), (1.0/(1.0-par.gamma))) - 1.0) * 
+                    par.gamma;
+    double radius = par.sigma * std::sqrt(2.0 * u_max);
     #endif
 
     // Return maximum PSF radius
@@ -492,6 +496,24 @@ double GCTAPsfKing::delta_max(const double& logE,
 }
 
 
+/***********************************************************************//**
+ * @brief Assign response table
+ *
+ * @param[in] table Response table.
+ ***************************************************************************/
+void GCTAPsfKing::table(const GCTAResponseTable& table)
+{
+    // Set response table
+    m_psf = table;
+
+    // Set new cache identifier
+    m_id = gammalib::cta_cache_id();
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print point spread function information
  *
@@ -529,12 +551,7 @@ void GCTAPsfKing::init_members(void)
     // Initialise members
     m_filename.clear();
     m_psf.clear();
-    m_par_logE   = -1.0e30;
-    m_par_theta  = -1.0;
-    m_par_norm   = 0.0;
-    m_par_gamma  = 0.0;
-    m_par_sigma  = 0.0;
-    m_par_sigma2 = 0.0;
+    m_id = gammalib::cta_cache_id();
 
     // Return
     return;
@@ -549,14 +566,8 @@ void GCTAPsfKing::init_members(void)
 void GCTAPsfKing::copy_members(const GCTAPsfKing& psf)
 {
     // Copy members
-    m_filename   = psf.m_filename;
-    m_psf        = psf.m_psf;
-    m_par_logE   = psf.m_par_logE;
-    m_par_theta  = psf.m_par_theta;
-    m_par_norm   = psf.m_par_norm;
-    m_par_gamma  = psf.m_par_gamma;
-    m_par_sigma  = psf.m_par_sigma;
-    m_par_sigma2 = psf.m_par_sigma2;
+    m_filename = psf.m_filename;
+    m_psf      = psf.m_psf;
 
     // Return
     return;
@@ -578,23 +589,27 @@ void GCTAPsfKing::free_members(void)
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
  * @param[in] theta Offset angle.
+ * @return PSF parameters.
  *
  * @exception GException::invalid_value
  *            No valid point spread function information has been found.
  *
  * This method updates the PSF parameter cache. As the performance table PSF
  * only depends on energy, the only parameter on which the cache values
- * depend is the energy.
+ * depend is the energy. Each thread has its own cache, hence the PSF can be
+ * evaluated concurrently by several threads.
  ***************************************************************************/
-void GCTAPsfKing::update(const double& logE, const double& theta) const
+const GCTAPsfKing::parameters& GCTAPsfKing::update(const double& logE,
+                                                   const double& theta) const
 {
-    // Only compute PSF parameters if arguments have changed
-    if (logE != m_par_logE || theta != m_par_theta) {
+    // Parameter cache of thread (all fields are initialised so that the
+    // cache stays an aggregate, as required for a threadprivate variable)
+    static parameters cache = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    #pragma omp threadprivate(cache)
+
+    // Only compute PSF parameters if PSF or arguments have changed
+    if (cache.id != m_id || logE != cache.logE || theta != cache.theta) {
 
-        // Save parameters
-        m_par_logE  = logE;
-        m_par_theta = theta;
-    
         // Determine sigma and gamma by interpolating between nodes
         std::vector<double> pars = m_psf(logE,theta);
 
@@ -610,16 +625,21 @@ void GCTAPsfKing::update(const double& logE, const double& theta) const
             throw GException::invalid_value(G_UPDATE, msg);
         }
 
+        // Save arguments
+        cache.id    = m_id;
+        cache.logE  = logE;
+        cache.theta = theta;
+
         // Set parameters
-        m_par_gamma  = pars[0];
-        m_par_sigma  = pars[1];
-        m_par_sigma2 = m_par_sigma * m_par_sigma;
+        cache.gamma  = pars[0];
+        cache.sigma  = pars[1];
+        cache.sigma2 = cache.sigma * cache.sigma;
 
         // Check for parameter sanity
-        if (m_par_gamma <= 0.0 || m_par_sigma <= 0.0) {
-            m_par_norm = 0.0;
-            std::string msg = "King function parameters m_par_gamma and"
-                              " m_par_sigma are zero (for "
+        if (cache.gamma <= 0.0 || cache.sigma <= 0.0) {
+            cache.norm = 0.0;
+            std::string msg = "King function parameters gamma and"
+                              " sigma are zero (for "
                               " parameter space logE=" +
                               gammalib::str(logE) + " and theta=" + 
                               gammalib::str(theta) + 
@@ -628,19 +648,19 @@ void GCTAPsfKing::update(const double& logE, const double& theta) const
         }
         else {   
             // Determine normalisation for given parameters
-            m_par_norm = 1.0 / gammalib::twopi * (1.0 - 1.0 / m_par_gamma) /
-                         m_par_sigma2;
+            cache.norm = 1.0 / gammalib::twopi * (1.0 - 1.0 / cache.gamma) /
+                         cache.sigma2;
         }
 
         // Optionally correct for fixed delta_max
         #if defined(G_FIX_DELTA_MAX)
-        double u_max = (r_max*r_max) / (2.0 * m_par_sigma2);
-        double norm  = 1.0 - std::pow((1.0 + u_max/m_par_gamma), 1.0-m_par_gamma);
-        m_par_norm /= norm;
+        double u_max = (r_max*r_max) / (2.0 * cache.sigma2);
+        double norm  = 1.0 - std::pow((1.0 + u_max/cache.gamma), 1.0-cache.gamma);
+        cache.norm /= norm;
         #endif
 
     }
 
-    // Return
-    return;
+    // Return parameters
+    return cache;
 }
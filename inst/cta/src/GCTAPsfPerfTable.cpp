@@ -185,14 +185,14 @@ double GCTAPsfPerfTable::operator()(const double& delta,
     static const double offset = std::exp(-0.5*5.0*5.0);
     #endif
     
-    // Update the parameter cache
-    update(logE);
+    // Get PSF parameters
+    parameters par = compute(logE);
 
     // Compute PSF value
     #if defined(G_SMOOTH_PSF)
-    double psf = m_par_scale * (std::exp(m_par_width * delta * delta) - offset);
+    double psf = par.scale * (std::exp(par.width * delta * delta) - offset);
     #else
-    double psf = m_par_scale * (std::exp(m_par_width * delta * delta));
+    double psf = par.scale * (std::exp(par.width * delta * delta));
     #endif
 
     #if defined(G_SMOOTH_PSF)
@@ -338,11 +338,11 @@ double GCTAPsfPerfTable::mc(GRan&         ran,
                             const double& azimuth,
                             const bool&   etrue) const
 {
-    // Update the parameter cache
-    update(logE);
+    // Get PSF parameters
+    parameters par = compute(logE);
 
     // Draw offset
-    double delta = m_par_sigma * ran.chisq2();
+    double delta = par.sigma * ran.chisq2();
     
     // Return PSF offset
     return delta;
@@ -370,11 +370,11 @@ double GCTAPsfPerfTable::delta_max(const double& logE,
                                    const double& azimuth,
                                    const bool&   etrue) const
 {
-    // Update the parameter cache
-    update(logE);
+    // Get PSF parameters
+    parameters par = compute(logE);
 
     // Compute maximum PSF radius
-    double radius = 5.0 * m_par_sigma;
+    double radius = 5.0 * par.sigma;
     
     // Return maximum PSF radius
     return radius;
@@ -434,10 +434,6 @@ void GCTAPsfPerfTable::init_members(void)
     m_r68.clear();
     m_r80.clear();
     m_sigma.clear();
-    m_par_logE  = -1.0e30;
-    m_par_scale = 1.0;
-    m_par_sigma = 0.0;
-    m_par_width = 0.0;
 
     // Return
     return;
@@ -457,10 +453,6 @@ void GCTAPsfPerfTable::copy_members(const GCTAPsfPerfTable& psf)
     m_r68       = psf.m_r68;
     m_r80       = psf.m_r80;
     m_sigma     = psf.m_sigma;
-    m_par_logE  = psf.m_par_logE;
-    m_par_scale = psf.m_par_scale;
-    m_par_sigma = psf.m_par_sigma;
-    m_par_width = psf.m_par_width;
 
     // Return
     return;
@@ -478,32 +470,28 @@ void GCTAPsfPerfTable::free_members(void)
 
 
 /***********************************************************************//**
- * @brief Update PSF parameter cache
+ * @brief Compute PSF parameters
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
+ * @return PSF parameters.
  *
- * This method updates the PSF parameter cache. As the performance table PSF
- * only depends on energy, the only parameter on which the cache values
- * depend is the energy.
+ * This method computes the Gaussian PSF parameters for a given energy. The
+ * PSF parameters are not cached, hence the PSF can be evaluated
+ * concurrently by several threads.
  ***************************************************************************/
-void GCTAPsfPerfTable::update(const double& logE) const
+GCTAPsfPerfTable::parameters GCTAPsfPerfTable::compute(const double& logE) const
 {
-    // Only compute PSF parameters if arguments have changed
-    if (logE != m_par_logE) {
+    // Allocate parameters
+    parameters par;
 
-        // Save energy
-        m_par_logE = logE;
-    
-        // Determine Gaussian sigma in radians
-        m_par_sigma = m_logE.interpolate(logE, m_sigma);
-
-        // Derive width=-0.5/(sigma*sigma) and scale=1/(twopi*sigma*sigma)
-        double sigma2 = m_par_sigma * m_par_sigma;
-        m_par_scale   =  1.0 / (gammalib::twopi * sigma2);
-        m_par_width   = -0.5 / sigma2;
+    // Determine Gaussian sigma in radians
+    par.sigma = m_logE.interpolate(logE, m_sigma);
 
-    }
+    // Derive width=-0.5/(sigma*sigma) and scale=1/(twopi*sigma*sigma)
+    double sigma2 = par.sigma * par.sigma;
+    par.scale     =  1.0 / (gammalib::twopi * sigma2);
+    par.width     = -0.5 / sigma2;
 
-    // Return
-    return;
+    // Return parameters
+    return par;
 }
@@ -651,31 +651,56 @@ double GCTAResponseCube::irf_diffuse(const GEvent&       event,
     const GCTAEventBin* bin = static_cast<const GCTAEventBin*>(&event);
 
     // Get pointer to source cache. We first search the cache for a model
-    // with the source name. If no model was found we initialise a new
-    // cache entry for that model. Otherwise, we simply return the actual
-    // cache entry.
-    GCTACubeSourceDiffuse* cache(NULL);
-    int index = cache_index(source.name());
-    if (index == -1) {
-    
-        // No cache entry was found, thus allocate and initialise a new one
-        cache = new GCTACubeSourceDiffuse;
-        cache->set(source.name(), *source.model(), obs);
-        m_cache.push_back(cache);
+    // with the source name identifier, which does not require locking. If
+    // no model was found we initialise a new cache entry for that model in
+    // a critical zone, so that the entry is computed only once even if
+    // several threads request it simultaneously.
+    GCTACubeSource* entry = cache_find(source.name_id());
+    if (entry == NULL) {
+
+        // Initialise error message
+        std::string error;
+
+        // Allocate and initialise cache entry
+        #pragma omp critical(GCTAResponseCube_irf_diffuse)
+        {
+            // Check whether the entry was allocated in the meantime
+            entry = cache_find(source.name_id());
+
+            // If not then allocate and initialise a new entry. Exceptions
+            // are caught as they must not leave the critical zone.
+            if (entry == NULL) {
+                GCTACubeSourceDiffuse* diffuse = new GCTACubeSourceDiffuse;
+                try {
+                    diffuse->set(source.name(), *source.model(), obs);
+                    cache_append(source.name_id(), diffuse);
+                    entry = diffuse;
+                }
+                catch (std::exception& e) {
+                    delete diffuse;
+                    error = e.what();
+                }
+            }
+        }
 
-    } // endif: no cache entry was found
-    else {
-    
-        // Check that the cache entry is of the expected type
-        if (m_cache[index]->code() != GCTA_CUBE_SOURCE_DIFFUSE) {
-            std::string msg = "Cached model \""+source.name()+"\" is not "
-                              "an extended source model. This method only "
-                              "applies to extended source models.";
+        // Throw an exception if the cache entry could not be initialised
+        if (entry == NULL) {
+            std::string msg = "Unable to initialise response cache for model "
+                              "\""+source.name()+"\": "+error;
             throw GException::invalid_value(G_IRF_DIFFUSE, msg);
         }
-        cache = static_cast<GCTACubeSourceDiffuse*>(m_cache[index]);
 
-    } // endelse: there was a cache entry for this model
+    } // endif: no cache entry was found
+
+    // Check that the cache entry is of the expected type
+    if (entry->code() != GCTA_CUBE_SOURCE_DIFFUSE) {
+        std::string msg = "Cached model \""+source.name()+"\" is not "
+                          "an extended source model. This method only "
+                          "applies to extended source models.";
+        throw GException::invalid_value(G_IRF_DIFFUSE, msg);
+    }
+    const GCTACubeSourceDiffuse* cache =
+          static_cast<const GCTACubeSourceDiffuse*>(entry);
 
     // Determine IRF value
     irf = cache->irf(bin->ipix(), bin->ieng());
@@ -720,6 +745,33 @@ double GCTAResponseCube::npred(const GPhoton&      photon,
 }
 
 
+/***********************************************************************//**
+ * @brief Set Psf handling of diffuse models
+ *
+ * @param[in] psf_convolve Convolve diffuse models with the Psf?
+ *
+ * Selects whether diffuse models are convolved with the Psf cube on the
+ * model map grid (true) or whether the Psf is numerically integrated for
+ * each event cube pixel (false, the default). Convolution is considerably
+ * faster for large maps. For each energy the convolution kernel is the
+ * exposure weighted mean Psf over the event cube.
+ *
+ * Changing the option clears the source response cache so that diffuse
+ * models are recomputed with the selected method.
+ ***************************************************************************/
+void GCTAResponseCube::psf_convolve(const bool& psf_convolve)
+{
+    // Clear cache if option changes
+    if (psf_convolve != m_psf_convolve) {
+        cache_clear();
+        m_psf_convolve = psf_convolve;
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Read response information from XML element
  *
@@ -838,6 +890,15 @@ std::string GCTAResponseCube::print(const GChatter& chatter) const
             }
         }
 
+        // Append Psf handling of diffuse models
+        result.append("\n"+gammalib::parformat("Diffuse model Psf"));
+        if (psf_convolve()) {
+            result.append("Convolution");
+        }
+        else {
+            result.append("Integration");
+        }
+
         // Append exposure cube information
         result.append("\n"+m_exposure.print(chatter));
 
@@ -869,10 +930,12 @@ void GCTAResponseCube::init_members(void)
     m_exposure.clear();
     m_psf.clear();
     m_background.clear();
-    m_apply_edisp = false;
+    m_apply_edisp  = false;
+    m_psf_convolve = false;
 
     // Initialise cache
-    m_cache.clear();
+    m_cache_first = NULL;
+    m_cache_last  = NULL;
 
     // Return
     return;
@@ -890,11 +953,13 @@ void GCTAResponseCube::copy_members(const GCTAResponseCube& rsp)
     m_exposure    = rsp.m_exposure;
     m_psf         = rsp.m_psf;
     m_background  = rsp.m_background;
-    m_apply_edisp = rsp.m_apply_edisp;
+    m_apply_edisp  = rsp.m_apply_edisp;
+    m_psf_convolve = rsp.m_psf_convolve;
 
     // Copy cache
-    for (int i = 0; i < rsp.m_cache.size(); ++i) {
-        m_cache.push_back((rsp.m_cache[i]->clone()));
+    for (cache_entry* entry = rsp.m_cache_first; entry != NULL;
+         entry = entry->next) {
+        cache_append(entry->id, entry->source->clone());
     }
 
     // Return
@@ -908,10 +973,28 @@ void GCTAResponseCube::copy_members(const GCTAResponseCube& rsp)
 void GCTAResponseCube::free_members(void)
 {
     // Free cache
-    for (int i = 0; i < m_cache.size(); ++i) {
-        if (m_cache[i] != NULL) delete m_cache[i];
-        m_cache[i] = NULL;
+    cache_clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clear response cache
+ *
+ * Deletes all source responses of the response cache.
+ ***************************************************************************/
+void GCTAResponseCube::cache_clear(void)
+{
+    // Free cache entries
+    while (m_cache_first != NULL) {
+        cache_entry* next = m_cache_first->next;
+        if (m_cache_first->source != NULL) delete m_cache_first->source;
+        delete m_cache_first;
+        m_cache_first = next;
     }
+    m_cache_last = NULL;
 
     // Return
     return;
@@ -919,33 +1002,62 @@ void GCTAResponseCube::free_members(void)
 
 
 /***********************************************************************//**
- * @brief Determine cache index for model
+ * @brief Search response cache for model
  *
- * @param[in] name Model name.
- * @return Cache index (-1 if model has not been found).
+ * @param[in] id Interned model name.
+ * @return Pointer to source response (NULL if model has not been found).
  *
- * Determines the cache index for a given model @p name.
+ * Searches the response cache for a model. The search compares integer
+ * identifiers and does not require locking.
  ***************************************************************************/
-int GCTAResponseCube::cache_index(const std::string& name) const
+GCTACubeSource* GCTAResponseCube::cache_find(const int& id) const
 {
-    // Initialise index
-    int index = -1;
+    // Make sure that we see entries linked by other threads
+    #pragma omp flush
 
-    // Continue only if there are models in cache
-    if (!m_cache.empty()) {
+    // Search entry
+    cache_entry* entry = m_cache_first;
+    while (entry != NULL && entry->id != id) {
+        entry = entry->next;
+    }
+
+    // Return source response
+    return ((entry != NULL) ? entry->source : NULL);
+}
 
-         // Search for model name
-         for (int i = 0; i < m_cache.size(); ++i) {
-             if (m_cache[i]->name() == name) {
-                 index = i;
-                 break;
-             }
-         }
 
-    } // endif: there were models in cache
+/***********************************************************************//**
+ * @brief Append source response to cache
+ *
+ * @param[in] id Interned model name.
+ * @param[in] source Pointer to source response.
+ *
+ * Appends a source response to the cache. The cache takes over ownership
+ * of the source response. The entry is fully initialised before it is
+ * linked into the cache, so that threads that search the cache without
+ * locking only see complete entries. Appending has to be done in a
+ * critical zone if several threads may append simultaneously.
+ ***************************************************************************/
+void GCTAResponseCube::cache_append(const int& id, GCTACubeSource* source) const
+{
+    // Allocate and initialise entry
+    cache_entry* entry = new cache_entry;
+    entry->id          = id;
+    entry->source      = source;
+    entry->next        = NULL;
+
+    // Make entry visible to all threads before linking it
+    #pragma omp flush
+    if (m_cache_last != NULL) {
+        m_cache_last->next = entry;
+    }
+    else {
+        m_cache_first = entry;
+    }
+    m_cache_last = entry;
 
-    // Return index
-    return index;
+    // Return
+    return;
 }
 
 
@@ -36,9 +36,13 @@
 #include "GMath.hpp"
 #include "GIntegral.hpp"
 #include "GCaldb.hpp"
+#include "GModelSpatialPointSource.hpp"
 #include "GModelSpatialRadial.hpp"
+#include "GModelSpatialRadialGauss.hpp"
+#include "GModelSpatialRadialDisk.hpp"
 #include "GModelSpatialRadialShell.hpp"
 #include "GModelSpatialElliptical.hpp"
+#include "GModelSpatialEllipticalGauss.hpp"
 #include "GCTAObservation.hpp"
 #include "GCTAResponseIrf.hpp"
 #include "GCTAResponse_helpers.hpp"
@@ -79,6 +83,12 @@
                                                             " GObservation&)"
 #define G_IRF_DIFFUSE       "GCTAResponseIrf::irf_diffuse(GEvent&, GSource&,"\
                                                             " GObservation&)"
+#define G_IRF_PTSRC_GRAD     "GCTAResponseIrf::irf_ptsrc_gradients(GEvent&,"\
+                                                  " GSource&, GObservation&)"
+#define G_IRF_RADIAL_GRAD   "GCTAResponseIrf::irf_radial_gradients(GEvent&,"\
+                                                  " GSource&, GObservation&)"
+#define G_IRF_ELLIPTICAL_GRAD              "GCTAResponseIrf::irf_elliptical_"\
+                                "gradients(GEvent&, GSource&, GObservation&)"
 #define G_NPRED_RADIAL              "GCTAResponseIrf::npred_radial(GSource&,"\
                                                             " GObservation&)"
 #define G_NPRED_ELLIPTICAL      "GCTAResponseIrf::npred_elliptical(GSource&,"\
@@ -108,6 +118,9 @@
 //#define G_DEBUG_NPRED_RADIAL                 //!< Debug npred_radial method
 //#define G_DEBUG_NPRED_DIFFUSE               //!< Debug npred_diffuse method
 //#define G_DEBUG_NPRED_ELLIPTICAL         //!< Debug npred_elliptical method
+
+/* __ Constants __________________________________________________________ */
+const double g_irf_grad_step = 0.0002 * gammalib::deg2rad; //!< Radians
 //#define G_DEBUG_PRINT_AEFF                   //!< Debug print() Aeff method
 //#define G_DEBUG_PRINT_PSF                     //!< Debug print() Psf method
 //#define G_DEBUG_PSF_DUMMY_SIGMA           //!< Debug psf_dummy_sigma method
@@ -1386,6 +1399,75 @@ std::string GCTAResponseIrf::print(const GChatter& chatter) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Return instrument response function and spatial model gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Value of instrument response function.
+ *
+ * Returns the instrument response function for a given event, source and
+ * observation, and computes in the same pass the gradients with respect
+ * to the spatial model parameters (see GResponse::irf_gradients()).
+ *
+ * Gradients are computed analytically for the parameters that are flagged
+ * by the model as having a gradient (see GModelPar::has_grad()), which are
+ * the position of point sources, the width of radial Gaussian models, the
+ * radius of radial disk models and the shape parameters of elliptical
+ * Gaussian models. For all other models no gradients are computed (see
+ * has_irf_gradients()).
+ ***************************************************************************/
+double GCTAResponseIrf::irf_gradients(const GEvent&       event,
+                                      const GSource&      source,
+                                      const GObservation& obs) const
+{
+    // Initialise IRF value
+    double irf = 0.0;
+
+    // Get spatial model
+    const GModelSpatial* model = source.model();
+
+    // Select method depending on the spatial model type
+    if (dynamic_cast<const GModelSpatialPointSource*>(model) != NULL) {
+        irf = irf_ptsrc_gradients(event, source, obs);
+    }
+    else if (dynamic_cast<const GModelSpatialRadialGauss*>(model) != NULL ||
+             dynamic_cast<const GModelSpatialRadialDisk*>(model)  != NULL) {
+        irf = irf_radial_gradients(event, source, obs);
+    }
+    else if (dynamic_cast<const GModelSpatialEllipticalGauss*>(model) != NULL) {
+        irf = irf_elliptical_gradients(event, source, obs);
+    }
+    else {
+        irf = GResponse::irf(event, source, obs);
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Signals whether the response computes spatial model gradients
+ *
+ * @param[in] model Spatial model.
+ * @return True if irf_gradients() computes the gradients of @p model.
+ *
+ * Returns true for point sources, radial Gaussian and disk models and
+ * elliptical Gaussian models, for which irf_gradients() computes the
+ * gradients analytically.
+ ***************************************************************************/
+bool GCTAResponseIrf::has_irf_gradients(const GModelSpatial& model) const
+{
+    // Return
+    return (dynamic_cast<const GModelSpatialPointSource*>(&model)     != NULL ||
+            dynamic_cast<const GModelSpatialRadialGauss*>(&model)     != NULL ||
+            dynamic_cast<const GModelSpatialRadialDisk*>(&model)      != NULL ||
+            dynamic_cast<const GModelSpatialEllipticalGauss*>(&model) != NULL);
+}
+
+
 /***********************************************************************//**
  * @brief Return IRF value for radial source model
  *
@@ -1854,7 +1936,7 @@ double GCTAResponseIrf::irf_diffuse(const GEvent&       event,
     const GCTAEventList* list = dynamic_cast<const GCTAEventList*>(obs.events());
     const GCTAEventAtom* atom = dynamic_cast<const GCTAEventAtom*>(&event);
     if (list != NULL && atom != NULL) {
-        irf = list->irf_cache(source.name(), atom->index());
+        irf = list->irf_cache(source.name_id(), atom->index());
         if (irf >= 0.0) {
             has_irf = true;
             #if defined(G_DEBUG_IRF_DIFFUSE)
@@ -1963,7 +2045,7 @@ double GCTAResponseIrf::irf_diffuse(const GEvent&       event,
         // Put IRF value in cache
         #if defined(G_USE_IRF_CACHE)
         if (list != NULL && atom != NULL) {
-            list->irf_cache(source.name(), atom->index(), irf);
+            list->irf_cache(source.name_id(), atom->index(), irf);
         }
         #endif
 
@@ -3137,3 +3219,517 @@ std::string GCTAResponseIrf::irf_filename(const std::string& filename) const
     // Return result
     return result;
 }
+
+
+/***********************************************************************//**
+ * @brief Return point source IRF value and position gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Value of instrument response function.
+ *
+ * @exception GCTAException::bad_model_type
+ *            Model is not a point source model.
+ *
+ * Computes the point source IRF
+ *
+ * \f[
+ *    IRF = A_{\rm eff}(\theta) \, PSF(\delta, \theta) \, E_{\rm disp}(\theta)
+ * \f]
+ *
+ * where \f$\theta\f$ is the angle between pointing and source and
+ * \f$\delta\f$ the angle between measured photon arrival direction and
+ * source, and the gradients of the IRF with respect to Right Ascension and
+ * Declination of the source using the chain rule
+ *
+ * \f[
+ *    \frac{\partial IRF}{\partial \epsilon} =
+ *    \frac{\partial IRF}{\partial \delta} \frac{\partial \delta}{\partial \epsilon} +
+ *    \frac{\partial IRF}{\partial \theta} \frac{\partial \theta}{\partial \epsilon}
+ * \f]
+ *
+ * where the angular derivatives follow from the position angles of the
+ * measured photon and pointing directions seen from the source. The
+ * one-dimensional derivatives with respect to \f$\delta\f$ and
+ * \f$\theta\f$ are computed by finite differences as the response
+ * components may be tabulated.
+ *
+ * The gradients are stored in the first and second parameter of the
+ * model, which are Right Ascension and Declination.
+ ***************************************************************************/
+double GCTAResponseIrf::irf_ptsrc_gradients(const GEvent&       event,
+                                            const GSource&      source,
+                                            const GObservation& obs) const
+{
+    // Retrieve CTA pointing and instrument direction
+    const GCTAPointing& pnt = retrieve_pnt(G_IRF_PTSRC_GRAD, obs);
+    const GCTAInstDir&  dir = retrieve_dir(G_IRF_PTSRC_GRAD, event);
+
+    // Get pointer on point source model
+    GModelSpatialPointSource* model =
+          dynamic_cast<GModelSpatialPointSource*>(const_cast<GModelSpatial*>(source.model()));
+    if (model == NULL) {
+        throw GCTAException::bad_model_type(G_IRF_PTSRC_GRAD);
+    }
+
+    // Get event attributes
+    const GSkyDir& obsDir = dir.dir();
+    const GEnergy& obsEng = event.energy();
+
+    // Get source attributes. The position angles are computed in
+    // celestial coordinates, hence the source direction is set from
+    // Right Ascension and Declination.
+    GSkyDir centre;
+    centre.radec_deg(model->ra(), model->dec());
+    const GEnergy& srcEng  = source.energy();
+    const GTime&   srcTime = source.time();
+
+    // Compute IRF value
+    GPhoton photon(model->dir(), srcEng, srcTime);
+    double  irf = this->irf(event, photon, obs);
+
+    // Get pointing direction zenith angle and azimuth [radians]
+    double zenith  = pnt.zenith();
+    double azimuth = pnt.azimuth();
+
+    // Get offset angle of source and angular separation between source and
+    // measured photon direction [radians]
+    double theta = pnt.dir().dist(centre);
+    double delta = obsDir.dist(centre);
+    double phi   = 0.0; //TODO: Implement Phi dependence
+
+    // Get log10(E/TeV) of true photon energy
+    double srcLogEng = srcEng.log10TeV();
+
+    // Get maximum angular separation for which PSF is significant
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+
+    // Initialise gradients with respect to source displacements towards
+    // North and East [per radian]
+    double g_north = 0.0;
+    double g_east  = 0.0;
+
+    // Compute gradients only if we're sufficiently close to PSF
+    if (delta <= delta_max) {
+
+        // Set step sizes. As the response is symmetric in delta and theta,
+        // negative angles are mirrored to obtain central differences.
+        const double h         = g_irf_grad_step;
+        double       delta_low = std::abs(delta - h);
+        double       theta_low = std::abs(theta - h);
+
+        // Compute effective area and energy dispersion for offset angles
+        double aeff_0   = aeff(theta,     phi, zenith, azimuth, srcLogEng);
+        double aeff_p   = aeff(theta + h, phi, zenith, azimuth, srcLogEng);
+        double aeff_m   = aeff(theta_low, phi, zenith, azimuth, srcLogEng);
+        double edisp_0  = 1.0;
+        double edisp_p  = 1.0;
+        double edisp_m  = 1.0;
+        if (use_edisp()) {
+            edisp_0 = edisp(obsEng, theta,     phi, zenith, azimuth, srcLogEng);
+            edisp_p = edisp(obsEng, theta + h, phi, zenith, azimuth, srcLogEng);
+            edisp_m = edisp(obsEng, theta_low, phi, zenith, azimuth, srcLogEng);
+        }
+
+        // Compute partial derivatives of IRF with respect to delta and theta
+        double psf_p    = psf(delta + h,  theta,     phi, zenith, azimuth, srcLogEng);
+        double psf_m    = psf(delta_low,  theta,     phi, zenith, azimuth, srcLogEng);
+        double psf_tp   = psf(delta,      theta + h, phi, zenith, azimuth, srcLogEng);
+        double psf_tm   = psf(delta,      theta_low, phi, zenith, azimuth, srcLogEng);
+        double deadc    = obs.deadc(srcTime);
+        double g_delta  = aeff_0 * (psf_p - psf_m) * edisp_0 * deadc / (2.0 * h);
+        double g_theta  = (aeff_p * psf_tp * edisp_p - aeff_m * psf_tm * edisp_m) *
+                          deadc / (2.0 * h);
+
+        // Compute position angles of measured photon direction and pointing
+        // seen from the source [radians]
+        double pa_obs = centre.posang(obsDir);
+        double pa_pnt = centre.posang(pnt.dir());
+
+        // Compute gradients with respect to source displacements. Moving
+        // the source towards a direction reduces the distance to it
+        // proportional to the cosine of the position angle difference.
+        g_north = -g_delta * std::cos(pa_obs) - g_theta * std::cos(pa_pnt);
+        g_east  = -g_delta * std::sin(pa_obs) - g_theta * std::sin(pa_pnt);
+
+    } // endif: we were sufficiently close to PSF
+
+    // Set position gradients
+    GModelPar& ra    = (*model)[0];
+    GModelPar& dec   = (*model)[1];
+    double     g_ra  = 0.0;
+    double     g_dec = 0.0;
+    if (ra.is_free()) {
+        g_ra = g_east * std::cos(centre.dec()) * gammalib::deg2rad * ra.scale();
+    }
+    if (dec.is_free()) {
+        g_dec = g_north * gammalib::deg2rad * dec.scale();
+    }
+    ra.factor_gradient(g_ra);
+    dec.factor_gradient(g_dec);
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Return radial model IRF value and shape parameter gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Value of instrument response function.
+ *
+ * @exception GCTAException::bad_model_type
+ *            Model is not a radial Gaussian or disk model.
+ *
+ * Computes the radial model IRF in the same way as irf_radial() and
+ * derives the gradients with respect to the model parameters that have
+ * a gradient from the IRF values that were computed for the IRF
+ * integration. The gradients are obtained by integrating the model
+ * gradients times the azimuthally integrated IRF over \f$\rho\f$. For a
+ * disk model, the contribution of the disk edge is added to the radius
+ * gradient.
+ ***************************************************************************/
+double GCTAResponseIrf::irf_radial_gradients(const GEvent&       event,
+                                             const GSource&      source,
+                                             const GObservation& obs) const
+{
+    // Set number of iterations for Romberg integration (see irf_radial())
+    static const int iter_rho = 5;
+    static const int iter_phi = 5;
+
+    // Retrieve CTA pointing
+    const GCTAPointing& pnt = retrieve_pnt(G_IRF_RADIAL_GRAD, obs);
+    const GCTAInstDir&  dir = retrieve_dir(G_IRF_RADIAL_GRAD, event);
+
+    // Get pointer on radial model
+    GModelSpatialRadial* model =
+          dynamic_cast<GModelSpatialRadial*>(const_cast<GModelSpatial*>(source.model()));
+    const GModelSpatialRadialDisk* disk =
+          dynamic_cast<const GModelSpatialRadialDisk*>(model);
+    if (dynamic_cast<const GModelSpatialRadialGauss*>(model) == NULL &&
+        disk == NULL) {
+        throw GCTAException::bad_model_type(G_IRF_RADIAL_GRAD);
+    }
+
+    // Get event attributes
+    const GSkyDir& obsDir = dir.dir();
+    const GEnergy& obsEng = event.energy();
+
+    // Get source attributes
+    const GSkyDir& centre  = model->dir();
+    const GEnergy& srcEng  = source.energy();
+    const GTime&   srcTime = source.time();
+
+    // Get pointing direction zenith angle and azimuth [radians]
+    double zenith  = pnt.zenith();
+    double azimuth = pnt.azimuth();
+
+    // Determine angular distances between measured photon direction, model
+    // centre and pointing direction [radians]
+    double zeta   = centre.dist(obsDir);
+    double eta    = pnt.dir().dist(obsDir);
+    double lambda = centre.dist(pnt.dir());
+
+    // Compute azimuth angle of pointing in model system [radians]
+    double omega0 = 0.0;
+    double denom  = std::sin(lambda) * std::sin(zeta);
+    if (denom != 0.0) {
+        double arg = (std::cos(eta) - std::cos(lambda) * std::cos(zeta))/denom;
+        omega0     = gammalib::acos(arg);
+    }
+
+    // Get log10(E/TeV) of true photon energy
+    double srcLogEng = srcEng.log10TeV();
+
+    // Assign the observed theta angle (see irf_radial())
+    double theta = eta;
+    double phi   = 0.0; //TODO: Implement IRF Phi dependence
+
+    // Get maximum PSF and source radius in radians.
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+    double src_max   = model->theta_max();
+
+    // Set radial model zenith angle range
+    double rho_min = (zeta > delta_max) ? zeta - delta_max : 0.0;
+    double rho_max = zeta + delta_max;
+    if (rho_max > src_max) {
+        rho_max = src_max;
+    }
+
+    // Collect indices of parameters with gradient
+    std::vector<int> pars;
+    for (int k = 0; k < model->size(); ++k) {
+        if ((*model)[k].has_grad()) {
+            pars.push_back(k);
+        }
+    }
+    int npars = pars.size();
+
+    // Initialise IRF value and gradients
+    double              irf = 0.0;
+    std::vector<double> grads(npars, 0.0);
+
+    // Perform zenith angle integration if interval is valid
+    if (rho_max > rho_min) {
+
+        // Setup integration kernel that records the integration nodes
+        std::vector<double>     nodes;
+        cta_irf_radial_kern_rho integrand(*this,
+                                          *model,
+                                          zenith,
+                                          azimuth,
+                                          srcEng,
+                                          srcTime,
+                                          srcLogEng,
+                                          obsEng,
+                                          zeta,
+                                          lambda,
+                                          omega0,
+                                          delta_max,
+                                          iter_phi,
+                                          &pars,
+                                          &nodes);
+
+        // Integrate over model's zenith angle
+        GIntegral integral(&integrand);
+        integral.fixed_iter(iter_rho);
+
+        // Setup integration boundaries
+        std::vector<double> bounds;
+        bounds.push_back(rho_min);
+        bounds.push_back(rho_max);
+
+        // Add boundary at transition between full and partial containment
+        // of model within Psf
+        double transition_point = delta_max - zeta;
+        if (transition_point > rho_min && transition_point < rho_max) {
+            bounds.push_back(transition_point);
+        }
+
+        // Integrate kernel
+        irf = integral.romberg(bounds, iter_rho);
+
+        // Get number of recorded kernel calls
+        int stride = 3 + npars;
+        int ncalls = nodes.size() / stride;
+
+        // Integrate parameter gradients using the recorded IRF values
+        std::vector<double> values(ncalls, 0.0);
+        for (int k = 0; k < npars; ++k) {
+            for (int i = 0; i < ncalls; ++i) {
+                values[i] = nodes[i*stride+3+k] * nodes[i*stride+2];
+            }
+            cta_kern_replay replay(values, 1, 0);
+            GIntegral       integral_grad(&replay);
+            integral_grad.fixed_iter(iter_rho);
+            grads[k] = integral_grad.romberg(bounds, iter_rho);
+        }
+
+        // Add the contribution of the disk edge to the radius gradient if
+        // the edge is within the integration range. The radius is the only
+        // parameter of a disk model that has a gradient.
+        if (disk != NULL && rho_max == src_max) {
+            for (int i = 0; i < ncalls; ++i) {
+                const double* node = &nodes[i*stride];
+                if (node[0] == rho_max) {
+                    double edge = node[1] * node[2];
+                    for (int k = 0; k < npars; ++k) {
+                        const GModelPar& par = (*model)[pars[k]];
+                        if (par.is_free()) {
+                            grads[k] += edge * gammalib::deg2rad * par.scale();
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+        // Apply deadtime correction
+        double deadc = obs.deadc(srcTime);
+        irf *= deadc;
+        for (int k = 0; k < npars; ++k) {
+            grads[k] *= deadc;
+        }
+
+    } // endif: integration interval is valid
+
+    // Set gradients
+    for (int k = 0; k < npars; ++k) {
+        (*model)[pars[k]].factor_gradient(grads[k]);
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Return elliptical model IRF value and parameter gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Value of instrument response function.
+ *
+ * @exception GCTAException::bad_model_type
+ *            Model is not an elliptical model.
+ *
+ * Computes the elliptical model IRF in the same way as irf_elliptical()
+ * and derives the gradients with respect to the model parameters that
+ * have a gradient from the IRF values that were computed for the IRF
+ * integration.
+ ***************************************************************************/
+double GCTAResponseIrf::irf_elliptical_gradients(const GEvent&       event,
+                                                 const GSource&      source,
+                                                 const GObservation& obs) const
+{
+    // Set number of iterations for Romberg integration (see irf_elliptical())
+    static const int iter_rho = 5;
+    static const int iter_phi = 5;
+
+    // Retrieve CTA pointing
+    const GCTAPointing& pnt = retrieve_pnt(G_IRF_ELLIPTICAL_GRAD, obs);
+    const GCTAInstDir&  dir = retrieve_dir(G_IRF_ELLIPTICAL_GRAD, event);
+
+    // Get pointer on elliptical model
+    GModelSpatialElliptical* model =
+          dynamic_cast<GModelSpatialElliptical*>(const_cast<GModelSpatial*>(source.model()));
+    if (model == NULL) {
+        throw GCTAException::bad_model_type(G_IRF_ELLIPTICAL_GRAD);
+    }
+
+    // Get event attributes (measured photon)
+    const GSkyDir& obsDir = dir.dir();
+    const GEnergy& obsEng = event.energy();
+
+    // Get source attributes
+    const GSkyDir& centre  = model->dir();
+    const GEnergy& srcEng  = source.energy();
+    const GTime&   srcTime = source.time();
+
+    // Get pointing direction zenith angle and azimuth [radians]
+    double zenith  = pnt.zenith();
+    double azimuth = pnt.azimuth();
+
+    // Determine geometry in model system (see irf_elliptical())
+    double rho_obs      = centre.dist(obsDir);
+    double posangle_obs = centre.posang(obsDir);
+    double rho_pnt      = centre.dist(pnt.dir());
+    double posangle_pnt = centre.posang(pnt.dir());
+    double omega_pnt    = posangle_pnt - posangle_obs;
+
+    // Get log10(E/TeV) of true photon energy
+    double srcLogEng = srcEng.log10TeV();
+
+    // Get maximum PSF radius [radians]
+    double theta     = pnt.dir().dist(obsDir);
+    double phi       = 0.0; //TODO: Implement IRF Phi dependence
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+
+    // Get the boundary ellipse (see irf_elliptical())
+    double semimajor;
+    double semiminor;
+    double posangle;
+    double aspect_ratio;
+    if (model->semimajor() >= model->semiminor()) {
+        aspect_ratio = (model->semimajor() > 0.0) ?
+                        model->semiminor() / model->semimajor() : 0.0;
+        posangle     = model->posangle() * gammalib::deg2rad;
+    }
+    else {
+        aspect_ratio = (model->semiminor() > 0.0) ?
+                        model->semimajor() / model->semiminor() : 0.0;
+        posangle     = model->posangle() * gammalib::deg2rad + gammalib::pihalf;
+    }
+    semimajor = model->theta_max();
+    semiminor = semimajor * aspect_ratio;
+
+    // Set zenith angle integration range for elliptical model
+    double rho_min = (rho_obs > delta_max) ? rho_obs - delta_max : 0.0;
+    double rho_max = rho_obs + delta_max;
+    if (rho_max > semimajor) {
+        rho_max = semimajor;
+    }
+
+    // Collect indices of parameters with gradient
+    std::vector<int> pars;
+    for (int k = 0; k < model->size(); ++k) {
+        if ((*model)[k].has_grad()) {
+            pars.push_back(k);
+        }
+    }
+    int npars = pars.size();
+
+    // Initialise IRF value and gradients
+    double              irf = 0.0;
+    std::vector<double> grads(npars, 0.0);
+
+    // Perform zenith angle integration if interval is valid
+    if (rho_max > rho_min) {
+
+        // Setup integration kernel that records the gradient integrals
+        std::vector<double>         nodes;
+        cta_irf_elliptical_kern_rho integrand(*this,
+                                              *model,
+                                              semimajor,
+                                              semiminor,
+                                              posangle,
+                                              zenith,
+                                              azimuth,
+                                              srcEng,
+                                              srcTime,
+                                              srcLogEng,
+                                              obsEng,
+                                              rho_obs,
+                                              posangle_obs,
+                                              rho_pnt,
+                                              omega_pnt,
+                                              delta_max,
+                                              iter_phi,
+                                              &pars,
+                                              &nodes);
+
+        // Integrate over model's zenith angle
+        GIntegral integral(&integrand);
+        integral.fixed_iter(iter_rho);
+
+        // Setup integration boundaries
+        std::vector<double> bounds;
+        bounds.push_back(rho_min);
+        bounds.push_back(rho_max);
+        if (semiminor > rho_min && semiminor < rho_max) {
+            bounds.push_back(semiminor);
+        }
+
+        // Integrate kernel
+        irf = integral.romberg(bounds, iter_rho);
+
+        // Integrate shape parameter gradients using the recorded values
+        for (int k = 0; k < npars; ++k) {
+            cta_kern_replay replay(nodes, npars, k);
+            GIntegral       integral_grad(&replay);
+            integral_grad.fixed_iter(iter_rho);
+            grads[k] = integral_grad.romberg(bounds, iter_rho);
+        }
+
+        // Apply deadtime correction
+        double deadc = obs.deadc(srcTime);
+        irf *= deadc;
+        for (int k = 0; k < npars; ++k) {
+            grads[k] *= deadc;
+        }
+
+    } // endif: integration interval is valid
+
+    // Set gradients
+    for (int k = 0; k < npars; ++k) {
+        (*model)[pars[k]].factor_gradient(grads[k]);
+    }
+
+    // Return IRF value
+    return irf;
+}
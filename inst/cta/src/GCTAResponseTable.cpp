@@ -228,13 +228,15 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg) const
     // Initialise result vector
     std::vector<double> result(num);
 
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    int    inx[2];
+    double wgt[2];
+    weights(arg, inx, wgt);
 
     // Perform 1D interpolation
     for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt_left  * m_pars[i][m_inx_left] +
-                    m_wgt_right * m_pars[i][m_inx_right];
+        result[i] = wgt[0] * m_pars[i][inx[0]] +
+                    wgt[1] * m_pars[i][inx[1]];
     }
 
     // Return result vector
@@ -276,15 +278,17 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg1,
     // Initialise result vector
     std::vector<double> result(num);
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Get indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+    weights(arg1, arg2, inx, wgt);
 
     // Perform 2D interpolation
     for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt1 * m_pars[i][m_inx1] +
-                    m_wgt2 * m_pars[i][m_inx2] +
-                    m_wgt3 * m_pars[i][m_inx3] +
-                    m_wgt4 * m_pars[i][m_inx4];
+        result[i] = wgt[0] * m_pars[i][inx[0]] +
+                    wgt[1] * m_pars[i][inx[1]] +
+                    wgt[2] * m_pars[i][inx[2]] +
+                    wgt[3] * m_pars[i][inx[3]];
     }
 
     // Return result vector
@@ -328,19 +332,21 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg1,
     // Initialise result vector
     std::vector<double> result(num);
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2, arg3);
+    // Get indices and weighting factors for interpolation
+    int    inx[8];
+    double wgt[8];
+    weights(arg1, arg2, arg3, inx, wgt);
 
     // Perform 3D interpolation
     for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt1 * m_pars[i][m_inx1] +
-                    m_wgt2 * m_pars[i][m_inx2] +
-                    m_wgt3 * m_pars[i][m_inx3] +
-                    m_wgt4 * m_pars[i][m_inx4] +
-                    m_wgt5 * m_pars[i][m_inx5] +
-                    m_wgt6 * m_pars[i][m_inx6] +
-                    m_wgt7 * m_pars[i][m_inx7] +
-                    m_wgt8 * m_pars[i][m_inx8] ;
+        result[i] = wgt[0] * m_pars[i][inx[0]] +
+                    wgt[1] * m_pars[i][inx[1]] +
+                    wgt[2] * m_pars[i][inx[2]] +
+                    wgt[3] * m_pars[i][inx[3]] +
+                    wgt[4] * m_pars[i][inx[4]] +
+                    wgt[5] * m_pars[i][inx[5]] +
+                    wgt[6] * m_pars[i][inx[6]] +
+                    wgt[7] * m_pars[i][inx[7]];
     }
 
     // Return result vector
@@ -475,12 +481,14 @@ double GCTAResponseTable::operator()(const int& index, const double& arg) const
     }
     #endif
 
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    int    inx[2];
+    double wgt[2];
+    weights(arg, inx, wgt);
 
     // Perform 1D interpolation
-    double result = m_wgt_left  * m_pars[index][m_inx_left] +
-                    m_wgt_right * m_pars[index][m_inx_right];
+    double result = wgt[0] * m_pars[index][inx[0]] +
+                    wgt[1] * m_pars[index][inx[1]];
 
     // Return result
     return result;
@@ -516,14 +524,16 @@ double GCTAResponseTable::operator()(const int& index, const double& arg1,
     }
     #endif
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Get indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+    weights(arg1, arg2, inx, wgt);
 
     // Perform 2D interpolation
-    double result = m_wgt1 * m_pars[index][m_inx1] +
-                    m_wgt2 * m_pars[index][m_inx2] +
-                    m_wgt3 * m_pars[index][m_inx3] +
-                    m_wgt4 * m_pars[index][m_inx4];
+    double result = wgt[0] * m_pars[index][inx[0]] +
+                    wgt[1] * m_pars[index][inx[1]] +
+                    wgt[2] * m_pars[index][inx[2]] +
+                    wgt[3] * m_pars[index][inx[3]];
 
     // Return result
     return result;
@@ -562,18 +572,20 @@ double GCTAResponseTable::operator()(const int&    index,
     }
     #endif
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2, arg3);
+    // Get indices and weighting factors for interpolation
+    int    inx[8];
+    double wgt[8];
+    weights(arg1, arg2, arg3, inx, wgt);
 
     // Perform 3D interpolation
-    double result = m_wgt1 * m_pars[index][m_inx1] +
-                    m_wgt2 * m_pars[index][m_inx2] +
-                    m_wgt3 * m_pars[index][m_inx3] +
-                    m_wgt4 * m_pars[index][m_inx4] +
-                    m_wgt5 * m_pars[index][m_inx5] +
-                    m_wgt6 * m_pars[index][m_inx6] +
-                    m_wgt7 * m_pars[index][m_inx7] +
-                    m_wgt8 * m_pars[index][m_inx8];
+    double result = wgt[0] * m_pars[index][inx[0]] +
+                    wgt[1] * m_pars[index][inx[1]] +
+                    wgt[2] * m_pars[index][inx[2]] +
+                    wgt[3] * m_pars[index][inx[3]] +
+                    wgt[4] * m_pars[index][inx[4]] +
+                    wgt[5] * m_pars[index][inx[5]] +
+                    wgt[6] * m_pars[index][inx[6]] +
+                    wgt[7] * m_pars[index][inx[7]];
 
     // Return result
     return result;
@@ -1278,28 +1290,6 @@ void GCTAResponseTable::init_members(void)
     m_axis_nodes.clear();
     m_pars.clear();
 
-    // Initialise cache
-    m_inx_left  = 0;
-    m_inx_right = 0;
-    m_wgt_left  = 0.0;
-    m_wgt_right = 0.0;
-    m_inx1      = 0;
-    m_inx2      = 0;
-    m_inx3      = 0;
-    m_inx4      = 0;
-    m_inx5      = 0;
-    m_inx6      = 0;
-    m_inx7      = 0;
-    m_inx8      = 0;
-    m_wgt1      = 0.0;
-    m_wgt2      = 0.0;
-    m_wgt3      = 0.0;
-    m_wgt4      = 0.0;
-    m_wgt5      = 0.0;
-    m_wgt6      = 0.0;
-    m_wgt7      = 0.0;
-    m_wgt8      = 0.0;
-
     // Return
     return;
 }
@@ -1329,28 +1319,6 @@ void GCTAResponseTable::copy_members(const GCTAResponseTable& table)
     m_axis_nodes  = table.m_axis_nodes;
     m_pars        = table.m_pars;
 
-    // Copy cache
-    m_inx_left  = table.m_inx_left;
-    m_inx_right = table.m_inx_right;
-    m_wgt_left  = table.m_wgt_left;
-    m_wgt_right = table.m_wgt_right;
-    m_inx1      = table.m_inx1;
-    m_inx2      = table.m_inx2;
-    m_inx3      = table.m_inx3;
-    m_inx4      = table.m_inx4;
-    m_inx5      = table.m_inx5;
-    m_inx6      = table.m_inx6;
-    m_inx7      = table.m_inx7;
-    m_inx8      = table.m_inx8;
-    m_wgt1      = table.m_wgt1;
-    m_wgt2      = table.m_wgt2;
-    m_wgt3      = table.m_wgt3;
-    m_wgt4      = table.m_wgt4;
-    m_wgt5      = table.m_wgt5;
-    m_wgt6      = table.m_wgt6;
-    m_wgt7      = table.m_wgt7;
-    m_wgt8      = table.m_wgt8;
-
     // Return
     return;
 }
@@ -1664,29 +1632,29 @@ void GCTAResponseTable::read_pars(const GFitsTable& hdu)
 
 
 /***********************************************************************//**
- * @brief Update 1D cache
+ * @brief Compute 1D interpolation indices and weights
  *
  * @param[in] arg Argument.
+ * @param[out] inx Indices of 2 table values.
+ * @param[out] wgt Weights of 2 table values.
  *
- * Updates the 1D interpolation cache. The interpolation cache is composed
- * of two indices and weights that define 2 data values of the 2D table
- * that are used for linear interpolation.
+ * Computes the two indices and weights that define the 2 data values of
+ * the 1D table that are used for linear interpolation. The method does not
+ * modify the response table and may be called concurrently by several
+ * threads.
  *
  * @todo Write down formula
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg) const
+void GCTAResponseTable::weights(const double& arg, int* inx, double* wgt) const
 {
-    // Get pointer to node array
-    const GNodeArray* nodes = &(m_axis_nodes[0]);
-
-    // Set value for node array
-    nodes->set_value(arg);
+    // Get indices and weighting factors for node array
+    GNodeArray::interpolation w = m_axis_nodes[0].interpolate(arg);
 
     // Set indices and weighting factors for interpolation
-    m_inx_left  = nodes->inx_left();
-    m_inx_right = nodes->inx_right();
-    m_wgt_left  = nodes->wgt_left();
-    m_wgt_right = nodes->wgt_right();
+    inx[0] = w.inx_left;
+    inx[1] = w.inx_right;
+    wgt[0] = w.wgt_left;
+    wgt[1] = w.wgt_right;
 
     // Return
     return;
@@ -1694,43 +1662,43 @@ void GCTAResponseTable::update(const double& arg) const
 
 
 /***********************************************************************//**
- * @brief Update 2D cache
+ * @brief Compute 2D interpolation indices and weights
  *
  * @param[in] arg1 Argument for first axis.
  * @param[in] arg2 Argument for second axis.
+ * @param[out] inx Indices of 4 table values.
+ * @param[out] wgt Weights of 4 table values.
  *
- * Updates the 2D interpolation cache. The interpolation cache is composed
- * of four indices and weights that define 4 data values of the 2D table
- * that are used for bilinear interpolation.
+ * Computes the four indices and weights that define the 4 data values of
+ * the 2D table that are used for bilinear interpolation. The method does
+ * not modify the response table and may be called concurrently by several
+ * threads.
  *
  * @todo Write down formula
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg1, const double& arg2) const
+void GCTAResponseTable::weights(const double& arg1, const double& arg2,
+                                int* inx, double* wgt) const
 {
-    // Get pointers to node arrays
-    const GNodeArray* nodes1 = &(m_axis_nodes[0]);
-    const GNodeArray* nodes2 = &(m_axis_nodes[1]);
-
-    // Set values for node arrays
-    nodes1->set_value(arg1);
-    nodes2->set_value(arg2);
+    // Get indices and weighting factors for node arrays
+    GNodeArray::interpolation w1 = m_axis_nodes[0].interpolate(arg1);
+    GNodeArray::interpolation w2 = m_axis_nodes[1].interpolate(arg2);
 
     // Compute offsets
     int size1        = axis(0);
-    int offset_left  = nodes2->inx_left()  * size1;
-    int offset_right = nodes2->inx_right() * size1;
+    int offset_left  = w2.inx_left  * size1;
+    int offset_right = w2.inx_right * size1;
 
     // Set indices for bi-linear interpolation
-    m_inx1 = nodes1->inx_left()  + offset_left;
-    m_inx2 = nodes1->inx_left()  + offset_right;
-    m_inx3 = nodes1->inx_right() + offset_left;
-    m_inx4 = nodes1->inx_right() + offset_right;
+    inx[0] = w1.inx_left  + offset_left;
+    inx[1] = w1.inx_left  + offset_right;
+    inx[2] = w1.inx_right + offset_left;
+    inx[3] = w1.inx_right + offset_right;
 
     // Set weighting factors for bi-linear interpolation
-    m_wgt1 = nodes1->wgt_left()  * nodes2->wgt_left();
-    m_wgt2 = nodes1->wgt_left()  * nodes2->wgt_right();
-    m_wgt3 = nodes1->wgt_right() * nodes2->wgt_left();
-    m_wgt4 = nodes1->wgt_right() * nodes2->wgt_right();
+    wgt[0] = w1.wgt_left  * w2.wgt_left;
+    wgt[1] = w1.wgt_left  * w2.wgt_right;
+    wgt[2] = w1.wgt_right * w2.wgt_left;
+    wgt[3] = w1.wgt_right * w2.wgt_right;
 
     // Return
     return;
@@ -1738,58 +1706,57 @@ void GCTAResponseTable::update(const double& arg1, const double& arg2) const
 
 
 /***********************************************************************//**
- * @brief Update 3D cache
+ * @brief Compute 3D interpolation indices and weights
  *
  * @param[in] arg1 Argument for first axis.
  * @param[in] arg2 Argument for second axis.
  * @param[in] arg3 Argument for third axis.
+ * @param[out] inx Indices of 8 table values.
+ * @param[out] wgt Weights of 8 table values.
  *
- * Updates the 3D interpolation cache. The interpolation cache is composed
- * of four indices and weights that define 4 data values of the 2D table
- * that are used for bilinear interpolation.
+ * Computes the eight indices and weights that define the 8 data values of
+ * the 3D table that are used for trilinear interpolation. The method does
+ * not modify the response table and may be called concurrently by several
+ * threads.
  *
  * @todo Write down formula
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg1, const double& arg2,
-                               const double& arg3) const
+void GCTAResponseTable::weights(const double& arg1, const double& arg2,
+                                const double& arg3, int* inx,
+                                double* wgt) const
 {
-    // Get pointers to node arrays (circumvent const correctness)
-    const GNodeArray* nodes1 = &(m_axis_nodes[0]);
-    const GNodeArray* nodes2 = &(m_axis_nodes[1]);
-    const GNodeArray* nodes3 = &(m_axis_nodes[2]);
-
-    // Set values for node arrays
-    nodes1->set_value(arg1);
-    nodes2->set_value(arg2);
-    nodes3->set_value(arg3);
+    // Get indices and weighting factors for node arrays
+    GNodeArray::interpolation w1 = m_axis_nodes[0].interpolate(arg1);
+    GNodeArray::interpolation w2 = m_axis_nodes[1].interpolate(arg2);
+    GNodeArray::interpolation w3 = m_axis_nodes[2].interpolate(arg3);
 
     // Compute offsets
     int size1          = axis(0);
     int size2          = axis(1);
-    int offset_left_2  = nodes2->inx_left()  * size1;
-    int offset_right_2 = nodes2->inx_right() * size1;
-    int offset_left_3  = nodes3->inx_left()  * size1 * size2;
-    int offset_right_3 = nodes3->inx_right() * size1 * size2;
+    int offset_left_2  = w2.inx_left  * size1;
+    int offset_right_2 = w2.inx_right * size1;
+    int offset_left_3  = w3.inx_left  * size1 * size2;
+    int offset_right_3 = w3.inx_right * size1 * size2;
 
     // Set indices for tri-linear interpolation
-    m_inx1 = nodes1->inx_left()  + offset_left_2  + offset_left_3 ;
-    m_inx2 = nodes1->inx_left()  + offset_left_2  + offset_right_3;
-    m_inx3 = nodes1->inx_left()  + offset_right_2 + offset_left_3 ;
-    m_inx4 = nodes1->inx_left()  + offset_right_2 + offset_right_3;
-    m_inx5 = nodes1->inx_right() + offset_left_2  + offset_left_3 ;
-    m_inx6 = nodes1->inx_right() + offset_left_2  + offset_right_3;
-    m_inx7 = nodes1->inx_right() + offset_right_2 + offset_left_3 ;
-    m_inx8 = nodes1->inx_right() + offset_right_2 + offset_right_3;
+    inx[0] = w1.inx_left  + offset_left_2  + offset_left_3 ;
+    inx[1] = w1.inx_left  + offset_left_2  + offset_right_3;
+    inx[2] = w1.inx_left  + offset_right_2 + offset_left_3 ;
+    inx[3] = w1.inx_left  + offset_right_2 + offset_right_3;
+    inx[4] = w1.inx_right + offset_left_2  + offset_left_3 ;
+    inx[5] = w1.inx_right + offset_left_2  + offset_right_3;
+    inx[6] = w1.inx_right + offset_right_2 + offset_left_3 ;
+    inx[7] = w1.inx_right + offset_right_2 + offset_right_3;
 
     // Set weighting factors for tri-linear interpolation
-    m_wgt1 = nodes1->wgt_left()  * nodes2->wgt_left()  *  nodes3->wgt_left();
-    m_wgt2 = nodes1->wgt_left()  * nodes2->wgt_left()  *  nodes3->wgt_right();
-    m_wgt3 = nodes1->wgt_left()  * nodes2->wgt_right() *  nodes3->wgt_left();
-    m_wgt4 = nodes1->wgt_left()  * nodes2->wgt_right() *  nodes3->wgt_right();
-    m_wgt5 = nodes1->wgt_right() * nodes2->wgt_left()  *  nodes3->wgt_left();
-    m_wgt6 = nodes1->wgt_right() * nodes2->wgt_left()  *  nodes3->wgt_right();
-    m_wgt7 = nodes1->wgt_right() * nodes2->wgt_right() *  nodes3->wgt_left();
-    m_wgt8 = nodes1->wgt_right() * nodes2->wgt_right() *  nodes3->wgt_right();
+    wgt[0] = w1.wgt_left  * w2.wgt_left  * w3.wgt_left;
+    wgt[1] = w1.wgt_left  * w2.wgt_left  * w3.wgt_right;
+    wgt[2] = w1.wgt_left  * w2.wgt_right * w3.wgt_left;
+    wgt[3] = w1.wgt_left  * w2.wgt_right * w3.wgt_right;
+    wgt[4] = w1.wgt_right * w2.wgt_left  * w3.wgt_left;
+    wgt[5] = w1.wgt_right * w2.wgt_left  * w3.wgt_right;
+    wgt[6] = w1.wgt_right * w2.wgt_right * w3.wgt_left;
+    wgt[7] = w1.wgt_right * w2.wgt_right * w3.wgt_right;
 
     // Return
     return;
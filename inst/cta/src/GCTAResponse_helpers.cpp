@@ -50,6 +50,7 @@
 
 /* __ Constants __________________________________________________________ */
 const double g_kulge_radius = 1.0e-12;         //!< Tiny angle (radians)
+const int    g_kern_chunk   = 64;              //!< Chunk size of batch kernels
 const double g_ellipse_kulge_radius = 1.0e-6;  //!< About 0.2 arc seconds
                                                //   A larger radius is used
                                                //   as the ellipse is defined
@@ -271,6 +272,11 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
     // Initialise result
     double irf = 0.0;
 
+    // Initialise values that are recorded for gradient computation
+    double model     = 0.0;
+    double irf_rho   = 0.0;
+    bool   gradients = false;
+
     // Continue only if rho is positive (otherwise the integral will be
     // zero)
     if (rho > 0.0) {
@@ -298,8 +304,15 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
                 rho_kluge = 0.0;
             }
 
-            // Evaluate sky model
-            double model = m_model.eval(rho_kluge, m_srcEng, m_srcTime);
+            // Evaluate sky model. If nodes are recorded then also evaluate
+            // the model gradients
+            if (m_nodes != NULL && m_pars != NULL) {
+                model     = m_model.eval_gradients(rho_kluge, m_srcEng, m_srcTime);
+                gradients = true;
+            }
+            else {
+                model = m_model.eval(rho_kluge, m_srcEng, m_srcTime);
+            }
 
             // Debug: test if model is non positive
             #if defined(G_DEBUG_MODEL_ZERO)
@@ -342,8 +355,9 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
                 // Integrate over phi
                 GIntegral integral(&integrand);
                 integral.fixed_iter(m_iter);
-                irf = integral.romberg(omega_min, omega_max, m_iter) *
-                      model * sin_rho;
+                irf_rho = integral.romberg(omega_min, omega_max, m_iter) *
+                          sin_rho;
+                irf     = irf_rho * model;
 
                 // Compile option: Check for NaN/Inf
                 #if defined(G_NAN_CHECK)
@@ -365,6 +379,18 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
 
     } // endif: rho was positive
 
+    // Optionally record node
+    if (m_nodes != NULL && m_pars != NULL) {
+        m_nodes->push_back(rho);
+        m_nodes->push_back(model);
+        m_nodes->push_back(irf_rho);
+        int npars = m_pars->size();
+        for (int k = 0; k < npars; ++k) {
+            m_nodes->push_back((gradients) ? m_model[(*m_pars)[k]].factor_gradient()
+                                           : 0.0);
+        }
+    }
+
     // Return result
     return irf;
 }
@@ -410,40 +436,91 @@ double cta_irf_radial_kern_rho::eval(const double& rho)
  ***************************************************************************/
 double cta_irf_radial_kern_omega::eval(const double& omega)
 {
-    // Compute PSF offset angle [radians]
-    double delta = std::acos(m_cos_psf + m_sin_psf * std::cos(omega));
-    
-    // Compute true photon offset angle in camera system [radians]
-    double offset = std::acos(m_cos_ph + m_sin_ph * std::cos(m_omega0 - omega));
-    
-    //TODO: Compute true photon azimuth angle in camera system [radians]
-    double azimuth = 0.0;
+    // Evaluate kernel for a single azimuth angle
+    double irf;
+    eval(&omega, &irf, 1);
 
-    // Evaluate IRF
-    double irf = m_rsp.aeff(offset, azimuth, m_zenith, m_azimuth, m_srcLogEng) *
-                 m_rsp.psf(delta, offset, azimuth, m_zenith, m_azimuth, m_srcLogEng);
+    // Return
+    return irf;
+}
 
-    // Optionally take energy dispersion into account
-    if (m_rsp.use_edisp() && irf > 0.0) {
-        irf *= m_rsp.edisp(m_obsEng, offset, azimuth, m_zenith, m_azimuth, m_srcLogEng);
-    }
-    
-    // Compile option: Check for NaN/Inf
-    #if defined(G_NAN_CHECK)
-    if (gammalib::is_notanumber(irf) || gammalib::is_infinite(irf)) {
-        std::cout << "*** ERROR: cta_irf_radial_kern_omega::eval";
-        std::cout << "(omega=" << omega << "):";
-        std::cout << " NaN/Inf encountered";
-        std::cout << " (irf=" << irf;
-        std::cout << ", delta=" << delta;
-        std::cout << ", offset=" << offset;
-        std::cout << ", azimuth=" << azimuth << ")";
-        std::cout << std::endl;
-    }
-    #endif
+
+/***********************************************************************//**
+ * @brief Kernel for radial model azimuth angle IRF integration
+ *
+ * @param[in] omega Array of azimuth angles (radians).
+ * @param[out] irf Array of IRF values.
+ * @param[in] n Number of azimuth angles.
+ *
+ * Computes the IRF for an array of azimuth angles (see the single value
+ * eval() method for the formulae). The PSF and camera offset angles are
+ * computed in tight loops over chunks of azimuth angles before the IRF is
+ * evaluated, which allows the compiler to vectorise the trigonometry.
+ ***************************************************************************/
+void cta_irf_radial_kern_omega::eval(const double* omega, double* irf,
+                                     const int& n)
+{
+    // Get local copies of the geometry parameters
+    const double cos_psf = m_cos_psf;
+    const double sin_psf = m_sin_psf;
+    const double cos_ph  = m_cos_ph;
+    const double sin_ph  = m_sin_ph;
+    const double omega0  = m_omega0;
+
+    // Allocate chunk arrays
+    double delta[g_kern_chunk];
+    double offset[g_kern_chunk];
+
+    // Loop over chunks of azimuth angles
+    for (int i0 = 0; i0 < n; i0 += g_kern_chunk) {
+
+        // Set chunk size and chunk arrays
+        int           num = (n - i0 < g_kern_chunk) ? n - i0 : g_kern_chunk;
+        const double* w   = omega + i0;
+        double*       y   = irf   + i0;
+
+        // Compute PSF offset angles and true photon offset angles in
+        // camera system [radians]
+        for (int i = 0; i < num; ++i) {
+            delta[i]  = std::acos(cos_psf + sin_psf * std::cos(w[i]));
+            offset[i] = std::acos(cos_ph  + sin_ph  * std::cos(omega0 - w[i]));
+        }
+
+        // Evaluate IRF
+        for (int i = 0; i < num; ++i) {
+
+            //TODO: Compute true photon azimuth angle in camera system [radians]
+            double azimuth = 0.0;
+
+            // Evaluate IRF
+            y[i] = m_rsp.aeff(offset[i], azimuth, m_zenith, m_azimuth, m_srcLogEng) *
+                   m_rsp.psf(delta[i], offset[i], azimuth, m_zenith, m_azimuth, m_srcLogEng);
+
+            // Optionally take energy dispersion into account
+            if (m_rsp.use_edisp() && y[i] > 0.0) {
+                y[i] *= m_rsp.edisp(m_obsEng, offset[i], azimuth, m_zenith, m_azimuth, m_srcLogEng);
+            }
+
+            // Compile option: Check for NaN/Inf
+            #if defined(G_NAN_CHECK)
+            if (gammalib::is_notanumber(y[i]) || gammalib::is_infinite(y[i])) {
+                std::cout << "*** ERROR: cta_irf_radial_kern_omega::eval";
+                std::cout << "(omega=" << w[i] << "):";
+                std::cout << " NaN/Inf encountered";
+                std::cout << " (irf=" << y[i];
+                std::cout << ", delta=" << delta[i];
+                std::cout << ", offset=" << offset[i];
+                std::cout << ", azimuth=" << azimuth << ")";
+                std::cout << std::endl;
+            }
+            #endif
+
+        } // endfor: looped over chunk
+
+    } // endfor: looped over chunks
 
     // Return
-    return irf;
+    return;
 }
 
 
@@ -644,6 +721,10 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
     // Initialise result
     double irf = 0.0;
 
+    // Initialise gradient integrals that are recorded
+    int                 npars = (m_pars != NULL && m_nodes != NULL) ? m_pars->size() : 0;
+    std::vector<double> grads(npars, 0.0);
+
     // Continue only if rho is positive
     if (rho > 0.0) {
 
@@ -676,7 +757,9 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
                 rho_kluge = 0.0;
             }
 
-            // Setup integration kernel
+            // Setup integration kernel. If gradients are requested then
+            // let the kernel record the model gradients times the IRF
+            std::vector<double> values;
             cta_irf_elliptical_kern_omega integrand(m_rsp,
                                                     m_model,
                                                     m_zenith,
@@ -691,12 +774,17 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
                                                     cos_psf,
                                                     sin_psf,
                                                     cos_ph,
-                                                    sin_ph);
+                                                    sin_ph,
+                                                    (npars > 0) ? m_pars : NULL,
+                                                    (npars > 0) ? &values : NULL);
 
             // Setup integrator
             GIntegral integral(&integrand);
             integral.fixed_iter(m_iter);
 
+            // Initialise azimuth angle intervals
+            cta_omega_intervals intervals;
+
             // If the radius rho is not larger than the semiminor axis
             // boundary, the circle with that radius is fully contained in
             // the ellipse and we can just integrate over the relevant arc
@@ -706,9 +794,8 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
                 double omega_min = -domega;
                 double omega_max = +domega;
 
-                // Integrate over omega
-                irf = integral.romberg(omega_min, omega_max, m_iter) *
-                      sin_rho;
+                // Set azimuth angle interval
+                intervals.push_back(std::make_pair(omega_min, omega_max));
 
             } // endif: circle comprised in ellipse
 
@@ -755,24 +842,36 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
                     cta_omega_intervals intervals2 = 
                         gammalib::limit_omega(omega2_min, omega2_max, domega);
 
-                    // Integrate over all intervals for omega1
-                    for (int i = 0; i < intervals1.size(); ++i) {
-                        double min = intervals1[i].first;
-                        double max = intervals1[i].second;
-                        irf       += integral.romberg(min, max, m_iter) * sin_rho;
-                    }
-
-                    // Integrate over all intervals for omega2
-                    for (int i = 0; i < intervals2.size(); ++i) {
-                        double min = intervals2[i].first;
-                        double max = intervals2[i].second;
-                        irf       += integral.romberg(min, max, m_iter) * sin_rho;
-                    }
+                    // Gather intervals for omega1 and omega2
+                    intervals.insert(intervals.end(), intervals1.begin(),
+                                     intervals1.end());
+                    intervals.insert(intervals.end(), intervals2.begin(),
+                                     intervals2.end());
 
                 } // endif: arc length was positive
 
             } // endelse: circle was not comprised in ellipse
 
+            // Integrate over all intervals
+            int nintervals = intervals.size();
+            for (int i = 0; i < nintervals; ++i) {
+                double min = intervals[i].first;
+                double max = intervals[i].second;
+                irf       += integral.romberg(min, max, m_iter) * sin_rho;
+            }
+
+            // Integrate the recorded gradient values over the same intervals
+            for (int k = 0; k < npars; ++k) {
+                cta_kern_replay replay(values, npars+1, k+1);
+                GIntegral       integral_grad(&replay);
+                integral_grad.fixed_iter(m_iter);
+                for (int i = 0; i < nintervals; ++i) {
+                    double min = intervals[i].first;
+                    double max = intervals[i].second;
+                    grads[k]  += integral_grad.romberg(min, max, m_iter) * sin_rho;
+                }
+            }
+
             // Compile option: Check for NaN/Inf
             #if defined(G_NAN_CHECK)
             if (gammalib::is_notanumber(irf) || gammalib::is_infinite(irf)) {
@@ -790,6 +889,11 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
     
     } // endif: rho was positive
 
+    // Optionally record gradient integrals
+    for (int k = 0; k < npars; ++k) {
+        m_nodes->push_back(grads[k]);
+    }
+
     // Return result
     return irf;
 }
@@ -839,77 +943,144 @@ double cta_irf_elliptical_kern_rho::eval(const double& rho)
  ***************************************************************************/
 double cta_irf_elliptical_kern_omega::eval(const double& omega)
 {
-    // Initialise IRF value
-    double irf = 0.0;
+    // Evaluate kernel for a single azimuth angle
+    double irf;
+    eval(&omega, &irf, 1);
 
-    // Compute azimuth angle in model coordinate system (radians)
-    double omega_model = omega + m_posangle_obs;
+    // Return
+    return irf;
+}
 
-    // Evaluate sky model
-    double model = m_model.eval(m_rho, omega_model, m_srcEng, m_srcTime);
 
-    // Debug: test if model is non positive
-    #if defined(G_DEBUG_MODEL_ZERO)
-    if (model <= 0.0) {
-        double m_semiminor_rad = m_model.semiminor() * gammalib::deg2rad;
-        double m_semimajor_rad = m_model.semimajor() * gammalib::deg2rad;
-        double diff_angle      = omega_model - m_model.posangle() * gammalib::deg2rad;
-        double cosinus         = std::cos(diff_angle);
-        double sinus           = std::sin(diff_angle);
-        double arg1            = m_semiminor_rad * cosinus;
-        double arg2            = m_semimajor_rad * sinus;
-        double r_ellipse       = m_semiminor_rad * m_semimajor_rad /
-                                 std::sqrt(arg1*arg1 + arg2*arg2);
-        std::cout << "*** WARNING: cta_irf_elliptical_kern_omega::eval";
-        std::cout << " zero model for (rho,omega)=(";
-        std::cout << m_rho*gammalib::rad2deg << ",";
-        std::cout << omega*gammalib::rad2deg << ")";
-        std::cout << " rho-r_ellipse=" << (m_rho-r_ellipse) << " radians";
-        std::cout << std::endl;
-    }
-    #endif
+/***********************************************************************//**
+ * @brief Kernel for elliptical model integration over model's azimuth angle
+ *
+ * @param[in] omega Array of azimuth angles (radians).
+ * @param[out] irf Array of IRF values.
+ * @param[in] n Number of azimuth angles.
+ *
+ * Computes the model times the IRF for an array of azimuth angles (see the
+ * single value eval() method for the formulae). The PSF and camera offset
+ * angles are computed in tight loops over chunks of azimuth angles before
+ * the model and the IRF are evaluated, which allows the compiler to
+ * vectorise the trigonometry.
+ ***************************************************************************/
+void cta_irf_elliptical_kern_omega::eval(const double* omega, double* irf,
+                                         const int& n)
+{
+    // Get local copies of the geometry parameters
+    const double cos_psf   = m_cos_psf;
+    const double sin_psf   = m_sin_psf;
+    const double cos_ph    = m_cos_ph;
+    const double sin_ph    = m_sin_ph;
+    const double omega_pnt = m_omega_pnt;
+
+    // Allocate chunk arrays
+    double delta[g_kern_chunk];
+    double theta[g_kern_chunk];
+
+    // Loop over chunks of azimuth angles
+    for (int i0 = 0; i0 < n; i0 += g_kern_chunk) {
+
+        // Set chunk size and chunk arrays
+        int           num = (n - i0 < g_kern_chunk) ? n - i0 : g_kern_chunk;
+        const double* w   = omega + i0;
+        double*       y   = irf   + i0;
+
+        // Compute Psf offset angles and true photon offset angles in
+        // camera system [radians]
+        for (int i = 0; i < num; ++i) {
+            delta[i] = std::acos(cos_psf + sin_psf * std::cos(w[i]));
+            theta[i] = std::acos(cos_ph  + sin_ph  * std::cos(omega_pnt - w[i]));
+        }
 
-    // Continue only if model is positive
-    if (model > 0.0) {
+        // Evaluate model times IRF
+        for (int i = 0; i < num; ++i) {
 
-        // Compute Psf offset angle [radians]
-        double delta = std::acos(m_cos_psf + m_sin_psf * std::cos(omega));
-    
-        // Compute true photon offset and azimuth angle in camera system
-        // [radians]
-        double theta = std::acos(m_cos_ph + m_sin_ph * std::cos(m_omega_pnt - omega));
-        double phi   = 0.0; //TODO: Implement IRF Phi dependence
+            // Initialise IRF value
+            y[i] = 0.0;
 
-        // Evaluate IRF * model
-        irf = m_rsp.aeff(theta, phi, m_zenith, m_azimuth, m_srcLogEng) *
-              m_rsp.psf(delta, theta, phi, m_zenith, m_azimuth, m_srcLogEng) *
-              model;
+            // Compute azimuth angle in model coordinate system (radians)
+            double omega_model = w[i] + m_posangle_obs;
 
-        // Optionally take energy dispersion into account
-        if (m_rsp.use_edisp() && irf > 0.0) {
-            irf *= m_rsp.edisp(m_obsEng, theta, phi, 
-                               m_zenith, m_azimuth, m_srcLogEng);
-        }
+            // Evaluate sky model. If values are recorded then also evaluate
+            // the model gradients
+            double model = (m_values != NULL)
+                           ? m_model.eval_gradients(m_rho, omega_model, m_srcEng, m_srcTime)
+                           : m_model.eval(m_rho, omega_model, m_srcEng, m_srcTime);
 
-        // Compile option: Check for NaN/Inf
-        #if defined(G_NAN_CHECK)
-        if (gammalib::is_notanumber(irf) || gammalib::is_infinite(irf)) {
-            std::cout << "*** ERROR: cta_irf_elliptical_kern_omega::eval";
-            std::cout << "(omega=" << omega << "):";
-            std::cout << " NaN/Inf encountered";
-            std::cout << " (irf=" << irf;
-            std::cout << ", model=" << model;
-            std::cout << ", delta=" << delta;
-            std::cout << ", theta=" << theta;
-            std::cout << ", phi=" << phi << ")";
-            std::cout << std::endl;
-        }
-        #endif
+            // Debug: test if model is non positive
+            #if defined(G_DEBUG_MODEL_ZERO)
+            if (model <= 0.0) {
+                double m_semiminor_rad = m_model.semiminor() * gammalib::deg2rad;
+                double m_semimajor_rad = m_model.semimajor() * gammalib::deg2rad;
+                double diff_angle      = omega_model - m_model.posangle() * gammalib::deg2rad;
+                double cosinus         = std::cos(diff_angle);
+                double sinus           = std::sin(diff_angle);
+                double arg1            = m_semiminor_rad * cosinus;
+                double arg2            = m_semimajor_rad * sinus;
+                double r_ellipse       = m_semiminor_rad * m_semimajor_rad /
+                                         std::sqrt(arg1*arg1 + arg2*arg2);
+                std::cout << "*** WARNING: cta_irf_elliptical_kern_omega::eval";
+                std::cout << " zero model for (rho,omega)=(";
+                std::cout << m_rho*gammalib::rad2deg << ",";
+                std::cout << w[i]*gammalib::rad2deg << ")";
+                std::cout << " rho-r_ellipse=" << (m_rho-r_ellipse) << " radians";
+                std::cout << std::endl;
+            }
+            #endif
 
-    } // endif: model is positive
+            // Continue only if model is positive
+            if (model > 0.0) {
+
+                // Set true photon azimuth angle in camera system [radians]
+                double phi = 0.0; //TODO: Implement IRF Phi dependence
+
+                // Evaluate IRF * model
+                y[i] = m_rsp.aeff(theta[i], phi, m_zenith, m_azimuth, m_srcLogEng) *
+                       m_rsp.psf(delta[i], theta[i], phi, m_zenith, m_azimuth, m_srcLogEng) *
+                       model;
+
+                // Optionally take energy dispersion into account
+                if (m_rsp.use_edisp() && y[i] > 0.0) {
+                    y[i] *= m_rsp.edisp(m_obsEng, theta[i], phi, 
+                                        m_zenith, m_azimuth, m_srcLogEng);
+                }
+
+                // Compile option: Check for NaN/Inf
+                #if defined(G_NAN_CHECK)
+                if (gammalib::is_notanumber(y[i]) || gammalib::is_infinite(y[i])) {
+                    std::cout << "*** ERROR: cta_irf_elliptical_kern_omega::eval";
+                    std::cout << "(omega=" << w[i] << "):";
+                    std::cout << " NaN/Inf encountered";
+                    std::cout << " (irf=" << y[i];
+                    std::cout << ", model=" << model;
+                    std::cout << ", delta=" << delta[i];
+                    std::cout << ", theta=" << theta[i];
+                    std::cout << ", phi=" << phi << ")";
+                    std::cout << std::endl;
+                }
+                #endif
+
+            } // endif: model is positive
+
+            // Optionally record model value and gradients times IRF
+            if (m_values != NULL) {
+                m_values->push_back(y[i]);
+                double irf_value = (model > 0.0) ? y[i] / model : 0.0;
+                int    npars     = m_pars->size();
+                for (int k = 0; k < npars; ++k) {
+                    m_values->push_back(m_model[(*m_pars)[k]].factor_gradient() *
+                                        irf_value);
+                }
+            }
+
+        } // endfor: looped over chunk
+
+    } // endfor: looped over chunks
 
     // Return
-    return irf;
+    return;
 }
 
 
@@ -2247,3 +2418,51 @@ double cta_psf_diffuse_kern_phi::eval(const double& phi)
     // Return kernel value
     return value;
 }
+
+
+/***********************************************************************//**
+ * @brief Kernel for Psf convolution of diffuse maps
+ *
+ * @param[in] delta PSF offset angle (radians).
+ * @return Psf value (sr^-1).
+ *
+ * Returns the weighted mean of the Psf cube values at the true photon
+ * arrival directions and energy for an offset angle @p delta. The kernel
+ * is used by GSkymap::convolve() to convolve a diffuse model map with the
+ * Psf.
+ ***************************************************************************/
+double cta_psf_diffuse_kern_map::eval(const double& delta)
+{
+    // Initialise Psf value
+    double psf = 0.0;
+
+    // Sum weighted Psf values
+    int ndirs = m_srcDirs.size();
+    for (int i = 0; i < ndirs; ++i) {
+        psf += m_weights[i] * m_rsp->psf()(m_srcDirs[i], delta, m_srcEng);
+    }
+
+    // Return Psf value
+    return psf;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel that replays recorded integrand values
+ *
+ * @return Recorded integrand value.
+ *
+ * Returns the recorded value at position m_offset of the next function
+ * call. The abscissa is not used since the values are replayed in the
+ * order of the recorded calls. Zero is returned if no more values have
+ * been recorded.
+ ***************************************************************************/
+double cta_kern_replay::eval(const double&)
+{
+    // Get index of recorded value and advance to next call
+    int index = m_next * m_stride + m_offset;
+    m_next++;
+
+    // Return recorded value
+    return (index < int(m_values.size())) ? m_values[index] : 0.0;
+}
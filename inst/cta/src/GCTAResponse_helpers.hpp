@@ -170,6 +170,15 @@ protected:
  * - \f$\omega\f$ is the azimuth angle is the position angle with respect to
  *   the connecting line between the model centre and the observed photon
  *   arrival direction.
+ *
+ * If a list of parameter indices and a node vector are passed to the
+ * constructor, the kernel records for each call the zenith angle
+ * \f$\rho\f$, the model value, the azimuthal IRF integral
+ * \f$\sin \rho \int IRF d\omega\f$, followed by the model gradients
+ * of all parameters in the list (see
+ * GModelSpatialRadial::eval_gradients()). The recorded values allow the
+ * computation of the parameter gradients from the same IRF evaluations
+ * using the cta_kern_replay kernel.
  ***************************************************************************/
 class cta_irf_radial_kern_rho : public GFunction {
 public:
@@ -185,7 +194,9 @@ public:
                             const double&              lambda,
                             const double&              omega0,
                             const double&              delta_max,
-                            const int&                 iter) :
+                            const int&                 iter,
+                            const std::vector<int>*    pars  = NULL,
+                            std::vector<double>*       nodes = NULL) :
                             m_rsp(rsp),
                             m_model(model),
                             m_zenith(zenith),
@@ -203,7 +214,9 @@ public:
                             m_omega0(omega0),
                             m_delta_max(delta_max),
                             m_cos_delta_max(std::cos(delta_max)),
-                            m_iter(iter) { }
+                            m_iter(iter),
+                            m_pars(pars),
+                            m_nodes(nodes) { }
     double eval(const double& rho);
 protected:
     const GCTAResponseIrf&     m_rsp;           //!< CTA response
@@ -224,6 +237,8 @@ protected:
     const double&              m_delta_max;     //!< Maximum PSF radius
     double                     m_cos_delta_max; //!< Cosine of maximum PSF radius
     const int&                 m_iter;          //!< Integration iterations
+    const std::vector<int>*    m_pars;          //!< Gradient parameter indices (optional)
+    std::vector<double>*       m_nodes;         //!< Recorded nodes (optional)
 };
 
 
@@ -274,6 +289,7 @@ public:
                               m_cos_ph(cos_ph),
                               m_sin_ph(sin_ph) { }
     double eval(const double& omega);
+    void   eval(const double* omega, double* irf, const int& n);
 protected:
     const GCTAResponseIrf& m_rsp;           //!< CTA response
     const double&          m_zenith;        //!< Zenith angle
@@ -440,6 +456,14 @@ protected:
  * - \f$\omega\f$ is the azimuth angle is the position angle with respect to
  *   the connecting line between the model centre and the observed photon
  *   arrival direction.
+ *
+ * If a list of parameter indices and a node vector are passed to the
+ * constructor, the kernel records for each call the integrals
+ * \f$\sin \rho \int \partial S_{\rm p} / \partial p_i \,
+ * IRF(\rho, \omega) d\omega\f$ for all parameters \f$p_i\f$ in the
+ * list (see GModelSpatialElliptical::eval_gradients()). The recorded values
+ * allow the computation of the parameter gradients from the same IRF
+ * evaluations using the cta_kern_replay kernel.
  ***************************************************************************/
 class cta_irf_elliptical_kern_rho : public GFunction {
 public:
@@ -459,7 +483,9 @@ public:
                                 const double&                  rho_pnt,
                                 const double&                  omega_pnt,
                                 const double&                  delta_max,
-                                const int&                     iter) :
+                                const int&                     iter,
+                                const std::vector<int>*        pars  = NULL,
+                                std::vector<double>*           nodes = NULL) :
                                 m_rsp(rsp),
                                 m_model(model),
                                 m_semimajor(semimajor),
@@ -481,7 +507,9 @@ public:
                                 m_omega_pnt(omega_pnt),
                                 m_delta_max(delta_max),
                                 m_cos_delta_max(std::cos(delta_max)),
-                                m_iter(iter) { }
+                                m_iter(iter),
+                                m_pars(pars),
+                                m_nodes(nodes) { }
     double eval(const double& rho);
 public:
     const GCTAResponseIrf&         m_rsp;           //!< CTA response
@@ -506,6 +534,8 @@ public:
     const double&                  m_delta_max;     //!< Maximum PSF radius
     double                         m_cos_delta_max; //!< Cosine of maximum PSF radius
     const int&                     m_iter;          //!< Integration iterations
+    const std::vector<int>*        m_pars;          //!< Gradient parameter indices (optional)
+    std::vector<double>*           m_nodes;         //!< Recorded nodes (optional)
 };
 
 
@@ -527,6 +557,12 @@ public:
  * - \f$\omega\f$ is the azimuth angle is the position angle with respect to
  *   the connecting line between the model centre and the observed photon
  *   arrival direction.
+ *
+ * If a list of parameter indices and a value vector are passed to the
+ * constructor, the kernel records for each azimuth angle the value
+ * \f$S_{\rm p} \, IRF\f$ followed by the values
+ * \f$\partial S_{\rm p} / \partial p_i \, IRF\f$ for all parameters
+ * \f$p_i\f$ in the list.
  ***************************************************************************/
 class cta_irf_elliptical_kern_omega : public GFunction {
 public:
@@ -544,7 +580,9 @@ public:
                                   const double&                  cos_psf,
                                   const double&                  sin_psf,
                                   const double&                  cos_ph,
-                                  const double&                  sin_ph) :
+                                  const double&                  sin_ph,
+                                  const std::vector<int>*        pars   = NULL,
+                                  std::vector<double>*           values = NULL) :
                                   m_rsp(rsp),
                                   m_model(model),
                                   m_zenith(zenith),
@@ -559,8 +597,11 @@ public:
                                   m_cos_psf(cos_psf),
                                   m_sin_psf(sin_psf),
                                   m_cos_ph(cos_ph),
-                                  m_sin_ph(sin_ph) { }
+                                  m_sin_ph(sin_ph),
+                                  m_pars(pars),
+                                  m_values(values) { }
     double eval(const double& omega);
+    void   eval(const double* omega, double* irf, const int& n);
 public:
     const GCTAResponseIrf&         m_rsp;          //!< CTA response
     const GModelSpatialElliptical& m_model;        //!< Spatial model
@@ -577,6 +618,8 @@ public:
     const double&                  m_sin_psf;      //!< Sine term for PSF offset angle computation
     const double&                  m_cos_ph;       //!< Cosine term for photon offset angle computation
     const double&                  m_sin_ph;       //!< Sine term for photon offset angle computation
+    const std::vector<int>*        m_pars;         //!< Gradient parameter indices (optional)
+    std::vector<double>*           m_values;       //!< Recorded values (optional)
 };
 
 
@@ -1355,4 +1398,66 @@ protected:
     const double&        m_cos_delta; //!< cos(delta)
 };
 
+
+/***********************************************************************//**
+ * @class cta_psf_diffuse_kern_map
+ *
+ * @brief Kernel for Psf convolution of diffuse maps used for stacked analysis
+ *
+ * The kernel is the weighted mean of the Psf cube at a set of true photon
+ * arrival directions. The weights need to be normalised to unity.
+ ***************************************************************************/
+class cta_psf_diffuse_kern_map : public GFunction {
+public:
+    cta_psf_diffuse_kern_map(const GCTAResponseCube*     rsp,
+                             const std::vector<GSkyDir>& srcDirs,
+                             const std::vector<double>&  weights,
+                             const GEnergy&              srcEng) :
+                             m_rsp(rsp),
+                             m_srcDirs(srcDirs),
+                             m_weights(weights),
+                             m_srcEng(srcEng) { }
+    double eval(const double& delta);
+protected:
+    const GCTAResponseCube*     m_rsp;     //!< Response cube
+    const std::vector<GSkyDir>& m_srcDirs; //!< True photon arrival directions
+    const std::vector<double>&  m_weights; //!< Normalised weights
+    const GEnergy&              m_srcEng;  //!< True photon energy
+};
+
+
+/***********************************************************************//**
+ * @class cta_kern_replay
+ *
+ * @brief Kernel that replays recorded integrand values
+ *
+ * This class implements a kernel that returns previously recorded integrand
+ * values in the order in which they were recorded. The recorded values are
+ * stored in a vector with @p stride values per function call, and the
+ * kernel returns the value at position @p offset of each call.
+ *
+ * As the Romberg integration with a fixed number of iterations always
+ * evaluates the same sequence of abscissa for identical integration
+ * boundaries, an integral over the same boundaries as the recording
+ * integral yields the integral of the replayed component. This allows the
+ * computation of several integrals, such as the gradients with respect to
+ * model parameters, from a single set of IRF evaluations.
+ ***************************************************************************/
+class cta_kern_replay : public GFunction {
+public:
+    cta_kern_replay(const std::vector<double>& values,
+                    const int&                 stride,
+                    const int&                 offset) :
+                    m_values(values),
+                    m_stride(stride),
+                    m_offset(offset),
+                    m_next(0) { }
+    double eval(const double& x);
+protected:
+    const std::vector<double>& m_values; //!< Recorded values
+    int                        m_stride; //!< Number of values per call
+    int                        m_offset; //!< Offset of replayed value
+    int                        m_next;   //!< Index of next call
+};
+
 #endif /* GCTARESPONSE_HELPERS_HPP */
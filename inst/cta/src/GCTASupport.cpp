@@ -38,6 +38,12 @@
 #include "GEbounds.hpp"
 #include "GCTARoi.hpp"
 #include "GCTAInstDir.hpp"
+#include "GSkymap.hpp"
+
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Method name definitions ____________________________________________ */
 #define G_READ_DS_ROI                      "gammalib::read_ds_roi(GFitsHDU&)"
@@ -255,3 +261,90 @@ GEbounds gammalib::read_ds_ebounds(const GFitsHDU& hdu)
     // Return
     return ebounds;
 }
+
+
+/***********************************************************************//**
+ * @brief Return number of threads for filling a cube
+ *
+ * @param[in] nitems Number of work items.
+ * @return Number of threads.
+ *
+ * Returns the number of threads that should be used for filling a cube
+ * from @p nitems independent work items. The number of threads does not
+ * exceed the number of work items, and is one if OpenMP is not available
+ * or if the method is called from within a parallel region.
+ ***************************************************************************/
+int gammalib::cta_fill_threads(const int& nitems)
+{
+    // Initialise number of threads
+    int nthreads = 1;
+
+    // Use as many threads as possible if we are not yet within a parallel
+    // region
+    #ifdef _OPENMP
+    if (!omp_in_parallel()) {
+        nthreads = (nitems < omp_get_max_threads()) ? nitems
+                                                    : omp_get_max_threads();
+        if (nthreads < 1) {
+            nthreads = 1;
+        }
+    }
+    #endif
+
+    // Return number of threads
+    return nthreads;
+}
+
+
+/***********************************************************************//**
+ * @brief Sum sky maps
+ *
+ * @param[in] maps Sky maps.
+ *
+ * Adds all sky maps to the first sky map. The maps are added pairwise in a
+ * binary tree, where the additions of each tree level are done in
+ * parallel, so that the time for summing n maps grows only as log2(n).
+ * All sky maps need to have the same pixelisation and number of maps.
+ ***************************************************************************/
+void gammalib::cta_reduce_maps(const std::vector<GSkymap*>& maps)
+{
+    // Get number of maps
+    int n = maps.size();
+
+    // Add pairs of maps for all tree levels
+    for (int step = 1; step < n; step *= 2) {
+        #pragma omp parallel for
+        for (int k = 0; k < n - step; k += 2*step) {
+            *maps[k] += *maps[k+step];
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return unique identifier for response parameter caches
+ *
+ * @return Unique identifier.
+ *
+ * Returns a new identifier at each call. Response components that keep
+ * their parameter cache per thread use this identifier to recognise
+ * whether the cache of a thread has been filled by themselves.
+ ***************************************************************************/
+int gammalib::cta_cache_id(void)
+{
+    // Last identifier
+    static int last_id = 0;
+
+    // Get new identifier
+    int id;
+    #pragma omp critical(gammalib_cta_cache_id)
+    {
+        id = ++last_id;
+    }
+
+    // Return identifier
+    return id;
+}
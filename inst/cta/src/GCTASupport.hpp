@@ -28,6 +28,7 @@
 #define GCTASUPPORT_HPP
 
 /* __ Includes ___________________________________________________________ */
+#include <vector>
 
 /* __ Namespaces _________________________________________________________ */
 
@@ -37,6 +38,7 @@
 class GFitsHDU;
 class GCTARoi;
 class GEbounds;
+class GSkymap;
 
 /* __ Prototypes _________________________________________________________ */
 namespace gammalib {
@@ -45,6 +47,9 @@ namespace gammalib {
                                const double& roi,     const double& cosroi);
     GCTARoi  read_ds_roi(const GFitsHDU& hdu);
     GEbounds read_ds_ebounds(const GFitsHDU& hdu);
+    int      cta_fill_threads(const int& nitems);
+    void     cta_reduce_maps(const std::vector<GSkymap*>& maps);
+    int      cta_cache_id(void);
 }
 
 #endif /* GCTASUPPORT_HPP */
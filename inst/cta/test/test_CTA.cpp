@@ -30,6 +30,7 @@
 #endif
 #include <stdlib.h>
 #include <iostream>
+#include <fstream>
 #include <cmath>
 #include <unistd.h>
 #include "GCTALib.hpp"
@@ -40,6 +41,9 @@
 #include "GCTAEdispPerfTable.hpp"
 #include "GCTAResponseTable.hpp"
 #include "GMath.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Namespaces _________________________________________________________ */
 
@@ -87,10 +91,12 @@ void TestGCTAResponse::set(void)
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_edisp_RMF), "Test energy dispersion RMF computation");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_edisp_2D), "Test energy dispersion 2D computation");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_diffuse), "Test diffuse IRF");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_gradients), "Test IRF gradients");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npred_diffuse), "Test diffuse IRF integration");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_expcube), "Test exposure cube");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_psfcube), "Test PSF cube");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_bkgcube), "Test background cube");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_diffuse_cube), "Test diffuse cube source convolution");
 
     // Return
     return;
@@ -147,7 +153,9 @@ void TestGCTAObservation::set(void)
     name("GCTAObservation");
 
     // Append tests to test suite
+    append(static_cast<pfunction>(&TestGCTAObservation::test_event_list), "Test event list");
     append(static_cast<pfunction>(&TestGCTAObservation::test_unbinned_obs), "Test unbinned observations");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_unbinned_threads), "Test unbinned event-level parallelism");
     append(static_cast<pfunction>(&TestGCTAObservation::test_binned_obs), "Test binned observation");
     append(static_cast<pfunction>(&TestGCTAObservation::test_cube_obs), "Test cube-style observation");
 
@@ -743,6 +751,150 @@ void TestGCTAResponse::test_response_irf_diffuse(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test CTA IRF gradient computation
+ *
+ * Tests the spatial model parameter gradients that are computed by the
+ * GCTAResponseIrf::irf_gradients method by comparing them to numerical
+ * derivatives of the IRF, for all models for which the response computes
+ * gradients. The model gradients that are returned by GObservation::model
+ * are compared to the numerical gradients of GObservation::model_grad.
+ * For shell and elliptical disk models it is checked that no gradients
+ * are declared, so that numerical gradients are used.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_irf_gradients(void)
+{
+    // Setup response with offset dependent effective area
+    GCTAResponseIrf rsp;
+    rsp.aeff(new GCTAAeffPerfTable(cta_edisp_perf));
+    rsp.psf(new GCTAPsfPerfTable(cta_edisp_perf));
+    rsp.offset_sigma(3.0);
+
+    // Setup observation
+    GSkyDir pnt_dir;
+    pnt_dir.radec_deg(83.6, 22.0);
+    GCTAPointing pnt;
+    pnt.dir(pnt_dir);
+    GCTAObservation obs;
+    obs.pointing(pnt);
+    obs.response(rsp);
+
+    // Setup event
+    GSkyDir obs_dir;
+    obs_dir.radec_deg(83.9, 22.3);
+    GCTAEventAtom event;
+    event.dir(GCTAInstDir(obs_dir));
+    event.energy(GEnergy(1.0, "TeV"));
+
+    // Setup models
+    GSkyDir src_dir;
+    src_dir.radec_deg(83.93, 22.28);
+    std::vector<GModelSpatial*> models;
+    models.push_back(new GModelSpatialPointSource(src_dir));
+    models.push_back(new GModelSpatialRadialGauss(src_dir, 0.2));
+    models.push_back(new GModelSpatialRadialDisk(src_dir, 0.1));
+    models.push_back(new GModelSpatialEllipticalGauss(src_dir, 0.3, 0.1, 30.0));
+    int nmodels = models.size();
+
+    // Loop over models
+    for (int k = 0; k < nmodels; ++k) {
+
+        // Set source with all model parameters free
+        GModelSpatial& model = *(models[k]);
+        GSource        source("Test", &model, event.energy(), GTime());
+        for (int i = 0; i < model.size(); ++i) {
+            model[i].free();
+        }
+
+        // Check that the response computes the gradients
+        test_assert(rsp.has_irf_gradients(model), "Check that response "
+                    "computes gradients of "+model.type());
+        test_assert(!rsp.GResponse::has_irf_gradients(model), "Check that "
+                    "base class computes no gradients of "+model.type());
+
+        // Compute IRF and gradients and check IRF value
+        double irf = rsp.irf_gradients(event, source, obs);
+        test_value(irf, rsp.GResponse::irf(event, source, obs),
+                   1.0e-10 * irf, "Check IRF value of "+model.type());
+
+        // Check gradients against numerical derivatives
+        for (int i = 0; i < model.size(); ++i) {
+
+            // Get parameter and gradient
+            GModelPar& par   = model[i];
+            double     grad  = par.factor_gradient();
+            double     value = par.value();
+            double     h     = 1.0e-4;
+            bool       pos   = (par.name() == "RA" || par.name() == "DEC");
+
+            // Skip parameters without gradient, which are the positions
+            // of radial and elliptical models
+            if (!par.has_grad()) {
+                test_assert(model.code() != GMODEL_SPATIAL_POINT_SOURCE && pos,
+                            "Check that "+par.name()+" of "+model.type()+
+                            " has a gradient");
+                continue;
+            }
+
+            // Compute numerical derivative
+            par.value(value + h);
+            double irf_p = rsp.GResponse::irf(event, source, obs);
+            par.value(value - h);
+            double irf_m = rsp.GResponse::irf(event, source, obs);
+            par.value(value);
+            double num   = (irf_p - irf_m) / (2.0 * h) * par.scale();
+
+            // Check gradient
+            test_value(grad, num, 1.0e-4 * std::abs(num), "Check "+par.name()+
+                       " gradient of "+model.type());
+
+        } // endfor: looped over parameters
+
+        // Check that the model gradients agree with the numerical model
+        // gradients
+        GModelSky sky(model, GModelSpectralConst());
+        GModels   skymodels;
+        skymodels.append(sky);
+        GVector   gradient(skymodels.npars());
+        obs.model(skymodels, event, &gradient);
+        const GModel& skymodel = *(skymodels[0]);
+        for (int i = 0; i < model.size(); ++i) {
+            double num = obs.model_grad(skymodel, skymodel[i], event);
+            test_value(gradient[i], num, 1.0e-3 * std::abs(num) + 1.0e-10,
+                       "Check model "+skymodel[i].name()+" gradient of "+
+                       model.type());
+        }
+
+    } // endfor: looped over models
+
+    // Delete models
+    for (int k = 0; k < nmodels; ++k) {
+        delete models[k];
+    }
+
+    // Check that shell and elliptical disk models declare no gradients
+    // and that the response does not compute them
+    GModelSpatialRadialShell     shell(src_dir, 0.1, 0.05);
+    GModelSpatialEllipticalDisk  disk(src_dir, 0.3, 0.1, 30.0);
+    std::vector<GModelSpatial*>  numerical;
+    numerical.push_back(&shell);
+    numerical.push_back(&disk);
+    int nnumerical = numerical.size();
+    for (int k = 0; k < nnumerical; ++k) {
+        const GModelSpatial& model = *(numerical[k]);
+        test_assert(!rsp.has_irf_gradients(model), "Check that response "
+                    "computes no gradients of "+model.type());
+        for (int i = 0; i < model.size(); ++i) {
+            test_assert(!model[i].has_grad(), "Check that "+model[i].name()+
+                        " of "+model.type()+" has no gradient");
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test CTA Npred computation
  *
@@ -935,6 +1087,125 @@ void TestGCTAResponse::test_response_bkgcube(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test Psf convolution of diffuse cube source
+ *
+ * Compares the diffuse cube source computed by the Psf convolution of the
+ * model map to the diffuse cube source computed by numerical integration
+ * of the Psf for each pixel. Pixels with more than 1% of the maximum
+ * value of an energy layer are required to agree within 3%, which is
+ * dominated by the 1% precision of the numerical integration and by the
+ * variation of the Psf over the event cube that is neglected by the
+ * convolution. The convolution is requested through the
+ * GCTAResponseCube::psf_convolve() option. The Psf cube is restricted to offset angles of 0.3 deg so
+ * that the numerical integration resolves the Psf core.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_diffuse_cube(void)
+{
+    // Setup pointing
+    GSkyDir pntdir;
+    pntdir.radec_deg(83.63, 22.01);
+    GCTAPointing pnt;
+    pnt.dir(pntdir);
+
+    // Setup energy boundaries and time interval
+    GEbounds ebounds(3, GEnergy(0.5, "TeV"), GEnergy(5.0, "TeV"));
+    GGti     gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+
+    // Set response from performance table
+    GCTAResponseIrf irf;
+    irf.aeff(new GCTAAeffPerfTable(cta_edisp_perf));
+    irf.psf(new GCTAPsfPerfTable(cta_edisp_perf));
+
+    // Setup dummy unbinned observation for exposure and Psf cube
+    // computation
+    GCTAEventList list;
+    list.roi(GCTARoi(GCTAInstDir(pntdir), 5.0));
+    list.ebounds(ebounds);
+    list.gti(gti);
+    GCTAObservation run;
+    run.ontime(1800.0);
+    run.livetime(1600.0);
+    run.deadc(1600.0/1800.0);
+    run.response(irf);
+    run.events(list);
+    run.pointing(pnt);
+
+    // Setup response cube
+    GCTACubeExposure   exposure("CAR", "CEL", 83.63, 22.01, 0.1, 0.1, 40, 40, ebounds);
+    GCTACubePsf        psf("CAR", "CEL", 83.63, 22.01, 0.5, 0.5, 8, 8, ebounds, 0.3, 100);
+    GCTACubeBackground background;
+    exposure.set(run);
+    psf.set(run);
+
+    // Setup cube-style observation with an event cube around the pointing
+    GSkymap         map("CAR", "CEL", 83.63, 22.01, 0.05, 0.05, 30, 30, ebounds.size());
+    GCTAEventCube   cube(map, ebounds, gti);
+    GCTAObservation obs;
+    obs.events(cube);
+    obs.response(exposure, psf, background);
+    obs.pointing(pnt);
+
+    // Setup diffuse model with a Gaussian blob that is offset from the
+    // event cube centre
+    GSkymap model_map("CAR", "CEL", 83.63, 22.01, 0.02, 0.02, 150, 150);
+    GSkyDir blob;
+    blob.radec_deg(83.9, 22.2);
+    for (long long i = 0; i < model_map.npix(); ++i) {
+        double theta = model_map.inx2dir(i).dist_deg(blob);
+        model_map(i) = std::exp(-0.5 * theta * theta / (0.2 * 0.2));
+    }
+    GModelSpatialDiffuseMap model(model_map);
+
+    // Setup same observation with a response cube that requests the Psf
+    // convolution of diffuse models
+    GCTAResponseCube rsp(exposure, psf, background);
+    rsp.psf_convolve(true);
+    GCTAObservation obs_convolve = obs;
+    obs_convolve.response(rsp);
+    test_assert(!static_cast<const GCTAResponseCube*>(obs.response())->psf_convolve(),
+                "Check that Psf integration is the default");
+    test_assert(static_cast<const GCTAResponseCube*>(obs_convolve.response())->psf_convolve(),
+                "Check that Psf convolution is requested");
+
+    // Compute diffuse cube source by numerical Psf integration and by
+    // Psf convolution
+    GCTACubeSourceDiffuse integrated;
+    GCTACubeSourceDiffuse convolved;
+    integrated.set("Diffuse", model, obs);
+    convolved.set("Diffuse", model, obs_convolve);
+
+    // Compare both computations
+    for (int iebin = 0; iebin < ebounds.size(); ++iebin) {
+        double max = 0.0;
+        for (long long pixel = 0; pixel < map.npix(); ++pixel) {
+            if (integrated.irf(pixel, iebin) > max) {
+                max = integrated.irf(pixel, iebin);
+            }
+        }
+        double dev = 0.0;
+        for (long long pixel = 0; pixel < map.npix(); ++pixel) {
+            double ref = integrated.irf(pixel, iebin);
+            if (ref > 0.01 * max) {
+                double rel = std::abs(convolved.irf(pixel, iebin) / ref - 1.0);
+                if (rel > dev) {
+                    dev = rel;
+                }
+            }
+        }
+        test_assert(max > 0.0, "Check diffuse cube source in energy bin "+
+                    gammalib::str(iebin));
+        test_assert(dev < 0.03, "Check Psf convolution in energy bin "+
+                    gammalib::str(iebin)+" (relative deviation "+
+                    gammalib::str(dev)+")");
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Utility function for energy dispersion tests
  *
@@ -1195,6 +1466,313 @@ void TestGCTAModel::test_model_irf_bgd(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test event list handling
+ *
+ * Tests appending, accessing, modifying and copying of events in a
+ * GCTAEventList.
+ ***************************************************************************/
+void TestGCTAObservation::test_event_list(void)
+{
+    // Build event list
+    GCTAEventList list;
+    for (int i = 0; i < 10; ++i) {
+        GCTAInstDir dir;
+        dir.dir().radec_deg(83.0 + 0.1 * i, 22.0 - 0.1 * i);
+        dir.detx(0.001 * i);
+        dir.dety(-0.001 * i);
+        GCTAEventAtom atom;
+        atom.dir(dir);
+        atom.energy(GEnergy(1.0 + i, "TeV"));
+        atom.time(GTime(100.0 * i));
+        atom.event_id(i+1);
+        list.append(atom);
+    }
+    test_value(list.size(), 10, "Check number of events");
+
+    // Check events
+    const GCTAEventList& clist = list;
+    for (int i = 0; i < 10; ++i) {
+        const GCTAEventAtom* atom = clist[i];
+        test_value(atom->index(), i, "Check event index");
+        test_value(atom->dir().dir().ra_deg(), 83.0 + 0.1 * i, 1.0e-10,
+                   "Check Right Ascension");
+        test_value(atom->dir().dir().dec_deg(), 22.0 - 0.1 * i, 1.0e-10,
+                   "Check Declination");
+        test_value(atom->dir().detx(), 0.001 * i, 1.0e-10, "Check DETX");
+        test_value(atom->dir().dety(), -0.001 * i, 1.0e-10, "Check DETY");
+        test_value(atom->energy().TeV(), 1.0 + i, 1.0e-10, "Check energy");
+        test_value(atom->time().secs(), 100.0 * i, 1.0e-10, "Check time");
+        test_value((int)atom->event_id(), i+1, "Check event identifier");
+        test_value(atom->phase(), 0.0, 1.0e-10, "Check phase");
+    }
+
+    // Check concurrent read access to the event list
+    int nbad = 0;
+    #pragma omp parallel for num_threads(4) reduction(+:nbad)
+    for (int k = 0; k < 10000; ++k) {
+        int                  i    = k % 10;
+        const GCTAEventAtom* atom = clist[i];
+        if (atom->index() != i ||
+            std::abs(atom->energy().TeV() - (1.0 + i)) > 1.0e-10 ||
+            std::abs(atom->time().secs() - 100.0 * i) > 1.0e-10) {
+            nbad++;
+        }
+    }
+    test_value(nbad, 0, "Check concurrent event access");
+
+    // Check that the const access operator returns the view of the
+    // calling thread, which is overwritten by the next access
+    const GCTAEventAtom* view1 = clist[1];
+    const GCTAEventAtom* view2 = clist[2];
+    test_assert(view1 == view2, "Check that thread view is reused");
+    test_value(view1->index(), 2, "Check that thread view was overwritten");
+
+    // Modify an event through the non-const access operator and check
+    // that the modification is visible before and after write back
+    list[3]->energy(GEnergy(42.0, "TeV"));
+    list[3]->phase(0.25);
+    test_value(clist[3]->energy().TeV(), 42.0, 1.0e-10,
+               "Check modified energy before write back");
+    test_value(list[5]->energy().TeV(), 6.0, 1.0e-10,
+               "Check unmodified energy");
+    test_value(clist[3]->energy().TeV(), 42.0, 1.0e-10,
+               "Check modified energy after write back");
+    test_value(clist[3]->phase(), 0.25, 1.0e-6,
+               "Check modified phase after write back");
+    test_value(clist[4]->phase(), 0.0, 1.0e-10,
+               "Check unmodified phase");
+
+    // Check that pointers returned by the non-const access operator alias
+    // the single write view
+    GCTAEventAtom* edit1 = list[1];
+    GCTAEventAtom* edit2 = list[2];
+    test_assert(edit1 == edit2, "Check that write view is shared");
+    test_value(edit1->index(), 2, "Check that write view was overwritten");
+
+    // Check that a pending modification survives copying
+    list[7]->event_id(99);
+    GCTAEventList copy(list);
+    test_value((int)copy[7]->event_id(), 99, "Check copied modification");
+    test_value(copy[3]->energy().TeV(), 42.0, 1.0e-10,
+               "Check copied energy");
+    test_value(copy[9]->dir().dir().ra_deg(), 83.9, 1.0e-10,
+               "Check copied Right Ascension");
+
+    // Check IRF cache
+    int id = gammalib::intern("Cached model");
+    test_value(list.irf_cache(id, 2), -1.0, 1.0e-10,
+               "Check IRF cache value of unknown model");
+    list.irf_cache("Cached model", 2, 3.5);
+    test_value(list.irf_cache(id, 2), 3.5, 1.0e-10,
+               "Check IRF cache value set by name");
+    test_value(list.irf_cache(id, 3), -1.0, 1.0e-10,
+               "Check IRF cache value that was not set");
+
+    // Fill IRF cache of several models from several threads
+    #pragma omp parallel for
+    for (int i = 0; i < 40; ++i) {
+        int model = gammalib::intern("Cached model "+gammalib::str(i % 4));
+        list.irf_cache(model, i / 4, double(i));
+    }
+    bool ok = true;
+    for (int i = 0; i < 40; ++i) {
+        int model = gammalib::intern("Cached model "+gammalib::str(i % 4));
+        if (list.irf_cache(model, i / 4) != double(i)) {
+            ok = false;
+        }
+    }
+    test_assert(ok, "Check IRF cache values set from several threads");
+
+    // Check that the IRF cache is copied
+    GCTAEventList copy_cache(list);
+    test_value(copy_cache.irf_cache("Cached model", 2), 3.5, 1.0e-10,
+               "Check copied IRF cache value");
+
+    // Check that streamed events are identical to loaded events
+    test_try("Stream events");
+    try {
+        GCTAEventList loaded(cta_events);
+        GCTAEventList streamed;
+        streamed.stream(cta_events, 1000);
+        test_assert(streamed.is_streamed(), "Check that events are streamed");
+        test_value(streamed.chunk_size(), 1000, "Check chunk size");
+        test_value(streamed.size(), loaded.size(), "Check number of events");
+        test_value(streamed.gti().size(), loaded.gti().size(),
+                   "Check number of GTIs");
+        const GCTAEventList& cloaded   = loaded;
+        const GCTAEventList& cstreamed = streamed;
+        bool same = true;
+        for (int i = 0; i < loaded.size(); ++i) {
+            const GCTAEventAtom* ref = cloaded[i];
+            const GCTAEventAtom* evt = cstreamed[i];
+            if (evt->index()       != i ||
+                evt->energy()      != ref->energy() ||
+                evt->time()        != ref->time() ||
+                evt->event_id()    != ref->event_id() ||
+                evt->dir().dir().dist(ref->dir().dir()) > 1.0e-10) {
+                same = false;
+            }
+        }
+        test_assert(same, "Check streamed events");
+        test_value(cstreamed[17]->energy().TeV(), cloaded[17]->energy().TeV(),
+                   1.0e-10, "Check energy after revisiting first chunk");
+        GCTAEventList copy_stream(streamed);
+        test_value(copy_stream.size(), loaded.size(),
+                   "Check number of events of copied streamed list");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that deferred reconstruction information is not read from an
+    // event file that was modified after loading
+    test_try("Modified event file");
+    try {
+        std::ifstream src(cta_events.c_str(), std::ios::binary);
+        std::ofstream dst("test_cta_events_modified.fits.gz", std::ios::binary);
+        dst << src.rdbuf();
+        dst.close();
+        GCTAEventList modified("test_cta_events_modified.fits.gz");
+        std::ofstream app("test_cta_events_modified.fits.gz",
+                          std::ios::binary | std::ios::app);
+        app << ' ';
+        app.close();
+        modified[0];
+        test_try_failure();
+    }
+    catch (GException::file_error &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that events streamed from a table in memory are identical to
+    // the events in memory, also when several threads read from their
+    // own chunks
+    test_try("Stream events from memory");
+    try {
+        // Set events table
+        const int           nevents = 1000;
+        GRan                ran;
+        GFitsTableULongCol  col_id("EVENT_ID", nevents);
+        GFitsTableDoubleCol col_time("TIME", nevents);
+        GFitsTableDoubleCol col_ra("RA", nevents);
+        GFitsTableDoubleCol col_dec("DEC", nevents);
+        GFitsTableDoubleCol col_detx("DETX", nevents);
+        GFitsTableDoubleCol col_dety("DETY", nevents);
+        GFitsTableDoubleCol col_energy("ENERGY", nevents);
+        for (int i = 0; i < nevents; ++i) {
+            col_id(i)     = i+1;
+            col_time(i)   = 1000.0 * ran.uniform();
+            col_ra(i)     = 83.0 + ran.uniform();
+            col_dec(i)    = 22.0 + ran.uniform();
+            col_detx(i)   = ran.uniform();
+            col_dety(i)   = ran.uniform();
+            col_energy(i) = 0.1 + 10.0 * ran.uniform();
+        }
+        GFitsBinTable table(nevents);
+        table.extname("EVENTS");
+        table.append(col_id);
+        table.append(col_time);
+        table.append(col_ra);
+        table.append(col_dec);
+        table.append(col_detx);
+        table.append(col_dety);
+        table.append(col_energy);
+        table.card("MJDREFI", 51544, "[days] Integer part of reference MJD");
+        table.card("MJDREFF", 0.5, "[days] Fractional part of reference MJD");
+        table.card("TSTART", 0.0, "[s] Start time");
+        table.card("TSTOP", 1000.0, "[s] Stop time");
+
+        // Stream events from table and check them sequentially
+        GCTAEventList streamed;
+        streamed.stream(table, 64);
+        test_assert(streamed.is_streamed(), "Check that events are streamed");
+        test_value(streamed.size(), nevents, "Check number of events");
+        const GCTAEventList& cstreamed = streamed;
+        int nbad = 0;
+        for (int i = 0; i < nevents; ++i) {
+            const GCTAEventAtom* evt = cstreamed[i];
+            if (evt->index()    != i ||
+                evt->event_id() != col_id(i) ||
+                std::abs(evt->energy().TeV() - col_energy(i)) > 1.0e-10 ||
+                std::abs(evt->time().convert(streamed.gti().reference()) -
+                         col_time(i)) > 1.0e-6 ||
+                std::abs(evt->dir().dir().ra_deg() - col_ra(i)) > 1.0e-10 ||
+                std::abs(evt->dir().dir().dec_deg() - col_dec(i)) > 1.0e-10) {
+                nbad++;
+            }
+        }
+        test_value(nbad, 0, "Check streamed events");
+
+        // Check concurrent access, each thread reading its own chunks
+        nbad = 0;
+        #pragma omp parallel for num_threads(4) reduction(+:nbad)
+        for (int k = 0; k < 4*nevents; ++k) {
+            int                  i   = (k * 7) % nevents;
+            const GCTAEventAtom* evt = cstreamed[i];
+            if (evt->index() != i || (int)evt->event_id() != i+1) {
+                nbad++;
+            }
+        }
+        test_value(nbad, 0, "Check concurrent access to streamed events");
+
+        // Check copy of streamed events
+        const GCTAEventList copy_stream(streamed);
+        test_value((int)copy_stream[nevents-1]->event_id(), nevents,
+                   "Check last event of copied streamed list");
+
+        // Check that IRF values are not cached for streamed events
+        streamed.irf_cache("Cached model", 2, 3.5);
+        test_value(streamed.irf_cache("Cached model", 2), -1.0, 1.0e-10,
+                   "Check that IRF values of streamed events are not cached");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that streamed events cannot be modified
+    test_try("Modify streamed events");
+    try {
+        GCTAEventList streamed;
+        streamed.stream(cta_events, 1000);
+        streamed.append(GCTAEventAtom());
+        test_try_failure("Appending to streamed events should throw "
+                         "an exception.");
+    }
+    catch (GException::invalid_value &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that an observation streams events if a chunk size is set
+    test_try("Stream observation events");
+    try {
+        GCTAObservation obs;
+        obs.chunk_size(500);
+        obs.load(cta_events);
+        const GCTAEventList* list =
+              dynamic_cast<const GCTAEventList*>(obs.events());
+        test_assert(list != NULL && list->is_streamed(),
+                    "Check that observation events are streamed");
+        test_value(list->chunk_size(), 500, "Check observation chunk size");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test unbinned observation handling
  ***************************************************************************/
@@ -1256,6 +1834,144 @@ void TestGCTAObservation::test_unbinned_obs(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test event-level parallelism for unbinned observation
+ *
+ * Evaluates the likelihood of an unbinned observation held in memory once
+ * with a single thread and once with several threads, and checks that the
+ * likelihood value, the gradient and the curvature matrix agree.
+ ***************************************************************************/
+void TestGCTAObservation::test_unbinned_threads(void)
+{
+    // Set pointing and region of interest
+    GSkyDir pnt_dir;
+    pnt_dir.radec_deg(83.63, 22.01);
+    GCTAPointing pnt(pnt_dir);
+    GCTARoi      roi(GCTAInstDir(pnt_dir), 3.0);
+
+    // Set response from performance table
+    GCTAResponseIrf rsp;
+    rsp.aeff(new GCTAAeffPerfTable(cta_edisp_perf));
+    rsp.psf(new GCTAPsfPerfTable(cta_edisp_perf));
+
+    // Set energy boundaries and good time intervals
+    GEbounds ebounds(GEnergy(0.1, "TeV"), GEnergy(100.0, "TeV"));
+    GGti     gti(GTime(0.0), GTime(1800.0));
+
+    // Create events around the pointing direction
+    GRan          ran;
+    GCTAEventList list;
+    list.roi(roi);
+    list.ebounds(ebounds);
+    list.gti(gti);
+    for (int i = 0; i < 2000; ++i) {
+        GSkyDir dir = pnt_dir;
+        dir.rotate_deg(360.0 * ran.uniform(), 2.5 * ran.uniform());
+        GCTAInstDir   instdir = pnt.instdir(dir);
+        GCTAEventAtom atom;
+        atom.dir(instdir);
+        atom.energy(GEnergy(0.1 * std::pow(100.0, ran.uniform()), "TeV"));
+        atom.time(GTime(1800.0 * ran.uniform()));
+        list.append(atom);
+    }
+
+    // Set observation
+    GCTAObservation obs;
+    obs.pointing(pnt);
+    obs.response(rsp);
+    obs.events(list);
+    obs.ontime(1800.0);
+    obs.livetime(1700.0);
+    obs.deadc(1700.0/1800.0);
+    test_assert(obs.is_threadsafe(),
+                "Check that unbinned observation is thread safe");
+
+    // Set source model with free position and background model
+    GSkyDir src_dir;
+    src_dir.radec_deg(83.6331, 22.0145);
+    GModelSky source(GModelSpatialPointSource(src_dir),
+                     GModelSpectralPlaw(5.7e-16, -2.48, GEnergy(0.3, "TeV")));
+    source.name("Crab");
+    source["RA"].free();
+    source["DEC"].free();
+    GCTAModelRadialAcceptance background(GCTAModelRadialGauss(3.0),
+                          GModelSpectralPlaw(6.1e-4, -1.83, GEnergy(1.0, "TeV")));
+    background.name("Background");
+    GModels models;
+    models.append(source);
+    models.append(background);
+
+    // Evaluate likelihood with one and with several threads
+    int           npars = models.npars();
+    GVector       grad1(npars);
+    GVector       grad4(npars);
+    GMatrixSparse curv1(npars,npars);
+    GMatrixSparse curv4(npars,npars);
+    double        npred1 = 0.0;
+    double        npred4 = 0.0;
+    #ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    #endif
+    double value1 = obs.likelihood(models, &grad1, &curv1, &npred1);
+    #ifdef _OPENMP
+    omp_set_num_threads(4);
+    #endif
+    double value4 = obs.likelihood(models, &grad4, &curv4, &npred4);
+    #ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+    #endif
+
+    // Check results
+    test_value(value4, value1, 1.0e-6, "Check likelihood value");
+    test_value(npred4, npred1, 1.0e-6, "Check Npred");
+    for (int i = 0; i < npars; ++i) {
+        test_value(grad4[i], grad1[i], 1.0e-6*(1.0+std::abs(grad1[i])),
+                   "Check gradient");
+        for (int j = 0; j < npars; ++j) {
+            test_value(curv4(i,j), curv1(i,j),
+                       1.0e-6*(1.0+std::abs(curv1(i,j))),
+                       "Check curvature");
+        }
+    }
+
+    // Set container with fewer observations than threads, so that the
+    // events of each observation are distributed over the threads
+    GObservations obss;
+    obs.id("1");
+    obss.append(obs);
+    obs.id("2");
+    obss.append(obs);
+    obss.models(models);
+
+    // Evaluate likelihood of container with four threads
+    #ifdef _OPENMP
+    omp_set_num_threads(4);
+    #endif
+    GObservations::likelihood likelihood(&obss);
+    likelihood.eval(models.pars());
+    #ifdef _OPENMP
+    omp_set_num_threads(nthreads);
+    #endif
+
+    // Check results
+    test_value(likelihood.value(), 2.0*value1, 1.0e-6,
+               "Check likelihood value of observation container");
+    test_value(likelihood.npred(), 2.0*npred1, 1.0e-6,
+               "Check Npred of observation container");
+    for (int i = 0; i < npars; ++i) {
+        for (int j = 0; j < npars; ++j) {
+            test_value((*likelihood.curvature())(i,j), 2.0*curv1(i,j),
+                       1.0e-6*(1.0+std::abs(2.0*curv1(i,j))),
+                       "Check curvature of observation container");
+        }
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test binned observation handling
  ***************************************************************************/
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include "GammaLib.hpp"
+#include "GCTALib.hpp"
 
 
 /***********************************************************************//**
@@ -58,10 +59,12 @@ public:
     void                      test_response_edisp_RMF(void);
     void                      test_response_edisp_2D(void);
     void                      test_response_irf_diffuse(void);
+    void                      test_response_irf_gradients(void);
     void                      test_response_npred_diffuse(void);
     void                      test_response_expcube(void);
     void                      test_response_psfcube(void);
     void                      test_response_bkgcube(void);
+    void                      test_response_diffuse_cube(void);
 
     // Utility methods
     void test_response_edisp_integration(const GCTAResponseIrf& rsp,
@@ -112,7 +115,9 @@ public:
     virtual void                 set(void);
     virtual TestGCTAObservation* clone(void) const;
     virtual std::string          classname(void) const { return "TestGCTAObservation"; }
+    void                         test_event_list(void);
     void                         test_unbinned_obs(void);
+    void                         test_unbinned_threads(void);
     void                         test_binned_obs(void);
     void                         test_cube_obs(void);
 };
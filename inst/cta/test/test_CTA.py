@@ -53,6 +53,7 @@ class Test(GPythonTestSuite):
         self.append(self.test_psf, "Test CTA PSF classes")
         self.append(self.test_edisp, "Test CTA energy dispersion classes")
         self.append(self.test_response, "Test CTA response classes")
+        self.append(self.test_eventlist, "Test CTA event list classes")
         self.append(self.test_onoff, "Test CTA ON/OFF analysis")
 
         # Return
@@ -276,6 +277,39 @@ class Test(GPythonTestSuite):
         return
 
 
+    # Test event list
+    def test_eventlist(self):
+        """
+        Test GCTAEventList class.
+        """
+        # Setup event list with two events
+        events = GCTAEventList()
+        event  = GCTAEventAtom()
+        event.energy(GEnergy(1.0, "TeV"))
+        events.append(event)
+        event.energy(GEnergy(2.0, "TeV"))
+        events.append(event)
+
+        # Check that events are returned as copies
+        a = events[0]
+        b = events[1]
+        self.test_value(a.energy().TeV(), 1.0, 1.0e-10,
+                        "Check energy of first event")
+        self.test_value(b.energy().TeV(), 2.0, 1.0e-10,
+                        "Check energy of second event")
+
+        # Check that modifying a copy does not modify the event list and
+        # that events are modified by assignment
+        a.energy(GEnergy(3.0, "TeV"))
+        self.test_value(events[0].energy().TeV(), 1.0, 1.0e-10,
+                        "Check that copy does not modify event list")
+        events[0] = a
+        self.test_value(events[0].energy().TeV(), 3.0, 1.0e-10,
+                        "Check event assignment")
+
+        # Return
+        return
+
     # Test ON/OFF analysis
     def test_onoff(self):
         """
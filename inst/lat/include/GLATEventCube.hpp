@@ -250,11 +250,14 @@ int GLATEventCube::ny(void) const
  * @brief Return number of pixels in event cube sky map
  *
  * @return Number of pixels in event cube sky map.
+ *
+ * The number of bins of an event cube is limited to the int range (see
+ * set_directions()), hence the number of pixels is returned as int.
  ***************************************************************************/
 inline
 int GLATEventCube::npix(void) const
 {
-    return m_map.npix();
+    return int(m_map.npix());
 }
 
 
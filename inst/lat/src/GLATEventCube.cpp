@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <climits>
 #include "GLATEventCube.hpp"
 #include "GLATException.hpp"
 #include "GTools.hpp"
@@ -240,7 +241,7 @@ GLATEventCube* GLATEventCube::clone(void) const
 int GLATEventCube::size(void) const
 {
     // Compute number of bins
-    int nbins = m_map.npix() * m_map.nmaps(); 
+    int nbins = int(m_map.npix() * m_map.nmaps());
 
     // Return number of bins
     return nbins;
@@ -292,7 +293,7 @@ int GLATEventCube::naxis(const int& axis) const
         naxis = m_map.ny();
         break;
     case 2:
-        naxis = m_map.npix();
+        naxis = int(m_map.npix());
         break;
     }
 
@@ -853,6 +854,8 @@ void GLATEventCube::read_gti(const GFitsTable& hdu)
  *
  * @exception GLATException::no_sky
  *            No sky pixels found in event cube.
+ * @exception GException::invalid_value
+ *            Number of event cube bins exceeds the int range.
  *
  * This method computes the sky directions and solid angles for all event
  * cube pixels. Sky directions are stored in an array of GLATInstDir objects
@@ -860,6 +863,15 @@ void GLATEventCube::read_gti(const GFitsTable& hdu)
  ***************************************************************************/
 void GLATEventCube::set_directions(void)
 {
+    // Throw an error if the event cube has more bins than can be indexed
+    if (m_map.npix() * m_map.nmaps() > INT_MAX) {
+        std::string msg = "Sky map with "+gammalib::str(m_map.npix())+
+                          " pixels and "+gammalib::str(m_map.nmaps())+
+                          " maps exceeds the maximum number of "+
+                          gammalib::str(INT_MAX)+" LAT event cube bins.";
+        throw GException::invalid_value(G_SET_DIRECTIONS, msg);
+    }
+
     // Throw an error if we have no sky pixels
     if (npix() < 1) {
         throw GLATException::no_sky(G_SET_DIRECTIONS, "Every LAT event cube"
@@ -334,7 +334,7 @@ void TestGLATLtCube::test_one_ltcube(const std::string& datadir, const double& r
         GSkymap map("GAL", 64, "RING", 1);
         GLATLtCube ltcube(lat_ltcube);
         GEnergy energy;
-        for (int i = 0; i < map.npix(); ++i) {
+        for (long long i = 0; i < map.npix(); ++i) {
             GSkyDir dir = map.inx2dir(i);
             map(i) = ltcube(dir, energy, test_fct1);
         }
@@ -351,7 +351,7 @@ void TestGLATLtCube::test_one_ltcube(const std::string& datadir, const double& r
         GSkymap map("GAL", 64, "RING", 1);
         GLATLtCube ltcube(lat_ltcube);
         GEnergy energy;
-        for (int i = 0; i < map.npix(); ++i) {
+        for (long long i = 0; i < map.npix(); ++i) {
             GSkyDir dir = map.inx2dir(i);
             map(i) = ltcube(dir, energy, test_fct2);
         }
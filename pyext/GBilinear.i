@@ -49,10 +49,10 @@ public:
     void        clear(void);
     GBilinear*  clone(void) const;
     std::string classname(void) const;
-    int&        index1(void);
-    int&        index2(void);
-    int&        index3(void);
-    int&        index4(void);
+    long long&  index1(void);
+    long long&  index2(void);
+    long long&  index3(void);
+    long long&  index4(void);
     double&     weight1(void);
     double&     weight2(void);
     double&     weight3(void);
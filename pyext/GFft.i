@@ -0,0 +1,62 @@
+/***************************************************************************
+ *                GFft.i - Fast Fourier transformation class               *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFft.i
+ * @brief Fast Fourier transformation class definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GFft.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GFft
+ *
+ * @brief Fast Fourier transformation class
+ ***************************************************************************/
+class GFft : public GBase {
+public:
+    // Constructors and destructors
+    GFft(void);
+    explicit GFft(const int& n);
+    GFft(const GFft& fft);
+    virtual ~GFft(void);
+
+    // Methods
+    void        clear(void);
+    GFft*       clone(void) const;
+    std::string classname(void) const;
+    const int&  size(void) const;
+    void        set(const int& n);
+    static int  good_size(const int& n);
+};
+
+
+/***********************************************************************//**
+ * @brief GFft class extension
+ ***************************************************************************/
+%extend GFft {
+    GFft copy() {
+        return (*self);
+    }
+};
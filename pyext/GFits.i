@@ -43,6 +43,12 @@
 #include "GFitsAsciiTable.hpp"
 %}
 
+/* __ Prototypes ________________________________________________________ */
+namespace gammalib {
+    bool fits_mmap(void);
+    void fits_mmap(const bool& mmap);
+}
+
 
 /***********************************************************************//**
  * @class GFits
@@ -27,6 +27,8 @@
 /* Put headers and other declarations here that are needed for compilation */
 #include "GHealpix.hpp"
 %}
+%include "std_vector.i"
+%template(vectorll) std::vector<long long>;
 
 
 /***********************************************************************//**
@@ -60,10 +62,18 @@ public:
     virtual GBilinear   interpolator(const GSkyDir& dir) const;
 
     // Other methods
-    const int&   npix(void) const;
-    const int&   nside(void) const;
-    std::string  ordering(void) const;
-    void         ordering(const std::string& ordering);
+    const long long&       npix(void) const;
+    const int&             nside(void) const;
+    std::string            ordering(void) const;
+    void                   ordering(const std::string& ordering);
+    std::vector<long long> query_disc(const GSkyDir& dir,
+                                      const double&  radius,
+                                      const bool&    inclusive = false) const;
+    std::vector<long long> query_strip(const double& bmin,
+                                       const double& bmax,
+                                       const bool&   inclusive = false) const;
+    std::vector<long long> query_polygon(const std::vector<GSkyDir>& vertices,
+                                         const bool& inclusive = false) const;
 };
 
 
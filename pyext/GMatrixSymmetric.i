@@ -85,6 +85,8 @@ public:
     GMatrix          extract_upper_triangle(void) const;
     GMatrixSymmetric cholesky_decompose(bool compress = true) const;
     GVector          cholesky_solver(const GVector& vector, bool compress = true) const;
+    GMatrix          cholesky_solver(const GMatrix& matrix, bool compress = true) const;
+    GVector          cholesky_inverse_diagonal(bool compress = true) const;
     GMatrixSymmetric cholesky_invert(bool compress = true) const;
 };
 
@@ -65,6 +65,7 @@ public:
     bool                has_par(const std::string& name) const;
     const std::string&  name(void) const;
     void                name(const std::string& name);
+    const int&          name_id(void) const;
     std::string         instruments(void) const;
     void                instruments(const std::string& instruments);
     const double&       ts(void) const;
@@ -66,7 +66,7 @@ public:
 
     // Other methods
     int                        maps(void) const;
-    int                        pixels(void) const;
+    long long                  pixels(void) const;
     void                       load(const std::string& filename);
     double                     value(void) const;
     void                       value(const double& value);
@@ -76,6 +76,7 @@ public:
                                         const GEvent&    event) const;
     virtual double           npred_grad(const GModel&    model,
                                         const GModelPar& par) const;
+    virtual bool             is_threadsafe(void) const;
 
     // Implemented methods
     void               name(const std::string& name);
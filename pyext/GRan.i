@@ -51,6 +51,7 @@ public:
     std::string            classname(void) const;
     void                   seed(unsigned long long int seed);
     unsigned long long int seed(void) const;
+    GRan                   substream(const unsigned long long int& index) const;
     unsigned long int      int32(void);
     unsigned long long int int64(void);
     double                 uniform(void);
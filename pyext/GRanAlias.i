@@ -0,0 +1,64 @@
+/***************************************************************************
+ *            GRanAlias.i - Alias table random sampler class               *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GRanAlias.i
+ * @brief Alias table random sampler class definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GRanAlias.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GRanAlias
+ *
+ * @brief Alias table random sampler class
+ ***************************************************************************/
+class GRanAlias : public GBase {
+public:
+    // Constructors and destructors
+    GRanAlias(void);
+    explicit GRanAlias(const std::vector<double>& weights);
+    GRanAlias(const GRanAlias& alias);
+    virtual ~GRanAlias(void);
+
+    // Methods
+    void          clear(void);
+    GRanAlias*    clone(void) const;
+    std::string   classname(void) const;
+    int           size(void) const;
+    bool          is_empty(void) const;
+    const double& total(void) const;
+    void          set(const std::vector<double>& weights);
+    int           draw(GRan& ran) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GRanAlias class extension
+ ***************************************************************************/
+%extend GRanAlias {
+    GRanAlias copy() {
+        return (*self);
+    }
+};
@@ -40,6 +40,7 @@ public:
     // Constructors and destructors
     GSkyPixel(void);
     GSkyPixel(const int& index);
+    GSkyPixel(const long long& index);
     GSkyPixel(const double& index);
     GSkyPixel(const int& x, const int& y);
     GSkyPixel(const double& x, const double& y);
@@ -27,6 +27,7 @@
 /* Put headers and other declarations here that are needed for compilation */
 #include "GSkymap.hpp"
 #include "GTools.hpp"
+#include "GFunction.hpp"
 %}
 
 
@@ -139,26 +140,33 @@ public:
     void                  clear(void);
     GSkymap*              clone(void) const;
     std::string           classname(void) const;
-    const int&            npix(void) const;
+    const long long&      npix(void) const;
     const int&            nx(void) const;
     const int&            ny(void) const;
     const int&            nmaps(void) const;
     void                  nmaps(const int& nmaps);
-    GSkyPixel             inx2pix(const int& index) const;
-    GSkyDir               inx2dir(const int& index) const;
+    GSkyPixel             inx2pix(const long long& index) const;
+    GSkyDir               inx2dir(const long long& index) const;
     GSkyDir               pix2dir(const GSkyPixel& pixel) const;
-    int                   pix2inx(const GSkyPixel& pixel) const;
-    int                   dir2inx(const GSkyDir& dir) const;
+    long long             pix2inx(const GSkyPixel& pixel) const;
+    long long             dir2inx(const GSkyDir& dir) const;
     GSkyPixel             dir2pix(const GSkyDir& dir) const;
-    double                solidangle(const int& index) const;
+    double                solidangle(const long long& index) const;
     double                solidangle(const GSkyPixel& pixel) const;
     bool                  contains(const GSkyDir& dir) const;
     bool                  contains(const GSkyPixel& pixel) const;
     const GSkyProjection* projection(void) const;
     void                  projection(const GSkyProjection& proj);
+    const bool&           pixel_cache(void) const;
+    void                  pixel_cache(const bool& cache);
     const double*         pixels(void) const;
     GSkymap               extract(const int& map, const int& nmaps = 1) const;
     void                  stack_maps(void);
+    void                  add(const GSkymap& map, const double& factor);
+    void                  scale(const std::vector<double>& factors);
+    void                  convolve(GFunction& kernel, const double& theta_max,
+                                   const int& map);
+    void                  convolve(GFunction& kernel, const double& theta_max);
     void                  load(const std::string& filename);
     void                  save(const std::string& filename, bool clobber = false) const;
     void                  read(const GFitsHDU& hdu);
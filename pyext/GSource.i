@@ -40,6 +40,8 @@ public:
     GSource(void);
     GSource(const std::string& name, GModelSpatial* model,
             const GEnergy& energy, const GTime& time);
+    GSource(const std::string& name, const int& name_id,
+            GModelSpatial* model, const GEnergy& energy, const GTime& time);
     GSource(const GSource& src);
     virtual ~GSource(void);
 
@@ -48,10 +50,12 @@ public:
     GSource*             clone(void) const;
     std::string          classname(void) const;
     const std::string&   name(void) const;
+    const int&           name_id(void) const;
     const GModelSpatial* model(void) const;
     const GEnergy&       energy(void) const;
     const GTime&         time(void) const;
     void                 name(const std::string& name);
+    void                 name_id(const int& id);
     void                 model(GModelSpatial* model);
     void                 energy(const GEnergy& energy);
     void                 time(const GTime& time);
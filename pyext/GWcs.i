@@ -69,6 +69,8 @@ public:
     double crval(const int& inx) const;
     double crpix(const int& inx) const;
     double cdelt(const int& inx) const;
+    double solidangle(const GSkyDir& dir1, const GSkyDir& dir2,
+                      const GSkyDir& dir3, const GSkyDir& dir4) const;
 };
 
 
@@ -48,5 +48,6 @@
 /* __ Numerics module ____________________________________________________ */
 %include "GDerivative.i"
 %include "GFunction.i"
+%include "GFft.i"
 %include "GIntegral.i"
 %include "GMath.i"
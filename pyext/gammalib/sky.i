@@ -43,6 +43,7 @@
 %import(module="gammalib.base") "GBase.i";
 %import(module="gammalib.base") "GContainer.i";
 %import(module="gammalib.base") "GRegistry.i";
+%import(module="gammalib.numerics") "GFunction.i";
 
 /* __ Make sure that exceptions are catched ______________________________ */
 %import(module="gammalib.support") "GException.i";
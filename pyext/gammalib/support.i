@@ -68,6 +68,7 @@
 %include "GBilinear.i"
 %include "GCsv.i"
 %include "GRan.i"
+%include "GRanAlias.i"
 %include "GUrl.i"
 %include "GUrlFile.i"
 %include "GUrlString.i"
@@ -29,6 +29,15 @@
 #include <config.h>
 #endif
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#if defined(HAVE_SYS_MMAN_H)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
 #include "GFits.hpp"
@@ -71,6 +80,22 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Prototypes of local functions ______________________________________ */
+static bool& fits_mmap_flag(void);
+static int  fits_mmap_tform(const char* tform, int* disktype, int* repeat);
+static bool fits_mmap_keyword(void* vptr, const char* keyname,
+                              const double& value);
+static bool fits_mmap_read(void* vptr, const int& disktype, const int& memtype,
+                           const long long& offset, const long long& stride,
+                           const int& number, const int& length, void* data);
+template <class D>
+static bool fits_mmap_decode(const unsigned char* src, const int& memtype,
+                             const long long& stride, const int& number,
+                             const int& length, void* data);
+template <class D, class M>
+static bool fits_mmap_decode(const unsigned char* src, const long long& stride,
+                             const int& number, const int& length, M* dst);
+
 
 /*==========================================================================
  =                                                                         =
@@ -1632,3 +1657,628 @@ int gammalib::fits_move_to_hdu(const std::string& caller, void* vptr,
     // Return HDU type
     return type;
 }
+
+
+/***********************************************************************//**
+ * @brief Signals whether FITS data are read through memory mappings
+ *
+ * @return True if memory mapped reading is enabled.
+ *
+ * See fits_mmap(const bool&).
+ ***************************************************************************/
+bool gammalib::fits_mmap(void)
+{
+    // Return flag
+    return (fits_mmap_flag());
+}
+
+
+/***********************************************************************//**
+ * @brief Enable or disable reading of FITS data through memory mappings
+ *
+ * @param[in] mmap Read FITS data through memory mappings?
+ *
+ * By default, all binary table columns and images are read using cfitsio.
+ * If memory mapped reading is enabled, fixed-width columns and images are
+ * instead decoded from a read-only memory mapping of the FITS file where
+ * possible (see fits_mmap_column() and fits_mmap_image()). This bypasses
+ * the cfitsio I/O buffers, but the data are still decoded into the buffers
+ * of the column or image, so memory usage does not change.
+ *
+ * The setting applies to all FITS files of the process. It should be set
+ * before any FITS data are read and not be changed while other threads
+ * read FITS files.
+ ***************************************************************************/
+void gammalib::fits_mmap(const bool& mmap)
+{
+    // Set flag
+    fits_mmap_flag() = mmap;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read binary table column cells through a read-only memory mapping
+ *
+ * @param[in] vptr FITS file void pointer.
+ * @param[in] colnum Column number (starting from 1).
+ * @param[in] type Datatype of the storage.
+ * @param[in] row Index of first row (starting from 0).
+ * @param[in] nrows Number of rows.
+ * @param[in] number Number of elements per row.
+ * @param[out] data Storage (number*nrows elements).
+ * @return True if the cells were read, false otherwise.
+ *
+ * Decodes the big-endian cells of rows [@p row, @p row + @p nrows[ of a
+ * fixed-width binary table column directly from a read-only mapping of
+ * the FITS file, bypassing the cfitsio I/O buffers. Only the pages that
+ * cover the requested rows are mapped. The FITS file pointer needs to be
+ * positioned at the table HDU.
+ *
+ * The column layout is determined from the NAXIS1 and TFORMn keywords, and
+ * the location of the data unit is obtained from cfitsio. Only columns
+ * without TSCALn/TZEROn scaling of plain disk files are read. The caller
+ * is responsible for not requesting a NULL value check. If memory mapped
+ * reading was not enabled using fits_mmap() or if the cells cannot be
+ * read, the method returns false and the caller should fall back to
+ * cfitsio.
+ ***************************************************************************/
+bool gammalib::fits_mmap_column(void* vptr, const int& colnum,
+                                const int& type, const int& row,
+                                const int& nrows, const int& number,
+                                void* data)
+{
+    // Initialise result
+    bool loaded = false;
+
+    // Continue only for a binary table HDU with a valid column if memory
+    // mapped reading was enabled
+    int status  = 0;
+    int hdutype = -1;
+    if (fits_mmap_flag()) {
+        status = __ffghdt(FPTR(vptr), &hdutype, &status);
+    }
+    if (status == 0 && hdutype == GFitsHDU::HT_BIN_TABLE &&
+        colnum > 0 && row >= 0) {
+
+        // Get row length
+        char      keyname[10];
+        long long naxis1 = 0;
+        std::sprintf(keyname, "NAXIS1");
+        status = __ffgky(FPTR(vptr), __TLONGLONG, keyname, &naxis1, NULL,
+                         &status);
+
+        // Get byte offset of column within a row, on-disk datatype and
+        // number of elements from the TFORMn keywords
+        long long offset   = 0;
+        int       disktype = __TNULL;
+        int       repeat   = 0;
+        for (int i = 1; i <= colnum && status == 0; ++i) {
+            char tform[__FLEN_FILENAME];
+            tform[0] = '\0';
+            std::sprintf(keyname, "TFORM%d", i);
+            status = __ffgky(FPTR(vptr), __TSTRING, keyname, tform, NULL,
+                             &status);
+            int bytes = fits_mmap_tform(tform, &disktype, &repeat);
+            if (bytes < 0) {
+                disktype = __TNULL;
+                break;
+            }
+            if (i < colnum) {
+                offset += bytes;
+            }
+        }
+
+        // Continue only for unscaled columns with the expected number of
+        // elements
+        char tscal[10];
+        char tzero[10];
+        std::sprintf(tscal, "TSCAL%d", colnum);
+        std::sprintf(tzero, "TZERO%d", colnum);
+        if (status == 0 && disktype != __TNULL && repeat == number &&
+            fits_mmap_keyword(vptr, tscal, 1.0) &&
+            fits_mmap_keyword(vptr, tzero, 0.0)) {
+
+            // Read cells
+            loaded = fits_mmap_read(vptr, disktype, type,
+                                    offset + (long long)row * naxis1, naxis1,
+                                    number, nrows, data);
+
+        } // endif: column was not scaled
+
+    } // endif: HDU was binary table
+
+    // Return result
+    return loaded;
+}
+
+
+/***********************************************************************//**
+ * @brief Read image pixels through a read-only memory mapping
+ *
+ * @param[in] vptr FITS file void pointer.
+ * @param[in] bitpix Number of bits per pixel (BITPIX).
+ * @param[in] type Datatype of the pixel storage.
+ * @param[in] npixels Number of pixels.
+ * @param[out] data Pixel storage (npixels elements).
+ * @return True if the pixels were read, false otherwise.
+ *
+ * Decodes the big-endian pixels of an uncompressed image directly from a
+ * read-only mapping of the FITS file. The FITS file pointer needs to be
+ * positioned at the image HDU. The caller is responsible for checking that
+ * no BSCALE/BZERO scaling and no NULL value check applies. If memory mapped
+ * reading was not enabled using fits_mmap() or if the pixels cannot be
+ * read, the method returns false and the caller should fall back to
+ * cfitsio.
+ ***************************************************************************/
+bool gammalib::fits_mmap_image(void* vptr, const int& bitpix,
+                               const int& type, const int& npixels,
+                               void* data)
+{
+    // Initialise result
+    bool loaded = false;
+
+    // Continue only for an uncompressed image HDU if memory mapped reading
+    // was enabled
+    int status  = 0;
+    int hdutype = -1;
+    if (fits_mmap_flag()) {
+        status = __ffghdt(FPTR(vptr), &hdutype, &status);
+    }
+    if (status == 0 && hdutype == GFitsHDU::HT_IMAGE &&
+        __fficmp(FPTR(vptr), &status) == 0 && status == 0) {
+
+        // Determine on-disk datatype from BITPIX
+        int disktype = __TNULL;
+        switch (bitpix) {
+        case 8:
+            disktype = __TBYTE;
+            break;
+        case 16:
+            disktype = __TSHORT;
+            break;
+        case 32:
+            disktype = __TLONG;
+            break;
+        case 64:
+            disktype = __TLONGLONG;
+            break;
+        case -32:
+            disktype = __TFLOAT;
+            break;
+        case -64:
+            disktype = __TDOUBLE;
+            break;
+        default:
+            break;
+        }
+
+        // Read pixels as a single row
+        loaded = fits_mmap_read(vptr, disktype, type, 0, 0, npixels, 1, data);
+
+    } // endif: HDU was uncompressed image
+
+    // Return result
+    return loaded;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Local functions                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Return memory mapped reading flag
+ *
+ * @return Reference to memory mapped reading flag.
+ ***************************************************************************/
+static bool& fits_mmap_flag(void)
+{
+    static bool flag = false;
+    return flag;
+}
+
+
+/***********************************************************************//**
+ * @brief Decode binary table TFORMn value
+ *
+ * @param[in] tform TFORMn value.
+ * @param[out] disktype On-disk datatype (__TNULL if not decodable).
+ * @param[out] repeat Number of elements.
+ * @return Width of column in bytes (-1 if format is unknown).
+ *
+ * Decodes the TFORMn value of a binary table column. The returned width
+ * includes all elements of the column and is the size of the descriptor
+ * for variable-length columns. Only columns of numerical types have an
+ * on-disk datatype that can be decoded from a memory mapping.
+ ***************************************************************************/
+static int fits_mmap_tform(const char* tform, int* disktype, int* repeat)
+{
+    // Skip leading blanks
+    while (*tform == ' ') {
+        tform++;
+    }
+
+    // Get repeat count (defaults to 1)
+    char* end = NULL;
+    *repeat   = (*tform >= '0' && *tform <= '9')
+                ? (int)std::strtol(tform, &end, 10) : 1;
+    if (end != NULL) {
+        tform = end;
+    }
+
+    // Get on-disk datatype and width
+    int width = -1;
+    *disktype = __TNULL;
+    switch (*tform) {
+    case 'L':
+    case 'A':
+        width = *repeat;
+        break;
+    case 'X':
+        width = (*repeat + 7) / 8;
+        break;
+    case 'B':
+        *disktype = __TBYTE;
+        width     = *repeat;
+        break;
+    case 'I':
+        *disktype = __TSHORT;
+        width     = 2 * *repeat;
+        break;
+    case 'J':
+        *disktype = __TLONG;
+        width     = 4 * *repeat;
+        break;
+    case 'K':
+        *disktype = __TLONGLONG;
+        width     = 8 * *repeat;
+        break;
+    case 'E':
+        *disktype = __TFLOAT;
+        width     = 4 * *repeat;
+        break;
+    case 'D':
+        *disktype = __TDOUBLE;
+        width     = 8 * *repeat;
+        break;
+    case 'C':
+    case 'P':
+        width = 8 * *repeat;
+        break;
+    case 'M':
+    case 'Q':
+        width = 16 * *repeat;
+        break;
+    default:
+        break;
+    }
+
+    // Return width
+    return width;
+}
+
+
+/***********************************************************************//**
+ * @brief Check that a keyword is absent or has a given value
+ *
+ * @param[in] vptr FITS file void pointer.
+ * @param[in] keyname Keyword name.
+ * @param[in] value Expected value.
+ * @return True if keyword is absent or has the expected value.
+ ***************************************************************************/
+static bool fits_mmap_keyword(void* vptr, const char* keyname,
+                              const double& value)
+{
+    // Get keyword value
+    char   name[10];
+    int    status = 0;
+    double actual = value;
+    std::strncpy(name, keyname, 9);
+    name[9] = '\0';
+    status  = __ffgky(FPTR(vptr), __TDOUBLE, name, &actual, NULL, &status);
+
+    // Return flag (status 202: keyword not found)
+    return ((status == 202) || (status == 0 && actual == value));
+}
+
+
+/***********************************************************************//**
+ * @brief Decode data unit elements from a read-only memory mapping
+ *
+ * @param[in] vptr FITS file void pointer.
+ * @param[in] disktype On-disk datatype.
+ * @param[in] memtype Datatype of the storage.
+ * @param[in] offset Byte offset of first element in data unit.
+ * @param[in] stride Byte stride between rows.
+ * @param[in] number Number of elements per row.
+ * @param[in] length Number of rows.
+ * @param[out] data Storage (number*length elements).
+ * @return True if the data were decoded, false otherwise.
+ *
+ * Maps the pages of the data unit of the current HDU that cover the
+ * requested elements and decodes them row by row. The file is mapped only
+ * if it is a plain disk file. Pending writes in the cfitsio buffers are
+ * flushed to disk before mapping, so that the mapping reflects the file
+ * content as seen by cfitsio.
+ ***************************************************************************/
+static bool fits_mmap_read(void* vptr, const int& disktype, const int& memtype,
+                           const long long& offset, const long long& stride,
+                           const int& number, const int& length, void* data)
+{
+    // Initialise result
+    bool loaded = false;
+
+    #if defined(HAVE_SYS_MMAN_H)
+    // Get on-disk element size
+    int bytes = 0;
+    switch (disktype) {
+    case __TBYTE:
+        bytes = 1;
+        break;
+    case __TSHORT:
+        bytes = 2;
+        break;
+    case __TLONG:
+    case __TFLOAT:
+        bytes = 4;
+        break;
+    case __TLONGLONG:
+    case __TDOUBLE:
+        bytes = 8;
+        break;
+    default:
+        break;
+    }
+
+    // Continue only if there is something to decode
+    if (bytes > 0 && number > 0 && length > 0 && data != NULL) {
+
+        // Flush pending writes and get URL type and file name
+        int  status = 0;
+        char urltype[__FLEN_FILENAME];
+        char filename[__FLEN_FILENAME];
+        urltype[0]  = '\0';
+        filename[0] = '\0';
+        status      = __ffflsh(FPTR(vptr), 0, &status);
+        status      = __ffurlt(FPTR(vptr), urltype, &status);
+        status      = __ffflnm(FPTR(vptr), filename, &status);
+
+        // Get data unit location of current HDU
+        long long headstart = 0;
+        long long datastart = 0;
+        long long dataend   = 0;
+        status = __ffghadll(FPTR(vptr), &headstart, &datastart, &dataend,
+                            &status);
+
+        // Determine byte range to be mapped
+        long long row   = (long long)number * bytes;
+        long long first = datastart + offset;
+        long long last  = first + (long long)(length-1) * stride + row;
+
+        // Continue only for a plain disk file
+        if (status == 0 &&
+            std::strcmp(urltype, "file://") == 0 && filename[0] != '\0' &&
+            (length == 1 || stride >= row) && last <= dataend) {
+
+            // Open file and check its size
+            int fd = open(filename, O_RDONLY);
+            if (fd >= 0) {
+                struct stat info;
+                if (fstat(fd, &info) == 0 && (long long)info.st_size >= last) {
+
+                    // Map byte range, aligned on a page boundary
+                    long long page   = (long long)sysconf(_SC_PAGESIZE);
+                    long long start  = (first / page) * page;
+                    size_t    size   = (size_t)(last - start);
+                    void*     region = mmap(NULL, size, PROT_READ,
+                                            MAP_PRIVATE, fd, (off_t)start);
+                    if (region != MAP_FAILED) {
+
+                        // Signal sequential access
+                        #if defined(MADV_SEQUENTIAL)
+                        madvise(region, size, MADV_SEQUENTIAL);
+                        #endif
+
+                        // Decode elements
+                        const unsigned char* src =
+                            (const unsigned char*)region + (first - start);
+                        switch (disktype) {
+                        case __TBYTE:
+                            loaded = fits_mmap_decode<unsigned char>(src,
+                                     memtype, stride, number, length, data);
+                            break;
+                        case __TSHORT:
+                            loaded = fits_mmap_decode<short>(src,
+                                     memtype, stride, number, length, data);
+                            break;
+                        case __TLONG:
+                            loaded = fits_mmap_decode<int>(src,
+                                     memtype, stride, number, length, data);
+                            break;
+                        case __TLONGLONG:
+                            loaded = fits_mmap_decode<long long>(src,
+                                     memtype, stride, number, length, data);
+                            break;
+                        case __TFLOAT:
+                            loaded = fits_mmap_decode<float>(src,
+                                     memtype, stride, number, length, data);
+                            break;
+                        case __TDOUBLE:
+                            loaded = fits_mmap_decode<double>(src,
+                                     memtype, stride, number, length, data);
+                            break;
+                        default:
+                            break;
+                        }
+
+                        // Unmap byte range
+                        munmap(region, size);
+
+                    } // endif: mapping was successful
+
+                } // endif: file was large enough
+
+                // Close file
+                close(fd);
+
+            } // endif: file could be opened
+
+        } // endif: file could be mapped
+
+    } // endif: datatype was supported
+    #endif
+
+    // Return result
+    return loaded;
+}
+
+
+/***********************************************************************//**
+ * @brief Decode big-endian elements into storage of a given datatype
+ *
+ * @param[in] src Pointer to first on-disk element.
+ * @param[in] memtype Datatype of the storage.
+ * @param[in] stride Byte stride between rows.
+ * @param[in] number Number of elements per row.
+ * @param[in] length Number of rows.
+ * @param[out] data Storage (number*length elements).
+ * @return True if the elements were decoded, false otherwise.
+ ***************************************************************************/
+template <class D>
+static bool fits_mmap_decode(const unsigned char* src, const int& memtype,
+                             const long long& stride, const int& number,
+                             const int& length, void* data)
+{
+    // Initialise result
+    bool decoded = false;
+
+    // Decode into storage
+    switch (memtype) {
+    case __TBYTE:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (unsigned char*)data);
+        break;
+    case __TSBYTE:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (signed char*)data);
+        break;
+    case __TSHORT:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (short*)data);
+        break;
+    case __TUSHORT:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (unsigned short*)data);
+        break;
+    case __TINT:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (int*)data);
+        break;
+    case __TUINT:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (unsigned int*)data);
+        break;
+    case __TLONG:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (long*)data);
+        break;
+    case __TULONG:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (unsigned long*)data);
+        break;
+    case __TLONGLONG:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (long long*)data);
+        break;
+    case __TFLOAT:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (float*)data);
+        break;
+    case __TDOUBLE:
+        decoded = fits_mmap_decode<D>(src, stride, number, length,
+                                      (double*)data);
+        break;
+    default:
+        break;
+    }
+
+    // Return result
+    return decoded;
+}
+
+
+/***********************************************************************//**
+ * @brief Decode big-endian elements
+ *
+ * @param[in] src Pointer to first on-disk element.
+ * @param[in] stride Byte stride between rows.
+ * @param[in] number Number of elements per row.
+ * @param[in] length Number of rows.
+ * @param[out] dst Storage (number*length elements).
+ * @return True if the elements were decoded, false otherwise.
+ *
+ * Decodes @p length rows of @p number consecutive big-endian elements of
+ * type D into the storage of type M. Bytes are swapped on little-endian
+ * hosts.
+ *
+ * Elements are only decoded if their values are exactly represented in
+ * the storage. Floating point elements need floating point storage that is
+ * at least as wide, integer elements need floating point storage with a
+ * sufficient mantissa or integer storage that holds their value. If any
+ * element cannot be decoded the method returns false, and the caller
+ * should let cfitsio apply its conversion rules.
+ ***************************************************************************/
+template <class D, class M>
+static bool fits_mmap_decode(const unsigned char* src, const long long& stride,
+                             const int& number, const int& length, M* dst)
+{
+    // Set datatype properties
+    const bool int_disk = std::numeric_limits<D>::is_integer;
+    const bool int_mem  = std::numeric_limits<M>::is_integer;
+
+    // Check that the storage can represent all on-disk values, except for
+    // integer storage of integer elements which is checked element-wise
+    if ((!int_disk && (int_mem || sizeof(M) < sizeof(D))) ||
+        (int_disk && !int_mem &&
+         std::numeric_limits<M>::digits < std::numeric_limits<D>::digits)) {
+        return false;
+    }
+
+    // Determine host byte order
+    const int  one    = 1;
+    const bool little = (*((const char*)&one) == 1);
+
+    // Loop over rows
+    for (int row = 0; row < length; ++row, src += stride) {
+
+        // Decode elements of row
+        const unsigned char* ptr = src;
+        for (int i = 0; i < number; ++i, ptr += sizeof(D)) {
+            D              value;
+            unsigned char* bytes = (unsigned char*)&value;
+            if (little) {
+                for (int k = 0; k < (int)sizeof(D); ++k) {
+                    bytes[k] = ptr[sizeof(D)-1-k];
+                }
+            }
+            else {
+                std::memcpy(bytes, ptr, sizeof(D));
+            }
+            *dst = (M)value;
+            if (int_mem && ((D)(*dst) != value ||
+                            (value < 0 && !std::numeric_limits<M>::is_signed))) {
+                return false;
+            }
+            dst++;
+        }
+
+    } // endfor: looped over rows
+
+    // Return
+    return true;
+}
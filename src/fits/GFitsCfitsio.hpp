@@ -57,12 +57,15 @@
 #define __ffdelt(A, B) ffdelt(A, B)
 #define __ffdhdu(A, B, C) ffdhdu(A, B, C)
 #define __ffdrow(A, B, C, D) ffdrow(A, B, C, D)
+#define __ffflnm(A, B, C) ffflnm(A, B, C)
+#define __ffflsh(A, B, C) ffflsh(A, B, C)
 #define __ffgabc(A, B, C, D, E, F) ffgabc(A, B, C, D, E, F)
 #define __ffgcv(A, B, C, D, E, F, G, H, I, J) ffgcv(A, B, C, D, E, F, G, H, I, J)
 #define __ffgcvb(A, B, C, D, E, F, G, H, I) ffgcvb(A, B, C, D, E, F, G, H, I)
 #define __ffgcvs(A, B, C, D, E, F, G, H, I) ffgcvs(A, B, C, D, E, F, G, H, I)
 #define __ffgdes(A, B, C, D, E, F) ffgdes(A, B, C, D, E, F)
 #define __ffgerr(A, B) ffgerr(A, B)
+#define __ffghadll(A, B, C, D, E) ffghadll(A, B, C, D, E)
 #define __ffghdt(A, B, C) ffghdt(A, B, C)
 #define __ffghsp(A, B, C, D) ffghsp(A, B, C, D)
 #define __ffgidm(A, B, C) ffgidm(A, B, C)
@@ -100,6 +103,9 @@
 #define __ffukyl(A, B, C, D, E) ffukyl(A, B, C, D, E)
 #define __ffukys(A, B, C, D, E) ffukys(A, B, C, D, E)
 #define __ffukyu(A, B, C, D) ffukyu(A, B, C, D)
+#define __ffurlt(A, B, C) ffurlt(A, B, C)
+#define __fficmp(A, B) fits_is_compressed_image(A, B)
+#define __FLEN_FILENAME FLEN_FILENAME
 #define __TNULL       0
 #define __TBIT        TBIT
 #define __TBYTE       TBYTE
@@ -134,12 +140,15 @@ typedef fitsfile __fitsfile;
 #define __ffdelt(A, B) __dummy()
 #define __ffdhdu(A, B, C) __dummy()
 #define __ffdrow(A, B, C, D) __dummy()
+#define __ffflnm(A, B, C) __dummy()
+#define __ffflsh(A, B, C) __dummy()
 #define __ffgabc(A, B, C, D, E, F) __dummy()
 #define __ffgcv(A, B, C, D, E, F, G, H, I, J) __dummy()
 #define __ffgcvb(A, B, C, D, E, F, G, H, I) __dummy()
 #define __ffgcvs(A, B, C, D, E, F, G, H, I) __dummy()
 #define __ffgdes(A, B, C, D, E, F) __dummy()
 #define __ffgerr(A, B) __error(A, B)
+#define __ffghadll(A, B, C, D, E) __dummy()
 #define __ffghdt(A, B, C) __dummy()
 #define __ffghsp(A, B, C, D) __dummy()
 #define __ffgidm(A, B, C) __dummy()
@@ -177,6 +186,9 @@ typedef fitsfile __fitsfile;
 #define __ffukyl(A, B, C, D, E) __dummy()
 #define __ffukys(A, B, C, D, E) __dummy()
 #define __ffukyu(A, B, C, D) __dummy()
+#define __ffurlt(A, B, C) __dummy()
+#define __fficmp(A, B) __dummy()
+#define __FLEN_FILENAME 1025
 #define __TNULL         0
 #define __TBIT          1
 #define __TBYTE        11
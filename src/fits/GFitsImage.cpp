@@ -671,7 +671,10 @@ void GFitsImage::open_image(void* vptr)
  * @exception GException::fits_error
  *            FITS error.
  *
- * Load image pixels from FITS file.
+ * Load image pixels from FITS file using cfitsio. If memory mapped reading
+ * was enabled using gammalib::fits_mmap(), unscaled images without NULL
+ * value check are decoded from a read-only memory mapping of the file if
+ * possible (see gammalib::fits_mmap_image()).
  ***************************************************************************/
 void GFitsImage::load_image(int datatype, const void* pixels,
                             const void* nulval, int* anynul)
@@ -679,8 +682,21 @@ void GFitsImage::load_image(int datatype, const void* pixels,
     // Move to HDU
     move_to_hdu();
 
-    // Load the image pixels (if there are some ...)
-    if (m_naxis > 0) {
+    // Check whether the pixels can be decoded from a memory mapping
+    bool mapped = (gammalib::fits_mmap() && m_naxis > 0 && nulval == NULL &&
+                   (!m_header.contains("BSCALE") ||
+                    m_header.real("BSCALE") == 1.0) &&
+                   (!m_header.contains("BZERO") ||
+                    m_header.real("BZERO") == 0.0));
+
+    // Load the image pixels from a memory mapping (if possible ...)
+    if (mapped && gammalib::fits_mmap_image(m_fitsfile, m_bitpix, datatype,
+                                            m_num_pixels, (void*)pixels)) {
+        *anynul = 0;
+    }
+
+    // ... otherwise load the image pixels (if there are some ...)
+    else if (m_naxis > 0) {
         long* fpixel = new long[m_naxis];
         long* lpixel = new long[m_naxis];
         long* inc    = new long[m_naxis];
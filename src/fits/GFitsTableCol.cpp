@@ -31,7 +31,10 @@
 #include <cstdlib>
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFits.hpp"
 #include "GFitsTableCol.hpp"
+#include "GFitsTableULongCol.hpp"
+#include "GFitsTableLongLongCol.hpp"
 #include "GTools.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -42,6 +45,9 @@
 #define G_SAVE_COLUMN_FIXED              "GFitsTableCol::save_column_fixed()"
 #define G_SAVE_COLUMN_VARIABLE        "GFitsTableCol::save_column_variable()"
 #define G_OFFSET                          "GFitsTableCol::offset(int&, int&)"
+#define G_READ_ROWS1 "GFitsTableCol::read_rows(int&, int&, std::vector<double>&)"
+#define G_READ_ROWS2                  "GFitsTableCol::read_rows(int&, int&,"\
+                                             " std::vector<unsigned long>&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -288,6 +294,130 @@ int GFitsTableCol::elements(const int& row) const
 }
 
 
+/***********************************************************************//**
+ * @brief Read cells of a row range as double precision values
+ *
+ * @param[in] row Index of first row.
+ * @param[in] nrows Number of rows.
+ * @param[out] values Cell values (nrows*number() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range is not contained in column.
+ * @exception GException::invalid_value
+ *            Column is a variable-length column.
+ * @exception GException::fits_error
+ *            An error occured while reading the cells from the FITS file.
+ *
+ * Reads the cells of rows [@p row, @p row + @p nrows[ into @p values,
+ * with the elements of a row being stored consecutively.
+ *
+ * If the column has not yet been loaded and a FITS file is attached to
+ * the column, the cells are read directly from the FITS file without
+ * loading the column into memory. This allows reading very large columns
+ * in chunks of rows while keeping the memory usage bounded. Otherwise the
+ * cells are taken from the column in memory.
+ ***************************************************************************/
+void GFitsTableCol::read_rows(const int&           row,
+                              const int&           nrows,
+                              std::vector<double>& values) const
+{
+    // Check row range
+    check_rows(G_READ_ROWS1, row, nrows);
+
+    // Allocate values
+    values.assign(std::size_t(nrows) * m_number, 0.0);
+
+    // Continue only if there are values to read
+    if (!values.empty()) {
+
+        // Read the cells from the FITS file if possible, otherwise take
+        // the cells from the column in memory
+        if (!read_cells(G_READ_ROWS1, row, values.size(), __TDOUBLE,
+                        &(values[0]))) {
+            double* ptr = &(values[0]);
+            for (int i = row; i < row + nrows; ++i) {
+                for (int k = 0; k < m_number; ++k) {
+                    *ptr++ = real(i, k);
+                }
+            }
+        }
+
+    } // endif: there were values to read
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read cells of a row range as unsigned integer values
+ *
+ * @param[in] row Index of first row.
+ * @param[in] nrows Number of rows.
+ * @param[out] values Cell values (nrows*number() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range is not contained in column.
+ * @exception GException::invalid_value
+ *            Column is a variable-length column.
+ * @exception GException::fits_error
+ *            An error occured while reading the cells from the FITS file.
+ *
+ * Reads the cells of rows [@p row, @p row + @p nrows[ into @p values,
+ * with the elements of a row being stored consecutively. Contrary to the
+ * double precision version of the method, 64-bit integer cells are read
+ * without loss of precision, which makes this method suited for reading
+ * identifiers.
+ *
+ * See read_rows(const int&, const int&, std::vector<double>&) for the
+ * handling of columns that have not yet been loaded.
+ ***************************************************************************/
+void GFitsTableCol::read_rows(const int&                  row,
+                              const int&                  nrows,
+                              std::vector<unsigned long>& values) const
+{
+    // Check row range
+    check_rows(G_READ_ROWS2, row, nrows);
+
+    // Allocate values
+    values.assign(std::size_t(nrows) * m_number, 0);
+
+    // Continue only if there are values to read
+    if (!values.empty()) {
+
+        // Read the cells from the FITS file if possible, otherwise take
+        // the cells from the column in memory. The 64-bit integer columns
+        // are accessed directly as their values may not be representable
+        // as double precision value
+        if (!read_cells(G_READ_ROWS2, row, values.size(), __TULONG,
+                        &(values[0]))) {
+            const GFitsTableULongCol*    ulong_col =
+                  dynamic_cast<const GFitsTableULongCol*>(this);
+            const GFitsTableLongLongCol* llong_col =
+                  dynamic_cast<const GFitsTableLongLongCol*>(this);
+            unsigned long* ptr = &(values[0]);
+            for (int i = row; i < row + nrows; ++i) {
+                for (int k = 0; k < m_number; ++k) {
+                    if (ulong_col != NULL) {
+                        *ptr++ = (*ulong_col)(i, k);
+                    }
+                    else if (llong_col != NULL) {
+                        *ptr++ = (unsigned long)((*llong_col)(i, k));
+                    }
+                    else {
+                        *ptr++ = (unsigned long)(real(i, k));
+                    }
+                }
+            }
+        }
+
+    } // endif: there were values to read
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns TFORM code for binary table column
  *
@@ -585,13 +715,24 @@ void GFitsTableCol::load_column_fixed(void)
                                   status);
                 }
 
-                // Load data
-                status = __ffgcv(FPTR(m_fitsfile), m_type, m_colnum, 
-                                 1, 1, m_size, ptr_nulval(), ptr_data(),
-                                 &m_anynul, &status);
-                if (status != 0) {
-                    throw GException::fits_error(G_LOAD_COLUMN_FIXED, status,
-                                    "for column '"+m_name+"'.");
+                // Load data. If memory mapped reading was enabled,
+                // unscaled columns without NULL value check are decoded
+                // from a read-only memory mapping of the file if possible;
+                // otherwise cfitsio is used.
+                if (ptr_nulval() == NULL &&
+                    gammalib::fits_mmap_column(m_fitsfile, m_colnum, m_type,
+                                               0, m_length, m_number,
+                                               ptr_data())) {
+                    m_anynul = 0;
+                }
+                else {
+                    status = __ffgcv(FPTR(m_fitsfile), m_type, m_colnum,
+                                     1, 1, m_size, ptr_nulval(), ptr_data(),
+                                     &m_anynul, &status);
+                    if (status != 0) {
+                        throw GException::fits_error(G_LOAD_COLUMN_FIXED,
+                                        status, "for column '"+m_name+"'.");
+                    }
                 }
         
             } // endif: no primary HDU found
@@ -906,6 +1047,104 @@ int GFitsTableCol::offset(const int& row, const int& inx) const
 }
 
 
+/***********************************************************************//**
+ * @brief Check row range for reading of cells
+ *
+ * @param[in] origin Name of calling method.
+ * @param[in] row Index of first row.
+ * @param[in] nrows Number of rows.
+ *
+ * @exception GException::out_of_range
+ *            Row range is not contained in column.
+ * @exception GException::invalid_value
+ *            Column is a variable-length column.
+ *
+ * Checks that the row range [@p row, @p row + @p nrows[ is contained in
+ * the column and that the column is a fixed-length column.
+ ***************************************************************************/
+void GFitsTableCol::check_rows(const std::string& origin,
+                               const int&         row,
+                               const int&         nrows) const
+{
+    // Check row range
+    if (row < 0 || row > m_length) {
+        throw GException::out_of_range(origin, "Row index", row,
+                                       m_length+1);
+    }
+    if (nrows < 0 || row + nrows > m_length) {
+        throw GException::out_of_range(origin, "Number of rows", nrows,
+                                       m_length-row+1);
+    }
+
+    // Throw an exception for variable-length columns
+    if (m_variable) {
+        std::string msg = "Rows cannot be read for variable-length column \""+
+                          m_name+"\".";
+        throw GException::invalid_value(origin, msg);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Read cells from FITS file
+ *
+ * @param[in] origin Name of calling method.
+ * @param[in] row Index of first row.
+ * @param[in] nelements Number of cells.
+ * @param[in] type cfitsio data type of @p values.
+ * @param[out] values Cell values.
+ * @return True if the cells were read from the FITS file.
+ *
+ * @exception GException::fits_error
+ *            An error occured while reading the cells from the FITS file.
+ *
+ * Reads @p nelements cells starting from the first element of @p row from
+ * the FITS file, converting them by cfitsio into the data @p type. The
+ * cells are only read if the column has not yet been loaded and a FITS
+ * file is attached to the column, otherwise false is returned and the
+ * caller needs to take the cells from the column in memory.
+ ***************************************************************************/
+bool GFitsTableCol::read_cells(const std::string& origin,
+                               const int&         row,
+                               const int&         nelements,
+                               const int&         type,
+                               void*              values) const
+{
+    // Check whether the cells can be read from the FITS file
+    bool read = (!is_loaded() && FPTR(m_fitsfile)->Fptr != NULL &&
+                 m_colnum > 0);
+
+    // If yes then read the cells
+    if (read) {
+
+        // Move to the HDU
+        gammalib::fits_move_to_hdu(origin, m_fitsfile);
+
+        // Read cells from a read-only memory mapping of the file if
+        // enabled and possible, otherwise read them using cfitsio
+        int nrows = (m_number > 0) ? nelements / m_number : 0;
+        if (!gammalib::fits_mmap_column(m_fitsfile, m_colnum, type, row,
+                                        nrows, m_number, values)) {
+            int status = 0;
+            int anynul = 0;
+            status     = __ffgcv(FPTR(m_fitsfile), type, m_colnum, row+1, 1,
+                                 nelements, NULL, values, &anynul, &status);
+            if (status != 0) {
+                throw GException::fits_error(origin, status,
+                                             "for column '"+m_name+"'.");
+            }
+        }
+
+    }
+
+    // Return flag
+    return read;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
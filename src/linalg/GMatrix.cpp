@@ -36,6 +36,7 @@
 #include "GMatrix.hpp"
 #include "GMatrixSparse.hpp"
 #include "GMatrixSymmetric.hpp"
+#include "GMatrixKernels.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_CONSTRUCTOR                          "GMatrix::GMatrix(int&, int&)"
@@ -291,13 +292,8 @@ GVector GMatrix::operator*(const GVector& vector) const
 
     // Perform vector multiplication
     GVector result(m_rows);
-    for (int row = 0; row < m_rows; ++row) {
-        double        sum = 0.0;
-        const double* src = m_data + row;
-        for (int col = 0; col < m_cols; ++col, src += m_rows) {
-            sum += *src * vector[col];
-        }
-        result[row] = sum;
+    if (m_rows > 0 && m_cols > 0) {
+        gammalib::gemv(m_rows, m_cols, m_data, &(vector[0]), &(result[0]));
     }
 
     // Return result
@@ -404,10 +400,9 @@ GMatrix& GMatrix::operator-=(const GMatrix& matrix)
  * This method performs a matrix multiplication. The operation can only
  * succeed when the dimensions of both matrices are compatible.
  *
- * In case of rectangular matrices the result matrix does not change and
- * the operation is performed inplace. For the general case the result
- * matrix changes in size and for simplicity a new matrix is allocated to
- * hold the result.
+ * The multiplication is done by the blocked gammalib::gemm() kernel (or a
+ * BLAS routine if available) into a newly allocated result matrix, which
+ * then replaces the matrix.
  ***************************************************************************/
 GMatrix& GMatrix::operator*=(const GMatrix& matrix)
 {
@@ -418,41 +413,20 @@ GMatrix& GMatrix::operator*=(const GMatrix& matrix)
                                           matrix.m_rows, matrix.m_cols);
     }
 
-    // Case A: Matrices are rectangular, so perform 'inplace' multiplication
-    if (m_rows == m_cols) {
-        for (int row = 0; row < m_rows; ++row) {
-            GVector v_row = this->row(row);
-            for (int col = 0; col < m_cols; ++col) {
-                double sum = 0.0;
-                for (int i = 0; i < m_cols; ++i) {
-                    sum += v_row[i] * matrix(i,col);
-                }
-                (*this)(row,col) = sum;
-            }
-        }
-    }
-
-    // Case B: Matrices are not rectangular, so we cannot work inplace
-    else {
+    // Continue only if the result matrix is not empty
+    if (m_rows > 0 && matrix.m_cols > 0) {
 
         // Allocate result matrix
         GMatrix result(m_rows, matrix.m_cols);
 
-        // Loop over all elements of result matrix
-        for (int row = 0; row < m_rows; ++row) {
-            for (int col = 0; col < matrix.m_cols; ++col) {
-                double sum = 0.0;
-                for (int i = 0; i < m_cols; ++i) {
-                    sum += (*this)(row,i) * matrix(i,col);
-                }
-                result(row,col) = sum;
-            }
-        }
+        // Compute matrix product
+        gammalib::gemm(m_rows, matrix.m_cols, m_cols,
+                       m_data, matrix.m_data, result.m_data);
 
         // Assign result
         *this = result;
 
-    } // endelse: matrices were not rectangular
+    } // endif: result matrix was not empty
 
     // Return result
     return *this;
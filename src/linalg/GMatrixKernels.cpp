@@ -0,0 +1,501 @@
+/***************************************************************************
+ *           GMatrixKernels.cpp - Dense matrix computation kernels         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GMatrixKernels.cpp
+ * @brief Dense matrix computation kernels implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include <vector>
+#include "GMatrixKernels.hpp"
+
+/* __ Prototypes of BLAS and LAPACK routines _____________________________ */
+#ifdef HAVE_LAPACK
+extern "C" {
+    void dgemm_(const char* transa, const char* transb,
+                const int* m, const int* n, const int* k,
+                const double* alpha, const double* a, const int* lda,
+                const double* b, const int* ldb,
+                const double* beta, double* c, const int* ldc);
+    void dgemv_(const char* trans, const int* m, const int* n,
+                const double* alpha, const double* a, const int* lda,
+                const double* x, const int* incx,
+                const double* beta, double* y, const int* incy);
+    void dpptrf_(const char* uplo, const int* n, double* ap, int* info);
+    void dpptri_(const char* uplo, const int* n, double* ap, int* info);
+}
+#endif
+
+/* __ Constants __________________________________________________________ */
+const int    block_rows   = 256;     //!< Rows per cache block
+const int    block_inner  = 64;      //!< Inner dimension per cache block
+const int    block_cols   = 32;      //!< Columns per cache block (task)
+const int    min_parallel = 128;     //!< Minimum matrix dimension for threads
+const double min_flops    = 1.0e6;   //!< Minimum operations for threads
+
+/* __ Prototypes of local functions ______________________________________ */
+static inline double* packed_column(double* ap, const int& n, const int& col);
+
+
+/***********************************************************************//**
+ * @brief General matrix multiplication C = A * B
+ *
+ * @param[in] m Number of rows of @p a and @p c.
+ * @param[in] n Number of columns of @p b and @p c.
+ * @param[in] k Number of columns of @p a and rows of @p b.
+ * @param[in] a Matrix A (column-major, m x k).
+ * @param[in] b Matrix B (column-major, k x n).
+ * @param[out] c Matrix C (column-major, m x n).
+ *
+ * Computes the matrix product C = A * B. The array @p c must not overlap
+ * with @p a or @p b.
+ *
+ * The blocked implementation updates each column of C by the columns of
+ * A, so that the innermost loop runs over contiguous memory. A block of
+ * block_rows x block_inner elements of A is reused for all columns of a
+ * block of C. Blocks of C columns are distributed over the threads. The
+ * products are summed in the same order as for the plain triple loop.
+ ***************************************************************************/
+void gammalib::gemm(const int& m, const int& n, const int& k,
+                    const double* a, const double* b, double* c)
+{
+    // Continue only if matrix is not empty
+    if (m > 0 && n > 0) {
+
+        // Case A: use BLAS
+        #ifdef HAVE_LAPACK
+        if (k > 0) {
+            const char   trans = 'N';
+            const double alpha = 1.0;
+            const double beta  = 0.0;
+            dgemm_(&trans, &trans, &m, &n, &k, &alpha, a, &m, b, &k,
+                   &beta, c, &m);
+        }
+        else {
+            for (int i = 0; i < m*n; ++i) {
+                c[i] = 0.0;
+            }
+        }
+
+        // Case B: use blocked kernel
+        #else
+        double flops = double(m) * double(n) * double(k);
+        #pragma omp parallel for schedule(dynamic) if (flops >= min_flops)
+        for (int j0 = 0; j0 < n; j0 += block_cols) {
+
+            // Determine last column of block
+            int j1 = (j0 + block_cols < n) ? j0 + block_cols : n;
+
+            // Initialise columns of block
+            for (int i = m*j0; i < m*j1; ++i) {
+                c[i] = 0.0;
+            }
+
+            // Loop over blocks of inner dimension and rows
+            for (int p0 = 0; p0 < k; p0 += block_inner) {
+                int p1 = (p0 + block_inner < k) ? p0 + block_inner : k;
+                for (int i0 = 0; i0 < m; i0 += block_rows) {
+                    int i1 = (i0 + block_rows < m) ? i0 + block_rows : m;
+
+                    // Update block of C. Four columns of A are added at
+                    // once to reduce the memory traffic on C; the products
+                    // are still added in the order of the inner index
+                    for (int j = j0; j < j1; ++j) {
+                        double*       cj = c + j*m;
+                        const double* bj = b + j*k;
+                        int           p  = p0;
+                        for (; p+3 < p1; p += 4) {
+                            const double* ap0 = a + p*m;
+                            const double* ap1 = ap0 + m;
+                            const double* ap2 = ap1 + m;
+                            const double* ap3 = ap2 + m;
+                            double        bp0 = bj[p];
+                            double        bp1 = bj[p+1];
+                            double        bp2 = bj[p+2];
+                            double        bp3 = bj[p+3];
+                            for (int i = i0; i < i1; ++i) {
+                                double sum = cj[i];
+                                sum  += ap0[i] * bp0;
+                                sum  += ap1[i] * bp1;
+                                sum  += ap2[i] * bp2;
+                                sum  += ap3[i] * bp3;
+                                cj[i] = sum;
+                            }
+                        }
+                        for (; p < p1; ++p) {
+                            const double* ap  = a + p*m;
+                            double        bpj = bj[p];
+                            for (int i = i0; i < i1; ++i) {
+                                cj[i] += ap[i] * bpj;
+                            }
+                        }
+                    }
+
+                } // endfor: looped over row blocks
+            } // endfor: looped over inner blocks
+
+        } // endfor: looped over column blocks
+        #endif
+
+    } // endif: matrix was not empty
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief General matrix vector multiplication y = A * x
+ *
+ * @param[in] m Number of rows of @p a.
+ * @param[in] n Number of columns of @p a.
+ * @param[in] a Matrix A (column-major, m x n).
+ * @param[in] x Vector x (n elements).
+ * @param[out] y Vector y (m elements).
+ *
+ * Computes the product y = A * x. The array @p y must not overlap with
+ * @p a or @p x.
+ *
+ * The blocked implementation adds the columns of A, weighted by the
+ * elements of x, to blocks of y, so that the innermost loop runs over
+ * contiguous memory. The row blocks are distributed over the threads.
+ ***************************************************************************/
+void gammalib::gemv(const int& m, const int& n,
+                    const double* a, const double* x, double* y)
+{
+    // Continue only if vector is not empty
+    if (m > 0) {
+
+        // Case A: use BLAS
+        #ifdef HAVE_LAPACK
+        if (n > 0) {
+            const char   trans = 'N';
+            const double alpha = 1.0;
+            const double beta  = 0.0;
+            const int    inc   = 1;
+            dgemv_(&trans, &m, &n, &alpha, a, &m, x, &inc, &beta, y, &inc);
+        }
+        else {
+            for (int i = 0; i < m; ++i) {
+                y[i] = 0.0;
+            }
+        }
+
+        // Case B: use blocked kernel
+        #else
+        double flops = double(m) * double(n);
+        #pragma omp parallel for schedule(static) if (flops >= min_flops)
+        for (int i0 = 0; i0 < m; i0 += block_rows) {
+            int i1 = (i0 + block_rows < m) ? i0 + block_rows : m;
+            for (int i = i0; i < i1; ++i) {
+                y[i] = 0.0;
+            }
+            for (int j = 0; j < n; ++j) {
+                const double* aj = a + j*m;
+                double        xj = x[j];
+                for (int i = i0; i < i1; ++i) {
+                    y[i] += aj[i] * xj;
+                }
+            }
+        }
+        #endif
+
+    } // endif: vector was not empty
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Cholesky decomposition of packed symmetric matrix
+ *
+ * @param[in] n Matrix dimension.
+ * @param[in,out] ap Packed lower triangle (n*(n+1)/2 elements).
+ * @param[out] pivot Non-positive pivot if decomposition failed.
+ * @return Index of failing column, -1 on success.
+ *
+ * Replaces the lower triangle of a symmetric positive definite matrix by
+ * its Cholesky factor L, where A = L * L^T. If the matrix is not positive
+ * definite, the index of the column with a non-positive pivot is returned
+ * and the pivot is stored in @p pivot.
+ *
+ * The blocked implementation is a left-looking algorithm that operates on
+ * panels of block_inner columns. Each panel is first updated by all columns
+ * to the left of the panel, where the rows are split into blocks that are
+ * distributed over the threads. The panel is then factorised. The updates
+ * of each element are subtracted in the same order as for the unblocked
+ * algorithm.
+ ***************************************************************************/
+int gammalib::potrf(const int& n, double* ap, double* pivot)
+{
+    // Initialise result
+    int result = -1;
+
+    // Case A: use LAPACK
+    #ifdef HAVE_LAPACK
+    if (n > 0) {
+        const char uplo = 'L';
+        int        info = 0;
+        dpptrf_(&uplo, &n, ap, &info);
+        if (info > 0) {
+            result = info - 1;
+            *pivot = packed_column(ap, n, result)[result];
+        }
+    }
+
+    // Case B: use blocked kernel
+    #else
+    for (int j0 = 0; j0 < n; j0 += block_inner) {
+
+        // Determine last column of panel
+        int j1 = (j0 + block_inner < n) ? j0 + block_inner : n;
+
+        // Update panel by all columns left of the panel
+        if (j0 > 0) {
+            #pragma omp parallel for schedule(dynamic) if (n >= min_parallel)
+            for (int i0 = j0; i0 < n; i0 += block_rows) {
+                int i1 = (i0 + block_rows < n) ? i0 + block_rows : n;
+                for (int k = 0; k < j0; ++k) {
+                    const double* lk = packed_column(ap, n, k);
+                    for (int j = j0; j < j1 && j < i1; ++j) {
+                        double* lj  = packed_column(ap, n, j);
+                        double  ljk = lk[j];
+                        int     i   = (i0 > j) ? i0 : j;
+                        for (; i < i1; ++i) {
+                            lj[i] -= ljk * lk[i];
+                        }
+                    }
+                }
+            }
+        }
+
+        // Factorise panel
+        for (int j = j0; j < j1; ++j) {
+
+            // Update column by panel columns left of the column
+            double* lj = packed_column(ap, n, j);
+            for (int k = j0; k < j; ++k) {
+                const double* lk  = packed_column(ap, n, k);
+                double        ljk = lk[j];
+                for (int i = j; i < n; ++i) {
+                    lj[i] -= ljk * lk[i];
+                }
+            }
+
+            // Check pivot
+            if (lj[j] <= 0.0) {
+                *pivot = lj[j];
+                return j;
+            }
+
+            // Scale column
+            lj[j]       = std::sqrt(lj[j]);
+            double diag = 1.0 / lj[j];
+            for (int i = j+1; i < n; ++i) {
+                lj[i] *= diag;
+            }
+
+        } // endfor: looped over panel columns
+
+    } // endfor: looped over panels
+    #endif
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Inverse of packed symmetric matrix from its Cholesky factor
+ *
+ * @param[in] n Matrix dimension.
+ * @param[in,out] ap Packed lower triangle (n*(n+1)/2 elements).
+ *
+ * Replaces the Cholesky factor L, as computed by potrf(), by the lower
+ * triangle of the inverse matrix A^(-1) = L^(-T) * L^(-1).
+ ***************************************************************************/
+void gammalib::potri(const int& n, double* ap)
+{
+    // Case A: use LAPACK
+    #ifdef HAVE_LAPACK
+    if (n > 0) {
+        const char uplo = 'L';
+        int        info = 0;
+        dpptri_(&uplo, &n, ap, &info);
+    }
+
+    // Case B: use blocked kernels
+    #else
+    trtri(n, ap);
+    syrk(n, ap);
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Inverse of packed lower triangular matrix
+ *
+ * @param[in] n Matrix dimension.
+ * @param[in,out] ap Packed lower triangle (n*(n+1)/2 elements).
+ *
+ * Replaces the lower triangular matrix L by its inverse L^(-1). Each column
+ * of the inverse is obtained by forward substitution, where the columns of
+ * L are subtracted from the result column so that the innermost loop runs
+ * over contiguous memory. The inverse is computed for blocks of block_cols
+ * columns at once so that each column of L is reused for all columns of
+ * the block. The column blocks are distributed over the threads.
+ ***************************************************************************/
+void gammalib::trtri(const int& n, double* ap)
+{
+    // Continue only if matrix is not empty
+    if (n > 0) {
+
+        // Allocate result
+        std::vector<double> inv(n*(n+1)/2, 0.0);
+
+        // Loop over column blocks
+        #pragma omp parallel for schedule(dynamic) if (n >= min_parallel)
+        for (int j0 = 0; j0 < n; j0 += block_cols) {
+
+            // Determine last column of block
+            int j1 = (j0 + block_cols < n) ? j0 + block_cols : n;
+
+            // Forward substitution
+            for (int k = j0; k < n; ++k) {
+                const double* lk = packed_column(ap, n, k);
+                for (int j = j0; j < j1 && j <= k; ++j) {
+                    double* xj = packed_column(&inv[0], n, j);
+                    if (k == j) {
+                        xj[k] = 1.0 / lk[k];
+                    }
+                    else {
+                        xj[k] /= lk[k];
+                    }
+                    double xk = xj[k];
+                    for (int i = k+1; i < n; ++i) {
+                        xj[i] -= lk[i] * xk;
+                    }
+                }
+            }
+
+        } // endfor: looped over column blocks
+
+        // Store result
+        int nelements = inv.size();
+        for (int i = 0; i < nelements; ++i) {
+            ap[i] = inv[i];
+        }
+
+    } // endif: matrix was not empty
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Symmetric product of packed lower triangular matrix
+ *
+ * @param[in] n Matrix dimension.
+ * @param[in,out] ap Packed lower triangle (n*(n+1)/2 elements).
+ *
+ * Replaces the lower triangular matrix L by the lower triangle of the
+ * symmetric matrix L^T * L. Each element is the scalar product of two
+ * column segments of L, which is computed using four partial sums so that
+ * it can be vectorised. The columns are distributed over the threads.
+ ***************************************************************************/
+void gammalib::syrk(const int& n, double* ap)
+{
+    // Continue only if matrix is not empty
+    if (n > 0) {
+
+        // Allocate result
+        std::vector<double> prod(n*(n+1)/2, 0.0);
+
+        // Loop over columns
+        #pragma omp parallel for schedule(dynamic) if (n >= min_parallel)
+        for (int j = 0; j < n; ++j) {
+            const double* lj = packed_column(ap, n, j);
+            double*       pj = packed_column(&prod[0], n, j);
+            for (int i = j; i < n; ++i) {
+                const double* li   = packed_column(ap, n, i);
+                double        sum0 = 0.0;
+                double        sum1 = 0.0;
+                double        sum2 = 0.0;
+                double        sum3 = 0.0;
+                int           k    = i;
+                for (; k+3 < n; k += 4) {
+                    sum0 += lj[k]   * li[k];
+                    sum1 += lj[k+1] * li[k+1];
+                    sum2 += lj[k+2] * li[k+2];
+                    sum3 += lj[k+3] * li[k+3];
+                }
+                for (; k < n; ++k) {
+                    sum0 += lj[k] * li[k];
+                }
+                pj[i] = (sum0 + sum1) + (sum2 + sum3);
+            }
+        }
+
+        // Store result
+        int nelements = prod.size();
+        for (int i = 0; i < nelements; ++i) {
+            ap[i] = prod[i];
+        }
+
+    } // endif: matrix was not empty
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Local functions                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Return pointer to column of packed lower triangle
+ *
+ * @param[in] ap Packed lower triangle.
+ * @param[in] n Matrix dimension.
+ * @param[in] col Column index.
+ * @return Pointer to column.
+ *
+ * Returns a pointer that is shifted so that the element (row,col) of the
+ * lower triangle (row >= col) is obtained by indexing the pointer with
+ * @p row.
+ ***************************************************************************/
+static inline double* packed_column(double* ap, const int& n, const int& col)
+{
+    return (ap + col*n - col*(col+1)/2);
+}
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *           GMatrixKernels.hpp - Dense matrix computation kernels         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GMatrixKernels.hpp
+ * @brief Dense matrix computation kernels definition
+ * @author Juergen Knoedlseder
+ *
+ * This file declares the computation kernels that are used by the dense
+ * matrix classes GMatrix and GMatrixSymmetric. General matrices are stored
+ * in column-major order, symmetric and triangular matrices are stored as
+ * packed lower triangles in column-major order, which corresponds to the
+ * storage of GMatrixSymmetric and to the 'L' packed storage of LAPACK.
+ *
+ * If GammaLib was configured with LAPACK support (HAVE_LAPACK) the kernels
+ * call the corresponding BLAS and LAPACK routines, otherwise cache-blocked
+ * implementations are used whose inner loops run over contiguous memory so
+ * that they can be vectorised by the compiler. The blocked implementations
+ * are distributed over several threads if OpenMP is available and if the
+ * matrices are sufficiently large.
+ */
+
+#ifndef GMATRIXKERNELS_HPP
+#define GMATRIXKERNELS_HPP
+
+/* __ Prototypes _________________________________________________________ */
+namespace gammalib {
+    void gemm(const int& m, const int& n, const int& k,
+              const double* a, const double* b, double* c);
+    void gemv(const int& m, const int& n,
+              const double* a, const double* x, double* y);
+    int  potrf(const int& n, double* ap, double* pivot);
+    void potri(const int& n, double* ap);
+    void trtri(const int& n, double* ap);
+    void syrk(const int& n, double* ap);
+}
+
+#endif /* GMATRIXKERNELS_HPP */
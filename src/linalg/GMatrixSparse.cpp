@@ -29,6 +29,7 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <algorithm>          // std::sort, std::lower_bound
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GVector.hpp"
@@ -54,8 +55,13 @@
 #define G_ADD_TO_COLUMN     "GMatrixSymmetric::add_to_column(int&, GVector&)"
 #define G_ADD_TO_COLUMN2     "GMatrixSymmetric::add_to_column(int&, double*,"\
                                                                 " int*, int)"
+#define G_ADD_MATRICES                         "GMatrixSparse::add_matrices("\
+                                              "std::vector<GMatrixSparse*>&)"
+#define G_PATTERN_INIT        "GMatrixSparse::pattern_init(GMatrixSparse&)"
 #define G_CHOL_DECOMP               "GMatrixSparse::cholesky_decompose(bool)"
 #define G_CHOL_SOLVE         "GMatrixSparse::cholesky_solver(GVector&, bool)"
+#define G_CHOL_SOLVE_MAT     "GMatrixSparse::cholesky_solver(GMatrix&, bool)"
+#define G_CHOL_INV_DIAG      "GMatrixSparse::cholesky_inverse_diagonal(bool)"
 #define G_STACK_INIT                  "GMatrixSparse::stack_init(int&, int&)"
 #define G_STACK_PUSH  "GMatrixSparse::stack_push_column(double*, int*, int&,"\
                                                                      " int&)"
@@ -83,6 +89,9 @@
 //#define G_DEBUG_SPARSE_STACK_PUSH           // Analyse stack column pushing
 //#define G_DEBUG_SPARSE_STACK_FLUSH         // Analyse stack column flushing
 
+/* __ Constants __________________________________________________________ */
+const int cholesky_block_size = 32;  //!< Right-hand sides solved at once
+
 
 /*==========================================================================
  =                                                                         =
@@ -1185,6 +1194,33 @@ void GMatrixSparse::add_to_column(const int& column, const GVector& vector)
     std::cout << std::endl;
     #endif
 
+    // If the matrix accumulates values on a shared pattern then add the
+    // non-zero vector elements as compressed array
+    if (m_pattern_data != NULL) {
+
+        // Raise an exception if the matrix and vector dimensions are incompatible
+        if (m_rows != vector.size()) {
+            throw GException::matrix_vector_mismatch(G_ADD_TO_COLUMN, vector.size(),
+                                                     m_rows, m_cols);
+        }
+
+        // Compress vector and add it to the column
+        std::vector<double> values;
+        std::vector<int>    rows;
+        for (int row = 0; row < m_rows; ++row) {
+            if (vector[row] != 0.0) {
+                values.push_back(vector[row]);
+                rows.push_back(row);
+            }
+        }
+        if (!rows.empty()) {
+            add_to_column(column, &(values[0]), &(rows[0]), rows.size());
+        }
+
+        // Return
+        return;
+    }
+
     // Initialise number of non-zero elements to 0
     int non_zero = 0;
 
@@ -1281,6 +1317,10 @@ void GMatrixSparse::add_to_column(const int& column, const GVector& vector)
  * This is the main driver routine to add data to a matrix. It handles both
  * normal and stack-based filled. Note that there is another instance of this
  * method that takes a vector.
+ *
+ * If the matrix accumulates values on a shared pattern (see pattern_init())
+ * the elements that exist in the pattern are only added to the pattern
+ * values, and the remaining elements are added to the matrix elements.
  ***************************************************************************/
 void GMatrixSparse::add_to_column(const int& column, const double* values,
                                   const int* rows, int number)
@@ -1313,18 +1353,11 @@ void GMatrixSparse::add_to_column(const int& column, const double* values,
     std::cout << std::endl;
     #endif
 
-    // If we have a stack then try to push elements on stack first. Note that
-    // stack_push_column does its own argument verifications, so to avoid
-    // double checking we don't do anything before this call ...
-    if (m_stack_data != NULL) {
-        number = stack_push_column(values, rows, number, column);
-        if (number == 0) {
-            return;
-        }
-    }
+    // If the matrix accumulates values on a shared pattern then add all
+    // elements that exist in the pattern to the pattern values and add
+    // the remaining elements to the matrix elements
+    if (m_pattern_data != NULL) {
 
-    // ... otherwise check the arguments
-    else {
         // If the array is empty there is nothing to do
         if (!values || !rows || (number < 1)) {
             return;
@@ -1337,66 +1370,300 @@ void GMatrixSparse::add_to_column(const int& column, const double* values,
         }
         #endif
 
-        // Raise an exception if the matrix and vector dimensions are incompatible
-        if (rows[number-1] >= m_rows) {
-            throw GException::matrix_vector_mismatch(G_ADD_TO_COLUMN2, rows[number-1],
-                                                     m_rows, m_cols);
+        // Get pattern row indices of column
+        const int* first = m_pattern_rowinx + m_pattern_colstart[column];
+        const int* last  = m_pattern_rowinx + m_pattern_colstart[column+1];
+
+        // Loop over all array elements. Since the row indices are in
+        // ascending order the search range shrinks with every element.
+        // Consecutive elements that are not in the pattern are added in
+        // one go to the matrix elements.
+        int miss = -1;
+        for (int i = 0; i < number; ++i) {
+            first = std::lower_bound(first, last, rows[i]);
+            if (first != last && *first == rows[i]) {
+                m_pattern_data[first - m_pattern_rowinx] += values[i];
+                if (miss >= 0) {
+                    add_column_elements(column, values+miss, rows+miss, i-miss);
+                    miss = -1;
+                }
+            }
+            else if (miss < 0) {
+                miss = i;
+            }
+        }
+        if (miss >= 0) {
+            add_column_elements(column, values+miss, rows+miss, number-miss);
         }
 
-    } // endelse: there was no stack
+    } // endif: matrix accumulates values on shared pattern
 
-    // Get indices of column in matrix
-    int i_start = m_colstart[column];
-    int i_stop  = m_colstart[column+1];
+    // ... otherwise add all elements to the matrix elements
+    else {
+        add_column_elements(column, values, rows, number);
+    }
 
-    // Case A: the column exists in the matrix, so mix new elements with existing
-    // data
-    if (i_start < i_stop) {
+    // Return
+    return;
+}
 
-        // Fill pending element before the merge (it will be lost otherwise)
+
+/***********************************************************************//**
+ * @brief Add a set of matrices to the matrix
+ *
+ * @param[in] matrices Matrices to be added.
+ *
+ * @exception GException::matrix_mismatch
+ *            Incompatible matrix size.
+ *
+ * Adds all @p matrices to the matrix. This is equivalent to successively
+ * applying the += operator to all matrices, but the assembly is done in a
+ * single pass over the columns of the result matrix, and the columns are
+ * distributed over the available threads if OpenMP is available.
+ *
+ * Values that the @p matrices accumulated on a shared pattern (see
+ * pattern_init()) are added in place if the pattern is the pattern on
+ * which the matrix itself accumulates values, or the pattern of the matrix
+ * elements. Since this only sums value arrays no matrix assembly is needed
+ * if the @p matrices hold no other elements. Values on any other pattern
+ * are added like matrix elements.
+ *
+ * All other elements are assembled column by column. In a first pass each
+ * thread determines the number of elements for its columns, from which the
+ * pattern of the result matrix is built. In a second pass each thread sums
+ * the values of its columns in a value-only working array and writes them
+ * directly into the shared result arrays. Since the threads write into
+ * disjoint columns no locking is needed. Elements that sum up to zero are
+ * dropped from the matrix by the assembly.
+ *
+ * The matrix values are always added in the order of the @p matrices
+ * vector, hence the result does not depend on the number of threads.
+ *
+ * The method is intended to merge the partial matrices that are
+ * accumulated by several threads, such as the curvature matrices of the
+ * likelihood computation. The fill stacks of the matrices are not
+ * considered, hence all fill stacks should be flushed before calling the
+ * method. Since the assembly replaces the matrix elements, matrices that
+ * accumulate values on the pattern of the matrix elements should not be
+ * used anymore after the call.
+ ***************************************************************************/
+void GMatrixSparse::add_matrices(const std::vector<const GMatrixSparse*>& matrices)
+{
+    // Get number of matrices
+    int nmatrices = matrices.size();
+
+    // Raise an exception if the matrix dimensions are not compatible
+    for (int i = 0; i < nmatrices; ++i) {
+        if (m_rows != matrices[i]->m_rows || m_cols != matrices[i]->m_cols) {
+            throw GException::matrix_mismatch(G_ADD_MATRICES,
+                                              m_rows, m_cols,
+                                              matrices[i]->m_rows,
+                                              matrices[i]->m_cols);
+        }
+    }
+
+    // Continue only if there are matrices and if the matrix is not empty
+    if (nmatrices > 0 && m_rows > 0 && m_cols > 0) {
+
+        // Fill pending element
         fill_pending();
 
-        // Allocate workspace to hold combined column
-        int     wrk_size   = number + i_stop - i_start;
-        double* wrk_double = new double[wrk_size];
-        int*    wrk_int    = new int[wrk_size];
+        // Set the sources for the column assembly, starting with the matrix
+        // elements. Values on the pattern of the matrix or on the pattern
+        // of the matrix elements are collected for in place addition.
+        std::vector<const int*>    src_colstart;
+        std::vector<const int*>    src_rowinx;
+        std::vector<const double*> src_data;
+        std::vector<const double*> pattern_values;
+        std::vector<const double*> element_values;
+        bool                       assemble = false;
+        if (m_elements > 0) {
+            src_colstart.push_back(m_colstart);
+            src_rowinx.push_back(m_rowinx);
+            src_data.push_back(m_data);
+        }
+        for (int k = 0; k < nmatrices; ++k) {
+            const GMatrixSparse* matrix = matrices[k];
+            if (matrix->m_elements > 0) {
+                src_colstart.push_back(matrix->m_colstart);
+                src_rowinx.push_back(matrix->m_rowinx);
+                src_data.push_back(matrix->m_data);
+                assemble = true;
+            }
+            if (matrix->m_fill_val != 0.0) {
+                assemble = true;
+            }
+            if (matrix->m_pattern_data == NULL) {
+                continue;
+            }
+            if (m_pattern_data != NULL &&
+                matrix->m_pattern_colstart == m_pattern_colstart &&
+                matrix->m_pattern_rowinx   == m_pattern_rowinx) {
+                pattern_values.push_back(matrix->m_pattern_data);
+            }
+            else if (matrix->m_pattern_colstart == m_colstart &&
+                     matrix->m_pattern_rowinx   == m_rowinx) {
+                element_values.push_back(matrix->m_pattern_data);
+            }
+            else {
+                src_colstart.push_back(matrix->m_pattern_colstart);
+                src_rowinx.push_back(matrix->m_pattern_rowinx);
+                src_data.push_back(matrix->m_pattern_data);
+                assemble = true;
+            }
+        }
+        int nsources = src_colstart.size();
+
+        // Add values in place
+        add_values(m_pattern_data, m_pattern_elements, pattern_values);
+        add_values(m_data, m_elements, element_values);
+
+        // Continue only if there are elements to assemble
+        if (assemble) {
+
+            // Allocate column start indices and element arrays of the result
+            // matrix
+            int*    colstart = new int[m_cols+1];
+            double* data     = NULL;
+            int*    rowinx   = NULL;
+            int     alloc    = 0;
+
+            // Assemble columns in parallel
+            #pragma omp parallel
+            {
+                // Allocate thread working arrays. The marker array flags the
+                // rows that are present in the actual column, the values
+                // array holds the sums of the actual column and the rows
+                // array holds the row indices of the actual column
+                std::vector<int>    marker(m_rows, -1);
+                std::vector<double> values(m_rows, 0.0);
+                std::vector<int>    rows;
+                rows.reserve(m_rows);
+
+                // Pass 1: determine the number of elements in each column of
+                // the result matrix
+                #pragma omp for schedule(dynamic, 64)
+                for (int col = 0; col < m_cols; ++col) {
+                    int num = 0;
+                    for (int k = 0; k < nsources; ++k) {
+                        const int* src_row = src_rowinx[k];
+                        for (int i = src_colstart[k][col]; i < src_colstart[k][col+1]; ++i) {
+                            int row = src_row[i];
+                            if (marker[row] != col) {
+                                marker[row] = col;
+                                num++;
+                            }
+                        }
+                    }
+                    for (int k = 0; k < nmatrices; ++k) {
+                        const GMatrixSparse* matrix = matrices[k];
+                        if (matrix->m_fill_val != 0.0 && matrix->m_fill_col == col &&
+                            marker[matrix->m_fill_row] != col) {
+                            marker[matrix->m_fill_row] = col;
+                            num++;
+                        }
+                    }
+                    colstart[col+1] = num;
+                }
 
-        // Mix matrix column with specified data
-        int num_mix;
-        mix_column(&(m_data[i_start]), &(m_rowinx[i_start]), i_stop-i_start,
-                   values, rows, number,
-                   wrk_double, wrk_int, &num_mix);
+                // Build column start indices and allocate element arrays
+                #pragma omp single
+                {
+                    colstart[0] = 0;
+                    for (int col = 0; col < m_cols; ++col) {
+                        colstart[col+1] += colstart[col];
+                    }
+                    alloc = colstart[m_cols];
+                    if (alloc > 0) {
+                        data   = new double[alloc];
+                        rowinx = new int[alloc];
+                    }
+                } // implicit barrier
 
-        // Insert mixed column
-        this->column(column, wrk_double, wrk_int, num_mix);
+                // Reset marker array
+                for (int row = 0; row < m_rows; ++row) {
+                    marker[row] = -1;
+                }
 
-        // Free workspace
-        delete [] wrk_int;
-        delete [] wrk_double;
+                // Pass 2: sum the column values and store them in the element
+                // arrays. The rows are sorted so that the row indices of each
+                // column are in ascending order.
+                #pragma omp for schedule(dynamic, 64)
+                for (int col = 0; col < m_cols; ++col) {
+
+                    // Sum values of all sources
+                    rows.clear();
+                    for (int k = 0; k < nsources; ++k) {
+                        const int*    src_row = src_rowinx[k];
+                        const double* src_val = src_data[k];
+                        for (int i = src_colstart[k][col]; i < src_colstart[k][col+1]; ++i) {
+                            int row = src_row[i];
+                            if (marker[row] != col) {
+                                marker[row] = col;
+                                rows.push_back(row);
+                            }
+                            values[row] += src_val[i];
+                        }
+                    }
 
-    } // endif: Case A
+                    // Add pending elements of all matrices
+                    for (int k = 0; k < nmatrices; ++k) {
+                        const GMatrixSparse* matrix = matrices[k];
+                        if (matrix->m_fill_val != 0.0 && matrix->m_fill_col == col) {
+                            int row = matrix->m_fill_row;
+                            if (marker[row] != col) {
+                                marker[row] = col;
+                                rows.push_back(row);
+                            }
+                            values[row] += matrix->m_fill_val;
+                        }
+                    }
 
-    // Case B: the column does not yet exist in the matrix, so just insert it
-    else {
-        this->column(column, values, rows, number);
-    }
+                    // Store values in ascending row order and reset the
+                    // values array
+                    std::sort(rows.begin(), rows.end());
+                    int inx  = colstart[col];
+                    int nrow = rows.size();
+                    for (int i = 0; i < nrow; ++i) {
+                        data[inx]   = values[rows[i]];
+                        rowinx[inx] = rows[i];
+                        values[rows[i]] = 0.0;
+                        inx++;
+                    }
 
-    // Debugging: show sparse matrix after insertion
-    #if defined(G_DEBUG_SPARSE_ADDITION)
-    std::cout << " Out Data: ";
-    for (int i = 0; i < m_elements; ++i) {
-        std::cout << m_data[i] << " ";
-    }
-    std::cout << std::endl << " Out Row : ";
-    for (int i = 0; i < m_elements; ++i) {
-        std::cout << m_rowinx[i] << " ";
-    }
-    std::cout << std::endl << " Out Col : ";
-    for (int i = 0; i < m_cols+1; ++i) {
-        std::cout << m_colstart[i] << " ";
-    }
-    std::cout << std::endl;
-    #endif
+                } // endfor: looped over columns
+
+            } // end pragma omp parallel
+
+            // Remove elements that summed up to zero
+            int elements = 0;
+            for (int col = 0; col < m_cols; ++col) {
+                int start     = colstart[col];
+                int stop      = colstart[col+1];
+                colstart[col] = elements;
+                for (int i = start; i < stop; ++i) {
+                    if (data[i] != 0.0) {
+                        data[elements]   = data[i];
+                        rowinx[elements] = rowinx[i];
+                        elements++;
+                    }
+                }
+            }
+            colstart[m_cols] = elements;
+
+            // Replace matrix elements by the result
+            if (m_colstart != NULL) delete [] m_colstart;
+            if (m_data     != NULL) delete [] m_data;
+            if (m_rowinx   != NULL) delete [] m_rowinx;
+            m_colstart = colstart;
+            m_data     = data;
+            m_rowinx   = rowinx;
+            m_elements = elements;
+            m_alloc    = alloc;
+
+        } // endif: there were elements to assemble
+
+    } // endif: there were matrices to add
 
     // Return
     return;
@@ -1619,23 +1886,59 @@ double GMatrixSparse::sum(void) const
  * is stored within a GMatrixSparse object.
  ***************************************************************************/
 GMatrixSparse GMatrixSparse::cholesky_decompose(const bool& compress) const
+{
+    // Allocate decomposition without symbolic analysis
+    GMatrixSparse decomposition;
+
+    // Compute Cholesky decomposition of matrix
+    decomposition.cholesky_refactor(*this, compress);
+
+    // Return decomposition
+    return decomposition;
+}
+
+
+/***********************************************************************//**
+ * @brief Recompute Cholesky decomposition for a new matrix
+ *
+ * @param[in] matrix Matrix to decompose.
+ * @param[in] compress Use zero-row/column compression (defaults to true).
+ * @return True if the symbolic analysis was reused.
+ *
+ * Replaces the Cholesky decomposition held by this object by the Cholesky
+ * decomposition of @p matrix.
+ *
+ * If the object already holds a decomposition and @p matrix has (after
+ * zero-row/column compression) the same sparsity pattern as the matrix
+ * that was decomposed before, the symbolic analysis (fill-reducing
+ * ordering, elimination tree and column counts) is reused and only the
+ * numeric factorisation is computed. Otherwise a full decomposition is
+ * done. This allows to efficiently decompose a sequence of matrices with
+ * a fixed pattern, for example the curvature matrices of successive
+ * iterations of an optimizer:
+ *
+ *     GMatrixSparse decomposition;
+ *     for (...) {
+ *         decomposition.cholesky_refactor(curvature);
+ *         GVector x = decomposition.cholesky_solver(gradient);
+ *     }
+ ***************************************************************************/
+bool GMatrixSparse::cholesky_refactor(const GMatrixSparse& matrix,
+                                      const bool&          compress)
 {
     // Create copy of matrix
-    GMatrixSparse matrix = *this;
+    GMatrixSparse work = matrix;
 
     // Save original matrix size
-    int matrix_rows = matrix.m_rows;
-    int matrix_cols = matrix.m_cols;
+    int matrix_rows = work.m_rows;
+    int matrix_cols = work.m_cols;
 
     // Delete any existing symbolic and numeric analysis object and reset
     // pointers
-    if (matrix.m_symbolic != NULL) delete matrix.m_symbolic;
-    if (matrix.m_numeric  != NULL) delete matrix.m_numeric;
-    matrix.m_symbolic = NULL;
-    matrix.m_numeric  = NULL;
-
-    // Allocate symbolic analysis object
-    GSparseSymbolic* symbolic = new GSparseSymbolic();
+    if (work.m_symbolic != NULL) delete work.m_symbolic;
+    if (work.m_numeric  != NULL) delete work.m_numeric;
+    work.m_symbolic = NULL;
+    work.m_numeric  = NULL;
 
     // Declare numeric analysis object. We don't allocate one since we'll
     // throw it away at the end of the function (the L matrix will be copied
@@ -1643,42 +1946,59 @@ GMatrixSparse GMatrixSparse::cholesky_decompose(const bool& compress) const
     GSparseNumeric numeric;
 
     // Fill pending element into matrix
-    matrix.fill_pending();
+    work.fill_pending();
 
     // Remove rows and columns containing only zeros if matrix compression
     // has been selected
     if (compress) {
-        matrix.remove_zero_row_col();
+        work.remove_zero_row_col();
     }
 
-    // Ordering an symbolic analysis of matrix. This sets up an array 'pinv'
-    // which contains the fill-in reducing permutations
-    symbolic->cholesky_symbolic_analysis(1, matrix);
+    // Determine whether the existing symbolic analysis can be reused
+    bool reuse = (m_symbolic  != NULL        &&
+                  m_rows      == matrix_rows &&
+                  m_cols      == matrix_cols &&
+                  m_symbolic->has_pattern(work));
+
+    // Allocate symbolic analysis object and store it in the sparse matrix
+    // object
+    GSparseSymbolic* symbolic = new GSparseSymbolic();
+    work.m_symbolic = symbolic;
 
-    // Store symbolic pointer in sparse matrix object
-    matrix.m_symbolic = symbolic;
+    // Copy the symbolic analysis if it can be reused, otherwise perform the
+    // ordering and symbolic analysis of the matrix. This sets up an array
+    // 'pinv' which contains the fill-in reducing permutations
+    if (reuse) {
+        *symbolic = *m_symbolic;
+    }
+    else {
+        symbolic->cholesky_symbolic_analysis(1, work);
+    }
 
     // Perform numeric Cholesky decomposition
-    numeric.cholesky_numeric_analysis(matrix, *symbolic);
+    numeric.cholesky_numeric_analysis(work, *symbolic);
 
     // Copy L matrix into this object
-    matrix.free_elements(0, matrix.m_elements);
-    matrix.alloc_elements(0, numeric.m_L->m_elements);
-    for (int i = 0; i < matrix.m_elements; ++i) {
-        matrix.m_data[i]   = numeric.m_L->m_data[i];
-        matrix.m_rowinx[i] = numeric.m_L->m_rowinx[i];
+    work.free_elements(0, work.m_elements);
+    work.alloc_elements(0, numeric.m_L->m_elements);
+    for (int i = 0; i < work.m_elements; ++i) {
+        work.m_data[i]   = numeric.m_L->m_data[i];
+        work.m_rowinx[i] = numeric.m_L->m_rowinx[i];
     }
-    for (int col = 0; col <= matrix.m_cols; ++col) {
-        matrix.m_colstart[col] = numeric.m_L->m_colstart[col];
+    for (int col = 0; col <= work.m_cols; ++col) {
+        work.m_colstart[col] = numeric.m_L->m_colstart[col];
     }
 
     // Insert zero rows and columns if they have been removed previously.
     if (compress) {
-        matrix.insert_zero_row_col(matrix_rows, matrix_cols);
+        work.insert_zero_row_col(matrix_rows, matrix_cols);
     }
 
-    // Return matrix
-    return matrix;
+    // Store decomposition
+    *this = work;
+
+    // Return reuse flag
+    return reuse;
 }
 
 
@@ -1915,6 +2235,225 @@ GVector GMatrixSparse::cholesky_solver(const GVector& vector,
 }
 
 
+/***********************************************************************//**
+ * @brief Cholesky solver for multiple right-hand sides
+ *
+ * @param[in] matrix Matrix of right-hand sides.
+ * @param[in] compress Request matrix compression.
+ * @return Matrix of solutions.
+ *
+ * @exception GException::matrix_mismatch
+ *            Matrix dimensions do not match.
+ * @exception GException::matrix_not_factorised
+ *            Matrix has not been factorised.
+ *
+ * Solves the linear equation A*X=B using a Cholesky decomposition of A,
+ * where each column of B is a right-hand side. This function is to be
+ * applied on a GMatrixSparse matrix for which a Choleksy factorization has
+ * been produced using 'cholesky_decompose'.
+ *
+ * The right-hand sides are solved in blocks. Within a block, the values
+ * of all right-hand sides for a given row are stored contiguously, so
+ * that each element of the Cholesky factor is loaded only once per block
+ * and applied to all right-hand sides of the block in an inner loop.
+ ***************************************************************************/
+GMatrix GMatrixSparse::cholesky_solver(const GMatrix& matrix,
+                                       const bool&    compress) const
+{
+    // Raise an exception if the matrix dimensions are incompatible
+    if (m_rows != matrix.rows()) {
+        throw GException::matrix_mismatch(G_CHOL_SOLVE_MAT,
+                                          matrix.rows(), matrix.columns(),
+                                          m_rows, m_cols);
+    }
+
+    // Raise an exception if there is no symbolic pointer or permutation
+    if (!m_symbolic || !m_symbolic->m_pinv) {
+        throw GException::matrix_not_factorised(G_CHOL_SOLVE_MAT,
+                                                "Cholesky decomposition");
+    }
+
+    // Get row and column mappings
+    std::vector<int> row_map;
+    std::vector<int> row_inx;
+    std::vector<int> col_inx;
+    cholesky_maps(compress, row_map, row_inx, col_inx);
+    int num_rows = row_inx.size();
+    int num_cols = col_inx.size();
+
+    // Allocate result matrix
+    int     nrhs = matrix.columns();
+    GMatrix result(m_cols, nrhs);
+
+    // Setup pointers to L matrix and permutation
+    const int*    Lp   = m_colstart;
+    const int*    Li   = m_rowinx;
+    const double* Lx   = m_data;
+    const int*    pinv = m_symbolic->m_pinv;
+
+    // Allocate working array that holds a block of right-hand sides
+    std::vector<double> work(num_rows * cholesky_block_size);
+
+    // Loop over blocks of right-hand sides
+    for (int first = 0; first < nrhs; first += cholesky_block_size) {
+
+        // Set number of right-hand sides in block
+        int nb = (first + cholesky_block_size < nrhs) ? cholesky_block_size
+                                                      : nrhs - first;
+
+        // Compress and permute right-hand sides
+        for (int c_row = 0; c_row < num_rows; ++c_row) {
+            double* x = &work[pinv[c_row] * nb];
+            for (int k = 0; k < nb; ++k) {
+                x[k] = matrix(row_inx[c_row], first + k);
+            }
+        }
+
+        // Inplace solve L\X=X
+        for (int c_col = 0; c_col < num_cols; ++c_col) {
+            int     col  = col_inx[c_col];
+            double* xcol = &work[c_col * nb];
+            double  diag = 1.0 / Lx[Lp[col]];
+            for (int k = 0; k < nb; ++k) {
+                xcol[k] *= diag;
+            }
+            for (int p = Lp[col]+1; p < Lp[col+1]; ++p) {
+                int c_row = row_map[Li[p]];
+                if (c_row >= 0) {
+                    double* xrow = &work[c_row * nb];
+                    double  l    = Lx[p];
+                    for (int k = 0; k < nb; ++k) {
+                        xrow[k] -= l * xcol[k];
+                    }
+                }
+            }
+        }
+
+        // Inplace solve L'\X=X
+        for (int c_col = num_cols-1; c_col >= 0; --c_col) {
+            int     col  = col_inx[c_col];
+            double* xcol = &work[c_col * nb];
+            for (int p = Lp[col]+1; p < Lp[col+1]; ++p) {
+                int c_row = row_map[Li[p]];
+                if (c_row >= 0) {
+                    const double* xrow = &work[c_row * nb];
+                    double        l    = Lx[p];
+                    for (int k = 0; k < nb; ++k) {
+                        xcol[k] -= l * xrow[k];
+                    }
+                }
+            }
+            double diag = 1.0 / Lx[Lp[col]];
+            for (int k = 0; k < nb; ++k) {
+                xcol[k] *= diag;
+            }
+        }
+
+        // Permute and expand solutions
+        for (int c_col = 0; c_col < num_cols; ++c_col) {
+            const double* x = &work[pinv[c_col] * nb];
+            for (int k = 0; k < nb; ++k) {
+                result(col_inx[c_col], first + k) = x[k];
+            }
+        }
+
+    } // endfor: looped over blocks of right-hand sides
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Return diagonal of inverse matrix
+ *
+ * @param[in] compress Request matrix compression.
+ * @return Diagonal elements of inverse matrix.
+ *
+ * @exception GException::matrix_not_square
+ *            Matrix is not square.
+ * @exception GException::matrix_not_factorised
+ *            Matrix has not been factorised.
+ *
+ * Returns the diagonal elements of the inverse of a matrix A without
+ * computing the full inverse. This function is to be applied on a
+ * GMatrixSparse matrix for which a Choleksy factorization has been
+ * produced using 'cholesky_decompose'.
+ *
+ * With A = P' L L' P, the diagonal element i of the inverse is given by
+ * the squared norm of L^-1 e_j, where e_j is the unit vector of the
+ * permuted index j of i. Since L is lower triangular, the forward solve
+ * for e_j only involves the columns j and beyond, and columns for which
+ * the intermediate solution is zero are skipped. No backward solve is
+ * needed. Diagonal elements of rows and columns that were removed by
+ * compression are set to zero.
+ ***************************************************************************/
+GVector GMatrixSparse::cholesky_inverse_diagonal(const bool& compress) const
+{
+    // Raise an exception if the matrix is not square
+    if (m_rows != m_cols) {
+        throw GException::matrix_not_square(G_CHOL_INV_DIAG, m_rows, m_cols);
+    }
+
+    // Raise an exception if there is no symbolic pointer or permutation
+    if (!m_symbolic || !m_symbolic->m_pinv) {
+        throw GException::matrix_not_factorised(G_CHOL_INV_DIAG,
+                                                "Cholesky decomposition");
+    }
+
+    // Get row and column mappings
+    std::vector<int> row_map;
+    std::vector<int> row_inx;
+    std::vector<int> col_inx;
+    cholesky_maps(compress, row_map, row_inx, col_inx);
+    int num_cols = col_inx.size();
+
+    // Allocate result vector and working vector
+    GVector             result(m_rows);
+    std::vector<double> x(row_inx.size(), 0.0);
+
+    // Setup pointers to L matrix and permutation
+    const int*    Lp   = m_colstart;
+    const int*    Li   = m_rowinx;
+    const double* Lx   = m_data;
+    const int*    pinv = m_symbolic->m_pinv;
+
+    // Loop over all non-zero rows
+    for (int c_row = 0; c_row < (int)row_inx.size(); ++c_row) {
+
+        // Set permuted unit vector
+        int start = pinv[c_row];
+        x[start]  = 1.0;
+
+        // Inplace solve L\x=x, starting from the unit vector element and
+        // accumulating the squared norm of the solution
+        double sum = 0.0;
+        for (int c_col = start; c_col < num_cols; ++c_col) {
+            double value = x[c_col];
+            if (value != 0.0) {
+                int col   = col_inx[c_col];
+                value    /= Lx[Lp[col]];
+                sum      += value * value;
+                x[c_col]  = 0.0;
+                for (int p = Lp[col]+1; p < Lp[col+1]; ++p) {
+                    int c = row_map[Li[p]];
+                    if (c >= 0) {
+                        x[c] -= Lx[p] * value;
+                    }
+                }
+            }
+        }
+
+        // Store diagonal element
+        result[row_inx[c_row]] = sum;
+
+    } // endfor: looped over rows
+
+    // Return result
+    return result;
+}
+
+
 /***********************************************************************//**
  * @brief Invert matrix using a Cholesky decomposition
  *
@@ -2551,6 +3090,161 @@ void GMatrixSparse::stack_destroy(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Initialise value accumulation on a shared pattern
+ *
+ * @param[in] matrix Matrix providing the pattern.
+ *
+ * @exception GException::matrix_mismatch
+ *            Incompatible matrix size.
+ *
+ * Initialises the accumulation of values on the pattern of @p matrix. If
+ * @p matrix accumulates itself values on a shared pattern, that pattern is
+ * used, otherwise the pattern of the @p matrix elements is used. The
+ * pattern is not copied, hence @p matrix needs to exist and its elements
+ * must not change as long as values are accumulated on its pattern.
+ *
+ * Once initialised, the add_to_column() methods add all elements that
+ * exist in the pattern to an array of pattern values, so that no matrix
+ * elements need to be inserted. Elements that are not part of the pattern
+ * are added to the matrix elements, using the fill stack if it exists.
+ * The pattern values are added to the matrix elements by pattern_destroy()
+ * and are merged by add_matrices().
+ *
+ * If @p matrix has no elements, or if @p matrix is the matrix itself, the
+ * method does nothing.
+ ***************************************************************************/
+void GMatrixSparse::pattern_init(const GMatrixSparse& matrix)
+{
+    // Raise an exception if the matrix dimensions are not compatible
+    if (m_rows != matrix.m_rows || m_cols != matrix.m_cols) {
+        throw GException::matrix_mismatch(G_PATTERN_INIT,
+                                          m_rows, m_cols,
+                                          matrix.m_rows, matrix.m_cols);
+    }
+
+    // Continue only if matrix is not the matrix itself
+    if (&matrix != this) {
+
+        // Destroy any existing pattern
+        pattern_destroy();
+
+        // Share the pattern on which the matrix accumulates values, or
+        // the pattern of the matrix elements
+        if (matrix.m_pattern_data != NULL) {
+            m_pattern_colstart = matrix.m_pattern_colstart;
+            m_pattern_rowinx   = matrix.m_pattern_rowinx;
+            m_pattern_elements = matrix.m_pattern_elements;
+        }
+        else if (matrix.m_elements > 0) {
+            m_pattern_colstart = matrix.m_colstart;
+            m_pattern_rowinx   = matrix.m_rowinx;
+            m_pattern_elements = matrix.m_elements;
+        }
+
+        // Allocate and initialise pattern values
+        if (m_pattern_elements > 0) {
+            m_pattern_data = new double[m_pattern_elements];
+            for (int i = 0; i < m_pattern_elements; ++i) {
+                m_pattern_data[i] = 0.0;
+            }
+        }
+        else {
+            init_pattern_members();
+        }
+
+    } // endif: matrix was not the matrix itself
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destroy value accumulation on a shared pattern
+ *
+ * Adds the values accumulated on the shared pattern to the matrix elements
+ * and releases the pattern. Values that are zero are not added. If the
+ * matrix has no elements, the pattern values simply become the matrix
+ * elements.
+ ***************************************************************************/
+void GMatrixSparse::pattern_destroy(void)
+{
+    // Continue only if values are accumulated on a pattern
+    if (m_pattern_data != NULL) {
+
+        // Fill pending element
+        fill_pending();
+
+        // If the matrix has no elements then copy the pattern values with
+        // their row indices into the matrix elements
+        if (m_elements == 0) {
+
+            // Count non-zero pattern values
+            int elements = 0;
+            for (int i = 0; i < m_pattern_elements; ++i) {
+                if (m_pattern_data[i] != 0.0) {
+                    elements++;
+                }
+            }
+
+            // Allocate element arrays
+            int*    colstart = new int[m_cols+1];
+            double* data     = NULL;
+            int*    rowinx   = NULL;
+            if (elements > 0) {
+                data   = new double[elements];
+                rowinx = new int[elements];
+            }
+
+            // Copy non-zero pattern values
+            int inx = 0;
+            for (int col = 0; col < m_cols; ++col) {
+                colstart[col] = inx;
+                for (int i = m_pattern_colstart[col]; i < m_pattern_colstart[col+1]; ++i) {
+                    if (m_pattern_data[i] != 0.0) {
+                        data[inx]   = m_pattern_data[i];
+                        rowinx[inx] = m_pattern_rowinx[i];
+                        inx++;
+                    }
+                }
+            }
+            colstart[m_cols] = inx;
+
+            // Replace matrix elements
+            if (m_colstart != NULL) delete [] m_colstart;
+            if (m_data     != NULL) delete [] m_data;
+            if (m_rowinx   != NULL) delete [] m_rowinx;
+            m_colstart = colstart;
+            m_data     = data;
+            m_rowinx   = rowinx;
+            m_elements = elements;
+            m_alloc    = elements;
+
+            // Free pattern members
+            free_pattern_members();
+
+        } // endif: matrix had no elements
+
+        // ... otherwise hand the pattern values over to a matrix and add
+        // that matrix to the matrix elements
+        else {
+            GMatrixSparse values(m_rows, m_cols);
+            values.m_pattern_colstart = m_pattern_colstart;
+            values.m_pattern_rowinx   = m_pattern_rowinx;
+            values.m_pattern_data     = m_pattern_data;
+            values.m_pattern_elements = m_pattern_elements;
+            init_pattern_members();
+            add_matrices(std::vector<const GMatrixSparse*>(1, &values));
+        }
+
+    } // endif: values were accumulated on a pattern
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -2572,8 +3266,9 @@ void GMatrixSparse::init_members(void)
     m_symbolic  = NULL;
     m_numeric   = NULL;
 
-    // Initialise stack members
+    // Initialise stack and pattern members
     init_stack_members();
+    init_pattern_members();
 
     // Return
     return;
@@ -2602,6 +3297,17 @@ void GMatrixSparse::copy_members(const GMatrixSparse& matrix)
         }
     }
 
+    // Share the pattern and copy the pattern values if they exist
+    if (matrix.m_pattern_data != NULL) {
+        m_pattern_colstart = matrix.m_pattern_colstart;
+        m_pattern_rowinx   = matrix.m_pattern_rowinx;
+        m_pattern_elements = matrix.m_pattern_elements;
+        m_pattern_data     = new double[m_pattern_elements];
+        for (int i = 0; i < m_pattern_elements; ++i) {
+            m_pattern_data[i] = matrix.m_pattern_data[i];
+        }
+    }
+
     // Clone symbolic decomposition if it exists
     if (matrix.m_symbolic != NULL) {
         m_symbolic  = new GSparseSymbolic();
@@ -2634,8 +3340,9 @@ void GMatrixSparse::free_members(void)
     m_symbolic = NULL;
     m_numeric  = NULL;
 
-    // Free stack members
+    // Free stack and pattern members
     free_stack_members();
+    free_pattern_members();
 
     // Return
     return;
@@ -2745,6 +3452,76 @@ void GMatrixSparse::free_stack_members(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Initialise shared pattern members
+ ***************************************************************************/
+void GMatrixSparse::init_pattern_members(void)
+{
+    // Initialise pattern members
+    m_pattern_colstart = NULL;
+    m_pattern_rowinx   = NULL;
+    m_pattern_data     = NULL;
+    m_pattern_elements = 0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete shared pattern members
+ *
+ * Deletes the pattern values. The pattern itself is not owned by the
+ * matrix and is not deleted.
+ ***************************************************************************/
+void GMatrixSparse::free_pattern_members(void)
+{
+    // Free pattern values
+    if (m_pattern_data != NULL) delete [] m_pattern_data;
+
+    // Properly mark members as free
+    init_pattern_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add value arrays to an array
+ *
+ * @param[in,out] data Array to which the values are added.
+ * @param[in] elements Number of array elements.
+ * @param[in] values Value arrays to be added.
+ *
+ * Adds all @p values arrays element-wise to @p data. The value arrays are
+ * added in the order of the @p values vector and the elements are
+ * distributed over the available threads if OpenMP is available.
+ ***************************************************************************/
+void GMatrixSparse::add_values(double*                           data,
+                               const int&                        elements,
+                               const std::vector<const double*>& values) const
+{
+    // Get number of value arrays
+    int nvalues = values.size();
+
+    // Continue only if there are values
+    if (nvalues > 0) {
+        #pragma omp parallel for
+        for (int i = 0; i < elements; ++i) {
+            double sum = data[i];
+            for (int k = 0; k < nvalues; ++k) {
+                sum += values[k][i];
+            }
+            data[i] = sum;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Determines element index for (row,column)
  *
@@ -3267,6 +4044,171 @@ void GMatrixSparse::insert_zero_row_col(const int& rows, const int& cols)
 }
 
 
+/***********************************************************************//**
+ * @brief Setup row and column mappings for Cholesky solvers
+ *
+ * @param[in] compress Request matrix compression.
+ * @param[out] row_map Mapping from matrix rows into compressed rows.
+ * @param[out] row_inx Matrix rows of compressed rows.
+ * @param[out] col_inx Matrix columns of compressed columns.
+ *
+ * Sets up the mappings between matrix rows and columns and the rows and
+ * columns of a Cholesky decomposition that has been computed with
+ * zero-row/column compression. An entry of -1 in @p row_map indicates
+ * that the row has been dropped. If no compression is requested or
+ * needed, identity mappings are returned.
+ ***************************************************************************/
+void GMatrixSparse::cholesky_maps(const bool&       compress,
+                                  std::vector<int>& row_map,
+                                  std::vector<int>& row_inx,
+                                  std::vector<int>& col_inx) const
+{
+    // Flag row and column compression
+    bool row_compressed = (compress && m_rowsel != NULL && m_num_rowsel < m_rows);
+    bool col_compressed = (compress && m_colsel != NULL && m_num_colsel < m_cols);
+
+    // Setup row mappings
+    if (row_compressed) {
+        row_map.assign(m_rows, -1);
+        row_inx.assign(m_rowsel, m_rowsel + m_num_rowsel);
+        for (int c_row = 0; c_row < m_num_rowsel; ++c_row) {
+            row_map[m_rowsel[c_row]] = c_row;
+        }
+    }
+    else {
+        row_map.resize(m_rows);
+        for (int row = 0; row < m_rows; ++row) {
+            row_map[row] = row;
+        }
+        row_inx = row_map;
+    }
+
+    // Setup column mappings
+    if (col_compressed) {
+        col_inx.assign(m_colsel, m_colsel + m_num_colsel);
+    }
+    else {
+        col_inx.resize(m_cols);
+        for (int col = 0; col < m_cols; ++col) {
+            col_inx[col] = col;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Add compressed array to matrix elements of column
+ *
+ * @param[in] column Column index [0,...,columns()-1].
+ * @param[in] values Compressed array.
+ * @param[in] rows Row indices of array.
+ * @param[in] number Number of elements in array.
+ *
+ * @exception GException::out_of_range
+ *            Invalid column index specified.
+ * @exception GException::matrix_vector_mismatch
+ *            Matrix dimension mismatches the vector size.
+ *
+ * Adds the content of a compressed array to the matrix elements of a
+ * column, using the fill stack if it exists. Values accumulated on a shared
+ * pattern are not considered.
+ ***************************************************************************/
+void GMatrixSparse::add_column_elements(const int& column, const double* values,
+                                        const int* rows, int number)
+{
+    // If we have a stack then try to push elements on stack first. Note that
+    // stack_push_column does its own argument verifications, so to avoid
+    // double checking we don't do anything before this call ...
+    if (m_stack_data != NULL) {
+        number = stack_push_column(values, rows, number, column);
+        if (number == 0) {
+            return;
+        }
+    }
+
+    // ... otherwise check the arguments
+    else {
+        // If the array is empty there is nothing to do
+        if (!values || !rows || (number < 1)) {
+            return;
+        }
+
+        // Raise an exception if the column index is invalid
+        #if defined(G_RANGE_CHECK)
+        if (column < 0 || column >= m_cols) {
+            throw GException::out_of_range(G_ADD_TO_COLUMN2, column, 0, m_cols-1);
+        }
+        #endif
+
+        // Raise an exception if the matrix and vector dimensions are incompatible
+        if (rows[number-1] >= m_rows) {
+            throw GException::matrix_vector_mismatch(G_ADD_TO_COLUMN2, rows[number-1],
+                                                     m_rows, m_cols);
+        }
+
+    } // endelse: there was no stack
+
+    // Get indices of column in matrix
+    int i_start = m_colstart[column];
+    int i_stop  = m_colstart[column+1];
+
+    // Case A: the column exists in the matrix, so mix new elements with existing
+    // data
+    if (i_start < i_stop) {
+
+        // Fill pending element before the merge (it will be lost otherwise)
+        fill_pending();
+
+        // Allocate workspace to hold combined column
+        int     wrk_size   = number + i_stop - i_start;
+        double* wrk_double = new double[wrk_size];
+        int*    wrk_int    = new int[wrk_size];
+
+        // Mix matrix column with specified data
+        int num_mix;
+        mix_column(&(m_data[i_start]), &(m_rowinx[i_start]), i_stop-i_start,
+                   values, rows, number,
+                   wrk_double, wrk_int, &num_mix);
+
+        // Insert mixed column
+        this->column(column, wrk_double, wrk_int, num_mix);
+
+        // Free workspace
+        delete [] wrk_int;
+        delete [] wrk_double;
+
+    } // endif: Case A
+
+    // Case B: the column does not yet exist in the matrix, so just insert it
+    else {
+        this->column(column, values, rows, number);
+    }
+
+    // Debugging: show sparse matrix after insertion
+    #if defined(G_DEBUG_SPARSE_ADDITION)
+    std::cout << " Out Data: ";
+    for (int i = 0; i < m_elements; ++i) {
+        std::cout << m_data[i] << " ";
+    }
+    std::cout << std::endl << " Out Row : ";
+    for (int i = 0; i < m_elements; ++i) {
+        std::cout << m_rowinx[i] << " ";
+    }
+    std::cout << std::endl << " Out Col : ";
+    for (int i = 0; i < m_cols+1; ++i) {
+        std::cout << m_colstart[i] << " ";
+    }
+    std::cout << std::endl;
+    #endif
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Prepare mix of sparse columns
  *
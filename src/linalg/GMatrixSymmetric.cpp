@@ -35,6 +35,7 @@
 #include "GMatrix.hpp"
 #include "GMatrixSparse.hpp"
 #include "GMatrixSymmetric.hpp"
+#include "GMatrixKernels.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_CONSTRUCTOR        "GMatrixSymmetric::GMatrixSymmetric(int&, int&)"
@@ -51,12 +52,19 @@
 #define G_SET_COLUMN               "GMatrixSymmetric::column(int&, GVector&)"
 #define G_ADD_TO_ROW           "GMatrixSymmetric::add_to_row(int&, GVector&)"
 #define G_ADD_TO_COLUMN     "GMatrixSymmetric::add_to_column(int&, GVector&)"
+#define G_RANK1_UPDATE   "GMatrixSymmetric::rank1_update(double&, GVector&,"\
+                                                               " int*, int&)"
 #define G_CHOL_DECOMP            "GMatrixSymmetric::cholesky_decompose(int&)"
 #define G_CHOL_SOLVE      "GMatrixSymmetric::cholesky_solver(GVector&, int&)"
 #define G_CHOL_INVERT               "GMatrixSymmetric::cholesky_invert(int&)"
+#define G_CHOL_SOLVE_MAT "GMatrixSymmetric::cholesky_solver(GMatrix&, bool&)"
+#define G_CHOL_INV_DIAG  "GMatrixSymmetric::cholesky_inverse_diagonal(bool&)"
 #define G_COPY_MEMBERS    "GMatrixSymmetric::copy_members(GMatrixSymmetric&)"
 #define G_ALLOC_MEMBERS         "GMatrixSymmetric::alloc_members(int&, int&)"
 
+/* __ Constants __________________________________________________________ */
+const int cholesky_block_size = 32;  //!< Right-hand sides solved at once
+
 
 /*==========================================================================
  =                                                                         =
@@ -710,6 +718,59 @@ void GMatrixSymmetric::add_to_column(const int& column, const GVector& vector)
 }
 
 
+/***********************************************************************//**
+ * @brief Add symmetric rank-1 update to matrix
+ *
+ * @param[in] alpha Scaling factor.
+ * @param[in] vector Vector.
+ * @param[in] inx Indices of vector elements.
+ * @param[in] number Number of indices.
+ *
+ * @exception GException::matrix_vector_mismatch
+ *            Matrix dimension mismatches the vector size.
+ *
+ * Adds the outer product alpha * vector * vector^T to the matrix, where
+ * only the vector elements with the indices @p inx are considered. All
+ * other vector elements are assumed to be zero. This corresponds to the
+ * BLAS SYR operation on the rows and columns given by @p inx. Each index
+ * should occur only once in @p inx.
+ *
+ * Since only one triangle of the matrix is stored, each element is updated
+ * only once, which makes the method about twice as fast as adding the
+ * columns of the outer product to a general matrix.
+ ***************************************************************************/
+void GMatrixSymmetric::rank1_update(const double& alpha, const GVector& vector,
+                                    const int* inx, const int& number)
+{
+    // Raise an exception if the matrix and vector dimensions are not
+    // compatible
+    if (m_rows != vector.size()) {
+        throw GException::matrix_vector_mismatch(G_RANK1_UPDATE, vector.size(),
+                                                 m_rows, m_cols);
+    }
+
+    // Loop over columns
+    for (int j = 0; j < number; ++j) {
+
+        // Get column and scaled column value
+        int    col   = inx[j];
+        double value = alpha * vector[col];
+
+        // Loop over rows of lower triangle
+        for (int i = j; i < number; ++i) {
+            int row = inx[i];
+            int k   = (row >= col) ? m_colstart[col]+(row-col)
+                                   : m_colstart[row]+(col-row);
+            m_data[k] += value * vector[row];
+        }
+
+    } // endfor: looped over columns
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return inverted matrix
  *
@@ -907,12 +968,15 @@ GMatrix GMatrixSymmetric::extract_upper_triangle(void) const
  * Returns the Cholesky decomposition of a sparse matrix. The decomposition
  * is stored within a GMatrixSymmetric object.
  *
- * The method is inspired by the algorithm found in Numerical Recipes.
  * The decomposition, which is a matrix occupying only the lower triange,
  * is stored in the elements of the symmetric matrix. To visualise the
  * matrix one has to use 'lower_triangle()' to extract the relevant part.
- * Case A operates on a full matrix, Case B operates on a (logically)
- * compressed matrix where zero rows/columns have been removed.
+ * Case A operates on a full matrix, Case B operates on a compressed copy
+ * of the matrix where zero rows/columns have been removed.
+ *
+ * The decomposition is computed by the blocked gammalib::potrf() kernel,
+ * or by the LAPACK routine dpptrf if GammaLib was configured with LAPACK
+ * support.
  ***************************************************************************/
 GMatrixSymmetric GMatrixSymmetric::cholesky_decompose(const bool& compress) const
 {
@@ -930,67 +994,33 @@ GMatrixSymmetric GMatrixSymmetric::cholesky_decompose(const bool& compress) cons
     // Case A: no zero-row/col compression needed
     if (no_zeros) {
 
-        // Loop over upper triangle (col >= row)
-        double diag = 0.0;
-        for (int row = 0; row < matrix.m_rows; ++row) {
-            double* ptr = matrix.m_data + matrix.m_colstart[row];
-            for (int col = row; col < matrix.m_cols; ++col, ++ptr) {
-                // sum = M(row,col)
-                double sum = *ptr;
-                for (int k = 0; k < row; ++k) {
-                    int offset = matrix.m_colstart[k] - k; // is always positive
-                    sum -= matrix.m_data[offset+row] * matrix.m_data[offset+col]; // sum -= M(row,k)*M(col,k)
-                }
-                if (row == col) {
-                    if (sum <= 0.0) {
-                        throw GException::matrix_not_pos_definite(G_CHOL_DECOMP, row, sum);
-                    }
-                    *ptr = std::sqrt(sum);  // M(row,row) = sqrt(sum)
-                    diag = 1.0/(*ptr);
-                }
-                else {
-                    *ptr = sum*diag; // M(row,col) = sum/M(row,row)
-                }
-            }
+        // Decompose matrix in place
+        double pivot = 0.0;
+        int    row   = gammalib::potrf(matrix.m_rows, matrix.m_data, &pivot);
+        if (row >= 0) {
+            throw GException::matrix_not_pos_definite(G_CHOL_DECOMP, row, pivot);
         }
+
     } // endif: there were no zero rows/cols in matrix
 
     // Case B: zero-row/col compression needed
     else if (matrix.m_num_inx > 0) {
 
-        // Allocate loop variables and pointers
-        int  row;
-        int  col;
-        int  k;
-        int* row_ptr;
-        int* col_ptr;
-        int* k_ptr;
+        // Gather compressed matrix
+        std::vector<double> packed = matrix.pack_inx();
 
-        // Loop over upper triangle (col >= row)
-        double diag = 0.0;
-        for (row = 0, row_ptr = matrix.m_inx; row < matrix.m_num_inx; ++row, ++row_ptr) {
-            double* ptr_0 = matrix.m_data + matrix.m_colstart[*row_ptr] - *row_ptr;
-            for (col = row, col_ptr = matrix.m_inx + row; col < matrix.m_num_inx; ++col, ++col_ptr) {
-                double* ptr = ptr_0 + *col_ptr;
-                double  sum = *ptr;                                  // sum = M(row,col)
-                for (k = 0, k_ptr = matrix.m_inx; k < row; ++k, ++k_ptr) {
-                    int offset = matrix.m_colstart[*k_ptr] - *k_ptr;        // is always positive
-                    sum       -= matrix.m_data[offset+*row_ptr] *
-                                 matrix.m_data[offset+*col_ptr];
-                                                                     // sum -= M(row,k)*M(col,k)
-                }
-                if (*row_ptr == *col_ptr) {
-                    if (sum <= 0.0) {
-                        throw GException::matrix_not_pos_definite(G_CHOL_DECOMP, *row_ptr, sum);
-                    }
-                    *ptr = std::sqrt(sum); // M(row,row) = sqrt(sum)
-                    diag = 1.0/(*ptr);
-                }
-                else {
-                    *ptr = sum*diag; // M(row,col) = sum/M(row,row)
-                }
-            }
+        // Decompose compressed matrix
+        double pivot = 0.0;
+        int    row   = gammalib::potrf(matrix.m_num_inx, &(packed[0]), &pivot);
+        if (row >= 0) {
+            throw GException::matrix_not_pos_definite(G_CHOL_DECOMP,
+                                                      matrix.m_inx[row],
+                                                      pivot);
         }
+
+        // Scatter decomposition back into matrix
+        matrix.unpack_inx(packed);
+
     } // endelse: zero-row/col compression needed
 
     // Case C: all matrix elements are zero
@@ -1099,130 +1129,206 @@ GVector GMatrixSymmetric::cholesky_solver(const GVector& vector,
 
 
 /***********************************************************************//**
- * @brief Invert matrix using a Cholesky decomposition
+ * @brief Cholesky solver for multiple right-hand sides
  *
- * @param[in] compress Use zero-row/column compression (defaults to true).
- * @return Inverted matrix.
+ * @param[in] matrix Matrix of right-hand sides.
+ * @param[in] compress Request matrix compression.
+ * @return Matrix of solutions.
  *
+ * @exception GException::matrix_mismatch
+ *            Matrix dimensions do not match.
  * @exception GException::matrix_zero
  *            All matrix elements are zero.
  *
- * Inverts the matrix using a Cholesky decomposition.
+ * Solves the linear equation A*X=B using a Cholesky decomposition of A,
+ * where each column of B is a right-hand side. This function is to be
+ * applied on a decomposition GMatrixSymmetric matrix that is produced by
+ * 'cholesky_decompose'.
  *
- * The method distinguish two cases. Case A operates on a full matrix while
- * Case B operates on a (logically) compressed matrix where all zero
- * rows/columns are skipped.
+ * The right-hand sides are solved in blocks. Within a block, the values
+ * of all right-hand sides for a given row are stored contiguously, so
+ * that each element of the Cholesky factor is loaded only once per block
+ * and applied to all right-hand sides of the block in an inner loop.
  ***************************************************************************/
-GMatrixSymmetric GMatrixSymmetric::cholesky_invert(const bool& compress) const
+GMatrix GMatrixSymmetric::cholesky_solver(const GMatrix& matrix,
+                                          const bool&    compress) const
 {
-    // Generate Cholesky decomposition of matrix
-    GMatrixSymmetric matrix = cholesky_decompose(compress);
-
-    // Check if zero-row/col compression is needed
-    int no_zeros = ((compress && (matrix.m_num_inx == matrix.m_rows)) || !compress);
+    // Raise an exception if the matrix dimensions are not compatible
+    if (m_rows != matrix.rows()) {
+        throw GException::matrix_mismatch(G_CHOL_SOLVE_MAT,
+                                          matrix.rows(), matrix.columns(),
+                                          m_rows, m_cols);
+    }
 
-    // Case A: no zero-row/col compression needed
-    if (no_zeros) {
+    // Get indices of non-zero rows/columns
+    std::vector<int> inx = cholesky_inx(compress, G_CHOL_SOLVE_MAT);
+    int              num = inx.size();
 
-        // Generate inverse of Cholesky decomposition (col>row)
-        for (int row = 0; row < matrix.m_rows; ++row) {
+    // Allocate result matrix
+    int     nrhs = matrix.columns();
+    GMatrix result(m_rows, nrhs);
 
-            // M(row,row) = 1/M(row,row)
-            double* ptr = matrix.m_data + matrix.m_colstart[row];
-            *ptr        = 1.0/(*ptr);
+    // Allocate working array that holds a block of right-hand sides
+    std::vector<double> work(num * cholesky_block_size);
 
-            for (int col = row+1; col < matrix.m_cols; ++col) {
+    // Loop over blocks of right-hand sides
+    for (int first = 0; first < nrhs; first += cholesky_block_size) {
 
-                // sum -= M(col,k)*M(k,row)
-                double   sum = 0.0;
-                double* ptr1 = matrix.m_data + col - row;
-                double* ptr2 = ptr;
-                for (int k = row; k < col; ++k) {
-                    sum -= *(ptr1-- + matrix.m_colstart[k]) * *ptr2++;
-                }
+        // Set number of right-hand sides in block
+        int nb = (first + cholesky_block_size < nrhs) ? cholesky_block_size
+                                                      : nrhs - first;
 
-                // M(col,row) = sum/M(col,col)
-                *(ptr+col-row) = sum/matrix.m_data[matrix.m_colstart[col]];
+        // Copy right-hand sides
+        for (int i = 0; i < num; ++i) {
+            double* x = &work[i * nb];
+            for (int k = 0; k < nb; ++k) {
+                x[k] = matrix(inx[i], first + k);
             }
         }
 
-        // Matrix multiplication (col>=row)
-        for (int row = 0; row < matrix.m_rows; ++row) {
-            double* ptr = matrix.m_data + matrix.m_colstart[row];
-            for (int col = row; col < matrix.m_cols; ++col) {
-                // sum += M(row,k)*M(k,col)
-                double   sum = 0.0;
-                double* ptr1 = ptr + col - row;
-                double* ptr2 = matrix.m_data + matrix.m_colstart[col];
-                for (int k = col; k < matrix.m_cols; ++k) {
-                    sum += *ptr1++ * *ptr2++;
+        // Solve L*Y=B, storing Y in X
+        for (int i = 0; i < num; ++i) {
+            const double* lcol = m_data + m_colstart[inx[i]] - inx[i]; // M(.,i)
+            double*       xi   = &work[i * nb];
+            double        diag = 1.0 / lcol[inx[i]];
+            for (int k = 0; k < nb; ++k) {
+                xi[k] *= diag;
+            }
+            for (int j = i+1; j < num; ++j) {
+                double* xj = &work[j * nb];
+                double  l  = lcol[inx[j]];                         // M(j,i)
+                for (int k = 0; k < nb; ++k) {
+                    xj[k] -= l * xi[k];
                 }
-                // M(row,col) = sum
-                *(ptr+col-row) = sum;
             }
         }
-    } // endif: no zero-row/col compression needed
-
-    // Case B: zero-row/col compression needed
-    else if (matrix.m_num_inx > 0) {
 
-        // Allocate loop variables and pointers
-        int  row;
-        int  col;
-        int  k;
-        int* row_ptr;
-        int* col_ptr;
-        int* k_ptr;
-
-        // Generate inverse of Cholesky decomposition (col>row)
-        for (row = 0, row_ptr = matrix.m_inx;
-             row < matrix.m_num_inx; ++row, ++row_ptr) {
-
-            // M(row,row) = 1/M(row,row)
-            double* ptr_diag = matrix.m_data + matrix.m_colstart[*row_ptr];
-            double* ptr_2    = ptr_diag - *row_ptr;
-            *ptr_diag        = 1.0/(*ptr_diag);
-                                     
-            for (col = row+1, col_ptr = matrix.m_inx+row+1;
-                 col < matrix.m_num_inx; ++col, ++col_ptr) {
-
-                // sum -= M(col,k)*M(k,row)
-                double  sum   = 0.0;
-                double* ptr_1 = matrix.m_data + *col_ptr;
-                for (k = row, k_ptr = matrix.m_inx+row;
-                     k < col; ++k, ++k_ptr) {
-                    sum -= *(ptr_1 + matrix.m_colstart[*k_ptr] - *k_ptr) *
-                           *(ptr_2 + *k_ptr);
+        // Solve trans(L)*X=Y
+        for (int i = num-1; i >= 0; --i) {
+            const double* lcol = m_data + m_colstart[inx[i]] - inx[i]; // M(.,i)
+            double*       xi   = &work[i * nb];
+            for (int j = i+1; j < num; ++j) {
+                const double* xj = &work[j * nb];
+                double        l  = lcol[inx[j]];                   // M(j,i)
+                for (int k = 0; k < nb; ++k) {
+                    xi[k] -= l * xj[k];
                 }
+            }
+            double diag = 1.0 / lcol[inx[i]];
+            for (int k = 0; k < nb; ++k) {
+                xi[k] *= diag;
+            }
+        }
 
-                // M(col,row) = sum/M(col,col)
-                *(ptr_2 + *col_ptr) =
-                    sum/matrix.m_data[matrix.m_colstart[*col_ptr]];
+        // Store solutions
+        for (int i = 0; i < num; ++i) {
+            const double* x = &work[i * nb];
+            for (int k = 0; k < nb; ++k) {
+                result(inx[i], first + k) = x[k];
             }
         }
 
-        // Matrix multiplication (col>=row)
-        for (row = 0, row_ptr = matrix.m_inx;
-             row < matrix.m_num_inx; ++row, ++row_ptr) {
-            double* ptr_diag = matrix.m_data + matrix.m_colstart[*row_ptr];
-            double* ptr_1    = ptr_diag - *row_ptr;
-
-            for (col = row, col_ptr = matrix.m_inx+row;
-                 col < matrix.m_num_inx; ++col, ++col_ptr) {
-
-                // sum += M(row,k)*M(k,col)
-                double  sum   = 0.0;
-                double* ptr_2 = matrix.m_data + matrix.m_colstart[*col_ptr] - *col_ptr;
-                for (k = col, k_ptr = matrix.m_inx+col;
-                     k < matrix.m_num_inx; ++k, ++k_ptr) {
-                    sum += *(ptr_1 + *k_ptr) * *(ptr_2 + *k_ptr);
-                }
+    } // endfor: looped over blocks of right-hand sides
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Return diagonal of inverse matrix
+ *
+ * @param[in] compress Request matrix compression.
+ * @return Diagonal elements of inverse matrix.
+ *
+ * @exception GException::matrix_zero
+ *            All matrix elements are zero.
+ *
+ * Returns the diagonal elements of the inverse of a matrix A without
+ * computing the full inverse. This function is to be applied on a
+ * decomposition GMatrixSymmetric matrix that is produced by
+ * 'cholesky_decompose'.
+ *
+ * With A = L L', the diagonal element i of the inverse is the squared norm
+ * of L^-1 e_i. Since L is lower triangular, the forward solve for e_i only
+ * involves the rows and columns i and beyond, and no backward solve is
+ * needed. Diagonal elements of rows and columns that were removed by
+ * compression are set to zero.
+ ***************************************************************************/
+GVector GMatrixSymmetric::cholesky_inverse_diagonal(const bool& compress) const
+{
+    // Get indices of non-zero rows/columns
+    std::vector<int> inx = cholesky_inx(compress, G_CHOL_INV_DIAG);
+    int              num = inx.size();
 
-                // M(row,col) = sum
-                *(ptr_1 + *col_ptr) = sum;
+    // Allocate result vector and working vector
+    GVector             result(m_rows);
+    std::vector<double> y(num, 0.0);
+
+    // Loop over all non-zero rows
+    for (int i = 0; i < num; ++i) {
+
+        // Solve L*y=e_i, accumulating the squared norm of y
+        double sum = 0.0;
+        y[i]       = 1.0;
+        for (int c = i; c < num; ++c) {
+            const double* lcol  = m_data + m_colstart[inx[c]] - inx[c]; // M(.,c)
+            double        value = y[c] / lcol[inx[c]];
+            sum  += value * value;
+            y[c]  = 0.0;
+            for (int j = c+1; j < num; ++j) {
+                y[j] -= lcol[inx[j]] * value;                           // M(j,c)
             }
         }
-    } // endelse: zero-row/col compression needed
+
+        // Store diagonal element
+        result[inx[i]] = sum;
+
+    } // endfor: looped over rows
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Invert matrix using a Cholesky decomposition
+ *
+ * @param[in] compress Use zero-row/column compression (defaults to true).
+ * @return Inverted matrix.
+ *
+ * @exception GException::matrix_zero
+ *            All matrix elements are zero.
+ *
+ * Inverts the matrix using a Cholesky decomposition.
+ *
+ * The method distinguish two cases. Case A operates on a full matrix while
+ * Case B operates on a compressed copy of the matrix where all zero
+ * rows/columns are skipped.
+ *
+ * The inverse is computed from the decomposition by the blocked
+ * gammalib::potri() kernel, or by the LAPACK routine dpptri if GammaLib was
+ * configured with LAPACK support.
+ ***************************************************************************/
+GMatrixSymmetric GMatrixSymmetric::cholesky_invert(const bool& compress) const
+{
+    // Generate Cholesky decomposition of matrix
+    GMatrixSymmetric matrix = cholesky_decompose(compress);
+
+    // Check if zero-row/col compression is needed
+    int no_zeros = ((compress && (matrix.m_num_inx == matrix.m_rows)) || !compress);
+
+    // Case A: no zero-row/col compression needed
+    if (no_zeros) {
+        gammalib::potri(matrix.m_rows, matrix.m_data);
+    }
+
+    // Case B: zero-row/col compression needed
+    else if (matrix.m_num_inx > 0) {
+        std::vector<double> packed = matrix.pack_inx();
+        gammalib::potri(matrix.m_num_inx, &(packed[0]));
+        matrix.unpack_inx(packed);
+    }
 
     // Case C: all matrix elements are zero
     else {
@@ -1453,6 +1559,106 @@ void GMatrixSymmetric::set_inx(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Return indices of rows and columns used by Cholesky solvers
+ *
+ * @param[in] compress Request matrix compression.
+ * @param[in] origin Method asking for the indices.
+ * @return Indices of non-zero rows and columns.
+ *
+ * @exception GException::matrix_zero
+ *            All matrix elements are zero.
+ *
+ * Returns the indices of the rows and columns of a decomposition that
+ * are used by the Cholesky solvers. If zero-row/column compression is
+ * requested and needed, only the non-zero rows and columns are returned,
+ * otherwise all rows and columns are returned.
+ ***************************************************************************/
+std::vector<int> GMatrixSymmetric::cholesky_inx(const bool&        compress,
+                                                const std::string& origin) const
+{
+    // Initialise indices
+    std::vector<int> inx;
+
+    // Check if zero-row/col compression is needed
+    int no_zeros = ((compress && (m_num_inx == m_rows)) || !compress);
+
+    // Case A: no zero-row/col compression needed
+    if (no_zeros) {
+        inx.resize(m_rows);
+        for (int row = 0; row < m_rows; ++row) {
+            inx[row] = row;
+        }
+    }
+
+    // Case B: zero-row/col compression needed
+    else if (m_num_inx > 0) {
+        inx.assign(m_inx, m_inx + m_num_inx);
+    }
+
+    // Case C: all matrix elements are zero
+    else {
+        throw GException::matrix_zero(origin);
+    }
+
+    // Return indices
+    return inx;
+}
+
+
+/***********************************************************************//**
+ * @brief Gather compressed matrix
+ *
+ * @return Packed lower triangle of compressed matrix.
+ *
+ * Returns the lower triangle of the matrix that is formed by the rows and
+ * columns in the index array m_inx (see set_inx()) in packed column-major
+ * storage, as used by the dense matrix kernels.
+ ***************************************************************************/
+std::vector<double> GMatrixSymmetric::pack_inx(void) const
+{
+    // Allocate packed matrix
+    std::vector<double> packed(m_num_inx*(m_num_inx+1)/2);
+
+    // Gather elements
+    int inx = 0;
+    for (int col = 0; col < m_num_inx; ++col) {
+        const double* ptr = m_data + m_colstart[m_inx[col]] - m_inx[col];
+        for (int row = col; row < m_num_inx; ++row) {
+            packed[inx++] = ptr[m_inx[row]];
+        }
+    }
+
+    // Return packed matrix
+    return packed;
+}
+
+
+/***********************************************************************//**
+ * @brief Scatter compressed matrix
+ *
+ * @param[in] packed Packed lower triangle of compressed matrix.
+ *
+ * Stores the packed lower triangle of a compressed matrix, as returned by
+ * pack_inx(), in the rows and columns of the matrix that are given by the
+ * index array m_inx.
+ ***************************************************************************/
+void GMatrixSymmetric::unpack_inx(const std::vector<double>& packed)
+{
+    // Scatter elements
+    int inx = 0;
+    for (int col = 0; col < m_num_inx; ++col) {
+        double* ptr = m_data + m_colstart[m_inx[col]] - m_inx[col];
+        for (int row = col; row < m_num_inx; ++row) {
+            ptr[m_inx[row]] = packed[inx++];
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                           Friend functions                              =
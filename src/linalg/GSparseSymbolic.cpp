@@ -58,11 +58,15 @@ GSparseSymbolic::GSparseSymbolic(void)
   m_n_parent   = 0;
   m_n_cp       = 0;
   m_n_leftmost = 0;
+  m_n_colstart = 0;
+  m_n_rowinx   = 0;
   m_pinv       = NULL;
   m_q          = NULL;
   m_parent     = NULL;
   m_cp         = NULL;
   m_leftmost   = NULL;
+  m_colstart   = NULL;
+  m_rowinx     = NULL;
   m_m2         = 0;
   m_lnz        = 0.0;
   m_unz        = 0.0;
@@ -83,6 +87,8 @@ GSparseSymbolic::~GSparseSymbolic(void)
   if (m_parent   != NULL) delete [] m_parent;
   if (m_cp       != NULL) delete [] m_cp;
   if (m_leftmost != NULL) delete [] m_leftmost;
+  if (m_colstart != NULL) delete [] m_colstart;
+  if (m_rowinx   != NULL) delete [] m_rowinx;
 
   // Return
   return;
@@ -109,6 +115,8 @@ GSparseSymbolic& GSparseSymbolic::operator= (const GSparseSymbolic& s)
       if (m_parent   != NULL) delete [] m_parent;
       if (m_cp       != NULL) delete [] m_cp;
       if (m_leftmost != NULL) delete [] m_leftmost;
+      if (m_colstart != NULL) delete [] m_colstart;
+      if (m_rowinx   != NULL) delete [] m_rowinx;
 
       // Initialise private members for clean destruction
       m_n_pinv     = 0;
@@ -116,11 +124,15 @@ GSparseSymbolic& GSparseSymbolic::operator= (const GSparseSymbolic& s)
       m_n_parent   = 0;
       m_n_cp       = 0;
       m_n_leftmost = 0;
+      m_n_colstart = 0;
+      m_n_rowinx   = 0;
       m_pinv       = NULL;
       m_q          = NULL;
       m_parent     = NULL;
       m_cp         = NULL;
       m_leftmost   = NULL;
+      m_colstart   = NULL;
+      m_rowinx     = NULL;
       m_m2         = 0;
       m_lnz        = 0.0;
       m_unz        = 0.0;
@@ -129,46 +141,69 @@ GSparseSymbolic& GSparseSymbolic::operator= (const GSparseSymbolic& s)
       m_m2  = s.m_m2;
       m_lnz = s.m_lnz;
       m_unz = s.m_unz;
-	
-	  // Copy m_pinv array if it exists
-	  if (s.m_pinv != NULL && s.m_n_pinv > 0) {
-	      m_pinv = new int[s.m_n_pinv];
-          for (int i = 0; i < s.m_n_pinv; ++i)
+
+      // Copy m_pinv array if it exists
+      if (s.m_pinv != NULL && s.m_n_pinv > 0) {
+          m_pinv = new int[s.m_n_pinv];
+          for (int i = 0; i < s.m_n_pinv; ++i) {
               m_pinv[i] = s.m_pinv[i];
-	      m_n_pinv = s.m_n_pinv;
-	  }
+          }
+          m_n_pinv = s.m_n_pinv;
+      }
 
-	  // Copy m_q array if it exists
-	  if (s.m_q != NULL && s.m_n_q > 0) {
-	      m_q = new int[s.m_n_q];
-          for (int i = 0; i < s.m_n_q; ++i)
+      // Copy m_q array if it exists
+      if (s.m_q != NULL && s.m_n_q > 0) {
+          m_q = new int[s.m_n_q];
+          for (int i = 0; i < s.m_n_q; ++i) {
               m_q[i] = s.m_q[i];
-	      m_n_q = s.m_n_q;
+          }
+          m_n_q = s.m_n_q;
       }
 
       // Copy m_parent array if it exists
-	  if (s.m_parent != NULL && s.m_n_parent > 0) {
-	      m_parent = new int[s.m_n_parent];
-          for (int i = 0; i < s.m_n_parent; ++i)
+      if (s.m_parent != NULL && s.m_n_parent > 0) {
+          m_parent = new int[s.m_n_parent];
+          for (int i = 0; i < s.m_n_parent; ++i) {
               m_parent[i] = s.m_parent[i];
-	      m_n_parent = s.m_n_parent;
-	  }
+          }
+          m_n_parent = s.m_n_parent;
+      }
 
-	  // Copy m_cp array if it exists
-	  if (s.m_cp != NULL && s.m_n_cp > 0) {
-	      m_cp = new int[s.m_n_cp];
-          for (int i = 0; i < s.m_n_cp; ++i)
+      // Copy m_cp array if it exists
+      if (s.m_cp != NULL && s.m_n_cp > 0) {
+          m_cp = new int[s.m_n_cp];
+          for (int i = 0; i < s.m_n_cp; ++i) {
               m_cp[i] = s.m_cp[i];
-	      m_n_cp = s.m_n_cp;
-	  }
+          }
+          m_n_cp = s.m_n_cp;
+      }
 
-	  // Copy m_leftmost array if it exists
-	  if (s.m_leftmost != NULL && s.m_n_leftmost > 0) {
-	      m_leftmost = new int[s.m_n_leftmost];
-          for (int i = 0; i < s.m_n_leftmost; ++i)
+      // Copy m_leftmost array if it exists
+      if (s.m_leftmost != NULL && s.m_n_leftmost > 0) {
+          m_leftmost = new int[s.m_n_leftmost];
+          for (int i = 0; i < s.m_n_leftmost; ++i) {
               m_leftmost[i] = s.m_leftmost[i];
-	      m_n_leftmost = s.m_n_leftmost;
-	  }
+          }
+          m_n_leftmost = s.m_n_leftmost;
+      }
+
+      // Copy m_colstart array if it exists
+      if (s.m_colstart != NULL && s.m_n_colstart > 0) {
+          m_colstart = new int[s.m_n_colstart];
+          for (int i = 0; i < s.m_n_colstart; ++i) {
+              m_colstart[i] = s.m_colstart[i];
+          }
+          m_n_colstart = s.m_n_colstart;
+      }
+
+      // Copy m_rowinx array if it exists
+      if (s.m_rowinx != NULL && s.m_n_rowinx > 0) {
+          m_rowinx = new int[s.m_n_rowinx];
+          for (int i = 0; i < s.m_n_rowinx; ++i) {
+              m_rowinx[i] = s.m_rowinx[i];
+          }
+          m_n_rowinx = s.m_n_rowinx;
+      }
 
     } // endif: object was not identical
 
@@ -211,6 +246,8 @@ void GSparseSymbolic::cholesky_symbolic_analysis(int order,
   if (m_parent   != NULL) delete [] m_parent;
   if (m_cp       != NULL) delete [] m_cp;
   if (m_leftmost != NULL) delete [] m_leftmost;
+  if (m_colstart != NULL) delete [] m_colstart;
+  if (m_rowinx   != NULL) delete [] m_rowinx;
   
   // Initialise members
   m_n_pinv     = 0;
@@ -218,11 +255,15 @@ void GSparseSymbolic::cholesky_symbolic_analysis(int order,
   m_n_parent   = 0;
   m_n_cp       = 0;
   m_n_leftmost = 0;
+  m_n_colstart = 0;
+  m_n_rowinx   = 0;
   m_pinv       = NULL;
   m_q          = NULL;
   m_parent     = NULL;
   m_cp         = NULL;
   m_leftmost   = NULL;
+  m_colstart   = NULL;
+  m_rowinx     = NULL;
   m_m2         = 0;
   m_lnz        = 0.0;
   m_unz        = 0.0;
@@ -336,6 +377,8 @@ void GSparseSymbolic::cholesky_symbolic_analysis(int order,
     if (m_parent   != NULL) delete [] m_parent;
     if (m_cp       != NULL) delete [] m_cp;
     if (m_leftmost != NULL) delete [] m_leftmost;
+    if (m_colstart != NULL) delete [] m_colstart;
+    if (m_rowinx   != NULL) delete [] m_rowinx;
   
     // Initialise members
     m_n_pinv     = 0;
@@ -343,16 +386,35 @@ void GSparseSymbolic::cholesky_symbolic_analysis(int order,
     m_n_parent   = 0;
     m_n_cp       = 0;
     m_n_leftmost = 0;
+    m_n_colstart = 0;
+    m_n_rowinx   = 0;
     m_pinv       = NULL;
     m_q          = NULL;
     m_parent     = NULL;
     m_cp         = NULL;
     m_leftmost   = NULL;
+    m_colstart   = NULL;
+    m_rowinx     = NULL;
     m_m2         = 0;
     m_lnz        = 0.0;
     m_unz        = 0.0;
   }
 
+  // Otherwise store the sparsity pattern of the analysed matrix so that
+  // the analysis can be reused for matrices with the same pattern
+  else if (m.m_colstart != NULL) {
+    m_n_colstart = n+1;
+    m_n_rowinx   = m.m_colstart[n];
+    m_colstart   = new int[m_n_colstart];
+    for (int i = 0; i < m_n_colstart; ++i)
+      m_colstart[i] = m.m_colstart[i];
+    if (m_n_rowinx > 0) {
+      m_rowinx = new int[m_n_rowinx];
+      for (int i = 0; i < m_n_rowinx; ++i)
+        m_rowinx[i] = m.m_rowinx[i];
+    }
+  }
+
   // Debug
   #if defined(G_DEBUG_SPARSE_CHOLESKY)
   cout << "GSparseSymbolic::cholesky_symbolic_analysis finished" << endl;
@@ -363,6 +425,42 @@ void GSparseSymbolic::cholesky_symbolic_analysis(int order,
 }
 
 
+/***************************************************************************
+ *                               has_pattern                               *
+ * ----------------------------------------------------------------------- *
+ * Checks whether a sparse matrix has the same sparsity pattern as the     *
+ * matrix for which the symbolic analysis was done. In that case the       *
+ * ordering, elimination tree and column counts are also valid for the     *
+ * matrix, and only the numeric factorisation needs to be redone.          *
+ * ----------------------------------------------------------------------- *
+ * Input:   m                    Sparse matrix                             *
+ * Output:  true if the sparsity pattern is identical                      *
+ ***************************************************************************/
+bool GSparseSymbolic::has_pattern(const GMatrixSparse& m) const
+{
+  // Signal no pattern if there is no valid analysis or if the matrix
+  // dimensions differ
+  if (m_colstart == NULL || m_pinv == NULL || m.m_colstart == NULL ||
+      m_n_colstart != m.m_cols+1 || m_n_rowinx != m.m_colstart[m.m_cols])
+    return false;
+
+  // Compare column start indices
+  for (int i = 0; i < m_n_colstart; ++i) {
+    if (m_colstart[i] != m.m_colstart[i])
+      return false;
+  }
+
+  // Compare row indices
+  for (int i = 0; i < m_n_rowinx; ++i) {
+    if (m_rowinx[i] != m.m_rowinx[i])
+      return false;
+  }
+
+  // Return
+  return true;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                     GSparseSymbolic private functions                   =
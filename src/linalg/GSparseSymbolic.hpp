@@ -67,6 +67,7 @@ public:
 
     // Methods
     void cholesky_symbolic_analysis(int order, const GMatrixSparse& m);
+    bool has_pattern(const GMatrixSparse& m) const;
 
 private:
     // Private methods
@@ -96,6 +97,10 @@ private:
     int    m_n_parent;    //!< Number of elements in m_parent
     int    m_n_cp;        //!< Number of elements in m_cp
     int    m_n_leftmost;  //!< Number of elements in m_leftmost
+    int*   m_colstart;    //!< Column start indices of analysed matrix
+    int*   m_rowinx;      //!< Row indices of analysed matrix
+    int    m_n_colstart;  //!< Number of elements in m_colstart
+    int    m_n_rowinx;    //!< Number of elements in m_rowinx
 };
 
 #endif /* GSPARSESYMBOLIC_HPP */
@@ -132,12 +132,18 @@ GModel::~GModel(void)
  *
  * @param[in] model Model.
  * @return Model.
+ *
+ * The model keeps its link to the model container that holds it, and the
+ * container is informed that the model name may have changed.
  ***************************************************************************/
 GModel& GModel::operator=(const GModel& model)
 {
     // Execute only if object is not identical
     if (this != &model) {
 
+        // Keep renaming flag of model container
+        bool* renamed = m_renamed;
+
         // Free members
         free_members();
 
@@ -147,6 +153,12 @@ GModel& GModel::operator=(const GModel& model)
         // Copy members
         copy_members(model);
 
+        // Restore renaming flag and signal that model name may have changed
+        m_renamed = renamed;
+        if (m_renamed != NULL) {
+            *m_renamed = true;
+        }
+
     } // endif: object was not identical
 
     // Return
@@ -556,6 +568,7 @@ void GModel::init_members(void)
 {
     // Initialise members
     m_name.clear();
+    m_name_id    = -1;
     m_instruments.clear();
     m_scales.clear();
     m_ids.clear();
@@ -564,6 +577,7 @@ void GModel::init_members(void)
     m_has_ts     = false;
     m_has_tscalc = false;
     m_tscalc     = false;
+    m_renamed    = NULL;
     
     // Return
     return;
@@ -579,6 +593,7 @@ void GModel::copy_members(const GModel& model)
 {
     // Copy members
     m_name        = model.m_name;
+    m_name_id     = model.m_name_id;
     m_instruments = model.m_instruments;
     m_scales      = model.m_scales;
     m_ids         = model.m_ids;
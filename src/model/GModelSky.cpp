@@ -28,7 +28,10 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#include <vector>
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GException.hpp"
 #include "GIntegral.hpp"
 #include "GModelRegistry.hpp"
@@ -43,6 +46,11 @@
 #include "GSource.hpp"
 #include "GResponse.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Globals ____________________________________________________________ */
 const GModelSky         g_pointsource_seed("PointSource");
 const GModelSky         g_extendedsource_seed("ExtendedSource");
@@ -53,6 +61,8 @@ const GModelRegistry    g_diffusesource_registry(&g_diffusesource_seed);
 
 /* __ Method name definitions ____________________________________________ */
 #define G_NPRED           "GModelSky::npred(GEnergy&, GTime&, GObservation&)"
+#define G_MC        "GModelSky::mc(double&, GSkyDir&, double&, GEnergy&, "\
+                                       "GEnergy&, GTime&, GTime&, GRan&)"
 #define G_XML_SPATIAL                  "GModelSky::xml_spatial(GXmlElement&)"
 #define G_XML_SPECTRAL                "GModelSky::xml_spectral(GXmlElement&)"
 #define G_XML_TEMPORAL                "GModelSky::xml_temporal(GXmlElement&)"
@@ -71,6 +81,9 @@ const GModelRegistry    g_diffusesource_registry(&g_diffusesource_seed);
 //#define G_DUMP_MC                                  //!< Dump MC information
 //#define G_DUMP_MC_DETAIL                  //!< Dump detailed MC information
 
+/* __ Constants __________________________________________________________ */
+const int mc_block_size = 10000;          //!< Photons per Monte Carlo block
+
 
 /*==========================================================================
  =                                                                         =
@@ -573,7 +586,8 @@ double GModelSky::npred(const GEnergy& obsEng, const GTime& obsTime,
         GTime   srcTime = obsTime;
 
         // Set source
-        GSource source(this->name(), m_spatial, srcEng, srcTime);
+        GSource source(this->name(), this->name_id(), m_spatial, srcEng,
+                       srcTime);
 
         // Compute response components
         double npred_spatial  = rsp->npred(source, obs);
@@ -800,6 +814,9 @@ void GModelSky::write(GXmlElement& xml) const
  * @param[in,out] ran Random number generator.
  * @return List of photons
  *
+ * @exception GException::runtime_error
+ *            Simulation of a photon block failed.
+ *
  * Returns a list of photons that has been derived by Monte Carlo simulation
  * from the model. A simulation region is define by specification of
  * - a simulation cone, which is a circular region on the sky defined by
@@ -815,6 +832,12 @@ void GModelSky::write(GXmlElement& xml) const
  * only the sky region will be simulated that is actually observed by the
  * telescope.
  *
+ * The photons are simulated in blocks of arrival times. If there is more
+ * than one block, each block is simulated with an independent substream
+ * of a generator that is seeded from @p ran (see GRan::substream()), and
+ * the blocks are distributed over the available OpenMP threads. The
+ * simulated photons therefore do not depend on the number of threads.
+ *
  * @todo Implement unique model ID to assign as Monte Carlo ID
  ***************************************************************************/
 GPhotons GModelSky::mc(const double& area,
@@ -894,52 +917,133 @@ GPhotons GModelSky::mc(const double& area,
             std::cout << "  Times=" << times.size() << std::endl;
             #endif
 
-            // Reserve space for photons
-            if (times.size() > 0) {
-                photons.reserve(times.size());
+            // Get number of photons to simulate
+            int ntimes = times.size();
+
+            // Determine number of photon blocks. The block size does not
+            // depend on the number of threads so that the simulated photons
+            // do not depend on the number of threads either
+            int nblocks = (ntimes + mc_block_size - 1) / mc_block_size;
+
+            // Allocate photon candidates and cosines of their distance to
+            // the simulation cone centre
+            std::vector<GPhoton> candidates(ntimes);
+            std::vector<double>  cosdist(ntimes);
+
+            // Make sure that the celestial coordinates of the simulation
+            // cone centre are computed before photons are simulated since
+            // they are shared by all threads
+            dir.ra();
+
+            // If we have a single block then simulate the photons using
+            // the random number generator directly
+            if (nblocks == 1) {
+                mc_block(*spectral, times, 0, ntimes, emin, emax, dir,
+                         &candidates, &cosdist, ran);
             }
 
-            // Loop over photons
-            for (int i = 0; i < times.size(); ++i) {
-
-                // Debug option: dump photon index
-                #if defined(G_DUMP_MC_DETAIL)
-                std::cout << "  Photon=" << i << std::endl;
-                #endif
-
-                // Allocate photon
-                GPhoton photon;
-
-                // Set photon arrival time
-                photon.time(times[i]);
-
-                // Debug option: dump time
-                #if defined(G_DUMP_MC_DETAIL)
-                std::cout << "    Time=" << times[i] << std::endl;
+            // ... otherwise simulate each block with an independent random
+            // number generator substream
+            else if (nblocks > 1) {
+
+                // Derive the base generator of the block substreams from the
+                // random number generator
+                GRan base(ran.int64());
+
+                // Make sure that all precomputation caches of the spatial
+                // model are set up before it is shared by the threads, using
+                // a scratch copy of the random number generator
+                GRan scratch(base);
+                m_spatial->mc(emin, tmin, scratch);
+
+                // Determine number of threads. Simulate the blocks serially
+                // if we are already within a parallel region.
+                int nthreads = 1;
+                #ifdef _OPENMP
+                if (!omp_in_parallel()) {
+                    nthreads = (nblocks < omp_get_max_threads())
+                               ? nblocks : omp_get_max_threads();
+                }
                 #endif
 
-                // Set photon energy
-                photon.energy(spectral->mc(emin, emax, photon.time(), ran));
-
-                // Debug option: dump energy
-                #if defined(G_DUMP_MC_DETAIL)
-                std::cout << "    Energy=" << photon.energy() << std::endl;
-                #endif
+                // Initialise error message
+                std::string error;
+
+                // Simulate blocks in parallel. Each thread works on its own
+                // copy of the spectral model since spectral models modify
+                // their internal state when drawing energies
+                #pragma omp parallel num_threads(nthreads)
+                {
+                    // Allocate spectral model copy for this thread
+                    GModelSpectral* thread_spectral = spectral->clone();
+
+                    // Loop over blocks
+                    #pragma omp for schedule(dynamic)
+                    for (int iblock = 0; iblock < nblocks; ++iblock) {
+
+                        // Determine time range of block
+                        int ifirst = iblock * mc_block_size;
+                        int ilast  = ifirst + mc_block_size;
+                        if (ilast > ntimes) {
+                            ilast = ntimes;
+                        }
+
+                        // Simulate block, recording any error since
+                        // exceptions must not leave the parallel region
+                        try {
+                            GRan stream = base.substream(iblock);
+                            mc_block(*thread_spectral, times, ifirst, ilast,
+                                     emin, emax, dir, &candidates, &cosdist,
+                                     stream);
+                        }
+                        catch (std::exception& e) {
+                            #pragma omp critical(GModelSky_mc)
+                            {
+                                if (error.empty()) {
+                                    error = e.what();
+                                }
+                            }
+                        }
+
+                    } // endfor: looped over blocks
+
+                    // Free spectral model copy
+                    delete thread_spectral;
+
+                } // end pragma omp parallel
+
+                // Throw an exception if a block failed
+                if (!error.empty()) {
+                    if (free_spectral) delete spectral;
+                    std::string msg = "Monte Carlo simulation of model \""+
+                                      name()+"\" failed: "+error;
+                    throw GException::runtime_error(G_MC, msg);
+                }
 
-                // Set incident photon direction
-                photon.dir(m_spatial->mc(photon.energy(), photon.time(), ran));
+            } // endelse: simulated several blocks
 
-                // Debug option: dump direction
-                #if defined(G_DUMP_MC_DETAIL)
-                std::cout << "    Direction=" << photon.dir() << std::endl;
-                #endif
+            // Determine cosine of the simulation cone radius
+            double cosrad = (radius < 180.0)
+                            ? std::cos(radius * gammalib::deg2rad) : -2.0;
 
-                // Append photon
-                if (dir.dist_deg(photon.dir()) <= radius) {
-                    photons.append(photon);
+            // Count photons within simulation cone
+            int nphotons = 0;
+            for (int i = 0; i < ntimes; ++i) {
+                if (cosdist[i] >= cosrad) {
+                    nphotons++;
                 }
+            }
 
-            } // endfor: looped over photons
+            // Append photons within simulation cone in the order of their
+            // arrival times
+            if (nphotons > 0) {
+                photons.reserve(nphotons);
+                for (int i = 0; i < ntimes; ++i) {
+                    if (cosdist[i] >= cosrad) {
+                        photons.append(candidates[i]);
+                    }
+                }
+            }
 
             // Free spectral model if required
             if (free_spectral) delete spectral;
@@ -1487,15 +1591,25 @@ double GModelSky::integrate_dir(const GEvent&       event,
         const GResponse* rsp = obs.response();
 
         // Set source
-        GSource source(this->name(), m_spatial, srcEng, srcTime);
+        GSource source(this->name(), this->name_id(), m_spatial, srcEng,
+                       srcTime);
         
         // Get IRF value. This method returns the spatial component of the
-        // source model.
-        double irf = rsp->irf(event, source, obs);
+        // source model. If gradients are requested and the response
+        // computes the spatial model parameter gradients, the response
+        // also computes the gradients.
+        bool   spatial_grad = (grad &&
+                               m_spatial->code() != GMODEL_SPATIAL_DIFFUSE &&
+                               rsp->has_irf_gradients(*m_spatial));
+        double irf          = (spatial_grad)
+                              ? rsp->irf_gradients(event, source, obs)
+                              : rsp->irf(event, source, obs);
 
         // If required, apply instrument specific model scaling
+        double scaling = 1.0;
         if (!m_scales.empty()) {
-            irf *= scale(obs.instrument()).value();
+            scaling  = scale(obs.instrument()).value();
+            irf     *= scaling;
         }
 
         // Case A: evaluate gradients
@@ -1541,6 +1655,20 @@ double GModelSky::integrate_dir(const GEvent&       event,
                 }
             }
 
+            // Multiply factors to spatial gradients that were provided by
+            // the response
+            if (spatial_grad) {
+                double fact = spec * temp * scaling;
+                if (fact != 1.0) {
+                    for (int i = 0; i < m_spatial->size(); ++i) {
+                        GModelPar& par = (*m_spatial)[i];
+                        if (par.has_grad()) {
+                            par.factor_gradient(par.factor_gradient() * fact);
+                        }
+                    }
+                }
+            }
+
         } // endif: gradient evaluation has been requested
 
         // Case B: evaluate no gradients
@@ -1590,6 +1718,106 @@ bool GModelSky::valid_model(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Simulate block of photons
+ *
+ * @param[in] spectral Spectral model.
+ * @param[in] times Photon arrival times.
+ * @param[in] ifirst Index of first arrival time.
+ * @param[in] ilast Index after last arrival time.
+ * @param[in] emin Minimum photon energy.
+ * @param[in] emax Maximum photon energy.
+ * @param[in] dir Centre of simulation cone.
+ * @param[in,out] photons Photons.
+ * @param[in,out] cosdist Cosine of distance to simulation cone centre.
+ * @param[in,out] ran Random number generator.
+ *
+ * Simulates the photons for the arrival times [@p ifirst, @p ilast[ and
+ * stores them in the corresponding elements of the pre-sized @p photons
+ * array. The cosines of the angular distances between the photons and the
+ * simulation cone centre are stored in the corresponding elements of the
+ * pre-sized @p cosdist array. They are computed in a separate loop over
+ * the photon coordinates so that the compiler can vectorise the loop.
+ *
+ * The method only writes into the specified ranges of the arrays, hence
+ * disjoint blocks may be simulated in parallel provided that each thread
+ * uses its own spectral model and random number generator. The celestial
+ * coordinates of @p dir need to be computed before.
+ ***************************************************************************/
+void GModelSky::mc_block(const GModelSpectral&  spectral,
+                         const GTimes&          times,
+                         const int&             ifirst,
+                         const int&             ilast,
+                         const GEnergy&         emin,
+                         const GEnergy&         emax,
+                         const GSkyDir&         dir,
+                         std::vector<GPhoton>*  photons,
+                         std::vector<double>*   cosdist,
+                         GRan&                  ran) const
+{
+    // Get number of photons in block
+    int n = ilast - ifirst;
+
+    // Allocate photon coordinates
+    std::vector<double> ra(n);
+    std::vector<double> dec(n);
+
+    // Loop over photons
+    for (int i = 0; i < n; ++i) {
+
+        // Debug option: dump photon index
+        #if defined(G_DUMP_MC_DETAIL)
+        std::cout << "  Photon=" << ifirst+i << std::endl;
+        #endif
+
+        // Get reference to photon
+        GPhoton& photon = (*photons)[ifirst+i];
+
+        // Set photon arrival time
+        photon.time(times[ifirst+i]);
+
+        // Debug option: dump time
+        #if defined(G_DUMP_MC_DETAIL)
+        std::cout << "    Time=" << photon.time() << std::endl;
+        #endif
+
+        // Set photon energy
+        photon.energy(spectral.mc(emin, emax, photon.time(), ran));
+
+        // Debug option: dump energy
+        #if defined(G_DUMP_MC_DETAIL)
+        std::cout << "    Energy=" << photon.energy() << std::endl;
+        #endif
+
+        // Set incident photon direction
+        photon.dir(m_spatial->mc(photon.energy(), photon.time(), ran));
+
+        // Debug option: dump direction
+        #if defined(G_DUMP_MC_DETAIL)
+        std::cout << "    Direction=" << photon.dir() << std::endl;
+        #endif
+
+        // Store photon coordinates
+        ra[i]  = photon.dir().ra();
+        dec[i] = photon.dir().dec();
+
+    } // endfor: looped over photons
+
+    // Compute cosines of distances to simulation cone centre
+    double  ra0      = dir.ra();
+    double  sin_dec0 = std::sin(dir.dec());
+    double  cos_dec0 = std::cos(dir.dec());
+    double* cosines  = &((*cosdist)[ifirst]);
+    for (int i = 0; i < n; ++i) {
+        cosines[i] = sin_dec0 * std::sin(dec[i]) +
+                     cos_dec0 * std::cos(dec[i]) * std::cos(ra[i] - ra0);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Integration kernel for edisp_kern() method
  *
@@ -33,6 +33,7 @@
 #include "GMath.hpp"
 #include "GModelSpatialDiffuseCube.hpp"
 #include "GModelSpatialRegistry.hpp"
+#include "GHealpix.hpp"
 #include "GFitsTable.hpp"
 #include "GFitsTableCol.hpp"
 
@@ -378,12 +379,12 @@ double GModelSpatialDiffuseCube::eval_gradients(const GPhoton& photon) const
  *            cover the specified @p energy.
  *
  * Returns a random sky direction according to the intensity distribution of
- * the model sky map and the specified energy. The method makes use of a
- * cache array that contains the normalised cumulative flux values for each
- * of the sky maps in the cube. The specified energy is used to select the
- * appropriate cache array from the cube. Using a uniform random number, the
- * selected cache array is scanned using a bi-section method to determine
- * the skymap pixel for which the position should be returned. To avoid
+ * the model sky map and the specified energy. The method makes use of an
+ * alias table that was built from the pixel flux values for each of the
+ * sky maps in the cube. The specified energy is used to select the
+ * appropriate alias table from the cube. Using a uniform random number, the
+ * selected alias table returns in constant time the skymap pixel for which
+ * the position should be returned. To avoid
  * binning problems, the exact position within the pixel is set by a uniform
  * random number generator (neglecting thus pixel distortions). The
  * fractional skymap pixel is then converted into a sky direction.
@@ -399,7 +400,7 @@ GSkyDir GModelSpatialDiffuseCube::mc(const GEnergy& energy,
     fetch_cube();
 
     // Determine number of skymap pixels
-    int npix = pixels();
+    long long npix = pixels();
 
     // Continue only if there are skymap pixels
     if (npix > 0) {
@@ -437,33 +438,23 @@ GSkyDir GModelSpatialDiffuseCube::mc(const GEnergy& energy,
             }
         }
         
-        // Get uniform random number
-        double u = ran.uniform();
-
-        // Get pixel index according to random number. We use a bi-section
-        // method to find the corresponding skymap pixel
-        int offset = i * (npix+1);
-        int low    = offset;
-        int high   = offset + npix;
-        while ((high - low) > 1) {
-            int mid = (low+high) / 2;
-            if (u < m_mc_cache[mid]) {
-                high = mid;
-            }
-            else if (m_mc_cache[mid] <= u) {
-                low = mid;
-            }
-        }
+        // Continue only if the map has a positive flux
+        if (i < int(m_mc_cache.size()) && m_mc_cache[i].total() > 0.0) {
 
-        // Convert sky map index to sky map pixel
-        GSkyPixel pixel = m_cube.inx2pix(low-offset);
+            // Get pixel index from the alias table of the map
+            int index = m_mc_cache[i].draw(ran);
 
-        // Randomize pixel
-        pixel.x(pixel.x() + ran.uniform() - 0.5);
-        pixel.y(pixel.y() + ran.uniform() - 0.5);
+            // Convert sky map index to sky map pixel
+            GSkyPixel pixel = m_cube.inx2pix(index);
 
-        // Get sky direction
-        dir = m_cube.pix2dir(pixel);
+            // Randomize pixel
+            pixel.x(pixel.x() + ran.uniform() - 0.5);
+            pixel.y(pixel.y() + ran.uniform() - 0.5);
+
+            // Get sky direction
+            dir = m_cube.pix2dir(pixel);
+
+        } // endif: map had a positive flux
     
     } // endif: there were pixels in sky map
 
@@ -781,6 +772,10 @@ GEnergies GModelSpatialDiffuseCube::energies(void)
  *
  * Sets the simulation cone centre and radius that defines the directions
  * that will be simulated using the mc() method.
+ *
+ * The pixels that overlap with the simulation cone are determined once for
+ * all maps. For a HealPix cube they are obtained by a disc query, hence
+ * only the pixels within the cone are visited.
  ***************************************************************************/
 void GModelSpatialDiffuseCube::set_mc_cone(const GSkyDir& centre,
                                            const double&  radius)
@@ -793,29 +788,26 @@ void GModelSpatialDiffuseCube::set_mc_cone(const GSkyDir& centre,
     fetch_cube();
 
     // Determine number of cube pixels and maps
-    int npix  = pixels();
-    int nmaps = maps();
+    long long npix  = pixels();
+    int       nmaps = maps();
 
     // Continue only if there are pixels and maps
     if (npix > 0 && nmaps > 0) {
 
-        // Reserve space for all pixels in cache
-        m_mc_cache.reserve((npix+1)*nmaps);
-
-        // Loop over all maps
-        for (int i = 0; i < nmaps; ++i) {
-
-            // Compute pixel offset
-            int offset = i * (npix+1);
-
-            // Set first cache value to 0
-            m_mc_cache.push_back(0.0);
-
-            // Initialise cache with cumulative pixel fluxes and compute
-            // total flux in skymap for normalization. Negative pixels are
-            // excluded from the cumulative map.
-            double total_flux = 0.0;
-        	for (int k = 0; k < npix; ++k) {
+        // Determine the pixels that overlap with the simulation cone. There
+        // is no problem of having even pixels outside the simulation cone
+        // taken into account as long as the mc() method has an explicit
+        // test of whether a simulated event is contained in the simulation
+        // cone.
+        std::vector<long long> cone_pixels;
+        const GHealpix*        healpix =
+                               dynamic_cast<const GHealpix*>(m_cube.projection());
+        if (healpix != NULL) {
+            cone_pixels = healpix->query_disc(centre, radius, true);
+        }
+        else {
+            std::vector<GSkyDir> dirs = m_cube.inx2dir(0, npix);
+            for (long long k = 0; k < npix; ++k) {
 
                 // Derive effective pixel radius from half opening angle
                 // that corresponds to the pixel's solid angle. For security,
@@ -824,35 +816,40 @@ void GModelSpatialDiffuseCube::set_mc_cone(const GSkyDir& centre,
                        std::acos(1.0 - m_cube.solidangle(k)/gammalib::twopi) *
                        gammalib::rad2deg * 1.5;
 
-                // Add up flux with simulation cone radius + effective pixel
-                // radius. The effective pixel radius is added to make sure
-                // that all pixels that overlap with the simulation cone are
-                // taken into account. There is no problem of having even
-                // pixels outside the simulation cone taken into account as
-                // long as the mc() method has an explicit test of whether a
-                // simulated event is contained in the simulation cone.
-                double distance = centre.dist_deg(m_cube.pix2dir(k));
-                if (distance <= radius+pixel_radius) {
-                    double flux = m_cube(k,i) * m_cube.solidangle(k);
-                    if (flux > 0.0) {
-                        total_flux += flux;
-                    }
+                // Select pixel if it is within simulation cone radius +
+                // effective pixel radius. The effective pixel radius is
+                // added to make sure that all pixels that overlap with the
+                // simulation cone are taken into account.
+                if (centre.dist_deg(dirs[k]) <= radius+pixel_radius) {
+                    cone_pixels.push_back(k);
                 }
 
-                // Push back flux
-        		m_mc_cache.push_back(total_flux); // units: ph/cm2/s/MeV
-        	}
+            } // endfor: looped over pixels
+        }
+
+        // Reserve space for the alias tables of all maps
+        m_mc_cache.reserve(nmaps);
 
-            // Normalize cumulative pixel fluxes so that the values in the
-            // cache run from 0 to 1
-            if (total_flux > 0.0) {
-        		for (int k = 0; k < npix; ++k) {
-        			m_mc_cache[k+offset] /= total_flux;
-        		}
-        	}
+        // Loop over all maps
+        for (int i = 0; i < nmaps; ++i) {
+
+            // Initialise pixel fluxes and compute total flux within the
+            // simulation cone. Negative pixels are excluded from the alias
+            // table.
+            std::vector<double> fluxes(npix, 0.0);
+            double              total_flux = 0.0;
+            int                 ncone      = cone_pixels.size();
+            for (int j = 0; j < ncone; ++j) {
+                long long k    = cone_pixels[j];
+                double    flux = m_cube(k,i) * m_cube.solidangle(k);
+                if (flux > 0.0) {
+                    fluxes[k]   = flux; // units: ph/cm2/s/MeV
+                    total_flux += flux;
+                }
+            }
 
-            // Make sure that last pixel in the cache is >1
-            m_mc_cache[npix+offset] = 1.0001;
+            // Build alias table for the map
+            m_mc_cache.push_back(GRanAlias(fluxes));
 
             // Store centre flux in node array
             if (m_logE.size() == nmaps) {
@@ -868,11 +865,11 @@ void GModelSpatialDiffuseCube::set_mc_cone(const GSkyDir& centre,
 
         } // endfor: looped over all maps
 
-        // Dump cache values for debugging
+        // Dump cache for debugging
         #if defined(G_DEBUG_CACHE)
         for (int i = 0; i < m_mc_cache.size(); ++i) {
-            std::cout << "i=" << i;
-            std::cout << " c=" << m_mc_cache[i] << std::endl;
+            std::cout << "i=" << i << std::endl;
+            std::cout << m_mc_cache[i].print() << std::endl;
         }
         #endif
 
@@ -323,10 +323,10 @@ double GModelSpatialDiffuseMap::eval_gradients(const GPhoton& photon) const
  * @return Sky direction.
  *
  * Returns a random sky direction according to the intensity distribution of
- * the model sky map. It makes use of a cache array that contains the
- * normalized cumulative flux values of the skymap. Using a uniform random
- * number, this cache array is scanned using a bi-section method to determine
- * the skymap pixel for which the position should be returned. To avoid
+ * the model sky map. It makes use of an alias table that was built from
+ * the flux values of the skymap pixels. Using a uniform random number, the
+ * alias table returns in constant time the skymap pixel for which the
+ * position should be returned. To avoid
  * binning problems, the exact position within the pixel is set by a uniform
  * random number generator. In case of a 2D map, this is done by randomizing
  * the skymap pixel values (neglecting thus pixel distortions). In case of a
@@ -343,13 +343,13 @@ GSkyDir GModelSpatialDiffuseMap::mc(const GEnergy& energy,
     GSkyDir dir;
 
     // Determine number of skymap pixels
-    int npix = m_map.npix();
+    long long npix = m_map.npix();
 
-    // Continue only if there are skymap pixels
-    if (npix > 0) {
+    // Continue only if there are skymap pixels with positive flux
+    if (npix > 0 && m_mc_cache.total() > 0.0) {
 
-        // Get pixel index from CDF
-    	int index = ran.cdf(m_mc_cache);
+        // Get pixel index from alias table
+    	int index = m_mc_cache.draw(ran);
 
     	// Convert sky map index to sky map pixel
     	GSkyPixel pixel = m_map.inx2pix(index);
@@ -715,8 +715,9 @@ void GModelSpatialDiffuseMap::free_members(void)
  * zero intensity.
  *
  * The method also initialises a cache for Monte Carlo sampling of the
- * skymap. This Monte Carlo cache consists of a linear array that maps a
- * value between 0 and 1 into the skymap pixel.
+ * skymap. This Monte Carlo cache consists of an alias table built from the
+ * pixel fluxes that maps a uniform random number into the skymap pixel in
+ * constant time.
  *
  * Note that if the GSkymap object contains multiple maps, only the first
  * map is used.
@@ -729,22 +730,17 @@ void GModelSpatialDiffuseMap::prepare_map(void)
     m_radius = 0.0;
 
     // Determine number of skymap pixels
-    int npix = m_map.npix();
+    long long npix = m_map.npix();
 
     // Continue only if there are skymap pixels
     if (npix > 0) {
 
-        // Reserve space for all pixels in cache
-        m_mc_cache.reserve(npix+1);
-
-        // Set first cache value to 0
-        m_mc_cache.push_back(0.0);
-
-        // Initialise cache with cumulative pixel fluxes and compute total
-        // flux in skymap for normalization. Negative pixels are set to
-        // zero intensity in the skymap. Invalid pixels are also filtered.
-        double sum = 0.0;
-        for (int i = 0; i < npix; ++i) {
+        // Compute pixel fluxes and total flux in skymap for normalization.
+        // Negative pixels are set to zero intensity in the skymap. Invalid
+        // pixels are also filtered.
+        std::vector<double> fluxes(npix);
+        double              sum = 0.0;
+        for (long long i = 0; i < npix; ++i) {
             double flux = m_map(i) * m_map.solidangle(i);
             if (flux < 0.0 ||
                 gammalib::is_notanumber(flux) ||
@@ -752,31 +748,26 @@ void GModelSpatialDiffuseMap::prepare_map(void)
                 m_map(i) = 0.0;
                 flux     = 0.0;
             }
-            sum += flux;
-            m_mc_cache.push_back(sum);
+            fluxes[i] = flux;
+            sum      += flux;
         }
 
-        // Normalize fluxes in the cache so that the values in the cache
-        // run from 0 to 1. Optionally also normalize the sky map.
+        // Build alias table from pixel fluxes
+        m_mc_cache.set(fluxes);
+
+        // Optionally normalize the sky map
         if (sum > 0.0) {
             if (normalize()) {
-                for (int i = 0; i < npix; ++i) {
-                    m_map(i)      /= sum;
-                    m_mc_cache[i] /= sum;
+                for (long long i = 0; i < npix; ++i) {
+                    m_map(i) /= sum;
                 }
                 m_norm = 1.0;
             }
             else {
-                for (int i = 0; i < npix; ++i) {
-                    m_mc_cache[i] /= sum;
-                }
                 m_norm = sum;
             }
         }
 
-        // Make sure that last pixel in the cache is >1
-        m_mc_cache[npix] = 1.0001;
-
         // If we have a HealPix map then set radius to 180 deg
         if (m_map.projection()->code() == "HPX") {
             m_radius = 180.0;
@@ -790,8 +781,9 @@ void GModelSpatialDiffuseMap::prepare_map(void)
             m_centre = m_map.pix2dir(centre);
 
             // Determine map radius
-            for (int i = 0; i < npix; ++i) {
-                double radius = m_map.inx2dir(i).dist_deg(m_centre);
+            std::vector<GSkyDir> dirs = m_map.inx2dir(0, npix);
+            for (long long i = 0; i < npix; ++i) {
+                double radius = dirs[i].dist_deg(m_centre);
                 if (radius > m_radius) {
                     m_radius = radius;
                 }
@@ -802,7 +794,7 @@ void GModelSpatialDiffuseMap::prepare_map(void)
         // Dump preparation results
         #if defined(G_DEBUG_PREPARE)
         double sum_control = 0.0;
-        for (int i = 0; i < npix; ++i) {
+        for (long long i = 0; i < npix; ++i) {
             double flux = m_map(i) * m_map.solidangle(i);
             if (flux >= 0.0) {
                 sum_control += flux;
@@ -812,12 +804,9 @@ void GModelSpatialDiffuseMap::prepare_map(void)
         std::cout << "Total flux after normalization : " << sum_control << std::endl;
         #endif
 
-        // Dump cache values for debugging
+        // Dump cache for debugging
         #if defined(G_DEBUG_CACHE)
-        for (int i = 0; i < npix+1; ++i) {
-            std::cout << "i=" << i;
-            std::cout << " c=" << m_mc_cache[i] << std::endl;
-        }
+        std::cout << m_mc_cache.print() << std::endl;
         #endif
 
     } // endif: there were skymap pixels
@@ -476,7 +476,7 @@ void GModelSpatialElliptical::init_members(void)
     m_semimajor.free();
     m_semimajor.scale(1.0);
     m_semimajor.gradient(0.0);
-    m_semimajor.has_grad(false); // Elliptical components never have gradients
+    m_semimajor.has_grad(false); // Declared by derived classes
 
     // Initialise semi-minor axis
     m_semiminor.clear();
@@ -487,7 +487,7 @@ void GModelSpatialElliptical::init_members(void)
     m_semiminor.free();
     m_semiminor.scale(1.0);
     m_semiminor.gradient(0.0);
-    m_semiminor.has_grad(false); // Elliptical components never have gradients
+    m_semiminor.has_grad(false); // Declared by derived classes
 
     // Set parameter pointer(s)
     m_pars.clear();
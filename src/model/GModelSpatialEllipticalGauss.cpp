@@ -340,9 +340,36 @@ double GModelSpatialEllipticalGauss::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * Evaluates the function value. No gradient computation is implemented as
- * Elliptical models will be convolved with the instrument response and thus
- * require the numerical computation of the derivatives.
+ * Evaluates the function value and the gradients with respect to the
+ * semi-major axis \f$a\f$, the semi-minor axis \f$b\f$ and the position
+ * angle \f$\phi_0\f$ of the ellipse. Writing the model as
+ *
+ * \f[
+ *    S_{\rm p}(\theta, \phi | E, t) = \frac{1}{2 \pi a b}
+ *    \exp \left( -\frac{\theta^2}{2} \left( \frac{\cos^2 u}{b^2} +
+ *                                         \frac{\sin^2 u}{a^2} \right)
+ *         \right)
+ * \f]
+ *
+ * with \f$u = \phi + \phi_0\f$, the gradients are given by
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial a} = S_{\rm p}
+ *    \left( \frac{\theta^2 \sin^2 u}{a^3} - \frac{1}{a} \right)
+ * \f]
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial b} = S_{\rm p}
+ *    \left( \frac{\theta^2 \cos^2 u}{b^3} - \frac{1}{b} \right)
+ * \f]
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial \phi_0} = S_{\rm p} \,
+ *    \theta^2 \sin u \cos u \left( \frac{1}{b^2} - \frac{1}{a^2} \right)
+ * \f]
+ *
+ * The gradients are stored in the respective parameters. The gradients
+ * with respect to the model centre are not computed by this method.
  *
  * See the eval() method for more information.
  ***************************************************************************/
@@ -351,8 +378,51 @@ double GModelSpatialEllipticalGauss::eval_gradients(const double&  theta,
                                                     const GEnergy& energy,
                                                     const GTime&   time) const
 {
+    // Compute value (this also updates the precomputation cache)
+    double value = eval(theta, posangle, energy, time);
+
+    // Initialise gradients
+    double g_semimajor = 0.0;
+    double g_semiminor = 0.0;
+    double g_posangle  = 0.0;
+
+    // Compute gradients if model is non-zero
+    if (value > 0.0 && m_major_rad > 0.0 && m_minor_rad > 0.0) {
+
+        // Compute help terms
+        double u      = posangle + m_last_posangle * gammalib::deg2rad;
+        double cosu   = std::cos(u);
+        double sinu   = std::sin(u);
+        double theta2 = theta * theta;
+
+        // Compute partial derivatives
+        if (m_semimajor.is_free()) {
+            g_semimajor = value * (theta2 * sinu * sinu / m_major2 - 1.0) /
+                          m_major_rad * gammalib::deg2rad *
+                          m_semimajor.scale();
+        }
+        if (m_semiminor.is_free()) {
+            g_semiminor = value * (theta2 * cosu * cosu / m_minor2 - 1.0) /
+                          m_minor_rad * gammalib::deg2rad *
+                          m_semiminor.scale();
+        }
+        if (m_posangle.is_free()) {
+            g_posangle = value * theta2 * sinu * cosu *
+                         (1.0 / m_minor2 - 1.0 / m_major2) *
+                         gammalib::deg2rad * m_posangle.scale();
+        }
+
+    } // endif: model was non-zero
+
+    // Set gradients
+    GModelSpatialEllipticalGauss* ptr =
+        const_cast<GModelSpatialEllipticalGauss*>(this);
+    ptr->m_semimajor.factor_gradient(g_semimajor);
+    ptr->m_semiminor.factor_gradient(g_semiminor);
+    ptr->m_posangle.factor_gradient(g_posangle);
+
     // Return value
-    return (eval(theta, posangle, energy, time));
+    return value;
 }
 
 
@@ -636,6 +706,12 @@ std::string GModelSpatialEllipticalGauss::print(const GChatter& chatter) const
  ***************************************************************************/
 void GModelSpatialEllipticalGauss::init_members(void)
 {
+    // Signal that the shape parameter gradients are provided by the
+    // response
+    m_posangle.has_grad(true);
+    m_semimajor.has_grad(true);
+    m_semiminor.has_grad(true);
+
     // Initialise precomputation cache. Note that zero values flag
     // uninitialised as a zero radius is not meaningful
     m_last_minor        = 0.0;
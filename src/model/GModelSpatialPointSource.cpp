@@ -545,7 +545,7 @@ void GModelSpatialPointSource::init_members(void)
     m_ra.fix();
     m_ra.scale(1.0);
     m_ra.gradient(0.0);
-    m_ra.has_grad(false);
+    m_ra.has_grad(true);   // Gradient is provided by response
 
     // Initialise Declination
     m_dec.clear();
@@ -554,7 +554,7 @@ void GModelSpatialPointSource::init_members(void)
     m_dec.fix();
     m_dec.scale(1.0);
     m_dec.gradient(0.0);
-    m_dec.has_grad(false);
+    m_dec.has_grad(true);  // Gradient is provided by response
 
     // Set parameter pointer(s)
     m_pars.clear();
@@ -288,9 +288,19 @@ double GModelSpatialRadialDisk::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * Evaluates the function value. No gradient computation is implemented as
- * radial models will be convolved with the instrument response and thus
- * require the numerical computation of the derivatives.
+ * Evaluates the function value and the gradient with respect to the disk
+ * radius inside the disk
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial r} =
+ *    -\frac{\sin r}{2 \pi (1 - \cos r)^2}
+ * \f]
+ *
+ * which results from the change of the disk normalisation. The gradient is
+ * stored in the Radius parameter. Note that the gradient does not include
+ * the contribution of the disk edge, which is a Dirac function at
+ * \f$\theta=r\f$ that needs to be taken into account by the code that
+ * integrates the model.
  *
  * See the eval() method for more information.
  ***************************************************************************/
@@ -298,8 +308,21 @@ double GModelSpatialRadialDisk::eval_gradients(const double&  theta,
                                                const GEnergy& energy,
                                                const GTime&   time) const
 {
+    // Compute value (this also updates the precomputation cache)
+    double value = eval(theta, energy, time);
+
+    // Compute partial derivative with respect to radius
+    double g_radius = 0.0;
+    if (m_radius.is_free() && value > 0.0) {
+        g_radius = -gammalib::twopi * std::sin(m_radius_rad) * m_norm * m_norm *
+                   gammalib::deg2rad * m_radius.scale();
+    }
+
+    // Set gradient
+    const_cast<GModelSpatialRadialDisk*>(this)->m_radius.factor_gradient(g_radius);
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -538,7 +561,7 @@ void GModelSpatialRadialDisk::init_members(void)
     m_radius.free();
     m_radius.scale(1.0);
     m_radius.gradient(0.0);
-    m_radius.has_grad(false);  // Radial components never have gradients
+    m_radius.has_grad(true);  // Gradient is provided by response
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_radius);
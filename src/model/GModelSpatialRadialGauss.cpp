@@ -282,15 +282,43 @@ double GModelSpatialRadialGauss::eval(const double&  theta,
  * @param[in] time Photon arrival time.
  * @return Model value.
  *
- * This method simply calls the eval() method as no analytical gradients
- * will be computed. See the eval() method for more details.
+ * Evaluates the function value and the gradient with respect to the
+ * Gaussian width
+ *
+ * \f[
+ *    \frac{\partial S_{\rm p}}{\partial \sigma} =
+ *    S_{\rm p}(\vec{p} | E, t) \left(\frac{\theta^2}{\sigma^3} -
+ *                                  \frac{2}{\sigma} \right)
+ * \f]
+ *
+ * The gradient is stored in the Sigma parameter. The gradients with respect
+ * to the model centre are not computed by this method as they depend on
+ * the direction of the photon. See the eval() method for more details.
  ***************************************************************************/
 double GModelSpatialRadialGauss::eval_gradients(const double&  theta,
                                                 const GEnergy& energy,
                                                 const GTime&   time) const
 {
+    // Compute value
+    double value = eval(theta, energy, time);
+
+    // Compute partial derivative with respect to sigma
+    double g_sigma = 0.0;
+    if (m_sigma.is_free()) {
+        double sigma_rad = sigma() * gammalib::deg2rad;
+        if (sigma_rad > 0.0) {
+            double theta2 = theta * theta;
+            double sigma2 = sigma_rad * sigma_rad;
+            g_sigma       = value * (theta2 / sigma2 - 2.0) / sigma_rad *
+                            gammalib::deg2rad * m_sigma.scale();
+        }
+    }
+
+    // Set gradient
+    const_cast<GModelSpatialRadialGauss*>(this)->m_sigma.factor_gradient(g_sigma);
+
     // Return value
-    return (eval(theta, energy, time));
+    return value;
 }
 
 
@@ -538,7 +566,7 @@ void GModelSpatialRadialGauss::init_members(void)
     m_sigma.free();
     m_sigma.scale(1.0);
     m_sigma.gradient(0.0);
-    m_sigma.has_grad(false);  // Radial components never have gradients
+    m_sigma.has_grad(true);  // Gradient is provided by response
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_sigma);
@@ -305,14 +305,12 @@ double GModelSpectralNodes::eval_gradients(const GEnergy& srcEng,
     // Update evaluation cache
     update_eval_cache();
 
-    // Set interpolation value
-    m_log_energies.set_value(srcEng.log10MeV());
-
     // Get indices and weights for interpolation
-    int    inx_left  = m_log_energies.inx_left();
-    int    inx_right = m_log_energies.inx_right();
-    double wgt_left  = m_log_energies.wgt_left();
-    double wgt_right = m_log_energies.wgt_right();
+    GNodeArray::interpolation wgt = m_log_energies.interpolate(srcEng.log10MeV());
+    int    inx_left  = wgt.inx_left;
+    int    inx_right = wgt.inx_right;
+    double wgt_left  = wgt.wgt_left;
+    double wgt_right = wgt.wgt_right;
 
     // Interpolate function
     double exponent = m_log_values[inx_left]  * wgt_left +
@@ -389,12 +387,10 @@ double GModelSpectralNodes::flux(const GEnergy& emin, const GEnergy& emax) const
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int inx_emin = m_lin_energies.interpolate(e_min).inx_left;
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        int inx_emax = m_lin_energies.interpolate(e_max).inx_left;
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -476,12 +472,10 @@ double GModelSpectralNodes::eflux(const GEnergy& emin, const GEnergy& emax) cons
         double e_max = emax.MeV();
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int inx_emin = m_lin_energies.interpolate(e_min).inx_left;
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        int inx_emax = m_lin_energies.interpolate(e_max).inx_left;
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -1576,12 +1570,10 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_energies.set_value(e_min);
-            int inx_emin = m_lin_energies.inx_left();
+            int inx_emin = m_lin_energies.interpolate(e_min).inx_left;
 
             // Determine left node index for maximum energy
-            m_lin_energies.set_value(e_max);
-            int inx_emax = m_lin_energies.inx_left();
+            int inx_emax = m_lin_energies.interpolate(e_max).inx_left;
     
             // If both energies are within the same node then just
             // add this one node on the stack
@@ -36,6 +36,9 @@
 #include "GObservation.hpp"
 #include "GXml.hpp"
 #include "GXmlElement.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Method name definitions ____________________________________________ */
 #define G_ACCESS                          "GModels::operator[](std::string&)"
@@ -331,11 +334,22 @@ GModel* GModels::set(const int& index, const GModel& model)
         throw GException::invalid_value(G_SET1, msg);
     }
 
+    // Remove name of existing model from model name index
+    std::map<std::string, int>::iterator it =
+        m_index.find(m_models[index]->name());
+    if (it != m_index.end() && it->second == index) {
+        m_index.erase(it);
+    }
+
     // Delete any existing model
     if (m_models[index] != NULL) delete m_models[index];
 
     // Assign new model by cloning
     m_models[index] = model.clone();
+    m_models[index]->m_renamed = &m_index_dirty;
+
+    // Add model to model name index
+    m_index[m_models[index]->name()] = index;
 
     // Return pointer to model
     return m_models[index];
@@ -378,11 +392,22 @@ GModel* GModels::set(const std::string& name, const GModel& model)
         throw GException::invalid_value(G_SET2, msg);
     }
 
+    // Remove name of existing model from model name index
+    std::map<std::string, int>::iterator it =
+        m_index.find(m_models[index]->name());
+    if (it != m_index.end() && it->second == index) {
+        m_index.erase(it);
+    }
+
     // Delete any existing model
     if (m_models[index] != NULL) delete m_models[index];
 
     // Assign new model by cloning
     m_models[index] = model.clone();
+    m_models[index]->m_renamed = &m_index_dirty;
+
+    // Add model to model name index
+    m_index[m_models[index]->name()] = index;
 
     // Return pointer to model
     return m_models[index];
@@ -416,10 +441,14 @@ GModel* GModels::append(const GModel& model)
 
     // Create deep copy of model
     GModel* ptr = model.clone();
+    ptr->m_renamed = &m_index_dirty;
 
     // Append deep copy of model
     m_models.push_back(ptr);
 
+    // Add model to model name index
+    m_index[ptr->name()] = size()-1;
+
     // Return pointer to model
     return ptr;
 }
@@ -470,10 +499,16 @@ GModel* GModels::insert(const int& index, const GModel& model)
 
     // Create deep copy of model
     GModel* ptr = model.clone();
+    ptr->m_renamed = &m_index_dirty;
 
     // Inserts deep copy of model
     m_models.insert(m_models.begin()+index, ptr);
 
+    // Shift indices of all subsequent models and add model to model name
+    // index
+    shift_index(index, 1);
+    m_index[ptr->name()] = index;
+
     // Return pointer to model
     return ptr;
 }
@@ -518,10 +553,16 @@ GModel* GModels::insert(const std::string& name, const GModel& model)
 
     // Create deep copy of model
     GModel* ptr = model.clone();
+    ptr->m_renamed = &m_index_dirty;
 
     // Inserts deep copy of model
     m_models.insert(m_models.begin()+index, ptr);
 
+    // Shift indices of all subsequent models and add model to model name
+    // index
+    shift_index(index, 1);
+    m_index[ptr->name()] = index;
+
     // Return pointer to model
     return ptr;
 }
@@ -546,12 +587,22 @@ void GModels::remove(const int& index)
     }
     #endif
 
+    // Remove model from model name index
+    std::map<std::string, int>::iterator it =
+        m_index.find(m_models[index]->name());
+    if (it != m_index.end() && it->second == index) {
+        m_index.erase(it);
+    }
+
     // Delete model
     delete m_models[index];
 
     // Erase model component from container
     m_models.erase(m_models.begin() + index);
 
+    // Shift indices of all subsequent models
+    shift_index(index+1, -1);
+
     // Return
     return;
 }
@@ -577,12 +628,22 @@ void GModels::remove(const std::string& name)
         throw GException::model_not_found(G_REMOVE2, name);
     }
 
+    // Remove model from model name index
+    std::map<std::string, int>::iterator it =
+        m_index.find(m_models[index]->name());
+    if (it != m_index.end() && it->second == index) {
+        m_index.erase(it);
+    }
+
     // Delete model
     delete m_models[index];
 
     // Erase model component from container
     m_models.erase(m_models.begin() + index);
 
+    // Shift indices of all subsequent models
+    shift_index(index+1, -1);
+
     // Return
     return;
 }
@@ -625,6 +686,10 @@ void GModels::extend(const GModels& models)
 
             // Append model to container
             m_models.push_back(models[i]->clone());
+            m_models.back()->m_renamed = &m_index_dirty;
+
+            // Add model to model name index
+            m_index[m_models.back()->name()] = size()-1;
 
         } // endfor: looped over all models
 
@@ -948,6 +1013,8 @@ void GModels::init_members(void)
 {
     // Initialise members
     m_models.clear();
+    m_index.clear();
+    m_index_dirty = false;
 
     // Return
     return;
@@ -969,8 +1036,12 @@ void GModels::copy_members(const GModels& models)
     m_models.clear();
     for (int i = 0; i < models.m_models.size(); ++i) {
         m_models.push_back((models.m_models[i]->clone()));
+        m_models.back()->m_renamed = &m_index_dirty;
     }
 
+    // Build model name index
+    set_index();
+
     // Return
     return;
 }
@@ -1003,20 +1074,106 @@ void GModels::free_members(void)
  *
  * Returns model index based on the specified @p name. If no model with the
  * specified @p name is found the method returns -1.
+ *
+ * The model is looked up in the model name index, and a hit is only
+ * accepted if the name of the indexed model still matches @p name. If a
+ * model in the container has been renamed since the index was built, the
+ * index is rebuilt once and the model is looked up again. Within a parallel
+ * region the index is not rebuilt and the container is searched linearly
+ * instead.
  ***************************************************************************/
 int GModels::get_index(const std::string& name) const
 {
     // Initialise index
     int index = -1;
 
-    // Search model with specified name
-    for (int i = 0; i < size(); ++i) {
-        if (m_models[i]->name() == name) {
-            index = i;
-            break;
-        }
+    // Look up model in model name index and verify the hit
+    std::map<std::string, int>::const_iterator it = m_index.find(name);
+    if (it != m_index.end() && it->second < size() &&
+        m_models[it->second]->name() == name) {
+        index = it->second;
     }
 
+    // ... otherwise, if models have been renamed, rebuild the index and
+    // look up the model again
+    else if (m_index_dirty) {
+
+        // Search linearly within a parallel region
+        #ifdef _OPENMP
+        if (omp_in_parallel()) {
+            for (int i = 0; i < size(); ++i) {
+                if (m_models[i]->name() == name) {
+                    index = i;
+                    break;
+                }
+            }
+            return index;
+        }
+        #endif
+
+        // Rebuild index
+        set_index();
+
+        // Look up model in rebuilt index
+        it = m_index.find(name);
+        if (it != m_index.end()) {
+            index = it->second;
+        }
+
+    } // endelse: models have been renamed
+
     // Return index
     return index;
 }
+
+
+/***********************************************************************//**
+ * @brief Shift model indices in model name index
+ *
+ * @param[in] index First model index to shift.
+ * @param[in] offset Shift offset.
+ *
+ * Adds @p offset to all model indices in the model name index that are
+ * equal to or larger than @p index.
+ ***************************************************************************/
+void GModels::shift_index(const int& index, const int& offset)
+{
+    // Shift all indices equal to or beyond the specified index
+    std::map<std::string, int>::iterator it;
+    for (it = m_index.begin(); it != m_index.end(); ++it) {
+        if (it->second >= index) {
+            it->second += offset;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Build model name index
+ *
+ * Builds the model name index from the names of all models in the
+ * container. If several models have the same name, the index refers to
+ * the first of them.
+ *
+ * Once the index is built, it is flagged as valid until a model in the
+ * container is renamed.
+ ***************************************************************************/
+void GModels::set_index(void) const
+{
+    // Clear index
+    m_index.clear();
+
+    // Add all models to index
+    for (int i = 0; i < size(); ++i) {
+        m_index.insert(std::make_pair(m_models[i]->name(), i));
+    }
+
+    // Signal that index is valid
+    m_index_dirty = false;
+
+    // Return
+    return;
+}
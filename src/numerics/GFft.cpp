@@ -0,0 +1,635 @@
+/***************************************************************************
+ *               GFft.cpp - Fast Fourier transformation class              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFft.cpp
+ * @brief Fast Fourier transformation class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include "GFft.hpp"
+#include "GTools.hpp"
+#include "GMath.hpp"
+#include "GException.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_SET                                             "GFft::set(int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Constants __________________________________________________________ */
+namespace {
+    const int max_radix = 13;    //!< Largest radix of Cooley-Tukey algorithm
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GFft::GFft(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Length constructor
+ *
+ * @param[in] n Transformation length.
+ *
+ * Plans the Fast Fourier Transformation for length @p n. See the set()
+ * method for details.
+ ***************************************************************************/
+GFft::GFft(const int& n)
+{
+    // Initialise members
+    init_members();
+
+    // Plan transformation
+    set(n);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] fft Fast Fourier transformation.
+ ***************************************************************************/
+GFft::GFft(const GFft& fft)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(fft);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GFft::~GFft(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] fft Fast Fourier transformation.
+ * @return Fast Fourier transformation.
+ ***************************************************************************/
+GFft& GFft::operator=(const GFft& fft)
+{
+    // Execute only if object is not identical
+    if (this != &fft) {
+
+        // Free members
+        free_members();
+
+        // Initialise members
+        init_members();
+
+        // Copy members
+        copy_members(fft);
+
+    } // endif: object was not identical
+
+    // Return
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear Fast Fourier transformation
+ ***************************************************************************/
+void GFft::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone Fast Fourier transformation
+ *
+ * @return Pointer to deep copy of Fast Fourier transformation.
+ ***************************************************************************/
+GFft* GFft::clone(void) const
+{
+    return new GFft(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Plan Fast Fourier transformation
+ *
+ * @param[in] n Transformation length.
+ *
+ * @exception GException::invalid_argument
+ *            Negative transformation length specified.
+ *
+ * Plans the Fast Fourier Transformation for length @p n. The length is
+ * factorised into radices 4, 2 and odd primes. If all prime factors are
+ * not larger than 13 the twiddle factors of the mixed-radix Cooley-Tukey
+ * algorithm are computed. Otherwise, the chirp and the kernel spectrum of
+ * Bluestein's algorithm are computed, which uses a transformation with a
+ * power of two length that is at least 2n-1.
+ ***************************************************************************/
+void GFft::set(const int& n)
+{
+    // Throw an exception if the length is negative
+    if (n < 0) {
+        std::string msg = "Negative transformation length "+
+                          gammalib::str(n)+" specified.\n"
+                          "Please specify a non-negative length.";
+        throw GException::invalid_argument(G_SET, msg);
+    }
+
+    // Clear any existing plan
+    clear();
+
+    // Set transformation length
+    m_size = n;
+
+    // Continue only if length is larger than one
+    if (n > 1) {
+
+        // Factorise length
+        int rest = n;
+        while (rest % 4 == 0) {
+            m_factors.push_back(4);
+            rest /= 4;
+        }
+        while (rest % 2 == 0) {
+            m_factors.push_back(2);
+            rest /= 2;
+        }
+        for (int p = 3; p * p <= rest; p += 2) {
+            while (rest % p == 0) {
+                m_factors.push_back(p);
+                rest /= p;
+            }
+        }
+        if (rest > 1) {
+            m_factors.push_back(rest);
+        }
+
+        // Determine largest factor
+        int largest  = 1;
+        int nfactors = m_factors.size();
+        for (int i = 0; i < nfactors; ++i) {
+            if (m_factors[i] > largest) {
+                largest = m_factors[i];
+            }
+        }
+
+        // Case A: Cooley-Tukey algorithm. Compute twiddle factors.
+        if (largest <= max_radix) {
+            m_twiddle.resize(n);
+            for (int k = 0; k < n; ++k) {
+                m_twiddle[k] = std::polar(1.0, -gammalib::twopi * double(k) /
+                                               double(n));
+            }
+        }
+
+        // Case B: Bluestein's algorithm. Compute the chirp and the spectrum
+        // of the convolution kernel.
+        else {
+
+            // Clear factors
+            m_factors.clear();
+
+            // Determine power of two length of convolution
+            int m = 1;
+            while (m < 2 * n - 1) {
+                m *= 2;
+            }
+
+            // Plan transformation for convolution
+            m_fft = new GFft(m);
+
+            // Compute chirp. The square is taken modulo 2n to keep the
+            // phase argument small.
+            m_chirp.resize(n);
+            for (int k = 0; k < n; ++k) {
+                long long k2 = ((long long)k * (long long)k) % (2 * (long long)n);
+                m_chirp[k]   = std::polar(1.0, -gammalib::pi * double(k2) /
+                                               double(n));
+            }
+
+            // Compute spectrum of convolution kernel
+            m_kernel.assign(m, std::complex<double>(0.0, 0.0));
+            m_kernel[0] = std::conj(m_chirp[0]);
+            for (int k = 1; k < n; ++k) {
+                m_kernel[k]   = std::conj(m_chirp[k]);
+                m_kernel[m-k] = std::conj(m_chirp[k]);
+            }
+            m_fft->forward(&m_kernel[0]);
+
+        } // endelse: Bluestein's algorithm
+
+    } // endif: length was larger than one
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return good transformation length
+ *
+ * @param[in] n Minimum transformation length.
+ * @return Smallest length not below @p n that factorises into 2, 3 and 5.
+ ***************************************************************************/
+int GFft::good_size(const int& n)
+{
+    // Initialise good size
+    int size = (n > 1) ? n : 1;
+
+    // Search smallest length that factorises into 2, 3 and 5
+    while (true) {
+        int rest = size;
+        while (rest % 2 == 0) {
+            rest /= 2;
+        }
+        while (rest % 3 == 0) {
+            rest /= 3;
+        }
+        while (rest % 5 == 0) {
+            rest /= 5;
+        }
+        if (rest == 1) {
+            break;
+        }
+        size++;
+    }
+
+    // Return good size
+    return size;
+}
+
+
+/***********************************************************************//**
+ * @brief Print Fast Fourier transformation information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing Fast Fourier transformation information.
+ ***************************************************************************/
+std::string GFft::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GFft ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Length"));
+        result.append(gammalib::str(m_size));
+        result.append("\n"+gammalib::parformat("Algorithm"));
+        if (m_fft != NULL) {
+            result.append("Bluestein ("+gammalib::str(m_fft->size())+")");
+        }
+        else {
+            result.append("Cooley-Tukey (");
+            int nfactors = m_factors.size();
+            for (int i = 0; i < nfactors; ++i) {
+                if (i > 0) {
+                    result.append("x");
+                }
+                result.append(gammalib::str(m_factors[i]));
+            }
+            result.append(")");
+        }
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GFft::init_members(void)
+{
+    // Initialise members
+    m_size = 0;
+    m_factors.clear();
+    m_twiddle.clear();
+    m_fft  = NULL;
+    m_chirp.clear();
+    m_kernel.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] fft Fast Fourier transformation.
+ ***************************************************************************/
+void GFft::copy_members(const GFft& fft)
+{
+    // Copy members
+    m_size    = fft.m_size;
+    m_factors = fft.m_factors;
+    m_twiddle = fft.m_twiddle;
+    m_chirp   = fft.m_chirp;
+    m_kernel  = fft.m_kernel;
+
+    // Clone Bluestein transformation
+    if (fft.m_fft != NULL) {
+        m_fft = fft.m_fft->clone();
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GFft::free_members(void)
+{
+    // Free memory
+    if (m_fft != NULL) delete m_fft;
+
+    // Signal free pointers
+    m_fft = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Fast Fourier transformation
+ *
+ * @param[in,out] data Array of size() complex values.
+ * @param[in] forward Forward transformation?
+ ***************************************************************************/
+void GFft::transform(std::complex<double>* data, const bool& forward) const
+{
+    // Continue only if length is larger than one
+    if (m_size > 1) {
+
+        // Case A: Bluestein's algorithm
+        if (m_fft != NULL) {
+            bluestein(data, forward);
+        }
+
+        // Case B: Cooley-Tukey algorithm. The recursion works out of
+        // place, hence the input data are copied first.
+        else {
+            std::vector<std::complex<double> > in(data, data + m_size);
+            cooley_tukey(&in[0], data, m_size, 1, 0, forward);
+        }
+
+    } // endif: length was larger than one
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform mixed-radix Cooley-Tukey transformation
+ *
+ * @param[in] in Input array.
+ * @param[out] out Output array.
+ * @param[in] n Length of transformation.
+ * @param[in] stride Stride of input array.
+ * @param[in] ifactor Index of first radix factor.
+ * @param[in] forward Forward transformation?
+ *
+ * Recursively performs a decimation in time transformation of the @p n
+ * elements in[0], in[stride], ..., in[(n-1)*stride]. The transformation is
+ * split into p transformations of length n/p, where p is the radix factor
+ * @p ifactor, whose results are combined using radix-p butterflies.
+ * Dedicated butterflies are used for radices 2 and 4.
+ ***************************************************************************/
+void GFft::cooley_tukey(const std::complex<double>* in,
+                        std::complex<double>*       out,
+                        const int&                  n,
+                        const int&                  stride,
+                        const int&                  ifactor,
+                        const bool&                 forward) const
+{
+    // Handle trivial transformation
+    if (n == 1) {
+        out[0] = in[0];
+        return;
+    }
+
+    // Get radix and length of sub transformations
+    int p = m_factors[ifactor];
+    int m = n / p;
+
+    // Perform sub transformations
+    for (int q = 0; q < p; ++q) {
+        cooley_tukey(in + q * stride, out + q * m, m, stride * p, ifactor + 1,
+                     forward);
+    }
+
+    // Get step in twiddle factor table
+    int step = m_size / n;
+
+    // Case A: radix 2 butterflies
+    if (p == 2) {
+        for (int k = 0; k < m; ++k) {
+            std::complex<double> w = (forward) ? m_twiddle[k*step]
+                                               : std::conj(m_twiddle[k*step]);
+            std::complex<double> t = out[k+m] * w;
+            out[k+m] = out[k] - t;
+            out[k]  += t;
+        }
+    }
+
+    // Case B: radix 4 butterflies
+    else if (p == 4) {
+        for (int k = 0; k < m; ++k) {
+            std::complex<double> w1 = m_twiddle[k*step];
+            std::complex<double> w2 = m_twiddle[2*k*step];
+            std::complex<double> w3 = m_twiddle[3*k*step];
+            if (!forward) {
+                w1 = std::conj(w1);
+                w2 = std::conj(w2);
+                w3 = std::conj(w3);
+            }
+            std::complex<double> a0 = out[k];
+            std::complex<double> a1 = out[k+m]   * w1;
+            std::complex<double> a2 = out[k+2*m] * w2;
+            std::complex<double> a3 = out[k+3*m] * w3;
+            std::complex<double> b0 = a0 + a2;
+            std::complex<double> b1 = a0 - a2;
+            std::complex<double> b2 = a1 + a3;
+            std::complex<double> b3 = (forward)
+                                      ? std::complex<double>( (a1-a3).imag(),
+                                                             -(a1-a3).real())
+                                      : std::complex<double>(-(a1-a3).imag(),
+                                                              (a1-a3).real());
+            out[k]     = b0 + b2;
+            out[k+m]   = b1 + b3;
+            out[k+2*m] = b0 - b2;
+            out[k+3*m] = b1 - b3;
+        }
+    }
+
+    // Case C: generic radix butterflies
+    else {
+        int                                pstep = m_size / p;
+        std::vector<std::complex<double> > t(p);
+        for (int k = 0; k < m; ++k) {
+            for (int q = 0; q < p; ++q) {
+                std::complex<double> w = m_twiddle[q*k*step];
+                t[q] = out[k+q*m] * ((forward) ? w : std::conj(w));
+            }
+            for (int s = 0; s < p; ++s) {
+                std::complex<double> sum = t[0];
+                for (int q = 1; q < p; ++q) {
+                    std::complex<double> w = m_twiddle[((q*s) % p) * pstep];
+                    sum += t[q] * ((forward) ? w : std::conj(w));
+                }
+                out[k+s*m] = sum;
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Bluestein transformation
+ *
+ * @param[in,out] data Array of size() complex values.
+ * @param[in] forward Forward transformation?
+ *
+ * Performs the transformation using Bluestein's algorithm, which writes
+ * the transformation as a convolution with a chirp
+ *
+ * \f[
+ *    X_k = c_k \sum_{j=0}^{n-1} (x_j c_j) c^*_{k-j}
+ * \f]
+ *
+ * where \f$c_k = \exp(-i \pi k^2/n)\f$. The convolution is computed using
+ * Fast Fourier Transformations of power of two length. For the backward
+ * transformation the chirp is replaced by its complex conjugate, and the
+ * kernel spectrum by its mirrored complex conjugate.
+ ***************************************************************************/
+void GFft::bluestein(std::complex<double>* data, const bool& forward) const
+{
+    // Get convolution length
+    int m = m_fft->size();
+
+    // Multiply data by chirp
+    std::vector<std::complex<double> > a(m, std::complex<double>(0.0, 0.0));
+    for (int k = 0; k < m_size; ++k) {
+        a[k] = data[k] * ((forward) ? m_chirp[k] : std::conj(m_chirp[k]));
+    }
+
+    // Convolve with kernel
+    m_fft->forward(&a[0]);
+    if (forward) {
+        for (int k = 0; k < m; ++k) {
+            a[k] *= m_kernel[k];
+        }
+    }
+    else {
+        for (int k = 0; k < m; ++k) {
+            a[k] *= std::conj(m_kernel[(m-k) % m]);
+        }
+    }
+    m_fft->backward(&a[0]);
+
+    // Multiply result by chirp and normalise convolution
+    double norm = 1.0 / double(m);
+    for (int k = 0; k < m_size; ++k) {
+        data[k] = a[k] * norm *
+                  ((forward) ? m_chirp[k] : std::conj(m_chirp[k]));
+    }
+
+    // Return
+    return;
+}
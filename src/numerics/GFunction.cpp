@@ -125,6 +125,29 @@ GFunction& GFunction::operator=(const GFunction& function)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate function for an array of values
+ *
+ * @param[in] x Array of function arguments.
+ * @param[out] y Array of function values.
+ * @param[in] n Number of values.
+ *
+ * Evaluates the function for the n values in the array x and stores the
+ * results in the array y. The default implementation calls eval(x[i]) for
+ * each value.
+ ***************************************************************************/
+void GFunction::eval(const double* x, double* y, const int& n)
+{
+    // Evaluate function for all values
+    for (int i = 0; i < n; ++i) {
+        y[i] = eval(x[i]);
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -44,6 +44,8 @@
 /* __ Debug definitions __________________________________________________ */
 
 /* __ Constants __________________________________________________________ */
+const int trapzd_chunk = 64;  //!< Number of abscissas per kernel call in trapzd()
+
 namespace gammalib {
 
     // Gauss-Kronrod abscissae, common to the 10-, 21-, 43- and 87-point rule
@@ -553,6 +555,10 @@ double GIntegral::romberg(const double& a, const double& b, const int& order)
  * variable, yet this led to some untrackable integration problems. For this
  * reason, previous results are now passed using an argument.
  * Result initialisation is done if n=1.
+ *
+ * The abscissas of a refinement level are passed to the batch
+ * GFunction::eval() method in chunks of up to trapzd_chunk values, so that
+ * the working arrays stay on the stack.
  ***************************************************************************/
 double GIntegral::trapzd(const double& a, const double& b, const int& n,
                          double result)
@@ -569,12 +575,13 @@ double GIntegral::trapzd(const double& a, const double& b, const int& n,
         if (n == 1) {
         
             // Evaluate integrand at boundaries
-            double y_a = m_kernel->eval(a);
-            double y_b = m_kernel->eval(b);
+            double x[2] = {a, b};
+            double y[2];
+            m_kernel->eval(x, y, 2);
             m_calls += 2;
             
             // Compute result
-            result = 0.5*(b-a)*(y_a + y_b);
+            result = 0.5*(b-a)*(y[0] + y[1]);
             
         } // endif: only a single step was requested
 
@@ -617,19 +624,31 @@ double GIntegral::trapzd(const double& a, const double& b, const int& n,
                 gammalib::warning(G_TRAPZD, m_message);
             }
 
-            // Sum up values
-            double x   = a + 0.5*del;
+            // Evaluate and sum up the integrand for the abscissas of this
+            // refinement level. The abscissas are processed in chunks so
+            // that no memory needs to be allocated
+            double x[trapzd_chunk];
+            double y[trapzd_chunk];
+            double xj  = a + 0.5*del;
             double sum = 0.0;
-            for (int j = 0; j < it; ++j, x+=del) {
-                
-                // Evaluate integrand
-                double y = m_kernel->eval(x);
-                m_calls++;
+            for (int j = 0; j < it; j += trapzd_chunk) {
+
+                // Set abscissas of chunk
+                int nx = (it - j < trapzd_chunk) ? it - j : trapzd_chunk;
+                for (int k = 0; k < nx; ++k, xj+=del) {
+                    x[k] = xj;
+                }
 
-                // Add integrand
-                sum += y;
-                
-            } // endfor: looped over steps
+                // Evaluate integrand for all abscissas of chunk
+                m_kernel->eval(x, y, nx);
+                m_calls += nx;
+
+                // Sum up values
+                for (int k = 0; k < nx; ++k) {
+                    sum += y[k];
+                }
+
+            } // endfor: looped over chunks
 
             // Set result
             result = 0.5*(result + (b-a)*sum/tnm);
@@ -723,6 +742,9 @@ double GIntegral::adaptive_simpson(const double& a, const double& b) const
  * @param[in] a Left integration boundary.
  * @param[in] b Right integration boundary.
  *
+ * The integrand is evaluated for all nodes of the 21-, 43- and 87-point
+ * formulae in a single call to the batch GFunction::eval() method per
+ * formula.
  ***************************************************************************/
 double GIntegral::gauss_kronrod(const double& a, const double& b) const
 {
@@ -743,6 +765,8 @@ double GIntegral::gauss_kronrod(const double& a, const double& b) const
     double fv3[5];
     double fv4[5];
     double savfun[21];
+    double x[44];
+    double y[44];
 
     // Main code loop (so that we can exit using break)
     do {
@@ -761,12 +785,24 @@ double GIntegral::gauss_kronrod(const double& a, const double& b) const
             }
         }
 
-        // Compute function at mid-point
+        // Set mid-point and abscissas of the 21-point formula
         double h     = 0.5 * (b - a);
         double abs_h = std::abs(h);
         double c     = 0.5 * (b + a);
-        double f_c   = m_kernel->eval(c);
-        m_calls++;
+        for (int k = 0; k < 5; ++k) {
+            double dx1 = h * gammalib::gkx1[k];
+            double dx2 = h * gammalib::gkx2[k];
+            x[2*k]      = c + dx1;
+            x[2*k+1]    = c - dx1;
+            x[2*k+10]   = c + dx2;
+            x[2*k+11]   = c - dx2;
+        }
+        x[20] = c;
+
+        // Evaluate function for the 21-point formula
+        m_kernel->eval(x, y, 21);
+        m_calls += 21;
+        double f_c = y[20];
 
         // Compute the integral using the 10- and 21-point formulae
         m_iter++;
@@ -774,11 +810,9 @@ double GIntegral::gauss_kronrod(const double& a, const double& b) const
         double res21  = gammalib::gkw21b[5] * f_c;
         double resabs = gammalib::gkw21b[5] * std::abs(f_c);
         for (int k = 0; k < 5; ++k) {
-            double x     = h * gammalib::gkx1[k];
-            double fval1 = m_kernel->eval(c+x);
-            double fval2 = m_kernel->eval(c-x);
+            double fval1 = y[2*k];
+            double fval2 = y[2*k+1];
             double fval  = fval1 + fval2;
-            m_calls     += 2;
             res10       += gammalib::gkw10[k]  * fval;
             res21       += gammalib::gkw21a[k] * fval;
             resabs      += gammalib::gkw21a[k] * (std::abs(fval1) + std::abs(fval2));
@@ -787,11 +821,9 @@ double GIntegral::gauss_kronrod(const double& a, const double& b) const
             fv2[k]       = fval2;
         }
         for (int k = 0; k < 5; ++k) {
-            double x = h * gammalib::gkx2[k];
-            double fval1 = m_kernel->eval(c+x);
-            double fval2 = m_kernel->eval(c-x);
+            double fval1 = y[2*k+10];
+            double fval2 = y[2*k+11];
             double fval  = fval1 + fval2;
-            m_calls     += 2;
             res21       += gammalib::gkw21b[k] * fval;
             resabs      += gammalib::gkw21b[k] * (std::abs(fval1) + std::abs(fval2));
             savfun[k+5]  = fval;
@@ -830,10 +862,14 @@ double GIntegral::gauss_kronrod(const double& a, const double& b) const
             res43 += savfun[k] * gammalib::gkw43a[k];
         }
         for (int k = 0; k < 11; ++k) {
-            double x     = h * gammalib::gkx3[k];
-            double fval  = (m_kernel->eval(c+x) +
-                            m_kernel->eval(c-x));
-            m_calls     += 2;
+            double dx = h * gammalib::gkx3[k];
+            x[2*k]    = c + dx;
+            x[2*k+1]  = c - dx;
+        }
+        m_kernel->eval(x, y, 22);
+        m_calls += 22;
+        for (int k = 0; k < 11; ++k) {
+            double fval  = y[2*k] + y[2*k+1];
             res43       += fval * gammalib::gkw43b[k];
             savfun[k+10] = fval;
         }
@@ -859,11 +895,14 @@ double GIntegral::gauss_kronrod(const double& a, const double& b) const
             res87 += savfun[k] * gammalib::gkw87a[k];
         }
         for (int k = 0; k < 22; ++k) {
-            double x = h * gammalib::gkx4[k];
-            res87   += gammalib::gkw87b[k] *
-                       (m_kernel->eval(c+x) +
-                        m_kernel->eval(c-x));
-            m_calls += 2;
+            double dx = h * gammalib::gkx4[k];
+            x[2*k]    = c + dx;
+            x[2*k+1]  = c - dx;
+        }
+        m_kernel->eval(x, y, 44);
+        m_calls += 44;
+        for (int k = 0; k < 22; ++k) {
+            res87 += gammalib::gkw87b[k] * (y[2*k] + y[2*k+1]);
         }
         result = res87 * h ;
 
@@ -351,6 +351,9 @@ void GEbounds::merge(void)
     // Update number of elements in object
     m_num = num;
 
+    // Update attributes
+    set_attributes();
+
     // Return
     return;
 }
@@ -411,7 +414,7 @@ void GEbounds::remove(const int& index)
     // Move all elements located after index forward
     for (int i = index+1; i < m_num; ++i) {
         m_min[i-1] = m_min[i];
-        m_min[i-1] = m_max[i];
+        m_max[i-1] = m_max[i];
     }
 
     // Reduce number of elements by one
@@ -501,7 +504,8 @@ void GEbounds::extend(const GEbounds& ebds)
  * @param[in] emax Maximum energy of last interval.
  *
  * Creates @p num linearly spaced energy boundaries running from @p emin to
- * @p emax.
+ * @p emax. The grid parameters are retained so that index() can compute
+ * the interval of an energy directly.
  ***************************************************************************/
 void GEbounds::set_lin(const int& num, const GEnergy& emin, const GEnergy& emax)
 {
@@ -523,6 +527,14 @@ void GEbounds::set_lin(const int& num, const GEnergy& emin, const GEnergy& emax)
     // Set attributes
     set_attributes();
 
+    // Signal linear grid
+    if (m_sorted && ebin.MeV() > 0.0) {
+        m_grid     = true;
+        m_grid_log = false;
+        m_grid_min = emin.MeV();
+        m_grid_bin = ebin.MeV();
+    }
+
     // Return
     return;
 }
@@ -536,7 +548,8 @@ void GEbounds::set_lin(const int& num, const GEnergy& emin, const GEnergy& emax)
  * @param[in] emax Maximum energy of last interval.
  *
  * Creates @p num logarithmically spaced energy boundaries running from
- * @p emin to @p emax.
+ * @p emin to @p emax. The grid parameters are retained so that index() can
+ * compute the interval of an energy directly.
  ***************************************************************************/
 void GEbounds::set_log(const int& num, const GEnergy& emin, const GEnergy& emax)
 {
@@ -560,6 +573,14 @@ void GEbounds::set_log(const int& num, const GEnergy& emin, const GEnergy& emax)
     // Set attributes
     set_attributes();
 
+    // Signal logarithmic grid
+    if (m_sorted && elogbin > 0.0) {
+        m_grid     = true;
+        m_grid_log = true;
+        m_grid_min = elogmin;
+        m_grid_bin = elogbin;
+    }
+
     // Return
     return;
 }
@@ -816,17 +837,32 @@ void GEbounds::write(GXmlElement& xml) const
  * i.e. and energy equals to max falls above the largest energy.
  *
  * If the energy falls outside all boundaries, -1 is returned.
+ *
+ * If the intervals are ordered and do not overlap the interval is located
+ * by a bi-section search, or computed directly if the boundaries were
+ * created by set_lin() or set_log(). Otherwise all intervals are searched.
  ***************************************************************************/
 int GEbounds::index(const GEnergy& eng) const
 {
     // Initialise index with 'not found'
     int index = -1;
 
-    // Search all energy boundaries for containment
-    for (int i = 0; i < m_num; ++i) {
-        if (eng >= m_min[i] && eng < m_max[i]) {
+    // If intervals are ordered then check the interval with the largest
+    // minimum energy not above the energy
+    if (m_sorted) {
+        int i = find(eng);
+        if (i >= 0 && eng < m_max[i]) {
             index = i;
-            break;
+        }
+    }
+
+    // ... otherwise search all energy boundaries for containment
+    else {
+        for (int i = 0; i < m_num; ++i) {
+            if (eng >= m_min[i] && eng < m_max[i]) {
+                index = i;
+                break;
+            }
         }
     }
 
@@ -981,11 +1017,20 @@ bool GEbounds::contains(const GEnergy& eng) const
     // Initialise test
     bool found = false;
 
-    // Test all energy boundaries
-    for (int i = 0; i < m_num; ++i) {
-        if (eng >= m_min[i] && eng <= m_max[i]) {
-            found = true;
-            break;
+    // If intervals are ordered then check the interval with the largest
+    // minimum energy not above the energy
+    if (m_sorted) {
+        int i = find(eng);
+        found = (i >= 0 && eng <= m_max[i]);
+    }
+
+    // ... otherwise test all energy boundaries
+    else {
+        for (int i = 0; i < m_num; ++i) {
+            if (eng >= m_min[i] && eng <= m_max[i]) {
+                found = true;
+                break;
+            }
         }
     }
 
@@ -1057,6 +1102,11 @@ void GEbounds::init_members(void)
     m_emax.clear();
     m_min = NULL;
     m_max = NULL;
+    m_sorted   = true;
+    m_grid     = false;
+    m_grid_log = false;
+    m_grid_min = 0.0;
+    m_grid_bin = 0.0;
 
     // Return
     return;
@@ -1071,9 +1121,14 @@ void GEbounds::init_members(void)
 void GEbounds::copy_members(const GEbounds& ebds)
 {
     // Copy attributes
-    m_num  = ebds.m_num;
-    m_emin = ebds.m_emin;
-    m_emax = ebds.m_emax;
+    m_num      = ebds.m_num;
+    m_emin     = ebds.m_emin;
+    m_emax     = ebds.m_emax;
+    m_sorted   = ebds.m_sorted;
+    m_grid     = ebds.m_grid;
+    m_grid_log = ebds.m_grid_log;
+    m_grid_min = ebds.m_grid_min;
+    m_grid_bin = ebds.m_grid_bin;
 
     // Copy arrays
     if (m_num > 0) {
@@ -1113,6 +1168,10 @@ void GEbounds::free_members(void)
  *
  * Determines the minimum and maximum energy from all intervals. If no
  * interval is present the minimum and maximum energies are cleared.
+ *
+ * The method also determines whether the intervals are ordered by
+ * increasing energy without overlap, and it discards any grid information
+ * since the intervals may have been modified.
  ***************************************************************************/
 void GEbounds::set_attributes(void)
 {
@@ -1133,6 +1192,18 @@ void GEbounds::set_attributes(void)
         m_emax.clear();
     }
 
+    // Determine whether intervals are ordered and do not overlap
+    m_sorted = true;
+    for (int i = 1; i < m_num; ++i) {
+        if (m_min[i] < m_max[i-1]) {
+            m_sorted = false;
+            break;
+        }
+    }
+
+    // Discard grid information
+    m_grid = false;
+
     // Return
     return;
 }
@@ -1215,3 +1286,63 @@ void GEbounds::insert_eng(const int&     index,
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Find interval with largest minimum energy not above energy
+ *
+ * @param[in] eng Energy.
+ * @return Interval index (-1 if energy is below all intervals).
+ *
+ * Returns the index of the last interval with a minimum energy not above
+ * @p eng. The method requires that the intervals are ordered and do not
+ * overlap. For a regular grid the index is computed from the energy and
+ * then corrected for rounding errors, otherwise a bi-section search is
+ * done.
+ ***************************************************************************/
+int GEbounds::find(const GEnergy& eng) const
+{
+    // Initialise index with 'not found'
+    int index = -1;
+
+    // Continue only if the energy is not below the first interval
+    if (m_num > 0 && eng >= m_min[0]) {
+
+        // If intervals form a grid then compute the index and correct it
+        // for rounding errors
+        if (m_grid) {
+            double x = (m_grid_log) ? eng.log10MeV() : eng.MeV();
+            double u = (x - m_grid_min) / m_grid_bin;
+            index    = (u < double(m_num)) ? int(u) : m_num-1;
+            if (index < 0) {
+                index = 0;
+            }
+            while (index > 0 && eng < m_min[index]) {
+                index--;
+            }
+            while (index < m_num-1 && eng >= m_min[index+1]) {
+                index++;
+            }
+        }
+
+        // ... otherwise do a bi-section search
+        else {
+            int low  = 0;
+            int high = m_num;
+            while (high - low > 1) {
+                int mid = (low + high) / 2;
+                if (eng < m_min[mid]) {
+                    high = mid;
+                }
+                else {
+                    low = mid;
+                }
+            }
+            index = low;
+        }
+
+    } // endif: energy was not below first interval
+
+    // Return index
+    return index;
+}
@@ -265,8 +265,8 @@ void GGti::insert(const GTime& tstart, const GTime& tstop)
 {
     // Determine index at which GTI should be inserted
     int inx = 0;
-    for (int i = 0; i < m_num; ++i) {
-        if (tstart < m_start[i]) {
+    for (; inx < m_num; ++inx) {
+        if (tstart < m_start[inx]) {
             break;
         }
     }
@@ -318,6 +318,9 @@ void GGti::merge(void)
     // Update number of elements in GTI
     m_num = num;
 
+    // Update attributes
+    set_attributes();
+
     // Return
     return;
 }
@@ -405,10 +408,11 @@ void GGti::reduce(const GTime& tstart, const GTime& tstop)
         GTime* stop  = new GTime[num];
 
         // Copy valid intervals
-        for (int i = 0; i < m_num; ++i) {
+        for (int i = 0, inx = 0; i < m_num; ++i) {
             if (m_start[i] <= m_stop[i]) {
-                start[i] = m_start[i];
-                stop[i]  = m_stop[i];
+                start[inx] = m_start[i];
+                stop[inx]  = m_stop[i];
+                inx++;
             }
         }
 
@@ -917,17 +921,31 @@ const GTimeReference& GGti::reference(void) const
  * Checks if a given @p time falls in at least one of the Good Time
  * Intervals. The method exits when the first matching interval has been
  * found.
+ *
+ * If the Good Time Intervals are ordered and do not overlap, the last
+ * Good Time Interval with a start time not after @p time is located using
+ * the interval found by the previous call as a starting point, and only
+ * this interval is tested. Otherwise all Good Time Intervals are tested.
  ***************************************************************************/
 bool GGti::contains(const GTime& time) const
 {
     // Initialise test
     bool found = false;
 
-    // Test all GTIs
-    for (int i = 0; i < m_num; ++i) {
-        if (time >= m_start[i] && time <= m_stop[i]) {
-            found = true;
-            break;
+    // If GTIs are ordered then test the GTI with the latest start time not
+    // after the time
+    if (m_sorted) {
+        int i = find(time);
+        found = (i >= 0 && time <= m_stop[i]);
+    }
+
+    // ... otherwise test all GTIs
+    else {
+        for (int i = 0; i < m_num; ++i) {
+            if (time >= m_start[i] && time <= m_stop[i]) {
+                found = true;
+                break;
+            }
         }
     }
 
@@ -1000,6 +1018,7 @@ void GGti::init_members(void)
     m_telapse = 0.0;
     m_start   = NULL;
     m_stop    = NULL;
+    m_sorted  = true;
 
     // Initialise time reference with native reference
     GTime time;
@@ -1024,6 +1043,7 @@ void GGti::copy_members(const GGti& gti)
     m_ontime    = gti.m_ontime;
     m_telapse   = gti.m_telapse;
     m_reference = gti.m_reference;
+    m_sorted    = gti.m_sorted;
 
     // Copy start/stop times
     if (m_num > 0) {
@@ -1067,6 +1087,7 @@ void GGti::free_members(void)
  *     m_stop    - Latest stop time of GTIs
  *     m_telapse - Latest stop time minus earliest start time of GTIs [sec]
  *     m_ontime  - Sum of all intervals [sec]
+ *     m_sorted  - Signals that GTIs are ordered and do not overlap
  ***************************************************************************/
 void GGti::set_attributes(void)
 {
@@ -1094,6 +1115,15 @@ void GGti::set_attributes(void)
         m_ontime += (m_stop[i].secs() - m_start[i].secs());
     }
 
+    // Determine whether GTIs are ordered and do not overlap
+    m_sorted = true;
+    for (int i = 1; i < m_num; ++i) {
+        if (m_start[i] < m_stop[i-1]) {
+            m_sorted = false;
+            break;
+        }
+    }
+
     // Return
     return;
 }
@@ -1173,3 +1203,84 @@ void GGti::insert_gti(const int& index, const GTime& tstart, const GTime& tstop)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Find Good Time Interval with latest start time not after time
+ *
+ * @param[in] time Time.
+ * @return Good Time Interval index (-1 if time is before all GTIs).
+ *
+ * Returns the index of the last Good Time Interval with a start time not
+ * after @p time. The method requires that the Good Time Intervals are
+ * ordered and do not overlap.
+ *
+ * The search starts from the interval found by the previous call of the
+ * calling thread. The search range is doubled until it brackets @p time,
+ * followed by a bi-section search within the range. For a time ordered sequence of
+ * times this takes on average a constant time per call, and at most a
+ * time that is logarithmic in the number of Good Time Intervals.
+ ***************************************************************************/
+int GGti::find(const GTime& time) const
+{
+    // Search hint of calling thread. The hint is shared by all Good Time
+    // Intervals that are searched by the thread
+    static int last = 0;
+    #pragma omp threadprivate(last)
+
+    // Initialise index with 'not found'
+    int index = -1;
+
+    // Continue only if the time is not before the first GTI
+    if (m_num > 0 && time >= m_start[0]) {
+
+        // Get search hint. Since the hint is only used as a starting point
+        // any value within the valid range is fine.
+        int hint = last;
+        if (hint < 0 || hint >= m_num) {
+            hint = 0;
+        }
+
+        // Bracket the time in [low, high[ by doubling the search range
+        // from the hint. The backward search terminates since the time is
+        // not before the first GTI.
+        int low  = hint;
+        int high = hint + 1;
+        int step = 1;
+        if (time < m_start[low]) {
+            high = low;
+            low  = (high > step) ? high - step : 0;
+            while (time < m_start[low]) {
+                high  = low;
+                step *= 2;
+                low   = (high > step) ? high - step : 0;
+            }
+        }
+        else {
+            while (high < m_num && time >= m_start[high]) {
+                low   = high;
+                high  = (m_num - high > step) ? high + step : m_num;
+                step *= 2;
+            }
+        }
+
+        // Bi-section search within [low, high[
+        while (high - low > 1) {
+            int mid = (low + high) / 2;
+            if (time < m_start[mid]) {
+                high = mid;
+            }
+            else {
+                low = mid;
+            }
+        }
+
+        // Set index and store hint
+        index = low;
+        last  = low;
+
+    } // endif: time was not before first GTI
+
+    // Return index
+    return index;
+}
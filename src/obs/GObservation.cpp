@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <vector>
 #include "GException.hpp"
 #include "GObservation.hpp"
 #include "GModelSky.hpp"
@@ -38,10 +39,18 @@
 #include "GEventCube.hpp"
 #include "GEventList.hpp"
 #include "GEventBin.hpp"
+#include "GMatrixSymmetric.hpp"
+
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Method name definitions ____________________________________________ */
 #define G_LIKELIHOOD           "GObservation::likelihood(GModels&, GVector*,"\
-                                                  " GMatrixSparse*, double*)"
+                  " GMatrixSparse*, double*, std::vector<GMatrixSymmetric>*)"
+#define G_LIKELIHOOD_EVENTS   "GObservation::likelihood_events(GModels&, ..."\
+                  " GMatrixSparse*, std::vector<GMatrixSymmetric>*, double*)"
 #define G_MODEL                   "GObservation::model(GModels&, GPointing&,"\
                                     " GInstDir&, GEnergy&, GTime&, GVector*)"
 #define G_EVENTS                                     "GObservation::events()"
@@ -51,6 +60,7 @@
 /* __ Constants __________________________________________________________ */
 const double minmod = 1.0e-100;                      //!< Minimum model value
 const double minerr = 1.0e-100;                //!< Minimum statistical error
+const int    min_thread_events = 100;       //!< Minimum events per thread
 
 /* __ Macros _____________________________________________________________ */
 
@@ -161,16 +171,27 @@ GObservation& GObservation::operator=(const GObservation& obs)
  * @param[in,out] gradient Pointer to gradients.
  * @param[in,out] curvature Pointer to curvature matrix.
  * @param[in,out] npred Pointer to Npred value.
+ * @param[in,out] dense Pointer to dense curvature accumulators (optional).
  * @return Likelihood.
  *
  * Computes the likelihood for a specified set of models. The method also
  * returns the gradients, the curvature matrix, and the number of events
  * that are predicted by all models.
+ *
+ * If @p dense is not NULL, the curvature contributions of the events are
+ * not added to the @p curvature matrix but to the dense accumulators in
+ * the vector pointed to by @p dense (see likelihood_events()). The vector
+ * needs to hold at least one accumulator of dimension npars x npars; the
+ * number of accumulators limits the number of threads that are used for
+ * the event loop. The accumulators are owned by the caller, which keeps
+ * them across likelihood evaluations and adds them to the curvature matrix
+ * once all observations have been evaluated.
  ***************************************************************************/
-double GObservation::likelihood(const GModels& models,
-                                GVector*       gradient,
-                                GMatrixSparse* curvature,
-                                double*        npred) const
+double GObservation::likelihood(const GModels&                 models,
+                                GVector*                       gradient,
+                                GMatrixSparse*                 curvature,
+                                double*                        npred,
+                                std::vector<GMatrixSymmetric>* dense) const
 {
     // Initialise likelihood value
     double value = 0.0;
@@ -188,6 +209,7 @@ double GObservation::likelihood(const GModels& models,
             value = likelihood_poisson_unbinned(models,
                                                 gradient,
                                                 curvature,
+                                                dense,
                                                 npred);
 
         } // endif: Poisson statistics
@@ -208,15 +230,17 @@ double GObservation::likelihood(const GModels& models,
             value = likelihood_poisson_binned(models,
                                               gradient,
                                               curvature,
+                                              dense,
                                               npred);
         }
 
         // ... or Gaussian statistics
         else if (statistics == "GAUSSIAN") {
             value = likelihood_gaussian_binned(models,
-                                              gradient,
-                                              curvature,
-                                              npred);
+                                               gradient,
+                                               curvature,
+                                               dense,
+                                               npred);
         }
 
         // ... or unsupported
@@ -295,8 +319,23 @@ double GObservation::model(const GModels& models, const GEvent& event,
                 // For energy dispersion, no gradients are available as we
                 // have not implemented code that integrates the gradients
                 // over the energy dispersion. Here it's simpler to just use
-                // numerical gradients.
+                // numerical gradients. The spatial parameters of a sky
+                // model, which come first, only have a gradient if the
+                // response computes the spatial model gradients (see
+                // GResponse::has_irf_gradients()).
                 if (gradient != NULL) {
+
+                    // Determine number of spatial parameters without
+                    // gradient
+                    int              nspatial = 0;
+                    const GModelSky* sky      = dynamic_cast<const GModelSky*>(mptr);
+                    if (sky != NULL && sky->spatial() != NULL &&
+                        sky->spatial()->code() != GMODEL_SPATIAL_DIFFUSE &&
+                        !response()->has_irf_gradients(*(sky->spatial()))) {
+                        nspatial = sky->spatial()->size();
+                    }
+
+                    // Loop over model parameters
                     for (int ipar = 0; ipar < mptr->size(); ++ipar) {
 
                         // Get reference to model parameter
@@ -318,7 +357,8 @@ double GObservation::model(const GModels& models, const GEvent& event,
                         #endif
 
                         if (par.is_free()) {
-                            if (par.has_grad() && !response()->use_edisp()) {
+                            if (par.has_grad() && ipar >= nspatial &&
+                                !response()->use_edisp()) {
                                 (*gradient)[igrad+ipar] = par.factor_gradient();
                             }
                             else {
@@ -520,7 +560,8 @@ double GObservation::npred(const GModel& model) const
  * @param[in] event Event.
  *
  * This method uses a robust but simple difference method to estimate
- * parameter gradients that have not been provided by the model. We use here
+ * parameter gradients that have not been provided by the model or by the
+ * response (see GResponse::irf_gradients()). We use here
  * a simple method as this method is likely used for spatial model parameters,
  * and the spatial model may eventually be noisy due to numerical integration
  * limits.
@@ -825,6 +866,7 @@ void GObservation::free_members(void)
  * @param[in] models Models.
  * @param[in,out] gradient Gradient.
  * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulators (optional).
  * @param[in,out] npred Number of predicted events.
  * @return Likelihood value.
  *
@@ -841,11 +883,16 @@ void GObservation::free_members(void)
  * \f$\delta L/dp\f$
  * and the curvature matrix
  * \f$\delta^2 L/dp_1 dp_2\f$.
+ *
+ * The sum over the events is computed by likelihood_events(), which
+ * distributes the events over several threads if the observation is
+ * thread safe.
  ***************************************************************************/
-double GObservation::likelihood_poisson_unbinned(const GModels& models,
-                                                 GVector*       gradient,
-                                                 GMatrixSparse* curvature,
-                                                 double*        npred) const
+double GObservation::likelihood_poisson_unbinned(const GModels&                 models,
+                                                 GVector*                       gradient,
+                                                 GMatrixSparse*                 curvature,
+                                                 std::vector<GMatrixSymmetric>* dense,
+                                                 double*                        npred) const
 {
     // Initialise likelihood value
     double value = 0.0;
@@ -853,9 +900,7 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
     // Get number of parameters
     int npars = gradient->size();
 
-    // Allocate some working arrays
-    int*    inx    = new int[npars];
-    double* values = new double[npars];
+    // Allocate working vector
     GVector wrk_grad(npars);
 
     // Determine Npred value and gradient for this observation
@@ -866,8 +911,322 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
     *npred    += npred_value;
     *gradient += wrk_grad;
 
+    // Add contribution of all events
+    value += likelihood_events(&GObservation::poisson_unbinned_kernel,
+                               models, gradient, curvature, dense, npred);
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        binned analysis (version with working arrays)
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulators (optional).
+ * @param[in,out] npred Number of predicted events.
+ * @return Likelihood value.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using binned analysis and Poisson statistics.
+ * The -(log-likelihood) function is given by
+ * \f$L=-\sum_i n_i \log e_i - e_i\f$
+ * where the sum is taken over all data space bins, \f$n_i\f$ is the
+ * observed number of counts and \f$e_i\f$ is the model.
+ * This method also computes the parameter gradients
+ * \f$\delta L/dp\f$
+ * and the curvature matrix
+ * \f$\delta^2 L/dp_1 dp_2\f$
+ * and also updates the total number of predicted events m_npred.
+ ***************************************************************************/
+double GObservation::likelihood_poisson_binned(const GModels&                 models,
+                                               GVector*                       gradient,
+                                               GMatrixSparse*                 curvature,
+                                               std::vector<GMatrixSymmetric>* dense,
+                                               double*                        npred) const
+{
+    // Compute likelihood by summing over all bins
+    double value = likelihood_events(&GObservation::poisson_binned_kernel,
+                                     models, gradient, curvature, dense,
+                                     npred);
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Gaussian statistics and
+ *        binned analysis (version with working arrays)
+ *
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulators (optional).
+ * @param[in,out] npred Number of predicted events.
+ * @return Likelihood value.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using binned analysis and Poisson statistics.
+ * The -(log-likelihood) function is given by
+ * \f$L = 1/2 \sum_i (n_i - e_i)^2 \sigma_i^{-2}\f$
+ * where the sum is taken over all data space bins, \f$n_i\f$ is the
+ * observed number of counts, \f$e_i\f$ is the model and \f$\sigma_i\f$
+ * is the statistical uncertainty.
+ * This method also computes the parameter gradients
+ * \f$\delta L/dp\f$
+ * and the curvature matrix
+ * \f$\delta^2 L/dp_1 dp_2\f$
+ * and also updates the total number of predicted events m_npred.
+ ***************************************************************************/
+double GObservation::likelihood_gaussian_binned(const GModels&                 models,
+                                                GVector*                       gradient,
+                                                GMatrixSparse*                 curvature,
+                                                std::vector<GMatrixSymmetric>* dense,
+                                                double*                        npred) const
+{
+    // Compute likelihood by summing over all bins
+    double value = likelihood_events(&GObservation::gaussian_binned_kernel,
+                                     models, gradient, curvature, dense,
+                                     npred);
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Sum likelihood kernel over all events
+ *
+ * @param[in] kernel Likelihood kernel.
+ * @param[in] models Models.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulators (optional).
+ * @param[in,out] npred Number of predicted events.
+ * @return Likelihood value.
+ *
+ * Evaluates the likelihood @p kernel for all events (or bins) of the
+ * observation.
+ *
+ * If OpenMP is available, if the observation is thread safe (see
+ * is_threadsafe()), and if the method is not called from within an active
+ * parallel region (such as the loop over observations in
+ * GObservations::likelihood::eval), the events are partitioned into one
+ * contiguous block per thread. Each block is evaluated using its own copy
+ * of the models and its own likelihood, Npred, gradient and curvature
+ * accumulators. The partial results are then added in block order, so that
+ * for a given number of threads the result does not depend on the thread
+ * scheduling. The block curvature matrices accumulate their values on the
+ * sparsity pattern of the @p curvature matrix (see
+ * GMatrixSparse::pattern_init()) and are merged using
+ * GMatrixSparse::add_matrices(), which sums the values on the pattern in
+ * place and only assembles the elements that are not part of the pattern.
+ *
+ * If @p dense is not NULL, the kernels accumulate the curvature using
+ * rank-1 updates of the dense accumulators instead of the @p curvature
+ * matrix. Block @p i adds to the accumulator @p (*dense)[i], and the
+ * number of blocks is limited to the number of accumulators in @p dense.
+ * The accumulators are neither allocated nor reduced by this method; this
+ * is left to the caller.
+ *
+ * @exception GException::invalid_argument
+ *            Dense accumulator vector is empty or accumulator dimension
+ *            differs from number of parameters.
+ ***************************************************************************/
+double GObservation::likelihood_events(likelihood_kernel              kernel,
+                                       const GModels&                 models,
+                                       GVector*                       gradient,
+                                       GMatrixSparse*                 curvature,
+                                       std::vector<GMatrixSymmetric>* dense,
+                                       double*                        npred) const
+{
+    // Initialise likelihood value
+    double value = 0.0;
+
+    // Get number of events and parameters
+    int nevents = events()->size();
+    int npars   = gradient->size();
+
+    // Check dense accumulators
+    if (dense != NULL) {
+        if (dense->empty()) {
+            std::string msg = "No dense curvature accumulators specified. "
+                              "Please specify at least one accumulator.";
+            throw GException::invalid_argument(G_LIKELIHOOD_EVENTS, msg);
+        }
+        for (int i = 0; i < int(dense->size()); ++i) {
+            if ((*dense)[i].rows() != npars || (*dense)[i].columns() != npars) {
+                std::string msg = "Dense curvature accumulator "+
+                                  gammalib::str(i)+" has dimension "+
+                                  gammalib::str((*dense)[i].rows())+" x "+
+                                  gammalib::str((*dense)[i].columns())+
+                                  " but "+gammalib::str(npars)+" x "+
+                                  gammalib::str(npars)+" is required. "
+                                  "Please specify accumulators that match "
+                                  "the number of parameters.";
+                throw GException::invalid_argument(G_LIKELIHOOD_EVENTS, msg);
+            }
+        }
+    }
+
+    // Determine number of event blocks. Use only a single block if the
+    // observation is not thread safe, if we are already within a parallel
+    // region or if there are too few events per thread
+    int nblocks = 1;
+    #ifdef _OPENMP
+    if (is_threadsafe() && !omp_in_parallel()) {
+        nblocks = omp_get_max_threads();
+        if (nblocks > nevents / min_thread_events) {
+            nblocks = nevents / min_thread_events;
+        }
+        if (dense != NULL && nblocks > int(dense->size())) {
+            nblocks = int(dense->size());
+        }
+        if (nblocks < 1) {
+            nblocks = 1;
+        }
+    }
+    #endif
+
+    // If we have a single block then sum directly into the output
+    // arguments
+    if (nblocks == 1) {
+        GMatrixSymmetric* block_dense = (dense != NULL) ? &((*dense)[0]) : NULL;
+        value = (this->*kernel)(models, 0, nevents, gradient, curvature,
+                                block_dense, npred);
+    }
+
+    // ... otherwise use one set of accumulators per block
+    else {
+
+        // Set stack size and number of entries
+        int stack_size  = (2*npars > 100000) ? 2*npars : 100000;
+        int max_entries =  2*npars;
+
+        // Allocate block accumulators. Sparse block curvature matrices are
+        // only needed if no dense accumulators were specified
+        int nsparse = (dense == NULL) ? nblocks : 0;
+        std::vector<double>        values(nblocks, 0.0);
+        std::vector<double>        npreds(nblocks, 0.0);
+        std::vector<GVector>       gradients(nblocks, GVector(npars));
+        std::vector<GMatrixSparse> curvatures(nsparse, GMatrixSparse(npars,npars));
+
+        // Evaluate blocks in parallel. Each thread works on its own copy
+        // of the models since model evaluation and numerical gradient
+        // computation modify the model state
+        #pragma omp parallel num_threads(nblocks)
+        {
+            // Allocate model copy for this thread
+            GModels thread_models(models);
+
+            // Loop over blocks
+            #pragma omp for schedule(static)
+            for (int iblock = 0; iblock < nblocks; ++iblock) {
+
+                // Determine event range of block
+                int ifirst = int((long long)(nevents) * iblock / nblocks);
+                int ilast  = int((long long)(nevents) * (iblock+1) / nblocks);
+
+                // Set curvature accumulators of block
+                GMatrixSparse*    block_curvature = NULL;
+                GMatrixSymmetric* block_dense     = NULL;
+                if (dense != NULL) {
+                    block_dense = &((*dense)[iblock]);
+                }
+                else {
+                    block_curvature = &(curvatures[iblock]);
+                    block_curvature->pattern_init(*curvature);
+                    block_curvature->stack_init(stack_size, max_entries);
+                }
+
+                // Evaluate block
+                values[iblock] = (this->*kernel)(thread_models,
+                                                 ifirst,
+                                                 ilast,
+                                                 &(gradients[iblock]),
+                                                 block_curvature,
+                                                 block_dense,
+                                                 &(npreds[iblock]));
+
+                // Flush and release stack
+                if (block_curvature != NULL) {
+                    block_curvature->stack_destroy();
+                }
+
+            } // endfor: looped over blocks
+
+        } // end pragma omp parallel
+
+        // Reduce block accumulators in block order
+        for (int iblock = 0; iblock < nblocks; ++iblock) {
+            value      += values[iblock];
+            *npred     += npreds[iblock];
+            *gradient  += gradients[iblock];
+        }
+
+        // Merge sparse block curvature matrices. Values on the sparsity
+        // pattern are summed in place, the other elements are assembled in
+        // a single pass with parallel column assembly
+        if (nsparse > 0) {
+            std::vector<const GMatrixSparse*> block_curvatures;
+            for (int iblock = 0; iblock < nsparse; ++iblock) {
+                block_curvatures.push_back(&(curvatures[iblock]));
+            }
+            curvature->add_matrices(block_curvatures);
+        }
+
+    } // endelse: used several blocks
+
+    // Return
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Likelihood kernel for Poisson statistics and unbinned analysis
+ *
+ * @param[in] models Models.
+ * @param[in] ifirst Index of first event.
+ * @param[in] ilast Index after last event.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulator (optional).
+ * @return Likelihood value.
+ *
+ * Computes the contribution \f$-\sum_i \log e_i\f$ of the events
+ * [@p ifirst, @p ilast[ to the -(log-likelihood) function, and the
+ * corresponding contributions to the parameter gradients and the
+ * curvature matrix. The Npred contribution is handled by
+ * likelihood_poisson_unbinned(). If a @p dense curvature accumulator is
+ * specified the curvature contributions are added to the accumulator
+ * instead of the curvature matrix.
+ ***************************************************************************/
+double GObservation::poisson_unbinned_kernel(const GModels&    models,
+                                             const int&        ifirst,
+                                             const int&        ilast,
+                                             GVector*          gradient,
+                                             GMatrixSparse*    curvature,
+                                             GMatrixSymmetric* dense,
+                                             double*) const
+{
+    // Initialise likelihood value
+    double value = 0.0;
+
+    // Get number of parameters
+    int npars = gradient->size();
+
+    // Allocate some working arrays
+    int*    inx    = new int[npars];
+    double* values = new double[npars];
+    GVector wrk_grad(npars);
+
     // Iterate over all events
-    for (int i = 0; i < events()->size(); ++i) {
+    for (int i = ifirst; i < ilast; ++i) {
 
         // Get event pointer
         const GEvent* event = (*events())[i];
@@ -903,6 +1262,18 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
         // Update gradient vector and curvature matrix.
         double fb = 1.0 / model;
         double fa = fb / model;
+
+        // If we have a dense curvature accumulator then update the gradient
+        // and add a rank-1 update to the dense curvature matrix
+        if (dense != NULL) {
+            for (int jdev = 0; jdev < ndev; ++jdev) {
+                (*gradient)[inx[jdev]] -= fb * wrk_grad[inx[jdev]];
+            }
+            dense->rank1_update(fa, wrk_grad, inx, ndev);
+            continue;
+        }
+
+        // ... otherwise update the sparse curvature matrix column by column
         for (int jdev = 0; jdev < ndev; ++jdev) {
 
             // Initialise computation
@@ -937,31 +1308,30 @@ double GObservation::likelihood_poisson_unbinned(const GModels& models,
 
 
 /***********************************************************************//**
- * @brief Evaluate log-likelihood function for Poisson statistics and
- *        binned analysis (version with working arrays)
+ * @brief Likelihood kernel for Poisson statistics and binned analysis
  *
  * @param[in] models Models.
+ * @param[in] ifirst Index of first bin.
+ * @param[in] ilast Index after last bin.
  * @param[in,out] gradient Gradient.
  * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulator (optional).
  * @param[in,out] npred Number of predicted events.
  * @return Likelihood value.
  *
- * This method evaluates the -(log-likelihood) function for parameter
- * optimisation using binned analysis and Poisson statistics.
- * The -(log-likelihood) function is given by
- * \f$L=-\sum_i n_i \log e_i - e_i\f$
- * where the sum is taken over all data space bins, \f$n_i\f$ is the
- * observed number of counts and \f$e_i\f$ is the model.
- * This method also computes the parameter gradients
- * \f$\delta L/dp\f$
- * and the curvature matrix
- * \f$\delta^2 L/dp_1 dp_2\f$
- * and also updates the total number of predicted events m_npred.
+ * Computes the contribution of the bins [@p ifirst, @p ilast[ to the
+ * -(log-likelihood) function, the parameter gradients, the curvature
+ * matrix and the number of predicted events. If a @p dense curvature
+ * accumulator is specified the curvature contributions are added to the
+ * accumulator instead of the curvature matrix.
  ***************************************************************************/
-double GObservation::likelihood_poisson_binned(const GModels& models,
-                                               GVector*       gradient,
-                                               GMatrixSparse* curvature,
-                                               double*        npred) const
+double GObservation::poisson_binned_kernel(const GModels&    models,
+                                           const int&        ifirst,
+                                           const int&        ilast,
+                                           GVector*          gradient,
+                                           GMatrixSparse*    curvature,
+                                           GMatrixSymmetric* dense,
+                                           double*           npred) const
 {
     // Initialise likelihood value
     double value = 0.0;
@@ -987,7 +1357,7 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
     GVector wrk_grad(npars);
 
     // Iterate over all bins
-    for (int i = 0; i < events()->size(); ++i) {
+    for (int i = ifirst; i < ilast; ++i) {
 
         // Update number of bins
         #if defined(G_OPT_DEBUG)
@@ -1068,6 +1438,16 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
             double fc = (1.0 - fb);
             double fa = fb / model;
 
+            // If we have a dense curvature accumulator then update the
+            // gradient and add a rank-1 update to the dense curvature matrix
+            if (dense != NULL) {
+                for (int jdev = 0; jdev < ndev; ++jdev) {
+                    (*gradient)[inx[jdev]] += fc * wrk_grad[inx[jdev]];
+                }
+                dense->rank1_update(fa, wrk_grad, inx, ndev);
+                continue;
+            }
+
             // Loop over columns
             for (int jdev = 0; jdev < ndev; ++jdev) {
 
@@ -1133,7 +1513,7 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
     std::cout << "Sum of data: " << sum_data << std::endl;
     std::cout << "Sum of model: " << sum_model << std::endl;
     std::cout << "Initial statistics: " << init_value << std::endl;
-    std::cout << "Statistics: " << m_value-init_value << std::endl;
+    std::cout << "Statistics: " << value-init_value << std::endl;
     #endif
 
     // Return
@@ -1142,32 +1522,30 @@ double GObservation::likelihood_poisson_binned(const GModels& models,
 
 
 /***********************************************************************//**
- * @brief Evaluate log-likelihood function for Gaussian statistics and
- *        binned analysis (version with working arrays)
+ * @brief Likelihood kernel for Gaussian statistics and binned analysis
  *
  * @param[in] models Models.
+ * @param[in] ifirst Index of first bin.
+ * @param[in] ilast Index after last bin.
  * @param[in,out] gradient Gradient.
  * @param[in,out] curvature Curvature matrix.
+ * @param[in,out] dense Dense curvature accumulator (optional).
  * @param[in,out] npred Number of predicted events.
  * @return Likelihood value.
  *
- * This method evaluates the -(log-likelihood) function for parameter
- * optimisation using binned analysis and Poisson statistics.
- * The -(log-likelihood) function is given by
- * \f$L = 1/2 \sum_i (n_i - e_i)^2 \sigma_i^{-2}\f$
- * where the sum is taken over all data space bins, \f$n_i\f$ is the
- * observed number of counts, \f$e_i\f$ is the model and \f$\sigma_i\f$
- * is the statistical uncertainty.
- * This method also computes the parameter gradients
- * \f$\delta L/dp\f$
- * and the curvature matrix
- * \f$\delta^2 L/dp_1 dp_2\f$
- * and also updates the total number of predicted events m_npred.
+ * Computes the contribution of the bins [@p ifirst, @p ilast[ to the
+ * -(log-likelihood) function, the parameter gradients, the curvature
+ * matrix and the number of predicted events. If a @p dense curvature
+ * accumulator is specified the curvature contributions are added to the
+ * accumulator instead of the curvature matrix.
  ***************************************************************************/
-double GObservation::likelihood_gaussian_binned(const GModels& models,
-                                                GVector*       gradient,
-                                                GMatrixSparse* curvature,
-                                                double*        npred) const
+double GObservation::gaussian_binned_kernel(const GModels&    models,
+                                            const int&        ifirst,
+                                            const int&        ilast,
+                                            GVector*          gradient,
+                                            GMatrixSparse*    curvature,
+                                            GMatrixSymmetric* dense,
+                                            double*           npred) const
 {
     // Initialise likelihood value
     double value = 0.0;
@@ -1181,7 +1559,7 @@ double GObservation::likelihood_gaussian_binned(const GModels& models,
     GVector wrk_grad(npars);
 
     // Iterate over all bins
-    for (int i = 0; i < events()->size(); ++i) {
+    for (int i = ifirst; i < ilast; ++i) {
 
         // Get event pointer
         const GEventBin* bin =
@@ -1243,6 +1621,16 @@ double GObservation::likelihood_gaussian_binned(const GModels& models,
             continue;
         }
 
+        // If we have a dense curvature accumulator then update the gradient
+        // and add a rank-1 update to the dense curvature matrix
+        if (dense != NULL) {
+            for (int jdev = 0; jdev < ndev; ++jdev) {
+                (*gradient)[inx[jdev]] -= fa * (wrk_grad[inx[jdev]] * weight);
+            }
+            dense->rank1_update(weight, wrk_grad, inx, ndev);
+            continue;
+        }
+
         // Loop over columns
         for (int jdev = 0; jdev < ndev; ++jdev) {
 
@@ -183,6 +183,29 @@ GObservations::likelihood& GObservations::likelihood::operator=(const likelihood
  * Poisson and Gaussian statistics. 
  * Note that different statistics and different analysis methods
  * (binned/unbinned) may be combined.
+ *
+ * If the observations are distributed over the threads, each thread
+ * accumulates the curvature in its own sparse matrix, and the matrices of
+ * all threads are merged at the end. The curvature matrix of the previous
+ * evaluation is kept as sparsity pattern, and all thread matrices
+ * accumulate their values on that pattern, so that only values are summed
+ * and the merge reduces to adding the value arrays of all threads. Only
+ * elements that are not part of the pattern are inserted as matrix
+ * elements and are assembled into the curvature matrix.
+ *
+ * If the number of parameters does not exceed
+ * GObservation::max_dense_pars, the curvature is instead accumulated in
+ * dense accumulators, one per thread, using rank-1 updates. If the
+ * observations are distributed over the threads each thread owns one set
+ * with a single accumulator, otherwise a single set with one accumulator
+ * per thread is passed to GObservation::likelihood(), which distributes the
+ * events of each observation over these accumulators. The accumulators are
+ * kept across evaluations and are only reallocated if their layout or the
+ * number of parameters changes. At the end of the evaluation
+ * they are summed in thread order and written into the curvature matrix,
+ * which is also kept across evaluations, so that no memory is allocated
+ * for the curvature once the sparsity pattern of the curvature matrix is
+ * established.
  ***************************************************************************/
 void GObservations::likelihood::eval(const GOptimizerPars& pars) 
 {
@@ -206,113 +229,215 @@ void GObservations::likelihood::eval(const GOptimizerPars& pars)
             continue;
         }
 
-        // Free old memory
-        if (m_gradient  != NULL) delete m_gradient;
-        if (m_curvature != NULL) delete m_curvature;
+        // Determine whether the curvature is accumulated in dense
+        // accumulators
+        bool use_dense = (npars <= GObservation::max_dense_pars);
+
+        // Free old memory. The curvature matrix is kept if its size did
+        // not change. In dense mode its values are overwritten in place,
+        // otherwise it provides the sparsity pattern for the evaluation
+        GMatrixSparse* pattern = NULL;
+        if (m_gradient != NULL) delete m_gradient;
+        if (m_curvature != NULL && m_curvature->rows() != npars) {
+            delete m_curvature;
+            m_curvature = NULL;
+        }
+        if (!use_dense) {
+            pattern     = m_curvature;
+            m_curvature = NULL;
+        }
 
         // Initialise value, gradient vector and curvature matrix
-        m_value     = 0.0;
-        m_npred     = 0.0;
-        m_gradient  = new GVector(npars);
-        m_curvature = new GMatrixSparse(npars,npars);
+        m_value    = 0.0;
+        m_npred    = 0.0;
+        m_gradient = new GVector(npars);
+        if (m_curvature == NULL) {
+            m_curvature = new GMatrixSparse(npars,npars);
+            if (pattern != NULL) {
+                m_curvature->pattern_init(*pattern);
+            }
+        }
 
         // Set stack size and number of entries
         int stack_size  = (2*npars > 100000) ? 2*npars : 100000;
         int max_entries =  2*npars;
-        m_curvature->stack_init(stack_size, max_entries);
 
-        // Allocate vectors to save working variables of each thread
-        std::vector<GVector*>       vect_cpy_grad;
-        std::vector<GMatrixSparse*> vect_cpy_curvature;
-        std::vector<double*>        vect_cpy_value;
-        std::vector<double*>        vect_cpy_npred;
+        // Allocate vectors to save working variables of each thread. The
+        // working variables are indexed by the thread number, so that they
+        // are always added in the same order.
+        int nthreads = 1;
+        #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+        #endif
+        std::vector<GVector*>       vect_cpy_grad(nthreads, NULL);
+        std::vector<GMatrixSparse*> vect_cpy_curvature(nthreads, NULL);
+        std::vector<double*>        vect_cpy_value(nthreads, NULL);
+        std::vector<double*>        vect_cpy_npred(nthreads, NULL);
+
+        // Decide whether the observations are distributed over the threads
+        // or whether the observations are computed one after the other so
+        // that GObservation::likelihood() distributes the events of each
+        // observation over the threads. Event-level parallelism is used
+        // if there are fewer observations than threads and if all
+        // observations support it; otherwise threads would stay idle.
+        bool obs_parallel = (m_this->size() > 1);
+        if (obs_parallel && m_this->size() < nthreads) {
+            bool threadsafe = true;
+            for (int i = 0; i < m_this->size(); ++i) {
+                if (!m_this->m_obs[i]->is_threadsafe()) {
+                    threadsafe = false;
+                    break;
+                }
+            }
+            obs_parallel = !threadsafe;
+        }
+
+        // Set up dense curvature accumulators. If the observations are
+        // distributed over the threads each thread gets a set holding a
+        // single accumulator, otherwise a single set holds one accumulator
+        // per thread so that GObservation::likelihood() can distribute the
+        // events over the threads. The accumulators are only reallocated
+        // if their layout or the number of parameters changed, otherwise
+        // they are reset
+        if (use_dense) {
+            int nsets  = (obs_parallel) ? nthreads : 1;
+            int nalloc = (obs_parallel) ? 1 : nthreads;
+            if (int(m_dense.size())    != nsets  ||
+                int(m_dense[0].size()) != nalloc ||
+                m_dense[0][0].rows()   != npars) {
+                m_dense.assign(nsets,
+                               std::vector<GMatrixSymmetric>(nalloc,
+                                          GMatrixSymmetric(npars,npars)));
+            }
+            else {
+                for (int i = 0; i < nsets; ++i) {
+                    for (int k = 0; k < nalloc; ++k) {
+                        m_dense[i][k] = 0.0;
+                    }
+                }
+            }
+        }
 
         // Here OpenMP will paralellize the execution. The following code will
         // be executed by the differents threads. In order to avoid protecting
         // attributes ( m_value,m_npred, m_gradient and m_curvature), each thread
         // works with its own working variables (cpy_*). When a thread starts,
-        // we add working variables in a vector (vect_cpy_*). When computation
-        // is finished we just add all elements contain in the vector to the
-        // attributes value.
-        #pragma omp parallel
+        // it stores its working variables in the vectors (vect_cpy_*) at the
+        // index of its thread number. When computation is finished we just
+        // add all elements contained in the vectors to the attributes value.
+        // If the observations are not distributed over the threads the
+        // loop is executed by a single thread, so that
+        // GObservation::likelihood() can distribute the events of each
+        // observation over the threads.
+        #pragma omp parallel num_threads(nthreads) if (obs_parallel)
         {
-            // Allocate and initialize variable copies for multi-threading
-            GModels        cpy_model(m_this->models());
-            GVector*       cpy_gradient  = new GVector(npars);
-            GMatrixSparse* cpy_curvature = new GMatrixSparse(npars,npars);
-            double*        cpy_npred     = new double(0.0);
-            double*        cpy_value     = new double(0.0);
-
-            // Set stack size and number of entries
-            cpy_curvature->stack_init(stack_size, max_entries);
-
-            // Push variable copies into vector. This is a critical zone to
-            // avoid multiple thread pushing simultaneously.
-            #pragma omp critical
-            {
-                vect_cpy_grad.push_back(cpy_gradient);
-                vect_cpy_curvature.push_back(cpy_curvature); 
-                vect_cpy_value.push_back(cpy_value);
-                vect_cpy_npred.push_back(cpy_npred);
+            // Get thread index
+            int thread = 0;
+            #ifdef _OPENMP
+            thread = omp_get_thread_num();
+            #endif
+
+            // Allocate and initialize variable copies for multi-threading.
+            // In dense mode the thread uses its set of dense accumulators
+            // and no sparse curvature matrix is needed. Otherwise the
+            // thread accumulates the curvature values on the sparsity
+            // pattern of the previous evaluation
+            GModels                        cpy_model(m_this->models());
+            GVector*                       cpy_gradient  = new GVector(npars);
+            GMatrixSparse*                 cpy_curvature = NULL;
+            std::vector<GMatrixSymmetric>* cpy_dense     = NULL;
+            double*                        cpy_npred     = new double(0.0);
+            double*                        cpy_value     = new double(0.0);
+            if (use_dense) {
+                cpy_dense = &(m_dense[thread]);
+            }
+            else {
+                cpy_curvature = new GMatrixSparse(npars,npars);
+                cpy_curvature->pattern_init(*m_curvature);
+                cpy_curvature->stack_init(stack_size, max_entries);
             }
 
+            // Store variable copies at the index of the thread
+            vect_cpy_grad[thread]      = cpy_gradient;
+            vect_cpy_curvature[thread] = cpy_curvature;
+            vect_cpy_value[thread]     = cpy_value;
+            vect_cpy_npred[thread]     = cpy_npred;
+
             // Loop over all observations. The omp for directive will deal
-            // with the iterations on the differents threads.
-            #pragma omp for
+            // with the iterations on the differents threads. A static
+            // schedule assigns the observations always to the same threads.
+            #pragma omp for schedule(static)
             for (int i = 0; i < m_this->size(); ++i) {
 
                 // Compute likelihood
                 *cpy_value += m_this->m_obs[i]->likelihood(cpy_model,
                                                            cpy_gradient,
                                                            cpy_curvature,
-                                                           cpy_npred);
+                                                           cpy_npred,
+                                                           cpy_dense);
 
             } // endfor: looped over observations
 
             // Release stack
-            cpy_curvature->stack_destroy();
+            if (cpy_curvature != NULL) {
+                cpy_curvature->stack_destroy();
+            }
 
         } // end pragma omp parallel
 
-        // Now the computation is finished, update attributes.
-        // For each omp section, a thread will be created.
-        #pragma omp sections
-        {
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_curvature.size() ; ++i) {
-                    *m_curvature += *(vect_cpy_curvature.at(i));
-                    delete vect_cpy_curvature.at(i);
+        // Now the computation is finished, update attributes in the order
+        // of the thread numbers. Threads that were not started have no
+        // working variables. In dense mode the accumulators of all threads
+        // are summed and written into the curvature matrix, otherwise the
+        // curvature matrices of all threads are merged. The values on the
+        // sparsity pattern are summed in place, and the elements that are
+        // not part of the pattern are assembled in a single pass over the
+        // columns of the curvature matrix.
+        if (use_dense) {
+            GMatrixSymmetric& sum = m_dense[0][0];
+            for (int i = 0; i < int(m_dense.size()); ++i) {
+                for (int k = 0; k < int(m_dense[i].size()); ++k) {
+                    if (i > 0 || k > 0) {
+                        sum += m_dense[i][k];
+                    }
                 }
             }
-
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_grad.size(); ++i){
-                    *m_gradient += *(vect_cpy_grad.at(i));
-                    delete vect_cpy_grad.at(i);
+            set_curvature(sum);
+        }
+        else {
+            std::vector<const GMatrixSparse*> curvatures;
+            for (int i = 0; i < nthreads; ++i) {
+                if (vect_cpy_curvature[i] != NULL) {
+                    curvatures.push_back(vect_cpy_curvature[i]);
                 }
             }
-
-            #pragma omp section
-            {
-                for(int i = 0; i < vect_cpy_npred.size(); ++i){
-                    m_npred += *(vect_cpy_npred.at(i));
-                    delete vect_cpy_npred.at(i);
-                }
+            m_curvature->add_matrices(curvatures);
+            for (int i = 0; i < nthreads; ++i) {
+                delete vect_cpy_curvature[i];
             }
-
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_value.size(); ++i){
-                    m_value += *(vect_cpy_value.at(i));
-                    delete vect_cpy_value.at(i);
-                }
+            m_curvature->pattern_destroy();
+            if (pattern != NULL) {
+                delete pattern;
             }
-        } // end of pragma omp sections
-
-        // Release stack
-        m_curvature->stack_destroy();
+        }
+        for (int i = 0; i < nthreads; ++i){
+            if (vect_cpy_grad.at(i) != NULL) {
+                *m_gradient += *(vect_cpy_grad.at(i));
+                delete vect_cpy_grad.at(i);
+            }
+        }
+        for(int i = 0; i < nthreads; ++i){
+            if (vect_cpy_npred.at(i) != NULL) {
+                m_npred += *(vect_cpy_npred.at(i));
+                delete vect_cpy_npred.at(i);
+            }
+        }
+        for (int i = 0; i < nthreads; ++i){
+            if (vect_cpy_value.at(i) != NULL) {
+                m_value += *(vect_cpy_value.at(i));
+                delete vect_cpy_value.at(i);
+            }
+        }
 
     } while(0); // endwhile: main loop
 
@@ -369,6 +494,7 @@ void GObservations::likelihood::init_members(void)
     m_this      = NULL;
     m_gradient  = NULL;
     m_curvature = NULL;
+    m_dense.clear();
 
     // Return
     return;
@@ -393,6 +519,9 @@ void GObservations::likelihood::copy_members(const likelihood& fct)
     // Clone curvature matrix if it exists
     if (fct.m_curvature != NULL) m_curvature = new GMatrixSparse(*fct.m_curvature);
 
+    // Copy dense curvature accumulators
+    m_dense = fct.m_dense;
+
     // Return
     return;
 }
@@ -414,3 +543,34 @@ void GObservations::likelihood::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Set curvature matrix from dense matrix
+ *
+ * @param[in] matrix Dense curvature matrix.
+ *
+ * Writes the non-zero elements of the dense curvature @p matrix column by
+ * column into the curvature matrix. If the sparsity pattern of a column
+ * did not change since the last evaluation, the values are overwritten in
+ * place without any memory allocation.
+ ***************************************************************************/
+void GObservations::likelihood::set_curvature(const GMatrixSymmetric& matrix)
+{
+    // Get number of parameters
+    int npars = matrix.rows();
+
+    // Allocate column vector
+    GVector column(npars);
+
+    // Write all columns
+    for (int col = 0; col < npars; ++col) {
+        for (int row = 0; row < npars; ++row) {
+            column[row] = matrix(row, col);
+        }
+        m_curvature->column(col, column);
+    }
+
+    // Return
+    return;
+}
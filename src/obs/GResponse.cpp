@@ -193,6 +193,53 @@ double GResponse::irf(const GEvent&       event,
 }
 
 
+/***********************************************************************//**
+ * @brief Signals whether the response computes spatial model gradients
+ *
+ * @return True if irf_gradients() computes the spatial model gradients.
+ *
+ * Returns true if irf_gradients() computes the gradients with respect to
+ * the parameters of the spatial model that are flagged by the model as
+ * having a gradient (see GModelPar::has_grad()). If false is returned, the
+ * gradients of these parameters are computed numerically by
+ * GObservation::model_grad().
+ *
+ * The base class method returns false for any spatial model. Derived
+ * classes that overload irf_gradients() also need to overload this method.
+ ***************************************************************************/
+bool GResponse::has_irf_gradients(const GModelSpatial&) const
+{
+    // Return
+    return false;
+}
+
+
+/***********************************************************************//**
+ * @brief Return instrument response function and spatial model gradients
+ *
+ * @param[in] event Observed event.
+ * @param[in] source Source.
+ * @param[in] obs Observation.
+ * @return Value of instrument response function.
+ *
+ * Returns the same value as irf(), and in addition computes the gradients
+ * of the instrument response function with respect to the parameters of
+ * the spatial model that are flagged by the model as having a gradient
+ * (see GModelPar::has_grad()). The gradients are stored in the parameters.
+ *
+ * The method is only called for spatial models for which
+ * has_irf_gradients() returns true. The base class method computes no
+ * gradients and simply returns irf().
+ ***************************************************************************/
+double GResponse::irf_gradients(const GEvent&       event,
+                                const GSource&      source,
+                                const GObservation& obs) const
+{
+    // Return IRF value
+    return (this->irf(event, source, obs));
+}
+
+
 /***********************************************************************//**
  * @brief Return value of point source instrument response function
  *
@@ -78,10 +78,45 @@ GSource::GSource(const std::string& name,
     init_members();
 
     // Set members
-    m_name   = name;
-    m_model  = model;
-    m_energy = energy;
-    m_time   = time;
+    m_name    = name;
+    m_name_id = gammalib::intern(name);
+    m_model   = model;
+    m_energy  = energy;
+    m_time    = time;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Source constructor with interned source name
+ *
+ * @param[in] name Source name.
+ * @param[in] name_id Interned source name identifier.
+ * @param[in] model Spatial model pointer.
+ * @param[in] energy Energy.
+ * @param[in] time Time.
+ *
+ * Constructs a source using an identifier that was obtained by interning
+ * the source name (see gammalib::intern()), for example using
+ * GModel::name_id(). This avoids interning the source name again.
+ ***************************************************************************/
+GSource::GSource(const std::string& name,
+                 const int&         name_id,
+                 GModelSpatial*     model,
+                 const GEnergy&     energy,
+                 const GTime&       time)
+{ 
+    // Initialise private members
+    init_members();
+
+    // Set members
+    m_name    = name;
+    m_name_id = name_id;
+    m_model   = model;
+    m_energy  = energy;
+    m_time    = time;
 
     // Return
     return;
@@ -228,7 +263,8 @@ void GSource::init_members(void)
 {
     // Initialise members
     m_name.clear();
-    m_model = NULL;
+    m_name_id = -1;
+    m_model   = NULL;
     m_energy.clear();
     m_time.clear();
   
@@ -245,8 +281,9 @@ void GSource::init_members(void)
 void GSource::copy_members(const GSource& src)
 {
     // Copy members
-    m_model  = src.m_model;
-    m_name   = src.m_name;
+    m_model   = src.m_model;
+    m_name    = src.m_name;
+    m_name_id = src.m_name_id;
     m_energy = src.m_energy;
     m_time   = src.m_time;
     
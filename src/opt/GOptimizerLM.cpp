@@ -466,21 +466,19 @@ void GOptimizerLM::errors(GOptimizerFunction& fct, GOptimizerPars& pars)
     // Loop over error computation (maximum 2 turns)
     for (int i = 0; i < 2; ++i) {
 
-        // Solve: curvature * X = unit
+        // Compute the diagonal of the inverse curvature matrix. Only the
+        // diagonal is needed, hence the full inverse is not computed
         try {
-            GMatrixSparse decomposition = curvature->cholesky_decompose(true);
-            GVector unit(npars);
+            m_decomposition.cholesky_refactor(*curvature, true);
+            GVector diag = m_decomposition.cholesky_inverse_diagonal(true);
             for (int ipar = 0; ipar < npars; ++ipar) {
-                unit[ipar] = 1.0;
-                GVector x  = decomposition.cholesky_solver(unit, true);
-                if (x[ipar] >= 0.0) {
-                    pars[ipar]->factor_error(sqrt(x[ipar]));
+                if (diag[ipar] >= 0.0) {
+                    pars[ipar]->factor_error(sqrt(diag[ipar]));
                 }
                 else {
                     pars[ipar]->factor_error(0.0);
                     m_status = G_LM_BAD_ERRORS;
                 }
-                unit[ipar] = 0.0;
             }
         }
         catch (GException::matrix_zero &e) {
@@ -650,6 +648,9 @@ void GOptimizerLM::init_members(void)
     m_iter    = 0;
     m_num_dec = 0;
 
+    // Initialise curvature decomposition
+    m_decomposition.clear();
+
     // Initialise pointer to logger
     m_logger = NULL;
 
@@ -687,6 +688,9 @@ void GOptimizerLM::copy_members(const GOptimizerLM& opt)
     m_iter         = opt.m_iter;
     m_logger       = opt.m_logger;
 
+    // Copy curvature decomposition
+    m_decomposition = opt.m_decomposition;
+
     // Return
     return;
 }
@@ -761,9 +765,13 @@ void GOptimizerLM::iteration(GOptimizerFunction& fct, GOptimizerPars& pars)
         std::cout << std::endl;
         #endif
 
-        // Solve: curvature * X = grad. Handle matrix problems
+        // Solve: curvature * X = grad. The decomposition is kept between
+        // iterations so that the symbolic analysis of the curvature matrix
+        // is only redone if its sparsity pattern changes. Handle matrix
+        // problems
         try {
-            *grad = curvature->solve(*grad);
+            m_decomposition.cholesky_refactor(*curvature, true);
+            *grad = m_decomposition.cholesky_solver(*grad, true);
         }
         catch (GException::matrix_zero &e) {
             m_status = G_LM_SINGULAR;
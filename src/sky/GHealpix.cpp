@@ -29,10 +29,12 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <algorithm>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GMath.hpp"
 #include "GHealpix.hpp"
+#include "GFft.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_CONSTRUCT    "GHealpix::GHealpix(int& ,std::string& ,std::string&)"
@@ -45,6 +47,11 @@
 #define G_PIX2ANG_NEST        "GHealpix::pix2ang_nest(int, double*, double*)"
 #define G_ORDERING_SET                     "GHealpix::ordering(std::string&)"
 #define G_INTERPOLATOR             "GHealpix::interpolator(double&, double&)"
+#define G_QUERY_STRIP          "GHealpix::query_strip(double&, double&, bool&)"
+#define G_QUERY_POLYGON  "GHealpix::query_polygon(std::vector<GSkyDir>&, bool&)"
+#define G_MAP2ALM                          "GHealpix::map2alm(double*, int&)"
+#define G_ALM2MAP "GHealpix::alm2map(std::vector<std::complex<double> >&, int&,"\
+                                                                 " double*)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -53,12 +60,13 @@
 /* __ Debug definitions __________________________________________________ */
 
 /* __ Local prototypes ___________________________________________________ */
+static void intersect_ranges(std::vector<long long>*       ranges,
+                             const std::vector<long long>& other);
 
 /* __ Constants __________________________________________________________ */
 const int jrll[12]  = {2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4};
 const int jpll[12]  = {1, 3, 5, 7, 0, 2, 4, 6, 1, 3, 5, 7};
-const int order_max = 13;
-const int ns_max    = 1 << order_max;
+const int order_max = 27;
 
 /* __ Static conversion arrays ___________________________________________ */
 static short ctab[0x100];
@@ -107,7 +115,7 @@ GHealpix::GHealpix(const int&         nside,
     // Initialise class members
     init_members();
 
-    // Check nside parameter (power of 2 between 1 and 8192)
+    // Check nside parameter (power of 2 between 1 and 2^27)
     if (nside2order(nside) == -1) {
         throw GException::wcs_hpx_bad_nside(G_CONSTRUCT, nside);
     }
@@ -120,7 +128,7 @@ GHealpix::GHealpix(const int&         nside,
 
     // Set Healpix parameters
     m_nside      = nside;
-    m_npface     = m_nside * m_nside;
+    m_npface     = (long long)m_nside * (long long)m_nside;
     m_ncap       = 2 * (m_npface - m_nside);
     m_num_pixels = 12 * m_npface;
     m_fact2      = 4.0 / m_num_pixels;
@@ -304,7 +312,7 @@ void GHealpix::read(const GFitsHDU& hdu)
 
     // Get Healpix resolution and determine number of pixels and solid angle
     m_nside      = hdu.integer("NSIDE");
-    m_npface     = m_nside * m_nside;
+    m_npface     = (long long)m_nside * (long long)m_nside;
     m_ncap       = 2 * (m_npface - m_nside);
     m_num_pixels = 12 * m_npface;
     m_fact2      = 4.0 / m_num_pixels;
@@ -340,7 +348,8 @@ void GHealpix::write(GFitsHDU& hdu) const
     hdu.card("PIXTYPE",  "HEALPIX",  "HEALPix pixelisation");
     hdu.card("NSIDE",    nside(),    "HEALPix resolution parameter");
     hdu.card("FIRSTPIX", 0,          "Index of first pixel");
-    hdu.card("LASTPIX",  npix()-1,   "Index of last pixel");
+    hdu.card("LASTPIX",  0,          "Index of last pixel");
+    hdu.card("LASTPIX").value(npix()-1); // Pixel index may exceed 32 bit
     hdu.card("ORDERING", ordering(),
              "Pixel ordering scheme, either RING or NESTED");
     hdu.card("COORDSYS", coordsys(),
@@ -372,10 +381,10 @@ GSkyDir GHealpix::pix2dir(const GSkyPixel& pixel) const
     double phi   = 0.0;
     switch (m_ordering) {
     case 0:
-        pix2ang_ring(int(pixel), &theta, &phi);
+        pix2ang_ring((long long)pixel, &theta, &phi);
         break;
     case 1:
-        pix2ang_nest(int(pixel), &theta, &phi);
+        pix2ang_nest((long long)pixel, &theta, &phi);
         break;
     default:
         break;
@@ -424,7 +433,7 @@ GSkyPixel GHealpix::dir2pix(const GSkyDir& dir) const
     }
 
     // Perform ordering dependent conversion
-    int index;
+    long long index = 0;
     switch (m_ordering) {
     case 0:
         index = ang2pix_z_phi_ring(z, phi);
@@ -441,6 +450,100 @@ GSkyPixel GHealpix::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of an array of pixel indices
+ *
+ * @param[in] x Array [n] of pixel indices.
+ * @param[out] lon Array [n] of longitudes in the projection's coordinate
+ *                 system (deg).
+ * @param[out] lat Array [n] of latitudes in the projection's coordinate
+ *                 system (deg).
+ * @param[in] n Number of pixels.
+ *
+ * Converts @p n HealPix pixel indices into sky coordinates without
+ * allocating intermediate GSkyPixel and GSkyDir objects. Since HealPix
+ * pixels are one-dimensional, the array of pixel y coordinates of the
+ * GSkyProjection interface is not used and may be NULL.
+ ***************************************************************************/
+void GHealpix::pix2dir(const double* x, const double*,
+                       double* lon, double* lat, const int& n) const
+{
+    // Loop over all pixels
+    for (int i = 0; i < n; ++i) {
+
+        // Perform ordering dependent conversion
+        double theta = 0.0;
+        double phi   = 0.0;
+        switch (m_ordering) {
+        case 0:
+            pix2ang_ring((long long)x[i], &theta, &phi);
+            break;
+        case 1:
+            pix2ang_nest((long long)x[i], &theta, &phi);
+            break;
+        default:
+            break;
+        }
+
+        // Store sky coordinates
+        lon[i] = phi * gammalib::rad2deg;
+        lat[i] = (gammalib::pihalf - theta) * gammalib::rad2deg;
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices of an array of sky coordinates
+ *
+ * @param[in] lon Array [n] of longitudes in the projection's coordinate
+ *                system (deg).
+ * @param[in] lat Array [n] of latitudes in the projection's coordinate
+ *                system (deg).
+ * @param[out] x Array [n] of pixel indices.
+ * @param[out] y Array [n] of pixel y coordinates (set to zero).
+ * @param[in] n Number of sky coordinates.
+ *
+ * Converts @p n sky coordinates into HealPix pixel indices without
+ * allocating intermediate GSkyPixel and GSkyDir objects.
+ ***************************************************************************/
+void GHealpix::dir2pix(const double* lon, const double* lat,
+                       double* x, double* y, const int& n) const
+{
+    // Loop over all sky coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Compute (z,phi)
+        double z   = std::sin(lat[i] * gammalib::deg2rad);
+        double phi = lon[i] * gammalib::deg2rad;
+
+        // Perform ordering dependent conversion
+        long long index = 0;
+        switch (m_ordering) {
+        case 0:
+            index = ang2pix_z_phi_ring(z, phi);
+            break;
+        case 1:
+            index = ang2pix_z_phi_nest(z, phi);
+            break;
+        default:
+            break;
+        }
+
+        // Store pixel index
+        x[i] = double(index);
+        y[i] = 0.0;
+
+    } // endfor: looped over sky coordinates
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return interpolator for given sky direction
  *
@@ -533,6 +636,447 @@ void GHealpix::ordering(const std::string& ordering)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns pixels within a disc
+ *
+ * @param[in] dir Disc centre.
+ * @param[in] radius Disc radius (deg).
+ * @param[in] inclusive Return all pixels that overlap with the disc?
+ * @return Array of pixel indices.
+ *
+ * Returns the indices of all pixels whose centres lie within the disc of
+ * @p radius around @p dir. If @p inclusive is true, all pixels that
+ * overlap with the disc are returned; in that case a few pixels that are
+ * close to, but outside, the disc may be returned as well.
+ *
+ * The pixel indices are returned in increasing order for the ordering
+ * scheme of the projection.
+ *
+ * This method has been adapted from the query_disc() function located in
+ * the file healpix_base.cc in Healpix version 3.20.
+ ***************************************************************************/
+std::vector<long long> GHealpix::query_disc(const GSkyDir& dir,
+                                            const double&  radius,
+                                            const bool&    inclusive) const
+{
+    // Get disc centre in projection coordinates
+    double theta;
+    double phi;
+    dir2ang(dir, &theta, &phi);
+
+    // Set disc
+    std::vector<double> z0(1, std::cos(theta));
+    std::vector<double> phi0(1, phi);
+    std::vector<double> rad(1, radius * gammalib::deg2rad);
+    if (inclusive) {
+        rad[0] += max_pixrad();
+    }
+
+    // Get pixel ranges in ring scheme and convert them into pixels
+    std::vector<long long> pixels = ranges2pixels(query_discs(z0, phi0, rad));
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixels within a latitude strip
+ *
+ * @param[in] bmin Minimum latitude of strip (deg).
+ * @param[in] bmax Maximum latitude of strip (deg).
+ * @param[in] inclusive Return all pixels that overlap with the strip?
+ * @return Array of pixel indices.
+ *
+ * @exception GException::invalid_argument
+ *            Minimum latitude larger than maximum latitude.
+ *
+ * Returns the indices of all pixels whose centres lie within the latitude
+ * strip [@p bmin, @p bmax] of the coordinate system of the projection. If
+ * @p inclusive is true, all pixels that overlap with the strip are
+ * returned; in that case a few pixels that are close to, but outside, the
+ * strip may be returned as well.
+ *
+ * The pixel indices are returned in increasing order for the ordering
+ * scheme of the projection.
+ *
+ * This method has been adapted from the query_strip_internal() function
+ * located in the file healpix_base.cc in Healpix version 3.20.
+ ***************************************************************************/
+std::vector<long long> GHealpix::query_strip(const double& bmin,
+                                             const double& bmax,
+                                             const bool&   inclusive) const
+{
+    // Throw an exception if the strip is invalid
+    if (bmin > bmax) {
+        std::string msg = "Minimum latitude "+gammalib::str(bmin)+" deg is"
+                          " larger than maximum latitude "+
+                          gammalib::str(bmax)+" deg.\n"
+                          "Please specify a minimum latitude that is not"
+                          " larger than the maximum latitude.";
+        throw GException::invalid_argument(G_QUERY_STRIP, msg);
+    }
+
+    // Compute cosines of colatitudes of strip boundaries
+    double z1 = std::sin(bmax * gammalib::deg2rad);
+    double z2 = std::sin(bmin * gammalib::deg2rad);
+
+    // Determine range of rings
+    int ring1 = 0;
+    int ring2 = 0;
+    if (inclusive) {
+        ring1 = ring_above(z1);
+        ring2 = ring_above(z2) + 1;
+    }
+    else {
+        ring1 = ring_above(z1) + 1;
+        ring2 = ring_above(z2);
+    }
+    if (ring1 < 1) {
+        ring1 = 1;
+    }
+    if (ring2 > 4*m_nside-1) {
+        ring2 = 4*m_nside-1;
+    }
+
+    // Set pixel range in ring scheme
+    std::vector<long long> ranges;
+    if (ring1 <= ring2) {
+        long long startpix1;
+        int       ringpix1;
+        long long startpix2;
+        int       ringpix2;
+        bool      shifted;
+        get_ring_info(ring1, &startpix1, &ringpix1, &shifted);
+        get_ring_info(ring2, &startpix2, &ringpix2, &shifted);
+        ranges.push_back(startpix1);
+        ranges.push_back(startpix2 + ringpix2);
+    }
+
+    // Convert pixel ranges into pixels
+    std::vector<long long> pixels = ranges2pixels(ranges);
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixels within a convex polygon
+ *
+ * @param[in] vertices Polygon vertices.
+ * @param[in] inclusive Return all pixels that overlap with the polygon?
+ * @return Array of pixel indices.
+ *
+ * @exception GException::invalid_argument
+ *            Less than three vertices, degenerate or non-convex polygon.
+ *
+ * Returns the indices of all pixels whose centres lie within the convex
+ * polygon defined by @p vertices. The vertices are connected by great
+ * circle arcs and can be given in clockwise or counter-clockwise order. If
+ * @p inclusive is true, all pixels that overlap with the polygon are
+ * returned; in that case a few pixels that are close to, but outside, the
+ * polygon may be returned as well.
+ *
+ * The pixel indices are returned in increasing order for the ordering
+ * scheme of the projection.
+ *
+ * This method has been adapted from the query_polygon_internal() function
+ * located in the file healpix_base.cc in Healpix version 3.20. Each edge
+ * of the polygon defines a hemisphere, and the polygon is the
+ * intersection of all these hemispheres.
+ ***************************************************************************/
+std::vector<long long> GHealpix::query_polygon(const std::vector<GSkyDir>& vertices,
+                                               const bool& inclusive) const
+{
+    // Get number of vertices
+    int nv = vertices.size();
+
+    // Throw an exception if there are less than three vertices
+    if (nv < 3) {
+        std::string msg = "Polygon has "+gammalib::str(nv)+" vertices.\n"
+                          "Please specify at least three vertices.";
+        throw GException::invalid_argument(G_QUERY_POLYGON, msg);
+    }
+
+    // Compute Cartesian vertex vectors in projection coordinates
+    std::vector<double> x(nv);
+    std::vector<double> y(nv);
+    std::vector<double> z(nv);
+    for (int i = 0; i < nv; ++i) {
+        double theta;
+        double phi;
+        dir2ang(vertices[i], &theta, &phi);
+        x[i] = std::sin(theta) * std::cos(phi);
+        y[i] = std::sin(theta) * std::sin(phi);
+        z[i] = std::cos(theta);
+    }
+
+    // Compute the hemispheres defined by the edges of the polygon. The
+    // hemisphere centres are the edge normals oriented towards the inside
+    // of the polygon.
+    std::vector<double> z0(nv);
+    std::vector<double> phi0(nv);
+    std::vector<double> rad(nv, gammalib::pihalf);
+    double              flip = 1.0;
+    for (int i = 0; i < nv; ++i) {
+
+        // Compute normalised edge normal
+        int    k    = (i+1) % nv;
+        double nx   = y[i]*z[k] - z[i]*y[k];
+        double ny   = z[i]*x[k] - x[i]*z[k];
+        double nz   = x[i]*y[k] - y[i]*x[k];
+        double norm = std::sqrt(nx*nx + ny*ny + nz*nz);
+        if (norm > 0.0) {
+            nx /= norm;
+            ny /= norm;
+            nz /= norm;
+        }
+
+        // Check on which side of the edge the next vertex lies
+        int    l   = (i+2) % nv;
+        double hnd = nx*x[l] + ny*y[l] + nz*z[l];
+        if (std::abs(hnd) <= 1.0e-10) {
+            std::string msg = "Polygon has a degenerate corner at vertex "+
+                              gammalib::str((i+1) % nv)+".\n"
+                              "Please specify distinct vertices that are not"
+                              " located on a great circle.";
+            throw GException::invalid_argument(G_QUERY_POLYGON, msg);
+        }
+        if (i == 0) {
+            flip = (hnd < 0.0) ? -1.0 : 1.0;
+        }
+        else if (flip*hnd < 0.0) {
+            std::string msg = "Polygon is not convex at vertex "+
+                              gammalib::str((i+1) % nv)+".\n"
+                              "Please specify a convex polygon.";
+            throw GException::invalid_argument(G_QUERY_POLYGON, msg);
+        }
+
+        // Set hemisphere
+        z0[i]   = flip * nz;
+        phi0[i] = std::atan2(flip * ny, flip * nx);
+        if (inclusive) {
+            rad[i] += max_pixrad();
+        }
+
+    } // endfor: looped over edges
+
+    // Get pixel ranges in ring scheme and convert them into pixels
+    std::vector<long long> pixels = ranges2pixels(query_discs(z0, phi0, rad));
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute spherical harmonic coefficients of a map
+ *
+ * @param[in] pixels Pixel values [0,...,npix()-1].
+ * @param[in] lmax Maximum multipole.
+ * @return Spherical harmonic coefficients.
+ *
+ * @exception GException::invalid_argument
+ *            Negative maximum multipole specified.
+ *
+ * Computes the spherical harmonic coefficients
+ *
+ * \f[
+ *    a_{lm} = \Omega \sum_p f_p Y^*_{lm}(\theta_p, \phi_p)
+ * \f]
+ *
+ * of the map with pixel values \f$f_p\f$ for \f$0 \le m \le l \le l_{\rm
+ * max}\f$, where \f$\Omega\f$ is the solid angle of a pixel. The
+ * coefficients for negative \f$m\f$ follow for a real valued map from
+ * \f$a_{l,-m} = (-1)^m a^*_{lm}\f$.
+ *
+ * The coefficients are returned ordered by increasing \f$m\f$ and, for
+ * given \f$m\f$, by increasing \f$l\f$, hence the coefficient \f$a_{lm}\f$
+ * has the index \f$m(2l_{\rm max}+3-m)/2 + l - m\f$.
+ *
+ * The computation exploits the iso-latitude rings of the HEALPix scheme.
+ * The pixels of each ring are first Fourier transformed in longitude,
+ * and the associated Legendre functions are then summed over pairs of
+ * rings that are symmetric with respect to the equator. The computing
+ * time is proportional to \f$N_{\rm side} l_{\rm max}^2\f$. The
+ * transformation is not iterated, hence the coefficients of a map that is
+ * band limited to \f$l_{\rm max} \le 2N_{\rm side}\f$ are only recovered
+ * approximately, with a relative error that decreases from a few percent
+ * for \f$N_{\rm side}=4\f$ to a few \f$10^{-4}\f$ for
+ * \f$N_{\rm side}=256\f$.
+ ***************************************************************************/
+std::vector<std::complex<double> > GHealpix::map2alm(const double* pixels,
+                                                     const int&    lmax) const
+{
+    // Throw an exception if the maximum multipole is negative
+    if (lmax < 0) {
+        std::string msg = "Negative maximum multipole "+gammalib::str(lmax)+
+                          " specified.\n"
+                          "Please specify a non-negative maximum multipole.";
+        throw GException::invalid_argument(G_MAP2ALM, msg);
+    }
+
+    // Get number of rings and number of orders
+    int nrings = 4 * m_nside - 1;
+    int nm     = lmax + 1;
+
+    // Setup ring geometry and Fourier transformations
+    std::vector<double> z;
+    std::vector<double> logsin;
+    std::vector<GFft>   ffts;
+    ring_geometry(&z, &logsin, &ffts);
+
+    // Compute the Fourier coefficients of all rings, weighted by the pixel
+    // solid angle
+    std::vector<std::complex<double> > values((long long)nrings * nm);
+    #pragma omp parallel for schedule(dynamic)
+    for (int ring = 1; ring <= nrings; ++ring) {
+
+        // Get ring information
+        long long startpix;
+        int       ringpix;
+        double    theta;
+        bool      shifted;
+        get_ring_info(ring, &startpix, &ringpix, &theta, &shifted);
+
+        // Fourier transform ring pixels
+        std::vector<std::complex<double> > data(ringpix);
+        for (int i = 0; i < ringpix; ++i) {
+            long long index = startpix + i;
+            if (m_ordering == 1) {
+                index = ring2nest(index);
+            }
+            data[i] = pixels[index];
+        }
+        ffts[ringpix/4].forward(&data[0]);
+
+        // Store Fourier coefficients, taking into account the longitude of
+        // the first ring pixel
+        double                phi0  = (shifted) ? gammalib::pi / ringpix : 0.0;
+        std::complex<double>* value = &values[(long long)(ring-1) * nm];
+        for (int m = 0; m <= lmax; ++m) {
+            value[m] = m_solidangle * data[m % ringpix] *
+                       std::polar(1.0, -m * phi0);
+        }
+
+    } // endfor: looped over rings
+
+    // Allocate spherical harmonic coefficients
+    std::vector<std::complex<double> > alm((long long)nm * (nm+1) / 2);
+
+    // Perform Legendre transformation for all orders
+    #pragma omp parallel for schedule(dynamic)
+    for (int m = 0; m <= lmax; ++m) {
+        long long offset = (long long)m * (2*lmax+3-m) / 2;
+        legendre_transform(m, lmax, z, logsin, &values[0], &alm[offset], true);
+    }
+
+    // Return spherical harmonic coefficients
+    return alm;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute map from spherical harmonic coefficients
+ *
+ * @param[in] alm Spherical harmonic coefficients.
+ * @param[in] lmax Maximum multipole.
+ * @param[out] pixels Pixel values [0,...,npix()-1].
+ *
+ * @exception GException::invalid_argument
+ *            Negative maximum multipole specified or number of coefficients
+ *            inconsistent with maximum multipole.
+ *
+ * Computes the pixel values
+ *
+ * \f[
+ *    f_p = \sum_{l=0}^{l_{\rm max}} \sum_{m=-l}^{l}
+ *          a_{lm} Y_{lm}(\theta_p, \phi_p)
+ * \f]
+ *
+ * of a real valued map from the spherical harmonic coefficients @p alm,
+ * which are ordered as the coefficients returned by map2alm().
+ ***************************************************************************/
+void GHealpix::alm2map(const std::vector<std::complex<double> >& alm,
+                       const int&                                lmax,
+                       double*                                   pixels) const
+{
+    // Get number of orders
+    int nm = lmax + 1;
+
+    // Throw an exception if the maximum multipole is negative or if the
+    // number of coefficients is inconsistent
+    if (lmax < 0 || (long long)alm.size() != (long long)nm * (nm+1) / 2) {
+        std::string msg = "Number of coefficients "+gammalib::str(alm.size())+
+                          " is inconsistent with maximum multipole "+
+                          gammalib::str(lmax)+".\n"
+                          "Please specify (lmax+1)(lmax+2)/2 coefficients.";
+        throw GException::invalid_argument(G_ALM2MAP, msg);
+    }
+
+    // Get number of rings
+    int nrings = 4 * m_nside - 1;
+
+    // Setup ring geometry and Fourier transformations
+    std::vector<double> z;
+    std::vector<double> logsin;
+    std::vector<GFft>   ffts;
+    ring_geometry(&z, &logsin, &ffts);
+
+    // Perform Legendre transformation for all orders, which gives the
+    // Fourier coefficients of all rings
+    std::vector<std::complex<double> > values((long long)nrings * nm);
+    std::vector<std::complex<double> > coeffs(alm);
+    #pragma omp parallel for schedule(dynamic)
+    for (int m = 0; m <= lmax; ++m) {
+        long long offset = (long long)m * (2*lmax+3-m) / 2;
+        legendre_transform(m, lmax, z, logsin, &values[0], &coeffs[offset], false);
+    }
+
+    // Compute pixel values of all rings
+    #pragma omp parallel for schedule(dynamic)
+    for (int ring = 1; ring <= nrings; ++ring) {
+
+        // Get ring information
+        long long startpix;
+        int       ringpix;
+        double    theta;
+        bool      shifted;
+        get_ring_info(ring, &startpix, &ringpix, &theta, &shifted);
+
+        // Fold positive and negative orders into the Fourier coefficients
+        // of the ring, taking into account the longitude of the first ring
+        // pixel
+        double                             phi0  = (shifted) ? gammalib::pi / ringpix : 0.0;
+        const std::complex<double>*        value = &values[(long long)(ring-1) * nm];
+        std::vector<std::complex<double> > data(ringpix);
+        for (int m = 0; m <= lmax; ++m) {
+            std::complex<double> v = value[m] * std::polar(1.0, m * phi0);
+            int                  k = m % ringpix;
+            data[k] += v;
+            if (m > 0) {
+                data[(ringpix-k) % ringpix] += std::conj(v);
+            }
+        }
+
+        // Transform into ring pixels
+        ffts[ringpix/4].backward(&data[0]);
+        for (int i = 0; i < ringpix; ++i) {
+            long long index = startpix + i;
+            if (m_ordering == 1) {
+                index = ring2nest(index);
+            }
+            pixels[index] = data[i].real();
+        }
+
+    } // endfor: looped over rings
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print WCS information
  *
@@ -686,14 +1230,20 @@ bool GHealpix::compare(const GSkyProjection& proj) const
  * @param[in] value Value.
  * @return Compressed Bits.
  *
+ * Extracts the even bits of a 64-bit @p value into an integer.
+ *
  * This method has been adapted from the compress_bits() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::compress_bits(const int& value) const
+int GHealpix::compress_bits(const long long& value) const
 {
     // Compress Bits
-    int raw        = (value & 0x5555) | ((value & 0x55550000) >> 15);
-    int compressed = ctab[raw & 0xff] | (ctab[raw >> 8] << 4);
+    long long raw        = value & 0x5555555555555555LL;
+    raw                 |= raw >> 15;
+    int       compressed = ctab[raw & 0xff]              |
+                          (ctab[(raw >> 8)  & 0xff] << 4)  |
+                          (ctab[(raw >> 32) & 0xff] << 16) |
+                          (ctab[(raw >> 40) & 0xff] << 20);
 
     // Return compressed value
     return compressed;
@@ -706,13 +1256,18 @@ int GHealpix::compress_bits(const int& value) const
  * @param[in] value Compressed value.
  * @return Spread Bits.
  *
+ * Spreads the bits of @p value over the even bits of a 64-bit integer.
+ *
  * This method has been adapted from the spread_bits() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::spread_bits(const int& value) const
+long long GHealpix::spread_bits(const int& value) const
 {
     // Spread bits
-    int spread = utab[value & 0xff] | (utab[(value >> 8) & 0xff] << 16);
+    long long spread = (long long)(utab[value         & 0xff])        |
+                      ((long long)(utab[(value >> 8)  & 0xff]) << 16) |
+                      ((long long)(utab[(value >> 16) & 0xff]) << 32) |
+                      ((long long)(utab[(value >> 24) & 0xff]) << 48);
 
     // Return spread value
     return spread;
@@ -730,13 +1285,14 @@ int GHealpix::spread_bits(const int& value) const
  * This method has been adapted from the nest2xyf() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-void GHealpix::nest2xyf(const int& pix, int* ix, int* iy, int* face) const
+void GHealpix::nest2xyf(const long long& pix, int* ix, int* iy,
+                        int* face) const
 {
     // Compute face number
-    *face = pix >> (2 * m_order);
+    *face = int(pix >> (2 * m_order));
 
     // Compute pixel
-    int pixel = pix & (m_npface - 1);
+    long long pixel = pix & (m_npface - 1);
 
     // Compute (x,y)
     *ix = compress_bits(pixel);
@@ -758,7 +1314,8 @@ void GHealpix::nest2xyf(const int& pix, int* ix, int* iy, int* face) const
  * This method has been adapted from the ring2xyf() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-void GHealpix::ring2xyf(const int& pix, int* ix, int* iy, int* face) const
+void GHealpix::ring2xyf(const long long& pix, int* ix, int* iy,
+                        int* face) const
 {
     // Declare some variables
     int nl2 = 2*m_nside;
@@ -769,8 +1326,8 @@ void GHealpix::ring2xyf(const int& pix, int* ix, int* iy, int* face) const
 
     // Handle pixel in the North Polar cap
     if (pix < m_ncap) {
-        iring  = (1+isqrt(1+2*pix)) >> 1;    // Counted from North pole
-        iphi   = (pix+1) - 2*iring*(iring-1);
+        iring  = int((1+isqrt(1+2*pix)) >> 1);    // Counted from North pole
+        iphi   = int((pix+1) - 2*(long long)iring*(iring-1));
         kshift = 0;
         nr     = iring;
         *face  = (iphi-1)/nr;
@@ -778,10 +1335,10 @@ void GHealpix::ring2xyf(const int& pix, int* ix, int* iy, int* face) const
 
     // Handle pixel in equatorial region
     else if (pix < (m_num_pixels-m_ncap)) {
-        int ip   = pix - m_ncap;
-        int tmp  = (m_order>=0) ? ip >> (m_order+2) : ip/(4*m_nside);
-        iring    = tmp + m_nside;
-        iphi     = ip - tmp * 4 * m_nside + 1;
+        long long ip  = pix - m_ncap;
+        long long tmp = (m_order>=0) ? ip >> (m_order+2) : ip/(4*m_nside);
+        iring         = int(tmp) + m_nside;
+        iphi          = int(ip - tmp * 4 * m_nside) + 1;
         kshift   = (iring + m_nside) & 1;
         nr       = m_nside;
         int ire  = iring - m_nside + 1;
@@ -801,9 +1358,9 @@ void GHealpix::ring2xyf(const int& pix, int* ix, int* iy, int* face) const
     
     // Handle pixel in the South Polar cap
     else {
-        int ip = m_num_pixels - pix;
-        iring  = (1+isqrt(2*ip-1))>>1; // Counted from South pole
-        iphi   = 4 * iring + 1 - (ip - 2*iring*(iring-1));
+        long long ip = m_num_pixels - pix;
+        iring        = int((1+isqrt(2*ip-1))>>1); // Counted from South pole
+        iphi         = int(4 * iring + 1 - (ip - 2*(long long)iring*(iring-1)));
         kshift = 0;
         nr     = iring;
         iring  = 2 * nl2 - iring;
@@ -835,11 +1392,12 @@ void GHealpix::ring2xyf(const int& pix, int* ix, int* iy, int* face) const
  * This method has been adapted from the xyf2nest() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::xyf2nest(const int& ix, const int& iy, const int& face) const
+long long GHealpix::xyf2nest(const int& ix, const int& iy,
+                            const int& face) const
 {
     // Computed pixel number
-    int pix = (int(face) << (2 * m_order)) +
-              spread_bits(ix) + (spread_bits(iy) << 1);
+    long long pix = ((long long)face << (2 * m_order)) +
+                    spread_bits(ix) + (spread_bits(iy) << 1);
 
     // Return pixel number
     return pix;
@@ -857,16 +1415,17 @@ int GHealpix::xyf2nest(const int& ix, const int& iy, const int& face) const
  * This method has been adapted from the xyf2ring() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::xyf2ring(const int& ix, const int& iy, const int& face) const
+long long GHealpix::xyf2ring(const int& ix, const int& iy,
+                            const int& face) const
 {
     // Compute ring number
     int nl4 = 4 * m_nside;
     int jr  = (jrll[face]*m_nside) - ix - iy  - 1;
 
     // Get information about that ring
-    int  n_before;
-    int  nr;
-    bool shifted;
+    long long n_before;
+    int       nr;
+    bool      shifted;
     get_ring_info(jr, &n_before, &nr, &shifted);
     
     // Compute pixel number
@@ -925,7 +1484,7 @@ int GHealpix::nside2order(const int& nside) const
  * This method has been adapted from the nest2ring() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::nest2ring(const int& pix) const
+long long GHealpix::nest2ring(const long long& pix) const
 {
     // Throw an exception if map is not a hierachical map
     if (m_order < 0) {
@@ -940,7 +1499,7 @@ int GHealpix::nest2ring(const int& pix) const
     nest2xyf(pix, &ix, &iy, &face);
 
     // Convert (x,y,face) tuple to ring index
-    int iring = xyf2ring(ix, iy, face);
+    long long iring = xyf2ring(ix, iy, face);
 
     // Return ring index
     return iring;
@@ -959,7 +1518,7 @@ int GHealpix::nest2ring(const int& pix) const
  * This method has been adapted from the ring2nest() function located in
  * the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::ring2nest(const int& pix) const
+long long GHealpix::ring2nest(const long long& pix) const
 {
     // Throw an exception if map is not a hierachical map
     if (m_order < 0) {
@@ -973,46 +1532,11 @@ int GHealpix::ring2nest(const int& pix) const
     int face;
     ring2xyf(pix, &ix, &iy, &face);
 
-    // Convert (x,y,face) tuple to ring index
-    int iring = xyf2nest(ix, iy, face);
-
-    // Return ring index
-    return iring;
-}
-
-
-/***********************************************************************//**
- * @brief Convert pixel index to (x,y) coordinate
- *
- * @param[in] ipix Pixel index for which (x,y) are to be computed.
- * @param[out] x Pointer to x coordinate.
- * @param[out] y Pointer to y coordinate.
- ***************************************************************************/
-void GHealpix::pix2xy(const int& ipix, int* x, int* y) const
-{
-    // Set x coordinate
-    int raw = (ipix & 0x5555) | ((ipix & 0x55550000) >> 15);
-    *x      = ctab[raw & 0xff] | (ctab[raw >> 8] << 4);
-
-    // Set y coordinate
-    raw = ((ipix & 0xaaaa) >> 1) | ((ipix & 0xaaaa0000) >> 16);
-    *y  = ctab[raw & 0xff] | (ctab[raw >> 8] << 4);
+    // Convert (x,y,face) tuple to nested index
+    long long inest = xyf2nest(ix, iy, face);
 
-    // Return
-    return;
-}
-
-
-/***********************************************************************//**
- * @brief Convert (x,y) coordinate to pixel
- *
- * @param[in] x x coordinate.
- * @param[in] y y coordinate.
- ***************************************************************************/
-int GHealpix::xy2pix(int x, int y) const
-{
-    // Return pixel
-    return utab[x&0xff] | (utab[x>>8]<<16) | (utab[y&0xff]<<1) | (utab[y>>8]<<17);
+    // Return nested index
+    return inest;
 }
 
 
@@ -1026,39 +1550,40 @@ int GHealpix::xy2pix(int x, int y) const
  * @exception GException::out_of_range
  *            Pixel index is out of range.
  ***************************************************************************/
-void GHealpix::pix2ang_ring(int ipix, double* theta, double* phi) const
+void GHealpix::pix2ang_ring(long long ipix, double* theta, double* phi) const
 {
     // Check if ipix is in range
     if (ipix < 0 || ipix >= m_num_pixels) {
-        throw  GException::out_of_range(G_PIX2ANG_RING, ipix, 0, m_num_pixels-1);
+        throw GException::out_of_range(G_PIX2ANG_RING, "Pixel index",
+                                       ipix, m_num_pixels);
     }
 
     // Handle North Polar cap
     if (ipix < m_ncap) {
-        int iring = int(0.5*(1+isqrt(1+2*ipix))); // counted from North pole
-        int iphi  = (ipix+1) - 2*iring*(iring-1);
-        *theta    = std::acos(1.0 - (iring*iring) * m_fact2);
-        *phi      = (iphi - 0.5) * gammalib::pi/(2.0*iring);
+        int       iring = int((1+isqrt(1+2*ipix)) >> 1); // counted from North pole
+        long long iphi  = (ipix+1) - 2*(long long)iring*(iring-1);
+        *theta          = std::acos(1.0 - (double(iring)*iring) * m_fact2);
+        *phi            = (iphi - 0.5) * gammalib::pi/(2.0*iring);
     }
 
     // Handle Equatorial region
     else if (ipix < (m_num_pixels - m_ncap)) {
-        int    ip    = ipix - m_ncap;
-        int    iring = ip/(4*m_nside) + m_nside;   // counted from North pole
-        int    iphi  = ip%(4*m_nside) + 1;
-        double fodd  = ((iring+m_nside)&1) ? 1 : 0.5;
-        int    nl2   = 2*m_nside;
-        *theta       = std::acos((nl2 - iring) * m_fact1);
-        *phi         = (iphi - fodd) * gammalib::pi/nl2;
+        long long ip    = ipix - m_ncap;
+        int       iring = int(ip >> (m_order+2)) + m_nside; // counted from North pole
+        int       iphi  = int(ip & (4*m_nside-1)) + 1;
+        double    fodd  = ((iring+m_nside)&1) ? 1 : 0.5;
+        int       nl2   = 2*m_nside;
+        *theta          = std::acos((nl2 - iring) * m_fact1);
+        *phi            = (iphi - fodd) * gammalib::pi/nl2;
     }
 
     // Handle South Polar cap
     else {
-        int ip    = m_num_pixels - ipix;
-        int iring = int(0.5*(1+isqrt(2*ip-1)));    // Counted from South pole
-        int iphi  = 4*iring + 1 - (ip - 2*iring*(iring-1));
-        *theta    = std::acos(-1.0 + (iring*iring) * m_fact2);
-        *phi      = (iphi - 0.5) * gammalib::pi/(2.*iring);
+        long long ip    = m_num_pixels - ipix;
+        int       iring = int((1+isqrt(2*ip-1)) >> 1);   // Counted from South pole
+        long long iphi  = 4*iring + 1 - (ip - 2*(long long)iring*(iring-1));
+        *theta          = std::acos(-1.0 + (double(iring)*iring) * m_fact2);
+        *phi            = (iphi - 0.5) * gammalib::pi/(2.*iring);
     }
 
     // Return
@@ -1076,22 +1601,20 @@ void GHealpix::pix2ang_ring(int ipix, double* theta, double* phi) const
  * @exception GException::out_of_range
  *            Pixel index is out of range.
  ***************************************************************************/
-void GHealpix::pix2ang_nest(int ipix, double* theta, double* phi) const
+void GHealpix::pix2ang_nest(long long ipix, double* theta, double* phi) const
 {
     // Check if ipix is in range
     if (ipix < 0 || ipix >= m_num_pixels) {
-        throw GException::out_of_range(G_PIX2ANG_NEST, ipix, 0, m_num_pixels-1);
+        throw GException::out_of_range(G_PIX2ANG_NEST, "Pixel index",
+                                       ipix, m_num_pixels);
     }
 
-    // Get face number and index in face
-    int nl4      = 4 * m_nside;
-    int face_num = ipix >> (2*m_order);      // Face number in {0,11}
-    int ipf      = ipix & (m_npface - 1);
-
-    // Get pixel coordinates
+    // Get face number and pixel coordinates
+    int nl4 = 4 * m_nside;
+    int face_num;
     int ix;
     int iy;
-    pix2xy(ipf, &ix, &iy);
+    nest2xyf(ipix, &ix, &iy, &face_num);
 
     // Computes the z coordinate on the sphere
     int jr = (jrll[face_num] << m_order) - ix - iy - 1;
@@ -1104,14 +1627,14 @@ void GHealpix::pix2ang_nest(int ipix, double* theta, double* phi) const
     // North pole region
     if (jr < m_nside) {
         nr     = jr;
-        z      = 1. - nr*nr*m_fact2;
+        z      = 1. - double(nr)*nr*m_fact2;
         kshift = 0;
     }
 
     // South pole region
     else if (jr > 3*m_nside) {
         nr     = nl4 - jr;
-        z      = nr*nr*m_fact2 - 1;
+        z      = double(nr)*nr*m_fact2 - 1;
         kshift = 0;
     }
 
@@ -1142,10 +1665,10 @@ void GHealpix::pix2ang_nest(int ipix, double* theta, double* phi) const
  * @param[in] z Cosine of zenith angle - cos(theta).
  * @param[in] phi Azimuth angle in radians.
  ***************************************************************************/
-int GHealpix::ang2pix_z_phi_ring(double z, double phi) const
+long long GHealpix::ang2pix_z_phi_ring(double z, double phi) const
 {
     // Initialise pixel
-    int ipix = 0;
+    long long ipix = 0;
 
     // Setup
     double za = fabs(z);
@@ -1153,6 +1676,7 @@ int GHealpix::ang2pix_z_phi_ring(double z, double phi) const
 
     // Equatorial region
     if (za <= gammalib::twothird) {
+        int    nl4    = 4*m_nside;
         double temp1  = m_nside*(0.5+tt);
         double temp2  = m_nside*z*0.75;
         int    jp     = int(temp1-temp2);           // index of ascending edge line
@@ -1160,8 +1684,10 @@ int GHealpix::ang2pix_z_phi_ring(double z, double phi) const
         int    ir     = m_nside + 1 + jp - jm;      // in {1,2n+1}
         int    kshift = 1 - (ir & 1);               // kshift=1 if ir even, 0 otherwise
         int    ip     = (jp+jm-m_nside+kshift+1)/2; // in {0,4n-1}
-        ip            = int(gammalib::modulo(ip,4*m_nside));
-        ipix          = m_ncap + (ir-1)*4*m_nside + ip;
+        if (ip >= nl4) {
+            ip -= nl4;
+        }
+        ipix          = m_ncap + (long long)(ir-1)*nl4 + ip;
     }
 
     // North & South polar caps
@@ -1172,11 +1698,13 @@ int GHealpix::ang2pix_z_phi_ring(double z, double phi) const
         int    jm  = int((1.0-tp)*tmp); // decreasing edge line index
         int    ir  = jp + jm + 1;       // ring number counted from the closest pole
         int    ip  = int(tt*ir);        // in {0,4*ir-1}
-        ip = int(gammalib::modulo(ip,4*ir));
+        if (ip >= 4*ir) {
+            ip -= 4*ir;
+        }
         if (z>0)
-            ipix = 2*ir*(ir-1) + ip;
+            ipix = 2*(long long)ir*(ir-1) + ip;
         else
-            ipix = m_num_pixels - 2*ir*(ir+1) + ip;
+            ipix = m_num_pixels - 2*(long long)ir*(ir+1) + ip;
     }
 
     // Return pixel
@@ -1189,8 +1717,11 @@ int GHealpix::ang2pix_z_phi_ring(double z, double phi) const
  *
  * @param[in] z Cosine of zenith angle - cos(theta).
  * @param[in] phi Azimuth angle in radians.
+ *
+ * This method has been adapted from the loc2pix() function located in the
+ * file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
-int GHealpix::ang2pix_z_phi_nest(double z, double phi) const
+long long GHealpix::ang2pix_z_phi_nest(double z, double phi) const
 {
     // Initialise face and pixel numbers
     int face_num;
@@ -1203,47 +1734,46 @@ int GHealpix::ang2pix_z_phi_nest(double z, double phi) const
 
     // Equatorial region
     if (za <= gammalib::twothird) {
-        double temp1 = ns_max*(0.5+tt);
-        double temp2 = ns_max*z*0.75;
+        double temp1 = m_nside*(0.5+tt);
+        double temp2 = m_nside*z*0.75;
         int    jp    = int(temp1-temp2); // index of  ascending edge line
         int    jm    = int(temp1+temp2); // index of descending edge line
-        int    ifp   = jp >> order_max;  // in {0,4}
-        int    ifm   = jm >> order_max;
+        int    ifp   = jp >> m_order;    // in {0,4}
+        int    ifm   = jm >> m_order;
         if (ifp == ifm)                  // faces 4 to 7
             face_num = (ifp==4) ? 4: ifp+4;
         else if (ifp < ifm)              // (half-)faces 0 to 3
             face_num = ifp;
         else                             // (half-)faces 8 to 11
             face_num = ifm + 8;
-        ix = jm & (ns_max-1);
-        iy = ns_max - (jp & (ns_max-1)) - 1;
+        ix = jm & (m_nside-1);
+        iy = m_nside - (jp & (m_nside-1)) - 1;
     }
 
     // Polar region, za > 2/3
     else {
         int    ntt = int(tt);
         double tp  = tt-ntt;
-        double tmp = ns_max * std::sqrt(3*(1-za));
-        int    jp  = int(tp*tmp);        // increasing edge line index
-        int    jm  = int((1.0-tp)*tmp);  // decreasing edge line index
-        if (jp >= ns_max) jp = ns_max-1; // for points too close to the boundary
-        if (jm >= ns_max) jm = ns_max-1;
+        double tmp = m_nside * std::sqrt(3*(1-za));
+        int    jp  = int(tp*tmp);          // increasing edge line index
+        int    jm  = int((1.0-tp)*tmp);    // decreasing edge line index
+        if (ntt >= 4) ntt = 3;
+        if (jp >= m_nside) jp = m_nside-1; // for points too close to the boundary
+        if (jm >= m_nside) jm = m_nside-1;
         if (z >= 0) {
-            face_num = ntt;              // in {0,3}
-            ix       = ns_max - jm - 1;
-            iy       = ns_max - jp - 1;
+            face_num = ntt;                // in {0,3}
+            ix       = m_nside - jm - 1;
+            iy       = m_nside - jp - 1;
         }
         else {
-            face_num = ntt + 8;          // in {8,11}
+            face_num = ntt + 8;            // in {8,11}
             ix       =  jp;
             iy       =  jm;
         }
     }
 
-    // Get pixel
-    int ipf = xy2pix(ix, iy);
-    ipf >>= (2*(order_max - m_order));     // in {0, nside**2 - 1}
-    return ipf + (face_num<<(2*m_order));  // in {0, 12*nside**2 - 1}
+    // Return pixel
+    return (xyf2nest(ix, iy, face_num));
 }
 
 
@@ -1297,7 +1827,7 @@ int GHealpix::ring_above(const double& costheta) const
  * located in the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
 void GHealpix::get_ring_info(const int& ring,
-                             int*       startpix,
+                             long long* startpix,
                              int*       ringpix,
                              bool*      shifted) const
 {
@@ -1305,14 +1835,14 @@ void GHealpix::get_ring_info(const int& ring,
     if (ring < m_nside) {
         *shifted  = true;
         *ringpix  = 4 * ring;
-        *startpix = 2 * ring * (ring-1);
+        *startpix = 2 * (long long)ring * (ring-1);
     }
     
     // Handle ring in equatorial region
     else if (ring < 3*m_nside) {
         *shifted  = ((ring-m_nside) & 1) == 0;
         *ringpix  = 4 * m_nside;
-        *startpix = m_ncap + (ring-m_nside) * *ringpix;
+        *startpix = m_ncap + (long long)(ring-m_nside) * *ringpix;
     }
 
     // Handle ring in South polar cap
@@ -1320,7 +1850,7 @@ void GHealpix::get_ring_info(const int& ring,
         int nr    = 4 * m_nside - ring;
         *shifted  = true;
         *ringpix  = 4 * nr;
-        *startpix = m_num_pixels - 2 * nr * (nr+1);
+        *startpix = m_num_pixels - 2 * (long long)nr * (nr+1);
     }
 
     // Return
@@ -1342,7 +1872,7 @@ void GHealpix::get_ring_info(const int& ring,
  * located in the file healpix_base.cc in Healpix version 3.20.
  ***************************************************************************/
 void GHealpix::get_ring_info(const int& ring,
-                             int*       startpix,
+                             long long* startpix,
                              int*       ringpix,
                              double*    theta,
                              bool*      shifted) const
@@ -1352,10 +1882,10 @@ void GHealpix::get_ring_info(const int& ring,
 
     // Are we in the North?
     if (northring < m_nside) {
-        double tmp      = northring * northring * m_fact2;
+        double tmp      = double(northring) * northring * m_fact2;
         double costheta = 1.0 - tmp;
         double sintheta = std::sqrt(tmp * (2.0-tmp));
-        *startpix       = 2 * northring * (northring - 1);
+        *startpix       = 2 * (long long)northring * (northring - 1);
         *ringpix        = 4 * northring;
         *theta          = std::atan2(sintheta, costheta);
         *shifted        = true;
@@ -1364,7 +1894,7 @@ void GHealpix::get_ring_info(const int& ring,
         *theta    = std::acos((2.0 * m_nside-northring) * m_fact1);
         *ringpix  = 4 * m_nside;
         *shifted  = ((northring - m_nside) & 1) == 0;
-        *startpix = m_ncap + (northring - m_nside) * *ringpix;
+        *startpix = m_ncap + (long long)(northring - m_nside) * *ringpix;
     }
     
     // Are we in the southern hemisphere?
@@ -1405,14 +1935,14 @@ GBilinear GHealpix::interpolator(const double& theta, const double& phi) const
     }
 
     // Prepare computation
-    double costheta = std::cos(theta);
-    int    ir1      = ring_above(costheta); // Ring above actual colatitude
-    int    ir2      = ir1 + 1;              // Ring below actual colatitude
-    int    sp;                              // Start pixel in ring
-    int    nr;                              // Number of pixels in ring
-    double theta1;                          // Colatitude of ring above
-    double theta2;                          // Colatitude of ring below
-    bool   shift;
+    double    costheta = std::cos(theta);
+    int       ir1      = ring_above(costheta); // Ring above actual colatitude
+    int       ir2      = ir1 + 1;              // Ring below actual colatitude
+    long long sp;                              // Start pixel in ring
+    int       nr;                              // Number of pixels in ring
+    double    theta1;                          // Colatitude of ring above
+    double    theta2;                          // Colatitude of ring below
+    bool      shift;
 
     // Compute interpolating pixels and phi weights if the colatitude is not
     // North of all rings (if we're North of all rings, ir1=0)
@@ -1515,8 +2045,544 @@ GBilinear GHealpix::interpolator(const double& theta, const double& phi) const
  *
  * Returns the integer @a n, which fulfills @a n*n <= arg < (n+1)*(n+1).
  ***************************************************************************/
-unsigned int GHealpix::isqrt(unsigned int arg) const
+long long GHealpix::isqrt(const long long& arg) const
 {
+    // Compute square root
+    long long result = (long long)(std::sqrt(double(arg) + 0.5));
+
+    // For large arguments the double precision square root may be off by
+    // one, hence correct the result
+    if (arg >= (1LL << 50)) {
+        if (result * result > arg) {
+            --result;
+        }
+        else if ((result + 1) * (result + 1) <= arg) {
+            ++result;
+        }
+    }
+
     // Return
-    return unsigned(std::sqrt(arg+0.5));
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns cosine of colatitude of ring
+ *
+ * @param[in] ring Ring number (the number of the first ring is 1).
+ * @return Cosine of colatitude of ring.
+ *
+ * This method has been adapted from the ring2z() function located in the
+ * file healpix_base.cc in Healpix version 3.20.
+ ***************************************************************************/
+double GHealpix::ring2z(const int& ring) const
+{
+    // Initialise result
+    double z;
+
+    // Compute cosine of colatitude dependent on region
+    if (ring < m_nside) {
+        z = 1.0 - double(ring) * ring * m_fact2;
+    }
+    else if (ring <= 3*m_nside) {
+        z = (2*m_nside - ring) * m_fact1;
+    }
+    else {
+        int nr = 4*m_nside - ring;
+        z      = double(nr) * nr * m_fact2 - 1.0;
+    }
+
+    // Return
+    return z;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns maximum angular distance between pixel centre and corners
+ *
+ * @return Maximum angular distance (radians).
+ *
+ * This method has been adapted from the max_pixrad() function located in
+ * the file healpix_base.cc in Healpix version 3.20.
+ ***************************************************************************/
+double GHealpix::max_pixrad(void) const
+{
+    // Set vector of equatorial pixel corner
+    double za   = gammalib::twothird;
+    double phia = gammalib::pi / (4.0 * m_nside);
+    double sa   = std::sqrt((1.0 - za) * (1.0 + za));
+    double xa   = sa * std::cos(phia);
+    double ya   = sa * std::sin(phia);
+
+    // Set vector of polar cap pixel centre
+    double t1 = 1.0 - 1.0 / m_nside;
+    t1       *= t1;
+    double zb = 1.0 - t1 / 3.0;
+    double xb = std::sqrt((1.0 - zb) * (1.0 + zb));
+
+    // Compute angle between both vectors
+    double cx = ya * zb;
+    double cy = za * xb - xa * zb;
+    double cz = -ya * xb;
+    double angle = std::atan2(std::sqrt(cx*cx + cy*cy + cz*cz),
+                              xa * xb + za * zb);
+
+    // Return
+    return angle;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns colatitude and longitude of sky direction
+ *
+ * @param[in] dir Sky direction.
+ * @param[out] theta Colatitude in projection coordinates (radians).
+ * @param[out] phi Longitude in projection coordinates (radians).
+ ***************************************************************************/
+void GHealpix::dir2ang(const GSkyDir& dir, double* theta, double* phi) const
+{
+    // Compute coordinate system dependent theta and phi
+    switch (m_coordsys) {
+    case 0:
+        *theta = gammalib::pihalf - dir.dec();
+        *phi   = dir.ra();
+        break;
+    case 1:
+        *theta = gammalib::pihalf - dir.b();
+        *phi   = dir.l();
+        break;
+    default:
+        *theta = 0.0;
+        *phi   = 0.0;
+        break;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel ranges within the intersection of discs
+ *
+ * @param[in] z0 Cosines of colatitudes of disc centres.
+ * @param[in] phi0 Longitudes of disc centres (radians).
+ * @param[in] radius Disc radii (radians).
+ * @return Pixel ranges in ring scheme.
+ *
+ * Returns the ring scheme pixels whose centres lie within all discs. The
+ * pixels are returned as an array of [begin, end[ pairs of pixel indices
+ * in increasing order.
+ *
+ * The method first restricts the rings to the latitude band that is
+ * covered by all discs. For each ring the longitude interval of the ring
+ * that lies within a disc is then intersected with the pixel ranges of the
+ * ring.
+ *
+ * This method has been adapted from the query_multidisc() function located
+ * in the file healpix_base.cc in Healpix version 3.20.
+ ***************************************************************************/
+std::vector<long long> GHealpix::query_discs(const std::vector<double>& z0,
+                                             const std::vector<double>& phi0,
+                                             const std::vector<double>& radius) const
+{
+    // Initialise pixel ranges
+    std::vector<long long> ranges;
+
+    // Get number of discs
+    int ndiscs = z0.size();
+
+    // Determine range of rings that are covered by all discs
+    int irmin = 1;
+    int irmax = 4*m_nside - 1;
+    for (int j = 0; j < ndiscs; ++j) {
+        if (radius[j] < gammalib::pi) {
+            double theta = std::acos(z0[j]);
+            double rlat1 = theta - radius[j];
+            double rlat2 = theta + radius[j];
+            if (rlat1 > 0.0) {
+                int ring = ring_above(std::cos(rlat1)) + 1;
+                if (ring > irmin) {
+                    irmin = ring;
+                }
+            }
+            if (rlat2 < gammalib::pi) {
+                int ring = ring_above(std::cos(rlat2));
+                if (ring < irmax) {
+                    irmax = ring;
+                }
+            }
+        }
+    }
+
+    // Precompute disc attributes
+    std::vector<double> cosrad(ndiscs);
+    std::vector<double> sin0(ndiscs);
+    std::vector<double> phi(ndiscs);
+    for (int j = 0; j < ndiscs; ++j) {
+        cosrad[j] = std::cos(radius[j]);
+        sin0[j]   = std::sqrt((1.0 - z0[j]) * (1.0 + z0[j]));
+        phi[j]    = gammalib::modulo(phi0[j], gammalib::twopi);
+    }
+
+    // Loop over rings
+    std::vector<long long> ring_ranges;
+    std::vector<long long> arc;
+    for (int iz = irmin; iz <= irmax; ++iz) {
+
+        // Get ring information
+        long long ipix1;
+        int       nr;
+        bool      shifted;
+        get_ring_info(iz, &ipix1, &nr, &shifted);
+        double z     = ring2z(iz);
+        double shift = (shifted) ? 0.5 : 0.0;
+
+        // Initialise pixel ranges of ring with the full ring
+        ring_ranges.assign(1, ipix1);
+        ring_ranges.push_back(ipix1 + nr);
+
+        // Intersect ring with all discs
+        for (int j = 0; j < ndiscs && !ring_ranges.empty(); ++j) {
+
+            // Skip discs that cover the full sky
+            if (radius[j] >= gammalib::pi) {
+                continue;
+            }
+
+            // Determine half width in longitude of the ring section that
+            // is within the disc. A negative value signals that the ring is
+            // outside the disc, a value of pi that the ring is within the
+            // disc.
+            double dphi;
+            if (sin0[j] < 1.0e-12) {
+                dphi = (z * z0[j] >= cosrad[j]) ? gammalib::pi : -1.0;
+            }
+            else {
+                double x   = (cosrad[j] - z * z0[j]) / sin0[j];
+                double ysq = 1.0 - z * z - x * x;
+                if (ysq <= 0.0) {
+                    dphi = (x < 0.0) ? gammalib::pi : -1.0;
+                }
+                else {
+                    dphi = std::atan2(std::sqrt(ysq), x);
+                }
+            }
+
+            // If the ring is outside the disc then drop all pixels
+            if (dphi < 0.0) {
+                ring_ranges.clear();
+                continue;
+            }
+
+            // If the ring is within the disc then keep all pixels
+            if (dphi >= gammalib::pi) {
+                continue;
+            }
+
+            // Determine pixels within the ring section
+            double scale = nr / gammalib::twopi;
+            int    ip_lo = int(std::floor(scale * (phi[j] - dphi) - shift)) + 1;
+            int    ip_hi = int(std::floor(scale * (phi[j] + dphi) - shift));
+            if (ip_hi - ip_lo + 1 >= nr) {
+                continue;
+            }
+            arc.clear();
+            if (ip_lo <= ip_hi) {
+                if (ip_hi >= nr) {
+                    ip_lo -= nr;
+                    ip_hi -= nr;
+                }
+                if (ip_lo < 0) {
+                    arc.push_back(ipix1);
+                    arc.push_back(ipix1 + ip_hi + 1);
+                    arc.push_back(ipix1 + ip_lo + nr);
+                    arc.push_back(ipix1 + nr);
+                }
+                else {
+                    arc.push_back(ipix1 + ip_lo);
+                    arc.push_back(ipix1 + ip_hi + 1);
+                }
+            }
+
+            // Intersect pixel ranges of ring with ring section
+            intersect_ranges(&ring_ranges, arc);
+
+        } // endfor: looped over discs
+
+        // Append pixel ranges of ring
+        ranges.insert(ranges.end(), ring_ranges.begin(), ring_ranges.end());
+
+    } // endfor: looped over rings
+
+    // Return pixel ranges
+    return ranges;
+}
+
+
+/***********************************************************************//**
+ * @brief Converts ring scheme pixel ranges into pixels
+ *
+ * @param[in] ranges Pixel ranges in ring scheme.
+ * @return Array of pixel indices.
+ *
+ * Converts an array of [begin, end[ pairs of ring scheme pixel indices
+ * into an array of pixel indices for the ordering scheme of the
+ * projection. The pixel indices are sorted in increasing order.
+ ***************************************************************************/
+std::vector<long long> GHealpix::ranges2pixels(const std::vector<long long>& ranges) const
+{
+    // Determine number of pixels
+    int       nranges = ranges.size();
+    long long npix    = 0;
+    for (int i = 0; i+1 < nranges; i += 2) {
+        npix += ranges[i+1] - ranges[i];
+    }
+
+    // Allocate pixels
+    std::vector<long long> pixels;
+    pixels.reserve(npix);
+
+    // Append pixels of all ranges
+    for (int i = 0; i+1 < nranges; i += 2) {
+        for (long long pix = ranges[i]; pix < ranges[i+1]; ++pix) {
+            pixels.push_back(pix);
+        }
+    }
+
+    // Convert pixels into nested scheme if required
+    if (m_ordering == 1) {
+        for (long long i = 0; i < npix; ++i) {
+            pixels[i] = ring2nest(pixels[i]);
+        }
+        std::sort(pixels.begin(), pixels.end());
+    }
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Setup ring geometry for spherical harmonic transformations
+ *
+ * @param[out] z Cosine of colatitude of northern rings.
+ * @param[out] logsin Logarithm of sine of colatitude of northern rings.
+ * @param[out] ffts Fourier transformations of rings.
+ *
+ * Computes the cosine and the logarithm of the sine of the colatitudes of
+ * the rings 1 to 2 Nside (the rings of the northern hemisphere and the
+ * equator), and plans the Fourier transformations for all ring lengths.
+ * The transformation for a ring with n pixels has index n/4.
+ ***************************************************************************/
+void GHealpix::ring_geometry(std::vector<double>* z,
+                             std::vector<double>* logsin,
+                             std::vector<GFft>*   ffts) const
+{
+    // Compute geometry of northern rings
+    z->assign(2*m_nside+1, 0.0);
+    logsin->assign(2*m_nside+1, 0.0);
+    for (int ring = 1; ring <= 2*m_nside; ++ring) {
+        long long startpix;
+        int       ringpix;
+        double    theta;
+        bool      shifted;
+        get_ring_info(ring, &startpix, &ringpix, &theta, &shifted);
+        (*z)[ring]      = std::cos(theta);
+        (*logsin)[ring] = std::log(std::sin(theta));
+    }
+
+    // Plan Fourier transformations
+    ffts->assign(m_nside+1, GFft());
+    for (int i = 1; i <= m_nside; ++i) {
+        (*ffts)[i].set(4*i);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Legendre transformation for one order
+ *
+ * @param[in] m Order.
+ * @param[in] lmax Maximum multipole.
+ * @param[in] z Cosine of colatitude of northern rings.
+ * @param[in] logsin Logarithm of sine of colatitude of northern rings.
+ * @param[in,out] values Fourier coefficients of all rings.
+ * @param[in,out] alm Spherical harmonic coefficients of order @p m.
+ * @param[in] analysis Compute coefficients from Fourier coefficients?
+ *
+ * If @p analysis is true, adds the sum over all rings of the ring Fourier
+ * coefficients times the normalised associated Legendre functions
+ * \f$\lambda_{lm}(z)\f$ to the coefficients @p alm. Otherwise, sets the
+ * Fourier coefficients of order @p m of all rings to the sum of @p alm
+ * times \f$\lambda_{lm}(z)\f$ over all multipoles. The Fourier coefficients
+ * are stored by ring, with lmax+1 coefficients per ring.
+ *
+ * The Legendre functions are computed by the usual recursion in \f$l\f$,
+ * starting from \f$\lambda_{mm}\f$. The symmetry
+ * \f$\lambda_{lm}(-z) = (-1)^{l+m} \lambda_{lm}(z)\f$ is used to handle
+ * the rings of the southern hemisphere together with the rings of the
+ * northern hemisphere. As \f$\lambda_{mm}\f$ underflows for large orders
+ * close to the poles, the recursion is started with a scaled value and
+ * the scaling is removed once the functions become significant.
+ ***************************************************************************/
+void GHealpix::legendre_transform(const int&                 m,
+                                  const int&                 lmax,
+                                  const std::vector<double>& z,
+                                  const std::vector<double>& logsin,
+                                  std::complex<double>*      values,
+                                  std::complex<double>*      alm,
+                                  const bool&                analysis) const
+{
+    // Set scaling constants
+    const double scale_factor = 1.0e-300;
+    const double scale_limit  = 1.0e150;
+    const double log_scale    = 690.77552789821371;  // -ln(scale_factor)
+    const double log_limit    = -345.38776394910684; // ln(1/scale_limit)
+
+    // Compute recursion coefficients
+    std::vector<double> a(lmax+1, 0.0);
+    std::vector<double> inva(lmax+1, 0.0);
+    for (int l = m+1; l <= lmax; ++l) {
+        a[l]    = std::sqrt((4.0*l*l - 1.0) / (double(l)*l - double(m)*m));
+        inva[l] = 1.0 / a[l];
+    }
+
+    // Compute logarithm of normalisation of lambda_mm
+    double lnorm = 0.5 * std::log((2.0*m + 1.0) / gammalib::fourpi);
+    for (int k = 1; k <= m; ++k) {
+        lnorm += 0.5 * std::log((2.0*k - 1.0) / (2.0*k));
+    }
+    double sign = (m % 2 == 0) ? 1.0 : -1.0;
+
+    // Get number of Fourier coefficients per ring
+    long long stride = lmax + 1;
+
+    // Loop over northern rings
+    for (int ring = 1; ring <= 2*m_nside; ++ring) {
+
+        // Get Fourier coefficients of ring and of its southern counterpart
+        std::complex<double>* north   = values + (ring-1) * stride + m;
+        std::complex<double>* south   = values + (4*m_nside-ring-1) * stride + m;
+        bool                  equator = (ring == 2*m_nside);
+
+        // Initialise even and odd sums
+        std::complex<double> even(0.0, 0.0);
+        std::complex<double> odd(0.0, 0.0);
+        if (analysis) {
+            even = (equator) ? *north : *north + *south;
+            odd  = (equator) ? *north : *north - *south;
+        }
+
+        // Compute scaled lambda_mm
+        double lmm   = lnorm + m * logsin[ring];
+        int    scale = 0;
+        while (lmm < log_limit) {
+            lmm += log_scale;
+            scale--;
+        }
+        double lam      = sign * std::exp(lmm);
+        double lam_prev = 0.0;
+        double zr       = z[ring];
+
+        // Loop over multipoles
+        for (int l = m; l <= lmax; ++l) {
+
+            // Compute next Legendre function. Remove one level of scaling
+            // if the function becomes large.
+            if (l > m) {
+                double next = a[l] * (zr * lam - lam_prev * inva[l-1]);
+                lam_prev    = lam;
+                lam         = next;
+                if (scale < 0 && std::abs(lam) > scale_limit) {
+                    lam      *= scale_factor;
+                    lam_prev *= scale_factor;
+                    scale++;
+                }
+            }
+
+            // Use Legendre function only if it is not scaled
+            if (scale == 0) {
+                if (analysis) {
+                    alm[l-m] += lam * (((l-m) % 2 == 0) ? even : odd);
+                }
+                else if ((l-m) % 2 == 0) {
+                    even += lam * alm[l-m];
+                }
+                else {
+                    odd += lam * alm[l-m];
+                }
+            }
+
+        } // endfor: looped over multipoles
+
+        // Store Fourier coefficients of ring and its southern counterpart
+        if (!analysis) {
+            *north = even + odd;
+            if (!equator) {
+                *south = even - odd;
+            }
+        }
+
+    } // endfor: looped over northern rings
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                              Local functions                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Intersect pixel ranges
+ *
+ * @param[in,out] ranges Pixel ranges.
+ * @param[in] other Pixel ranges to intersect with.
+ *
+ * Replaces the sorted array of [begin, end[ pixel index pairs @p ranges by
+ * its intersection with the sorted array of pixel index pairs @p other.
+ ***************************************************************************/
+static void intersect_ranges(std::vector<long long>*       ranges,
+                             const std::vector<long long>& other)
+{
+    // Allocate result
+    std::vector<long long> result;
+
+    // Merge both range arrays
+    int nranges = ranges->size();
+    int nother  = other.size();
+    int i       = 0;
+    int k       = 0;
+    while (i+1 < nranges && k+1 < nother) {
+
+        // Compute overlap of current ranges
+        long long begin = std::max((*ranges)[i], other[k]);
+        long long end   = std::min((*ranges)[i+1], other[k+1]);
+        if (begin < end) {
+            result.push_back(begin);
+            result.push_back(end);
+        }
+
+        // Advance the range that ends first
+        if ((*ranges)[i+1] < other[k+1]) {
+            i += 2;
+        }
+        else {
+            k += 2;
+        }
+
+    } // endwhile: merged ranges
+
+    // Store result
+    *ranges = result;
+
+    // Return
+    return;
 }
@@ -176,15 +176,19 @@ void GSkyDir::radec(const double& ra, const double& dec)
     // Set attributes
     m_has_lb    = false;
     m_has_radec = true;
-    #if defined(G_SINCOS_CACHE)
-    m_has_lb_cache    = false;
-    m_has_radec_cache = false;
-    #endif
 
     // Set direction
     m_ra  = ra;
     m_dec = dec;
 
+    // Set sincos cache
+    #if defined(G_SINCOS_CACHE)
+    m_has_lb_cache    = false;
+    m_has_radec_cache = true;
+    m_sin_dec         = std::sin(m_dec);
+    m_cos_dec         = std::cos(m_dec);
+    #endif
+
     // Return
     return;
 }
@@ -203,15 +207,19 @@ void GSkyDir::radec_deg(const double& ra, const double& dec)
     // Set attributes
     m_has_lb    = false;
     m_has_radec = true;
-    #if defined(G_SINCOS_CACHE)
-    m_has_lb_cache    = false;
-    m_has_radec_cache = false;
-    #endif
 
     // Set direction
     m_ra  = ra  * gammalib::deg2rad;
     m_dec = dec * gammalib::deg2rad;
 
+    // Set sincos cache
+    #if defined(G_SINCOS_CACHE)
+    m_has_lb_cache    = false;
+    m_has_radec_cache = true;
+    m_sin_dec         = std::sin(m_dec);
+    m_cos_dec         = std::cos(m_dec);
+    #endif
+
     // Return
     return;
 }
@@ -230,15 +238,19 @@ void GSkyDir::lb(const double& l, const double& b)
     // Set attributes
     m_has_lb    = true;
     m_has_radec = false;
-    #if defined(G_SINCOS_CACHE)
-    m_has_lb_cache    = false;
-    m_has_radec_cache = false;
-    #endif
 
     // Set direction
     m_l = l;
     m_b = b;
 
+    // Set sincos cache
+    #if defined(G_SINCOS_CACHE)
+    m_has_lb_cache    = true;
+    m_has_radec_cache = false;
+    m_sin_b           = std::sin(m_b);
+    m_cos_b           = std::cos(m_b);
+    #endif
+
     // Return
     return;
 }
@@ -257,15 +269,19 @@ void GSkyDir::lb_deg(const double& l, const double& b)
     // Set attributes
     m_has_lb    = true;
     m_has_radec = false;
-    #if defined(G_SINCOS_CACHE)
-    m_has_lb_cache    = false;
-    m_has_radec_cache = false;
-    #endif
 
     // Set direction
     m_l = l * gammalib::deg2rad;
     m_b = b * gammalib::deg2rad;
 
+    // Set sincos cache
+    #if defined(G_SINCOS_CACHE)
+    m_has_lb_cache    = true;
+    m_has_radec_cache = false;
+    m_sin_b           = std::sin(m_b);
+    m_cos_b           = std::cos(m_b);
+    #endif
+
     // Return
     return;
 }
@@ -292,15 +308,19 @@ void GSkyDir::celvector(const GVector& vector)
     // Set attributes
     m_has_lb    = false;
     m_has_radec = true;
-    #if defined(G_SINCOS_CACHE)
-    m_has_lb_cache    = false;
-    m_has_radec_cache = false;
-    #endif
 
     // Convert vector into sky position
     m_dec = std::asin(vector[2]);
     m_ra  = std::atan2(vector[1], vector[0]);
 
+    // Set sincos cache
+    #if defined(G_SINCOS_CACHE)
+    m_has_lb_cache    = false;
+    m_has_radec_cache = true;
+    m_sin_dec         = std::sin(m_dec);
+    m_cos_dec         = std::cos(m_dec);
+    #endif
+
     // Return
     return;
 }
@@ -440,12 +460,9 @@ GVector GSkyDir::celvector(void) const
     double  cosra  = std::cos(m_ra);
     double  sinra  = std::sin(m_ra);
     #if defined(G_SINCOS_CACHE)
-    if (!m_has_radec_cache) {
-        m_has_radec_cache = true;
-        m_sin_dec         = std::sin(m_dec);
-        m_cos_dec         = std::cos(m_dec);
-    }
-    GVector vector(m_cos_dec*cosra, m_cos_dec*sinra, m_sin_dec);
+    double  cosdec = (m_has_radec_cache) ? m_cos_dec : std::cos(m_dec);
+    double  sindec = (m_has_radec_cache) ? m_sin_dec : std::sin(m_dec);
+    GVector vector(cosdec*cosra, cosdec*sinra, sindec);
     #else
     double  cosdec = std::cos(m_dec);
     double  sindec = std::sin(m_dec);
@@ -473,20 +490,8 @@ double GSkyDir::dist(const GSkyDir& dir) const
     // Compute dependent on coordinate system availability. This speeds
     // up things by avoiding unnecessary coordinate transformations.
     if (m_has_lb) {
-        #if defined(G_SINCOS_CACHE)
-        if (!m_has_lb_cache) {
-            m_has_lb_cache = true;
-            m_sin_b        = std::sin(m_b);
-            m_cos_b        = std::cos(m_b);
-        }
-        #endif
         if (dir.m_has_lb) {
             #if defined(G_SINCOS_CACHE)
-            if (!dir.m_has_lb_cache) {
-                dir.m_has_lb_cache = true;
-                dir.m_sin_b        = std::sin(dir.m_b);
-                dir.m_cos_b        = std::cos(dir.m_b);
-            }
             cosdis = m_sin_b * dir.m_sin_b +
                      m_cos_b * dir.m_cos_b *
                      std::cos(dir.m_l - m_l);
@@ -509,20 +514,8 @@ double GSkyDir::dist(const GSkyDir& dir) const
         }
     }
     else if (m_has_radec) {
-        #if defined(G_SINCOS_CACHE)
-        if (!m_has_radec_cache) {
-            m_has_radec_cache = true;
-            m_sin_dec         = std::sin(m_dec);
-            m_cos_dec         = std::cos(m_dec);
-        }
-        #endif
         if (dir.m_has_radec) {
             #if defined(G_SINCOS_CACHE)
-            if (!dir.m_has_radec_cache) {
-                dir.m_has_radec_cache = true;
-                dir.m_sin_dec         = std::sin(dir.m_dec);
-                dir.m_cos_dec         = std::cos(dir.m_dec);
-            }
             cosdis = m_sin_dec * dir.m_sin_dec +
                      m_cos_dec * dir.m_cos_dec *
                      std::cos(dir.m_ra - m_ra);
@@ -600,13 +593,6 @@ double GSkyDir::posang(const GSkyDir& dir) const
     // Compute dependent on coordinate system availability. This speeds
     // up things by avoiding unnecessary coordinate transformations.
     if (m_has_lb) {
-        #if defined(G_SINCOS_CACHE)
-        if (!m_has_lb_cache) {
-            m_has_lb_cache = true;
-            m_sin_b        = std::sin(m_b);
-            m_cos_b        = std::cos(m_b);
-        }
-        #endif
         if (dir.m_has_lb) {
             arg_1 = std::sin(dir.m_l - m_l);
             #if defined(G_SINCOS_CACHE)
@@ -629,13 +615,6 @@ double GSkyDir::posang(const GSkyDir& dir) const
         }
     }
     else if (m_has_radec) {
-        #if defined(G_SINCOS_CACHE)
-        if (!m_has_radec_cache) {
-            m_has_radec_cache = true;
-            m_sin_dec         = std::sin(m_dec);
-            m_cos_dec         = std::cos(m_dec);
-        }
-        #endif
         if (dir.m_has_radec) {
             arg_1 = std::sin(dir.m_ra - m_ra);
             #if defined(G_SINCOS_CACHE)
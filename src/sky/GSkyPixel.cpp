@@ -34,6 +34,7 @@
 
 /* __ Method name definitions ____________________________________________ */
 #define G_INT                                     "GSkyPixel::operator int()"
+#define G_LONGLONG                          "GSkyPixel::operator long long()"
 #define G_DOUBLE                               "GSkyPixel::operator double()"
 
 /* __ Macros _____________________________________________________________ */
@@ -81,6 +82,23 @@ GSkyPixel::GSkyPixel(const int& index)
 }
 
 
+/***********************************************************************//**
+ * @brief 1D pixel constructor (64-bit integer version)
+ *
+ * @param[in] index Pixel index.
+ ***************************************************************************/
+GSkyPixel::GSkyPixel(const long long& index)
+{
+    // Set members
+    m_size = 1;
+    m_x    = double(index);
+    m_y    = 0.0;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief 1D pixel constructor (double precision version)
  *
@@ -223,6 +241,33 @@ GSkyPixel::operator int() const
 }
 
 
+/***********************************************************************//**
+ * @brief To 64-bit integer type conversion
+ *
+ * @return Pixel index.
+ *
+ * Converts the sky map pixel into a 64-bit integer value. Use this
+ * conversion for pixel indices of sky maps that may have more than 2^31
+ * pixels.
+ ***************************************************************************/
+GSkyPixel::operator long long() const
+{
+    // Throw an exception if pixel is not 1D
+    if (!is_1D()) {
+        std::string msg = "Sky map pixel is not 1-dimensional.\n"
+                          "Conversion from GSkyPixel to long long is only"
+                          " allowed for 1-dimensional sky map pixels.";
+        throw GException::invalid_value(G_LONGLONG, msg);
+    }
+
+    // Round pixel to integer value
+    long long value = (long long)(m_x + 0.5);
+
+    // Return value
+    return value;
+}
+
+
 /***********************************************************************//**
  * @brief To double type conversion
  *
@@ -199,6 +199,105 @@ void GSkyProjection::coordsys(const std::string& coordsys)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of an array of sky map pixels
+ *
+ * @param[in] x Array [n] of pixel x coordinates (or pixel indices for
+ *              1-dimensional projections).
+ * @param[in] y Array [n] of pixel y coordinates (ignored for 1-dimensional
+ *              projections).
+ * @param[out] lon Array [n] of longitudes in the projection's coordinate
+ *                 system (deg).
+ * @param[out] lat Array [n] of latitudes in the projection's coordinate
+ *                 system (deg).
+ * @param[in] n Number of pixels.
+ *
+ * Converts @p n sky map pixels into sky coordinates. This default
+ * implementation loops over the single pixel pix2dir() method. Derived
+ * classes should overload this method to perform the conversion without
+ * allocating intermediate GSkyPixel and GSkyDir objects.
+ ***************************************************************************/
+void GSkyProjection::pix2dir(const double* x, const double* y,
+                             double* lon, double* lat, const int& n) const
+{
+    // Loop over all pixels
+    for (int i = 0; i < n; ++i) {
+
+        // Set sky map pixel
+        GSkyPixel pixel = (size() == 1) ? GSkyPixel(x[i])
+                                        : GSkyPixel(x[i], y[i]);
+
+        // Convert pixel into sky direction
+        GSkyDir dir = pix2dir(pixel);
+
+        // Store coordinates
+        if (m_coordsys == 0) {
+            lon[i] = dir.ra_deg();
+            lat[i] = dir.dec_deg();
+        }
+        else {
+            lon[i] = dir.l_deg();
+            lat[i] = dir.b_deg();
+        }
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns sky map pixels of an array of sky coordinates
+ *
+ * @param[in] lon Array [n] of longitudes in the projection's coordinate
+ *                system (deg).
+ * @param[in] lat Array [n] of latitudes in the projection's coordinate
+ *                system (deg).
+ * @param[out] x Array [n] of pixel x coordinates (or pixel indices for
+ *               1-dimensional projections).
+ * @param[out] y Array [n] of pixel y coordinates (set to zero for
+ *               1-dimensional projections).
+ * @param[in] n Number of sky coordinates.
+ *
+ * Converts @p n sky coordinates into sky map pixels. This default
+ * implementation loops over the single direction dir2pix() method.
+ ***************************************************************************/
+void GSkyProjection::dir2pix(const double* lon, const double* lat,
+                             double* x, double* y, const int& n) const
+{
+    // Loop over all sky coordinates
+    for (int i = 0; i < n; ++i) {
+
+        // Set sky direction
+        GSkyDir dir;
+        if (m_coordsys == 0) {
+            dir.radec_deg(lon[i], lat[i]);
+        }
+        else {
+            dir.lb_deg(lon[i], lat[i]);
+        }
+
+        // Convert sky direction into pixel
+        GSkyPixel pixel = dir2pix(dir);
+
+        // Store pixel
+        if (pixel.is_1D()) {
+            x[i] = pixel.index();
+            y[i] = 0.0;
+        }
+        else {
+            x[i] = pixel.x();
+            y[i] = pixel.y();
+        }
+
+    } // endfor: looped over sky coordinates
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Protected methods                            =
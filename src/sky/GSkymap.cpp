@@ -28,15 +28,23 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <limits>
 #include "GException.hpp"
 #include "GTools.hpp"
+#include "GMath.hpp"
 #include "GSkymap.hpp"
 #include "GHealpix.hpp"
 #include "GWcsRegistry.hpp"
 #include "GWcs.hpp"
 #include "GFits.hpp"
 #include "GFitsTableDoubleCol.hpp"
+#include "GFitsTableLongLongCol.hpp"
 #include "GFitsImageDouble.hpp"
+#include "GFunction.hpp"
+#include "GFft.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_CONSTRUCT_HPX                "GSkymap::GSkymap(std::string&, int&,"\
@@ -48,16 +56,20 @@
 #define G_OP_UNARY_SUB                        "GSkymap::operator-=(GSkymap&)"
 #define G_OP_UNARY_MUL                        "GSkymap::operator-=(GSkymap&)"
 #define G_OP_UNARY_DIV                        "GSkymap::operator-=(GSkymap&)"
-#define G_OP_ACCESS_1D                        "GSkymap::operator(int&, int&)"
+#define G_OP_ACCESS_1D                  "GSkymap::operator(long long&, int&)"
 #define G_OP_ACCESS_2D                  "GSkymap::operator(GSkyPixel&, int&)"
 #define G_OP_VALUE                        "GSkymap::operator(GSkyDir&, int&)"
-#define G_INX2DIR                                    "GSkymap::inx2dir(int&)"
+#define G_INX2DIR                              "GSkymap::inx2dir(long long&)"
+#define G_INX2DIR2                       "GSkymap::inx2dir(long long&, int&)"
 #define G_PIX2DIR                              "GSkymap::pix2dir(GSkyPixel&)"
 #define G_DIR2INX                                "GSkymap::dir2inx(GSkyDir&)"
 #define G_DIR2PIX                                "GSkymap::dir2pix(GSkyDir&)"
-#define G_SOLIDANGLE1                             "GSkymap::solidangle(int&)"
+#define G_SOLIDANGLE1                       "GSkymap::solidangle(long long&)"
 #define G_SOLIDANGLE2                       "GSkymap::solidangle(GSkyPixel&)"
 #define G_EXTRACT                              "GSkymap::extract(int&, int&)"
+#define G_ADD                                   "GSkymap::add(GSkymap&, double&)"
+#define G_SCALE                          "GSkymap::scale(std::vector<double>&)"
+#define G_CONVOLVE               "GSkymap::convolve(GFunction&, double&, int&)"
 #define G_READ                               "GSkymap::read(const GFitsHDU&)"
 #define G_SET_WCS     "GSkymap::set_wcs(std::string&, std::string&, double&,"\
                               " double&, double&, double&, double&, double&,"\
@@ -65,6 +77,7 @@
 #define G_READ_HEALPIX                   "GSkymap::read_healpix(GFitsTable*)"
 #define G_READ_WCS                           "GSkymap::read_wcs(GFitsImage*)"
 #define G_ALLOC_WCS                         "GSkymap::alloc_wcs(GFitsImage*)"
+#define G_CREATE_HEALPIX_HDU                "GSkymap::create_healpix_hdu()"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -75,6 +88,15 @@
 //#define G_READ_WCS_DEBUG                                  // Debug read_wcs
 
 /* __ Prototype __________________________________________________________ */
+static void fft2d(std::complex<double>* data,
+                  const GFft&           fftx,
+                  const GFft&           ffty,
+                  const bool&           forward);
+
+/* __ Constants __________________________________________________________ */
+const long long max_column_size      = 2147483647; //!< Maximum FITS column size
+const double    max_pixel_distortion = 0.01;       //!< Maximum pixel size variation for convolution
+const int       kernel_subsamples    = 5;          //!< Kernel samples per pixel and axis
 
 
 /*==========================================================================
@@ -217,7 +239,7 @@ GSkymap::GSkymap(const std::string& wcs,
     // Set number of pixels and number of maps
     m_num_x      = nx;
     m_num_y      = ny;
-    m_num_pixels = m_num_x * m_num_y;
+    m_num_pixels = (long long)m_num_x * (long long)m_num_y;
     m_num_maps   = nmaps;
 
     // Allocate pixels
@@ -303,10 +325,10 @@ GSkymap& GSkymap::operator=(const GSkymap& map)
 GSkymap& GSkymap::operator=(const double& value)
 {
     // Get number of pixels
-    int num = m_num_pixels * m_num_maps;
+    long long num = m_num_pixels * m_num_maps;
 
     // Loop over all pixels
-    for (int i = 0; i < num; ++i) {
+    for (long long i = 0; i < num; ++i) {
         m_pixels[i] = value;
     }
 
@@ -329,10 +351,8 @@ GSkymap& GSkymap::operator=(const double& value)
  * bi-linearily interpolating the values in the source sky map, allowing thus
  * for a reprojection of sky map values.
  *
- * @todo The method is not optimized for speed as the transformation is done
- * for each layer separately. A private method should be introduced that
- * does the transformation, allowing the to loop more effectively over the
- * layers.
+ * If both sky maps have the same pixelisation, the pixels are combined
+ * directly without interpolation.
  ***************************************************************************/
 GSkymap& GSkymap::operator+=(const GSkymap& map)
 {
@@ -345,21 +365,37 @@ GSkymap& GSkymap::operator+=(const GSkymap& map)
         throw GException::invalid_value(G_OP_UNARY_ADD, msg);
     }
 
-    // Loop over all pixels of sky map
-    for (int index = 0; index < npix(); ++index) {
+    // If both maps have the same pixelisation then operate directly on
+    // the pixels ...
+    if (is_same(map)) {
+        long long     n   = m_num_pixels * m_num_maps;
+        double*       dst = m_pixels;
+        const double* src = map.m_pixels;
+        for (long long i = 0; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
 
-        // Get sky direction of actual pixel
-        GSkyDir dir = inx2dir(index);
+    // ... otherwise interpolate the source map
+    else {
+
+        // Loop over all pixels of sky map
+        for (long long index = 0; index < npix(); ++index) {
 
-        // Loop over all layers
-        for (int layer = 0; layer < nmaps(); ++layer) {
+            // Get sky direction of actual pixel
+            GSkyDir dir = inx2dir(index);
+
+            // Loop over all layers
+            for (int layer = 0; layer < nmaps(); ++layer) {
         
-            // Add value
-            (*this)(index, layer) += map(dir, layer);
+                // Add value
+                (*this)(index, layer) += map(dir, layer);
 
-        } // endfor: looped over all layers
+            } // endfor: looped over all layers
         
-    } // endfor: looped over all pixels
+        } // endfor: looped over all pixels
+
+    } // endelse: interpolated source map
 
     // Return this object
     return *this;
@@ -377,10 +413,10 @@ GSkymap& GSkymap::operator+=(const GSkymap& map)
 GSkymap& GSkymap::operator+=(const double& value)
 {
     // Set total number of sky map pixels
-    int num = m_num_pixels * m_num_maps;
+    long long num = m_num_pixels * m_num_maps;
 
     // Loop over all pixels of sky map
-    for (int i = 0; i < num; ++i) {
+    for (long long i = 0; i < num; ++i) {
         m_pixels[i] += value;
     }
 
@@ -403,10 +439,8 @@ GSkymap& GSkymap::operator+=(const double& value)
  * by bi-linearily interpolating the values in the source sky map, allowing
  * thus for a reprojection of sky map values.
  *
- * @todo The method is not optimized for speed as the transformation is done
- * for each layer separately. A private method should be introduced that
- * does the transformation, allowing the to loop more effectively over the
- * layers.
+ * If both sky maps have the same pixelisation, the pixels are combined
+ * directly without interpolation.
  ***************************************************************************/
 GSkymap& GSkymap::operator-=(const GSkymap& map)
 {
@@ -419,21 +453,37 @@ GSkymap& GSkymap::operator-=(const GSkymap& map)
         throw GException::invalid_value(G_OP_UNARY_SUB, msg);
     }
 
-    // Loop over all pixels of sky map
-    for (int index = 0; index < npix(); ++index) {
+    // If both maps have the same pixelisation then operate directly on
+    // the pixels ...
+    if (is_same(map)) {
+        long long     n   = m_num_pixels * m_num_maps;
+        double*       dst = m_pixels;
+        const double* src = map.m_pixels;
+        for (long long i = 0; i < n; ++i) {
+            dst[i] -= src[i];
+        }
+    }
+
+    // ... otherwise interpolate the source map
+    else {
+
+        // Loop over all pixels of sky map
+        for (long long index = 0; index < npix(); ++index) {
 
-        // Get sky direction of actual pixel
-        GSkyDir dir = inx2dir(index);
+            // Get sky direction of actual pixel
+            GSkyDir dir = inx2dir(index);
 
-        // Loop over all layers
-        for (int layer = 0; layer < nmaps(); ++layer) {
+            // Loop over all layers
+            for (int layer = 0; layer < nmaps(); ++layer) {
         
-            // Subtract value
-            (*this)(index, layer) -= map(dir, layer);
+                // Subtract value
+                (*this)(index, layer) -= map(dir, layer);
 
-        } // endfor: looped over all layers
+            } // endfor: looped over all layers
         
-    } // endfor: looped over all pixels
+        } // endfor: looped over all pixels
+
+    } // endelse: interpolated source map
 
     // Return this object
     return *this;
@@ -451,10 +501,10 @@ GSkymap& GSkymap::operator-=(const GSkymap& map)
 GSkymap& GSkymap::operator-=(const double& value)
 {
     // Set total number of sky map pixels
-    int num = m_num_pixels * m_num_maps;
+    long long num = m_num_pixels * m_num_maps;
 
     // Loop over all pixels of sky map
-    for (int i = 0; i < num; ++i) {
+    for (long long i = 0; i < num; ++i) {
         m_pixels[i] -= value;
     }
 
@@ -477,10 +527,8 @@ GSkymap& GSkymap::operator-=(const double& value)
  * by bi-linearily interpolating the values in the source sky map, allowing
  * thus for a reprojection of sky map values.
  *
- * @todo The method is not optimized for speed as the transformation is done
- * for each layer separately. A private method should be introduced that
- * does the transformation, allowing to loop more effectively over the
- * layers.
+ * If both sky maps have the same pixelisation, the pixels are combined
+ * directly without interpolation.
  ***************************************************************************/
 GSkymap& GSkymap::operator*=(const GSkymap& map)
 {
@@ -493,21 +541,37 @@ GSkymap& GSkymap::operator*=(const GSkymap& map)
         throw GException::invalid_value(G_OP_UNARY_MUL, msg);
     }
 
-    // Loop over all pixels of sky map
-    for (int index = 0; index < npix(); ++index) {
+    // If both maps have the same pixelisation then operate directly on
+    // the pixels ...
+    if (is_same(map)) {
+        long long     n   = m_num_pixels * m_num_maps;
+        double*       dst = m_pixels;
+        const double* src = map.m_pixels;
+        for (long long i = 0; i < n; ++i) {
+            dst[i] *= src[i];
+        }
+    }
+
+    // ... otherwise interpolate the source map
+    else {
 
-        // Get sky direction of actual pixel
-        GSkyDir dir = inx2dir(index);
+        // Loop over all pixels of sky map
+        for (long long index = 0; index < npix(); ++index) {
 
-        // Loop over all layers
-        for (int layer = 0; layer < nmaps(); ++layer) {
+            // Get sky direction of actual pixel
+            GSkyDir dir = inx2dir(index);
 
-            // Subtract value
-            (*this)(index, layer) *= map(dir, layer);
+            // Loop over all layers
+            for (int layer = 0; layer < nmaps(); ++layer) {
 
-        } // endfor: looped over all layers
+                // Subtract value
+                (*this)(index, layer) *= map(dir, layer);
 
-    } // endfor: looped over all pixels
+            } // endfor: looped over all layers
+
+        } // endfor: looped over all pixels
+
+    } // endelse: interpolated source map
 
     // Return this object
     return *this;
@@ -525,11 +589,11 @@ GSkymap& GSkymap::operator*=(const GSkymap& map)
 GSkymap& GSkymap::operator*=(const double& factor)
 {
     // Compute total number of pixels
-    int n = npix() * nmaps();
+    long long n = npix() * nmaps();
 
     // Loop over all pixels
     double* pixel = m_pixels;
-    for (int i = 0; i < n; ++i) {
+    for (long long i = 0; i < n; ++i) {
         *pixel++ *= factor;
     }
 
@@ -552,10 +616,8 @@ GSkymap& GSkymap::operator*=(const double& factor)
  * by bi-linearily interpolating the values in the source sky map, allowing
  * thus for a reprojection of sky map values.
  *
- * @todo The method is not optimized for speed as the transformation is done
- * for each layer separately. A private method should be introduced that
- * does the transformation, allowing to loop more effectively over the
- * layers.
+ * If both sky maps have the same pixelisation, the pixels are combined
+ * directly without interpolation.
  ***************************************************************************/
 GSkymap& GSkymap::operator/=(const GSkymap& map)
 {
@@ -568,29 +630,58 @@ GSkymap& GSkymap::operator/=(const GSkymap& map)
         throw GException::invalid_value(G_OP_UNARY_DIV, msg);
     }
 
-    // Loop over all pixels of sky map
-    for (int index = 0; index < npix(); ++index) {
-
-        // Get sky direction of actual pixel
-        GSkyDir dir = inx2dir(index);
+    // If both maps have the same pixelisation then divide the pixels
+    // directly ...
+    if (is_same(map)) {
 
-        // Loop over all layers
-        for (int layer = 0; layer < nmaps(); ++layer) {
-
-            // Check for division by zero
-            if (map(dir,layer) == 0.0) {
+        // Check for division by zero
+        long long     n   = m_num_pixels * m_num_maps;
+        const double* src = map.m_pixels;
+        for (long long i = 0; i < n; ++i) {
+            if (src[i] == 0.0) {
                 std::string msg = "Trying to divide by zero."
                                   " Map entries have to be strictly non-zero"
                                   " for division";
                 throw GException::invalid_value(G_OP_UNARY_DIV, msg);
             }
+        }
+
+        // Divide pixels
+        double* dst = m_pixels;
+        for (long long i = 0; i < n; ++i) {
+            dst[i] /= src[i];
+        }
+
+    } // endif: maps had the same pixelisation
+
+    // ... otherwise interpolate the source map
+    else {
+
+        // Loop over all pixels of sky map
+        for (long long index = 0; index < npix(); ++index) {
+
+            // Get sky direction of actual pixel
+            GSkyDir dir = inx2dir(index);
+
+            // Loop over all layers
+            for (int layer = 0; layer < nmaps(); ++layer) {
+
+                // Check for division by zero
+                if (map(dir,layer) == 0.0) {
+                    std::string msg = "Trying to divide by zero."
+                                      " Map entries have to be strictly non-zero"
+                                      " for division";
+                    throw GException::invalid_value(G_OP_UNARY_DIV, msg);
+                }
             
-            // Subtract value
-            (*this)(index, layer) /= map(dir, layer);
+                // Subtract value
+                (*this)(index, layer) /= map(dir, layer);
 
-        } // endfor: looped over all layers
+            } // endfor: looped over all layers
 
-    } // endfor: looped over all pixels
+        } // endfor: looped over all pixels
+
+    } // endelse: interpolated source map
 
     // Return this object
     return *this;
@@ -618,11 +709,11 @@ GSkymap& GSkymap::operator/=(const double& factor)
     }
 
     // Compute total number of pixels
-    int n = npix() * nmaps();
+    long long n = npix() * nmaps();
 
     // Loop over all pixels
     double* pixel = m_pixels;
-    for (int i = 0; i < n; ++i) {
+    for (long long i = 0; i < n; ++i) {
         *pixel++ /= factor;
     }
 
@@ -644,7 +735,7 @@ GSkymap& GSkymap::operator/=(const double& factor)
  * Access sky map pixel by its index, where the most quickly varying axis is
  * the x axis of the map.
  ***************************************************************************/
-double& GSkymap::operator()(const int& index, const int& map)
+double& GSkymap::operator()(const long long& index, const int& map)
 {
     // Throw an error if pixel index or map index is not in valid range
     #if defined(G_RANGE_CHECK)
@@ -677,7 +768,7 @@ double& GSkymap::operator()(const int& index, const int& map)
  * Access sky map pixel by its index, where the most quickly varying axis is
  * the x axis of the map.
  ***************************************************************************/
-const double& GSkymap::operator()(const int& index, const int& map) const
+const double& GSkymap::operator()(const long long& index, const int& map) const
 {
     // Throw an error if pixel index or map index is not in valid range
     #if defined(G_RANGE_CHECK)
@@ -729,7 +820,7 @@ double& GSkymap::operator()(const GSkyPixel& pixel, const int& map)
     #endif
 
     // Get pixel index
-    int index = pix2inx(pixel);
+    long long index = pix2inx(pixel);
 
     // Return reference to pixel value
     return m_pixels[index+m_num_pixels*map];
@@ -767,7 +858,7 @@ const double& GSkymap::operator()(const GSkyPixel& pixel, const int& map) const
     #endif
 
     // Get pixel index
-    int index = pix2inx(pixel);
+    long long index = pix2inx(pixel);
 
     // Return reference to pixel value
     return m_pixels[index+m_num_pixels*map];
@@ -897,7 +988,7 @@ double GSkymap::operator()(const GSkyDir& dir, const int& map) const
     if (m_contained) {
 
         // Compute map offset
-        int offset = m_num_pixels * map;
+        long long offset = m_num_pixels * map;
 
         // Compute interpolated skymap value
         intensity = m_interpol(m_pixels+offset);
@@ -973,21 +1064,21 @@ void GSkymap::nmaps(const int& nmaps)
     if (m_num_pixels > 0 && nmaps != m_num_maps) {
 
         // Compute new skymap size
-        int new_size = m_num_pixels * nmaps;
+        long long new_size = m_num_pixels * nmaps;
 
         // Allocate memory for new map
         double* pixels = new double[new_size];
 
         // Copy over existing pixels
-        int num_copy = (nmaps > m_num_maps) ? m_num_maps : nmaps;
-        num_copy    *= m_num_pixels;
-        for (int i = 0; i < num_copy; ++i) {
+        long long num_copy = (nmaps > m_num_maps) ? m_num_maps : nmaps;
+        num_copy          *= m_num_pixels;
+        for (long long i = 0; i < num_copy; ++i) {
             pixels[i] = m_pixels[i];
         }
 
         // Set any additional pixels to zero
         if (nmaps > m_num_maps) {
-            for (int i = num_copy; i < new_size; ++i) {
+            for (long long i = num_copy; i < new_size; ++i) {
                 pixels[i] = 0.0;
             }
         }
@@ -1019,7 +1110,7 @@ void GSkymap::nmaps(const int& nmaps)
  * sky map leads to a 1D GSkyPixel object, a 2D sky map leads to a 2D
  * GSkyPixel object.
  ***************************************************************************/
-GSkyPixel GSkymap::inx2pix(const int& index) const
+GSkyPixel GSkymap::inx2pix(const long long& index) const
 {
     // Initialise sky map pixel
     GSkyPixel pixel;
@@ -1030,7 +1121,7 @@ GSkyPixel GSkymap::inx2pix(const int& index) const
         pixel.y(double(index / m_num_x));
     }
     else {              //!< 1D sky map
-        pixel.index(index);
+        pixel.index(double(index));
     }
 
     // Return pixel
@@ -1047,9 +1138,10 @@ GSkyPixel GSkymap::inx2pix(const int& index) const
  * @exception GException::invalid_value
  *            No valid sky projection found.
  *
- * Returns sky direction for a given pixel index.
+ * Returns sky direction for a given pixel index. If the pixel cache is
+ * used, the sky direction is taken from the cache.
  ***************************************************************************/
-GSkyDir GSkymap::inx2dir(const int& index) const
+GSkyDir GSkymap::inx2dir(const long long& index) const
 {
     // Throw error if sky projection is not valid
     if (m_proj == NULL) {
@@ -1057,14 +1149,115 @@ GSkyDir GSkymap::inx2dir(const int& index) const
         throw GException::invalid_value(G_INX2DIR, msg);
     }
 
-    // Determine sky direction from pixel index.
-    GSkyDir dir = m_proj->pix2dir(inx2pix(index));
+    // Initialise sky direction
+    GSkyDir dir;
+
+    // Determine sky direction from pixel cache or from pixel index
+    if (is_cached(index)) {
+        dir = cached_dir(index);
+    }
+    else {
+        dir = m_proj->pix2dir(inx2pix(index));
+    }
 
     // Return sky direction
     return dir;
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky directions of a range of pixels
+ *
+ * @param[in] index Index of first pixel [0,...,npix()-1].
+ * @param[in] number Number of pixels.
+ * @return Sky directions of pixels [index,...,index+number-1].
+ *
+ * @exception GException::invalid_value
+ *            No valid sky projection found.
+ * @exception GException::invalid_argument
+ *            Pixel range is not comprised in the sky map.
+ *
+ * Returns the sky directions for a range of @p number pixels starting
+ * from pixel @p index. The conversion is done by a single call of the
+ * array version of GSkyProjection::pix2dir(), which is considerably faster
+ * than calling inx2dir() for each pixel. If the pixel cache is used, the
+ * sky directions are taken from the cache.
+ ***************************************************************************/
+std::vector<GSkyDir> GSkymap::inx2dir(const long long& index,
+                                      const int&       number) const
+{
+    // Throw error if sky projection is not valid
+    if (m_proj == NULL && number > 0) {
+        std::string msg = "Sky projection has not been defined.";
+        throw GException::invalid_value(G_INX2DIR2, msg);
+    }
+
+    // Throw error if pixel range is not valid
+    if (index < 0 || number < 0 || index+number > m_num_pixels) {
+        std::string msg = "Pixel range ["+gammalib::str(index)+","+
+                          gammalib::str(index+number-1)+"] is not"
+                          " comprised in the sky map pixel range [0,"+
+                          gammalib::str(m_num_pixels-1)+"].";
+        throw GException::invalid_argument(G_INX2DIR2, msg);
+    }
+
+    // Initialise sky directions
+    std::vector<GSkyDir> dirs;
+
+    // If the pixel cache is used then take the sky directions from the
+    // cache
+    if (m_use_pixel_cache) {
+        dirs.reserve(number);
+        for (int i = 0; i < number; ++i) {
+            dirs.push_back(inx2dir(index + i));
+        }
+    }
+
+    // ... otherwise continue only if there are pixels
+    else if (number > 0) {
+
+        // Allocate memory for transformation
+        std::vector<double> x(number);
+        std::vector<double> y(number, 0.0);
+        std::vector<double> lon(number);
+        std::vector<double> lat(number);
+
+        // Set pixel coordinates
+        for (int i = 0; i < number; ++i) {
+            long long inx = index + i;
+            if (m_num_x != 0) { //!< 2D sky map
+                x[i] = double(inx % m_num_x);
+                y[i] = double(inx / m_num_x);
+            }
+            else {              //!< 1D sky map
+                x[i] = double(inx);
+            }
+        }
+
+        // Transform pixels into sky coordinates
+        m_proj->pix2dir(&x[0], &y[0], &lon[0], &lat[0], number);
+
+        // Set sky directions
+        bool equ = (m_proj->coordsys() == "EQU");
+        dirs.reserve(number);
+        for (int i = 0; i < number; ++i) {
+            GSkyDir dir;
+            if (equ) {
+                dir.radec_deg(lon[i], lat[i]);
+            }
+            else {
+                dir.lb_deg(lon[i], lat[i]);
+            }
+            dirs.push_back(dir);
+        }
+
+    } // endif: there were pixels
+
+    // Return sky directions
+    return dirs;
+}
+
+
 /***********************************************************************//**
  * @brief Returns sky direction of pixel
  *
@@ -1089,16 +1282,24 @@ GSkyDir GSkymap::pix2dir(const GSkyPixel& pixel) const
     // Initialise sky direction
     GSkyDir dir;
 
-    // If pixel size matches the projection size then perform a straight
-    // forward conversion
-    if (m_proj->size() == pixel.size()) {
+    // Get pixel index in the pixel cache
+    long long index = cached_index(pixel);
+
+    // If the pixel is cached then take the sky direction from the cache
+    if (index >= 0) {
+        dir = cached_dir(index);
+    }
+
+    // ... otherwise, if pixel size matches the projection size then perform
+    // a straight forward conversion
+    else if (m_proj->size() == pixel.size()) {
         dir = m_proj->pix2dir(pixel);
     }
 
     // ... otherwise, if we have a 2D projection but a 1D pixel then
     // interpret the pixel as the linear index in the pixel array
     else if (m_proj->size() == 2) {
-        dir = m_proj->pix2dir(GSkyPixel(inx2pix(int(pixel))));
+        dir = m_proj->pix2dir(GSkyPixel(inx2pix((long long)pixel)));
     }
 
     // ... otherwise we have a 1D projection but a 2D pixel. There is
@@ -1125,14 +1326,14 @@ GSkyDir GSkymap::pix2dir(const GSkyPixel& pixel) const
  *
  * Converts a sky map @p pixel into the pixel index.
  ***************************************************************************/
-int GSkymap::pix2inx(const GSkyPixel& pixel) const
+long long GSkymap::pix2inx(const GSkyPixel& pixel) const
 {
     // Initialise pixel index
-    int index = 0;
+    long long index = 0;
 
     // Handle 1D sky map pixel
     if (pixel.is_1D()) {
-        index = int(pixel);
+        index = (long long)pixel;
     }
 
     // Handle 2D sky map pixel
@@ -1143,7 +1344,7 @@ int GSkymap::pix2inx(const GSkyPixel& pixel) const
         int iy = int(pixel.y()+0.5);
 
         // Set index
-        index = ix + iy * m_num_x;
+        index = ix + (long long)iy * m_num_x;
 
     }
 
@@ -1163,7 +1364,7 @@ int GSkymap::pix2inx(const GSkyPixel& pixel) const
  *
  * Returns sky map pixel index for a given sky direction.
  ***************************************************************************/
-int GSkymap::dir2inx(const GSkyDir& dir) const
+long long GSkymap::dir2inx(const GSkyDir& dir) const
 {
     // Throw error if WCS is not valid
     if (m_proj == NULL) {
@@ -1172,7 +1373,7 @@ int GSkymap::dir2inx(const GSkyDir& dir) const
     }
 
     // Determine pixel index for a given sky direction
-    int index = pix2inx(m_proj->dir2pix(dir));
+    long long index = pix2inx(m_proj->dir2pix(dir));
 
     // Return pixel index
     return index;
@@ -1215,9 +1416,10 @@ GSkyPixel GSkymap::dir2pix(const GSkyDir& dir) const
  * @exception GException::invalid_value
  *            No valid sky projection found.
  *
- * Returns the solid angle of the pixel with the specified @p index.
+ * Returns the solid angle of the pixel with the specified @p index. If the
+ * pixel cache is used, the solid angle is taken from the cache.
  ***************************************************************************/
-double GSkymap::solidangle(const int& index) const
+double GSkymap::solidangle(const long long& index) const
 {
     // Throw error if WCS is not valid
     if (m_proj == NULL) {
@@ -1225,8 +1427,16 @@ double GSkymap::solidangle(const int& index) const
         throw GException::invalid_value(G_SOLIDANGLE1, msg);
     }
 
-    // Determine solid angle from pixel index.
-    double solidangle = m_proj->solidangle(inx2pix(index));
+    // Initialise solid angle
+    double solidangle = 0.0;
+
+    // Determine solid angle from pixel cache or from pixel index
+    if (is_cached(index)) {
+        solidangle = cached_solidangle(index);
+    }
+    else {
+        solidangle = m_proj->solidangle(inx2pix(index));
+    }
 
     // Return solid angle
     return solidangle;
@@ -1255,16 +1465,24 @@ double GSkymap::solidangle(const GSkyPixel& pixel) const
     // Initialise solid angle
     double solidangle = 0.0;
 
-    // If pixel size matches the projection size then perform a straight
-    // forward solid angle determination
-    if (m_proj->size() == pixel.size()) {
+    // Get pixel index in the pixel cache
+    long long index = cached_index(pixel);
+
+    // If the pixel is cached then take the solid angle from the cache
+    if (index >= 0) {
+        solidangle = cached_solidangle(index);
+    }
+
+    // ... otherwise, if pixel size matches the projection size then perform
+    // a straight forward solid angle determination
+    else if (m_proj->size() == pixel.size()) {
         solidangle = m_proj->solidangle(pixel);
     }
 
     // ... otherwise, if we have a 2D projection but a 1D pixel then
     // interpret the pixel as the linear index in the pixel array
     else if (m_proj->size() == 2) {
-        solidangle = m_proj->solidangle(GSkyPixel(inx2pix(int(pixel))));
+        solidangle = m_proj->solidangle(GSkyPixel(inx2pix((long long)pixel)));
     }
 
     // ... otherwise we have a 1D projection but a 2D pixel. There is
@@ -1296,6 +1514,8 @@ double GSkymap::solidangle(const GSkyPixel& pixel) const
  * for example a 1D projection to a 2D skymap. Please use this method only
  * when you know what you're doing.
  *
+ * The interpolation and pixel caches are invalidated.
+ *
  * @todo We may restrict this method to not allow changing the projection
  * dimension.
  ***************************************************************************/
@@ -1307,6 +1527,35 @@ void GSkymap::projection(const GSkyProjection& proj)
     // Clone input WCS
     m_proj = proj.clone();
 
+    // Invalidate computation and pixel caches
+    m_hascache = false;
+    free_pixel_cache();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set pixel cache usage
+ *
+ * @param[in] cache Use pixel cache?
+ *
+ * Enables or disables the pixel cache. If the pixel cache is enabled, the
+ * sky directions and solid angles of all pixels are computed on first
+ * request and stored for subsequent use. Disabling the pixel cache frees
+ * the memory that is occupied by the cache.
+ ***************************************************************************/
+void GSkymap::pixel_cache(const bool& cache)
+{
+    // Set pixel cache usage flag
+    m_use_pixel_cache = cache;
+
+    // Free pixel cache if it is not used
+    if (!cache) {
+        free_pixel_cache();
+    }
+
     // Return
     return;
 }
@@ -1406,7 +1655,7 @@ GSkymap GSkymap::extract(const int& map, const int& nmaps) const
     }
 
     // Compute memory size for extracted map
-    int n_size = m_num_pixels * nmaps;
+    long long n_size = m_num_pixels * nmaps;
 
     // Allocate memory for extracted maps (handle the case that the
     // extracted map can be empty)
@@ -1416,19 +1665,19 @@ GSkymap GSkymap::extract(const int& map, const int& nmaps) const
     }
 
     // Extract pixels
-    double *src = m_pixels + map*m_num_pixels;
-    double *dst = pixels;
-    for (int i = 0; i < n_size; ++i) {
-        *dst++ = *src++;
+    if (n_size > 0) {
+        const double* src = m_pixels + map*m_num_pixels;
+        std::copy(src, src + n_size, pixels);
     }
 
-    // Create a copy of the map
-    GSkymap result = *this;
-
-    // Delete pixels from that map
-    if (result.m_pixels != NULL) delete [] result.m_pixels;
+    // Create a copy of the map without pixels, so that the pixels of all
+    // maps are not copied for nothing
+    GSkymap result;
+    result.free_members();
+    result.init_members();
+    result.copy_members(*this, false);
 
-    // Attach copied pixels to the map
+    // Attach extracted pixels to the map
     result.m_pixels = pixels;
 
     // Set number of maps
@@ -1457,13 +1706,14 @@ void GSkymap::stack_maps(void)
         // Allocate memory for stacked map
         double* pixels = new double[m_num_pixels];
 
-        // Stack map and save in memory
-        for (int i = 0; i < m_num_pixels; ++i) {
-            double sum = 0.0;
-            for (int k = 0; k < m_num_maps; ++k) {
-                sum += (*this)(i,k);
+        // Stack map and save in memory. The maps are summed one after the
+        // other so that the pixels are accessed contiguously.
+        std::copy(m_pixels, m_pixels + m_num_pixels, pixels);
+        for (int k = 1; k < m_num_maps; ++k) {
+            const double* src = m_pixels + k * m_num_pixels;
+            for (long long i = 0; i < m_num_pixels; ++i) {
+                pixels[i] += src[i];
             }
-            pixels[i] = sum;
         }
 
         // Free existing pixels
@@ -1482,6 +1732,221 @@ void GSkymap::stack_maps(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Add scaled sky map
+ *
+ * @param[in] map Sky map.
+ * @param[in] factor Scale factor.
+ *
+ * @exception GException::invalid_value
+ *            Mismatch between number of maps in skymap object.
+ *
+ * Adds the content of @p map multiplied by @p factor to the sky map. This
+ * is equivalent to adding a scaled copy of @p map, but avoids the
+ * allocation of the copy. If both sky maps have the same pixelisation, the
+ * pixels are combined directly, otherwise the content of @p map is
+ * bi-linearily interpolated as for operator+=().
+ ***************************************************************************/
+void GSkymap::add(const GSkymap& map, const double& factor)
+{
+    // Check if number of layers are identical
+    if (map.nmaps() != nmaps()) {
+        std::string msg = "Mismatch of number of maps in skymap object"
+                          " ("+gammalib::str(nmaps())+" maps in destination"
+                          " map, "+gammalib::str(map.nmaps())+" in source"
+                          " map.";
+        throw GException::invalid_value(G_ADD, msg);
+    }
+
+    // If both maps have the same pixelisation then operate directly on
+    // the pixels ...
+    if (is_same(map)) {
+        long long     n   = m_num_pixels * m_num_maps;
+        double*       dst = m_pixels;
+        const double* src = map.m_pixels;
+        for (long long i = 0; i < n; ++i) {
+            dst[i] += factor * src[i];
+        }
+    }
+
+    // ... otherwise interpolate the source map
+    else {
+
+        // Loop over all pixels of sky map
+        for (long long index = 0; index < npix(); ++index) {
+
+            // Get sky direction of actual pixel
+            GSkyDir dir = inx2dir(index);
+
+            // Loop over all layers
+            for (int layer = 0; layer < nmaps(); ++layer) {
+                (*this)(index, layer) += factor * map(dir, layer);
+            }
+
+        } // endfor: looped over all pixels
+
+    } // endelse: interpolated source map
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Scale each map by a factor
+ *
+ * @param[in] factors Scale factors for all maps.
+ *
+ * @exception GException::invalid_argument
+ *            Number of scale factors differs from number of maps.
+ *
+ * Multiplies all pixels of map k by factors[k], which allows for example
+ * to apply an energy dependent weight to the layers of a sky map cube.
+ ***************************************************************************/
+void GSkymap::scale(const std::vector<double>& factors)
+{
+    // Throw an exception if the number of factors is not correct
+    if (int(factors.size()) != m_num_maps) {
+        std::string msg = "Number of scale factors ("+
+                          gammalib::str((int)factors.size())+") differs from "
+                          "the number of maps ("+gammalib::str(m_num_maps)+
+                          ").";
+        throw GException::invalid_argument(G_SCALE, msg);
+    }
+
+    // Loop over all maps
+    for (int k = 0; k < m_num_maps; ++k) {
+        double  factor = factors[k];
+        double* pixels = m_pixels + k * m_num_pixels;
+        for (long long i = 0; i < m_num_pixels; ++i) {
+            pixels[i] *= factor;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convolve one map with a kernel
+ *
+ * @param[in] kernel Convolution kernel.
+ * @param[in] theta_max Maximum angular separation of kernel (radians).
+ * @param[in] map Map index [0,...,nmaps()-1].
+ *
+ * @exception GException::out_of_range
+ *            Map index outside valid range.
+ * @exception GException::invalid_value
+ *            Sky map projection does not support convolution or sky map
+ *            pixel size varies too much over the map.
+ *
+ * Replaces the pixel values \f$f_i\f$ of map @p map by
+ *
+ * \f[
+ *    f'_i = \sum_j f_j \, \Omega_j \, K(\theta_{ij})
+ * \f]
+ *
+ * where \f$\Omega_j\f$ is the solid angle of pixel \f$j\f$ and
+ * \f$K(\theta)\f$ is the @p kernel value (per steradian) for an angular
+ * separation \f$\theta\f$ (in radians) between the pixels \f$i\f$ and
+ * \f$j\f$. The kernel is assumed to vanish for separations beyond
+ * @p theta_max. See convolve(GFunction&, const double&) for details on the
+ * computation.
+ ***************************************************************************/
+void GSkymap::convolve(GFunction& kernel, const double& theta_max,
+                       const int& map)
+{
+    // Throw an exception if the map index is invalid
+    if (map < 0 || map >= m_num_maps) {
+        throw GException::out_of_range(G_CONVOLVE, "Sky map index", map,
+                                       m_num_maps);
+    }
+
+    // Convolve map
+    if (m_proj != NULL && m_proj->code() == "HPX") {
+        convolve_healpix(kernel, theta_max, map, 1);
+    }
+    else {
+        convolve_wcs(kernel, theta_max, map, 1);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convolve all maps with a kernel
+ *
+ * @param[in] kernel Convolution kernel.
+ * @param[in] theta_max Maximum angular separation of kernel (radians).
+ *
+ * @exception GException::invalid_value
+ *            Sky map projection does not support convolution or sky map
+ *            pixel size varies too much over the map.
+ *
+ * Replaces the pixel values \f$f_i\f$ of all maps by
+ *
+ * \f[
+ *    f'_i = \sum_j f_j \, \Omega_j \, K(\theta_{ij})
+ * \f]
+ *
+ * where \f$\Omega_j\f$ is the solid angle of pixel \f$j\f$ and
+ * \f$K(\theta)\f$ is the @p kernel value (per steradian) for an angular
+ * separation \f$\theta\f$ (in radians) between the pixels \f$i\f$ and
+ * \f$j\f$. The kernel is assumed to vanish for separations beyond
+ * @p theta_max. For a kernel that is normalised to unity the convolution
+ * conserves the flux of the map.
+ *
+ * For HealPix maps the convolution is computed in spherical harmonic
+ * space, using the coefficients \f$a_{lm}\f$ up to
+ * \f$l_{\rm max} = 3 N_{\rm side} - 1\f$, which are multiplied by the
+ * Legendre coefficients
+ *
+ * \f[
+ *    b_l = 2 \pi \int_0^{\theta_{\rm max}} K(\theta) \,
+ *          P_l(\cos \theta) \sin \theta \, d\theta
+ * \f]
+ *
+ * of the kernel.
+ *
+ * For cartesian ("CAR") and gnomonic ("TAN") World Coordinate Systems the
+ * convolution is computed using a two-dimensional Fast Fourier
+ * Transformation of the zero padded maps. The kernel is averaged over the
+ * pixels at the pixel offsets with respect to the map centre, so that
+ * kernels that are not much wider than a pixel keep their normalisation.
+ * Since the same kernel is used for all pixels, the pixel grid has
+ * to be approximately uniform over the map. An exception is thrown if the
+ * pixel size varies by more than 1% over the map, which happens for maps
+ * that extend too far from the projection centre or, for "CAR" maps, to
+ * high latitudes.
+ * Pixels within @p theta_max of the map border receive only the
+ * contributions from pixels inside the map.
+ *
+ * If many maps with the same projection are convolved, enabling the pixel
+ * cache speeds up the computation of the pixel solid angles.
+ ***************************************************************************/
+void GSkymap::convolve(GFunction& kernel, const double& theta_max)
+{
+    // Continue only if there are maps
+    if (m_num_maps > 0) {
+
+        // Convolve maps
+        if (m_proj != NULL && m_proj->code() == "HPX") {
+            convolve_healpix(kernel, theta_max, 0, m_num_maps);
+        }
+        else {
+            convolve_wcs(kernel, theta_max, 0, m_num_maps);
+        }
+
+    } // endif: there were maps
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Load skymap from FITS file.
  *
@@ -1606,10 +2071,16 @@ void GSkymap::save(const std::string& filename, bool clobber) const
  ***************************************************************************/
 void GSkymap::read(const GFitsHDU& hdu)
 {
+    // Keep pixel cache usage flag
+    bool use_pixel_cache = m_use_pixel_cache;
+
     // Free memory and initialise members
     free_members();
     init_members();
 
+    // Restore pixel cache usage flag
+    m_use_pixel_cache = use_pixel_cache;
+
     // Initialize load flag
     bool loaded = false;
 
@@ -1744,6 +2215,10 @@ void GSkymap::init_members(void)
     m_last_dir.clear();
     m_interpol.clear();
 
+    // Initialise pixel cache
+    m_use_pixel_cache = false;
+    m_pixel_cache     = NULL;
+
     // Return
     return;
 }
@@ -1755,14 +2230,14 @@ void GSkymap::init_members(void)
 void GSkymap::alloc_pixels(void)
 {
     // Compute data size
-    int size = m_num_pixels * m_num_maps;
+    long long size = m_num_pixels * m_num_maps;
 
     // Continue only if there are pixels
     if (size > 0) {
 
         // Allocate pixels and initialize them to 0
         m_pixels = new double[size];
-        for (int i = 0; i < size; ++i) {
+        for (long long i = 0; i < size; ++i) {
             m_pixels[i] = 0.0;
         }
 
@@ -1777,8 +2252,12 @@ void GSkymap::alloc_pixels(void)
  * @brief Copy class members
  *
  * @param[in] map Sky map.
+ * @param[in] pixels Copy pixels?
+ *
+ * Copies all class members. If @p pixels is false, the pixels are not
+ * copied and the sky map has no pixels on return.
  ***************************************************************************/
-void GSkymap::copy_members(const GSkymap& map)
+void GSkymap::copy_members(const GSkymap& map, const bool& pixels)
 {
     // Copy attributes
     m_num_pixels = map.m_num_pixels;
@@ -1792,18 +2271,27 @@ void GSkymap::copy_members(const GSkymap& map)
     m_last_dir  = map.m_last_dir;
     m_interpol  = map.m_interpol;
 
+    // Share pixel cache. The reference count is changed in a critical
+    // zone since the cache may be shared by sky maps in several threads.
+    m_use_pixel_cache = map.m_use_pixel_cache;
+    #pragma omp critical(GSkymap_pixel_cache)
+    {
+        m_pixel_cache = map.m_pixel_cache;
+        if (m_pixel_cache != NULL) {
+            m_pixel_cache->m_refs++;
+        }
+    }
+
     // Clone sky projection if it is valid
     if (map.m_proj != NULL) m_proj = map.m_proj->clone();
 
     // Compute data size
-    int size = m_num_pixels * m_num_maps;
+    long long size = m_num_pixels * m_num_maps;
 
     // Copy pixels
-    if (size > 0 && map.m_pixels != NULL) {
-        alloc_pixels();
-        for (int i = 0; i < size; ++i) {
-            m_pixels[i] = map.m_pixels[i];
-        }
+    if (pixels && size > 0 && map.m_pixels != NULL) {
+        m_pixels = new double[size];
+        std::copy(map.m_pixels, map.m_pixels + size, m_pixels);
     }
 
     // Return
@@ -1820,6 +2308,9 @@ void GSkymap::free_members(void)
     if (m_proj   != NULL) delete m_proj;
     if (m_pixels != NULL) delete [] m_pixels;
 
+    // Release pixel cache
+    free_pixel_cache();
+
     // Signal free pointers
     m_proj       = NULL;
     m_pixels     = NULL;
@@ -1912,6 +2403,11 @@ void GSkymap::set_wcs(const std::string& wcs, const std::string& coords,
  * a multiple of 1024. On the other hand, vectors may also be used to store
  * several HEALPix maps into a single column. Alternatively, multiple maps
  * may be stored in multiple columns.
+ *
+ * Maps with explicit indexing (INDXSCHM = 'EXPLICIT') provide the pixel
+ * indices in a "PIXEL" column, which may be a 64-bit integer ("K") column,
+ * and the pixel values of all maps in the remaining columns. Pixels that
+ * are not listed are set to zero.
  ***************************************************************************/
 void GSkymap::read_healpix(const GFitsTable& table)
 {
@@ -1934,6 +2430,51 @@ void GSkymap::read_healpix(const GFitsTable& table)
     std::cout << "m_num_pixels=" << m_num_pixels << std::endl;
     #endif
 
+    // Read explicitly indexed pixels
+    if (table.has_card("INDXSCHM") && table.string("INDXSCHM") == "EXPLICIT" &&
+        table.contains("PIXEL")) {
+
+        // Read pixel indices
+        std::vector<unsigned long> indices;
+        table["PIXEL"]->read_rows(0, nrows, indices);
+
+        // Determine number of maps from all columns except the index column
+        m_num_maps = 0;
+        for (int icol = 0; icol < ncols; ++icol) {
+            const GFitsTableCol* col = table[icol];
+            if (col->name() != "PIXEL") {
+                m_num_maps += col->number();
+            }
+        }
+
+        // Allocate pixels to hold the maps
+        alloc_pixels();
+
+        // Loop over all columns except the index column and set the pixels
+        int imap = 0;
+        for (int icol = 0; icol < ncols; ++icol) {
+            const GFitsTableCol* col = table[icol];
+            if (col->name() == "PIXEL") {
+                continue;
+            }
+            for (int inx = 0; inx < col->number(); ++inx, ++imap) {
+                double* ptr = m_pixels + m_num_pixels*imap;
+                for (int row = 0; row < nrows; ++row) {
+                    long long index = (long long)indices[row];
+                    if (index < 0 || index >= m_num_pixels) {
+                        throw GException::out_of_range(G_READ_HEALPIX,
+                              "HEALPix pixel index", index, m_num_pixels);
+                    }
+                    ptr[index] = col->real(row,inx);
+                }
+            }
+        }
+
+        // Return
+        return;
+
+    } // endif: pixels were explicitly indexed
+
     // Number of map pixels has to be a multiple of the number of
     // rows in column
     if (m_num_pixels % nrows != 0) {
@@ -1942,7 +2483,7 @@ void GSkymap::read_healpix(const GFitsTable& table)
     }
 
     // Determine vector length for HEALPix data storage
-    int nentry = m_num_pixels / nrows;
+    long long nentry = m_num_pixels / nrows;
     #if defined(G_READ_HEALPIX_DEBUG)
     std::cout << "nentry=" << nentry << std::endl;
     #endif
@@ -1953,7 +2494,7 @@ void GSkymap::read_healpix(const GFitsTable& table)
     for (int icol = 0; icol < ncols; ++icol) {
         const GFitsTableCol* col = table[icol];
         if (col->number() % nentry == 0) {
-            m_num_maps += col->number() / nentry;
+            m_num_maps += int(col->number() / nentry);
         }
     }
     #if defined(G_READ_HEALPIX_DEBUG)
@@ -1976,11 +2517,11 @@ void GSkymap::read_healpix(const GFitsTable& table)
         if (col->number() % nentry == 0) {
 
             // Determine number of maps in column
-            int num = col->number() / nentry;
+            int num = int(col->number() / nentry);
 
             // Loop over all maps in column
             int inx_start = 0;
-            int inx_end   = nentry;
+            int inx_end   = int(nentry);
             for (int i = 0; i < num; ++i) {
 
                 // Load map
@@ -1997,7 +2538,7 @@ void GSkymap::read_healpix(const GFitsTable& table)
 
                 // Increment index range
                 inx_start  = inx_end;
-                inx_end   += nentry;
+                inx_end   += int(nentry);
 
                 // Increment map counter
                 imap++;
@@ -2059,7 +2600,7 @@ void GSkymap::read_wcs(const GFitsImage& image)
     #endif
 
     // Compute number of pixels
-    m_num_pixels = m_num_x * m_num_y;
+    m_num_pixels = (long long)m_num_x * (long long)m_num_y;
     #if defined(G_READ_WCS_DEBUG)
     std::cout << "m_num_pixels=" << m_num_pixels << std::endl;
     #endif
@@ -2141,8 +2682,23 @@ void GSkymap::alloc_wcs(const GFitsImage& image)
 /***********************************************************************//**
  * @brief Create FITS HDU containing Healpix data
  *
+ * @exception GException::invalid_value
+ *            Sky map has too many non-zero pixels to be stored in a FITS
+ *            column.
+ *
  * This method allocates a binary table HDU that contains the Healpix data.
  * Deallocation of the table has to be done by the client.
+ *
+ * All maps are stored in a single vector column "DATA". If the total number
+ * of pixels exceeds the capacity of a FITS table column (2^31-1 elements),
+ * each map is stored in a separate column "DATA_1", "DATA_2", etc.
+ *
+ * Maps with more than 2^31-1 pixels (Nside >= 16384) do not fit into a
+ * FITS table column. They are stored with explicit indexing
+ * (INDXSCHM = 'EXPLICIT'): a 64-bit integer ("K") column "PIXEL" holds the
+ * indices of all pixels that are non-zero in any of the maps, followed by
+ * the pixel values using the same column layout as above. All layouts are
+ * understood by read_healpix().
  ***************************************************************************/
 GFitsBinTable* GSkymap::create_healpix_hdu(void) const
 {
@@ -2150,29 +2706,100 @@ GFitsBinTable* GSkymap::create_healpix_hdu(void) const
     GFitsBinTable* hdu = NULL;
 
     // Compute size of Healpix data
-    int size = m_num_pixels * m_num_maps;
+    long long size = m_num_pixels * m_num_maps;
+
+    // Signal whether pixels need to be indexed explicitly
+    bool explicit_index = (m_num_pixels > max_column_size);
 
     // Continue only if we have pixels
     if (size > 0) {
 
-        // Set number of rows and columns
-        int rows   = m_num_pixels;
-        int number = m_num_maps;
+        // Determine indices of pixels to be stored. For explicit indexing
+        // only the pixels that are non-zero in any of the maps are stored
+        std::vector<long long> indices;
+        long long              nindices = m_num_pixels;
+        if (explicit_index) {
+            for (long long index = 0; index < m_num_pixels; ++index) {
+                for (int imap = 0; imap < m_num_maps; ++imap) {
+                    if (m_pixels[index + m_num_pixels*imap] != 0.0) {
+                        indices.push_back(index);
+                        break;
+                    }
+                }
+            }
+            nindices = (long long)indices.size();
+        }
+
+        // Throw an exception if the pixels do not fit into a column
+        if (nindices > max_column_size) {
+            std::string msg = "Sky map with "+gammalib::str(nindices)+
+                              " non-zero pixels exceeds the maximum number"
+                              " of "+gammalib::str(max_column_size)+
+                              " elements of a FITS table column.";
+            throw GException::invalid_value(G_CREATE_HEALPIX_HDU, msg);
+        }
 
-        // Create column to hold Healpix data
-        GFitsTableDoubleCol column = GFitsTableDoubleCol("DATA", rows, number);
+        // Set number of rows
+        int rows = int(nindices);
 
-        // Fill data into column
-        double* ptr = m_pixels;
-        for (int inx = 0; inx < number; ++inx) {
+        // Create HDU that contains Healpix map in a binary table
+        hdu = new GFitsBinTable(rows);
+
+        // If pixels are explicitly indexed then store the pixel indices
+        // in a 64-bit integer column
+        if (explicit_index) {
+            GFitsTableLongLongCol column = GFitsTableLongLongCol("PIXEL", rows);
             for (int row = 0; row < rows; ++row) {
-                column(row,inx) = *ptr++;
+                column(row) = indices[row];
             }
+            hdu->append(column);
         }
 
-        // Create HDU that contains Healpix map in a binary table
-        hdu = new GFitsBinTable(rows);
-        hdu->append(column);
+        // If all maps fit into a single column then store them as a vector
+        // column
+        if ((long long)rows * m_num_maps <= max_column_size) {
+
+            // Create column to hold Healpix data
+            int                 number = m_num_maps;
+            GFitsTableDoubleCol column = GFitsTableDoubleCol("DATA", rows, number);
+
+            // Fill data into column
+            for (int inx = 0; inx < number; ++inx) {
+                const double* ptr = m_pixels + m_num_pixels*inx;
+                for (int row = 0; row < rows; ++row) {
+                    column(row,inx) = (explicit_index) ? ptr[indices[row]]
+                                                       : ptr[row];
+                }
+            }
+
+            // Append column
+            hdu->append(column);
+
+        } // endif: all maps fitted into a single column
+
+        // ... otherwise store each map in a separate column
+        else {
+
+            // Loop over maps
+            for (int imap = 0; imap < m_num_maps; ++imap) {
+
+                // Create column to hold Healpix map
+                std::string         name   = "DATA_"+gammalib::str(imap+1);
+                GFitsTableDoubleCol column = GFitsTableDoubleCol(name, rows);
+
+                // Fill data into column
+                const double* ptr = m_pixels + m_num_pixels*imap;
+                for (int row = 0; row < rows; ++row) {
+                    column(row) = (explicit_index) ? ptr[indices[row]]
+                                                   : ptr[row];
+                }
+
+                // Append column
+                hdu->append(column);
+
+            } // endfor: looped over maps
+
+        } // endelse: stored each map in a separate column
 
     } // endif: there were pixels
 
@@ -2189,6 +2816,8 @@ GFitsBinTable* GSkymap::create_healpix_hdu(void) const
 
     // Set additional keywords
     hdu->card("NBRBINS", m_num_maps, "Number of HEALPix maps");
+    hdu->card("INDXSCHM", (explicit_index) ? "EXPLICIT" : "IMPLICIT",
+              "Indexing scheme, either IMPLICIT or EXPLICIT");
 
     // Return HDU
     return hdu;
@@ -2209,7 +2838,7 @@ GFitsImageDouble* GSkymap::create_wcs_hdu(void) const
     GFitsImageDouble* hdu = NULL;
 
     // Compute size of Healpix data
-    int size = m_num_pixels * m_num_maps;
+    long long size = m_num_pixels * m_num_maps;
 
     // Continue only if we have pixels
     if (size > 0) {
@@ -2262,6 +2891,675 @@ GFitsImageDouble* GSkymap::create_wcs_hdu(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Compute pixel cache
+ *
+ * @return Pointer to pixel cache.
+ *
+ * Computes the sky directions and solid angles of all sky map pixels and
+ * stores them in the pixel cache. For 2D projections the pixels are
+ * processed row by row using the array version of GSkyProjection::pix2dir()
+ * and the pixel corners are shared between adjacent pixels and rows, which
+ * reduces the number of projections by about a factor of five with respect
+ * to computing each pixel separately. Rows that contain pixels outside the
+ * projection are computed pixel by pixel.
+ *
+ * Pixels that are outside the projection are flagged in the cache by a
+ * negative solid angle.
+ *
+ * The method returns a newly allocated pixel cache with a reference count
+ * of one and does not publish it.
+ ***************************************************************************/
+GSkymap::pixcache* GSkymap::set_pixel_cache(void) const
+{
+    // Allocate pixel cache
+    pixcache* cache = new pixcache;
+    cache->m_lon.assign(m_num_pixels, 0.0);
+    cache->m_lat.assign(m_num_pixels, 0.0);
+    cache->m_omega.assign(m_num_pixels, -1.0);
+
+    // Continue only if there is a projection
+    if (m_proj != NULL) {
+
+        // Set coordinate system flag
+        cache->m_equ = (m_proj->coordsys() == "EQU");
+
+        // Get pointer on World Coordinate System (NULL for HEALPix)
+        const GWcs* wcs = dynamic_cast<const GWcs*>(m_proj);
+
+        // Case A: 2D sky map
+        if (wcs != NULL && m_num_x > 0) {
+
+            // Allocate pixel centres and pixel corners of one row
+            int                  ncorner = m_num_x + 1;
+            std::vector<double>  x(m_num_x);
+            std::vector<double>  y(m_num_x);
+            std::vector<double>  xc(ncorner);
+            std::vector<double>  yc(ncorner);
+            std::vector<double>  lon(ncorner);
+            std::vector<double>  lat(ncorner);
+            std::vector<GSkyDir> lower(ncorner);
+            std::vector<GSkyDir> upper(ncorner);
+            bool                 has_lower = false;
+
+            // Set x coordinates of pixel centres and pixel corners
+            for (int ix = 0; ix < m_num_x; ++ix) {
+                x[ix]  = double(ix);
+                xc[ix] = double(ix) - 0.5;
+            }
+            xc[m_num_x] = double(m_num_x) - 0.5;
+
+            // Loop over rows
+            for (int iy = 0; iy < m_num_y; ++iy) {
+
+                // Get pixel offset of row
+                long long offset = (long long)iy * (long long)m_num_x;
+
+                // Compute pixel centres and pixel corners of row. If the
+                // row contains pixels outside the projection then signal
+                // that the row needs a pixel-wise computation.
+                bool valid = true;
+                try {
+
+                    // Compute pixel centres
+                    y.assign(m_num_x, double(iy));
+                    wcs->pix2dir(&x[0], &y[0], &cache->m_lon[offset],
+                                 &cache->m_lat[offset], m_num_x);
+
+                    // Compute lower pixel corners if they are not yet
+                    // available from the previous row
+                    if (!has_lower) {
+                        yc.assign(ncorner, double(iy) - 0.5);
+                        wcs->pix2dir(&xc[0], &yc[0], &lon[0], &lat[0], ncorner);
+                        for (int ix = 0; ix < ncorner; ++ix) {
+                            if (cache->m_equ) {
+                                lower[ix].radec_deg(lon[ix], lat[ix]);
+                            }
+                            else {
+                                lower[ix].lb_deg(lon[ix], lat[ix]);
+                            }
+                        }
+                    }
+
+                    // Compute upper pixel corners
+                    has_lower = false;
+                    yc.assign(ncorner, double(iy) + 0.5);
+                    wcs->pix2dir(&xc[0], &yc[0], &lon[0], &lat[0], ncorner);
+                    for (int ix = 0; ix < ncorner; ++ix) {
+                        if (cache->m_equ) {
+                            upper[ix].radec_deg(lon[ix], lat[ix]);
+                        }
+                        else {
+                            upper[ix].lb_deg(lon[ix], lat[ix]);
+                        }
+                    }
+
+                }
+                catch (GException::wcs_invalid_x_y& e) {
+                    valid     = false;
+                    has_lower = false;
+                }
+
+                // If the row is valid then compute the solid angles from
+                // the pixel corners and keep the upper pixel corners as
+                // lower pixel corners of the next row
+                if (valid) {
+                    for (int ix = 0; ix < m_num_x; ++ix) {
+                        cache->m_omega[offset+ix] =
+                            wcs->solidangle(lower[ix], lower[ix+1],
+                                            upper[ix+1], upper[ix]);
+                    }
+                    lower.swap(upper);
+                    has_lower = true;
+                }
+
+                // ... otherwise compute the row pixel by pixel and skip
+                // all pixels that are outside the projection
+                else {
+                    for (int ix = 0; ix < m_num_x; ++ix) {
+                        try {
+                            GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
+                            GSkyDir   dir   = wcs->pix2dir(pixel);
+                            double    omega = wcs->solidangle(pixel);
+                            if (cache->m_equ) {
+                                cache->m_lon[offset+ix] = dir.ra_deg();
+                                cache->m_lat[offset+ix] = dir.dec_deg();
+                            }
+                            else {
+                                cache->m_lon[offset+ix] = dir.l_deg();
+                                cache->m_lat[offset+ix] = dir.b_deg();
+                            }
+                            cache->m_omega[offset+ix] = omega;
+                        }
+                        catch (GException::wcs_invalid_x_y& e) {
+                            cache->m_omega[offset+ix] = -1.0;
+                        }
+                    }
+                }
+
+            } // endfor: looped over rows
+
+        } // endif: 2D sky map
+
+        // Case B: 1D sky map
+        else {
+
+            // Set chunk size for array conversion
+            const int nchunk = 65536;
+
+            // Allocate pixel coordinates
+            std::vector<double> x(nchunk);
+            std::vector<double> y(nchunk, 0.0);
+
+            // Loop over chunks of pixels
+            for (long long index = 0; index < m_num_pixels; index += nchunk) {
+
+                // Get number of pixels in chunk
+                int number = (m_num_pixels-index < nchunk)
+                             ? int(m_num_pixels-index) : nchunk;
+
+                // Compute pixel centres
+                for (int i = 0; i < number; ++i) {
+                    x[i] = double(index + i);
+                }
+                m_proj->pix2dir(&x[0], &y[0], &cache->m_lon[index],
+                                &cache->m_lat[index], number);
+
+                // Compute solid angles
+                for (int i = 0; i < number; ++i) {
+                    cache->m_omega[index+i] =
+                        m_proj->solidangle(GSkyPixel(index + i));
+                }
+
+            } // endfor: looped over chunks
+
+        } // endelse: 1D sky map
+
+    } // endif: there was a projection
+
+    // Return pixel cache
+    return cache;
+}
+
+
+/***********************************************************************//**
+ * @brief Check whether a pixel is in the pixel cache
+ *
+ * @param[in] index Pixel index [0,...,npix()-1].
+ * @return True if the pixel is in the pixel cache.
+ *
+ * Returns true if the pixel cache is used and if the pixel with the
+ * specified @p index is in the pixel cache. The pixel cache is computed
+ * if it is not yet valid.
+ ***************************************************************************/
+bool GSkymap::is_cached(const long long& index) const
+{
+    // Initialise flag
+    bool cached = false;
+
+    // Continue only if pixel cache is used
+    if (m_use_pixel_cache) {
+
+        // Get pixel cache
+        const pixcache* cache = pixel_cache_data();
+
+        // Check whether pixel is in cache
+        cached = (index >= 0 && index < m_num_pixels &&
+                  cache->m_omega[index] >= 0.0);
+
+    } // endif: pixel cache was used
+
+    // Return flag
+    return cached;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixel index of a pixel in the pixel cache
+ *
+ * @param[in] pixel Sky map pixel.
+ * @return Pixel index (-1 if pixel is not in the pixel cache).
+ *
+ * Returns the pixel index of a sky map @p pixel if the pixel is in the
+ * pixel cache. Only pixels with integer coordinates are in the pixel
+ * cache.
+ ***************************************************************************/
+long long GSkymap::cached_index(const GSkyPixel& pixel) const
+{
+    // Initialise pixel index
+    long long index = -1;
+
+    // Continue only if pixel cache is used
+    if (m_use_pixel_cache) {
+
+        // Determine pixel index of 1D pixel
+        long long inx = -1;
+        if (pixel.is_1D()) {
+            if (pixel.index() == std::floor(pixel.index())) {
+                inx = (long long)pixel.index();
+            }
+        }
+
+        // ... or of 2D pixel in 2D sky map
+        else if (pixel.is_2D() && m_proj->size() == 2) {
+            if (pixel.x() == std::floor(pixel.x()) &&
+                pixel.y() == std::floor(pixel.y()) &&
+                pixel.x() >= 0.0 && pixel.x() < double(m_num_x) &&
+                pixel.y() >= 0.0 && pixel.y() < double(m_num_y)) {
+                inx = (long long)pixel.x() + (long long)pixel.y() * m_num_x;
+            }
+        }
+
+        // Set pixel index if pixel is in the pixel cache
+        if (is_cached(inx)) {
+            index = inx;
+        }
+
+    } // endif: pixel cache was used
+
+    // Return pixel index
+    return index;
+}
+
+
+/***********************************************************************//**
+ * @brief Return sky direction of a pixel in the pixel cache
+ *
+ * @param[in] index Pixel index [0,...,npix()-1].
+ * @return Sky direction.
+ ***************************************************************************/
+GSkyDir GSkymap::cached_dir(const long long& index) const
+{
+    // Get pixel cache
+    const pixcache* cache = pixel_cache_data();
+
+    // Set sky direction
+    GSkyDir dir;
+    if (cache->m_equ) {
+        dir.radec_deg(cache->m_lon[index], cache->m_lat[index]);
+    }
+    else {
+        dir.lb_deg(cache->m_lon[index], cache->m_lat[index]);
+    }
+
+    // Return sky direction
+    return dir;
+}
+
+
+/***********************************************************************//**
+ * @brief Return solid angle of a pixel in the pixel cache
+ *
+ * @param[in] index Pixel index [0,...,npix()-1].
+ * @return Solid angle (sr).
+ ***************************************************************************/
+double GSkymap::cached_solidangle(const long long& index) const
+{
+    // Return solid angle
+    return (pixel_cache_data()->m_omega[index]);
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixel cache
+ *
+ * @return Pointer to pixel cache.
+ *
+ * Returns the pixel cache, and computes and publishes the pixel cache if
+ * it has not yet been computed.
+ *
+ * As the method may be called from several threads, the cache is computed
+ * and published in a critical zone. The cache content is flushed before
+ * the pointer is published, and the pointer is read between two flushes,
+ * so that a thread that finds a published cache also sees its content.
+ ***************************************************************************/
+const GSkymap::pixcache* GSkymap::pixel_cache_data(void) const
+{
+    // Get published pixel cache
+    #pragma omp flush
+    const pixcache* cache = m_pixel_cache;
+    #pragma omp flush
+
+    // If the pixel cache was not yet published then compute and publish
+    // it in a critical zone. Entering and leaving the critical zone
+    // implies a flush.
+    if (cache == NULL) {
+        #pragma omp critical(GSkymap_pixel_cache)
+        {
+            if (m_pixel_cache == NULL) {
+                pixcache* data = set_pixel_cache();
+                #pragma omp flush
+                m_pixel_cache = data;
+            }
+            cache = m_pixel_cache;
+        }
+    }
+
+    // Return pixel cache
+    return cache;
+}
+
+
+/***********************************************************************//**
+ * @brief Release pixel cache
+ *
+ * Releases the pixel cache of the sky map. The pixel cache is deleted once
+ * it is no longer used by any sky map.
+ ***************************************************************************/
+void GSkymap::free_pixel_cache(void)
+{
+    // Release pixel cache in a critical zone since the cache may be shared
+    // by sky maps in several threads
+    #pragma omp critical(GSkymap_pixel_cache)
+    {
+        if (m_pixel_cache != NULL) {
+            m_pixel_cache->m_refs--;
+            if (m_pixel_cache->m_refs == 0) {
+                delete m_pixel_cache;
+            }
+            m_pixel_cache = NULL;
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Check whether a sky map has the same pixelisation
+ *
+ * @param[in] map Sky map.
+ * @return True if @p map has the same pixelisation as the sky map.
+ *
+ * Two sky maps have the same pixelisation if they have the same number of
+ * pixels, the same image dimensions and an identical sky projection, so
+ * that pixels with the same index cover the same sky region.
+ ***************************************************************************/
+bool GSkymap::is_same(const GSkymap& map) const
+{
+    // Check dimensions and projection
+    bool same = (m_num_pixels == map.m_num_pixels &&
+                 m_num_x      == map.m_num_x      &&
+                 m_num_y      == map.m_num_y      &&
+                 m_proj != NULL && map.m_proj != NULL &&
+                 *m_proj == *map.m_proj);
+
+    // Return result
+    return same;
+}
+
+
+/***********************************************************************//**
+ * @brief Convolve HealPix maps with a kernel
+ *
+ * @param[in] kernel Convolution kernel.
+ * @param[in] theta_max Maximum angular separation of kernel (radians).
+ * @param[in] map First map to convolve.
+ * @param[in] nmaps Number of maps to convolve.
+ *
+ * Convolves the maps in spherical harmonic space. The Legendre coefficients
+ * of the kernel are computed by Simpson integration of the kernel over
+ * [0, @p theta_max], using a step size that resolves the oscillations of
+ * the Legendre polynomials up to the maximum multipole.
+ ***************************************************************************/
+void GSkymap::convolve_healpix(GFunction&    kernel,
+                               const double& theta_max,
+                               const int&    map,
+                               const int&    nmaps)
+{
+    // Get HealPix projection
+    const GHealpix* healpix = static_cast<const GHealpix*>(m_proj);
+
+    // Set maximum multipole
+    int lmax = 3 * healpix->nside() - 1;
+
+    // Set number of integration intervals (must be even)
+    double theta = (theta_max < gammalib::pi) ? theta_max : gammalib::pi;
+    int    nsteps = 2 * (int(0.5 * (lmax+1) * theta) + 500);
+    double step   = theta / double(nsteps);
+
+    // Sample kernel
+    std::vector<double> thetas(nsteps+1);
+    std::vector<double> values(nsteps+1);
+    for (int i = 0; i <= nsteps; ++i) {
+        thetas[i] = i * step;
+    }
+    kernel.eval(&thetas[0], &values[0], nsteps+1);
+
+    // Compute Legendre coefficients of kernel using Simpson's rule
+    std::vector<double> bl(lmax+1, 0.0);
+    for (int i = 0; i <= nsteps; ++i) {
+
+        // Compute Simpson weight
+        double weight = (i == 0 || i == nsteps) ? 1.0 : ((i % 2 == 1) ? 4.0 : 2.0);
+        weight *= gammalib::twopi * step / 3.0 * values[i] * std::sin(thetas[i]);
+
+        // Add Legendre polynomials, computed by recursion
+        double z      = std::cos(thetas[i]);
+        double p_prev = 1.0;
+        double p      = z;
+        bl[0] += weight;
+        for (int l = 1; l <= lmax; ++l) {
+            bl[l] += weight * p;
+            double p_next = ((2.0*l + 1.0) * z * p - l * p_prev) / (l + 1.0);
+            p_prev        = p;
+            p             = p_next;
+        }
+
+    } // endfor: looped over integration steps
+
+    // Loop over maps
+    for (int k = map; k < map+nmaps; ++k) {
+
+        // Transform map into spherical harmonic coefficients
+        double*                            pixels = m_pixels + k * m_num_pixels;
+        std::vector<std::complex<double> > alm    = healpix->map2alm(pixels, lmax);
+
+        // Multiply coefficients by Legendre coefficients of kernel
+        for (int m = 0, i = 0; m <= lmax; ++m) {
+            for (int l = m; l <= lmax; ++l, ++i) {
+                alm[i] *= bl[l];
+            }
+        }
+
+        // Transform coefficients back into map
+        healpix->alm2map(alm, lmax, pixels);
+
+    } // endfor: looped over maps
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convolve World Coordinate System maps with a kernel
+ *
+ * @param[in] kernel Convolution kernel.
+ * @param[in] theta_max Maximum angular separation of kernel (radians).
+ * @param[in] map First map to convolve.
+ * @param[in] nmaps Number of maps to convolve.
+ *
+ * @exception GException::invalid_value
+ *            Sky map projection does not support convolution or sky map
+ *            pixel size varies too much over the map.
+ *
+ * Convolves the maps using a two-dimensional Fast Fourier Transformation.
+ * The maps are zero padded by the kernel extent in both dimensions, so
+ * that the cyclic convolution computed by the Fourier transformation does
+ * not wrap around the map borders. The kernel is transformed only once and
+ * is used for all maps.
+ *
+ * A single kernel is only valid if the pixel size is nearly the same over
+ * the map. The pixel sizes of "CAR" and "TAN" maps grow with the distance
+ * from the projection centre, and for "CAR" maps the pixel size in
+ * longitude shrinks with the latitude. The method therefore compares the
+ * pixel sizes at the map corners and edge centres to the pixel size at
+ * the map centre, and throws an exception if they differ by more than 1%.
+ ***************************************************************************/
+void GSkymap::convolve_wcs(GFunction&    kernel,
+                           const double& theta_max,
+                           const int&    map,
+                           const int&    nmaps)
+{
+    // Throw an exception if the projection does not support convolution
+    std::string code = (m_proj != NULL) ? m_proj->code() : "";
+    if (code != "CAR" && code != "TAN") {
+        std::string msg = "Sky map convolution is not supported for \""+code+
+                          "\" projection.\n"
+                          "Please use a \"CAR\", \"TAN\" or \"HPX\" "
+                          "projection.";
+        throw GException::invalid_value(G_CONVOLVE, msg);
+    }
+
+    // Get centre pixel and pixel sizes at centre pixel
+    int     ic     = m_num_x / 2;
+    int     jc     = m_num_y / 2;
+    GSkyDir centre = pix2dir(GSkyPixel(double(ic), double(jc)));
+    double  dx     = pix2dir(GSkyPixel(ic-0.5, double(jc))).dist(
+                     pix2dir(GSkyPixel(ic+0.5, double(jc))));
+    double  dy     = pix2dir(GSkyPixel(double(ic), jc-0.5)).dist(
+                     pix2dir(GSkyPixel(double(ic), jc+0.5)));
+
+    // Throw an exception if the pixel size at the map corners or edge
+    // centres differs too much from the pixel size at the map centre.
+    // Pixels outside the projection are considered as infinitely distorted.
+    int    xs[3]      = {0, ic, m_num_x-1};
+    int    ys[3]      = {0, jc, m_num_y-1};
+    double distortion = 0.0;
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            try {
+                double x   = double(xs[i]);
+                double y   = double(ys[j]);
+                double dxp = pix2dir(GSkyPixel(x-0.5, y)).dist(
+                             pix2dir(GSkyPixel(x+0.5, y)));
+                double dyp = pix2dir(GSkyPixel(x, y-0.5)).dist(
+                             pix2dir(GSkyPixel(x, y+0.5)));
+                distortion = std::max(distortion, std::abs(dxp/dx - 1.0));
+                distortion = std::max(distortion, std::abs(dyp/dy - 1.0));
+            }
+            catch (GException::wcs_invalid_x_y& e) {
+                distortion = std::numeric_limits<double>::infinity();
+            }
+        }
+    }
+    if (!(distortion <= max_pixel_distortion)) {
+        std::string msg = "Sky map pixel size varies by "+
+                          gammalib::str(100.0*distortion)+"% over the map, "
+                          "which exceeds the "+
+                          gammalib::str(100.0*max_pixel_distortion)+"% "
+                          "that are allowed for a convolution with a single "
+                          "kernel.\n"
+                          "Please use a map that extends less far from the "
+                          "projection centre or to higher latitudes, or use "
+                          "a \"HPX\" projection.";
+        throw GException::invalid_value(G_CONVOLVE, msg);
+    }
+
+    // Determine kernel extent in pixels
+    int rx = (dx > 0.0) ? int(theta_max / dx) + 1 : m_num_x - 1;
+    int ry = (dy > 0.0) ? int(theta_max / dy) + 1 : m_num_y - 1;
+    if (rx > m_num_x - 1) {
+        rx = m_num_x - 1;
+    }
+    if (ry > m_num_y - 1) {
+        ry = m_num_y - 1;
+    }
+
+    // Plan Fourier transformations for zero padded maps
+    int  nx   = GFft::good_size(m_num_x + rx);
+    int  ny   = GFft::good_size(m_num_y + ry);
+    GFft fftx(nx);
+    GFft ffty(ny);
+
+    // Sample kernel at pixel offsets with respect to centre pixel. The
+    // kernel is averaged over the area of each pixel, so that kernels that
+    // are not much wider than a pixel keep their normalisation.
+    int                 nsub  = kernel_subsamples;
+    int                 nkx   = 2*rx + 1;
+    int                 nky   = 2*ry + 1;
+    int                 nsamp = nkx * nky * nsub * nsub;
+    std::vector<double> thetas(nsamp);
+    std::vector<double> values(nsamp);
+    for (int iy = 0, i = 0; iy < nky; ++iy) {
+        for (int ix = 0; ix < nkx; ++ix) {
+            for (int sy = 0; sy < nsub; ++sy) {
+                double y = double(jc+iy-ry) + (sy+0.5)/nsub - 0.5;
+                for (int sx = 0; sx < nsub; ++sx, ++i) {
+                    double x  = double(ic+ix-rx) + (sx+0.5)/nsub - 0.5;
+                    thetas[i] = centre.dist(pix2dir(GSkyPixel(x, y)));
+                }
+            }
+        }
+    }
+    kernel.eval(&thetas[0], &values[0], nsamp);
+
+    // Set kernel on zero padded grid, where negative offsets wrap around
+    // the grid
+    std::vector<std::complex<double> > kern((long long)nx * ny);
+    for (int iy = 0, i = 0; iy < nky; ++iy) {
+        for (int ix = 0; ix < nkx; ++ix) {
+            double value = 0.0;
+            for (int k = 0; k < nsub*nsub; ++k, ++i) {
+                if (thetas[i] <= theta_max) {
+                    value += values[i];
+                }
+            }
+            int kx = (rx - ix + nx) % nx;
+            int ky = (ry - iy + ny) % ny;
+            kern[(long long)ky * nx + kx] = value / double(nsub*nsub);
+        }
+    }
+
+    // Transform kernel
+    fft2d(&kern[0], fftx, ffty, true);
+
+    // Compute pixel solid angles
+    std::vector<double> omega(m_num_pixels);
+    for (long long i = 0; i < m_num_pixels; ++i) {
+        omega[i] = solidangle(i);
+    }
+
+    // Loop over maps
+    double                             norm = 1.0 / (double(nx) * double(ny));
+    std::vector<std::complex<double> > data((long long)nx * ny);
+    for (int k = map; k < map+nmaps; ++k) {
+
+        // Get pointer to map pixels
+        double* pixels = m_pixels + k * m_num_pixels;
+
+        // Fill zero padded map with pixel values times solid angle
+        std::fill(data.begin(), data.end(), std::complex<double>(0.0, 0.0));
+        for (int iy = 0, i = 0; iy < m_num_y; ++iy) {
+            for (int ix = 0; ix < m_num_x; ++ix, ++i) {
+                data[(long long)iy * nx + ix] = pixels[i] * omega[i];
+            }
+        }
+
+        // Convolve map with kernel
+        fft2d(&data[0], fftx, ffty, true);
+        long long ndata = data.size();
+        for (long long i = 0; i < ndata; ++i) {
+            data[i] *= kern[i];
+        }
+        fft2d(&data[0], fftx, ffty, false);
+
+        // Store convolved map
+        for (int iy = 0, i = 0; iy < m_num_y; ++iy) {
+            for (int ix = 0; ix < m_num_x; ++ix, ++i) {
+                pixels[i] = data[(long long)iy * nx + ix].real() * norm;
+            }
+        }
+
+    } // endfor: looped over maps
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                                 Friends                                 =
@@ -2283,7 +3581,7 @@ GSkymap sqrt(const GSkymap& map)
     for (int i = 0; i < map.nmaps(); ++i) {
 
         // Loop over all bins
-        for (int j = 0; j < map.npix(); ++j) {
+        for (long long j = 0; j < map.npix(); ++j) {
 
             // Get the content from the bin
             double content = map(j,i);
@@ -2305,3 +3603,66 @@ GSkymap sqrt(const GSkymap& map)
     // Return vector
     return result;
 }
+
+
+/*==========================================================================
+ =                                                                         =
+ =                              Local functions                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Two-dimensional Fast Fourier Transformation
+ *
+ * @param[in,out] data Array of fftx.size() * ffty.size() complex values.
+ * @param[in] fftx Fourier transformation of rows.
+ * @param[in] ffty Fourier transformation of columns.
+ * @param[in] forward Perform forward transformation?
+ *
+ * Transforms the row-major array @p data by first transforming all rows and
+ * then all columns. The backward transformation is not normalised.
+ ***************************************************************************/
+static void fft2d(std::complex<double>* data,
+                  const GFft&           fftx,
+                  const GFft&           ffty,
+                  const bool&           forward)
+{
+    // Get dimensions
+    int nx = fftx.size();
+    int ny = ffty.size();
+
+    // Transform rows
+    #pragma omp parallel for
+    for (int iy = 0; iy < ny; ++iy) {
+        if (forward) {
+            fftx.forward(data + (long long)iy * nx);
+        }
+        else {
+            fftx.backward(data + (long long)iy * nx);
+        }
+    }
+
+    // Transform columns
+    #pragma omp parallel
+    {
+        std::vector<std::complex<double> > column(ny);
+        #pragma omp for
+        for (int ix = 0; ix < nx; ++ix) {
+            for (int iy = 0; iy < ny; ++iy) {
+                column[iy] = data[(long long)iy * nx + ix];
+            }
+            if (forward) {
+                ffty.forward(&column[0]);
+            }
+            else {
+                ffty.backward(&column[0]);
+            }
+            for (int iy = 0; iy < ny; ++iy) {
+                data[(long long)iy * nx + ix] = column[iy];
+            }
+        }
+    }
+
+    // Return
+    return;
+}
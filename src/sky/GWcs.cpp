@@ -426,6 +426,30 @@ void GWcs::write(GFitsHDU& hdu) const
  *
  * @param[in] pixel Pixel index (x,y)
  *
+ * Computes the sky directions of the four pixel corners and returns the
+ * solid angle of the spherical polygon that is spanned by these corners.
+ ***************************************************************************/
+double GWcs::solidangle(const GSkyPixel& pixel) const
+{
+    // Get the sky directions of the 4 points
+    GSkyDir dir1 = pix2dir(GSkyPixel(pixel.x()-0.5, pixel.y()-0.5));
+    GSkyDir dir2 = pix2dir(GSkyPixel(pixel.x()+0.5, pixel.y()-0.5));
+    GSkyDir dir3 = pix2dir(GSkyPixel(pixel.x()+0.5, pixel.y()+0.5));
+    GSkyDir dir4 = pix2dir(GSkyPixel(pixel.x()-0.5, pixel.y()+0.5));
+
+    // Return solid angle
+    return (solidangle(dir1, dir2, dir3, dir4));
+}
+
+
+/***********************************************************************//**
+ * @brief Returns solid angle of pixel corners in units of steradians
+ *
+ * @param[in] dir1 Sky direction of first pixel corner.
+ * @param[in] dir2 Sky direction of second pixel corner.
+ * @param[in] dir3 Sky direction of third pixel corner.
+ * @param[in] dir4 Sky direction of fourth pixel corner.
+ *
  * Estimates solid angles of pixels using the Girard equation for excess
  * area - see: http://mathworld.wolfram.com/SphericalPolygon.html
  *
@@ -447,15 +471,13 @@ void GWcs::write(GFitsHDU& hdu) const
  *         4---------3
  *             a34
  *
+ * The corners are expected in the order (x-0.5,y-0.5), (x+0.5,y-0.5),
+ * (x+0.5,y+0.5) and (x-0.5,y+0.5), which allows computing the solid angles
+ * of many pixels from a single grid of corner directions.
  ***************************************************************************/
-double GWcs::solidangle(const GSkyPixel& pixel) const
+double GWcs::solidangle(const GSkyDir& dir1, const GSkyDir& dir2,
+                        const GSkyDir& dir3, const GSkyDir& dir4) const
 {
-    // Get the sky directions of the 4 points
-    GSkyDir dir1 = pix2dir(GSkyPixel(pixel.x()-0.5, pixel.y()-0.5));
-    GSkyDir dir2 = pix2dir(GSkyPixel(pixel.x()+0.5, pixel.y()-0.5));
-    GSkyDir dir3 = pix2dir(GSkyPixel(pixel.x()+0.5, pixel.y()+0.5));
-    GSkyDir dir4 = pix2dir(GSkyPixel(pixel.x()-0.5, pixel.y()+0.5));
-
     // Compile option 1: Use triginometric function
     #if G_SOLIDANGLE_OPTION == 1
 
@@ -739,6 +761,115 @@ GSkyPixel GWcs::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of an array of sky map pixels
+ *
+ * @param[in] x Array [n] of pixel x coordinates.
+ * @param[in] y Array [n] of pixel y coordinates.
+ * @param[out] lon Array [n] of longitudes in the projection's coordinate
+ *                 system (deg).
+ * @param[out] lat Array [n] of latitudes in the projection's coordinate
+ *                 system (deg).
+ * @param[in] n Number of pixels.
+ *
+ * Converts @p n sky map pixels into sky coordinates using a single call of
+ * the pixel-to-world transformation, so that the linear transformation,
+ * the deprojection and the spherical rotation each run as one loop over
+ * all pixels. As for the single pixel method, the sky map pixel values
+ * start from 0 while the WCS pixel reference starts from 1.
+ ***************************************************************************/
+void GWcs::pix2dir(const double* x, const double* y,
+                   double* lon, double* lat, const int& n) const
+{
+    // Continue only if there are pixels
+    if (n > 0) {
+
+        // Allocate memory for transformation
+        std::vector<double> pixcrd(2*n);
+        std::vector<double> imgcrd(2*n);
+        std::vector<double> phi(n);
+        std::vector<double> theta(n);
+        std::vector<double> world(2*n);
+        std::vector<int>    stat(n);
+
+        // Set sky pixels. We have to add 1.0 here as the WCS pixel
+        // reference (CRPIX) starts from one while GSkyPixel starts from 0.
+        for (int i = 0, k = 0; i < n; ++i, k += 2) {
+            pixcrd[k]   = x[i] + 1.0;
+            pixcrd[k+1] = y[i] + 1.0;
+        }
+
+        // Transform pixel-to-world coordinates
+        wcs_p2s(n, 2, &pixcrd[0], &imgcrd[0], &phi[0], &theta[0],
+                &world[0], &stat[0]);
+
+        // Extract sky coordinates
+        for (int i = 0, k = 0; i < n; ++i, k += 2) {
+            lon[i] = world[k];
+            lat[i] = world[k+1];
+        }
+
+    } // endif: there were pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns sky map pixels of an array of sky coordinates
+ *
+ * @param[in] lon Array [n] of longitudes in the projection's coordinate
+ *                system (deg).
+ * @param[in] lat Array [n] of latitudes in the projection's coordinate
+ *                system (deg).
+ * @param[out] x Array [n] of pixel x coordinates.
+ * @param[out] y Array [n] of pixel y coordinates.
+ * @param[in] n Number of sky coordinates.
+ *
+ * Converts @p n sky coordinates into sky map pixels using a single call of
+ * the world-to-pixel transformation. As for the single direction method,
+ * the sky map pixel values start from 0 while the WCS pixel reference
+ * starts from 1.
+ ***************************************************************************/
+void GWcs::dir2pix(const double* lon, const double* lat,
+                   double* x, double* y, const int& n) const
+{
+    // Continue only if there are sky coordinates
+    if (n > 0) {
+
+        // Allocate memory for transformation
+        std::vector<double> world(2*n);
+        std::vector<double> phi(n);
+        std::vector<double> theta(n);
+        std::vector<double> imgcrd(2*n);
+        std::vector<double> pixcrd(2*n);
+        std::vector<int>    stat(n);
+
+        // Set world coordinates
+        for (int i = 0, k = 0; i < n; ++i, k += 2) {
+            world[k]   = lon[i];
+            world[k+1] = lat[i];
+        }
+
+        // Transform world-to-pixel coordinates
+        wcs_s2p(n, 2, &world[0], &phi[0], &theta[0], &imgcrd[0],
+                &pixcrd[0], &stat[0]);
+
+        // Extract sky map pixels. We have to subtract 1 here as GSkyPixel
+        // starts from zero while the WCS reference (CRPIX) starts from one.
+        for (int i = 0, k = 0; i < n; ++i, k += 2) {
+            x[i] = pixcrd[k]   - 1.0;
+            y[i] = pixcrd[k+1] - 1.0;
+        }
+
+    } // endif: there were sky coordinates
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set World Coordinate System parameters
  *
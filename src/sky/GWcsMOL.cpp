@@ -505,7 +505,7 @@ void GWcsMOL::prj_x2s(int nx, int ny, int sxy, int spt,
         double t = std::asin(z) * gammalib::rad2deg;
 
         // Do ...
-        for (int ix = 0; ix < mx; ++ix, phip += spt, thetap += spt, statp += spt) {
+        for (int ix = 0; ix < mx; ++ix, phip += spt, thetap += spt, ++statp) {
 
             // Set status flag
             if (istat < 0 && *thetap >= 0.0) {
@@ -651,7 +651,7 @@ void GWcsMOL::prj_s2x(int nphi, int ntheta, int spt, int sxy,
         eta -= m_y0;
 
         // Do ...
-        for (int iphi = 0; iphi < mphi; ++iphi, xp += sxy, yp += sxy, statp += sxy) {
+        for (int iphi = 0; iphi < mphi; ++iphi, xp += sxy, yp += sxy, ++statp) {
             *xp    = xi * (*xp) - m_x0;
             *yp    = eta;
             *statp = 0;
@@ -130,6 +130,47 @@ GException::out_of_range::out_of_range(const std::string& origin,
 }
 
 
+/***********************************************************************//**
+ * @brief 64-bit index is out of range [0,elements-1]
+ *
+ * @param[in] origin Method throwing the exception.
+ * @param[in] what Describes what is out of range.
+ * @param[in] index Index.
+ * @param[in] elements Number of elements.
+ * @param[in] message Optional error message.
+ *
+ * Variant for indices that may exceed the range of a 32-bit integer, such
+ * as pixel indices of large sky maps.
+ ***************************************************************************/
+GException::out_of_range::out_of_range(const std::string& origin,
+                                       const std::string& what,
+                                       const long long&   index,
+                                       const long long&   elements,
+                                       const std::string& message)
+{
+    // Set origin
+    m_origin = origin;
+
+    // Set message
+    if (elements > 0) {
+        m_message = gammalib::strip_whitespace(what) + " " +
+                    gammalib::str(index) + " is outside the"
+                    " valid range [0," + gammalib::str(elements-1) + "].";
+    }
+    else {
+        m_message = "Invalid access to empty object with " +
+                    gammalib::tolower(gammalib::strip_whitespace(what)) +
+                    " " + gammalib::str(index) + ".";
+    }
+    if (message.length() > 0) {
+        m_message += (" " + message);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Runtime error
  *
@@ -44,6 +44,7 @@
 #define G_REMOVE                                   "GNodeArray::remove(int&)"
 #define G_INTERPOLATE                      "GNodeArray::interpolate(double&,"\
                                                      " std::vector<double>&)"
+#define G_INTERPOLATE_WGT                  "GNodeArray::interpolate(double&)"
 #define G_SET_VALUE                          "GNodeArray::set_value(double&)"
 
 /* __ Macros _____________________________________________________________ */
@@ -525,12 +526,12 @@ double GNodeArray::interpolate(const double& value,
                                           vector.size());
     }
     
-    // Set interpolation value (circumvent const correctness)
-    set_value(value);
+    // Get interpolation indices and weighting factors
+    interpolation wgt = interpolate(value);
 
     // Interpolate
-    double y = vector[inx_left()]  * wgt_left() +
-               vector[inx_right()] * wgt_right();
+    double y = vector[wgt.inx_left]  * wgt.wgt_left +
+               vector[wgt.inx_right] * wgt.wgt_right;
 
     // Return
     return y;
@@ -538,36 +539,145 @@ double GNodeArray::interpolate(const double& value,
 
 
 /***********************************************************************//**
- * @brief Set indices and weighting factors for interpolation
+ * @brief Return indices and weighting factors for interpolation
  *
  * @param[in] value Value for which the interpolation should be done.
+ * @return Indices and weighting factors for interpolation.
  *
  * @exception GException::invalid_value
  *            No nodes are available for interpolation.
  *
- * Set the indices that bound the specified value and the corresponding
+ * Returns the indices that bound the specified value and the corresponding
  * weighting factors for linear interpolation. If the array has a linear
  * form (i.e. the nodes are equidistant), an analytic formula is used to
  * determine the boundary indices. If the nodes are not equidistant the
  * boundary indices are searched by bisection. If there is only a single
  * node, no interpolation is done and the index of this node is returned.
  *
- * Note that this method needs to be called after changing the node array
- * to setup the corrected interpolation indices and weights.
+ * Contrary to set_value(), this method does not modify the node array and
+ * can therefore be called concurrently by several threads. If the nodes
+ * have been modified through the non-const access operators and the
+ * precomputed node distances are not up to date, the indices are searched
+ * by bisection.
  ***************************************************************************/
-void GNodeArray::set_value(const double& value) const
+GNodeArray::interpolation GNodeArray::interpolate(const double& value) const
 {
     // Get number of nodes
     int nodes = m_node.size();
 
-    /*
-    // Throw an exception if less than 2 nodes are available
-    if (nodes < 2) {
-        throw GException::not_enough_nodes(G_SET_VALUE, nodes);
-    }
-    */
     // Throw an exception if there are no nodes
     if (nodes < 1) {
+        std::string msg = "Attempting to interpolate without having any "
+                          "nodes. Interpolation can only be done if nodes "
+                          "are available.";
+        throw GException::invalid_value(G_INTERPOLATE_WGT, msg);
+    }
+
+    // Allocate result
+    interpolation result;
+
+    // Handle special case of a single node
+    if (nodes == 1) {
+        result.inx_left  = 0;
+        result.inx_right = 0;
+        result.wgt_left  = 1.0;
+        result.wgt_right = 0.0;
+    }
+
+    // Handle all other cases
+    else {
+
+        // Initialise left index
+        int inx_left = 0;
+
+        // If array is linear then get left index from analytic formula
+        if (m_is_linear && !m_need_setup) {
+
+            // Set left index
+            inx_left = int(m_linear_slope * value + m_linear_offset);
+
+            // Keep index in valid range
+            if (inx_left < 0) {
+                inx_left = 0;
+            }
+            else if (inx_left >= nodes-1) {
+                inx_left = nodes - 2;
+            }
+
+        } // endif: array is linear
+
+        // ... otherwise search the relevant indices by bisection
+        else {
+
+            // Set left index if value is before first node
+            if (value < m_node[0]) {
+                inx_left = 0;
+            }
+
+            // Set left index if value is after last node
+            else if (value >  m_node[nodes-1]) {
+                inx_left = nodes - 2;
+            }
+
+            // Set left index by bisection
+            else {
+                int low  = 0;
+                int high = nodes - 1;
+                while ((high - low) > 1) {
+                    int mid = (low+high) / 2;
+                    if (m_node[mid] > value) {
+                        high = mid;
+                    }
+                    else {
+                        low = mid;
+                    }
+                }
+                inx_left = low;
+            } // endelse: did bisection
+        }
+
+        // Set indices
+        result.inx_left  = inx_left;
+        result.inx_right = inx_left + 1;
+
+        // Get distance to next node
+        double step = (m_need_setup) ? m_node[inx_left+1] - m_node[inx_left]
+                                     : m_step[inx_left];
+
+        // Set weighting factors
+        result.wgt_right = (value - m_node[inx_left]) / step;
+        result.wgt_left  = 1.0 - result.wgt_right;
+
+    } // endelse: more than one node was present
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Set indices and weighting factors for interpolation
+ *
+ * @param[in] value Value for which the interpolation should be done.
+ *
+ * @exception GException::invalid_value
+ *            No nodes are available for interpolation.
+ *
+ * Set the indices that bound the specified value and the corresponding
+ * weighting factors for linear interpolation. The indices and weighting
+ * factors are computed using interpolate(const double&) and are stored
+ * in the node array, from which they can be recovered using inx_left(),
+ * inx_right(), wgt_left() and wgt_right(). As the method modifies the
+ * node array, it should not be used on node arrays that are shared
+ * between threads.
+ *
+ * Note that this method needs to be called after changing the node array
+ * to setup the corrected interpolation indices and weights.
+ ***************************************************************************/
+void GNodeArray::set_value(const double& value) const
+{
+    // Throw an exception if there are no nodes
+    if (m_node.size() < 1) {
         std::string msg = "Attempting to set interpolating value without "
                           "having any nodes. Interpolation can only be "
                           "done if nodes are available.";
@@ -592,71 +702,14 @@ void GNodeArray::set_value(const double& value) const
     // Continue only if computation is required
     if (compute) {
 
-        // Handle special case of a single node
-        if (nodes == 1) {
-            m_inx_left  = 0;
-            m_inx_right = 0;
-            m_wgt_left  = 1.0;
-            m_wgt_right = 0.0;
-        }
-
-        // Handle all other cases
-        else {
-
-            // If array is linear then get left index from analytic formula
-            if (m_is_linear) {
-
-                // Set left index
-                m_inx_left = int(m_linear_slope * value + m_linear_offset);
-        
-                // Keep index in valid range
-                if (m_inx_left < 0) {
-                    m_inx_left = 0;
-                }
-                else if (m_inx_left >= nodes-1) {
-                    m_inx_left = nodes - 2;
-                }
-
-            } // endif: array is linear
-
-            // ... otherwise search the relevant indices by bisection
-            else {
-    
-                // Set left index if value is before first node
-                if (value < m_node[0]) {
-                    m_inx_left = 0;
-                }
-
-                // Set left index if value is after last node
-                else if (value >  m_node[nodes-1]) {
-                    m_inx_left = nodes - 2;
-                }
-
-                // Set left index by bisection
-                else {
-                    int low  = 0;
-                    int high = nodes - 1;
-                    while ((high - low) > 1) {
-                        int mid = (low+high) / 2;
-                        if (m_node[mid] > value) {
-                            high = mid;
-                        }
-                        else {
-                            low = mid;
-                        }
-                    }
-                    m_inx_left = low;
-                } // endelse: did bisection
-            }
-
-            // Set right index
-            m_inx_right = m_inx_left + 1;
-
-            // Set weighting factors
-            m_wgt_right = (value - m_node[m_inx_left]) / m_step[m_inx_left];
-            m_wgt_left  = 1.0 - m_wgt_right;
+        // Get indices and weighting factors
+        interpolation wgt = interpolate(value);
 
-        } // endelse: more than one node was present
+        // Store indices and weighting factors
+        m_inx_left  = wgt.inx_left;
+        m_inx_right = wgt.inx_right;
+        m_wgt_left  = wgt.wgt_left;
+        m_wgt_right = wgt.wgt_right;
 
     } // endif: computation was required
 
@@ -44,6 +44,9 @@
 
 /* __ Constants __________________________________________________________ */
 
+/* __ Prototypes of local functions ______________________________________ */
+static unsigned long long int ran_mix64(unsigned long long int x);
+
 
 /*==========================================================================
  =                                                                         =
@@ -200,6 +203,35 @@ void GRan::seed(unsigned long long int seed)
 }
 
 
+/***********************************************************************//**
+ * @brief Return random number generator for a substream
+ *
+ * @param[in] index Substream index.
+ * @return Random number generator for substream @p index.
+ *
+ * Returns a random number generator whose seed is derived from the seed of
+ * this generator and the substream @p index by a 64-bit mixing function.
+ * The substream depends neither on the numbers that have already been drawn
+ * from this generator nor on the order in which substreams are requested,
+ * hence parallel computations that assign one substream to each unit of
+ * work (e.g. a thread chunk, a source or a time slice) give bit-identical
+ * results independently of the number of threads. Substreams may be
+ * nested, e.g. ran.substream(source).substream(slice).
+ ***************************************************************************/
+GRan GRan::substream(const unsigned long long int& index) const
+{
+    // Derive the substream seed from the seed and the index. The index is
+    // offset by the golden ratio increment so that index 0 does not
+    // reproduce the parent generator.
+    unsigned long long int seed = ran_mix64(ran_mix64(m_seed) +
+                                            (index + 1) *
+                                            11400714819323198485ULL);
+
+    // Return random number generator for substream
+    return (GRan(seed));
+}
+
+
 /***********************************************************************//**
  * @brief Return 32-bit random unsigned integer
  ***************************************************************************/
@@ -535,3 +567,33 @@ void GRan::free_members(void)
     // Return
     return;
 }
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Local functions                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Mix 64-bit integer
+ *
+ * @param[in] x 64-bit integer.
+ * @return Mixed 64-bit integer.
+ *
+ * Bijective 64-bit mixing function taken from the finaliser of the
+ * SplitMix64 generator. Each input bit affects each output bit with a
+ * probability close to one half.
+ ***************************************************************************/
+static unsigned long long int ran_mix64(unsigned long long int x)
+{
+    // Mix bits
+    x ^= x >> 30;
+    x *= 13787848793156543929ULL;
+    x ^= x >> 27;
+    x *= 10723151780598845931ULL;
+    x ^= x >> 31;
+
+    // Return
+    return x;
+}
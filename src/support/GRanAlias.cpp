@@ -0,0 +1,459 @@
+/***************************************************************************
+ *           GRanAlias.cpp - Alias table random sampler class              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2026 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GRanAlias.cpp
+ * @brief Alias table random sampler class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "GRanAlias.hpp"
+#include "GTools.hpp"
+#include "GException.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_SET                          "GRanAlias::set(std::vector<double>&)"
+#define G_DRAW                                     "GRanAlias::draw(GRan&)"
+#define G_DRAWS                              "GRanAlias::draw(GRan&, int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Constants __________________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GRanAlias::GRanAlias(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Weights constructor
+ *
+ * @param[in] weights Array of non-negative weights.
+ *
+ * Constructs the alias table from an array of weights. See the set()
+ * method for details.
+ ***************************************************************************/
+GRanAlias::GRanAlias(const std::vector<double>& weights)
+{
+    // Initialise members
+    init_members();
+
+    // Build alias table
+    set(weights);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] alias Alias table random sampler.
+ ***************************************************************************/
+GRanAlias::GRanAlias(const GRanAlias& alias)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(alias);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GRanAlias::~GRanAlias(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] alias Alias table random sampler.
+ * @return Alias table random sampler.
+ ***************************************************************************/
+GRanAlias& GRanAlias::operator=(const GRanAlias& alias)
+{
+    // Execute only if object is not identical
+    if (this != &alias) {
+
+        // Free members
+        free_members();
+
+        // Initialise members
+        init_members();
+
+        // Copy members
+        copy_members(alias);
+
+    } // endif: object was not identical
+
+    // Return
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear alias table random sampler
+ ***************************************************************************/
+void GRanAlias::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone alias table random sampler
+ *
+ * @return Pointer to deep copy of alias table random sampler.
+ ***************************************************************************/
+GRanAlias* GRanAlias::clone(void) const
+{
+    return new GRanAlias(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Build alias table from weights
+ *
+ * @param[in] weights Array of non-negative weights.
+ *
+ * @exception GException::invalid_argument
+ *            Negative or non-finite weight encountered.
+ *
+ * Builds the alias table using Vose's algorithm. The weights do not need
+ * to be normalised. Indices with zero weight are never drawn. The
+ * construction takes a time proportional to the number of weights.
+ ***************************************************************************/
+void GRanAlias::set(const std::vector<double>& weights)
+{
+    // Clear any existing table
+    clear();
+
+    // Determine number of weights
+    int n = weights.size();
+
+    // Check weights and compute their sum
+    for (int i = 0; i < n; ++i) {
+        double weight = weights[i];
+        if (weight < 0.0 ||
+            gammalib::is_notanumber(weight) ||
+            gammalib::is_infinite(weight)) {
+            std::string msg = "Weight "+gammalib::str(weight)+" at index "+
+                              gammalib::str(i)+" is not a non-negative"
+                              " finite number.\n"
+                              "Please specify only non-negative finite"
+                              " weights.";
+            throw GException::invalid_argument(G_SET, msg);
+        }
+        m_total += weight;
+    }
+
+    // Continue only if there are weights
+    if (n > 0) {
+
+        // Allocate table
+        m_prob.assign(n, 1.0);
+        m_alias.resize(n);
+        for (int i = 0; i < n; ++i) {
+            m_alias[i] = i;
+        }
+
+        // Continue only if the weights are not all zero
+        if (m_total > 0.0) {
+
+            // Compute probabilities scaled so that their mean is one and
+            // split indices into those below and above the mean
+            double              scale = double(n) / m_total;
+            std::vector<double> scaled(n);
+            std::vector<int>    small;
+            std::vector<int>    large;
+            small.reserve(n);
+            large.reserve(n);
+            for (int i = 0; i < n; ++i) {
+                scaled[i] = weights[i] * scale;
+                if (scaled[i] < 1.0) {
+                    small.push_back(i);
+                }
+                else {
+                    large.push_back(i);
+                }
+            }
+
+            // Pair each index below the mean with an index above the mean
+            // that fills up the remaining probability
+            while (!small.empty() && !large.empty()) {
+                int s = small.back();
+                int l = large.back();
+                small.pop_back();
+                large.pop_back();
+                m_prob[s]  = scaled[s];
+                m_alias[s] = l;
+                scaled[l]  = (scaled[l] + scaled[s]) - 1.0;
+                if (scaled[l] < 1.0) {
+                    small.push_back(l);
+                }
+                else {
+                    large.push_back(l);
+                }
+            }
+
+            // The remaining indices have a probability of one within
+            // rounding errors. Zero weights are redirected to the first
+            // positive weight to make sure that they are never drawn.
+            int positive = 0;
+            while (weights[positive] <= 0.0) {
+                ++positive;
+            }
+            int nlarge = large.size();
+            int nsmall = small.size();
+            for (int k = 0; k < nlarge; ++k) {
+                m_prob[large[k]] = 1.0;
+            }
+            for (int k = 0; k < nsmall; ++k) {
+                if (weights[small[k]] > 0.0) {
+                    m_prob[small[k]] = 1.0;
+                }
+                else {
+                    m_prob[small[k]]  = 0.0;
+                    m_alias[small[k]] = positive;
+                }
+            }
+
+        } // endif: weights were not all zero
+
+    } // endif: there were weights
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Draw random index
+ *
+ * @param[in,out] ran Random number generator.
+ * @return Random index [0,...,size()-1].
+ *
+ * @exception GException::invalid_value
+ *            Alias table is empty or all weights are zero.
+ *
+ * Draws a random index with a probability proportional to its weight. The
+ * method consumes exactly one uniform random number: its integer part
+ * after scaling by the number of weights selects the table column, the
+ * fractional part decides between the column index and its alias.
+ ***************************************************************************/
+int GRanAlias::draw(GRan& ran) const
+{
+    // Throw an exception if there is nothing to draw from
+    if (m_total <= 0.0) {
+        std::string msg = "Alias table has no positive weights.\n"
+                          "Please build the table from weights with a"
+                          " positive sum before drawing.";
+        throw GException::invalid_value(G_DRAW, msg);
+    }
+
+    // Split uniform random number into column and fraction
+    int    n     = m_prob.size();
+    double u     = ran.uniform() * n;
+    int    index = int(u);
+    if (index >= n) {
+        index = n - 1;
+    }
+
+    // Return index or its alias
+    return ((u - index < m_prob[index]) ? index : m_alias[index]);
+}
+
+
+/***********************************************************************//**
+ * @brief Draw array of random indices
+ *
+ * @param[in,out] ran Random number generator.
+ * @param[in] number Number of indices to draw.
+ * @return Array of @p number random indices.
+ *
+ * @exception GException::invalid_value
+ *            Alias table is empty or all weights are zero.
+ *
+ * Draws @p number random indices in a single call. The result is identical
+ * to calling draw(GRan&) @p number times.
+ ***************************************************************************/
+std::vector<int> GRanAlias::draw(GRan& ran, const int& number) const
+{
+    // Throw an exception if there is nothing to draw from
+    if (m_total <= 0.0 && number > 0) {
+        std::string msg = "Alias table has no positive weights.\n"
+                          "Please build the table from weights with a"
+                          " positive sum before drawing.";
+        throw GException::invalid_value(G_DRAWS, msg);
+    }
+
+    // Allocate result
+    std::vector<int> indices(number > 0 ? number : 0);
+
+    // Draw indices
+    int           n     = m_prob.size();
+    double        dn    = double(n);
+    const double* prob  = (n > 0) ? &m_prob[0]  : NULL;
+    const int*    alias = (n > 0) ? &m_alias[0] : NULL;
+    for (int i = 0; i < number; ++i) {
+        double u     = ran.uniform() * dn;
+        int    index = int(u);
+        if (index >= n) {
+            index = n - 1;
+        }
+        indices[i] = (u - index < prob[index]) ? index : alias[index];
+    }
+
+    // Return indices
+    return indices;
+}
+
+
+/***********************************************************************//**
+ * @brief Print alias table random sampler information
+ *
+ * @param[in] chatter Chattiness (defaults to NORMAL).
+ * @return String containing alias table random sampler information.
+ ***************************************************************************/
+std::string GRanAlias::print(const GChatter& chatter) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Continue only if chatter is not silent
+    if (chatter != SILENT) {
+
+        // Append header
+        result.append("=== GRanAlias ===");
+
+        // Append information
+        result.append("\n"+gammalib::parformat("Number of weights"));
+        result.append(gammalib::str(size()));
+        result.append("\n"+gammalib::parformat("Sum of weights"));
+        result.append(gammalib::str(m_total));
+
+    } // endif: chatter was not silent
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                            Private methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GRanAlias::init_members(void)
+{
+    // Initialise members
+    m_prob.clear();
+    m_alias.clear();
+    m_total = 0.0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] alias Alias table random sampler.
+ ***************************************************************************/
+void GRanAlias::copy_members(const GRanAlias& alias)
+{
+    // Copy members
+    m_prob  = alias.m_prob;
+    m_alias = alias.m_alias;
+    m_total = alias.m_total;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GRanAlias::free_members(void)
+{
+    // Return
+    return;
+}
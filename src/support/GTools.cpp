@@ -38,6 +38,7 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <map>
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GFits.hpp"
@@ -50,6 +51,10 @@
 /* __ Coding definitions _________________________________________________ */
 #define G_PARFORMAT_LENGTH 29
 
+/* __ Prototypes of local functions ______________________________________ */
+static std::map<std::string,int>& intern_registry(void);
+static std::vector<std::string>&  intern_strings(void);
+
 
 /***********************************************************************//**
  * @brief Strip leading and trailing whitespace from string
@@ -1399,3 +1404,103 @@ void gammalib::xml_check_par(const std::string& origin,
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Return identifier of interned string
+ *
+ * @param[in] arg String.
+ * @return Unique identifier of string.
+ *
+ * Returns a unique non-negative integer identifier for a string. The
+ * identifier is assigned when the string is interned for the first time
+ * and remains valid for the lifetime of the process, hence identical
+ * strings always map to the same identifier. Identifiers allow to replace
+ * string comparisons, for example of model names, by integer comparisons.
+ *
+ * The function is thread safe.
+ ***************************************************************************/
+int gammalib::intern(const std::string& arg)
+{
+    // Initialise identifier
+    int id = -1;
+
+    // Intern string. The registry is allocated on first use so that
+    // strings may also be interned during static initialisation.
+    #pragma omp critical(gammalib_intern)
+    {
+        std::map<std::string,int>& ids = intern_registry();
+        std::map<std::string,int>::const_iterator it = ids.find(arg);
+        if (it != ids.end()) {
+            id = it->second;
+        }
+        else {
+            id = ids.size();
+            ids.insert(std::make_pair(arg, id));
+            intern_strings().push_back(arg);
+        }
+    }
+
+    // Return identifier
+    return id;
+}
+
+
+/***********************************************************************//**
+ * @brief Return interned string
+ *
+ * @param[in] id String identifier.
+ * @return Interned string (empty if identifier is unknown).
+ *
+ * Returns the string that corresponds to an identifier that was returned
+ * by gammalib::intern().
+ *
+ * The function is thread safe.
+ ***************************************************************************/
+std::string gammalib::interned(const int& id)
+{
+    // Initialise string
+    std::string result;
+
+    // Get string
+    #pragma omp critical(gammalib_intern)
+    {
+        const std::vector<std::string>& strings = intern_strings();
+        if (id >= 0 && id < int(strings.size())) {
+            result = strings[id];
+        }
+    }
+
+    // Return string
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                              Local functions                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Return registry of interned strings
+ *
+ * @return Map of interned strings and their identifiers.
+ ***************************************************************************/
+static std::map<std::string,int>& intern_registry(void)
+{
+    static std::map<std::string,int> registry;
+    return registry;
+}
+
+
+/***********************************************************************//**
+ * @brief Return list of interned strings
+ *
+ * @return Vector of interned strings, indexed by identifier.
+ ***************************************************************************/
+static std::vector<std::string>& intern_strings(void)
+{
+    static std::vector<std::string> strings;
+    return strings;
+}
@@ -391,6 +391,7 @@ void TestGFits::set(void)
     append(static_cast<pfunction>(&TestGFits::test_bintable_ulong), "Test bintable ulong");
     append(static_cast<pfunction>(&TestGFits::test_bintable_long), "Test bintable long");
     append(static_cast<pfunction>(&TestGFits::test_bintable_longlong), "Test bintable longlong");
+    append(static_cast<pfunction>(&TestGFits::test_mmap), "Test memory mapped reading");
 
     // Return
     return;
@@ -1182,6 +1183,29 @@ void TestGFits::test_bintable_double(void)
     catch(std::exception &e) {
         test_try_failure(e);
     }
+
+    // Read row range of vector column directly from file
+    test_try("Read rows from file");
+    try {
+        GFits                fits(filename);
+        const GFitsTableCol* col = (*fits.table(1))["DOUBLE10"];
+        std::vector<double>  values;
+        col->read_rows(1, 2, values);
+        test_assert(int(values.size()) == 2*nvec, "Check number of values");
+        for (int i = 1; i < nrows; ++i) {
+            for (int j = 0; j < nvec; ++j) {
+                double val = double(i)*2.3 + double(j)*11.7 + 0.95;
+                test_value(values[(i-1)*nvec+j], val, 1e-10,
+                           "Check value of row "+gammalib::str(i)+
+                           " and element "+gammalib::str(j));
+            }
+        }
+        fits.close();
+        test_try_success();
+    }
+    catch(std::exception &e) {
+        test_try_failure(e);
+    }
     
     // Test single column table
     TEST_TABLE1;
@@ -1441,6 +1465,29 @@ void TestGFits::test_bintable_longlong(void)
     GFitsTableLongLongCol col3("LONGLONGVAR", nrows, -1);
     TEST_VARTABLE_INT;
 
+    // Test reading of row ranges without loss of precision
+    test_try("Read rows");
+    try {
+        GFitsTableLongLongCol col4("LONGLONGID", nrows);
+        for (int i = 0; i < nrows; ++i) {
+            col4(i) = 9007199254740993LL + i; // 2^53 + 1 + i
+        }
+        std::vector<unsigned long> ids;
+        col4.read_rows(1, 2, ids);
+        test_assert(ids.size() == 2, "Check number of values");
+        test_assert(ids[0] == 9007199254740994UL &&
+                    ids[1] == 9007199254740995UL,
+                    "Check that 64-bit values are read without loss of "
+                    "precision");
+        std::vector<double> values;
+        col4.read_rows(0, nrows, values);
+        test_assert(int(values.size()) == nrows, "Check number of double values");
+        test_try_success();
+    }
+    catch(std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Write tables
     TEST_WRITE_TABLES;
 
@@ -1689,6 +1736,191 @@ void TestGFits::test_bintable_bit(void)
 }
 
 
+/***************************************************************************
+ * @brief Test reading of FITS files through memory mappings
+ *
+ * Writes a FITS file with byte-swapped, scaled and variable-length binary
+ * table columns and with byte-swapped and scaled images, and reads it back
+ * using cfitsio and using memory mappings. Both readers need to give the
+ * values that were written.
+ ***************************************************************************/
+void TestGFits::test_mmap(void)
+{
+    // Set filename
+    std::string filename = "test_mmap.fits";
+    remove(filename.c_str());
+
+    // Set number of rows and vector columns
+    int nrows = 5;
+    int nvec  = 3;
+
+    // Create columns
+    GFitsTableShortCol    col_short("SHORT", nrows);
+    GFitsTableLongCol     col_long("LONG", nrows);
+    GFitsTableLongLongCol col_longlong("LONGLONG", nrows);
+    GFitsTableFloatCol    col_float("FLOAT", nrows, nvec);
+    GFitsTableDoubleCol   col_double("DOUBLE", nrows, nvec);
+    GFitsTableUShortCol   col_ushort("USHORT", nrows);
+    GFitsTableULongCol    col_ulong("ULONG", nrows);
+    GFitsTableDoubleCol   col_scaled("SCALED", nrows);
+    GFitsTableDoubleCol   col_var("VARIABLE", nrows, -1);
+    for (int i = 0; i < nrows; ++i) {
+        col_short(i)    = short(1000*i - 2000);
+        col_long(i)     = 100000*i - 250000;
+        col_longlong(i) = 10000000000LL*i - 1;
+        col_ushort(i)   = (unsigned short)(60000 + i);
+        col_ulong(i)    = 4000000000UL + i;
+        col_scaled(i)   = double(i);
+        for (int j = 0; j < nvec; ++j) {
+            col_float(i,j)  = float(1.5*i + 0.25*j - 3.0);
+            col_double(i,j) = double(i)*2.3 + double(j)*11.7 + 0.95;
+        }
+        col_var.elements(i,i+1);
+        for (int j = 0; j < i+1; ++j) {
+            col_var(i,j) = double(i)*0.5 - double(j);
+        }
+    }
+
+    // Create table. The "SCALED" column is the eighth column.
+    GFitsBinTable table(nrows);
+    table.append(col_short);
+    table.append(col_long);
+    table.append(col_longlong);
+    table.append(col_float);
+    table.append(col_double);
+    table.append(col_ushort);
+    table.append(col_ulong);
+    table.append(col_scaled);
+    table.append(col_var);
+    table.card("TSCAL8", 2.0, "Column scale");
+    table.card("TZERO8", 1.0, "Column offset");
+
+    // Create images
+    short          pix_short[16];
+    double         pix_double[16];
+    unsigned short pix_ushort[16];
+    for (int i = 0; i < 16; ++i) {
+        pix_short[i]  = short(500*i - 4000);
+        pix_double[i] = 0.1 * double(i) - 0.7;
+        pix_ushort[i] = (unsigned short)(65000 + i);
+    }
+    GFitsImageShort  img_short(4, 4, pix_short);
+    GFitsImageDouble img_double(4, 4, pix_double);
+    GFitsImageUShort img_ushort(4, 4, pix_ushort);
+
+    // Save FITS file
+    test_try("Write FITS file");
+    try {
+        GFits fits(filename, true);
+        fits.append(img_short);
+        fits.append(img_double);
+        fits.append(img_ushort);
+        fits.append(table);
+        fits.save();
+        fits.close();
+        test_try_success();
+    }
+    catch(std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Read FITS file using cfitsio and using memory mappings. The values
+    // of the scaled column are compared between both readers.
+    std::vector<double> scaled[2];
+    for (int mode = 0; mode < 2; ++mode) {
+
+        // Set reader
+        gammalib::fits_mmap(mode == 1);
+        std::string reader = (mode == 1) ? " using memory mapping"
+                                         : " using cfitsio";
+
+        // Read FITS file
+        test_try("Read FITS file"+reader);
+        try {
+
+            // Open FITS file
+            GFits fits(filename);
+            const GFitsTable& tab = *fits.table(3);
+
+            // Read row range of vector column before the column is loaded
+            std::vector<double> values;
+            tab["DOUBLE"]->read_rows(1, 3, values);
+            test_assert(int(values.size()) == 3*nvec,
+                        "Check number of values of row range"+reader);
+            for (int i = 1; i < 4; ++i) {
+                for (int j = 0; j < nvec; ++j) {
+                    double val = double(i)*2.3 + double(j)*11.7 + 0.95;
+                    test_value(values[(i-1)*nvec+j], val, 1.0e-10,
+                               "Check row range of DOUBLE"+reader);
+                }
+            }
+
+            // Check columns
+            for (int i = 0; i < nrows; ++i) {
+                test_value(tab["SHORT"]->real(i), 1000.0*i - 2000.0,
+                           1.0e-10, "Check SHORT"+reader);
+                test_value(tab["LONG"]->real(i), 100000.0*i - 250000.0,
+                           1.0e-10, "Check LONG"+reader);
+                test_value(tab["LONGLONG"]->real(i), 1.0e10*i - 1.0,
+                           1.0e-10, "Check LONGLONG"+reader);
+                test_value(tab["USHORT"]->real(i), 60000.0 + i,
+                           1.0e-10, "Check scaled USHORT"+reader);
+                test_value(tab["ULONG"]->real(i), 4000000000.0 + i,
+                           1.0e-10, "Check scaled ULONG"+reader);
+                for (int j = 0; j < nvec; ++j) {
+                    test_value(tab["FLOAT"]->real(i,j), 1.5*i + 0.25*j - 3.0,
+                               1.0e-6, "Check FLOAT"+reader);
+                    test_value(tab["DOUBLE"]->real(i,j),
+                               double(i)*2.3 + double(j)*11.7 + 0.95,
+                               1.0e-10, "Check DOUBLE"+reader);
+                }
+                test_value(tab["VARIABLE"]->elements(i), i+1,
+                           "Check number of VARIABLE elements"+reader);
+                for (int j = 0; j < i+1; ++j) {
+                    test_value(tab["VARIABLE"]->real(i,j),
+                               double(i)*0.5 - double(j), 1.0e-10,
+                               "Check VARIABLE"+reader);
+                }
+                scaled[mode].push_back(tab["SCALED"]->real(i));
+            }
+
+            // Check images
+            for (int i = 0; i < 16; ++i) {
+                test_value(fits.image(0)->pixel(i%4, i/4), 500.0*i - 4000.0,
+                           1.0e-10, "Check SHORT image"+reader);
+                test_value(fits.image(1)->pixel(i%4, i/4), 0.1*i - 0.7,
+                           1.0e-10, "Check DOUBLE image"+reader);
+                test_value(fits.image(2)->pixel(i%4, i/4), 65000.0 + i,
+                           1.0e-10, "Check scaled USHORT image"+reader);
+            }
+
+            // Close FITS file
+            fits.close();
+            test_try_success();
+        }
+        catch(std::exception &e) {
+            test_try_failure(e);
+        }
+
+    } // endfor: looped over readers
+
+    // Restore default reader
+    gammalib::fits_mmap(false);
+
+    // Check that both readers give the same values for the scaled column
+    test_value(int(scaled[1].size()), int(scaled[0].size()),
+               "Check number of values of SCALED column");
+    for (int i = 0; i < int(scaled[0].size()) &&
+                    i < int(scaled[1].size()); ++i) {
+        test_value(scaled[1][i], scaled[0][i], 1.0e-10,
+                   "Check SCALED column using memory mapping");
+    }
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
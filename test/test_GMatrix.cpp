@@ -457,6 +457,43 @@ void TestGMatrix::matrix_operations(void)
         test_try_failure(e);
     }
 
+    // Test matrix*matrix and matrix*vector multiplication for matrices
+    // that span several cache blocks
+    GMatrix big_a(300, 170);
+    GMatrix big_b(170, 90);
+    GVector big_v(170);
+    for (int row = 0; row < 300; ++row) {
+        for (int col = 0; col < 170; ++col) {
+            big_a(row,col) = double((row * 7 + col * 3) % 11) - 5.0;
+        }
+    }
+    for (int row = 0; row < 170; ++row) {
+        for (int col = 0; col < 90; ++col) {
+            big_b(row,col) = double((row * 5 + col * 2) % 13) - 6.0;
+        }
+        big_v[row] = double(row % 7) - 3.0;
+    }
+    GMatrix big_c = big_a * big_b;
+    GVector big_y = big_a * big_v;
+    double  res_c = 0.0;
+    double  res_y = 0.0;
+    for (int row = 0; row < 300; ++row) {
+        for (int col = 0; col < 90; ++col) {
+            double value = 0.0;
+            for (int i = 0; i < 170; ++i) {
+                value += big_a(row,i) * big_b(i,col);
+            }
+            res_c += std::abs(big_c(row,col) - value);
+        }
+        double value = 0.0;
+        for (int i = 0; i < 170; ++i) {
+            value += big_a(row,i) * big_v[i];
+        }
+        res_y += std::abs(big_y[row] - value);
+    }
+    test_value(res_c, 0.0, 1.0e-10, "Test blocked matrix*matrix multiplication");
+    test_value(res_y, 0.0, 1.0e-10, "Test blocked matrix*vector multiplication");
+
     // Return
     return;
 }
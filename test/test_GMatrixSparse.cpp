@@ -861,6 +861,74 @@ void TestGMatrixSparse::matrix_arithmetics(void)
     test_assert(check_matrix(test, 1.0/3.0, 0.0), "Test GMatrixSparse / 3.0",
                 "Unexpected result matrix:\n"+test.print());
 
+    // GMatrixSparse::add_matrices
+    GMatrixSparse                     neg = -m_test;
+    std::vector<const GMatrixSparse*> matrices;
+    matrices.push_back(&m_test);
+    matrices.push_back(&m_test);
+    test = m_test;
+    test.add_matrices(matrices);
+    test_assert(check_matrix(m_test), "Test source matrix");
+    test_assert(check_matrix(test, 3.0, 0.0), "Test GMatrixSparse::add_matrices",
+                "Unexpected result matrix:\n"+test.print());
+    matrices.push_back(&neg);
+    test = GMatrixSparse(g_rows, g_cols);
+    test.add_matrices(matrices);
+    test_assert(check_matrix(test, 1.0, 0.0), "Test GMatrixSparse::add_matrices",
+                "Unexpected result matrix:\n"+test.print());
+    matrices.clear();
+    matrices.push_back(&neg);
+    test = m_test;
+    test.add_matrices(matrices);
+    test_value(test.fill(), 0.0, "Test GMatrixSparse::add_matrices cancellation");
+
+    // GMatrixSparse::pattern_init. Two matrices accumulate the test matrix
+    // on its pattern, one of them also an element that is not part of the
+    // pattern. The matrices are merged into a matrix that accumulates on
+    // the same pattern, so that only the element outside the pattern needs
+    // to be inserted.
+    GMatrixSparse pattern(g_rows, g_cols);
+    GMatrixSparse acc1(g_rows, g_cols);
+    GMatrixSparse acc2(g_rows, g_cols);
+    pattern.pattern_init(m_test);
+    acc1.pattern_init(pattern);
+    acc2.pattern_init(pattern);
+    acc2.stack_init();
+    for (int col = 0; col < g_cols; ++col) {
+        acc1.add_to_column(col, m_test.column(col));
+        acc2.add_to_column(col, m_test.column(col));
+    }
+    double extra_value = 10.0;
+    int    extra_row   = 1;
+    acc2.add_to_column(0, &extra_value, &extra_row, 1);
+    acc2.stack_destroy();
+    test_value(acc1.fill(), 0.0, "Test GMatrixSparse::pattern_init fill");
+    test_value(acc2.fill(), 1.0/double(g_rows*g_cols),
+               "Test GMatrixSparse::pattern_init fill outside pattern");
+    matrices.clear();
+    matrices.push_back(&acc1);
+    matrices.push_back(&acc2);
+    pattern.add_matrices(matrices);
+    test_value(pattern.fill(), 1.0/double(g_rows*g_cols),
+               "Test GMatrixSparse::add_matrices on pattern");
+    pattern.pattern_destroy();
+    test_value(pattern.fill(), double(g_elements+1)/double(g_rows*g_cols),
+               "Test GMatrixSparse::pattern_destroy fill");
+    test_value(pattern(1,0), 10.0, "Test GMatrixSparse::pattern_destroy value");
+    pattern(1,0) -= 10.0;
+    test_assert(check_matrix(pattern, 2.0, 0.0), "Test GMatrixSparse::pattern_destroy",
+                "Unexpected result matrix:\n"+pattern.print());
+
+    // GMatrixSparse::pattern_destroy without matrix elements
+    test = GMatrixSparse(g_rows, g_cols);
+    test.pattern_init(m_test);
+    for (int col = 0; col < g_cols; ++col) {
+        test.add_to_column(col, m_test.column(col));
+    }
+    test.pattern_destroy();
+    test_assert(check_matrix(test, 1.0, 0.0), "Test GMatrixSparse::pattern_destroy",
+                "Unexpected result matrix:\n"+test.print());
+
     // Test invalid matrix addition
     test_try("Test invalid matrix addition");
     try {
@@ -1248,6 +1316,70 @@ void TestGMatrixSparse::matrix_cholesky(void)
     res = (ciz_residuals.abs()).max();
     test_value(res, 0.0, 1.0e-15, "Test compressed matrix Cholesky inverter");
 
+    // Test numeric refactorisation with unchanged sparsity pattern. The
+    // first refactorisation needs a full decomposition, the second one
+    // reuses the symbolic analysis
+    GMatrixSparse refactor;
+    GMatrixSparse chol_scaled = chol_test;
+    for (int i = 0; i < 5; ++i) {
+        chol_scaled(i,i) *= 2.0;
+    }
+    test_assert(!refactor.cholesky_refactor(chol_test),
+                "Test cholesky_refactor() without symbolic analysis");
+    test_assert(refactor.cholesky_refactor(chol_scaled),
+                "Test cholesky_refactor() with same sparsity pattern");
+    GMatrixSparse cd_scaled = chol_scaled.cholesky_decompose();
+    a0 = GVector(5);
+    a0[0] = 1.0;
+    a0[2] = 0.5;
+    a0[4] = 0.3;
+    res = max(abs(refactor.cholesky_solver(a0) - cd_scaled.cholesky_solver(a0)));
+    test_value(res, 0.0, 1.0e-15, "Test cholesky_solver() after cholesky_refactor()");
+
+    // Test refactorisation with changed sparsity pattern
+    test_assert(!refactor.cholesky_refactor(chol_test_zero),
+                "Test cholesky_refactor() with changed sparsity pattern");
+    a0 = GVector(6);
+    a0[0] = 1.0;
+    a0[1] = 0.2;
+    a0[2] = 0.2;
+    a0[4] = 0.2;
+    a0[5] = 0.2;
+    e0 = GVector(6);
+    e0[0] = 1.0;
+    res = max(abs(refactor.cholesky_solver(a0) - e0));
+    test_value(res, 0.0, 1.0e-15, "Test compressed cholesky_solver() after cholesky_refactor()");
+
+    // Test Cholesky solver for multiple right-hand sides
+    GMatrix unit_dense(5,5);
+    for (int i = 0; i < 5; ++i) {
+        unit_dense(i,i) = 1.0;
+    }
+    GMatrix ms_residuals = cd.cholesky_solver(GMatrix(chol_test)) - unit_dense;
+    res = (ms_residuals.abs()).max();
+    test_value(res, 0.0, 1.0e-15, "Test cholesky_solver(GMatrix) method");
+
+    // Test compressed Cholesky solver for multiple right-hand sides
+    ms_residuals = cd_zero.cholesky_solver(GMatrix(chol_test_zero)) - GMatrix(unit);
+    res = (ms_residuals.abs()).max();
+    test_value(res, 0.0, 1.0e-15, "Test compressed cholesky_solver(GMatrix) method");
+
+    // Test diagonal of inverse matrix
+    GVector diag = cd.cholesky_inverse_diagonal();
+    res = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        res += std::abs(diag[i] - chol_test_inv(i,i));
+    }
+    test_value(res, 0.0, 1.0e-15, "Test cholesky_inverse_diagonal() method");
+
+    // Test diagonal of compressed inverse matrix
+    diag = cd_zero.cholesky_inverse_diagonal();
+    res  = 0.0;
+    for (int i = 0; i < 6; ++i) {
+        res += std::abs(diag[i] - chol_test_zero_inv(i,i));
+    }
+    test_value(res, 0.0, 1.0e-15, "Test compressed cholesky_inverse_diagonal() method");
+
     // Return
     return;
 }
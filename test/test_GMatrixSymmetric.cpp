@@ -783,6 +783,64 @@ void TestGMatrixSymmetric::matrix_cholesky(void)
 	res = (ciz_residuals.abs()).max();
     test_value(res, 0.0, 1.0e-15, "Test compressed cholesky_invert method");
 
+    // Test Cholesky solver for multiple right-hand sides
+    unit = GMatrixSymmetric(g_rows,g_cols);
+    unit(0,0) = unit(1,1) = unit(2,2) = 1.0;
+    GMatrix ms_residuals = cd.cholesky_solver(GMatrix(m_test)) - GMatrix(unit);
+    res = (ms_residuals.abs()).max();
+    test_value(res, 0.0, 1.0e-15, "Test cholesky_solver(GMatrix) method");
+
+    // Test compressed Cholesky solver for multiple right-hand sides
+    unit = GMatrixSymmetric(4,4);
+    unit(0,0) = unit(1,1) = unit(3,3) = 1.0;
+    ms_residuals = cd_zero.cholesky_solver(GMatrix(test_zero)) - GMatrix(unit);
+    res = (ms_residuals.abs()).max();
+    test_value(res, 0.0, 1.0e-15, "Test compressed cholesky_solver(GMatrix) method");
+
+    // Test diagonal of inverse matrix
+    GVector diag = cd.cholesky_inverse_diagonal();
+    res = 0.0;
+    for (int i = 0; i < g_rows; ++i) {
+        res += std::abs(diag[i] - test_inv(i,i));
+    }
+    test_value(res, 0.0, 1.0e-15, "Test cholesky_inverse_diagonal() method");
+
+    // Test diagonal of compressed inverse matrix
+    diag = cd_zero.cholesky_inverse_diagonal();
+    res  = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        res += std::abs(diag[i] - test_zero_inv(i,i));
+    }
+    test_value(res, 0.0, 1.0e-15, "Test compressed cholesky_inverse_diagonal() method");
+
+    // Test rank-1 update
+    GMatrixSymmetric rank1(g_rows,g_cols);
+    GVector          x(g_rows);
+    int              rank1_inx[2] = {2, 0};
+    x[0] = 2.0;
+    x[1] = 5.0;
+    x[2] = 3.0;
+    rank1.rank1_update(0.5, x, rank1_inx, 2);
+    res = std::abs(rank1(0,0) - 2.0) + std::abs(rank1(2,2) - 4.5) +
+          std::abs(rank1(0,2) - 3.0) + std::abs(rank1(2,0) - 3.0) +
+          std::abs(rank1(1,1)) + std::abs(rank1(0,1)) + std::abs(rank1(1,2));
+    test_value(res, 0.0, 1.0e-15, "Test rank1_update() method");
+
+    // Test Cholesky inversion of a matrix that spans several cache blocks
+    GMatrixSymmetric big(200,200);
+    for (int row = 0; row < 200; ++row) {
+        big(row,row) = 4.0;
+        for (int col = 0; col < row; ++col) {
+            big(row,col) = 1.0 / double((1 + row - col) * (1 + row - col));
+        }
+    }
+    GMatrix big_residuals = GMatrix(big) * GMatrix(big.cholesky_invert());
+    for (int row = 0; row < 200; ++row) {
+        big_residuals(row,row) -= 1.0;
+    }
+    res = (big_residuals.abs()).max();
+    test_value(res, 0.0, 1.0e-12, "Test blocked cholesky_invert method");
+
     // Return
     return;
 }
@@ -28,6 +28,8 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#include <ctime>
 #include <iostream>
 #include <ostream>
 #include <stdexcept>
@@ -70,6 +72,7 @@ void TestGModel::set(void)
     // Append tests
     append(static_cast<pfunction>(&TestGModel::test_model_par), "Test GModelPar");
     append(static_cast<pfunction>(&TestGModel::test_sky_model), "Test GModelSky");
+    append(static_cast<pfunction>(&TestGModel::test_sky_model_mc), "Test GModelSky Monte Carlo");
 
     // Append spatial model tests
     append(static_cast<pfunction>(&TestGModel::test_point_source), "Test GModelSpatialPointSource");
@@ -104,6 +107,7 @@ void TestGModel::set(void)
 
     // Append model container tests
     append(static_cast<pfunction>(&TestGModel::test_models), "Test GModels");
+    append(static_cast<pfunction>(&TestGModel::test_models_index), "Test GModels name index");
 
     // Append model registry tests
     append(static_cast<pfunction>(&TestGModel::test_model_registry), "Test model registries");
@@ -420,6 +424,93 @@ void TestGModel::test_sky_model(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test GModelSky Monte Carlo simulation
+ *
+ * Simulates photons from a radial Gaussian source in more than one block
+ * and checks that all photons fall within the simulation cone, that they
+ * are ordered in time, and that the photons do not depend on whether the
+ * blocks are simulated in parallel or serially.
+ ***************************************************************************/
+void TestGModel::test_sky_model_mc(void)
+{
+    // Setup sky model
+    GSkyDir dir;
+    dir.radec_deg(83.6331, 22.0145);
+    GModelSpatialRadialGauss spatial(dir, 1.0);
+    GModelSpectralPlaw       spectral(1.0e-7, -2.0, GEnergy(100.0, "MeV"));
+    GModelSky                sky(spatial, spectral);
+
+    // Set simulation region
+    double  area   = 1.0e4;
+    double  radius = 2.0;
+    GEnergy emin(100.0, "MeV");
+    GEnergy emax(100.0, "GeV");
+    GTime   tmin(0.0);
+    GTime   tmax(3.0e5);
+
+    // Simulate photons
+    GRan     ran1(1234);
+    GPhotons photons1 = sky.mc(area, dir, radius, emin, emax, tmin, tmax, ran1);
+
+    // Simulate photons serially by calling the method from within a
+    // parallel region
+    GRan     ran2(1234);
+    GPhotons photons2;
+    #pragma omp parallel num_threads(2)
+    {
+        #pragma omp single
+        {
+            photons2 = sky.mc(area, dir, radius, emin, emax, tmin, tmax, ran2);
+        }
+    }
+
+    // Check that several blocks were simulated and that some photons fell
+    // outside the simulation cone
+    test_assert(photons1.size() > 10000, "Expected more than 10000 photons "
+                "but found "+gammalib::str(photons1.size())+".");
+    test_assert(photons1.size() < 30000, "Expected less than 30000 photons "
+                "but found "+gammalib::str(photons1.size())+".");
+
+    // Check photons
+    int noutside  = 0;
+    int nunsorted = 0;
+    for (int i = 0; i < photons1.size(); ++i) {
+        if (dir.dist_deg(photons1[i].dir()) > radius + 1.0e-6) {
+            noutside++;
+        }
+        if (i > 0 && photons1[i].time() < photons1[i-1].time()) {
+            nunsorted++;
+        }
+    }
+    test_value(noutside, 0, "Check that photons are within cone");
+    test_value(nunsorted, 0, "Check that photons are ordered in time");
+
+    // Check that photons do not depend on the number of threads
+    test_value(photons2.size(), photons1.size(),
+               "Check number of serially simulated photons");
+    int ndiff = 0;
+    for (int i = 0; i < photons1.size() && i < photons2.size(); ++i) {
+        if (photons1[i].time()       != photons2[i].time()       ||
+            photons1[i].energy()     != photons2[i].energy()     ||
+            photons1[i].dir().ra()   != photons2[i].dir().ra()   ||
+            photons1[i].dir().dec()  != photons2[i].dir().dec()) {
+            ndiff++;
+        }
+    }
+    test_value(ndiff, 0, "Check that photons do not depend on threads");
+
+    // Check that subsequent simulations differ
+    GPhotons photons3 = sky.mc(area, dir, radius, emin, emax, tmin, tmax, ran1);
+    test_assert(photons3.size() != photons1.size() ||
+                photons3[0].energy() != photons1[0].energy(),
+                "Expected different photons for subsequent simulation.");
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test GModelSpatialPointSource class
  ***************************************************************************/
@@ -870,6 +961,31 @@ void TestGModel::test_radial_disk(void)
         test_try_failure(e);
     }
 
+    // Test analytical gradient
+    test_try("Test gradients");
+    try {
+        GSkyDir dir;
+        dir.radec_deg(83.6331, +22.0145);
+        GModelSpatialRadialDisk model(dir, 0.5);
+        model["Radius"].free();
+        GEnergy energy;
+        GTime   time;
+        double  theta = 0.3 * gammalib::deg2rad;
+        double  h     = 1.0e-6;
+        model.eval_gradients(theta, energy, time);
+        double  grad  = model["Radius"].factor_gradient();
+        model.radius(0.5 + h);
+        double  f_p   = model.eval(theta, energy, time);
+        model.radius(0.5 - h);
+        double  f_m   = model.eval(theta, energy, time);
+        test_value(grad, (f_p - f_m) / (2.0 * h), 1.0e-3 * std::abs(grad),
+                   "Check radius gradient");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 }
@@ -957,6 +1073,31 @@ void TestGModel::test_radial_gauss(void)
         test_try_failure(e);
     }
 
+    // Test analytical gradient
+    test_try("Test gradients");
+    try {
+        GSkyDir dir;
+        dir.radec_deg(83.6331, +22.0145);
+        GModelSpatialRadialGauss model(dir, 0.2);
+        model["Sigma"].free();
+        GEnergy energy;
+        GTime   time;
+        double  theta = 0.3 * gammalib::deg2rad;
+        double  h     = 1.0e-6;
+        model.eval_gradients(theta, energy, time);
+        double  grad  = model["Sigma"].factor_gradient();
+        model.sigma(0.2 + h);
+        double  f_p   = model.eval(theta, energy, time);
+        model.sigma(0.2 - h);
+        double  f_m   = model.eval(theta, energy, time);
+        test_value(grad, (f_p - f_m) / (2.0 * h), 1.0e-3 * std::abs(grad),
+                   "Check sigma gradient");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 }
@@ -1247,6 +1388,38 @@ void TestGModel::test_elliptical_gauss(void)
         test_try_failure(e);
     }
 
+    // Test analytical gradients
+    test_try("Test gradients");
+    try {
+        GSkyDir dir;
+        dir.radec_deg(83.6331, +22.0145);
+        GModelSpatialEllipticalGauss model(dir, 0.3, 0.1, 30.0);
+        GEnergy energy;
+        GTime   time;
+        double  theta    = 0.15 * gammalib::deg2rad;
+        double  posangle = 0.7;
+        double  h        = 1.0e-6;
+        const char* strarray[] = {"PA", "MajorRadius", "MinorRadius"};
+        for (int i = 0; i < 3; ++i) {
+            GModelPar& par = model[std::string(strarray[i])];
+            par.free();
+            model.eval_gradients(theta, posangle, energy, time);
+            double grad  = par.factor_gradient();
+            double value = par.value();
+            par.value(value + h);
+            double f_p   = model.eval(theta, posangle, energy, time);
+            par.value(value - h);
+            double f_m   = model.eval(theta, posangle, energy, time);
+            par.value(value);
+            test_value(grad, (f_p - f_m) / (2.0 * h), 1.0e-3 * std::abs(grad),
+                       "Check "+par.name()+" gradient");
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 }
@@ -2513,12 +2686,164 @@ void TestGModel::test_models(void)
     test_value(models[0]->scale("CTA").value(), 0.5);
     test_value(models[0]->scale("COM").value(), 1.0);
 
+    // Test model name index
+    GModels index;
+    for (int i = 0; i < 20; ++i) {
+        GModelSky src(GModelSpatialPointSource(83.6331, 22.0145),
+                      GModelSpectralPlaw(1.0e-7, -2.0, GEnergy(1.0, "TeV")));
+        src.name("Source "+gammalib::str(i));
+        index.append(src);
+    }
+    test_value(index.size(), 20);
+    test_assert(index["Source 0"]->name() == "Source 0",
+                "Expected model \"Source 0\".");
+    test_assert(index["Source 19"]->name() == "Source 19",
+                "Expected model \"Source 19\".");
+    test_assert(!index.contains("Source 20"), "Model \"Source 20\" found.");
+
+    // Test model name index after renaming models through pointers
+    index[3]->name("Renamed 3");
+    test_assert(index.contains("Renamed 3"), "Model \"Renamed 3\" not found.");
+    test_assert(!index.contains("Source 3"), "Model \"Source 3\" found.");
+    GModel* clone = index[0]->clone();
+    clone->name("Temporary");
+    GModel* appended = index.append(*clone);
+    test_assert(!index.contains("Source 3"), "Model \"Source 3\" found.");
+    appended->name("Appended");
+    test_assert(index.contains("Appended"), "Model \"Appended\" not found.");
+    test_assert(!index.contains("Temporary"), "Model \"Temporary\" found.");
+    test_assert(index["Appended"] == appended, "Expected model \"Appended\".");
+    test_value(index.size(), 21);
+
+    // Test model name index after renaming a model through a pointer that
+    // was obtained before the container was modified
+    GModel* first = index[0];
+    clone->name("Temporary");
+    index.append(*clone);
+    first->name("New");
+    test_assert(index.contains("New"), "Model \"New\" not found.");
+    test_assert(!index.contains("Source 0"), "Model \"Source 0\" found.");
+    test_assert(index["New"] == first, "Expected model \"New\".");
+    index.remove("Temporary");
+    first->name("Source 0");
+    test_assert(index.contains("Source 0"), "Model \"Source 0\" not found.");
+    test_assert(!index.contains("New"), "Model \"New\" found.");
+
+    // Test model name index after insertion and removal
+    clone->name("Temporary");
+    GModel* inserted = index.insert(0, *clone);
+    delete clone;
+    inserted->name("Inserted");
+    test_assert(index["Inserted"] == inserted,
+                "Expected model \"Inserted\".");
+    test_assert(index["Source 5"]->name() == "Source 5",
+                "Expected model \"Source 5\".");
+    index.remove("Source 1");
+    index.remove(0);
+    test_assert(!index.contains("Inserted"), "Model \"Inserted\" found.");
+    test_assert(!index.contains("Source 1"), "Model \"Source 1\" found.");
+    test_value(index.size(), 20);
+    test_assert(index["Source 5"]->name() == "Source 5",
+                "Expected model \"Source 5\".");
+    test_assert(index["Appended"] == appended,
+                "Expected model \"Appended\".");
+    test_assert(index.at(0)->name() == "Source 0",
+                "Expected model \"Source 0\".");
+
+    // Test model name index of a copied container
+    GModels copy(index);
+    test_assert(copy["Source 19"]->name() == "Source 19",
+                "Expected model \"Source 19\".");
+    test_assert(!copy.contains("Source 1"), "Model \"Source 1\" found.");
+
     // Exit test
     return;
 
 }
 
 
+/***********************************************************************//**
+ * @brief Test model name index of large model containers
+ *
+ * Loads model containers of different sizes from XML documents, accesses all
+ * models through the non-const access operator and renames one model. The
+ * time needed for a fixed number of failed look-ups is then compared for
+ * the different container sizes. As the model name index is rebuilt only
+ * once after renaming, the look-up time should not scale linearly with the
+ * container size.
+ ***************************************************************************/
+void TestGModel::test_models_index(void)
+{
+    // Set container sizes and number of look-ups
+    const int n_small   = 500;
+    const int n_large   = 8000;
+    const int n_lookups = 50000;
+
+    // Loop over container sizes
+    double cpu[2];
+    for (int k = 0; k < 2; ++k) {
+
+        // Set container size
+        int n = (k == 0) ? n_small : n_large;
+
+        // Create XML source library from the XML element of a single model
+        GModelSky src(GModelSpatialPointSource(83.6331, 22.0145),
+                      GModelSpectralPlaw(1.0e-7, -2.0, GEnergy(1.0, "TeV")));
+        GXml tmpl;
+        tmpl.append(GXmlElement("source_library title=\"source library\""));
+        src.write(*tmpl.element("source_library", 0));
+        GXmlElement source(*tmpl.element("source_library", 0)->element("source", 0));
+        GXml xml;
+        xml.append(GXmlElement("source_library title=\"source library\""));
+        GXmlElement* lib = xml.element("source_library", 0);
+        for (int i = 0; i < n; ++i) {
+            source.attribute("name", "Source "+gammalib::str(i));
+            lib->append(source);
+        }
+
+        // Load model container
+        GModels models;
+        models.read(xml);
+        test_value(models.size(), n);
+
+        // Access all models through non-const access operator and rename
+        // one model
+        for (int i = 0; i < n; ++i) {
+            models[i]->tscalc(false);
+        }
+        models[n/2]->name("Renamed");
+        test_assert(models.contains("Renamed"), "Model \"Renamed\" not found.");
+
+        // Time failed look-ups
+        int found = 0;
+        std::clock_t start = std::clock();
+        for (int i = 0; i < n_lookups; ++i) {
+            if (models.contains("Missing "+gammalib::str(i))) {
+                found++;
+            }
+        }
+        cpu[k] = double(std::clock() - start) / double(CLOCKS_PER_SEC);
+        test_value(found, 0);
+
+        // Check that the first and the last model are found
+        test_assert(models.contains("Source 0"), "Model \"Source 0\" not found.");
+        test_assert(models.contains("Source "+gammalib::str(n-1)),
+                    "Model \"Source "+gammalib::str(n-1)+"\" not found.");
+
+    } // endfor: looped over container sizes
+
+    // Check that look-up time does not scale linearly with container size
+    // (a linear scaling would result in a ratio of 16)
+    double ratio = cpu[1] / ((cpu[0] > 0.001) ? cpu[0] : 0.001);
+    test_assert(ratio < 5.0,
+                "Look-up time ratio "+gammalib::str(ratio)+" indicates a "
+                "linear scaling with the container size.");
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test model registry
  ***************************************************************************/
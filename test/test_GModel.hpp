@@ -49,6 +49,7 @@ public:
     virtual std::string classname(void) const { return "TestGModel"; }
     void                test_model_par(void);
     void                test_sky_model(void);
+    void                test_sky_model_mc(void);
     void                test_point_source(void);
     void                test_diffuse_const(void);
     void                test_diffuse_cube(void);
@@ -73,6 +74,7 @@ public:
     void                test_temp_const(void);
     void                test_model(void);
     void                test_models(void);
+    void                test_models_index(void);
     void                test_model_registry(void);
 
 private:        
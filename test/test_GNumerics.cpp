@@ -31,6 +31,9 @@
 #include <ostream>
 #include <stdexcept>
 #include <stdlib.h>
+#include <vector>
+#include <complex>
+#include <algorithm>
 #include "test_GNumerics.hpp"
 
 /* __ Namespaces _________________________________________________________ */
@@ -54,6 +57,8 @@ void TestGNumerics::set(void)
     append(static_cast<pfunction>(&TestGNumerics::test_romberg_integration),"Test Romberg integration");
     append(static_cast<pfunction>(&TestGNumerics::test_adaptive_simpson_integration),"Test adaptive Simpson integration");
     append(static_cast<pfunction>(&TestGNumerics::test_gauss_kronrod_integration),"Test Gauss-Kronrod integration");
+    append(static_cast<pfunction>(&TestGNumerics::test_batch_integration),"Test batch integration");
+    append(static_cast<pfunction>(&TestGNumerics::test_fft),"Test GFft");
 
     // Return
     return;
@@ -193,6 +198,125 @@ std::cout << integral << std::endl;
 }
 
 
+/***********************************************************************//**
+ * @brief Test integration using batch function evaluation
+ *
+ * Checks that the integration methods use the batch evaluation method of
+ * the integration kernel and that the results are identical to the results
+ * obtained with single value evaluation.
+ ***************************************************************************/
+void TestGNumerics::test_batch_integration(void)
+{
+    // Set-up integrals
+    Gauss      integrand(m_sigma);
+    GaussBatch integrand_batch(m_sigma);
+    GIntegral  integral(&integrand);
+    GIntegral  integral_batch(&integrand_batch);
+
+    // Test Romberg integration
+    double result       = integral.romberg(-m_sigma, m_sigma);
+    double result_batch = integral_batch.romberg(-m_sigma, m_sigma);
+    test_value(result_batch, result, 1.0e-15,
+               "Check Romberg integration with batch evaluation");
+    test_value(integral_batch.calls(), integral.calls(),
+               "Check number of Romberg function calls");
+    test_assert(integrand_batch.batches() > 0,
+                "Check that Romberg integration uses batch evaluation");
+
+    // Test Romberg integration with refinement levels that are evaluated
+    // in several chunks
+    integral.fixed_iter(10);
+    integral_batch.fixed_iter(10);
+    result       = integral.romberg(-m_sigma, m_sigma);
+    result_batch = integral_batch.romberg(-m_sigma, m_sigma);
+    test_value(result_batch, result, 1.0e-15,
+               "Check fixed Romberg integration with batch evaluation");
+    test_value(integral_batch.calls(), integral.calls(),
+               "Check number of fixed Romberg function calls");
+    test_assert(integral_batch.calls() > 128,
+                "Check that fixed Romberg integration needs several chunks");
+
+    // Test Gauss-Kronrod integration
+    int batches  = integrand_batch.batches();
+    result       = integral.gauss_kronrod(-m_sigma, m_sigma);
+    result_batch = integral_batch.gauss_kronrod(-m_sigma, m_sigma);
+    test_value(result_batch, result, 1.0e-15,
+               "Check Gauss-Kronrod integration with batch evaluation");
+    test_value(integral_batch.calls(), integral.calls(),
+               "Check number of Gauss-Kronrod function calls");
+    test_assert(integrand_batch.batches() > batches,
+                "Check that Gauss-Kronrod integration uses batch evaluation");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test Fast Fourier Transformation
+ *
+ * Compares the Fast Fourier Transformation to a direct computation of the
+ * discrete Fourier transform for lengths that factorise into small primes,
+ * for prime lengths that are transformed using Bluestein's algorithm and
+ * for mixed lengths, and checks that a backward transformation recovers
+ * the original data.
+ ***************************************************************************/
+void TestGNumerics::test_fft(void)
+{
+    // Set test lengths
+    const int lengths[] = {1, 2, 3, 4, 5, 7, 8, 12, 16, 30, 64, 97, 105, 210, 509};
+    const int nlengths  = sizeof(lengths) / sizeof(int);
+
+    // Loop over test lengths
+    for (int k = 0; k < nlengths; ++k) {
+
+        // Set data
+        int                                n = lengths[k];
+        std::vector<std::complex<double> > data(n);
+        for (int i = 0; i < n; ++i) {
+            data[i] = std::complex<double>(std::cos(0.3*i*i + 1.0), std::sin(0.7*i));
+        }
+
+        // Compute direct discrete Fourier transform
+        std::vector<std::complex<double> > dft(n);
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                double arg = -gammalib::twopi * double((long long)i * j % n) / n;
+                dft[j] += data[i] * std::polar(1.0, arg);
+            }
+        }
+
+        // Compute Fast Fourier Transformation and compare
+        GFft                               fft(n);
+        std::vector<std::complex<double> > result(data);
+        fft.forward(&result[0]);
+        double error = 0.0;
+        for (int j = 0; j < n; ++j) {
+            error = std::max(error, std::abs(result[j] - dft[j]));
+        }
+        test_value(error, 0.0, 1.0e-10 * n,
+                   "Check forward transformation of length "+gammalib::str(n));
+
+        // Check that backward transformation recovers data
+        fft.backward(&result[0]);
+        error = 0.0;
+        for (int i = 0; i < n; ++i) {
+            error = std::max(error, std::abs(result[i] / double(n) - data[i]));
+        }
+        test_value(error, 0.0, 1.0e-12,
+                   "Check backward transformation of length "+gammalib::str(n));
+
+    } // endfor: looped over test lengths
+
+    // Check good transformation lengths
+    test_value(GFft::good_size(97), 100, "Check good size for 97");
+    test_value(GFft::good_size(121), 125, "Check good size for 121");
+    test_value(GFft::good_size(128), 128, "Check good size for 128");
+
+    // Return
+    return;
+}
+
 /***********************************************************************//**
  * @brief Main test function
  ***************************************************************************/
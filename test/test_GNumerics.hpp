@@ -52,6 +52,31 @@ protected:
 };
 
 
+/***********************************************************************//**
+ * @class GaussBatch
+ *
+ * @brief Gaussian function with batch evaluation
+ ***************************************************************************/
+class GaussBatch : public Gauss {
+public:
+    GaussBatch(const double& sigma) : Gauss(sigma), m_batches(0) { return; }
+    virtual ~GaussBatch(void) { return; }
+    double eval(const double& x) {
+        return Gauss::eval(x);
+    }
+    void eval(const double* x, double* y, const int& n) {
+        m_batches++;
+        for (int i = 0; i < n; ++i) {
+            y[i] = Gauss::eval(x[i]);
+        }
+        return;
+    }
+    int batches(void) const { return m_batches; }
+protected:
+    int m_batches;
+};
+
+
 /***********************************************************************//**
  * @class TestGNumerics
  *
@@ -72,6 +97,8 @@ public:
     void                   test_romberg_integration(void);
     void                   test_adaptive_simpson_integration(void);
     void                   test_gauss_kronrod_integration(void);
+    void                   test_batch_integration(void);
+    void                   test_fft(void);
 
 private:
     // Private members
@@ -28,6 +28,8 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
+#include <vector>
 #include "testinst/GTestLib.hpp"
 #include "test_GObservation.hpp"
 
@@ -63,6 +65,8 @@ void TestGObservation::set(void)
     append(static_cast<pfunction>(&TestGObservation::test_energies), "Test GEnergies class");
     append(static_cast<pfunction>(&TestGObservation::test_ebounds), "Test GEbounds class");
     append(static_cast<pfunction>(&TestGObservation::test_photons), "Test GPhotons class");
+    append(static_cast<pfunction>(&TestGObservation::test_source), "Test GSource class");
+    append(static_cast<pfunction>(&TestGObservation::test_likelihood_curvature), "Test dense and sparse likelihood curvature");
 
     // Return
     return;
@@ -242,6 +246,65 @@ void TestGObservation::test_ebounds(void)
         test_try_failure(e);
     }
 
+    // Check index and contains methods against a search of all intervals
+    // for logarithmic, linear, irregular and unordered boundaries
+    GEbounds ebds_log(100, GEnergy(1.0, "GeV"), GEnergy(100.0, "TeV"));
+    GEbounds ebds_lin(100, GEnergy(1.0, "GeV"), GEnergy(100.0, "TeV"), false);
+    GEbounds ebds_irr;
+    ebds_irr.append(GEnergy(1.0, "GeV"),   GEnergy(2.0, "GeV"));
+    ebds_irr.append(GEnergy(2.0, "GeV"),   GEnergy(2.0, "GeV"));
+    ebds_irr.append(GEnergy(2.0, "GeV"),   GEnergy(30.0, "GeV"));
+    ebds_irr.append(GEnergy(50.0, "GeV"),  GEnergy(70.0, "GeV"));
+    ebds_irr.append(GEnergy(70.0, "GeV"),  GEnergy(100.0, "TeV"));
+    GEbounds ebds_uno;
+    ebds_uno.append(GEnergy(10.0, "TeV"),  GEnergy(100.0, "TeV"));
+    ebds_uno.append(GEnergy(1.0, "GeV"),   GEnergy(50.0, "GeV"));
+    ebds_uno.append(GEnergy(20.0, "GeV"),  GEnergy(1.0, "TeV"));
+    std::vector<GEbounds> ebounds;
+    ebounds.push_back(ebds_log);
+    ebounds.push_back(ebds_lin);
+    ebounds.push_back(ebds_irr);
+    ebounds.push_back(ebds_uno);
+    int nebounds = ebounds.size();
+    for (int k = 0; k < nebounds; ++k) {
+        const GEbounds& ebd = ebounds[k];
+        int nindex    = 0;
+        int ncontains = 0;
+        for (int i = 0; i <= 2000; ++i) {
+            GEnergy eng;
+            eng.MeV(std::pow(10.0, 2.5 + 6.0 * double(i)/2000.0));
+            int  index    = -1;
+            bool contains = false;
+            for (int j = 0; j < ebd.size(); ++j) {
+                if (index == -1 && eng >= ebd.emin(j) && eng < ebd.emax(j)) {
+                    index = j;
+                }
+                if (eng >= ebd.emin(j) && eng <= ebd.emax(j)) {
+                    contains = true;
+                }
+            }
+            if (ebd.index(eng) != index) {
+                nindex++;
+            }
+            if (ebd.contains(eng) != contains) {
+                ncontains++;
+            }
+        }
+        for (int j = 0; j < ebd.size(); ++j) {
+            if (k < 3 && ebd.emin(j) < ebd.emax(j) &&
+                ebd.index(ebd.emin(j)) != j) {
+                nindex++;
+            }
+            if (!ebd.contains(ebd.emax(j))) {
+                ncontains++;
+            }
+        }
+        test_value(nindex, 0, "Check GEbounds::index() for boundaries "+
+                   gammalib::str(k));
+        test_value(ncontains, 0, "Check GEbounds::contains() for boundaries "+
+                   gammalib::str(k));
+    }
+
     // Return
     return;
 }
@@ -369,6 +432,55 @@ void TestGObservation::test_gti(void)
     test_value(gti.tstart().secs(), 1.0, 1.0e-10, "Start time should be 1.");
     test_value(gti.tstop().secs(), 1000.0, 1.0e-10, "Stop time should be 1000.");
 
+    // Check reduction
+    gti.reduce(GTime(5.0), GTime(50.0));
+    test_value(gti.size(), 2, "GGti should have 2 intervals.");
+    test_value(gti.tstart(0).secs(), 5.0, 1.0e-10, "Bin 0 start time should be 5.");
+    test_value(gti.tstop(1).secs(), 50.0, 1.0e-10, "Bin 1 stop time should be 50.");
+    test_value(gti.ontime(), 45.0, 1.0e-10, "Ontime should be 45.");
+
+    // Check contains method against a test of all intervals for a large
+    // number of ordered intervals and for unordered intervals, using
+    // increasing, decreasing and random sequences of times
+    GGti gti_ord;
+    for (int i = 0; i < 1000; ++i) {
+        gti_ord.append(GTime(10.0*i), GTime(10.0*i + 5.0 + (i % 5)));
+    }
+    GGti gti_uno;
+    gti_uno.append(GTime(500.0), GTime(600.0));
+    gti_uno.append(GTime(100.0), GTime(550.0));
+    gti_uno.append(GTime(5000.0), GTime(5001.0));
+    GRan ran;
+    for (int k = 0; k < 2; ++k) {
+        const GGti& g = (k == 0) ? gti_ord : gti_uno;
+        int ndiff = 0;
+        for (int i = 0; i < 3*12000; ++i) {
+            double secs;
+            if (i < 12000) {
+                secs = double(i) - 100.0;
+            }
+            else if (i < 24000) {
+                secs = double(24000 - i) - 100.0;
+            }
+            else {
+                secs = 12000.0 * ran.uniform() - 100.0;
+            }
+            GTime time(secs);
+            bool  contains = false;
+            for (int j = 0; j < g.size(); ++j) {
+                if (time >= g.tstart(j) && time <= g.tstop(j)) {
+                    contains = true;
+                    break;
+                }
+            }
+            if (g.contains(time) != contains) {
+                ndiff++;
+            }
+        }
+        test_value(ndiff, 0, "Check GGti::contains() for intervals "+
+                   gammalib::str(k));
+    }
+
     // Return
     return;
 }
@@ -963,6 +1075,143 @@ void TestGObservation::test_photons(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test GSource class
+ *
+ * Checks that the interned source name is set together with the source
+ * name.
+ ***************************************************************************/
+void TestGObservation::test_source(void)
+{
+    // Check that void source has no interned name
+    GSource source;
+    test_value(source.name_id(), -1, "Check interned name of void source");
+
+    // Check that constructor interns source name
+    GModelSpatialPointSource model(83.63, 22.01);
+    GSource source2("Crab", &model, GEnergy(1.0, "TeV"), GTime(0.0));
+    test_value(source2.name_id(), gammalib::intern("Crab"),
+               "Check interned name of constructed source");
+
+    // Check that setting the name interns the name
+    source2.name("Vela");
+    test_value(source2.name_id(), gammalib::intern("Vela"),
+               "Check interned name after setting name");
+
+    // Check that copy keeps interned name
+    GSource source3(source2);
+    test_value(source3.name_id(), source2.name_id(),
+               "Check interned name of copied source");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test dense and sparse curvature accumulation of the likelihood
+ *
+ * Evaluates the likelihood function of a binned observation for a number
+ * of model parameters equal to GObservation::max_dense_pars, for which the
+ * curvature is accumulated in dense matrices, and for one more parameter,
+ * for which the curvature is accumulated in sparse matrices. The additional
+ * parameter belongs to a model with zero rate, hence the likelihood value,
+ * Npred, the gradient and the curvature of all other parameters have to
+ * agree for both computations.
+ ***************************************************************************/
+void TestGObservation::test_likelihood_curvature(void)
+{
+    // Set number of parameters for dense and sparse accumulation
+    int ndense  = GObservation::max_dense_pars;
+    int nsparse = ndense + 1;
+
+    // Setup models with a total rate of RATE. The sparse models contain
+    // an additional model with zero rate.
+    GModels models_dense;
+    GModels models_sparse;
+    for (int i = 0; i < nsparse; ++i) {
+        GTestModelData model;
+        model.name("Model "+gammalib::str(i));
+        model[0].value((i < ndense) ? RATE/double(ndense) : 0.0);
+        if (i < ndense) {
+            models_dense.append(model);
+        }
+        models_sparse.append(model);
+    }
+
+    // Create binned observation
+    GTime tmin(0.0);
+    GTime tmax(1800.0);
+    GRan  ran;
+    ran.seed(1);
+    GTestModelData   model;
+    GEvents*         events = model.generateCube(RATE,tmin,tmax,ran);
+    GTestObservation obs;
+    obs.events(*events);
+    obs.ontime(tmax.secs()-tmin.secs());
+    delete events;
+
+    // Setup observation containers
+    GObservations obs_dense;
+    GObservations obs_sparse;
+    obs_dense.append(obs);
+    obs_sparse.append(obs);
+    obs_dense.models(models_dense);
+    obs_sparse.models(models_sparse);
+
+    // Evaluate likelihood using dense and sparse curvature accumulation.
+    // Both likelihoods are evaluated twice to check that the dense
+    // accumulators and the curvature matrix that are kept across
+    // evaluations are properly reset, and that the sparse curvature
+    // accumulated on the sparsity pattern of the first evaluation is
+    // identical.
+    GModels                   pars_models_dense(obs_dense.models());
+    GModels                   pars_models_sparse(obs_sparse.models());
+    GOptimizerPars            pars_dense  = pars_models_dense.pars();
+    GOptimizerPars            pars_sparse = pars_models_sparse.pars();
+    GObservations::likelihood fct_dense(&obs_dense);
+    GObservations::likelihood fct_sparse(&obs_sparse);
+    fct_dense.eval(pars_dense);
+    fct_dense.eval(pars_dense);
+    fct_sparse.eval(pars_sparse);
+    double         fill_sparse  = fct_sparse.curvature()->fill();
+    fct_sparse.eval(pars_sparse);
+    double         value_dense  = fct_dense.value();
+    double         value_sparse = fct_sparse.value();
+    double         npred_dense  = fct_dense.npred();
+    double         npred_sparse = fct_sparse.npred();
+    GVector        grad_dense   = *fct_dense.gradient();
+    GVector        grad_sparse  = *fct_sparse.gradient();
+    GMatrixSparse  curv_dense   = *fct_dense.curvature();
+    GMatrixSparse  curv_sparse  = *fct_sparse.curvature();
+
+    // Check results
+    test_value(value_sparse, value_dense, 1.0e-10*std::abs(value_dense),
+               "Check likelihood value");
+    test_value(npred_sparse, npred_dense, 1.0e-10*npred_dense, "Check Npred");
+    int nbad = 0;
+    for (int i = 0; i < ndense; ++i) {
+        if (std::abs(grad_sparse[i] - grad_dense[i]) >
+            1.0e-10*(1.0+std::abs(grad_dense[i]))) {
+            nbad++;
+        }
+        for (int j = 0; j < ndense; ++j) {
+            if (std::abs(curv_sparse(i,j) - curv_dense(i,j)) >
+                1.0e-10*(1.0+std::abs(curv_dense(i,j)))) {
+                nbad++;
+            }
+        }
+    }
+    test_assert(curv_dense(0,0) > 0.0, "Check non-zero curvature");
+    test_value(curv_sparse.fill(), fill_sparse, "Check sparse curvature fill");
+    test_assert(nbad == 0, "Check gradient and curvature",
+                gammalib::str(nbad)+" differences found");
+
+    // Return
+    return;
+}
+
+
 #ifdef _OPENMP
 /***********************************************************************//**
 * @brief Set tests
@@ -980,6 +1229,13 @@ void TestOpenMP::set(void)
     append(static_cast<pfunction>(&TestOpenMP::test_observations_optimizer_binned_1), "Test binned optimization (1 thread)");
     append(static_cast<pfunction>(&TestOpenMP::test_observations_optimizer_binned_10), "Test binned optimisation (10 threads)");
 
+    // Append event-level parallelism tests
+    append(static_cast<pfunction>(&TestOpenMP::test_observation_likelihood_unbinned), "Test unbinned event-level parallelism");
+    append(static_cast<pfunction>(&TestOpenMP::test_observation_likelihood_binned), "Test binned event-level parallelism");
+
+    // Append reproducibility test
+    append(static_cast<pfunction>(&TestOpenMP::test_observations_likelihood_order), "Test reproducibility of observation-level parallelism");
+
     // Return
     return;
 }
@@ -1140,6 +1396,174 @@ void TestOpenMP::test_observations_optimizer_binned_10(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Test event-level parallelism for a single observation.
+ *
+ * @param[in] mode Testing mode.
+ *
+ * Evaluates the likelihood of a single observation using 1 and 10 threads
+ * and checks that the likelihood value, Npred, the gradient and the
+ * curvature matrix agree. This method supports two testing modes:
+ * 0 = unbinned and 1 = binned.
+ ***************************************************************************/
+void TestOpenMP::test_observation_likelihood(const int& mode)
+{
+    // Create Test Model
+    GTestModelData model;
+
+    // Create Models conteners
+    GModels models;
+    models.append(model);
+
+    // Time iterval (long enough to have several bins per thread)
+    GTime tmin(0.0);
+    GTime tmax(18000.0);
+
+    // Random Generator
+    GRan ran;
+    ran.seed(1);
+
+    // Create either a event list or an event cube
+    GEvents *events;
+    if (mode == UN_BINNED) {
+        events = model.generateList(RATE,tmin,tmax,ran);
+    }
+    else {
+        events = model.generateCube(RATE,tmin,tmax,ran);
+    }
+
+    // Create an observation
+    GTestObservation obs;
+    obs.events(*events);
+    obs.ontime(tmax.secs()-tmin.secs());
+    delete events;
+
+    // Evaluate likelihood with 1 and 10 threads
+    int           npars = models.npars();
+    GVector       grad1(npars);
+    GVector       grad10(npars);
+    GMatrixSparse curv1(npars,npars);
+    GMatrixSparse curv10(npars,npars);
+    double        npred1  = 0.0;
+    double        npred10 = 0.0;
+    omp_set_num_threads(1);
+    double value1  = obs.likelihood(models, &grad1, &curv1, &npred1);
+    omp_set_num_threads(10);
+    double value10 = obs.likelihood(models, &grad10, &curv10, &npred10);
+
+    // Check results
+    test_value(value10, value1, 1.0e-6, "Check likelihood value");
+    test_value(npred10, npred1, 1.0e-6, "Check Npred");
+    for (int i = 0; i < npars; ++i) {
+        test_value(grad10[i], grad1[i], 1.0e-6, "Check gradient");
+        for (int j = 0; j < npars; ++j) {
+            test_value(curv10(i,j), curv1(i,j), 1.0e-6, "Check curvature");
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test event-level parallelism with unbinned events
+ ***************************************************************************/
+void TestOpenMP::test_observation_likelihood_unbinned(void)
+{
+    // Test unbinned likelihood
+    test_observation_likelihood(UN_BINNED);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test event-level parallelism with binned events
+ ***************************************************************************/
+void TestOpenMP::test_observation_likelihood_binned(void)
+{
+    // Test binned likelihood
+    test_observation_likelihood(BINNED);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test reproducibility of observation-level parallelism
+ *
+ * Evaluates the likelihood of several observations repeatedly using 10
+ * threads and checks that the likelihood value, Npred, the gradient and
+ * the curvature matrix are identical for all evaluations, which requires
+ * that the results of the threads are always added in the same order.
+ ***************************************************************************/
+void TestOpenMP::test_observations_likelihood_order(void)
+{
+    // Create Test Model
+    GTestModelData model;
+
+    // Create Models conteners
+    GModels models;
+    models.append(model);
+
+    // Time iterval
+    GTime tmin(0.0);
+    GTime tmax(1800.0);
+
+    // Create observations
+    GObservations obs;
+    for (int i = 0; i < 12; ++i) {
+        GRan ran;
+        ran.seed(i);
+        GEvents* events = model.generateCube(RATE,tmin,tmax,ran);
+        GTestObservation ob;
+        ob.id(gammalib::str(i));
+        ob.events(*events);
+        ob.ontime(tmax.secs()-tmin.secs());
+        obs.append(ob);
+        delete events;
+    }
+    obs.models(models);
+
+    // Evaluate likelihood a first time with 10 threads
+    omp_set_num_threads(10);
+    GOptimizerPars            pars = models.pars();
+    GObservations::likelihood like(&obs);
+    like.eval(pars);
+    double        value  = like.value();
+    double        npred  = like.npred();
+    GVector       grad   = *like.gradient();
+    GMatrixSparse curv   = *like.curvature();
+
+    // Check that repeated evaluations give identical results
+    int nbad = 0;
+    for (int k = 0; k < 20; ++k) {
+        like.eval(pars);
+        if (like.value() != value || like.npred() != npred) {
+            nbad++;
+        }
+        for (int i = 0; i < grad.size(); ++i) {
+            if ((*like.gradient())[i] != grad[i]) {
+                nbad++;
+            }
+            for (int j = 0; j < grad.size(); ++j) {
+                if ((*like.curvature())(i,j) != curv(i,j)) {
+                    nbad++;
+                }
+            }
+        }
+    }
+    test_assert(nbad == 0, "Check identical likelihood evaluations",
+                gammalib::str(nbad)+" differences found");
+
+    // Return
+    return;
+}
 #endif
 
 
@@ -50,11 +50,13 @@ public:
     void                      test_ebounds(void);
     void                      test_gti(void);
     void                      test_photons(void);
+    void                      test_source(void);
     void                      test_time_reference(void);
     void                      test_time(void);
     void                      test_times(void);
     void                      test_energy(void);
     void                      test_energies(void);
+    void                      test_likelihood_curvature(void);
 };
 
 
@@ -80,6 +82,10 @@ public:
     void                test_observations_optimizer_binned_1();
     void                test_observations_optimizer_binned_10();
     void                test_observations_optimizer(const int& mode=0);
+    void                test_observation_likelihood_unbinned();
+    void                test_observation_likelihood_binned();
+    void                test_observation_likelihood(const int& mode=0);
+    void                test_observations_likelihood_order();
 };
 #endif
 
@@ -31,6 +31,7 @@
 #include <iostream>                           // cout, cerr
 #include <stdexcept>                          // std::exception
 #include <stdlib.h>
+#include <cmath>
 #include "test_GSky.hpp"
 #include "GTools.hpp"
 
@@ -56,10 +57,14 @@ void TestGSky::set(void){
     append(static_cast<pfunction>(&TestGSky::test_GWcs),"Test GWcs");
     append(static_cast<pfunction>(&TestGSky::test_GSkyPixel),"Test GSkyPixel");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_construct),"Test Healpix GSkymap constructors");
+    append(static_cast<pfunction>(&TestGSky::test_GHealpix_query),"Test GHealpix region queries");
+    append(static_cast<pfunction>(&TestGSky::test_GHealpix_64bit),"Test GHealpix 64-bit pixel indices");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_io),"Test Healpix GSkymap I/O");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_wcs_construct),"Test WCS GSkymap constructors");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap_wcs_io),"Test WCS GSkymap I/O");
     append(static_cast<pfunction>(&TestGSky::test_GSkymap),"Test GSkymap");
+    append(static_cast<pfunction>(&TestGSky::test_GSkymap_pixel_cache),"Test GSkymap pixel cache");
+    append(static_cast<pfunction>(&TestGSky::test_GSkymap_convolve),"Test GSkymap convolution");
     append(static_cast<pfunction>(&TestGSky::test_GSkyRegions_io),"Test GSkyRegions");
     append(static_cast<pfunction>(&TestGSky::test_GSkyRegionCircle_construct),"Test GSkyRegionCircle constructors");
     append(static_cast<pfunction>(&TestGSky::test_GSkyRegionCircle_logic),"Test GSkyRegionCircle logic");
@@ -262,6 +267,74 @@ double TestGSky::wcs_copy(GWcs* wcs, int nx, int ny, double& crpix1, double& crp
 }
 
 
+/***********************************************************************//**
+ * @brief Test consistency of batch conversion
+ *
+ * @param[in] wcs WCS object
+ * @param[in] nx Number of points in X
+ * @param[in] ny Number of points in Y
+ *
+ * Compares the array versions of pix2dir() and dir2pix() to the single
+ * pixel versions and returns the maximum deviation.
+ ***************************************************************************/
+double TestGSky::wcs_batch(GWcs* wcs, int nx, int ny)
+{
+    // Set pixel arrays
+    int                 n = nx * ny;
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::vector<double> lon(n);
+    std::vector<double> lat(n);
+    std::vector<double> xout(n);
+    std::vector<double> yout(n);
+    for (int iy = 0, i = 0; iy < ny; ++iy) {
+        for (int ix = 0; ix < nx; ++ix, ++i) {
+            x[i] = double(ix);
+            y[i] = double(iy);
+        }
+    }
+
+    // Perform batch conversions
+    wcs->pix2dir(&x[0], &y[0], &lon[0], &lat[0], n);
+    wcs->dir2pix(&lon[0], &lat[0], &xout[0], &yout[0], n);
+
+    // Initialise maximal deviation
+    double dev_max = 0.0;
+
+    // Compare to single pixel conversions
+    for (int i = 0; i < n; ++i) {
+
+        // Get sky direction of pixel
+        GSkyDir dir = wcs->pix2dir(GSkyPixel(x[i], y[i]));
+
+        // Compute coordinate deviations
+        double dlon = (wcs->coordsys() == "EQU") ? dir.ra_deg()  - lon[i]
+                                                 : dir.l_deg()   - lon[i];
+        double dlat = (wcs->coordsys() == "EQU") ? dir.dec_deg() - lat[i]
+                                                 : dir.b_deg()   - lat[i];
+        if (std::abs(dlon) > dev_max) {
+            dev_max = std::abs(dlon);
+        }
+        if (std::abs(dlat) > dev_max) {
+            dev_max = std::abs(dlat);
+        }
+
+        // Compute pixel deviation
+        GSkyPixel pixel = wcs->dir2pix(dir);
+        double    dx    = pixel.x() - xout[i];
+        double    dy    = pixel.y() - yout[i];
+        double    dist  = std::sqrt(dx*dx+dy*dy);
+        if (dist > dev_max) {
+            dev_max = dist;
+        }
+
+    } // endfor: looped over pixels
+
+    // Return
+    return dev_max;
+}
+
+
 /***********************************************************************//**
  * @brief Test GSkyPixel class
  *
@@ -492,6 +565,32 @@ void TestGSky::test_GWcs(void)
                 test_try_failure(e);
             }
 
+            // Test CEL batch conversion
+            test_try("Test CEL batch conversion");
+            try {
+                double tol = 0.0;
+                if ((tol = wcs_batch(cel, nx, ny)) > 1.0e-10) {
+                    throw exception_failure("CEL batch tolerance 1.0e-10 exceeded: "+gammalib::str(tol));
+                }
+                test_try_success();
+            }
+            catch (std::exception &e) {
+                test_try_failure(e);
+            }
+
+            // Test GAL batch conversion
+            test_try("Test GAL batch conversion");
+            try {
+                double tol = 0.0;
+                if ((tol = wcs_batch(gal, nx, ny)) > 1.0e-10) {
+                    throw exception_failure("GAL batch tolerance 1.0e-10 exceeded: "+gammalib::str(tol));
+                }
+                test_try_success();
+            }
+            catch (std::exception &e) {
+                test_try_failure(e);
+            }
+
             // Free memory
             delete cel;
             delete gal;
@@ -510,6 +609,245 @@ void TestGSky::test_GWcs(void)
 }
 
 
+/***************************************************************************
+ * @brief Test GHealpix region queries
+ *
+ * Compares the pixels returned by the disc, strip and polygon queries to
+ * the pixels found by testing all pixel centres, for ring and nested
+ * ordering. Pixel centres that are within 1e-9 radians of the region
+ * boundary are ignored.
+ ***************************************************************************/
+void TestGSky::test_GHealpix_query(void)
+{
+    // Set test discs (RA, Dec, radius in deg)
+    const int    ndiscs      = 5;
+    const double discs[][3] = {{83.63, 22.01,  5.0},
+                               { 1.00, -3.00, 20.0},
+                               { 0.00, 90.00, 12.0},
+                               {270.0, -85.0, 10.0},
+                               {123.0,  45.0, 120.0}};
+
+    // Loop over ordering schemes
+    for (int iorder = 0; iorder < 2; ++iorder) {
+
+        // Setup projection
+        std::string ordering = (iorder == 0) ? "RING" : "NESTED";
+        GHealpix    healpix(16, ordering, "EQU");
+        long long   npix = healpix.npix();
+
+        // Get pixel centres
+        std::vector<double> ra(npix);
+        std::vector<double> dec(npix);
+        std::vector<GSkyDir> dirs(npix);
+        for (long long i = 0; i < npix; ++i) {
+            dirs[i] = healpix.pix2dir(GSkyPixel(i));
+            ra[i]   = dirs[i].ra();
+            dec[i]  = dirs[i].dec();
+        }
+
+        // Test disc queries
+        for (int k = 0; k < ndiscs; ++k) {
+            GSkyDir centre;
+            centre.radec_deg(discs[k][0], discs[k][1]);
+            double radius = discs[k][2] * gammalib::deg2rad;
+            std::vector<long long> pixels    = healpix.query_disc(centre, discs[k][2]);
+            std::vector<long long> inclusive = healpix.query_disc(centre, discs[k][2], true);
+            std::vector<bool> selected(npix, false);
+            std::vector<bool> included(npix, false);
+            int nunsorted  = 0;
+            int npixels    = pixels.size();
+            int ninclusive = inclusive.size();
+            for (int i = 0; i < npixels; ++i) {
+                selected[pixels[i]] = true;
+                if (i > 0 && pixels[i] <= pixels[i-1]) {
+                    nunsorted++;
+                }
+            }
+            for (int i = 0; i < ninclusive; ++i) {
+                included[inclusive[i]] = true;
+            }
+            int nwrong    = 0;
+            int nmissing  = 0;
+            for (long long i = 0; i < npix; ++i) {
+                double dist = centre.dist(dirs[i]);
+                if (std::abs(dist - radius) > 1.0e-9 &&
+                    selected[i] != (dist < radius)) {
+                    nwrong++;
+                }
+                if (selected[i] && !included[i]) {
+                    nmissing++;
+                }
+            }
+            std::string text = ordering+" disc "+gammalib::str(k);
+            test_value(nwrong, 0, "Check pixels of "+text);
+            test_value(nunsorted, 0, "Check pixel order of "+text);
+            test_value(nmissing, 0, "Check inclusive pixels of "+text);
+        }
+
+        // Test strip query
+        std::vector<long long> pixels = healpix.query_strip(-30.0, 10.0);
+        std::vector<bool> selected(npix, false);
+        int               npixels = pixels.size();
+        for (int i = 0; i < npixels; ++i) {
+            selected[pixels[i]] = true;
+        }
+        int nwrong = 0;
+        for (long long i = 0; i < npix; ++i) {
+            double b    = dec[i] * gammalib::rad2deg;
+            bool border = (std::abs(b + 30.0) < 1.0e-9 ||
+                           std::abs(b - 10.0) < 1.0e-9);
+            if (!border && selected[i] != (b >= -30.0 && b <= 10.0)) {
+                nwrong++;
+            }
+        }
+        test_value(nwrong, 0, "Check pixels of "+ordering+" strip");
+
+        // Test polygon query using a quadrangle that crosses RA=0
+        std::vector<GSkyDir> vertices(4);
+        vertices[0].radec_deg(350.0, -10.0);
+        vertices[1].radec_deg( 20.0, -15.0);
+        vertices[2].radec_deg( 25.0,  20.0);
+        vertices[3].radec_deg(345.0,  15.0);
+        pixels = healpix.query_polygon(vertices);
+        selected.assign(npix, false);
+        npixels = pixels.size();
+        for (int i = 0; i < npixels; ++i) {
+            selected[pixels[i]] = true;
+        }
+        nwrong = 0;
+        for (long long i = 0; i < npix; ++i) {
+            bool   inside = true;
+            bool   border = false;
+            double px     = std::cos(dec[i]) * std::cos(ra[i]);
+            double py     = std::cos(dec[i]) * std::sin(ra[i]);
+            double pz     = std::sin(dec[i]);
+            for (int k = 0; k < 4; ++k) {
+                const GSkyDir& a  = vertices[k];
+                const GSkyDir& b  = vertices[(k+1) % 4];
+                double ax = std::cos(a.dec()) * std::cos(a.ra());
+                double ay = std::cos(a.dec()) * std::sin(a.ra());
+                double az = std::sin(a.dec());
+                double bx = std::cos(b.dec()) * std::cos(b.ra());
+                double by = std::cos(b.dec()) * std::sin(b.ra());
+                double bz = std::sin(b.dec());
+                double nx = ay*bz - az*by;
+                double ny = az*bx - ax*bz;
+                double nz = ax*by - ay*bx;
+                double d  = (nx*px + ny*py + nz*pz) /
+                            std::sqrt(nx*nx + ny*ny + nz*nz);
+                if (std::abs(d) < 1.0e-9) {
+                    border = true;
+                }
+                if (d < 0.0) {
+                    inside = false;
+                }
+            }
+            if (!border && selected[i] != inside) {
+                nwrong++;
+            }
+        }
+        test_assert(pixels.size() > 0, "Check that polygon has pixels");
+        test_value(nwrong, 0, "Check pixels of "+ordering+" polygon");
+
+    } // endfor: looped over ordering schemes
+
+    // Test invalid queries
+    GHealpix healpix(4, "RING", "EQU");
+    test_try("Test strip with invalid latitudes");
+    try {
+        healpix.query_strip(10.0, -10.0);
+        test_try_failure("Invalid strip shall throw an exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+    test_try("Test non-convex polygon");
+    try {
+        std::vector<GSkyDir> vertices(4);
+        vertices[0].radec_deg(0.0, 0.0);
+        vertices[1].radec_deg(20.0, 0.0);
+        vertices[2].radec_deg(10.0, 5.0);
+        vertices[3].radec_deg(10.0, 20.0);
+        healpix.query_polygon(vertices);
+        test_try_failure("Non-convex polygon shall throw an exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***************************************************************************
+ * @brief Test GHealpix 64-bit pixel indices
+ *
+ * Checks that pixel to direction conversions round trip for pixel indices
+ * beyond 2^31 and that ring and nested pixels with the same index map onto
+ * consistent sky directions.
+ ***************************************************************************/
+void TestGSky::test_GHealpix_64bit(void)
+{
+    // Set Nside for which the number of pixels exceeds 2^31
+    const int       nside = 16384;
+    const long long npix  = 12LL * (long long)nside * (long long)nside;
+
+    // Allocate projections
+    GHealpix ring(nside, "RING", "CEL");
+    GHealpix nest(nside, "NESTED", "CEL");
+
+    // Check number of pixels
+    test_assert(ring.npix() == npix, "Check number of RING pixels");
+    test_assert(nest.npix() == npix, "Check number of NESTED pixels");
+
+    // Loop over a set of pixels with indices beyond 2^31
+    int nring = 0;
+    int nnest = 0;
+    int nconv = 0;
+    for (long long index = 2147483648LL; index < npix; index += 9876543LL) {
+
+        // Check that pixel to direction conversion round trips
+        GSkyDir dir_ring = ring.pix2dir(GSkyPixel(index));
+        GSkyDir dir_nest = nest.pix2dir(GSkyPixel(index));
+        if ((long long)ring.dir2pix(dir_ring) != index) {
+            nring++;
+        }
+        if ((long long)nest.dir2pix(dir_nest) != index) {
+            nnest++;
+        }
+
+        // Check that the nested pixel centre is also a ring pixel centre
+        // (the tolerance accounts for the precision of GSkyDir::dist_deg())
+        long long inx = ring.dir2pix(dir_nest);
+        if (ring.pix2dir(GSkyPixel(inx)).dist_deg(dir_nest) > 1.0e-5) {
+            nconv++;
+        }
+
+    } // endfor: looped over pixels
+
+    // Check results
+    test_value(nring, 0, "Check RING pixel round trip beyond 2^31");
+    test_value(nnest, 0, "Check NESTED pixel round trip beyond 2^31");
+    test_value(nconv, 0, "Check NESTED to RING conversion beyond 2^31");
+
+    // Check last pixel
+    GSkyPixel last(npix-1);
+    test_assert((long long)last == npix-1, "Check 64-bit sky pixel index");
+    test_assert((long long)ring.dir2pix(ring.pix2dir(last)) == npix-1,
+                "Check last RING pixel");
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  * @brief GSkymap_healpix_construct
  ***************************************************************************/
@@ -645,7 +983,7 @@ void TestGSky::test_GSkymap_healpix_io(void)
     // Test Healpix map saving
     test_try("Test Healpix map saving");
     try {
-        for (int pix = 0; pix < refmap.npix(); ++pix)
+        for (long long pix = 0; pix < refmap.npix(); ++pix)
             refmap(pix) = pix+1;
         refmap.save(file1, true);
 
@@ -661,7 +999,7 @@ void TestGSky::test_GSkymap_healpix_io(void)
         GSkymap map;
         map.load(file1);
         int diff = 0;
-        for (int pix = 0; pix < refmap.npix(); ++pix) {
+        for (long long pix = 0; pix < refmap.npix(); ++pix) {
             if (map(pix) != refmap(pix))
                 diff++;
         }
@@ -680,7 +1018,7 @@ void TestGSky::test_GSkymap_healpix_io(void)
     try {
         GSkymap map(file1);
         int diff = 0;
-        for (int pix = 0; pix < refmap.npix(); ++pix) {
+        for (long long pix = 0; pix < refmap.npix(); ++pix) {
             if (map(pix) != refmap(pix))
                 diff++;
         }
@@ -693,6 +1031,47 @@ void TestGSky::test_GSkymap_healpix_io(void)
         test_try_failure(e);
     }
 
+    // Test Healpix map with explicitly indexed pixels
+    test_try("Test explicitly indexed Healpix map");
+    try {
+        GFitsBinTable         table(2);
+        GFitsTableLongLongCol pixel("PIXEL", 2);
+        GFitsTableDoubleCol   data("DATA", 2);
+        pixel(0) = 5;
+        pixel(1) = 190;
+        data(0)  = 1.5;
+        data(1)  = 2.5;
+        table.append(pixel);
+        table.append(data);
+        GHealpix healpix(4, "RING", "GAL");
+        healpix.write(table);
+        table.card("INDXSCHM", "EXPLICIT", "Indexing scheme");
+        GSkymap map;
+        map.read(table);
+        test_assert(map.npix() == 192, "Check number of pixels");
+        test_value(map.nmaps(), 1, "Check number of maps");
+        test_value(map(5), 1.5, 1.0e-10, "Check first indexed pixel");
+        test_value(map(190), 2.5, 1.0e-10, "Check second indexed pixel");
+        test_value(map(6), 0.0, 1.0e-10, "Check pixel that is not indexed");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that implicitly indexed maps are tagged as such
+    test_try("Test indexing scheme of Healpix map");
+    try {
+        GFits fits;
+        refmap.write(fits);
+        test_assert(fits.table("HEALPIX")->string("INDXSCHM") == "IMPLICIT",
+                    "Check indexing scheme of written map");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
 }
@@ -770,11 +1149,11 @@ void TestGSky::test_GSkymap_wcs_io(void)
     // Test WCS map saving
     test_try("Test WCS map saving");
     try {
-        for (int pix = 0; pix < refmap1.npix(); ++pix) {
+        for (long long pix = 0; pix < refmap1.npix(); ++pix) {
             refmap1(pix) = pix+1;
         }
         refmap1.save(file1, 1);
-        for (int pix = 0; pix < refmap2.npix(); ++pix) {
+        for (long long pix = 0; pix < refmap2.npix(); ++pix) {
             refmap2(pix) = pix+1;
         }
         refmap2.save(file2, 1);
@@ -790,7 +1169,7 @@ void TestGSky::test_GSkymap_wcs_io(void)
         GSkymap map;
         map.load(file1);
         int diff = 0;
-        for (int pix = 0; pix < refmap1.npix(); ++pix) {
+        for (long long pix = 0; pix < refmap1.npix(); ++pix) {
             if (map(pix) != refmap1(pix)) {
                 diff++;
             }
@@ -810,7 +1189,7 @@ void TestGSky::test_GSkymap_wcs_io(void)
         GSkymap map;
         map.load(file2);
         int diff = 0;
-        for (int pix = 0; pix < refmap2.npix(); ++pix) {
+        for (long long pix = 0; pix < refmap2.npix(); ++pix) {
             if (map(pix) != refmap2(pix)) {
                 diff++;
             }
@@ -840,7 +1219,7 @@ void TestGSky::test_GSkymap(void)
 
     // Fill map pixels
     double total_src = 0.0;
-    for (int pix = 0; pix < map_src.npix(); ++pix) {
+    for (long long pix = 0; pix < map_src.npix(); ++pix) {
         for (int k = 0; k < map_src.nmaps(); ++k) {
             map_src(pix,k) = pix+1;
             total_src     += map_src(pix,k);
@@ -854,7 +1233,7 @@ void TestGSky::test_GSkymap(void)
     // map should be 100 times the total in the source map as the operator
     // is expected to perform strict bi-linear interpolation
     double total_dst = 0.0;
-    for (int pix = 0; pix < map_dst.npix(); ++pix) {
+    for (long long pix = 0; pix < map_dst.npix(); ++pix) {
         for (int k = 0; k < map_dst.nmaps(); ++k) {
             total_dst += map_dst(pix,k);
         }
@@ -868,7 +1247,7 @@ void TestGSky::test_GSkymap(void)
     // Check total in destination map. Note that the total in the destination
     // map should be zero.
     total_dst = 0.0;
-    for (int pix = 0; pix < map_dst.npix(); ++pix) {
+    for (long long pix = 0; pix < map_dst.npix(); ++pix) {
         for (int k = 0; k < map_dst.nmaps(); ++k) {
             total_dst += map_dst(pix,k);
         }
@@ -880,7 +1259,7 @@ void TestGSky::test_GSkymap(void)
     test_map         *= map_src;
     double total_test = 0.0;
     double total_ref  = 0.0;
-    for (int pix = 0; pix < test_map.npix(); ++pix) {
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
         for (int k = 0; k < test_map.nmaps(); ++k) {
             total_test += test_map(pix,k);
             total_ref  += map_src(pix,k) * map_src(pix,k);
@@ -893,7 +1272,7 @@ void TestGSky::test_GSkymap(void)
     test_map  /= map_src;
     total_test = 0.0;
     total_ref  = 0.0;
-    for (int pix = 0; pix < test_map.npix(); ++pix) {
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
         for (int k = 0; k < test_map.nmaps(); ++k) {
             total_test += test_map(pix,k);
             total_ref  += map_src(pix,k) / map_src(pix,k);
@@ -905,7 +1284,7 @@ void TestGSky::test_GSkymap(void)
     test_map   = map_src;
     test_map  *= 3.3;
     total_test = 0.0;
-    for (int pix = 0; pix < test_map.npix(); ++pix) {
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
         for (int k = 0; k < test_map.nmaps(); ++k) {
             total_test += test_map(pix,k);
         }
@@ -916,7 +1295,7 @@ void TestGSky::test_GSkymap(void)
     test_map   = map_src;
     test_map  /= 3.3;
     total_test = 0.0;
-    for (int pix = 0; pix < test_map.npix(); ++pix) {
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
         for (int k = 0; k < test_map.nmaps(); ++k) {
             total_test += test_map(pix,k);
         }
@@ -928,7 +1307,7 @@ void TestGSky::test_GSkymap(void)
     test_map  += 3.3;
     total_test = 0.0;
     double ref = total_src + 3.3*test_map.npix()*test_map.nmaps();
-    for (int pix = 0; pix < test_map.npix(); ++pix) {
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
         for (int k = 0; k < test_map.nmaps(); ++k) {
             total_test += test_map(pix,k);
         }
@@ -940,13 +1319,110 @@ void TestGSky::test_GSkymap(void)
     test_map  -= 3.3;
     total_test = 0.0;
     ref        = total_src - 3.3*test_map.npix()*test_map.nmaps();
-    for (int pix = 0; pix < test_map.npix(); ++pix) {
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
         for (int k = 0; k < test_map.nmaps(); ++k) {
             total_test += test_map(pix,k);
         }
     }
 	test_value(total_test, ref, 1.0e-3, "Test operator-=(double)");
 
+    // Check operators, add() and scale() for maps with the same
+    // pixelisation, which combine pixels without interpolation
+    GSkymap map_same = map_src;
+    map_same        *= 0.5;
+    test_map         = map_src;
+    test_map        += map_same;
+    test_map.add(map_same, 2.0);
+    test_map        -= map_same;
+    test_map        *= map_same;
+    test_map        /= map_src;
+    std::vector<double> factors;
+    factors.push_back(2.0);
+    factors.push_back(-1.0);
+    test_map.scale(factors);
+    double dev = 0.0;
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
+        for (int k = 0; k < test_map.nmaps(); ++k) {
+            double value = 2.0 * map_src(pix,k) * 0.5 * factors[k];
+            dev = std::max(dev, std::abs(test_map(pix,k) - value));
+        }
+    }
+    test_value(dev, 0.0, 1.0e-10, "Test arithmetic for same pixelisation");
+    test_try("Test scale() with wrong number of factors");
+    try {
+        factors.push_back(1.0);
+        test_map.scale(factors);
+        test_try_failure("scale() with wrong number of factors should throw");
+    }
+    catch (GException::invalid_argument& e) {
+        test_try_success();
+    }
+    catch (std::exception& e) {
+        test_try_failure(e);
+    }
+
+    // Check add() with interpolation
+    test_map = map_dst;
+    test_map.add(map_src, -2.0);
+    total_test = 0.0;
+    for (long long pix = 0; pix < test_map.npix(); ++pix) {
+        for (int k = 0; k < test_map.nmaps(); ++k) {
+            total_test += test_map(pix,k);
+        }
+    }
+	test_value(total_test/100.0, -2.0*total_src, 1.0e-3,
+               "Test add(GSkymap, double) with interpolation");
+
+    // Check map extraction and stacking
+    GSkymap extracted = map_src.extract(1);
+    GSkymap stacked   = map_src;
+    stacked.stack_maps();
+    test_value(extracted.nmaps(), 1, "Test number of extracted maps");
+    test_value(stacked.nmaps(), 1, "Test number of stacked maps");
+    dev = 0.0;
+    for (long long pix = 0; pix < map_src.npix(); ++pix) {
+        dev = std::max(dev, std::abs(extracted(pix) - map_src(pix,1)));
+        dev = std::max(dev, std::abs(stacked(pix) - map_src(pix,0) -
+                                     map_src(pix,1)));
+    }
+    test_value(dev, 0.0, 1.0e-10, "Test extracted and stacked pixels");
+
+    // Check pixel range to sky direction conversion for WCS and HealPix
+    // maps
+    GSkymap map_hpx("GAL", 4, "RING", 1);
+    GSkymap maps[2] = {map_dst, map_hpx};
+    for (int m = 0; m < 2; ++m) {
+        long long            first = maps[m].npix() / 4;
+        int                  num   = int(maps[m].npix() / 2);
+        std::vector<GSkyDir> dirs  = maps[m].inx2dir(first, num);
+        double               dev   = 0.0;
+        for (int i = 0; i < num; ++i) {
+            GSkyDir dir  = maps[m].inx2dir(first+i);
+            double  dlon = std::abs(dirs[i].l_deg() - dir.l_deg());
+            double  dlat = std::abs(dirs[i].b_deg() - dir.b_deg());
+            if (dlon > dev) {
+                dev = dlon;
+            }
+            if (dlat > dev) {
+                dev = dlat;
+            }
+        }
+        test_value((int)dirs.size(), num, "Test inx2dir(int&, int&) size");
+        test_value(dev, 0.0, 1.0e-10, "Test inx2dir(int&, int&) directions");
+    }
+    test_try("Test inx2dir(int&, int&) out of range");
+    try {
+        std::vector<GSkyDir> dirs = map_hpx.inx2dir(1, map_hpx.npix());
+        test_try_failure("Pixel range exceeding the map should throw an"
+                         " exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Save maps
     map_src.save("test_map_src.fits", true);
     map_dst.save("test_map_dst.fits", true);
@@ -955,7 +1431,7 @@ void TestGSky::test_GSkymap(void)
     GSkymap map_stacked = map_src;
     map_stacked.stack_maps();
     double total_stacked = 0.0;
-    for (int pix = 0; pix < map_stacked.npix(); ++pix) {
+    for (long long pix = 0; pix < map_stacked.npix(); ++pix) {
         total_stacked += map_stacked(pix);
     }
 	test_value(total_stacked, total_src, 1.0e-3, "Test stack_maps() method");
@@ -966,7 +1442,7 @@ void TestGSky::test_GSkymap(void)
     map_more.nmaps(4);
     double total_more = 0.0;
     for (int k = 0; k < map_more.nmaps(); ++k) {
-        for (int pix = 0; pix < map_more.npix(); ++pix) {
+        for (long long pix = 0; pix < map_more.npix(); ++pix) {
             total_more += map_more(pix,k);
         }
     }
@@ -976,7 +1452,7 @@ void TestGSky::test_GSkymap(void)
     map_less.nmaps(1);
     double total_less = 0.0;
     for (int k = 0; k < map_less.nmaps(); ++k) {
-        for (int pix = 0; pix < map_less.npix(); ++pix) {
+        for (long long pix = 0; pix < map_less.npix(); ++pix) {
             total_less += map_less(pix,k);
         }
     }
@@ -987,7 +1463,7 @@ void TestGSky::test_GSkymap(void)
     GSkymap map_extract = map_src.extract(0);
     double total_extract = 0.0;
     for (int k = 0; k < map_extract.nmaps(); ++k) {
-        for (int pix = 0; pix < map_extract.npix(); ++pix) {
+        for (long long pix = 0; pix < map_extract.npix(); ++pix) {
             total_extract += map_extract(pix,k);
         }
     }
@@ -996,7 +1472,7 @@ void TestGSky::test_GSkymap(void)
     map_extract = map_src.extract(0,2);
     total_extract = 0.0;
     for (int k = 0; k < map_extract.nmaps(); ++k) {
-        for (int pix = 0; pix < map_extract.npix(); ++pix) {
+        for (long long pix = 0; pix < map_extract.npix(); ++pix) {
             total_extract += map_extract(pix,k);
         }
     }
@@ -1008,6 +1484,235 @@ void TestGSky::test_GSkymap(void)
 }
 
 
+/***************************************************************************
+ * @brief Test GSkymap pixel cache
+ *
+ * Compares the sky directions and solid angles that are obtained with the
+ * pixel cache to those obtained without the pixel cache, for an all-sky
+ * Hammer-Aitoff map that has pixels outside the projection, for a CAR map
+ * and for a HEALPix map.
+ ***************************************************************************/
+void TestGSky::test_GSkymap_pixel_cache(void)
+{
+    // Set test maps
+    std::vector<GSkymap> maps;
+    maps.push_back(GSkymap("AIT", "GAL", 0.0, 0.0, -2.0, 2.0, 190, 95));
+    maps.push_back(GSkymap("CAR", "CEL", 83.6, 22.0, -0.1, 0.1, 50, 40));
+    maps.push_back(GSkymap("GAL", 8, "NESTED"));
+
+    // Loop over test maps
+    int nmaps = maps.size();
+    for (int k = 0; k < nmaps; ++k) {
+
+        // Get reference map and map with pixel cache
+        GSkymap& map = maps[k];
+        GSkymap  cached(map);
+        cached.pixel_cache(true);
+        test_assert(cached.pixel_cache(), "Check pixel cache flag");
+
+        // Compare sky directions and solid angles of all pixels
+        int ndir     = 0;
+        int nomega   = 0;
+        int ninvalid = 0;
+        for (long long i = 0; i < map.npix(); ++i) {
+            try {
+                GSkyDir dir   = map.inx2dir(i);
+                double  omega = map.solidangle(i);
+                if (cached.inx2dir(i).dist_deg(dir) > 1.0e-5) {
+                    ndir++;
+                }
+                if (std::abs(cached.solidangle(i) - omega) > 1.0e-10 * omega) {
+                    nomega++;
+                }
+                GSkyPixel pixel = map.inx2pix(i);
+                if (cached.pix2dir(pixel).dist_deg(dir) > 1.0e-5 ||
+                    std::abs(cached.solidangle(pixel) - omega) > 1.0e-10 * omega) {
+                    ndir++;
+                }
+            }
+            catch (GException::wcs_invalid_x_y& e) {
+                ninvalid++;
+                try {
+                    cached.solidangle(i);
+                    nomega++;
+                }
+                catch (GException::wcs_invalid_x_y& e) {
+                }
+            }
+        }
+        std::string text = "map "+gammalib::str(k);
+        test_value(ndir, 0, "Check cached sky directions of "+text);
+        test_value(nomega, 0, "Check cached solid angles of "+text);
+        if (k == 0) {
+            test_assert(ninvalid > 0, "Check invalid pixels of "+text);
+        }
+
+        // Check that an array of sky directions is taken from the cache
+        std::vector<GSkyDir> dirs = cached.inx2dir(map.npix()/2, 10);
+        test_value((int)dirs.size(), 10, "Check cached sky direction array of "+text);
+
+    } // endfor: looped over maps
+
+    // Check that a projection change invalidates the pixel cache
+    GSkymap map("CAR", "CEL", 83.6, 22.0, -0.1, 0.1, 50, 40);
+    map.pixel_cache(true);
+    map.inx2dir(0);
+    GSkymap other("CAR", "CEL", 0.0, 0.0, -0.1, 0.1, 50, 40);
+    map.projection(*other.projection());
+    test_assert(map.inx2dir(0).dist_deg(other.inx2dir(0)) < 1.0e-10,
+                "Check pixel cache invalidation by projection change");
+
+    // Check that a copy shares the pixel cache and that a projection change
+    // of the copy leaves the pixel cache of the original map intact
+    GSkymap copy(map);
+    copy.projection(*maps[1].projection());
+    test_assert(copy.inx2dir(0).dist_deg(maps[1].inx2dir(0)) < 1.0e-10,
+                "Check pixel cache of copy after projection change");
+    test_assert(map.inx2dir(0).dist_deg(other.inx2dir(0)) < 1.0e-10,
+                "Check pixel cache of original after projection change of copy");
+
+    // Check that the pixel cache is correctly computed if it is first used
+    // by several threads
+    GSkymap reference("GAL", 16, "RING");
+    GSkymap shared(reference);
+    shared.pixel_cache(true);
+    int nwrong = 0;
+    #pragma omp parallel for num_threads(4) reduction(+:nwrong)
+    for (long long i = 0; i < reference.npix(); ++i) {
+        if (shared.inx2dir(i).dist_deg(reference.inx2dir(i)) > 1.0e-5 ||
+            std::abs(shared.solidangle(i) - reference.solidangle(i)) >
+            1.0e-10 * reference.solidangle(i)) {
+            nwrong++;
+        }
+    }
+    test_value(nwrong, 0, "Check pixel cache on concurrent first use");
+
+    // Exit test
+    return;
+}
+
+
+/***************************************************************************
+ * @brief Test GSkymap convolution
+ *
+ * Convolves a constant map and a point source with a normalised Gaussian
+ * kernel, for a CAR map and for a HealPix map. Checks that the constant
+ * map is preserved away from the map borders, that the point source flux
+ * is conserved and that the convolved point source reproduces the kernel.
+ * Also checks that unsupported projections and maps whose pixel size
+ * varies too much over the map are rejected.
+ ***************************************************************************/
+void TestGSky::test_GSkymap_convolve(void)
+{
+    // Set test maps and kernels
+    std::vector<GSkymap> maps;
+    std::vector<double>  sigmas;
+    maps.push_back(GSkymap("CAR", "CEL", 83.6, 22.0, -0.05, 0.05, 80, 60));
+    sigmas.push_back(0.15 * gammalib::deg2rad);
+    maps.push_back(GSkymap("CEL", 32, "RING"));
+    sigmas.push_back(6.0 * gammalib::deg2rad);
+
+    // Loop over test maps
+    int nmaps = maps.size();
+    for (int k = 0; k < nmaps; ++k) {
+
+        // Set kernel
+        double      sigma     = sigmas[k];
+        double      theta_max = 5.0 * sigma;
+        GaussKernel kernel(sigma);
+        std::string text      = "map "+gammalib::str(k);
+
+        // Setup map with a constant and a point source
+        GSkymap   map(maps[k]);
+        long long centre = (k == 0) ? map.pix2inx(GSkyPixel(40.0, 30.0)) : 0;
+        map.nmaps(2);
+        for (long long i = 0; i < map.npix(); ++i) {
+            map(i,0) = 1.0;
+        }
+        map(centre,1) = 1.0;
+
+        // Convolve maps
+        map.convolve(kernel, theta_max);
+
+        // Check that constant map is preserved away from the borders
+        double    max_dev = 0.0;
+        long long ncheck  = 0;
+        for (long long i = 0; i < map.npix(); ++i) {
+            if (k == 0) {
+                GSkyPixel pixel = map.inx2pix(i);
+                if (pixel.x() < 20 || pixel.x() >= 60 ||
+                    pixel.y() < 20 || pixel.y() >= 40) {
+                    continue;
+                }
+            }
+            max_dev = std::max(max_dev, std::abs(map(i,0) - 1.0));
+            ncheck++;
+        }
+        test_assert(ncheck > 0, "Check number of tested pixels of "+text);
+        test_value(max_dev, 0.0, 1.0e-2, "Check convolved constant "+text);
+
+        // Check that point source flux is conserved
+        double flux = 0.0;
+        for (long long i = 0; i < map.npix(); ++i) {
+            flux += map(i,1) * map.solidangle(i);
+        }
+        double omega = map.solidangle(centre);
+        test_value(flux/omega, 1.0, 1.0e-2, "Check convolved flux of "+text);
+
+        // Check that convolved point source reproduces kernel at a
+        // distance of one sigma
+        GSkyDir   dir = map.inx2dir(centre);
+        long long inx = 0;
+        double    dev = 2.0;
+        for (long long i = 0; i < map.npix(); ++i) {
+            double d = std::abs(map.inx2dir(i).dist(dir) - sigma);
+            if (d < dev) {
+                dev = d;
+                inx = i;
+            }
+        }
+        double value = omega * kernel.eval(map.inx2dir(inx).dist(dir));
+        test_value(map(inx,1), value, 2.0e-2 * value,
+                   "Check convolved point source of "+text);
+
+    } // endfor: looped over test maps
+
+    // Check that unsupported projections are rejected
+    GSkymap     ait("AIT", "GAL", 0.0, 0.0, -1.0, 1.0, 20, 20);
+    GaussKernel kernel(0.01);
+    test_try("Check convolution of AIT map");
+    try {
+        ait.convolve(kernel, 0.05);
+        test_try_failure("Convolution of AIT map should throw an exception");
+    }
+    catch (GException::invalid_value& e) {
+        test_try_success();
+    }
+    catch (std::exception& e) {
+        test_try_failure(e);
+    }
+
+    // Check that maps with a pixel size that varies too much over the map
+    // are rejected
+    GSkymap car("CAR", "GAL", 0.0, 0.0, -1.0, 1.0, 40, 40);
+    test_try("Check convolution of extended CAR map");
+    try {
+        car.convolve(kernel, 0.05);
+        test_try_failure("Convolution of extended CAR map should throw an "
+                         "exception");
+    }
+    catch (GException::invalid_value& e) {
+        test_try_success();
+    }
+    catch (std::exception& e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  * @brief GSkyRegionCircle_construct
  ***************************************************************************/
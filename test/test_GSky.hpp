@@ -23,8 +23,30 @@
 #define TEST_GSKY_HPP
 
 /* __ Includes ___________________________________________________________ */
+#include <cmath>
 #include "GammaLib.hpp"
 
+
+/***********************************************************************//**
+ * @class GaussKernel
+ *
+ * @brief Normalised two-dimensional Gaussian kernel
+ *
+ * Returns the value per steradian of a Gaussian kernel of width @p sigma
+ * (radians) at an angular separation given in radians.
+ ***************************************************************************/
+class GaussKernel : public GFunction {
+public:
+    GaussKernel(const double& sigma) : m_sigma(sigma) { return; }
+    virtual ~GaussKernel(void) { return; }
+    double eval(const double& theta) {
+        double arg = -0.5*theta*theta/(m_sigma*m_sigma);
+        return std::exp(arg) / (gammalib::twopi*m_sigma*m_sigma);
+    }
+protected:
+    double m_sigma;
+};
+
 /***********************************************************************//**
  * @class TestGSky
  *
@@ -44,10 +66,14 @@ public:
     void                test_GWcs(void);
     void                test_GSkyPixel(void);
     void                test_GSkymap_healpix_construct(void);
+    void                test_GHealpix_query(void);
+    void                test_GHealpix_64bit(void);
     void                test_GSkymap_healpix_io(void);
     void                test_GSkymap_wcs_construct(void);
     void                test_GSkymap_wcs_io(void);
     void                test_GSkymap(void);
+    void                test_GSkymap_pixel_cache(void);
+    void                test_GSkymap_convolve(void);
     void                test_GSkyRegions_io(void);
     void                test_GSkyRegionCircle_construct(void);
     void                test_GSkyRegionCircle_logic(void);
@@ -57,6 +83,7 @@ public:
 private:
     double wcs_forth_back_pixel(GWcs* wcs, int nx, int ny, double& crpix1, double& crpix2);
     double wcs_copy(GWcs* wcs, int nx, int ny, double& crpix1, double& crpix2);
+    double wcs_batch(GWcs* wcs, int nx, int ny);
 };
 
 #endif /* TEST_GSKY_HPP */
@@ -53,6 +53,8 @@ void TestGSupport::set(void){
     append(static_cast<pfunction>(&TestGSupport::test_expand_env), "Test Environment variable");
     append(static_cast<pfunction>(&TestGSupport::test_node_array), "Test GNodeArray");
     append(static_cast<pfunction>(&TestGSupport::test_bilinear), "Test GBilinear");
+    append(static_cast<pfunction>(&TestGSupport::test_ran_alias), "Test GRanAlias");
+    append(static_cast<pfunction>(&TestGSupport::test_ran_substream), "Test GRan substreams");
     append(static_cast<pfunction>(&TestGSupport::test_url_file),   "Test GUrlFile");
     append(static_cast<pfunction>(&TestGSupport::test_url_string), "Test GUrlString");
 
@@ -98,6 +100,19 @@ void TestGSupport::test_tools(void)
     test_value(gammalib::plaw_photon_flux(2.0, 3.0, 2.5, -1.0), 1.01366277027);
     test_value(gammalib::plaw_photon_flux(2.0, 3.0, 2.5, -2.5), 1.06136118604);
 
+    // Test string interning
+    int id1 = gammalib::intern("Test source 1");
+    int id2 = gammalib::intern("Test source 2");
+    test_assert(id1 >= 0, "gammalib::intern()", "Negative identifier");
+    test_assert(id1 != id2, "gammalib::intern()",
+                "Identical identifiers for different strings");
+    test_value(gammalib::intern("Test source 1"), id1);
+    test_assert(gammalib::interned(id2) == "Test source 2",
+                "gammalib::interned()",
+                "Unexpected string \""+gammalib::interned(id2)+"\"");
+    test_assert(gammalib::interned(-1) == "", "gammalib::interned()",
+                "Expected empty string for invalid identifier");
+
     // Return
     return;
 }
@@ -372,6 +387,33 @@ void TestGSupport::test_node_array(void)
     test_value(nodes.wgt_left(), 0.25, 1.0e-6, "Expected weight 0.25");
     test_value(nodes.wgt_right(), 0.75, 1.0e-6, "Expected weight 0.75");
 
+    // Test stateless interpolation and check that it agrees with set_value()
+    GNodeArray::interpolation wgt = nodes.interpolate(2.5);
+    test_value(wgt.inx_left, 0, "Expected node 0");
+    test_value(wgt.inx_right, 1, "Expected node 1");
+    test_value(wgt.wgt_left, 0.25, 1.0e-6, "Expected weight 0.25");
+    test_value(wgt.wgt_right, 0.75, 1.0e-6, "Expected weight 0.75");
+    for (double value = -1.0; value <= 6.0; value += 0.35) {
+        nodes.set_value(value);
+        wgt = nodes.interpolate(value);
+        test_value(wgt.inx_left, nodes.inx_left());
+        test_value(wgt.inx_right, nodes.inx_right());
+        test_value(wgt.wgt_left, nodes.wgt_left(), 1.0e-10);
+        test_value(wgt.wgt_right, nodes.wgt_right(), 1.0e-10);
+    }
+
+    // Test stateless interpolation for linear node array
+    GNodeArray linear;
+    linear.append(0.0);
+    linear.append(1.0);
+    linear.append(2.0);
+    linear.append(3.0);
+    wgt = linear.interpolate(2.2);
+    test_value(wgt.inx_left, 2, "Expected node 2");
+    test_value(wgt.inx_right, 3, "Expected node 3");
+    test_value(wgt.wgt_left, 0.8, 1.0e-6, "Expected weight 0.8");
+    test_value(wgt.wgt_right, 0.2, 1.0e-6, "Expected weight 0.2");
+
     // Return
     return;
 }
@@ -467,6 +509,179 @@ void TestGSupport::test_bilinear(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test GRanAlias class
+ *
+ * Test the GRanAlias class by comparing the frequencies of drawn indices
+ * to the weights, and by checking that the batch draw is identical to
+ * individual draws.
+ ***************************************************************************/
+void TestGSupport::test_ran_alias(void)
+{
+    // Test void constructor
+    GRanAlias empty;
+    test_value(empty.size(), 0, "Check size of empty alias table");
+    test_assert(empty.is_empty(), "Check that alias table is empty");
+
+    // Set weights
+    std::vector<double> weights;
+    weights.push_back(1.0);
+    weights.push_back(0.0);
+    weights.push_back(3.0);
+    weights.push_back(6.0);
+    weights.push_back(0.0);
+
+    // Build alias table
+    GRanAlias alias(weights);
+    test_value(alias.size(), 5, "Check size of alias table");
+    test_value(alias.total(), 10.0, 1.0e-10, "Check sum of weights");
+
+    // Draw indices and count frequencies
+    const int        n = 100000;
+    GRan             ran;
+    std::vector<int> counts(weights.size(), 0);
+    for (int i = 0; i < n; ++i) {
+        counts[alias.draw(ran)]++;
+    }
+
+    // Check frequencies (the expected standard deviation for the largest
+    // weight is about 0.0015)
+    test_value(double(counts[0])/n, 0.1, 0.01, "Check frequency of index 0");
+    test_value(counts[1], 0, "Check that zero weight index 1 is never drawn");
+    test_value(double(counts[2])/n, 0.3, 0.01, "Check frequency of index 2");
+    test_value(double(counts[3])/n, 0.6, 0.01, "Check frequency of index 3");
+    test_value(counts[4], 0, "Check that zero weight index 4 is never drawn");
+
+    // Check that batch draw is identical to individual draws
+    GRan             ran1(123);
+    GRan             ran2(123);
+    std::vector<int> batch = alias.draw(ran1, 1000);
+    int              ndiff = 0;
+    for (int i = 0; i < int(batch.size()); ++i) {
+        if (batch[i] != alias.draw(ran2)) {
+            ndiff++;
+        }
+    }
+    test_value((int)batch.size(), 1000, "Check size of batch draw");
+    test_value(ndiff, 0, "Check that batch draw equals individual draws");
+
+    // Check that copy draws the same indices
+    GRanAlias copy(alias);
+    GRan      ran3(42);
+    GRan      ran4(42);
+    test_value(copy.draw(ran3), alias.draw(ran4), "Check copy");
+
+    // Check that invalid weights are rejected
+    test_try("Check negative weight");
+    try {
+        std::vector<double> invalid(3, 1.0);
+        invalid[1] = -1.0;
+        GRanAlias bad(invalid);
+        test_try_failure("Negative weight should throw an exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that drawing from an all zero table is rejected
+    test_try("Check drawing from zero weights");
+    try {
+        GRanAlias zero(std::vector<double>(3, 0.0));
+        zero.draw(ran);
+        test_try_failure("Drawing from zero weights should throw an"
+                         " exception.");
+    }
+    catch (GException::invalid_value &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test GRan substreams
+ *
+ * Test that GRan substreams are deterministic, independent of the numbers
+ * drawn from the parent generator, and that a parallel computation using
+ * one substream per unit of work reproduces the serial result.
+ ***************************************************************************/
+void TestGSupport::test_ran_substream(void)
+{
+    // Set parent generator
+    GRan ran(1234);
+
+    // Check that substream does not depend on drawn numbers
+    GRan   sub1 = ran.substream(5);
+    double ref  = sub1.uniform();
+    for (int i = 0; i < 10; ++i) {
+        ran.uniform();
+    }
+    GRan sub2 = ran.substream(5);
+    test_value(sub2.uniform(), ref, 0.0, "Check substream reproducibility");
+
+    // Check that substreams differ from each other and from the parent
+    GRan parent(1234);
+    GRan sub3 = parent.substream(6);
+    GRan sub4 = parent.substream(0);
+    test_assert(sub3.int64() != ran.substream(5).int64(),
+                "Check that substreams 5 and 6 differ");
+    test_assert(sub4.int64() != GRan(1234).int64(),
+                "Check that substream 0 differs from parent");
+    test_assert(parent.substream(5).seed() != GRan(4321).substream(5).seed(),
+                "Check that substreams of different seeds differ");
+
+    // Check nested substreams
+    test_assert(parent.substream(1).substream(2).seed() !=
+                parent.substream(2).substream(1).seed(),
+                "Check that nested substreams are ordered");
+
+    // Fill an array serially and in parallel using one substream per
+    // block and check that the results are identical
+    const int           nblocks = 16;
+    const int           nblock  = 1000;
+    std::vector<double> serial(nblocks*nblock);
+    std::vector<double> parallel(nblocks*nblock);
+    for (int k = 0; k < nblocks; ++k) {
+        GRan stream = parent.substream(k);
+        for (int i = 0; i < nblock; ++i) {
+            serial[k*nblock+i] = stream.uniform();
+        }
+    }
+    #pragma omp parallel for
+    for (int k = 0; k < nblocks; ++k) {
+        GRan stream = parent.substream(k);
+        for (int i = 0; i < nblock; ++i) {
+            parallel[k*nblock+i] = stream.uniform();
+        }
+    }
+    int ndiff = 0;
+    for (int i = 0; i < nblocks*nblock; ++i) {
+        if (serial[i] != parallel[i]) {
+            ndiff++;
+        }
+    }
+    test_value(ndiff, 0, "Check parallel substreams");
+
+    // Check mean of concatenated substreams
+    double sum = 0.0;
+    for (int i = 0; i < nblocks*nblock; ++i) {
+        sum += serial[i];
+    }
+    test_value(sum/serial.size(), 0.5, 0.01, "Check mean of substreams");
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test GUrlFile class
  *
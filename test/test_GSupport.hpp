@@ -50,6 +50,8 @@ public:
     void                  test_expand_env(void);
     void                  test_node_array(void);
     void                  test_bilinear(void);
+    void                  test_ran_alias(void);
+    void                  test_ran_substream(void);
     void                  test_url_file(void);
     void                  test_url_string(void);
     void                  test_tools(void);
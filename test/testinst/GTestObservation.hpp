@@ -84,6 +84,7 @@ public:
     virtual double               ontime(void) const { return m_ontime; }
     virtual double               livetime(void) const { return m_ontime; }
     virtual double               deadc(const GTime& time) const { return 1.0; }
+    virtual bool                 is_threadsafe(void) const { return true; }
     virtual void                 read(const GXmlElement& xml) { return; }
     virtual void                 write(GXmlElement& xml) const { return; }
     virtual void                 ontime(const double& ontime) { m_ontime=ontime; }